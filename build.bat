@@ -87,10 +87,14 @@ if not "%no_meta%"=="1" (
 pushd build
 if "%raddbg%"=="1"             %compile% %gfx%       ..\src\raddbg\raddbg_main.cpp                                %compile_link% %out%raddbg.exe
 if "%raddbg_from_pdb%"=="1"    %compile%             ..\src\raddbg_convert\pdb\raddbg_from_pdb_main.c             %compile_link% %out%raddbg_from_pdb.exe
-if "%raddbg_from_dwarf%"=="1"  %compile%             ..\src\raddbg_convert\dwarf\raddbg_from_dwarf.c              %compile_link% %out%raddbg_from_dwarf.exe
+if "%raddbg_from_dwarf%"=="1"  %compile%             ..\src\raddbg_convert\dwarf\raddbg_from_dwarf_main.c         %compile_link% %out%raddbg_from_dwarf.exe
 if "%raddbg_dump%"=="1"        %compile%             ..\src\raddbg_dump\raddbg_dump.c                             %compile_link% %out%raddbg_dump.exe
 if "%ryan_scratch%"=="1"       %compile%             ..\src\scratch\ryan_scratch.c                                %compile_link% %out%ryan_scratch.exe
 if "%look_at_raddbg%"=="1"     %compile%             ..\src\scratch\look_at_raddbg.c                              %compile_link% %out%look_at_raddbg.exe
+if "%hash_store_bench%"=="1"   %compile%             ..\src\scratch\hash_store_bench.c                            %compile_link% %out%hash_store_bench.exe
+if "%eval_bench%"=="1"         %compile%             ..\src\scratch\eval_bench.c                                  %compile_link% %out%eval_bench.exe
+if "%hash_bench%"=="1"         %compile%             ..\src\scratch\hash_bench.c                                  %compile_link% %out%hash_bench.exe
+if "%ctrl_mem_diff_bench%"=="1" %compile%           ..\src\ctrl\test\ctrl_mem_diff_bench.cpp                     %compile_link% %out%ctrl_mem_diff_bench.exe
 if "%mule_main%"=="1"          del vc*.pdb mule*.pdb && %cl_release% /c ..\src\mule\mule_inline.cpp && %cl_release% /c ..\src\mule\mule_o2.cpp && %cl_debug% /EHsc ..\src\mule\mule_main.cpp ..\src\mule\mule_c.c mule_inline.obj mule_o2.obj
 if "%mule_module%"=="1"        %compile%             ..\src\mule\mule_module.cpp                                  %compile_link% %link_dll% %out%mule_module.dll
 popd
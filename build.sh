@@ -76,10 +76,15 @@ fi
 pushd build
 if [ "$raddbg" = "1" ];            then $compile $gfx "../src/raddbg/raddbg_main.cpp"                    $compile_link $out "raddbg"; fi
 if [ "$raddbg_from_pdb" = "1" ];   then $compile      "../src/raddbg_convert/pdb/raddbg_from_pdb_main.c" $compile_link $out "raddbg_from_pdb"; fi
-if [ "$raddbg_from_dwarf" = "1" ]; then $compile      "../src/raddbg_convert/dwarf/raddbg_from_dwarf.c"  $compile_link $out "raddbg_from_dwarf"; fi
+if [ "$raddbg_from_dwarf" = "1" ]; then $compile      "../src/raddbg_convert/dwarf/raddbg_from_dwarf_main.c" $compile_link $out "raddbg_from_dwarf"; fi
 if [ "$raddbg_dump" = "1" ];       then $compile      "../src/raddbg_dump/raddbg_dump.c"                 $compile_link $out "raddbg_dump"; fi
 if [ "$ryan_scratch" = "1" ];      then $compile      "../src/scratch/ryan_scratch.c"                    $compile_link $out "ryan_scratch"; fi
 if [ "$look_at_raddbg" = "1" ];    then $compile      "../src/scratch/look_at_raddbg.c"                  $compile_link $out "look_at_raddbg"; fi
+if [ "$hash_store_bench" = "1" ];  then $compile      "../src/scratch/hash_store_bench.c"                $compile_link $out "hash_store_bench"; fi
+if [ "$eval_bench" = "1" ];        then $compile      "../src/scratch/eval_bench.c"                      $compile_link $out "eval_bench"; fi
+if [ "$hash_bench" = "1" ];        then $compile      "../src/scratch/hash_bench.c"                      $compile_link $out "hash_bench"; fi
+if [ "$demon_watch_bench" = "1" ]; then $compile      "../src/demon/test/demon_watch_bench.cpp"          $compile_link $out "demon_watch_bench"; fi
+if [ "$ctrl_mem_diff_bench" = "1" ]; then $compile    "../src/ctrl/test/ctrl_mem_diff_bench.cpp"         $compile_link $out "ctrl_mem_diff_bench"; fi
 # if "%mule_main%"=="1"          del vc*.pdb mule*.pdb && %cl_release% /c ..\src\mule\mule_inline.cpp && %cl_release% /c ..\src\mule\mule_o2.cpp && %cl_debug% /EHsc ..\src\mule\mule_main.cpp ..\src\mule\mule_c.c mule_inline.obj mule_o2.obj
 # if "%mule_module%"=="1"        %compile%             ..\src\mule\mule_module.cpp                                  %compile_link% %link_dll% %out%mule_module.dll
 popd
@@ -15,20 +15,32 @@
 # include <intrin.h>
 
 # if ARCH_X64
-#  define ins_atomic_u64_eval(x) InterlockedAdd((volatile LONG *)(x), 0)
+#  define ins_atomic_u64_eval(x) InterlockedAdd64((volatile __int64 *)(x), 0)
 #  define ins_atomic_u64_inc_eval(x) InterlockedIncrement64((volatile __int64 *)(x))
 #  define ins_atomic_u64_dec_eval(x) InterlockedDecrement64((volatile __int64 *)(x))
 #  define ins_atomic_u64_eval_assign(x,c) InterlockedExchange64((volatile __int64 *)(x),(c))
-#  define ins_atomic_u64_add_eval(x,c) InterlockedAdd((volatile LONG *)(x), c)
+#  define ins_atomic_u64_add_eval(x,c) InterlockedAdd64((volatile __int64 *)(x), c)
+#  define ins_atomic_u32_eval(x) InterlockedAdd((volatile LONG *)(x), 0)
 #  define ins_atomic_u32_eval_assign(x,c) InterlockedExchange((volatile LONG *)(x),(c))
 #  define ins_atomic_u32_eval_cond_assign(x,k,c) InterlockedCompareExchange((volatile LONG *)(x),(k),(c))
 #  define ins_atomic_ptr_eval_assign(x,c) (void*)ins_atomic_u64_eval_assign((volatile __int64 *)(x), (__int64)(c))
+#  define ins_pause() _mm_pause()
 # endif
 
 #elif OS_LINUX || OS_MAC
 
 # if ARCH_X64
-#  define ins_atomic_u64_inc_eval(x) __sync_fetch_and_add((volatile U64 *)(x), 1)
+#  include <tmmintrin.h>
+#  include <wmmintrin.h>
+#  define ins_atomic_u64_eval(x) __sync_fetch_and_add((volatile U64 *)(x), 0)
+#  define ins_atomic_u64_inc_eval(x) (__sync_fetch_and_add((volatile U64 *)(x), 1) + 1)
+#  define ins_atomic_u64_dec_eval(x) (__sync_fetch_and_sub((volatile U64 *)(x), 1) - 1)
+#  define ins_atomic_u64_eval_assign(x,c) __sync_lock_test_and_set((volatile U64 *)(x),(c))
+#  define ins_atomic_u64_add_eval(x,c) (__sync_fetch_and_add((volatile U64 *)(x), c) + (c))
+#  define ins_atomic_u32_eval(x) __sync_fetch_and_add((volatile U32 *)(x), 0)
+#  define ins_atomic_u32_eval_assign(x,c) __sync_lock_test_and_set((volatile U32 *)(x),(c))
+#  define ins_atomic_u32_eval_cond_assign(x,k,c) __sync_val_compare_and_swap((volatile U32 *)(x),(c),(k))
+#  define ins_pause() __builtin_ia32_pause()
 # endif
 
 #else
@@ -36,6 +36,14 @@ ctrl_init(CTRL_WakeupFunctionType *wakeup_hook)
   {
     ctrl_state->process_memory_cache.stripes[idx].rw_mutex = os_rw_mutex_alloc();
   }
+  ctrl_state->condition_cache.arena = arena_alloc();
+  ctrl_state->condition_cache.slots_count = 256;
+  ctrl_state->condition_cache.slots = push_array(ctrl_state->condition_cache.arena, CTRL_ConditionCacheSlot, ctrl_state->condition_cache.slots_count);
+  ctrl_state->stop_snapshot.mutex = os_mutex_alloc();
+  ctrl_state->mem_snapshot.rw_mutex = os_rw_mutex_alloc();
+  ctrl_state->stop_snapshot.params.stack_size = KB(16);
+  ctrl_state->stop_snapshot.params.tls_size = KB(4);
+  ctrl_state->stop_snapshot.params.max_hot_range_age = 8;
   ctrl_state->u2c_ring_size = KB(64);
   ctrl_state->u2c_ring_base = push_array_no_zero(arena, U8, ctrl_state->u2c_ring_size);
   ctrl_state->u2c_ring_mutex = os_mutex_alloc();
@@ -191,15 +199,183 @@ ctrl_user_breakpoint_list_copy(Arena *arena, CTRL_UserBreakpointList *src)
   return dst;
 }
 
+//- conditional breakpoint lowering
+
+internal B32
+ctrl_demon_trap_condition_from_eval_program(EVAL_Program *program, U64 module_base, DEMON_TrapCondition *condition_out)
+{
+  // NOTE: the demon can only filter hits on conditions of the form
+  // `operand <cmp> operand` (or a lone operand, tested against zero), where
+  // each operand is a register and/or constant, optionally dereferenced once.
+  // the program is walked symbolically; anything else fails to lower, and the
+  // condition stays on the ctrl-side path.
+  B32 good = (program->insts != 0 && program->max_stack_depth <= 2);
+  DEMON_TrapOperand slots[2] = {0};
+  U64 slot_widths[2] = {0};
+  DEMON_TrapConditionOp op = DEMON_TrapConditionOp_Null;
+  B32 has_op = 0;
+  B32 stopped = 0;
+  for(U64 idx = 0; good && idx < program->inst_count; idx += 1)
+  {
+    EVAL_ProgramInst *inst = &program->insts[idx];
+    if(inst->op == EVAL_ProgramOp_Stop)
+    {
+      stopped = 1;
+      break;
+    }
+    B32 is_leaf = (inst->op == EVAL_ProgramOp_Const ||
+                   inst->op == EVAL_ProgramOp_ModuleOff ||
+                   inst->op == EVAL_ProgramOp_RegRead ||
+                   inst->op == EVAL_ProgramOp_RegReadAddImm);
+    if(has_op || inst->dst >= 2 || (is_leaf && inst->dst == 0 && idx != 0))
+    {
+      good = 0;
+      break;
+    }
+    DEMON_TrapOperand *s = &slots[inst->dst];
+    U64 *w = &slot_widths[inst->dst];
+    switch(inst->op)
+    {
+      default:{good = 0;}break;
+      
+      //- leaves
+      case EVAL_ProgramOp_Const:
+      {
+        MemoryZeroStruct(s);
+        s->imm = inst->imm;
+        *w = 8;
+      }break;
+      case EVAL_ProgramOp_ModuleOff:
+      {
+        MemoryZeroStruct(s);
+        s->imm = module_base + inst->imm;
+        *w = 8;
+      }break;
+      case EVAL_ProgramOp_RegRead:
+      case EVAL_ProgramOp_RegReadAddImm:
+      {
+        good = (1 <= inst->size && inst->size <= 8 && inst->imm <= max_U32);
+        MemoryZeroStruct(s);
+        s->reg_off = (U32)inst->imm;
+        s->reg_size = inst->size;
+        s->imm = inst->imm2;
+        *w = (inst->imm2 != 0 ? 8 : inst->size);
+      }break;
+      
+      //- address arithmetic & dereferences
+      case EVAL_ProgramOp_AddImm:
+      case EVAL_ProgramOp_AddImmMemRead:
+      case EVAL_ProgramOp_MemRead:
+      {
+        good = (s->mem_size == 0 && s->flags == 0);
+        if(inst->op != EVAL_ProgramOp_MemRead && inst->imm != 0)
+        {
+          s->imm += inst->imm;
+          *w = 8;
+        }
+        if(inst->op != EVAL_ProgramOp_AddImm)
+        {
+          good = good && (1 <= inst->size && inst->size <= 8);
+          s->mem_size = inst->size;
+          *w = inst->size;
+        }
+      }break;
+      case EVAL_ProgramOp_Add:
+      {
+        // NOTE: only folds in a plain constant, e.g. from an unfused `x + 1`
+        DEMON_TrapOperand *r = &slots[1];
+        good = (inst->dst == 0 &&
+                r->reg_size == 0 && r->mem_size == 0 && r->flags == 0 &&
+                s->mem_size == 0 && s->flags == 0);
+        s->imm += r->imm;
+        *w = 8;
+      }break;
+      
+      //- truncation; a no-op unless it narrows, and narrowing is only
+      // supported as the sign extension of an operand read at that width
+      case EVAL_ProgramOp_Trunc:
+      case EVAL_ProgramOp_TruncSigned:
+      {
+        U64 width_mask = (*w >= 8 ? max_U64 : (1ull << (*w*8)) - 1);
+        if(s->flags & DEMON_TrapOperandFlag_SignExtend)
+        {
+          good = (inst->imm == max_U64 || (inst->op == EVAL_ProgramOp_TruncSigned && inst->imm == width_mask));
+        }
+        else if((inst->imm & width_mask) != width_mask)
+        {
+          good = 0;
+        }
+        else if(inst->op == EVAL_ProgramOp_TruncSigned && inst->imm == width_mask && *w < 8)
+        {
+          s->flags |= DEMON_TrapOperandFlag_SignExtend;
+        }
+      }break;
+      
+      //- comparisons
+      case EVAL_ProgramOp_EqEq: {op = DEMON_TrapConditionOp_EqEq;}break;
+      case EVAL_ProgramOp_NtEq: {op = DEMON_TrapConditionOp_NtEq;}break;
+      case EVAL_ProgramOp_LessU:{op = DEMON_TrapConditionOp_LessU;}break;
+      case EVAL_ProgramOp_LsEqU:{op = DEMON_TrapConditionOp_LsEqU;}break;
+      case EVAL_ProgramOp_GrtrU:{op = DEMON_TrapConditionOp_GrtrU;}break;
+      case EVAL_ProgramOp_GrEqU:{op = DEMON_TrapConditionOp_GrEqU;}break;
+      case EVAL_ProgramOp_LessS:{op = DEMON_TrapConditionOp_LessS;}break;
+      case EVAL_ProgramOp_LsEqS:{op = DEMON_TrapConditionOp_LsEqS;}break;
+      case EVAL_ProgramOp_GrtrS:{op = DEMON_TrapConditionOp_GrtrS;}break;
+      case EVAL_ProgramOp_GrEqS:{op = DEMON_TrapConditionOp_GrEqS;}break;
+    }
+    if(op != DEMON_TrapConditionOp_Null)
+    {
+      has_op = 1;
+      good = good && (inst->dst == 0);
+    }
+  }
+  
+  //- fill
+  if(good && stopped)
+  {
+    MemoryZeroStruct(condition_out);
+    condition_out->l = slots[0];
+    if(has_op)
+    {
+      condition_out->op = op;
+      condition_out->r = slots[1];
+    }
+    else
+    {
+      condition_out->op = DEMON_TrapConditionOp_NtEq;
+    }
+  }
+  B32 result = (good && stopped);
+  return result;
+}
+
+internal DEMON_TrapCondition *
+ctrl_demon_trap_condition_from_user_bp(Arena *arena, Architecture arch, DBGI_Parse *dbgi, String8 exe_path, U64 base_vaddr, CTRL_UserBreakpoint *bp, U64 vaddr)
+{
+  DEMON_TrapCondition *result = 0;
+  if(bp->condition.size != 0)
+  {
+    EVAL_Program *program = ctrl_thread__eval_program_from_condition(arch, dbgi, exe_path, vaddr - base_vaddr, bp->condition);
+    DEMON_TrapCondition condition = {DEMON_TrapConditionOp_Null};
+    if(ctrl_demon_trap_condition_from_eval_program(program, base_vaddr, &condition))
+    {
+      result = push_array(arena, DEMON_TrapCondition, 1);
+      MemoryCopyStruct(result, &condition);
+    }
+  }
+  return result;
+}
+
 internal void
 ctrl_append_resolved_module_user_bp_traps(Arena *arena, DEMON_Handle process, DEMON_Handle module, CTRL_UserBreakpointList *user_bps, DEMON_TrapChunkList *traps_out)
 {
   Temp scratch = scratch_begin(&arena, 1);
   DBGI_Scope *scope = dbgi_scope_open();
   String8 exe_path = demon_full_path_from_module(scratch.arena, module);
-  DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, exe_path, max_U64);
+  DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, exe_path, DBGI_ParseTier_Full, max_U64);
   RADDBG_Parsed *rdbg = &dbgi->rdbg;
   U64 base_vaddr = demon_base_vaddr_from_module(module);
+  Architecture arch = demon_arch_from_object(process);
   for(CTRL_UserBreakpointNode *n = user_bps->first; n != 0; n = n->next)
   {
     CTRL_UserBreakpoint *bp = &n->v;
@@ -253,6 +429,7 @@ ctrl_append_resolved_module_user_bp_traps(Arena *arena, DEMON_Handle process, DE
           {
             U64 vaddr = voffs[i] + base_vaddr;
             DEMON_Trap trap = {process, vaddr, (U64)bp};
+            trap.condition = ctrl_demon_trap_condition_from_user_bp(arena, arch, dbgi, exe_path, base_vaddr, bp, vaddr);
             demon_trap_chunk_list_push(arena, traps_out, 256, &trap);
           }
         }
@@ -280,6 +457,7 @@ ctrl_append_resolved_module_user_bp_traps(Arena *arena, DEMON_Handle process, DE
                 U64 proc_voff = raddbg_first_voff_from_proc(rdbg, ids[match_i]);
                 U64 proc_vaddr = proc_voff + base_vaddr;
                 DEMON_Trap trap = {process, proc_vaddr + voff, (U64)bp};
+                trap.condition = ctrl_demon_trap_condition_from_user_bp(arena, arch, dbgi, exe_path, base_vaddr, bp, proc_vaddr + voff);
                 demon_trap_chunk_list_push(arena, traps_out, 256, &trap);
               }
             }
@@ -671,6 +849,78 @@ ctrl_halt(void)
   demon_halt(0, 0);
 }
 
+//- conditional breakpoint bytecode cache stats
+
+internal U64
+ctrl_condition_cache_hit_count(void)
+{
+  U64 result = ins_atomic_u64_eval(&ctrl_state->condition_cache.hit_count);
+  return result;
+}
+
+internal U64
+ctrl_condition_cache_miss_count(void)
+{
+  U64 result = ins_atomic_u64_eval(&ctrl_state->condition_cache.miss_count);
+  return result;
+}
+
+//- stop-time snapshot working set
+
+internal void
+ctrl_set_stop_snapshot_params(CTRL_StopSnapshotParams *params)
+{
+  OS_MutexScope(ctrl_state->stop_snapshot.mutex)
+  {
+    MemoryCopyStruct(&ctrl_state->stop_snapshot.params, params);
+  }
+}
+
+internal void
+ctrl_stop_snapshot_mark_hot_range(CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 vaddr_range)
+{
+  U64 run_idx = ctrl_run_idx();
+  CTRL_StopSnapshotState *ss = &ctrl_state->stop_snapshot;
+  OS_MutexScope(ss->mutex)
+  {
+    //- find existing range, or the slot to (re)use: a free one if there is
+    // one, otherwise the least recently marked
+    CTRL_StopSnapshotHotRange *dst = 0;
+    for(U64 idx = 0; idx < ss->hot_range_count; idx += 1)
+    {
+      CTRL_StopSnapshotHotRange *r = &ss->hot_ranges[idx];
+      if(r->machine_id == machine_id && ctrl_handle_match(r->process, process) &&
+         r->vaddr_range.min == vaddr_range.min && r->vaddr_range.max == vaddr_range.max)
+      {
+        dst = r;
+        break;
+      }
+    }
+    if(dst == 0 && ss->hot_range_count < ArrayCount(ss->hot_ranges))
+    {
+      dst = &ss->hot_ranges[ss->hot_range_count];
+      ss->hot_range_count += 1;
+    }
+    if(dst == 0)
+    {
+      dst = &ss->hot_ranges[0];
+      for(U64 idx = 1; idx < ss->hot_range_count; idx += 1)
+      {
+        if(ss->hot_ranges[idx].run_idx < dst->run_idx)
+        {
+          dst = &ss->hot_ranges[idx];
+        }
+      }
+    }
+    
+    //- fill
+    dst->machine_id = machine_id;
+    dst->process = process;
+    dst->vaddr_range = vaddr_range;
+    dst->run_idx = run_idx;
+  }
+}
+
 //- rjf: entity introspection
 
 internal U32
@@ -747,23 +997,69 @@ ctrl_process_read(CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 range,
   return actual_bytes_read;
 }
 
+internal CTRL_ProcessMemoryCacheNode4 *
+ctrl_process_memory_cache_node4_from_vaddr(CTRL_ProcessMemoryCacheNode *node, U64 vaddr, B32 create)
+{
+  U64 lvl4_idx = (vaddr&0x000000000FF00000ull) >> 20;
+  U64 lvl3_idx = (vaddr&0x0000000FF0000000ull) >> 28;
+  U64 lvl2_idx = (vaddr&0x00000FF000000000ull) >> 36;
+  U64 lvl1_idx = (vaddr&0x000FF00000000000ull) >> 44;
+  CTRL_ProcessMemoryCacheNode1 *node1 = node->children[lvl1_idx];
+  if(node1 == 0 && create)
+  {
+    node1 = push_array(node->arena, CTRL_ProcessMemoryCacheNode1, 1);
+    node->children[lvl1_idx] = node1;
+  }
+  CTRL_ProcessMemoryCacheNode2 *node2 = node1 ? node1->children[lvl2_idx] : 0;
+  if(node1 != 0 && node2 == 0 && create)
+  {
+    node2 = push_array(node->arena, CTRL_ProcessMemoryCacheNode2, 1);
+    node1->children[lvl2_idx] = node2;
+  }
+  CTRL_ProcessMemoryCacheNode3 *node3 = node2 ? node2->children[lvl3_idx] : 0;
+  if(node2 != 0 && node3 == 0 && create)
+  {
+    node3 = push_array(node->arena, CTRL_ProcessMemoryCacheNode3, 1);
+    node2->children[lvl3_idx] = node3;
+  }
+  CTRL_ProcessMemoryCacheNode4 *node4 = node3 ? node3->children[lvl4_idx] : 0;
+  if(node3 != 0 && node4 == 0 && create)
+  {
+    node4 = push_array(node->arena, CTRL_ProcessMemoryCacheNode4, 1);
+    node3->children[lvl4_idx] = node4;
+  }
+  return node4;
+}
+
 internal String8
 ctrl_query_cached_data_from_process_vaddr_range(Arena *arena, CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 range)
+{
+  String8 result = ctrl_query_cached_data_from_process_vaddr_range__read_size(arena, machine_id, process, range, 0);
+  return result;
+}
+
+internal String8
+ctrl_query_cached_data_from_process_vaddr_range__read_size(Arena *arena, CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 range, U64 *read_size_out)
 {
   String8 result = {0};
+  U64 read_size = 0;
   if(range.max > range.min &&
      dim_1u64(range) <= MB(256) &&
      range.min <= 0x000FFFFFFFFFFFFFull &&
      range.max <= 0x000FFFFFFFFFFFFFull)
   {
+    Temp scratch = scratch_begin(&arena, 1);
     HS_Scope *scope = hs_scope_open();
     CTRL_ProcessMemoryCache *cache = &ctrl_state->process_memory_cache;
+    U64 memgen_idx = ctrl_memgen_idx();
     
     //- rjf: unpack address range
     Rng1U64 page_range = r1u64(AlignDownPow2(range.min, KB(4)), AlignPow2(range.max, KB(4)));
+    U64 page_count = dim_1u64(page_range)/KB(4);
     
     //- rjf: setup output memory for read
-    void *read_out = push_array(arena, U8, dim_1u64(page_range));
+    U8 *read_out = push_array(arena, U8, dim_1u64(page_range));
+    B8 *page_is_good = push_array(scratch.arena, B8, page_count);
     
     //- rjf: unpack process/machine params
     U64 hash = ctrl_hash_from_string(str8_struct(&process));
@@ -772,116 +1068,137 @@ ctrl_query_cached_data_from_process_vaddr_range(Arena *arena, CTRL_MachineID mac
     CTRL_ProcessMemoryCacheSlot *slot = &cache->slots[slot_idx];
     CTRL_ProcessMemoryCacheStripe *stripe = &cache->stripes[stripe_idx];
     
-    //- rjf: cache lookup & fill loop
-    for(U64 page_vaddr = page_range.min; page_vaddr < page_range.max; page_vaddr += KB(4))
-    {
-      // rjf: unpack page base address
-      U64 lvl5_idx         = (page_vaddr&0x00000000000FF000ull) >> 12;
-      U64 lvl4_idx         = (page_vaddr&0x000000000FF00000ull) >> 20;
-      U64 lvl3_idx         = (page_vaddr&0x0000000FF0000000ull) >> 28;
-      U64 lvl2_idx         = (page_vaddr&0x00000FF000000000ull) >> 36;
-      U64 lvl1_idx         = (page_vaddr&0x000FF00000000000ull) >> 44;
-      
-      // rjf: try to find node & read from it
-      B32 node_found = 0;
-      B32 page_found = 0;
-      B32 page_stale = 0;
-      OS_MutexScopeR(stripe->rw_mutex)
+    //- gather all cached pages under one lock. stale pages are copied
+    // too, so they can stand in if the refetch fails, but are not good
+    U64 good_page_count = 0;
+    OS_MutexScopeR(stripe->rw_mutex)
+    {
+      CTRL_ProcessMemoryCacheNode *node = 0;
+      for(CTRL_ProcessMemoryCacheNode *n = slot->first; n != 0; n = n->next)
       {
-        CTRL_ProcessMemoryCacheNode *node = 0;
-        for(CTRL_ProcessMemoryCacheNode *n = slot->first; n != 0; n = n->next)
+        if(ctrl_handle_match(process, n->process) && n->machine_id == machine_id)
         {
-          if(ctrl_handle_match(process, n->process) && n->machine_id == machine_id)
-          {
-            node = n;
-            break;
-          }
+          node = n;
+          break;
         }
-        if(node != 0)
+      }
+      if(node != 0)
+      {
+        CTRL_ProcessMemoryCacheNode4 *node4 = 0;
+        for(U64 page_idx = 0; page_idx < page_count; page_idx += 1)
         {
-          node_found = 1;
-          CTRL_ProcessMemoryCacheNode1 *node1 =  node->children[lvl1_idx];
-          CTRL_ProcessMemoryCacheNode2 *node2 = node1 ? node1->children[lvl2_idx] : 0;
-          CTRL_ProcessMemoryCacheNode3 *node3 = node2 ? node2->children[lvl3_idx] : 0;
-          CTRL_ProcessMemoryCacheNode4 *node4 = node3 ? node3->children[lvl4_idx] : 0;
+          U64 page_vaddr = page_range.min + page_idx*KB(4);
+          U64 lvl5_idx = (page_vaddr&0x00000000000FF000ull) >> 12;
+          if(page_idx == 0 || lvl5_idx == 0)
+          {
+            node4 = ctrl_process_memory_cache_node4_from_vaddr(node, page_vaddr, 0);
+          }
           U128 page_hash = node4 ? node4->page_hashes[lvl5_idx] : u128_zero();
-          B32 stale = (node4 && node4->page_memgen_idxs[lvl5_idx] < ctrl_memgen_idx());
           if(!u128_match(page_hash, u128_zero()))
           {
-            page_stale = stale;
             String8 page_data = hs_data_from_hash(scope, page_hash);
             if(page_data.size >= KB(4))
             {
-              page_found = 1;
-              MemoryCopy((U8*)read_out + (page_vaddr-page_range.min), page_data.str, KB(4));
-            }
-            else
-            {
-              page_stale = 1;
+              MemoryCopy(read_out + page_idx*KB(4), page_data.str, KB(4));
+              page_is_good[page_idx] = (node4->page_memgen_idxs[lvl5_idx] >= memgen_idx);
+              good_page_count += page_is_good[page_idx];
             }
           }
         }
       }
-      
-      // rjf: either node or page not found? -> need a hard-lock & fill
-      if(!node_found || !page_found || page_stale) OS_MutexScopeW(stripe->rw_mutex)
+    }
+    
+    //- read each run of missing/stale pages with a single read, then
+    // commit all of the run's pages to the cache under one lock
+    if(good_page_count < page_count)
+    {
+      B8 *page_is_read = push_array(scratch.arena, B8, page_count);
+      for(U64 run_first_idx = 0, run_opl_idx = 0; run_first_idx < page_count; run_first_idx = run_opl_idx)
       {
-        CTRL_ProcessMemoryCacheNode *node = 0;
-        for(CTRL_ProcessMemoryCacheNode *n = slot->first; n != 0; n = n->next)
+        // find run
+        if(page_is_good[run_first_idx])
         {
-          if(ctrl_handle_match(process, n->process) && n->machine_id == machine_id)
-          {
-            node = n;
-            break;
-          }
+          run_opl_idx = run_first_idx+1;
+          continue;
         }
-        if(node == 0)
+        for(run_opl_idx = run_first_idx+1; run_opl_idx < page_count && !page_is_good[run_opl_idx]; run_opl_idx += 1);
+        
+        // read run - on a short read, the pages past the point of failure
+        // are retried as separate ranges of one vectored read, as readable
+        // pages may follow an unreadable one
+        U64 run_vaddr = page_range.min + run_first_idx*KB(4);
+        U64 run_size = (run_opl_idx-run_first_idx)*KB(4);
+        U8 *run_data = push_array_no_zero(scratch.arena, U8, run_size);
+        U64 run_bytes_read = ctrl_process_read(machine_id, process, r1u64(run_vaddr, run_vaddr+run_size), run_data);
+        U64 run_pages_read = Min(run_bytes_read, run_size)/KB(4);
+        for(U64 page_idx = run_first_idx; page_idx < run_first_idx+run_pages_read; page_idx += 1)
         {
-          Arena *node_arena = arena_alloc();
-          node = push_array(node_arena, CTRL_ProcessMemoryCacheNode, 1);
-          node->arena = node_arena;
-          node->machine_id = machine_id;
-          node->process = process;
-          node->range_hash_slots_count = 1024;
-          node->range_hash_slots = push_array(node_arena, CTRL_ProcessMemoryRangeHashSlot, node->range_hash_slots_count);
-          DLLPushBack(slot->first, slot->last, node);
+          page_is_read[page_idx] = 1;
         }
-        if(!page_found || page_stale)
+        if(run_first_idx+run_pages_read < run_opl_idx)
         {
-          CTRL_ProcessMemoryCacheNode1 *node1 = node->children[lvl1_idx];
-          if(node1 == 0)
+          U64 retry_count = run_opl_idx - (run_first_idx+run_pages_read);
+          DEMON_ReadRange *retry_ranges = push_array(scratch.arena, DEMON_ReadRange, retry_count);
+          for(U64 retry_idx = 0; retry_idx < retry_count; retry_idx += 1)
           {
-            node1 = push_array(node->arena, CTRL_ProcessMemoryCacheNode1, 1);
-            node->children[lvl1_idx] = node1;
+            U64 page_off = (run_pages_read+retry_idx)*KB(4);
+            retry_ranges[retry_idx].dst = run_data+page_off;
+            retry_ranges[retry_idx].src_address = run_vaddr+page_off;
+            retry_ranges[retry_idx].size = KB(4);
           }
-          CTRL_ProcessMemoryCacheNode2 *node2 = node1->children[lvl2_idx];
-          if(node2 == 0)
+          demon_read_memory_ranges(ctrl_demon_handle_from_ctrl(process), retry_ranges, retry_count);
+          for(U64 retry_idx = 0; retry_idx < retry_count; retry_idx += 1)
+          {
+            page_is_read[run_first_idx+run_pages_read+retry_idx] = (retry_ranges[retry_idx].bytes_read >= KB(4));
+          }
+        }
+        for(U64 page_idx = run_first_idx; page_idx < run_opl_idx; page_idx += 1)
+        {
+          if(page_is_read[page_idx])
           {
-            node2 = push_array(node->arena, CTRL_ProcessMemoryCacheNode2, 1);
-            node1->children[lvl2_idx] = node2;
+            U64 page_off = (page_idx-run_first_idx)*KB(4);
+            MemoryCopy(read_out + page_idx*KB(4), run_data+page_off, KB(4));
           }
-          CTRL_ProcessMemoryCacheNode3 *node3 = node2->children[lvl3_idx];
-          if(node3 == 0)
+        }
+        
+        // commit read pages
+        U64 committed_count = 0;
+        U64 *committed_vaddrs = push_array_no_zero(scratch.arena, U64, run_opl_idx-run_first_idx);
+        U128 *committed_hashes = push_array_no_zero(scratch.arena, U128, run_opl_idx-run_first_idx);
+        OS_MutexScopeW(stripe->rw_mutex)
+        {
+          CTRL_ProcessMemoryCacheNode *node = 0;
+          for(CTRL_ProcessMemoryCacheNode *n = slot->first; n != 0; n = n->next)
           {
-            node3 = push_array(node->arena, CTRL_ProcessMemoryCacheNode3, 1);
-            node2->children[lvl3_idx] = node3;
+            if(ctrl_handle_match(process, n->process) && n->machine_id == machine_id)
+            {
+              node = n;
+              break;
+            }
           }
-          CTRL_ProcessMemoryCacheNode4 *node4 = node3->children[lvl4_idx];
-          if(node4 == 0)
+          if(node == 0)
           {
-            node4 = push_array(node->arena, CTRL_ProcessMemoryCacheNode4, 1);
-            node3->children[lvl4_idx] = node4;
+            Arena *node_arena = arena_alloc();
+            node = push_array(node_arena, CTRL_ProcessMemoryCacheNode, 1);
+            node->arena = node_arena;
+            node->machine_id = machine_id;
+            node->process = process;
+            node->range_hash_slots_count = 1024;
+            node->range_hash_slots = push_array(node_arena, CTRL_ProcessMemoryRangeHashSlot, node->range_hash_slots_count);
+            DLLPushBack(slot->first, slot->last, node);
           }
-          Arena *page_arena = arena_alloc__sized(KB(8), KB(8));
-          void *page_base = push_array_no_zero(page_arena, U8, KB(4));
-          U64 actual_read_size = ctrl_process_read(machine_id, process, r1u64(page_vaddr, page_vaddr+KB(4)), page_base);
-          if(actual_read_size >= KB(4))
+          for(U64 page_idx = run_first_idx; page_idx < run_opl_idx; page_idx += 1)
           {
-            node4->page_memgen_idxs[lvl5_idx] = ctrl_memgen_idx();
-            if(page_stale)
+            if(!page_is_read[page_idx])
             {
-              MemoryCopy((U8*)read_out + (page_vaddr-page_range.min), page_base, KB(4));
+              continue;
             }
+            U64 page_vaddr = page_range.min + page_idx*KB(4);
+            U64 lvl5_idx = (page_vaddr&0x00000000000FF000ull) >> 12;
+            CTRL_ProcessMemoryCacheNode4 *node4 = ctrl_process_memory_cache_node4_from_vaddr(node, page_vaddr, 1);
+            Arena *page_arena = arena_alloc__sized(KB(8), KB(8));
+            U8 *page_base = push_array_no_zero(page_arena, U8, KB(4));
+            MemoryCopy(page_base, read_out + page_idx*KB(4), KB(4));
             U64 page_key_data[] =
             {
               (U64)machine_id,
@@ -890,22 +1207,43 @@ ctrl_query_cached_data_from_process_vaddr_range(Arena *arena, CTRL_MachineID mac
               page_vaddr+KB(4),
             };
             U128 page_key = hs_hash_from_data(str8((U8 *)page_key_data, sizeof(page_key_data)));
-            U128 page_hash = hs_submit_data(page_key,  &page_arena, str8((U8 *)page_base, KB(4)));
+            U128 page_hash = hs_submit_data(page_key, &page_arena, str8(page_base, KB(4)));
             node4->page_hashes[lvl5_idx] = page_hash;
+            node4->page_memgen_idxs[lvl5_idx] = memgen_idx;
+            committed_vaddrs[committed_count] = page_vaddr;
+            committed_hashes[committed_count] = page_hash;
+            committed_count += 1;
           }
-          else
-          {
-            arena_release(page_arena);
-          }
+        }
+        
+        // record new versions of pages in snapshot regions
+        if(committed_count != 0 && ins_atomic_u64_eval(&ctrl_state->mem_snapshot.region_count) != 0)
+        {
+          ctrl_mem_snapshot_commit_pages(machine_id, process, memgen_idx, committed_vaddrs, committed_hashes, committed_count);
         }
       }
+      for(U64 page_idx = 0; page_idx < page_count; page_idx += 1)
+      {
+        page_is_good[page_idx] |= page_is_read[page_idx];
+      }
     }
     
+    //- determine size of readable prefix
+    U64 good_prefix_page_count = 0;
+    for(;good_prefix_page_count < page_count && page_is_good[good_prefix_page_count]; good_prefix_page_count += 1);
+    U64 good_prefix_opl = page_range.min + good_prefix_page_count*KB(4);
+    read_size = (good_prefix_opl > range.min) ? (Min(good_prefix_opl, range.max) - range.min) : 0;
+    
     //- rjf: fill result by skipping/chopping read memory
     U64 byte_in_page_idx = (range.min&0x0000000000000FFFull) >> 0;
-    result.str = (U8*)read_out + byte_in_page_idx;
+    result.str = read_out + byte_in_page_idx;
     result.size = dim_1u64(range);
     hs_scope_close(scope);
+    scratch_end(scratch);
+  }
+  if(read_size_out != 0)
+  {
+    *read_size_out = read_size;
   }
   return result;
 }
@@ -979,6 +1317,16 @@ ctrl_stored_hash_from_process_vaddr_range(CTRL_MachineID machine_id, CTRL_Handle
       read_cache__break_all:;
     }
     
+    //- good, but the hash store evicted the data (memory budget) -> refetch
+    if(is_good && !is_stale && !u128_match(result, u128_zero()))
+    {
+      HS_Scope *scope = hs_scope_open();
+      B32 evicted = 0;
+      hs_data_from_hash_evicted(scope, result, &evicted);
+      is_stale = evicted;
+      hs_scope_close(scope);
+    }
+    
     //- rjf: not good -> create process cache node if necessary
     if(!is_good)
     {
@@ -1049,6 +1397,323 @@ ctrl_stored_hash_from_process_vaddr_range(CTRL_MachineID machine_id, CTRL_Handle
   return result;
 }
 
+//- process memory snapshot regions & diffing
+
+internal U128
+ctrl_mem_snapshot_key_from_page_version(CTRL_MemSnapshotRegion *region, U64 page_idx, U64 version_idx)
+{
+  U64 key_data[] =
+  {
+    (U64)region->machine_id,
+    (U64)region->process.u64[0],
+    region->id,
+    region->vaddr_range.min + page_idx*KB(4),
+    version_idx,
+  };
+  U128 key = hs_hash_from_data(str8((U8 *)key_data, sizeof(key_data)));
+  return key;
+}
+
+internal B32
+ctrl_mem_snapshot_region_add(CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 vaddr_range)
+{
+  B32 result = 0;
+  Rng1U64 page_range = r1u64(AlignDownPow2(vaddr_range.min, KB(4)), AlignPow2(vaddr_range.max, KB(4)));
+  if(page_range.max > page_range.min && dim_1u64(page_range) <= CTRL_MEM_SNAPSHOT_REGION_MAX_SIZE)
+  {
+    CTRL_MemSnapshotState *ms = &ctrl_state->mem_snapshot;
+    U64 run_idx = ctrl_run_idx();
+    
+    // already registered => just keep it from aging out
+    OS_MutexScopeW(ms->rw_mutex)
+    {
+      for(CTRL_MemSnapshotRegion *r = ms->first_region; r != 0; r = r->next)
+      {
+        if(r->machine_id == machine_id && ctrl_handle_match(r->process, process) &&
+           r->vaddr_range.min == page_range.min && r->vaddr_range.max == page_range.max)
+        {
+          r->run_idx = run_idx;
+          result = 1;
+          break;
+        }
+      }
+    }
+    
+    // new => allocate & push
+    if(!result)
+    {
+      Arena *arena = arena_alloc();
+      CTRL_MemSnapshotRegion *region = push_array(arena, CTRL_MemSnapshotRegion, 1);
+      region->arena = arena;
+      region->machine_id = machine_id;
+      region->process = process;
+      region->vaddr_range = page_range;
+      region->run_idx = run_idx;
+      region->page_count = dim_1u64(page_range)/KB(4);
+      region->page_version_heads = push_array(arena, U8, region->page_count);
+      region->page_checked_memgen_idxs = push_array(arena, U64, region->page_count);
+      region->page_version_memgen_idxs = push_array(arena, U64, region->page_count*CTRL_MEM_SNAPSHOT_VERSION_COUNT);
+      region->page_version_hashes = push_array(arena, U128, region->page_count*CTRL_MEM_SNAPSHOT_VERSION_COUNT);
+      OS_MutexScopeW(ms->rw_mutex)
+      {
+        ms->region_id_counter += 1;
+        region->id = ms->region_id_counter;
+        DLLPushBack(ms->first_region, ms->last_region, region);
+        ins_atomic_u64_inc_eval(&ms->region_count);
+      }
+      result = 1;
+    }
+  }
+  return result;
+}
+
+internal void
+ctrl_mem_snapshot_region_remove(CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 vaddr_range)
+{
+  Rng1U64 page_range = r1u64(AlignDownPow2(vaddr_range.min, KB(4)), AlignPow2(vaddr_range.max, KB(4)));
+  CTRL_MemSnapshotState *ms = &ctrl_state->mem_snapshot;
+  CTRL_MemSnapshotRegion *region = 0;
+  OS_MutexScopeW(ms->rw_mutex)
+  {
+    for(CTRL_MemSnapshotRegion *r = ms->first_region; r != 0; r = r->next)
+    {
+      if(r->machine_id == machine_id && ctrl_handle_match(r->process, process) &&
+         r->vaddr_range.min == page_range.min && r->vaddr_range.max == page_range.max)
+      {
+        region = r;
+        DLLRemove(ms->first_region, ms->last_region, region);
+        ins_atomic_u64_dec_eval(&ms->region_count);
+        break;
+      }
+    }
+  }
+  if(region != 0)
+  {
+    ctrl_mem_snapshot_region_release(region);
+  }
+}
+
+internal void
+ctrl_mem_snapshot_region_release(CTRL_MemSnapshotRegion *region)
+{
+  // unbind all version keys, so the hash store can evict old pages
+  for(U64 idx = 0; idx < region->page_count*CTRL_MEM_SNAPSHOT_VERSION_COUNT; idx += 1)
+  {
+    if(!u128_match(region->page_version_hashes[idx], u128_zero()))
+    {
+      U128 key = ctrl_mem_snapshot_key_from_page_version(region, idx/CTRL_MEM_SNAPSHOT_VERSION_COUNT, idx%CTRL_MEM_SNAPSHOT_VERSION_COUNT);
+      hs_bind_key(key, u128_zero());
+    }
+  }
+  arena_release(region->arena);
+}
+
+internal void
+ctrl_mem_snapshot_commit_pages(CTRL_MachineID machine_id, CTRL_Handle process, U64 memgen_idx, U64 *page_vaddrs, U128 *page_hashes, U64 page_count)
+{
+  CTRL_MemSnapshotState *ms = &ctrl_state->mem_snapshot;
+  OS_MutexScopeW(ms->rw_mutex)
+  {
+    for(CTRL_MemSnapshotRegion *region = ms->first_region; region != 0; region = region->next)
+    {
+      if(region->machine_id != machine_id || !ctrl_handle_match(region->process, process))
+      {
+        continue;
+      }
+      for(U64 idx = 0; idx < page_count; idx += 1)
+      {
+        if(!contains_1u64(region->vaddr_range, page_vaddrs[idx]))
+        {
+          continue;
+        }
+        U64 page_idx = (page_vaddrs[idx] - region->vaddr_range.min)/KB(4);
+        U64 head = region->page_version_heads[page_idx];
+        U64 latest_idx = (head + CTRL_MEM_SNAPSHOT_VERSION_COUNT - 1)%CTRL_MEM_SNAPSHOT_VERSION_COUNT;
+        U64 *memgen_idxs = &region->page_version_memgen_idxs[page_idx*CTRL_MEM_SNAPSHOT_VERSION_COUNT];
+        U128 *hashes = &region->page_version_hashes[page_idx*CTRL_MEM_SNAPSHOT_VERSION_COUNT];
+        
+        // older than the latest version => nothing to record
+        if(!u128_match(hashes[latest_idx], u128_zero()) && memgen_idxs[latest_idx] >= memgen_idx)
+        {
+          continue;
+        }
+        
+        // unchanged since the latest version => it's still good through this memgen
+        if(u128_match(hashes[latest_idx], page_hashes[idx]))
+        {
+          region->page_checked_memgen_idxs[page_idx] = Max(region->page_checked_memgen_idxs[page_idx], memgen_idx);
+          continue;
+        }
+        
+        // record new version in the oldest slot; its key keeps the page alive
+        U128 key = ctrl_mem_snapshot_key_from_page_version(region, page_idx, head);
+        if(hs_bind_key(key, page_hashes[idx]))
+        {
+          memgen_idxs[head] = memgen_idx;
+          hashes[head] = page_hashes[idx];
+          region->page_version_heads[page_idx] = (U8)((head + 1)%CTRL_MEM_SNAPSHOT_VERSION_COUNT);
+          region->page_checked_memgen_idxs[page_idx] = memgen_idx;
+        }
+      }
+    }
+  }
+}
+
+internal U128
+ctrl_mem_snapshot_hash_from_region_page_memgen(CTRL_MemSnapshotRegion *region, U64 page_idx, U64 memgen_idx)
+{
+  U128 result = {0};
+  U64 best_memgen_idx = 0;
+  U64 *memgen_idxs = &region->page_version_memgen_idxs[page_idx*CTRL_MEM_SNAPSHOT_VERSION_COUNT];
+  U128 *hashes = &region->page_version_hashes[page_idx*CTRL_MEM_SNAPSHOT_VERSION_COUNT];
+  
+  // NOTE: if the page wasn't checked since memgen_idx, it may have changed
+  // after its latest version, so the contents at memgen_idx aren't known
+  B32 is_checked = (memgen_idx <= region->page_checked_memgen_idxs[page_idx]);
+  for(U64 idx = 0; is_checked && idx < CTRL_MEM_SNAPSHOT_VERSION_COUNT; idx += 1)
+  {
+    if(!u128_match(hashes[idx], u128_zero()) && memgen_idxs[idx] <= memgen_idx &&
+       (u128_match(result, u128_zero()) || memgen_idxs[idx] >= best_memgen_idx))
+    {
+      result = hashes[idx];
+      best_memgen_idx = memgen_idxs[idx];
+    }
+  }
+  return result;
+}
+
+internal void
+ctrl_mem_diff_push(Arena *arena, CTRL_MemDiff *diff, Rng1U64 vaddr_range)
+{
+  if(diff->last != 0 && diff->last->vaddr_range.max == vaddr_range.min)
+  {
+    diff->last->vaddr_range.max = vaddr_range.max;
+  }
+  else
+  {
+    CTRL_MemDiffNode *n = push_array(arena, CTRL_MemDiffNode, 1);
+    n->vaddr_range = vaddr_range;
+    SLLQueuePush(diff->first, diff->last, n);
+    diff->count += 1;
+  }
+  diff->changed_byte_count += dim_1u64(vaddr_range);
+}
+
+internal void
+ctrl_mem_diff_push_changed_bytes(Arena *arena, CTRL_MemDiff *diff, U64 base_vaddr, U8 *a, U8 *b, U64 size)
+{
+  // compare 64 bytes at a time; only blocks which differ are scanned with
+  // per-16-byte difference masks
+  U64 run_min = 0;
+  B32 in_run = 0;
+  U64 off = 0;
+  for(;off < size;)
+  {
+    if(off + 64 <= size)
+    {
+      __m128i eq0 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)(a+off+ 0)), _mm_loadu_si128((__m128i *)(b+off+ 0)));
+      __m128i eq1 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)(a+off+16)), _mm_loadu_si128((__m128i *)(b+off+16)));
+      __m128i eq2 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)(a+off+32)), _mm_loadu_si128((__m128i *)(b+off+32)));
+      __m128i eq3 = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)(a+off+48)), _mm_loadu_si128((__m128i *)(b+off+48)));
+      __m128i eq = _mm_and_si128(_mm_and_si128(eq0, eq1), _mm_and_si128(eq2, eq3));
+      if(_mm_movemask_epi8(eq) == 0xFFFF)
+      {
+        if(in_run)
+        {
+          ctrl_mem_diff_push(arena, diff, r1u64(base_vaddr+run_min, base_vaddr+off));
+          in_run = 0;
+        }
+        off += 64;
+        continue;
+      }
+    }
+    U64 block_size = Min(16, size-off);
+    U32 diff_mask = 0;
+    if(block_size == 16)
+    {
+      __m128i eq = _mm_cmpeq_epi8(_mm_loadu_si128((__m128i *)(a+off)), _mm_loadu_si128((__m128i *)(b+off)));
+      diff_mask = (~(U32)_mm_movemask_epi8(eq)) & 0xFFFF;
+    }
+    else for(U64 idx = 0; idx < block_size; idx += 1)
+    {
+      diff_mask |= (U32)(a[off+idx] != b[off+idx]) << idx;
+    }
+    for(U64 idx = 0; idx < block_size; idx += 1)
+    {
+      B32 byte_differs = !!(diff_mask & (1u << idx));
+      if(byte_differs && !in_run)
+      {
+        run_min = off+idx;
+        in_run = 1;
+      }
+      else if(!byte_differs && in_run)
+      {
+        ctrl_mem_diff_push(arena, diff, r1u64(base_vaddr+run_min, base_vaddr+off+idx));
+        in_run = 0;
+      }
+    }
+    off += block_size;
+  }
+  if(in_run)
+  {
+    ctrl_mem_diff_push(arena, diff, r1u64(base_vaddr+run_min, base_vaddr+size));
+  }
+}
+
+internal CTRL_MemDiff
+ctrl_mem_diff_from_process_vaddr_range(Arena *arena, CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 vaddr_range, U64 memgen_idx_a, U64 memgen_idx_b)
+{
+  ProfBeginFunction();
+  CTRL_MemDiff diff = {0};
+  HS_Scope *scope = hs_scope_open();
+  CTRL_MemSnapshotState *ms = &ctrl_state->mem_snapshot;
+  OS_MutexScopeR(ms->rw_mutex)
+  {
+    for(CTRL_MemSnapshotRegion *region = ms->first_region; region != 0; region = region->next)
+    {
+      Rng1U64 range = intersect_1u64(region->vaddr_range, vaddr_range);
+      if(region->machine_id != machine_id || !ctrl_handle_match(region->process, process) || range.max <= range.min)
+      {
+        continue;
+      }
+      U64 first_page_idx = (AlignDownPow2(range.min, KB(4)) - region->vaddr_range.min)/KB(4);
+      U64 opl_page_idx = (AlignPow2(range.max, KB(4)) - region->vaddr_range.min)/KB(4);
+      for(U64 page_idx = first_page_idx; page_idx < opl_page_idx; page_idx += 1)
+      {
+        U64 page_vaddr = region->vaddr_range.min + page_idx*KB(4);
+        Rng1U64 page_range = intersect_1u64(r1u64(page_vaddr, page_vaddr+KB(4)), range);
+        U128 hash_a = ctrl_mem_snapshot_hash_from_region_page_memgen(region, page_idx, memgen_idx_a);
+        U128 hash_b = ctrl_mem_snapshot_hash_from_region_page_memgen(region, page_idx, memgen_idx_b);
+        
+        // same version => unchanged, without touching the data
+        if(u128_match(hash_a, hash_b) && !u128_match(hash_a, u128_zero()))
+        {
+          continue;
+        }
+        
+        // both versions available => compare bytes
+        String8 data_a = u128_match(hash_a, u128_zero()) ? str8_zero() : hs_data_from_hash(scope, hash_a);
+        String8 data_b = u128_match(hash_b, u128_zero()) ? str8_zero() : hs_data_from_hash(scope, hash_b);
+        if(data_a.size >= KB(4) && data_b.size >= KB(4))
+        {
+          U64 page_off = page_range.min - page_vaddr;
+          ctrl_mem_diff_push_changed_bytes(arena, &diff, page_range.min, data_a.str+page_off, data_b.str+page_off, dim_1u64(page_range));
+        }
+        
+        // either version isn't known (not yet snapshotted, aged out of the
+        // version ring, or evicted) => can't tell
+        else
+        {
+          diff.unknown_byte_count += dim_1u64(page_range);
+        }
+      }
+    }
+  }
+  hs_scope_close(scope);
+  ProfEnd();
+  return diff;
+}
+
 //- rjf: register reading/writing
 
 internal void *
@@ -1630,6 +2295,289 @@ ctrl_eval_memory_read(void *u, void *out, U64 addr, U64 size)
   return result;
 }
 
+//- stop-time snapshot
+
+internal int
+ctrl_thread__qsort_compare_ranges(Rng1U64 *a, Rng1U64 *b)
+{
+  int result = 0;
+  if(a->min < b->min)
+  {
+    result = -1;
+  }
+  else if(a->min > b->min)
+  {
+    result = +1;
+  }
+  return result;
+}
+
+internal void
+ctrl_thread__stop_snapshot(void)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(0, 0);
+  CTRL_StopSnapshotState *ss = &ctrl_state->stop_snapshot;
+  U64 run_idx = ctrl_run_idx();
+  
+  //- grab params & live hot ranges; drop hot ranges which have aged out
+  CTRL_StopSnapshotParams params = {0};
+  CTRL_StopSnapshotHotRange *hot_ranges = 0;
+  U64 hot_range_count = 0;
+  OS_MutexScope(ss->mutex)
+  {
+    params = ss->params;
+    for(U64 idx = 0; idx < ss->hot_range_count;)
+    {
+      if(ss->hot_ranges[idx].run_idx + params.max_hot_range_age < run_idx)
+      {
+        ss->hot_ranges[idx] = ss->hot_ranges[ss->hot_range_count-1];
+        ss->hot_range_count -= 1;
+      }
+      else
+      {
+        idx += 1;
+      }
+    }
+    hot_range_count = ss->hot_range_count;
+    hot_ranges = push_array_no_zero(scratch.arena, CTRL_StopSnapshotHotRange, hot_range_count);
+    MemoryCopy(hot_ranges, ss->hot_ranges, sizeof(CTRL_StopSnapshotHotRange)*hot_range_count);
+  }
+  
+  //- drop snapshot regions which have aged out; pick this stop's refresh
+  // ranges round-robin - each region continues from its page cursor, and
+  // regions which got a turn move to the back, so the cap is shared fairly
+  CTRL_MemSnapshotState *ms = &ctrl_state->mem_snapshot;
+  CTRL_MemSnapshotRegion *first_dead_region = 0;
+  CTRL_StopSnapshotHotRange *refresh_ranges = 0;
+  U64 refresh_range_count = 0;
+  OS_MutexScopeW(ms->rw_mutex)
+  {
+    for(CTRL_MemSnapshotRegion *r = ms->first_region, *next = 0; r != 0; r = next)
+    {
+      next = r->next;
+      if(r->run_idx + params.max_hot_range_age < run_idx)
+      {
+        DLLRemove(ms->first_region, ms->last_region, r);
+        ins_atomic_u64_dec_eval(&ms->region_count);
+        r->next = first_dead_region;
+        first_dead_region = r;
+      }
+    }
+    refresh_ranges = push_array_no_zero(scratch.arena, CTRL_StopSnapshotHotRange, ms->region_count*2);
+    U64 refresh_pages_left = CTRL_MEM_SNAPSHOT_STOP_REFRESH_CAP/KB(4);
+    CTRL_MemSnapshotRegion *first_refreshed_region = 0;
+    CTRL_MemSnapshotRegion *last_refreshed_region = 0;
+    for(CTRL_MemSnapshotRegion *r = ms->first_region, *next = 0; r != 0 && refresh_pages_left != 0; r = next)
+    {
+      next = r->next;
+      U64 page_count = Min(r->page_count, refresh_pages_left);
+      U64 first_page_idx = r->refresh_page_cursor;
+      U64 opl_page_idx = Min(first_page_idx + page_count, r->page_count);
+      CTRL_StopSnapshotHotRange *range = &refresh_ranges[refresh_range_count];
+      range->machine_id = r->machine_id;
+      range->process = r->process;
+      range->vaddr_range = r1u64(r->vaddr_range.min + first_page_idx*KB(4), r->vaddr_range.min + opl_page_idx*KB(4));
+      refresh_range_count += 1;
+      if(opl_page_idx - first_page_idx < page_count)
+      {
+        range = &refresh_ranges[refresh_range_count];
+        range->machine_id = r->machine_id;
+        range->process = r->process;
+        range->vaddr_range = r1u64(r->vaddr_range.min, r->vaddr_range.min + (page_count - (opl_page_idx - first_page_idx))*KB(4));
+        refresh_range_count += 1;
+      }
+      r->refresh_page_cursor = (first_page_idx + page_count)%r->page_count;
+      refresh_pages_left -= page_count;
+      DLLRemove(ms->first_region, ms->last_region, r);
+      DLLPushBack(first_refreshed_region, last_refreshed_region, r);
+    }
+    for(CTRL_MemSnapshotRegion *r = first_refreshed_region, *next = 0; r != 0; r = next)
+    {
+      next = r->next;
+      DLLPushBack(ms->first_region, ms->last_region, r);
+    }
+  }
+  for(CTRL_MemSnapshotRegion *r = first_dead_region, *next = 0; r != 0; r = next)
+  {
+    next = r->next;
+    ctrl_mem_snapshot_region_release(r);
+  }
+  
+  //- per process: gather the working set, then fill the cache with one read
+  // per contiguous run of pages
+  DEMON_HandleArray processes = demon_all_processes(scratch.arena);
+  for(U64 process_idx = 0; process_idx < processes.count; process_idx += 1)
+  {
+    Temp temp = temp_begin(scratch.arena);
+    DEMON_Handle process = processes.handles[process_idx];
+    CTRL_Handle process_ctrl = ctrl_handle_from_demon(process);
+    DEMON_HandleArray threads = demon_threads_from_process(temp.arena, process);
+    U64 ranges_cap = threads.count*2 + hot_range_count + refresh_range_count;
+    Rng1U64 *ranges = push_array_no_zero(temp.arena, Rng1U64, ranges_cap);
+    U64 ranges_count = 0;
+    
+    // stack tops & TLS blocks
+    for(U64 thread_idx = 0; thread_idx < threads.count; thread_idx += 1)
+    {
+      DEMON_Handle thread = threads.handles[thread_idx];
+      U64 sp = demon_read_sp(thread);
+      U64 tls_root = demon_tls_root_vaddr_from_thread(thread);
+      if(sp != 0 && params.stack_size != 0)
+      {
+        ranges[ranges_count] = r1u64(sp, sp + params.stack_size);
+        ranges_count += 1;
+      }
+      if(tls_root != 0 && params.tls_size != 0)
+      {
+        ranges[ranges_count] = r1u64(tls_root, tls_root + params.tls_size);
+        ranges_count += 1;
+      }
+    }
+    
+    // hot ranges
+    for(U64 idx = 0; idx < hot_range_count; idx += 1)
+    {
+      if(hot_ranges[idx].machine_id == CTRL_MachineID_Client && ctrl_handle_match(hot_ranges[idx].process, process_ctrl))
+      {
+        ranges[ranges_count] = hot_ranges[idx].vaddr_range;
+        ranges_count += 1;
+      }
+    }
+    
+    // snapshot region refresh ranges, so each stop records a version of
+    // every changed page it refreshes
+    for(U64 idx = 0; idx < refresh_range_count; idx += 1)
+    {
+      if(refresh_ranges[idx].machine_id == CTRL_MachineID_Client && ctrl_handle_match(refresh_ranges[idx].process, process_ctrl))
+      {
+        ranges[ranges_count] = refresh_ranges[idx].vaddr_range;
+        ranges_count += 1;
+      }
+    }
+    
+    // page-align, sort, merge & read
+    for(U64 idx = 0; idx < ranges_count; idx += 1)
+    {
+      ranges[idx] = r1u64(AlignDownPow2(ranges[idx].min, KB(4)), AlignPow2(ranges[idx].max, KB(4)));
+    }
+    qsort(ranges, ranges_count, sizeof(Rng1U64), (int (*)(const void *, const void *))ctrl_thread__qsort_compare_ranges);
+    for(U64 first_idx = 0, opl_idx = 0; first_idx < ranges_count; first_idx = opl_idx)
+    {
+      Rng1U64 run = ranges[first_idx];
+      for(opl_idx = first_idx+1; opl_idx < ranges_count && ranges[opl_idx].min <= run.max; opl_idx += 1)
+      {
+        run.max = Max(run.max, ranges[opl_idx].max);
+      }
+      Temp run_temp = temp_begin(temp.arena);
+      ctrl_query_cached_data_from_process_vaddr_range(run_temp.arena, CTRL_MachineID_Client, process_ctrl, run);
+      temp_end(run_temp);
+    }
+    temp_end(temp);
+  }
+  
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+internal EVAL_Program *
+ctrl_thread__eval_program_from_condition(Architecture arch, DBGI_Parse *dbgi, String8 exe_path, U64 voff, String8 condition)
+{
+  CTRL_ConditionCache *cache = &ctrl_state->condition_cache;
+  
+  //- hash key
+  U64 key_data[] =
+  {
+    ctrl_hash_from_string(condition),
+    ctrl_hash_from_string(exe_path),
+    voff,
+    dbgi->uid,
+    (U64)arch,
+  };
+  U64 hash = ctrl_hash_from_string(str8((U8 *)key_data, sizeof(key_data)));
+  CTRL_ConditionCacheSlot *slot = &cache->slots[hash%cache->slots_count];
+  
+  //- look up
+  CTRL_ConditionCacheNode *node = 0;
+  for(CTRL_ConditionCacheNode *n = slot->first; n != 0; n = n->next)
+  {
+    if(n->hash == hash &&
+       n->voff == voff &&
+       n->dbgi_parse_uid == dbgi->uid &&
+       n->arch == arch &&
+       str8_match(n->condition, condition, 0) &&
+       str8_match(n->exe_path, exe_path, 0))
+    {
+      node = n;
+      break;
+    }
+  }
+  
+  //- miss -> compile & insert. entries from old debug info parses are
+  // never looked up again, so when the cache gets too big, start over
+  if(node == 0)
+  {
+    if(cache->node_count >= CTRL_CONDITION_CACHE_MAX_NODE_COUNT)
+    {
+      arena_clear(cache->arena);
+      cache->slots = push_array(cache->arena, CTRL_ConditionCacheSlot, cache->slots_count);
+      cache->node_count = 0;
+      slot = &cache->slots[hash%cache->slots_count];
+    }
+    Temp scratch = scratch_begin(0, 0);
+    RADDBG_Parsed *rdbg = &dbgi->rdbg;
+    EVAL_ParseCtx parse_ctx = zero_struct;
+    {
+      parse_ctx.arch = arch;
+      parse_ctx.ip_voff = voff;
+      parse_ctx.rdbg = rdbg;
+      parse_ctx.type_graph = tg_graph_begin(bit_size_from_arch(arch)/8, 256);
+      parse_ctx.regs_map = ctrl_string2reg_from_arch(arch);
+      parse_ctx.reg_alias_map = ctrl_string2alias_from_arch(arch);
+      parse_ctx.locals_map = eval_push_locals_map_from_raddbg_voff(scratch.arena, rdbg, voff);
+      parse_ctx.member_map = eval_push_member_map_from_raddbg_voff(scratch.arena, rdbg, voff);
+    }
+    EVAL_TokenArray tokens = eval_token_array_from_text(scratch.arena, condition);
+    EVAL_ParseResult parse = eval_parse_expr_from_text_tokens(scratch.arena, &parse_ctx, condition, &tokens);
+    EVAL_ErrorList errors = parse.errors;
+    B32 parse_has_expr = (parse.expr != &eval_expr_nil);
+    B32 parse_is_type = (parse_has_expr && parse.expr->kind == EVAL_ExprKind_TypeIdent);
+    EVAL_IRTreeAndType ir_tree_and_type = {&eval_irtree_nil};
+    if(parse_has_expr && errors.count == 0)
+    {
+      ir_tree_and_type = eval_irtree_and_type_from_expr(scratch.arena, parse_ctx.type_graph, rdbg, parse.expr, &errors);
+    }
+    EVAL_OpList op_list = {0};
+    if(parse_has_expr && ir_tree_and_type.tree != &eval_irtree_nil)
+    {
+      eval_oplist_from_irtree(scratch.arena, ir_tree_and_type.tree, &op_list);
+    }
+    String8 bytecode = {0};
+    if(parse_has_expr && parse_is_type == 0 && op_list.encoded_size != 0)
+    {
+      bytecode = eval_bytecode_from_oplist(scratch.arena, &op_list);
+    }
+    node = push_array(cache->arena, CTRL_ConditionCacheNode, 1);
+    node->hash = hash;
+    node->condition = push_str8_copy(cache->arena, condition);
+    node->exe_path = push_str8_copy(cache->arena, exe_path);
+    node->voff = voff;
+    node->dbgi_parse_uid = dbgi->uid;
+    node->arch = arch;
+    node->program = eval_program_from_bytecode(cache->arena, arch, push_str8_copy(cache->arena, bytecode));
+    SLLQueuePush(slot->first, slot->last, node);
+    cache->node_count += 1;
+    ins_atomic_u64_inc_eval(&cache->miss_count);
+    scratch_end(scratch);
+  }
+  else
+  {
+    ins_atomic_u64_inc_eval(&cache->hit_count);
+  }
+  
+  return &node->program;
+}
+
 //- rjf: msg kind implementations
 
 internal void
@@ -1803,7 +2751,7 @@ ctrl_thread__launch_and_init(CTRL_Msg *msg)
             if(modules.count == 0) { continue; }
             DEMON_Handle module = modules.handles[0];
             String8 exe_path = demon_full_path_from_module(scratch.arena, module);
-            DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, exe_path, max_U64);
+            DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, exe_path, DBGI_ParseTier_Full, max_U64);
             RADDBG_Parsed *rdbg = &dbgi->rdbg;
             RADDBG_NameMap *unparsed_map = raddbg_name_map_from_kind(rdbg, RADDBG_NameMapKind_Procedures);
             if(rdbg->procedures != 0 && unparsed_map != 0)
@@ -2476,44 +3424,12 @@ ctrl_thread__run(CTRL_Msg *msg)
           if(conditions.node_count != 0)
           {
             String8 exe_path = demon_full_path_from_module(temp.arena, module);
-            DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, exe_path, max_U64);
-            RADDBG_Parsed *rdbg = &dbgi->rdbg;
+            DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, exe_path, DBGI_ParseTier_Full, max_U64);
             for(String8Node *condition_n = conditions.first; condition_n != 0; condition_n = condition_n->next)
             {
-              String8 string = condition_n->string;
-              EVAL_ParseCtx parse_ctx = zero_struct;
-              {
-                parse_ctx.arch = arch;
-                parse_ctx.ip_voff = thread_rip_voff;
-                parse_ctx.rdbg = rdbg;
-                parse_ctx.type_graph = tg_graph_begin(bit_size_from_arch(arch)/8, 256);
-                parse_ctx.regs_map = ctrl_string2reg_from_arch(arch);
-                parse_ctx.reg_alias_map = ctrl_string2alias_from_arch(arch);
-                parse_ctx.locals_map = eval_push_locals_map_from_raddbg_voff(temp.arena, rdbg, thread_rip_voff);
-                parse_ctx.member_map = eval_push_member_map_from_raddbg_voff(temp.arena, rdbg, thread_rip_voff);
-              }
-              EVAL_TokenArray tokens = eval_token_array_from_text(temp.arena, string);
-              EVAL_ParseResult parse = eval_parse_expr_from_text_tokens(temp.arena, &parse_ctx, string, &tokens);
-              EVAL_ErrorList errors = parse.errors;
-              B32 parse_has_expr = (parse.expr != &eval_expr_nil);
-              B32 parse_is_type = (parse_has_expr && parse.expr->kind == EVAL_ExprKind_TypeIdent);
-              EVAL_IRTreeAndType ir_tree_and_type = {&eval_irtree_nil};
-              if(parse_has_expr && errors.count == 0)
-              {
-                ir_tree_and_type = eval_irtree_and_type_from_expr(temp.arena, parse_ctx.type_graph, rdbg, parse.expr, &errors);
-              }
-              EVAL_OpList op_list = {0};
-              if(parse_has_expr && ir_tree_and_type.tree != &eval_irtree_nil)
-              {
-                eval_oplist_from_irtree(scratch.arena, ir_tree_and_type.tree, &op_list);
-              }
-              String8 bytecode = {0};
-              if(parse_has_expr && parse_is_type == 0 && op_list.encoded_size != 0)
-              {
-                bytecode = eval_bytecode_from_oplist(scratch.arena, &op_list);
-              }
+              EVAL_Program *program = ctrl_thread__eval_program_from_condition(arch, dbgi, exe_path, thread_rip_voff, condition_n->string);
               EVAL_Result eval = {0};
-              if(bytecode.size != 0)
+              if(program->bytecode.size != 0)
               {
                 U64 module_base = demon_base_vaddr_from_module(module);
                 U64 tls_base = 0; // TODO(rjf)
@@ -2525,7 +3441,7 @@ ctrl_thread__run(CTRL_Msg *msg)
                 machine.reg_size = reg_size;
                 machine.module_base = &module_base;
                 machine.tls_base = &tls_base;
-                eval = eval_interpret(&machine, bytecode);
+                eval = eval_interpret_program(&machine, program);
               }
               if(eval.bad_eval == 0 && eval.value.u64 == 0)
               {
@@ -2799,6 +3715,12 @@ ctrl_thread__run(CTRL_Msg *msg)
     }
   }
   
+  //- snapshot the working set before reporting the stop
+  if(stop_event != 0)
+  {
+    ctrl_thread__stop_snapshot();
+  }
+  
   //- rjf: record stop
   if(stop_event != 0)
   {
@@ -2862,6 +3784,12 @@ ctrl_thread__single_step(CTRL_Msg *msg)
     }
   }
   
+  //- snapshot the working set before reporting the stop
+  if(stop_event != 0)
+  {
+    ctrl_thread__stop_snapshot();
+  }
+  
   //- rjf: record stop
   if(stop_event != 0)
   {
@@ -2948,7 +3876,24 @@ ctrl_mem_stream_thread__entry_point(void *p)
       U64 arena_size = AlignPow2(range_size + ARENA_HEADER_SIZE, KB(64));
       range_arena = arena_alloc__sized(range_size+ARENA_HEADER_SIZE, range_size+ARENA_HEADER_SIZE);
       range_base = push_array_no_zero(range_arena, U8, range_size);
-      U64 bytes_read = ctrl_process_read(machine_id, process, vaddr_range, range_base);
+      
+      // assemble from the page cache, so that overlapping & shifted
+      // ranges share reads; fall back to a direct read for ranges the page
+      // cache does not cover
+      U64 bytes_read = 0;
+      {
+        Temp scratch = scratch_begin(0, 0);
+        String8 data = ctrl_query_cached_data_from_process_vaddr_range__read_size(scratch.arena, machine_id, process, vaddr_range, &bytes_read);
+        if(data.size == range_size)
+        {
+          MemoryCopy(range_base, data.str, bytes_read);
+        }
+        else
+        {
+          bytes_read = ctrl_process_read(machine_id, process, vaddr_range, range_base);
+        }
+        scratch_end(scratch);
+      }
       if(bytes_read == 0)
       {
         arena_release(range_arena);
@@ -391,6 +391,155 @@ struct CTRL_ProcessMemoryCache
 #define CTRL_WAKEUP_FUNCTION_DEF(name) void name(void)
 typedef CTRL_WAKEUP_FUNCTION_DEF(CTRL_WakeupFunctionType);
 
+////////////////////////////////
+//~ Conditional Breakpoint Bytecode Cache Types
+//
+// Compiling a breakpoint condition (parse, type graph, locals/member maps,
+// IR, bytecode) costs far more than interpreting it, so the ctrl thread
+// caches compiled & pre-decoded bytecode (EVAL_Program) by (condition, exe,
+// ip voff, arch, debug info parse uid). Parse uids are never reused, unlike
+// binary generations, which restart when dbgi evicts a binary. The cache is
+// only touched by the ctrl thread; the hit/miss counters are read from other
+// threads.
+
+typedef struct CTRL_ConditionCacheNode CTRL_ConditionCacheNode;
+struct CTRL_ConditionCacheNode
+{
+  CTRL_ConditionCacheNode *next;
+  U64 hash;
+  String8 condition;
+  String8 exe_path;
+  U64 voff;
+  U64 dbgi_parse_uid;
+  Architecture arch;
+  EVAL_Program program;
+};
+
+typedef struct CTRL_ConditionCacheSlot CTRL_ConditionCacheSlot;
+struct CTRL_ConditionCacheSlot
+{
+  CTRL_ConditionCacheNode *first;
+  CTRL_ConditionCacheNode *last;
+};
+
+typedef struct CTRL_ConditionCache CTRL_ConditionCache;
+struct CTRL_ConditionCache
+{
+  Arena *arena;
+  U64 slots_count;
+  CTRL_ConditionCacheSlot *slots;
+  U64 node_count;
+  U64 hit_count;
+  U64 miss_count;
+};
+
+#define CTRL_CONDITION_CACHE_MAX_NODE_COUNT 4096
+
+////////////////////////////////
+//~ Stop-Time Snapshot Types
+//
+// When a run or step stops, the ctrl thread fills the process memory cache
+// with a working set before reporting the stop: the top of every thread's
+// stack, every thread's TLS block, and "hot" ranges which the user side
+// marked as recently used (e.g. watch expression memory), plus up to
+// CTRL_MEM_SNAPSHOT_STOP_REFRESH_CAP bytes of memory snapshot regions. All
+// of it is read at the new memgen index, so the first frame after a stop is
+// served from the cache. Hot ranges and snapshot regions which aren't
+// re-marked within max_hot_range_age runs are dropped.
+
+typedef struct CTRL_StopSnapshotParams CTRL_StopSnapshotParams;
+struct CTRL_StopSnapshotParams
+{
+  U64 stack_size;
+  U64 tls_size;
+  U64 max_hot_range_age;
+};
+
+typedef struct CTRL_StopSnapshotHotRange CTRL_StopSnapshotHotRange;
+struct CTRL_StopSnapshotHotRange
+{
+  CTRL_MachineID machine_id;
+  CTRL_Handle process;
+  Rng1U64 vaddr_range;
+  U64 run_idx;
+};
+
+#define CTRL_STOP_SNAPSHOT_HOT_RANGE_CAP 256
+
+typedef struct CTRL_StopSnapshotState CTRL_StopSnapshotState;
+struct CTRL_StopSnapshotState
+{
+  OS_Handle mutex;
+  CTRL_StopSnapshotParams params;
+  CTRL_StopSnapshotHotRange hot_ranges[CTRL_STOP_SNAPSHOT_HOT_RANGE_CAP];
+  U64 hot_range_count;
+};
+
+////////////////////////////////
+//~ Process Memory Snapshot Types
+//
+// For selected regions, the process memory cache keeps the last few
+// versions of each page, so memory can be diffed between memgen indices.
+// Cached pages are content-addressed in the hash store, so a version is just
+// a (memgen index, hash) pair which holds its own hash store key - unchanged
+// pages share one copy, and a new version is only recorded when a refetched
+// page's hash differs from the latest. The contents of a page at memgen M
+// are those of its newest version with memgen <= M, if the page was last
+// checked at or after M - otherwise they're unknown. Stop-time snapshots
+// refresh regions round-robin, at most CTRL_MEM_SNAPSHOT_STOP_REFRESH_CAP
+// bytes per stop, so a stop never waits on reading large regions in full;
+// pages which weren't refreshed at a stop just diff as unknown there.
+
+#define CTRL_MEM_SNAPSHOT_VERSION_COUNT 4
+#define CTRL_MEM_SNAPSHOT_REGION_MAX_SIZE MB(64)
+#define CTRL_MEM_SNAPSHOT_STOP_REFRESH_CAP MB(4)
+
+typedef struct CTRL_MemSnapshotRegion CTRL_MemSnapshotRegion;
+struct CTRL_MemSnapshotRegion
+{
+  CTRL_MemSnapshotRegion *next;
+  CTRL_MemSnapshotRegion *prev;
+  Arena *arena;
+  U64 id;
+  CTRL_MachineID machine_id;
+  CTRL_Handle process;
+  Rng1U64 vaddr_range;
+  U64 run_idx;
+  U64 page_count;
+  U64 refresh_page_cursor;
+  U8 *page_version_heads;
+  U64 *page_checked_memgen_idxs;
+  U64 *page_version_memgen_idxs;
+  U128 *page_version_hashes;
+};
+
+typedef struct CTRL_MemSnapshotState CTRL_MemSnapshotState;
+struct CTRL_MemSnapshotState
+{
+  OS_Handle rw_mutex;
+  CTRL_MemSnapshotRegion *first_region;
+  CTRL_MemSnapshotRegion *last_region;
+  U64 region_count;
+  U64 region_id_counter;
+};
+
+typedef struct CTRL_MemDiffNode CTRL_MemDiffNode;
+struct CTRL_MemDiffNode
+{
+  CTRL_MemDiffNode *next;
+  Rng1U64 vaddr_range;
+};
+
+typedef struct CTRL_MemDiff CTRL_MemDiff;
+struct CTRL_MemDiff
+{
+  CTRL_MemDiffNode *first;
+  CTRL_MemDiffNode *last;
+  U64 count;
+  U64 changed_byte_count;
+  U64 unknown_byte_count;
+};
+
 ////////////////////////////////
 //~ rjf: Main State Types
 
@@ -409,6 +558,15 @@ struct CTRL_State
   // rjf: process memory cache
   CTRL_ProcessMemoryCache process_memory_cache;
   
+  // conditional breakpoint bytecode cache
+  CTRL_ConditionCache condition_cache;
+  
+  // stop-time memory snapshot working set
+  CTRL_StopSnapshotState stop_snapshot;
+  
+  // versioned snapshot regions of process memory
+  CTRL_MemSnapshotState mem_snapshot;
+  
   // rjf: user -> ctrl msg ring buffer
   U64 u2c_ring_size;
   U8 *u2c_ring_base;
@@ -491,6 +649,8 @@ internal void ctrl_user_breakpoint_list_push(Arena *arena, CTRL_UserBreakpointLi
 internal CTRL_UserBreakpointList ctrl_user_breakpoint_list_copy(Arena *arena, CTRL_UserBreakpointList *src);
 internal void ctrl_append_resolved_module_user_bp_traps(Arena *arena, DEMON_Handle process, DEMON_Handle module, CTRL_UserBreakpointList *user_bps, DEMON_TrapChunkList *traps_out);
 internal void ctrl_append_resolved_process_user_bp_traps(Arena *arena, DEMON_Handle process, CTRL_UserBreakpointList *user_bps, DEMON_TrapChunkList *traps_out);
+internal B32 ctrl_demon_trap_condition_from_eval_program(EVAL_Program *program, U64 module_base, DEMON_TrapCondition *condition_out);
+internal DEMON_TrapCondition *ctrl_demon_trap_condition_from_user_bp(Arena *arena, Architecture arch, DBGI_Parse *dbgi, String8 exe_path, U64 base_vaddr, CTRL_UserBreakpoint *bp, U64 vaddr);
 
 ////////////////////////////////
 //~ rjf: Message Type Functions
@@ -526,6 +686,14 @@ internal U64 ctrl_memgen_idx(void);
 //- rjf: halt everything
 internal void ctrl_halt(void);
 
+//- conditional breakpoint bytecode cache stats
+internal U64 ctrl_condition_cache_hit_count(void);
+internal U64 ctrl_condition_cache_miss_count(void);
+
+//- stop-time snapshot working set
+internal void ctrl_set_stop_snapshot_params(CTRL_StopSnapshotParams *params);
+internal void ctrl_stop_snapshot_mark_hot_range(CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 vaddr_range);
+
 //- rjf: exe -> dbg path mapping
 internal String8 ctrl_inferred_og_dbg_path_from_exe_path(Arena *arena, String8 exe_path);
 internal String8 ctrl_forced_og_dbg_path_from_exe_path(Arena *arena, String8 exe_path);
@@ -537,11 +705,24 @@ internal Architecture ctrl_arch_from_handle(CTRL_MachineID machine, CTRL_Handle
 
 //- rjf: process memory reading/writing
 internal U64 ctrl_process_read(CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 range, void *dst);
+internal CTRL_ProcessMemoryCacheNode4 *ctrl_process_memory_cache_node4_from_vaddr(CTRL_ProcessMemoryCacheNode *node, U64 vaddr, B32 create);
 internal String8 ctrl_query_cached_data_from_process_vaddr_range(Arena *arena, CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 range);
+internal String8 ctrl_query_cached_data_from_process_vaddr_range__read_size(Arena *arena, CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 range, U64 *read_size_out);
 internal String8 ctrl_query_cached_zero_terminated_data_from_process_vaddr_limit(Arena *arena, CTRL_MachineID machine_id, CTRL_Handle process, U64 vaddr, U64 limit, U64 endt_us);
 internal B32 ctrl_process_write_data(CTRL_MachineID machine_id, CTRL_Handle process, U64 vaddr, String8 data);
 internal U128 ctrl_stored_hash_from_process_vaddr_range(CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 range, B32 zero_terminated);
 
+//- process memory snapshot regions & diffing
+internal U128 ctrl_mem_snapshot_key_from_page_version(CTRL_MemSnapshotRegion *region, U64 page_idx, U64 version_idx);
+internal B32 ctrl_mem_snapshot_region_add(CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 vaddr_range);
+internal void ctrl_mem_snapshot_region_remove(CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 vaddr_range);
+internal void ctrl_mem_snapshot_region_release(CTRL_MemSnapshotRegion *region);
+internal void ctrl_mem_snapshot_commit_pages(CTRL_MachineID machine_id, CTRL_Handle process, U64 memgen_idx, U64 *page_vaddrs, U128 *page_hashes, U64 page_count);
+internal U128 ctrl_mem_snapshot_hash_from_region_page_memgen(CTRL_MemSnapshotRegion *region, U64 page_idx, U64 memgen_idx);
+internal void ctrl_mem_diff_push(Arena *arena, CTRL_MemDiff *diff, Rng1U64 vaddr_range);
+internal void ctrl_mem_diff_push_changed_bytes(Arena *arena, CTRL_MemDiff *diff, U64 base_vaddr, U8 *a, U8 *b, U64 size);
+internal CTRL_MemDiff ctrl_mem_diff_from_process_vaddr_range(Arena *arena, CTRL_MachineID machine_id, CTRL_Handle process, Rng1U64 vaddr_range, U64 memgen_idx_a, U64 memgen_idx_b);
+
 //- rjf: register reading/writing
 internal void *ctrl_reg_block_from_thread(CTRL_MachineID machine_id, CTRL_Handle thread);
 internal B32 ctrl_thread_write_reg_block(CTRL_MachineID machine_id, CTRL_Handle thread, void *block);
@@ -582,6 +763,11 @@ internal DEMON_Event *ctrl_thread__next_demon_event(Arena *arena, CTRL_Msg *msg,
 
 //- rjf: eval helpers
 internal B32 ctrl_eval_memory_read(void *u, void *out, U64 addr, U64 size);
+internal EVAL_Program *ctrl_thread__eval_program_from_condition(Architecture arch, DBGI_Parse *dbgi, String8 exe_path, U64 voff, String8 condition);
+
+//- stop-time snapshot
+internal int ctrl_thread__qsort_compare_ranges(Rng1U64 *a, Rng1U64 *b);
+internal void ctrl_thread__stop_snapshot(void);
 
 //- rjf: msg kind implementations
 internal void ctrl_thread__launch_and_handshake(CTRL_Msg *msg);
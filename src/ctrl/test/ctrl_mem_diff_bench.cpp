@@ -0,0 +1,237 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ process memory snapshot diff benchmark
+//
+// Simulates a run of stops over one maximum-size snapshot region: each stop
+// dirties a few bytes in a small number of pages, submits every page to the
+// hash store the way the page cache fill does, and commits the page versions.
+// Then it times the diff between the last two stops three ways - through
+// ctrl_mem_diff_from_process_vaddr_range (skips pages by version hash), by
+// running ctrl_mem_diff_push_changed_bytes over the whole region, and with a
+// plain byte loop - and checks all three agree on the changed byte count.
+
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "task_system/task_system.h"
+#include "mdesk/mdesk.h"
+#include "hash_store/hash_store.h"
+#include "text_cache/text_cache.h"
+#include "path/path.h"
+#include "txti/txti.h"
+#include "coff/coff.h"
+#include "pe/pe.h"
+#include "raddbg_format/raddbg_format.h"
+#include "raddbg_format/raddbg_format_parse.h"
+#include "raddbg_cons/raddbg_cons.h"
+#include "raddbg_convert/pdb/raddbg_coff.h"
+#include "raddbg_convert/pdb/raddbg_codeview.h"
+#include "raddbg_convert/pdb/raddbg_msf.h"
+#include "raddbg_convert/pdb/raddbg_pdb.h"
+#include "raddbg_convert/pdb/raddbg_coff_conversion.h"
+#include "raddbg_convert/pdb/raddbg_codeview_conversion.h"
+#include "raddbg_convert/pdb/raddbg_from_pdb.h"
+#include "raddbg_convert/pdb/raddbg_codeview_stringize.h"
+#include "raddbg_convert/pdb/raddbg_pdb_stringize.h"
+#include "raddbg_convert/dwarf/raddbg_elf.h"
+#include "raddbg_convert/dwarf/raddbg_dwarf.h"
+#include "raddbg_convert/dwarf/raddbg_from_dwarf.h"
+#include "regs/regs.h"
+#include "regs/raddbg/regs_raddbg.h"
+#include "type_graph/type_graph.h"
+#include "dbgi/dbgi.h"
+#include "demon/demon_inc.h"
+#include "eval/eval_compiler.h"
+#include "eval/eval_machine.h"
+#include "eval/eval_parser.h"
+#include "unwind/unwind.h"
+#include "ctrl/ctrl_inc.h"
+
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "task_system/task_system.c"
+#include "mdesk/mdesk.c"
+#include "hash_store/hash_store.c"
+#include "text_cache/text_cache.c"
+#include "path/path.c"
+#include "txti/txti.c"
+#include "coff/coff.c"
+#include "pe/pe.c"
+#include "raddbg_format/raddbg_format.c"
+#include "raddbg_format/raddbg_format_parse.c"
+#include "raddbg_cons/raddbg_cons.c"
+#include "raddbg_convert/pdb/raddbg_msf.c"
+#include "raddbg_convert/pdb/raddbg_codeview.c"
+#include "raddbg_convert/pdb/raddbg_pdb.c"
+#include "raddbg_convert/pdb/raddbg_coff_conversion.c"
+#include "raddbg_convert/pdb/raddbg_codeview_conversion.c"
+#include "raddbg_convert/pdb/raddbg_codeview_stringize.c"
+#include "raddbg_convert/pdb/raddbg_pdb_stringize.c"
+#include "raddbg_convert/pdb/raddbg_from_pdb.c"
+#include "raddbg_convert/dwarf/raddbg_elf.c"
+#include "raddbg_convert/dwarf/raddbg_dwarf.c"
+#include "raddbg_convert/dwarf/raddbg_from_dwarf.c"
+#include "regs/regs.c"
+#include "regs/raddbg/regs_raddbg.c"
+#include "type_graph/type_graph.c"
+#include "dbgi/dbgi.c"
+#include "demon/demon_inc.c"
+#include "eval/eval_compiler.c"
+#include "eval/eval_machine.c"
+#include "eval/eval_parser.c"
+#include "unwind/unwind.c"
+#include "ctrl/ctrl_inc.c"
+
+#define BENCH_REGION_BASE        0x10000000ull
+#define BENCH_REGION_SIZE        CTRL_MEM_SNAPSHOT_REGION_MAX_SIZE
+#define BENCH_PAGE_COUNT         (BENCH_REGION_SIZE/KB(4))
+#define BENCH_STOP_COUNT         8
+#define BENCH_DIRTY_PAGES        64
+#define BENCH_DIRTY_BYTES        24
+#define BENCH_DIFF_REPEAT_COUNT  16
+
+//- simulated stop: dirty pages, then submit & commit every page
+
+internal U64
+bench_rng_next(U64 *state)
+{
+  U64 x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  *state = x;
+  return x;
+}
+
+internal void
+bench_stop(CTRL_Handle process, U8 *memory, U64 memgen_idx, U64 *rng, U64 *page_vaddrs, U128 *page_hashes)
+{
+  for(U64 dirty_idx = 0; dirty_idx < BENCH_DIRTY_PAGES; dirty_idx += 1)
+  {
+    U64 page_idx = bench_rng_next(rng)%BENCH_PAGE_COUNT;
+    U64 off = bench_rng_next(rng)%(KB(4) - BENCH_DIRTY_BYTES);
+    for(U64 byte_idx = 0; byte_idx < BENCH_DIRTY_BYTES; byte_idx += 1)
+    {
+      memory[page_idx*KB(4) + off + byte_idx] += 1;
+    }
+  }
+  for(U64 page_idx = 0; page_idx < BENCH_PAGE_COUNT; page_idx += 1)
+  {
+    U64 page_vaddr = BENCH_REGION_BASE + page_idx*KB(4);
+    Arena *page_arena = arena_alloc__sized(KB(8), KB(8));
+    U8 *page_base = push_array_no_zero(page_arena, U8, KB(4));
+    MemoryCopy(page_base, memory + page_idx*KB(4), KB(4));
+    U64 page_key_data[] =
+    {
+      (U64)CTRL_MachineID_Client,
+      (U64)process.u64[0],
+      page_vaddr,
+      page_vaddr+KB(4),
+    };
+    U128 page_key = hs_hash_from_data(str8((U8 *)page_key_data, sizeof(page_key_data)));
+    page_vaddrs[page_idx] = page_vaddr;
+    page_hashes[page_idx] = hs_submit_data(page_key, &page_arena, str8(page_base, KB(4)));
+  }
+  ctrl_mem_snapshot_commit_pages(CTRL_MachineID_Client, process, memgen_idx, page_vaddrs, page_hashes, BENCH_PAGE_COUNT);
+}
+
+int
+main(int argc, char **argv)
+{
+  local_persist TCTX main_thread_tctx = {0};
+  tctx_init_and_equip(&main_thread_tctx);
+  Arena *arena = arena_alloc();
+  hs_init();
+  
+  //- only the snapshot state of the ctrl layer is needed
+  ctrl_state = push_array(arena, CTRL_State, 1);
+  ctrl_state->arena = arena;
+  ctrl_state->mem_snapshot.rw_mutex = os_rw_mutex_alloc();
+  
+  //- setup region & simulate stops
+  CTRL_Handle process = {0};
+  process.u64[0] = 1;
+  Rng1U64 region_range = r1u64(BENCH_REGION_BASE, BENCH_REGION_BASE + BENCH_REGION_SIZE);
+  ctrl_mem_snapshot_region_add(CTRL_MachineID_Client, process, region_range);
+  U8 *memory = push_array(arena, U8, BENCH_REGION_SIZE);
+  U8 *prev_memory = push_array_no_zero(arena, U8, BENCH_REGION_SIZE);
+  U64 *page_vaddrs = push_array_no_zero(arena, U64, BENCH_PAGE_COUNT);
+  U128 *page_hashes = push_array_no_zero(arena, U128, BENCH_PAGE_COUNT);
+  U64 rng = 0x2545F4914F6CDD1Dull;
+  for(U64 page_idx = 0; page_idx < BENCH_PAGE_COUNT; page_idx += 1)
+  {
+    for(U64 off = 0; off < KB(4); off += 8)
+    {
+      *(U64 *)(memory + page_idx*KB(4) + off) = bench_rng_next(&rng);
+    }
+  }
+  U64 commit_us = 0;
+  for(U64 stop_idx = 1; stop_idx <= BENCH_STOP_COUNT; stop_idx += 1)
+  {
+    MemoryCopy(prev_memory, memory, BENCH_REGION_SIZE);
+    U64 begin_us = os_now_microseconds();
+    bench_stop(process, memory, stop_idx, &rng, page_vaddrs, page_hashes);
+    commit_us += os_now_microseconds() - begin_us;
+  }
+  
+  //- time diffs between the last two stops
+  U64 snapshot_us = 0;
+  U64 snapshot_changed = 0;
+  U64 snapshot_unknown = 0;
+  U64 full_simd_us = 0;
+  U64 full_simd_changed = 0;
+  U64 scalar_us = 0;
+  U64 scalar_changed = 0;
+  for(U64 repeat_idx = 0; repeat_idx < BENCH_DIFF_REPEAT_COUNT; repeat_idx += 1)
+  {
+    Temp temp = temp_begin(arena);
+    
+    // snapshot diff
+    {
+      U64 begin_us = os_now_microseconds();
+      CTRL_MemDiff diff = ctrl_mem_diff_from_process_vaddr_range(temp.arena, CTRL_MachineID_Client, process, region_range, BENCH_STOP_COUNT-1, BENCH_STOP_COUNT);
+      snapshot_us += os_now_microseconds() - begin_us;
+      snapshot_changed = diff.changed_byte_count;
+      snapshot_unknown = diff.unknown_byte_count;
+    }
+    
+    // full-region SIMD compare
+    {
+      U64 begin_us = os_now_microseconds();
+      CTRL_MemDiff diff = {0};
+      ctrl_mem_diff_push_changed_bytes(temp.arena, &diff, BENCH_REGION_BASE, prev_memory, memory, BENCH_REGION_SIZE);
+      full_simd_us += os_now_microseconds() - begin_us;
+      full_simd_changed = diff.changed_byte_count;
+    }
+    
+    // full-region byte loop
+    {
+      U64 begin_us = os_now_microseconds();
+      U64 changed = 0;
+      for(U64 idx = 0; idx < BENCH_REGION_SIZE; idx += 1)
+      {
+        changed += (prev_memory[idx] != memory[idx]);
+      }
+      scalar_us += os_now_microseconds() - begin_us;
+      scalar_changed = changed;
+    }
+    
+    temp_end(temp);
+  }
+  
+  //- report
+  B32 good = (snapshot_unknown == 0 && snapshot_changed == scalar_changed && full_simd_changed == scalar_changed);
+  printf("region: %llu MB, %llu stops, %llu dirty pages/stop, commit %.1f ms/stop\n",
+         BENCH_REGION_SIZE/MB(1), (U64)BENCH_STOP_COUNT, (U64)BENCH_DIRTY_PAGES, (F64)commit_us/(1000.0*BENCH_STOP_COUNT));
+  printf("%-12s %14s %14s\n", "path", "us/diff", "changed bytes");
+  printf("%-12s %14.1f %14llu\n", "snapshot",  (F64)snapshot_us/BENCH_DIFF_REPEAT_COUNT,  snapshot_changed);
+  printf("%-12s %14.1f %14llu\n", "full simd", (F64)full_simd_us/BENCH_DIFF_REPEAT_COUNT, full_simd_changed);
+  printf("%-12s %14.1f %14llu\n", "scalar",    (F64)scalar_us/BENCH_DIFF_REPEAT_COUNT,    scalar_changed);
+  if(!good)
+  {
+    printf("MISMATCH (unknown bytes: %llu)\n", snapshot_unknown);
+  }
+  
+  return good ? 0 : 1;
+}
@@ -38,6 +38,7 @@ dbgi_init(void)
   dbgi_shared->p2u_ring_cv = os_condition_variable_alloc();
   dbgi_shared->p2u_ring_size = KB(64);
   dbgi_shared->p2u_ring_base = push_array_no_zero(arena, U8, dbgi_shared->p2u_ring_size);
+  dbgi_shared->cache_dir_mutex = os_mutex_alloc();
   dbgi_shared->parse_thread_count = Max(os_logical_core_count()-1, 1);
   dbgi_shared->parse_threads = push_array(arena, OS_Handle, dbgi_shared->parse_thread_count);
   for(U64 idx = 0; idx < dbgi_shared->parse_thread_count; idx += 1)
@@ -75,6 +76,251 @@ dbgi_hash_from_string(String8 string)
   return result;
 }
 
+////////////////////////////////
+//~ Debug Info Identity Functions
+
+internal B32
+dbgi_dbg_identity_is_zero(DBGI_DbgIdentity *identity)
+{
+  DBGI_DbgIdentity zero = {0};
+  B32 result = MemoryMatchStruct(identity, &zero);
+  return result;
+}
+
+internal B32
+dbgi_dbg_identity_match(DBGI_DbgIdentity *a, DBGI_DbgIdentity *b)
+{
+  B32 result = MemoryMatchStruct(a, b);
+  return result;
+}
+
+internal DBGI_DbgIdentity
+dbgi_dbg_identity_from_pdb_data(String8 data)
+{
+  // NOTE: only the leading blocks of the info & DBI streams are read, so
+  // this stays cheap for arbitrarily large PDBs. the age is the DBI's, which
+  // is the one an exe's debug directory refers to.
+  DBGI_DbgIdentity result = {0};
+  String8 info_data = msf_stream_first_block_from_data(data, PDB_FixedStream_PdbInfo);
+  String8 dbi_data = msf_stream_first_block_from_data(data, PDB_FixedStream_Dbi);
+  if(info_data.size >= sizeof(PDB_InfoHeader) + sizeof(COFF_Guid) &&
+     dbi_data.size >= sizeof(PDB_DbiHeader))
+  {
+    PDB_InfoHeader *info_header = (PDB_InfoHeader *)info_data.str;
+    PDB_DbiHeader *dbi_header = (PDB_DbiHeader *)dbi_data.str;
+    if(info_header->version >= PDB_Version_VC70_DEP &&
+       dbi_header->sig == PDB_DbiHeaderSignature_V1)
+    {
+      MemoryCopy(result.guid, info_data.str + sizeof(PDB_InfoHeader), sizeof(result.guid));
+      result.age = dbi_header->age;
+    }
+  }
+  return result;
+}
+
+internal DBGI_DbgIdentity
+dbgi_dbg_identity_from_elf_data(String8 data)
+{
+  // NOTE: only the header & section table are parsed, so this stays
+  // cheap for arbitrarily large ELF files.
+  DBGI_DbgIdentity result = {0};
+  Temp scratch = scratch_begin(0, 0);
+  ELF_Parsed *elf = elf_parsed_from_data(scratch.arena, data);
+  String8 build_id = elf_gnu_build_id_from_elf(elf);
+  if(build_id.size != 0)
+  {
+    dwarfconv_guid_age_from_build_id(build_id, result.guid, &result.age);
+  }
+  scratch_end(scratch);
+  return result;
+}
+
+internal DBGI_DbgIdentity
+dbgi_dbg_identity_from_raddbg_path(String8 path)
+{
+  DBGI_DbgIdentity result = {0};
+  RADDBG_Header header = {0};
+  OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_Shared, path);
+  U64 read_size = os_file_read(file, r1u64(0, sizeof(header)), &header);
+  os_file_close(file);
+  if(read_size == sizeof(header) &&
+     header.magic == RADDBG_MAGIC_CONSTANT &&
+     header.encoding_version == RADDBG_ENCODING_VERSION)
+  {
+    MemoryCopy(result.guid, header.dbg_guid, sizeof(result.guid));
+    result.age = header.dbg_age;
+  }
+  return result;
+}
+
+internal B32
+dbgi_raddbg_file_is_intact(String8 path)
+{
+  // NOTE: a conversion killed mid-write could leave a file whose header is
+  // fine but whose data is cut off - so its whole layout must parse, & all
+  // data sections must lie within the file
+  B32 result = 0;
+  OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_Shared, path);
+  OS_Handle file_map = os_file_map_open(OS_AccessFlag_Read, file);
+  FileProperties props = os_properties_from_file(file);
+  void *base = os_file_map_view_open(file_map, OS_AccessFlag_Read, r1u64(0, props.size));
+  if(base != 0)
+  {
+    RADDBG_Parsed parsed = {0};
+    if(raddbg_parse((U8 *)base, props.size, &parsed) == RADDBG_ParseStatus_Good)
+    {
+      result = 1;
+      for(U64 idx = 0; idx < parsed.dsec_count; idx += 1)
+      {
+        if(parsed.dsecs[idx].off + parsed.dsecs[idx].encoded_size > props.size)
+        {
+          result = 0;
+          break;
+        }
+      }
+    }
+    os_file_map_view_close(file_map, base);
+  }
+  os_file_map_close(file_map);
+  os_file_close(file);
+  return result;
+}
+
+////////////////////////////////
+//~ Shared RADDBG Cache Functions
+
+internal void
+dbgi_set_cache_dir(String8 cache_dir)
+{
+  if(cache_dir.size != 0 && !os_make_directory(cache_dir) && !os_file_path_exists(cache_dir))
+  {
+    cache_dir = str8_zero();
+  }
+  OS_MutexScope(dbgi_shared->cache_dir_mutex)
+  {
+    dbgi_shared->cache_dir_size = Min(cache_dir.size, sizeof(dbgi_shared->cache_dir_buffer));
+    MemoryCopy(dbgi_shared->cache_dir_buffer, cache_dir.str, dbgi_shared->cache_dir_size);
+  }
+}
+
+internal String8
+dbgi_cache_dir(Arena *arena)
+{
+  String8 result = {0};
+  OS_MutexScope(dbgi_shared->cache_dir_mutex)
+  {
+    result = push_str8_copy(arena, str8(dbgi_shared->cache_dir_buffer, dbgi_shared->cache_dir_size));
+  }
+  return result;
+}
+
+internal String8
+dbgi_cache_raddbg_path_from_og_dbg_path(Arena *arena, String8 cache_dir, String8 og_dbg_path, DBGI_DbgIdentity *identity)
+{
+  // NOTE: keyed like a symbol server - "<dir>/foo_<GUID><AGE>.raddbg" -
+  // so identical debug info found in any number of build trees shares one
+  // conversion.
+  Temp scratch = scratch_begin(&arena, 1);
+  String8List key_parts = {0};
+  for(U64 idx = 0; idx < ArrayCount(identity->guid); idx += 1)
+  {
+    str8_list_pushf(scratch.arena, &key_parts, "%02X", identity->guid[idx]);
+  }
+  str8_list_pushf(scratch.arena, &key_parts, "%X", identity->age);
+  String8 key = str8_list_join(scratch.arena, &key_parts, 0);
+  String8 name = str8_chop_last_dot(str8_skip_last_slash(og_dbg_path));
+  String8 result = push_str8f(arena, "%S/%S_%S.raddbg", cache_dir, name, key);
+  scratch_end(scratch);
+  return result;
+}
+
+internal B32
+dbgi_write_raddbg_file(String8 raddbg_path, String8List data)
+{
+  // NOTE: conversions are written to a unique temp file which is then renamed
+  // into place, so a killed conversion never leaves a partial file at the
+  // final path, & concurrent writers of one path each publish a whole file
+  Temp scratch = scratch_begin(0, 0);
+  U64 tmp_idx = ins_atomic_u64_inc_eval(&dbgi_shared->tmp_file_counter);
+  String8 tmp_path = push_str8f(scratch.arena, "%S.%i.%I64u.tmp", raddbg_path, os_get_pid(), tmp_idx);
+  B32 result = os_write_data_list_to_file_path(tmp_path, data);
+  if(result)
+  {
+    result = os_move_file_path(raddbg_path, tmp_path);
+  }
+  if(!result)
+  {
+    os_delete_file_at_path(tmp_path);
+  }
+  scratch_end(scratch);
+  return result;
+}
+
+////////////////////////////////
+//~ ELF Separate Debug File Lookup
+
+internal String8
+dbgi_elf_dbg_path_from_exe_path(Arena *arena, String8 exe_path, String8 exe_data)
+{
+  String8 result = exe_path;
+  Temp scratch = scratch_begin(&arena, 1);
+  ELF_Parsed *elf = elf_parsed_from_data(scratch.arena, exe_data);
+  DWARF_Parsed *dwarf = dwarf_parsed_from_elf(scratch.arena, elf);
+  
+  //- exe has no DWARF of its own? look for a separate debug file - first
+  // by build id, then by .gnu_debuglink, in the places gdb looks
+  if(elf != 0 && dwarf != 0 && dwarf->debug_data[DWARF_SectionCode_Info].size == 0)
+  {
+    String8 build_id = elf_gnu_build_id_from_elf(elf);
+    ELF_GnuDebugLink debuglink = elf_gnu_debuglink_from_elf(elf);
+    String8List candidates = {0};
+    if(build_id.size >= 2)
+    {
+      String8List hex_parts = {0};
+      for(U64 idx = 1; idx < build_id.size; idx += 1)
+      {
+        str8_list_pushf(scratch.arena, &hex_parts, "%02x", build_id.str[idx]);
+      }
+      String8 hex = str8_list_join(scratch.arena, &hex_parts, 0);
+      str8_list_pushf(scratch.arena, &candidates, "/usr/lib/debug/.build-id/%02x/%S.debug", build_id.str[0], hex);
+    }
+    if(debuglink.name.size != 0)
+    {
+      String8 exe_folder = str8_chop_last_slash(exe_path);
+      str8_list_pushf(scratch.arena, &candidates, "%S/%S", exe_folder, debuglink.name);
+      str8_list_pushf(scratch.arena, &candidates, "%S/.debug/%S", exe_folder, debuglink.name);
+      str8_list_pushf(scratch.arena, &candidates, "/usr/lib/debug%S/%S", exe_folder, debuglink.name);
+    }
+    
+    //- take the first candidate with a matching build id. the debuglink
+    // CRC is not checked - that would read the whole, possibly multi-GB, file.
+    for(String8Node *n = candidates.first; n != 0; n = n->next)
+    {
+      FileProperties props = os_properties_from_file_path(n->string);
+      if(props.modified == 0 || props.size == 0 || props.flags & FilePropertyFlag_IsFolder)
+      {
+        continue;
+      }
+      B32 build_id_matches = 1;
+      if(build_id.size != 0)
+      {
+        OS_FileView view = os_file_view_open(n->string);
+        ELF_Parsed *candidate_elf = elf_parsed_from_data(scratch.arena, view.data);
+        build_id_matches = str8_match(elf_gnu_build_id_from_elf(candidate_elf), build_id, 0);
+        os_file_view_close(&view);
+      }
+      if(build_id_matches)
+      {
+        result = push_str8_copy(arena, n->string);
+        break;
+      }
+    }
+  }
+  
+  scratch_end(scratch);
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Forced Override Cache Functions
 
@@ -262,7 +508,7 @@ dbgi_binary_close(String8 exe_path)
 }
 
 internal DBGI_Parse *
-dbgi_parse_from_exe_path(DBGI_Scope *scope, String8 exe_path, U64 endt_us)
+dbgi_parse_from_exe_path(DBGI_Scope *scope, String8 exe_path, DBGI_ParseTier min_tier, U64 endt_us)
 {
   Temp scratch = scratch_begin(0, 0);
   exe_path = path_normalized_from_string(scratch.arena, exe_path);
@@ -285,17 +531,30 @@ dbgi_parse_from_exe_path(DBGI_Scope *scope, String8 exe_path, U64 endt_us)
           break;
         }
       }
+      
+      // a publics-only parse may be read by callers which can make do with
+      // it while the full parse is still in flight, up until the parse
+      // thread is ready to swap it out. once nothing is in flight, the
+      // stored parse is the best there is, whatever its tier.
+      B32 parse_is_readable = 0;
+      if(binary != 0 && binary->parse.gen == binary->gen)
+      {
+        parse_is_readable = (!(binary->flags & DBGI_BinaryFlag_ParseInFlight) ||
+                             (binary->parse.tier == DBGI_ParseTier_Publics &&
+                              min_tier <= DBGI_ParseTier_Publics &&
+                              !(binary->flags & DBGI_BinaryFlag_ParseSwapPending)));
+      }
+      if(parse_is_readable)
+      {
+        dbgi_scope_touch_binary__stripe_mutex_r_guarded(scope, binary);
+        parse = &binary->parse;
+        break;
+      }
       if(binary != 0 && !(binary->flags & DBGI_BinaryFlag_ParseInFlight))
       {
-        if(binary->parse.gen == binary->gen)
-        {
-          dbgi_scope_touch_binary__stripe_mutex_r_guarded(scope, binary);
-          parse = &binary->parse;
-          break;
-        }
-        else if(!sent &&
-                os_now_microseconds() >= ins_atomic_u64_eval(&binary->last_time_enqueued_for_parse_us)+1000000 &&
-                dbgi_u2p_enqueue_exe_path(exe_path, endt_us))
+        if(!sent &&
+           os_now_microseconds() >= ins_atomic_u64_eval(&binary->last_time_enqueued_for_parse_us)+1000000 &&
+           dbgi_u2p_enqueue_exe_path(exe_path, endt_us))
         {
           sent = 1;
           ins_atomic_u64_eval_assign(&binary->last_time_enqueued_for_parse_us, os_now_microseconds());
@@ -312,6 +571,16 @@ dbgi_parse_from_exe_path(DBGI_Scope *scope, String8 exe_path, U64 endt_us)
   return parse;
 }
 
+//- bumped by every parse stored, so users can tell when results which
+// depended on a missing parse are worth recomputing
+
+internal U64
+dbgi_parse_gen(void)
+{
+  U64 result = ins_atomic_u64_eval(&dbgi_shared->parse_uid_gen);
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Analysis Threads
 
@@ -367,6 +636,27 @@ dbgi_u2p_dequeue_exe_path(Arena *arena)
   return result;
 }
 
+internal U64
+dbgi_p2u_size_from_event(DBGI_Event *event)
+{
+  U64 size = sizeof(DBGI_EventKind) + sizeof(U64)*5 + event->string.size;
+  return size;
+}
+
+internal void
+dbgi_p2u_write_event__ring_mutex_guarded(DBGI_Event *event)
+{
+  dbgi_shared->p2u_ring_write_pos += ring_write_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_write_pos, &event->kind);
+  dbgi_shared->p2u_ring_write_pos += ring_write_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_write_pos, &event->bytes_processed);
+  dbgi_shared->p2u_ring_write_pos += ring_write_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_write_pos, &event->bytes_total);
+  dbgi_shared->p2u_ring_write_pos += ring_write_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_write_pos, &event->units_processed);
+  dbgi_shared->p2u_ring_write_pos += ring_write_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_write_pos, &event->units_total);
+  dbgi_shared->p2u_ring_write_pos += ring_write_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_write_pos, &event->string.size);
+  dbgi_shared->p2u_ring_write_pos += ring_write(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_write_pos, event->string.str, event->string.size);
+  dbgi_shared->p2u_ring_write_pos += 7;
+  dbgi_shared->p2u_ring_write_pos -= dbgi_shared->p2u_ring_write_pos%8;
+}
+
 internal void
 dbgi_p2u_push_event(DBGI_Event *event)
 {
@@ -374,14 +664,10 @@ dbgi_p2u_push_event(DBGI_Event *event)
   {
     U64 unconsumed_size = (dbgi_shared->p2u_ring_write_pos-dbgi_shared->p2u_ring_read_pos);
     U64 available_size = dbgi_shared->p2u_ring_size-unconsumed_size;
-    U64 needed_size = sizeof(DBGI_EventKind) + sizeof(U64) + event->string.size;
+    U64 needed_size = dbgi_p2u_size_from_event(event);
     if(available_size >= needed_size)
     {
-      dbgi_shared->p2u_ring_write_pos += ring_write_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_write_pos, &event->kind);
-      dbgi_shared->p2u_ring_write_pos += ring_write_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_write_pos, &event->string.size);
-      dbgi_shared->p2u_ring_write_pos += ring_write(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_write_pos, event->string.str, event->string.size);
-      dbgi_shared->p2u_ring_write_pos += 7;
-      dbgi_shared->p2u_ring_write_pos -= dbgi_shared->p2u_ring_write_pos%8;
+      dbgi_p2u_write_event__ring_mutex_guarded(event);
       break;
     }
     os_condition_variable_wait(dbgi_shared->p2u_ring_cv, dbgi_shared->p2u_ring_mutex, max_U64);
@@ -396,12 +682,16 @@ dbgi_p2u_pop_events(Arena *arena, U64 endt_us)
   OS_MutexScope(dbgi_shared->p2u_ring_mutex) for(;;)
   {
     U64 unconsumed_size = (dbgi_shared->p2u_ring_write_pos-dbgi_shared->p2u_ring_read_pos);
-    if(unconsumed_size >= sizeof(DBGI_EventKind) + sizeof(U64))
+    if(unconsumed_size >= sizeof(DBGI_EventKind) + sizeof(U64)*5)
     {
       DBGI_EventNode *n = push_array(arena, DBGI_EventNode, 1);
       SLLQueuePush(events.first, events.last, n);
       events.count += 1;
       dbgi_shared->p2u_ring_read_pos += ring_read_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_read_pos, &n->v.kind);
+      dbgi_shared->p2u_ring_read_pos += ring_read_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_read_pos, &n->v.bytes_processed);
+      dbgi_shared->p2u_ring_read_pos += ring_read_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_read_pos, &n->v.bytes_total);
+      dbgi_shared->p2u_ring_read_pos += ring_read_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_read_pos, &n->v.units_processed);
+      dbgi_shared->p2u_ring_read_pos += ring_read_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_read_pos, &n->v.units_total);
       dbgi_shared->p2u_ring_read_pos += ring_read_struct(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_read_pos, &n->v.string.size);
       n->v.string.str = push_array_no_zero(arena, U8, n->v.string.size);
       dbgi_shared->p2u_ring_read_pos += ring_read(dbgi_shared->p2u_ring_base, dbgi_shared->p2u_ring_size, dbgi_shared->p2u_ring_read_pos, n->v.string.str, n->v.string.size);
@@ -418,6 +708,150 @@ dbgi_p2u_pop_events(Arena *arena, U64 endt_us)
   return events;
 }
 
+internal CONS_PROGRESS_FUNCTION_DEF(dbgi_conversion_progress_hook)
+{
+  // NOTE: this is called on task workers, which the UI thread may be helping
+  // to drain, so it must never wait on the event ring - progress events are
+  // dropped instead when the ring is over half full. cumulative counts from
+  // several workers can also arrive out of order, so each counter only ever
+  // moves forward.
+  DBGI_ConversionProgress *progress = (DBGI_ConversionProgress *)user;
+  B32 pushed = 0;
+  OS_MutexScope(dbgi_shared->p2u_ring_mutex)
+  {
+    U64 next_bytes_processed = Max(progress->bytes_processed, bytes_processed);
+    U64 next_units_processed = Max(progress->units_processed, units_processed);
+    DBGI_Event event = {DBGI_EventKind_ConversionProgress};
+    event.string = progress->raddbg_path;
+    event.bytes_processed = next_bytes_processed;
+    event.bytes_total = bytes_total;
+    event.units_processed = next_units_processed;
+    event.units_total = units_total;
+    U64 unconsumed_size = (dbgi_shared->p2u_ring_write_pos-dbgi_shared->p2u_ring_read_pos);
+    U64 needed_size = dbgi_p2u_size_from_event(&event);
+    if((next_bytes_processed != progress->bytes_processed || next_units_processed != progress->units_processed) &&
+       unconsumed_size + needed_size <= dbgi_shared->p2u_ring_size/2)
+    {
+      progress->bytes_processed = next_bytes_processed;
+      progress->units_processed = next_units_processed;
+      dbgi_p2u_write_event__ring_mutex_guarded(&event);
+      pushed = 1;
+    }
+  }
+  if(pushed)
+  {
+    os_condition_variable_broadcast(dbgi_shared->p2u_ring_cv);
+  }
+}
+
+internal B32
+dbgi_convert_og_dbg(Arena *arena, DBGI_ParseTier tier, B32 og_dbg_is_pdb, String8 exe_path, String8 exe_data, String8 og_dbg_path, String8 raddbg_path, String8 *data_out)
+{
+  ProfBeginFunction();
+  B32 result = 0;
+  B32 is_full = (tier == DBGI_ParseTier_Full);
+  Arena *conv_arena = arena_alloc();
+  OS_FileView og_dbg_view = os_file_view_open(og_dbg_path);
+  DBGI_ConversionProgress *progress = push_array(conv_arena, DBGI_ConversionProgress, 1);
+  progress->raddbg_path = raddbg_path;
+  
+  //- convert; the full tier fans its work out over the task system & reports
+  // progress, the publics tier is cheap enough to run on this thread
+  B32 good_parse = 0;
+  CONS_Root *root = 0;
+  if(og_dbg_is_pdb)
+  {
+    PDBCONV_Params *params = push_array(conv_arena, PDBCONV_Params, 1);
+    params->input_pdb_name = og_dbg_path;
+    params->input_pdb_data = og_dbg_view.data;
+    params->input_exe_name = exe_path;
+    params->input_exe_data = exe_data;
+    params->output_name = raddbg_path;
+    params->thread_count = is_full ? ts_thread_count() : 1;
+    if(is_full)
+    {
+      params->progress_func = dbgi_conversion_progress_hook;
+      params->progress_user = progress;
+    }
+    if(params->input_pdb_data.size == 0)
+    {
+      str8_list_pushf(conv_arena, &params->errors, "could not load input file '%S'", og_dbg_path);
+    }
+    PDBCONV_Out *out = (is_full ? pdbconv_convert(conv_arena, params) : pdbconv_convert_publics(conv_arena, params));
+    good_parse = out->good_parse;
+    root = out->root;
+  }
+  else
+  {
+    // NOTE: when the DWARF lives in a separate debug file, the exe still
+    // supplies the sections & build id
+    DWARFCONV_Params *params = push_array(conv_arena, DWARFCONV_Params, 1);
+    params->input_elf_name = og_dbg_path;
+    params->input_elf_data = og_dbg_view.data;
+    params->input_exe_name = exe_path;
+    params->input_exe_data = exe_data;
+    params->output_name = raddbg_path;
+    params->thread_count = is_full ? ts_thread_count() : 1;
+    params->unit_idx_max = max_U64;
+    if(is_full)
+    {
+      params->progress_func = dbgi_conversion_progress_hook;
+      params->progress_user = progress;
+    }
+    if(params->input_elf_data.size == 0)
+    {
+      str8_list_pushf(conv_arena, &params->errors, "could not load input file '%S'", og_dbg_path);
+    }
+    DWARFCONV_Out *out = (is_full ? dwarfconv_convert_elf(conv_arena, params) : dwarfconv_convert_publics(conv_arena, params));
+    good_parse = out->good_parse;
+    root = out->root;
+  }
+  
+  //- bake; the full tier is published at raddbg_path, the publics tier is
+  // joined into one contiguous block on arena, so it can be parsed in-place
+  if(good_parse && root != 0)
+  {
+    String8List baked = {0};
+    cons_bake_file(conv_arena, root, &baked);
+    if(is_full)
+    {
+      result = dbgi_write_raddbg_file(raddbg_path, baked);
+    }
+    else
+    {
+      *data_out = str8_list_join(arena, &baked, 0);
+      result = (data_out->size != 0);
+    }
+  }
+  
+  //- clean up
+  if(root != 0)
+  {
+    cons_root_release(root);
+  }
+  os_file_view_close(&og_dbg_view);
+  arena_release(conv_arena);
+  ProfEnd();
+  return result;
+}
+
+internal void
+dbgi_binary_release_parse__stripe_mutex_w_guarded(DBGI_Binary *bin, B32 release_exe)
+{
+  if(bin->parse.arena != 0) { arena_release(bin->parse.arena); }
+  if(release_exe)
+  {
+    if(bin->parse.exe_base != 0) {os_file_map_view_close(bin->exe_file_map, bin->parse.exe_base);}
+    if(!os_handle_match(os_handle_zero(), bin->exe_file_map)) {os_file_map_close(bin->exe_file_map);}
+    if(!os_handle_match(os_handle_zero(), bin->exe_file)) {os_file_close(bin->exe_file);}
+  }
+  if(bin->parse.dbg_base != 0) {os_file_map_view_close(bin->dbg_file_map, bin->parse.dbg_base);}
+  if(!os_handle_match(os_handle_zero(), bin->dbg_file_map)) {os_file_map_close(bin->dbg_file_map);}
+  if(!os_handle_match(os_handle_zero(), bin->dbg_file)) {os_file_close(bin->dbg_file);}
+  MemoryZeroStruct(&bin->parse);
+  bin->last_time_enqueued_for_parse_us = 0;
+}
+
 internal void
 dbgi_parse_thread_entry_point(void *p)
 {
@@ -485,6 +919,7 @@ dbgi_parse_thread_entry_point(void *p)
     Arena *parse_arena = 0;
     PE_BinInfo exe_pe_info = {0};
     String8 exe_dbg_path_embedded = {0};
+    B32 exe_is_elf = 0;
     if(do_task)
     {
       parse_arena = arena_alloc();
@@ -494,6 +929,10 @@ dbgi_parse_thread_entry_point(void *p)
         exe_pe_info = pe_bin_info_from_data(parse_arena, exe_data);
         exe_dbg_path_embedded = str8_cstring_capped((char *)exe_data.str+exe_pe_info.dbg_path_off, (char *)exe_data.str+exe_pe_info.dbg_path_off+Min(exe_data.size-exe_pe_info.dbg_path_off, 4096));
       }
+      else if(exe_file_props.size >= sizeof(elf_magic) && MemoryMatch(exe_file_base, elf_magic, sizeof(elf_magic)))
+      {
+        exe_is_elf = 1;
+      }
     }
     
     //- rjf: determine O.G. (may or may not be RADDBG) dbg path
@@ -505,6 +944,10 @@ dbgi_parse_thread_entry_point(void *p)
       {
         og_dbg_path = forced_og_dbg_path;
       }
+      else if(exe_is_elf)
+      {
+        og_dbg_path = dbgi_elf_dbg_path_from_exe_path(scratch.arena, exe_path, str8((U8 *)exe_file_base, exe_file_props.size));
+      }
       else
       {
         String8 possible_og_dbg_paths[] =
@@ -532,6 +975,7 @@ dbgi_parse_thread_entry_point(void *p)
     B32 og_dbg_is_elf    = 0;
     B32 og_dbg_is_raddbg = 0;
     FileProperties og_dbg_props = {0};
+    DBGI_DbgIdentity og_dbg_identity = {0};
     if(do_task) ProfScope("analyze O.G. dbg file")
     {
       OS_Handle file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_Shared, og_dbg_path);
@@ -550,6 +994,7 @@ dbgi_parse_thread_entry_point(void *p)
         {
           og_dbg_format_is_known = 1;
           og_dbg_is_pdb = 1;
+          og_dbg_identity = dbgi_dbg_identity_from_pdb_data(data);
         }
       }
       if(!og_dbg_format_is_known)
@@ -570,6 +1015,7 @@ dbgi_parse_thread_entry_point(void *p)
         {
           og_dbg_format_is_known = 1;
           og_dbg_is_elf = 1;
+          og_dbg_identity = dbgi_dbg_identity_from_elf_data(data);
         }
       }
       if(!og_dbg_format_is_known)
@@ -597,16 +1043,115 @@ dbgi_parse_thread_entry_point(void *p)
       {
         raddbg_path = push_str8f(scratch.arena, "%S.raddbg", str8_chop_last_dot(og_dbg_path));
       }
+      else if(og_dbg_format_is_known && og_dbg_is_elf)
+      {
+        // NOTE: ELF files often have no extension, or a meaningful one
+        // ("libfoo.so.1"), so the whole name is kept.
+        raddbg_path = push_str8f(scratch.arena, "%S.raddbg", og_dbg_path);
+      }
     }
     
-    //- rjf: check if raddbg file is up-to-date
+    //- rjf: check if raddbg file is up-to-date. if the O.G. dbg file has an
+    // identity, the raddbg file must have been converted from that same
+    // identity; file times are only a fallback for when it does not.
     B32 raddbg_file_is_up_to_date = 0;
+    B32 og_dbg_has_identity = !dbgi_dbg_identity_is_zero(&og_dbg_identity);
     if(do_task)
     {
-      if(raddbg_path.size != 0)
+      if(raddbg_path.size != 0 && og_dbg_has_identity)
+      {
+        DBGI_DbgIdentity raddbg_identity = dbgi_dbg_identity_from_raddbg_path(raddbg_path);
+        raddbg_file_is_up_to_date = (dbgi_dbg_identity_match(&raddbg_identity, &og_dbg_identity) &&
+                                     dbgi_raddbg_file_is_intact(raddbg_path));
+      }
+      else if(raddbg_path.size != 0)
       {
         FileProperties props = os_properties_from_file_path(raddbg_path);
-        raddbg_file_is_up_to_date = (props.modified > og_dbg_props.modified);
+        raddbg_file_is_up_to_date = (props.modified > og_dbg_props.modified &&
+                                     dbgi_raddbg_file_is_intact(raddbg_path));
+      }
+    }
+    
+    //- not up-to-date, but have a shared cache? look for this identity's
+    // conversion there - & if there is none yet, convert into the cache
+    if(do_task && !raddbg_file_is_up_to_date && (og_dbg_is_pdb || og_dbg_is_elf) && og_dbg_has_identity)
+    {
+      String8 cache_dir = dbgi_cache_dir(scratch.arena);
+      if(cache_dir.size != 0)
+      {
+        raddbg_path = dbgi_cache_raddbg_path_from_og_dbg_path(scratch.arena, cache_dir, og_dbg_path, &og_dbg_identity);
+        DBGI_DbgIdentity cached_identity = dbgi_dbg_identity_from_raddbg_path(raddbg_path);
+        raddbg_file_is_up_to_date = (dbgi_dbg_identity_match(&cached_identity, &og_dbg_identity) &&
+                                     dbgi_raddbg_file_is_intact(raddbg_path));
+      }
+    }
+    
+    //- raddbg file not up-to-date, & we can convert it? publish a
+    // publics-only parse first, so unwinding & symbolization work right away
+    B32 publics_parse_is_stored = 0;
+    if(do_task && !raddbg_file_is_up_to_date && (og_dbg_is_pdb || og_dbg_is_elf)) ProfScope("publish publics-only parse")
+    {
+      Arena *publics_arena = arena_alloc();
+      String8 exe_data = str8((U8 *)exe_file_base, exe_file_props.size);
+      String8 publics_data = {0};
+      dbgi_convert_og_dbg(publics_arena, DBGI_ParseTier_Publics, og_dbg_is_pdb, exe_path, exe_data, og_dbg_path, raddbg_path, &publics_data);
+      RADDBG_Parsed publics_parsed = {0};
+      RADDBG_ParseStatus parse_status = RADDBG_ParseStatus_HeaderDoesNotMatch;
+      if(publics_data.size != 0)
+      {
+        parse_status = raddbg_parse(publics_data.str, publics_data.size, &publics_parsed);
+      }
+      if(parse_status == RADDBG_ParseStatus_Good)
+      {
+        PE_BinInfo publics_pe_info = {0};
+        if(exe_file_props.size >= 2 && *(U16 *)exe_file_base == PE_DOS_MAGIC)
+        {
+          publics_pe_info = pe_bin_info_from_data(publics_arena, exe_data);
+        }
+        
+        // busy-loop-wait for all scope touches to be done
+        for(B32 done = 0; done == 0;)
+        {
+          OS_MutexScopeR(stripe->rw_mutex) for(DBGI_Binary *bin = slot->first; bin != 0; bin = bin->next)
+          {
+            if(str8_match(bin->exe_path, exe_path, 0) &&
+               bin->scope_touch_count == 0)
+            {
+              done = 1;
+              break;
+            }
+          }
+        }
+        
+        // clear old results & store the publics-only parse
+        OS_MutexScopeW(stripe->rw_mutex) for(DBGI_Binary *bin = slot->first; bin != 0; bin = bin->next)
+        {
+          if(str8_match(bin->exe_path, exe_path, 0))
+          {
+            dbgi_binary_release_parse__stripe_mutex_w_guarded(bin, 1);
+            bin->exe_file = exe_file;
+            bin->exe_file_map = exe_file_map;
+            bin->dbg_file = os_handle_zero();
+            bin->dbg_file_map = os_handle_zero();
+            bin->gen += 1;
+            bin->parse.gen = bin->gen;
+            bin->parse.uid = ins_atomic_u64_inc_eval(&dbgi_shared->parse_uid_gen);
+            bin->parse.tier = DBGI_ParseTier_Publics;
+            bin->parse.arena = publics_arena;
+            bin->parse.exe_base = exe_file_base;
+            bin->parse.exe_props = exe_file_props;
+            bin->parse.dbg_path = push_str8_copy(publics_arena, og_dbg_path);
+            MemoryCopyStruct(&bin->parse.pe, &publics_pe_info);
+            MemoryCopyStruct(&bin->parse.rdbg, &publics_parsed);
+            publics_parse_is_stored = 1;
+            break;
+          }
+        }
+        os_condition_variable_broadcast(stripe->cv);
+      }
+      if(!publics_parse_is_stored)
+      {
+        arena_release(publics_arena);
       }
     }
     
@@ -615,7 +1160,7 @@ dbgi_parse_thread_entry_point(void *p)
     {
       if(!raddbg_file_is_up_to_date) ProfScope("generate raddbg file")
       {
-        if(og_dbg_is_pdb)
+        if(og_dbg_is_pdb || og_dbg_is_elf)
         {
           // rjf: push conversion task begin event
           {
@@ -624,39 +1169,9 @@ dbgi_parse_thread_entry_point(void *p)
             dbgi_p2u_push_event(&event);
           }
           
-          // rjf: kick off process
-          OS_Handle process = {0};
-          {
-            OS_LaunchOptions opts = {0};
-            opts.path = os_string_from_system_path(scratch.arena, OS_SystemPath_Binary);
-            opts.inherit_env = 1;
-            opts.consoleless = 1;
-            str8_list_pushf(scratch.arena, &opts.cmd_line, "raddbg");
-            str8_list_pushf(scratch.arena, &opts.cmd_line, "--convert");
-            //str8_list_pushf(scratch.arena, &opts.cmd_line, "--capture");
-            str8_list_pushf(scratch.arena, &opts.cmd_line, "--exe:%S", exe_path);
-            str8_list_pushf(scratch.arena, &opts.cmd_line, "--pdb:%S", og_dbg_path);
-            str8_list_pushf(scratch.arena, &opts.cmd_line, "--out:%S", raddbg_path);
-            os_launch_process(&opts, &process);
-          }
-          
-          // rjf: wait for process to complete
-          {
-            U64 start_wait_t = os_now_microseconds();
-            for(;;)
-            {
-              B32 wait_done = os_process_wait(process, os_now_microseconds()+1000);
-              if(wait_done)
-              {
-                raddbg_file_is_up_to_date = 1;
-                break;
-              }
-              if(os_now_microseconds()-start_wait_t > 10000000 && og_dbg_props.size < MB(64))
-              {
-                // os_graphical_message(1, str8_lit("RADDBG INTERNAL DEVELOPMENT MESSAGE"), str8_lit("this is taking a while... indicative of something that seemed like a bug that Jeff hit before. attach with debugger now & see where the callstack is?"));
-              }
-            }
-          }
+          // convert in-process
+          String8 exe_data = str8((U8 *)exe_file_base, exe_file_props.size);
+          raddbg_file_is_up_to_date = dbgi_convert_og_dbg(scratch.arena, DBGI_ParseTier_Full, og_dbg_is_pdb, exe_path, exe_data, og_dbg_path, raddbg_path, 0);
           
           // rjf: push conversion task end event
           {
@@ -678,6 +1193,14 @@ dbgi_parse_thread_entry_point(void *p)
       }
     }
     
+    //- full conversion failed, but a publics-only parse was stored? the
+    // binary owns this task's exe handles now; keep that parse & skip to end
+    if(do_task && publics_parse_is_stored && !raddbg_file_is_up_to_date)
+    {
+      arena_release(parse_arena);
+      do_task = 0;
+    }
+    
     //- rjf: open raddbg file & gather info
     OS_Handle raddbg_file = {0};
     OS_Handle raddbg_file_map = {0};
@@ -691,6 +1214,20 @@ dbgi_parse_thread_entry_point(void *p)
       raddbg_file_base = os_file_map_view_open(raddbg_file_map, OS_AccessFlag_Read, r1u64(0, raddbg_file_props.size));
     }
     
+    //- publics-only parse stored? stop handing it out, so that its
+    // scope touches can drain before it's swapped out
+    if(do_task && publics_parse_is_stored)
+    {
+      OS_MutexScopeW(stripe->rw_mutex) for(DBGI_Binary *bin = slot->first; bin != 0; bin = bin->next)
+      {
+        if(str8_match(bin->exe_path, exe_path, 0))
+        {
+          bin->flags |= DBGI_BinaryFlag_ParseSwapPending;
+          break;
+        }
+      }
+    }
+    
     //- rjf: cache write, step 0: busy-loop-wait for all scope touches to be done
     if(do_task) ProfScope("cache write, step 0: busy-loop-wait for all scope touches to be done")
     {
@@ -722,16 +1259,9 @@ dbgi_parse_thread_entry_point(void *p)
           {
             raddbg_or_exe_file_is_updated = 1;
             
-            // rjf: clean up old stuff
-            if(bin->parse.arena != 0) { arena_release(bin->parse.arena); }
-            if(bin->parse.exe_base != 0) {os_file_map_view_close(bin->exe_file_map, bin->parse.exe_base);}
-            if(!os_handle_match(os_handle_zero(), bin->exe_file_map)) {os_file_map_close(bin->exe_file_map);}
-            if(!os_handle_match(os_handle_zero(), bin->exe_file)) {os_file_close(bin->exe_file);}
-            if(bin->parse.dbg_base != 0) {os_file_map_view_close(bin->dbg_file_map, bin->parse.dbg_base);}
-            if(!os_handle_match(os_handle_zero(), bin->dbg_file_map)) {os_file_map_close(bin->dbg_file_map);}
-            if(!os_handle_match(os_handle_zero(), bin->dbg_file)) {os_file_close(bin->dbg_file);}
-            MemoryZeroStruct(&bin->parse);
-            bin->last_time_enqueued_for_parse_us = 0;
+            // clean up old stuff; a publics-only parse already holds
+            // this task's exe handles, so those stay open
+            dbgi_binary_release_parse__stripe_mutex_w_guarded(bin, !publics_parse_is_stored);
             
             // rjf: store new handles & props
             bin->exe_file = exe_file;
@@ -797,6 +1327,8 @@ dbgi_parse_thread_entry_point(void *p)
           MemoryCopyStruct(&bin->parse.pe, &exe_pe_info);
           MemoryCopyStruct(&bin->parse.rdbg, &raddbg_parsed);
           bin->parse.gen = bin->gen;
+          bin->parse.uid = ins_atomic_u64_inc_eval(&dbgi_shared->parse_uid_gen);
+          bin->parse.tier = DBGI_ParseTier_Full;
           break;
         }
       }
@@ -815,7 +1347,7 @@ dbgi_parse_thread_entry_point(void *p)
       {
         if(str8_match(bin->exe_path, exe_path, 0))
         {
-          bin->flags &= ~DBGI_BinaryFlag_ParseInFlight;
+          bin->flags &= ~(DBGI_BinaryFlag_ParseInFlight|DBGI_BinaryFlag_ParseSwapPending);
           break;
         }
       }
@@ -865,17 +1397,9 @@ dbgi_evictor_thread_entry_point(void *p)
           {
             if(bin->refcount == 0 && bin->scope_touch_count == 0 && bin->flags == 0)
             {
-              if(bin->parse.arena != 0) { arena_release(bin->parse.arena); }
-              if(bin->parse.exe_base != 0) { os_file_map_view_close(bin->exe_file_map, bin->parse.exe_base); }
-              if(!os_handle_match(os_handle_zero(), bin->exe_file_map)) { os_file_map_close(bin->exe_file_map); }
-              if(!os_handle_match(os_handle_zero(), bin->exe_file)) { os_file_close(bin->exe_file); }
-              if(bin->parse.dbg_base != 0) { os_file_map_view_close(bin->dbg_file_map, bin->parse.dbg_base); }
-              if(!os_handle_match(os_handle_zero(), bin->dbg_file_map)) { os_file_map_close(bin->dbg_file_map); }
-              if(!os_handle_match(os_handle_zero(), bin->dbg_file)) { os_file_close(bin->dbg_file); }
+              dbgi_binary_release_parse__stripe_mutex_w_guarded(bin, 1);
               bin->exe_file_map = bin->exe_file = os_handle_zero();
               bin->dbg_file_map = bin->dbg_file = os_handle_zero();
-              MemoryZeroStruct(&bin->parse);
-              bin->last_time_enqueued_for_parse_us = 0;
               bin->gen = 1;
             }
           }
@@ -7,10 +7,26 @@
 ////////////////////////////////
 //~ rjf: Info Bundle Types
 
+// NOTE: a binary whose debug info must be converted first gets a
+// publics-only parse - unwind info, public symbols, & a procedure vmap -
+// which is swapped for the full parse once the conversion finishes. callers
+// state the minimum tier they can work with; only those asking for the
+// publics tier are handed it while the full conversion is still running.
+typedef enum DBGI_ParseTier
+{
+  DBGI_ParseTier_Null,
+  DBGI_ParseTier_Publics,
+  DBGI_ParseTier_Full,
+  DBGI_ParseTier_COUNT
+}
+DBGI_ParseTier;
+
 typedef struct DBGI_Parse DBGI_Parse;
 struct DBGI_Parse
 {
   U64 gen;
+  U64 uid;
+  DBGI_ParseTier tier;
   Arena *arena;
   void *exe_base;
   FileProperties exe_props;
@@ -21,6 +37,21 @@ struct DBGI_Parse
   RADDBG_Parsed rdbg;
 };
 
+////////////////////////////////
+//~ Debug Info Identity Types
+
+// NOTE: the GUID & age of the debug info a RADDBG file was converted
+// from, as recorded in its header. a RADDBG file is up-to-date when its
+// identity matches its source's - file times are only consulted when the
+// source has no identity. all zero means "unknown". ELF files have no GUID;
+// their GNU build id is packed into the same fields instead.
+typedef struct DBGI_DbgIdentity DBGI_DbgIdentity;
+struct DBGI_DbgIdentity
+{
+  U8 guid[16];
+  U32 age;
+};
+
 ////////////////////////////////
 //~ rjf: Exe -> Debug Forced Override Cache Types
 
@@ -56,6 +87,7 @@ typedef U32 DBGI_BinaryFlags;
 enum
 {
   DBGI_BinaryFlag_ParseInFlight = (1<<0),
+  DBGI_BinaryFlag_ParseSwapPending = (1<<1),
 };
 
 typedef struct DBGI_Binary DBGI_Binary;
@@ -130,6 +162,7 @@ typedef enum DBGI_EventKind
 {
   DBGI_EventKind_Null,
   DBGI_EventKind_ConversionStarted,
+  DBGI_EventKind_ConversionProgress,
   DBGI_EventKind_ConversionEnded,
   DBGI_EventKind_ConversionFailureUnsupportedFormat,
   DBGI_EventKind_COUNT
@@ -141,6 +174,18 @@ struct DBGI_Event
 {
   DBGI_EventKind kind;
   String8 string;
+  U64 bytes_processed;
+  U64 bytes_total;
+  U64 units_processed;
+  U64 units_total;
+};
+
+typedef struct DBGI_ConversionProgress DBGI_ConversionProgress;
+struct DBGI_ConversionProgress
+{
+  String8 raddbg_path;
+  U64 bytes_processed;
+  U64 units_processed;
 };
 
 typedef struct DBGI_EventNode DBGI_EventNode;
@@ -195,6 +240,16 @@ struct DBGI_Shared
   U64 p2u_ring_write_pos;
   U64 p2u_ring_read_pos;
   
+  // shared content-addressed RADDBG cache directory
+  OS_Handle cache_dir_mutex;
+  U64 cache_dir_size;
+  U8 cache_dir_buffer[4096];
+  U64 tmp_file_counter;
+  
+  // unique id source for stored parses - unlike binary generations, these
+  // are never reused, even after a binary is evicted & parsed again
+  U64 parse_uid_gen;
+  
   // rjf: threads
   U64 parse_thread_count;
   OS_Handle *parse_threads;
@@ -223,6 +278,29 @@ internal void dbgi_ensure_tctx_inited(void);
 
 internal U64 dbgi_hash_from_string(String8 string);
 
+////////////////////////////////
+//~ Debug Info Identity Functions
+
+internal B32 dbgi_dbg_identity_is_zero(DBGI_DbgIdentity *identity);
+internal B32 dbgi_dbg_identity_match(DBGI_DbgIdentity *a, DBGI_DbgIdentity *b);
+internal DBGI_DbgIdentity dbgi_dbg_identity_from_pdb_data(String8 data);
+internal DBGI_DbgIdentity dbgi_dbg_identity_from_elf_data(String8 data);
+internal DBGI_DbgIdentity dbgi_dbg_identity_from_raddbg_path(String8 path);
+internal B32 dbgi_raddbg_file_is_intact(String8 path);
+
+////////////////////////////////
+//~ Shared RADDBG Cache Functions
+
+internal void dbgi_set_cache_dir(String8 cache_dir);
+internal String8 dbgi_cache_dir(Arena *arena);
+internal String8 dbgi_cache_raddbg_path_from_og_dbg_path(Arena *arena, String8 cache_dir, String8 og_dbg_path, DBGI_DbgIdentity *identity);
+internal B32 dbgi_write_raddbg_file(String8 raddbg_path, String8List data);
+
+////////////////////////////////
+//~ ELF Separate Debug File Lookup
+
+internal String8 dbgi_elf_dbg_path_from_exe_path(Arena *arena, String8 exe_path, String8 exe_data);
+
 ////////////////////////////////
 //~ rjf: Forced Override Cache Functions
 
@@ -241,7 +319,8 @@ internal void dbgi_scope_touch_binary__stripe_mutex_r_guarded(DBGI_Scope *scope,
 
 internal void dbgi_binary_open(String8 exe_path);
 internal void dbgi_binary_close(String8 exe_path);
-internal DBGI_Parse *dbgi_parse_from_exe_path(DBGI_Scope *scope, String8 exe_path, U64 endt_us);
+internal DBGI_Parse *dbgi_parse_from_exe_path(DBGI_Scope *scope, String8 exe_path, DBGI_ParseTier min_tier, U64 endt_us);
+internal U64 dbgi_parse_gen(void);
 
 ////////////////////////////////
 //~ rjf: Parse Threads
@@ -249,9 +328,14 @@ internal DBGI_Parse *dbgi_parse_from_exe_path(DBGI_Scope *scope, String8 exe_pat
 internal B32 dbgi_u2p_enqueue_exe_path(String8 exe_path, U64 endt_us);
 internal String8 dbgi_u2p_dequeue_exe_path(Arena *arena);
 
+internal U64 dbgi_p2u_size_from_event(DBGI_Event *event);
+internal void dbgi_p2u_write_event__ring_mutex_guarded(DBGI_Event *event);
 internal void dbgi_p2u_push_event(DBGI_Event *event);
 internal DBGI_EventList dbgi_p2u_pop_events(Arena *arena, U64 endt_us);
 
+internal CONS_PROGRESS_FUNCTION_DEF(dbgi_conversion_progress_hook);
+internal B32 dbgi_convert_og_dbg(Arena *arena, DBGI_ParseTier tier, B32 og_dbg_is_pdb, String8 exe_path, String8 exe_data, String8 og_dbg_path, String8 raddbg_path, String8 *data_out);
+internal void dbgi_binary_release_parse__stripe_mutex_w_guarded(DBGI_Binary *bin, B32 release_exe);
 internal void dbgi_parse_thread_entry_point(void *p);
 
 ////////////////////////////////
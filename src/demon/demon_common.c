@@ -268,3 +268,136 @@ demon_push_event(Arena *arena, DEMON_EventList *list, DEMON_EventKind kind){
   return(result);
 }
 
+internal void
+demon_event_list_push_copy(Arena *arena, DEMON_EventList *list, DEMON_Event *event){
+  DEMON_Event *copy = demon_push_event(arena, list, event->kind);
+  MemoryCopyStruct(copy, event);
+  copy->string = push_str8_copy(arena, event->string);
+}
+
+////////////////////////////////
+//~ Trap Condition Helpers
+
+internal B32
+demon_trap_operand_eval(DEMON_Entity *thread, DEMON_TrapCondition *condition, DEMON_TrapOperand *operand, U64 *value_out){
+  B32 result = 1;
+  U64 value = 0;
+  U64 width = 8;
+  
+  if (operand->flags & DEMON_TrapOperandFlag_HitCount){
+    value = condition->hit_count;
+  }
+  else{
+    // register term
+    if (operand->reg_size != 0){
+      U64 reg_block_size = regs_block_size_from_architecture((Architecture)thread->arch);
+      if (operand->reg_size <= 8 && operand->reg_off + operand->reg_size <= reg_block_size){
+        void *reg_block = demon_accel_read_regs(thread);
+        MemoryCopy(&value, (U8*)reg_block + operand->reg_off, operand->reg_size);
+        width = operand->reg_size;
+      }
+      else{
+        result = 0;
+      }
+    }
+    
+    // offset
+    if (operand->imm != 0){
+      value += operand->imm;
+      width = 8;
+    }
+    
+    // dereference
+    if (result && operand->mem_size != 0){
+      U64 read_value = 0;
+      if (operand->mem_size <= 8 &&
+          demon_os_read_memory(thread->parent, &read_value, value, operand->mem_size) == operand->mem_size){
+        value = read_value;
+        width = operand->mem_size;
+      }
+      else{
+        result = 0;
+      }
+    }
+    
+    // sign extend
+    if (result && (operand->flags & DEMON_TrapOperandFlag_SignExtend) && width < 8){
+      U64 sign_bit = 1ull << (width*8 - 1);
+      if (value & sign_bit){
+        value |= ~((sign_bit << 1) - 1);
+      }
+    }
+  }
+  
+  *value_out = value;
+  return(result);
+}
+
+internal B32
+demon_trap_condition_eval(DEMON_Entity *thread, DEMON_TrapCondition *condition){
+  // NOTE: conditions that can't be evaluated hold, so the hit surfaces
+  B32 result = 1;
+  U64 l = 0;
+  U64 r = 0;
+  if (demon_trap_operand_eval(thread, condition, &condition->l, &l) &&
+      demon_trap_operand_eval(thread, condition, &condition->r, &r)){
+    switch (condition->op){
+      default:{}break;
+      case DEMON_TrapConditionOp_EqEq: {result = (l == r);}break;
+      case DEMON_TrapConditionOp_NtEq: {result = (l != r);}break;
+      case DEMON_TrapConditionOp_LessU:{result = (l <  r);}break;
+      case DEMON_TrapConditionOp_LsEqU:{result = (l <= r);}break;
+      case DEMON_TrapConditionOp_GrtrU:{result = (l >  r);}break;
+      case DEMON_TrapConditionOp_GrEqU:{result = (l >= r);}break;
+      case DEMON_TrapConditionOp_LessS:{result = ((S64)l <  (S64)r);}break;
+      case DEMON_TrapConditionOp_LsEqS:{result = ((S64)l <= (S64)r);}break;
+      case DEMON_TrapConditionOp_GrtrS:{result = ((S64)l >  (S64)r);}break;
+      case DEMON_TrapConditionOp_GrEqS:{result = ((S64)l >= (S64)r);}break;
+    }
+  }
+  return(result);
+}
+
+internal B32
+demon_trap_chunk_list_has_conditions(DEMON_TrapChunkList *traps){
+  B32 result = 0;
+  for (DEMON_TrapChunkNode *n = traps->first; n != 0 && !result; n = n->next){
+    for (U64 i = 0; i < n->count; i += 1){
+      if (n->v[i].condition != 0){
+        result = 1;
+        break;
+      }
+    }
+  }
+  return(result);
+}
+
+internal B32
+demon_trap_hit_is_filtered(DEMON_TrapChunkList *traps, DEMON_Event *event){
+  // NOTE: a hit is filtered only if every trap at the address has a
+  // condition, and none of them hold. every matching trap counts the hit.
+  B32 matched = 0;
+  B32 filtered = 1;
+  DEMON_Entity *thread = demon_ent_ptr_from_handle(event->thread);
+  if (thread != 0 && thread->kind == DEMON_EntityKind_Thread){
+    for (DEMON_TrapChunkNode *n = traps->first; n != 0; n = n->next){
+      for (U64 i = 0; i < n->count; i += 1){
+        DEMON_Trap *trap = &n->v[i];
+        if (trap->process == event->process && trap->address == event->instruction_pointer){
+          matched = 1;
+          if (trap->condition == 0){
+            filtered = 0;
+          }
+          else{
+            trap->condition->hit_count += 1;
+            if (demon_trap_condition_eval(thread, trap->condition)){
+              filtered = 0;
+            }
+          }
+        }
+      }
+    }
+  }
+  B32 result = (matched && filtered);
+  return(result);
+}
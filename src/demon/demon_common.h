@@ -146,5 +146,14 @@ internal void          demon_ent_map_erase(DEMON_MapRef map_ref);
 //~ allen: Event Helpers
 
 internal DEMON_Event*  demon_push_event(Arena *arena, DEMON_EventList *list, DEMON_EventKind kind);
+internal void          demon_event_list_push_copy(Arena *arena, DEMON_EventList *list, DEMON_Event *event);
+
+////////////////////////////////
+//~ Trap Condition Helpers
+
+internal B32 demon_trap_operand_eval(DEMON_Entity *thread, DEMON_TrapCondition *condition, DEMON_TrapOperand *operand, U64 *value_out);
+internal B32 demon_trap_condition_eval(DEMON_Entity *thread, DEMON_TrapCondition *condition);
+internal B32 demon_trap_chunk_list_has_conditions(DEMON_TrapChunkList *traps);
+internal B32 demon_trap_hit_is_filtered(DEMON_TrapChunkList *traps, DEMON_Event *event);
 
 #endif //DEMON_COMMON_H
@@ -36,6 +36,7 @@ demon_string_from_event_kind(DEMON_EventKind kind){
     case DEMON_EventKind_Memory:            result = str8_lit("Memory"); break;
     case DEMON_EventKind_DebugString:       result = str8_lit("DebugString"); break;
     case DEMON_EventKind_SetThreadName:     result = str8_lit("SetThreadName"); break;
+    case DEMON_EventKind_Watch:             result = str8_lit("Watch"); break;
   }
   return(result);
 }
@@ -328,13 +329,90 @@ demon_run(Arena *arena, DEMON_RunCtrls *ctrls)
       os_ctrls.trap_count = (U64)(dst - os_ctrls.traps);
     }
     
+    // convert watches
+    os_ctrls.watches = push_array_no_zero(scratch.arena, DEMON_OS_Watch, ctrls->watch_count);
+    {
+      DEMON_OS_Watch *dst = os_ctrls.watches;
+      DEMON_Watch *src = ctrls->watches;
+      for (U64 i = 0; i < ctrls->watch_count; i += 1, src += 1){
+        if (src->process != 0 && src->vaddr_range.max > src->vaddr_range.min){
+          DEMON_Entity *watch_process = demon_ent_ptr_from_handle(src->process);
+          if (watch_process != 0 &&
+              watch_process->kind == DEMON_EntityKind_Process){
+            dst->process = watch_process;
+            dst->vaddr_range = src->vaddr_range;
+            dst->id = src->id;
+            dst += 1;
+          }
+          else{
+            full_conversion = 0;
+            goto finish_conversion;
+          }
+        }
+      }
+      
+      os_ctrls.watch_count = (U64)(dst - os_ctrls.watches);
+    }
+    
     finish_conversion:;
   }
   
   // call the OS implementation of run
   DEMON_EventList result = {0};
   if (full_conversion){
-    result = demon_os_run(arena, &os_ctrls);
+    if (!demon_trap_chunk_list_has_conditions(&ctrls->traps)){
+      result = demon_os_run(arena, &os_ctrls);
+    }
+    else{
+      // NOTE: breakpoint hits on traps whose conditions all fail are
+      // filtered out right here: the thread is stepped off of the trap and
+      // the run resumes, without the hit ever reaching the caller.
+      for (;result.count == 0;){
+        Temp temp = temp_begin(scratch.arena);
+        DEMON_EventList events = demon_os_run(temp.arena, &os_ctrls);
+        
+        // filter
+        DEMON_HandleList step_threads = {0};
+        for (DEMON_EventNode *n = events.first; n != 0; n = n->next){
+          if (n->v.kind == DEMON_EventKind_Breakpoint &&
+              demon_trap_hit_is_filtered(&ctrls->traps, &n->v)){
+            demon_handle_list_push(temp.arena, &step_threads, n->v.thread);
+          }
+          else{
+            demon_event_list_push_copy(arena, &result, &n->v);
+          }
+        }
+        
+        // step filtered threads off of their traps
+        for (DEMON_HandleNode *n = step_threads.first; n != 0; n = n->next){
+          DEMON_OS_RunCtrls step_ctrls = {0};
+          step_ctrls.single_step_thread = demon_ent_ptr_from_handle(n->v);
+          for (B32 stepped = (step_ctrls.single_step_thread == 0); !stepped;){
+            DEMON_EventList step_events = demon_os_run(temp.arena, &step_ctrls);
+            for (DEMON_EventNode *step_n = step_events.first; step_n != 0; step_n = step_n->next){
+              DEMON_Event *event = &step_n->v;
+              if (event->kind == DEMON_EventKind_SingleStep && event->thread == n->v){
+                stepped = 1;
+                continue;
+              }
+              demon_event_list_push_copy(arena, &result, event);
+              switch (event->kind){
+                default:{stepped = 1;}break;
+                case DEMON_EventKind_CreateProcess:
+                case DEMON_EventKind_CreateThread:
+                case DEMON_EventKind_LoadModule:
+                case DEMON_EventKind_UnloadModule:
+                case DEMON_EventKind_Memory:
+                case DEMON_EventKind_DebugString:
+                case DEMON_EventKind_SetThreadName:{}break;
+              }
+            }
+          }
+        }
+        
+        temp_end(temp);
+      }
+    }
   }
   else{
     DEMON_Event *event = demon_push_event(arena, &result, DEMON_EventKind_Error);
@@ -654,6 +732,23 @@ demon_read_memory(DEMON_Handle process, void *dst, U64 src_address, U64 size){
   return(bytes_read);
 }
 
+internal U64
+demon_read_memory_ranges(DEMON_Handle process, DEMON_ReadRange *ranges, U64 range_count){
+  U64 bytes_read = 0;
+  for (U64 i = 0; i < range_count; i += 1){
+    ranges[i].bytes_read = 0;
+  }
+  if (demon_access_begin()){
+    DEMON_Entity *entity = demon_ent_ptr_from_handle(process);
+    if (entity != 0 &&
+        entity->kind == DEMON_EntityKind_Process){
+      bytes_read = demon_os_read_memory_ranges(entity, ranges, range_count);
+    }
+    demon_access_end();
+  }
+  return(bytes_read);
+}
+
 internal B32
 demon_write_memory(DEMON_Handle process, U64 dst_address, void *src, U64 size){
   B32 result = 0;
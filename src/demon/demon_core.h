@@ -41,6 +41,21 @@ enum{
   DEMON_MemoryProtectFlag_Execute = (1<<2),
 };
 
+////////////////////////////////
+//~ Memory Read Ranges
+
+// One (address, size) pair of a vectored read. bytes_read is filled by the
+// read; as with demon_read_memory, it may stop short of size.
+
+typedef struct DEMON_ReadRange DEMON_ReadRange;
+struct DEMON_ReadRange
+{
+  void *dst;
+  U64 src_address;
+  U64 size;
+  U64 bytes_read;
+};
+
 ////////////////////////////////
 //~ allen: Demon Event Types
 
@@ -63,6 +78,7 @@ typedef enum DEMON_EventKind
   DEMON_EventKind_Memory,
   DEMON_EventKind_DebugString,
   DEMON_EventKind_SetThreadName,
+  DEMON_EventKind_Watch,
   DEMON_EventKind_COUNT
 }
 DEMON_EventKind;
@@ -141,12 +157,64 @@ struct DEMON_EventList
 ////////////////////////////////
 //~ allen: Demon Run Control Types
 
+// NOTE: A trap condition is one comparison simple enough for the
+// demon to check by itself when its trap is hit, without surfacing the hit.
+// An operand's value is: (register bytes at reg_off, if reg_size != 0) + imm,
+// then dereferenced as mem_size bytes (if mem_size != 0), then optionally
+// sign extended from its width. A hit count operand is the number of times
+// the trap has been hit, counting this hit.
+typedef U32 DEMON_TrapOperandFlags;
+enum
+{
+  DEMON_TrapOperandFlag_SignExtend = (1<<0),
+  DEMON_TrapOperandFlag_HitCount   = (1<<1),
+};
+
+typedef struct DEMON_TrapOperand DEMON_TrapOperand;
+struct DEMON_TrapOperand
+{
+  DEMON_TrapOperandFlags flags;
+  U32 reg_off;
+  U8 reg_size;
+  U8 mem_size;
+  U64 imm;
+};
+
+typedef enum DEMON_TrapConditionOp
+{
+  DEMON_TrapConditionOp_Null,
+  DEMON_TrapConditionOp_EqEq,
+  DEMON_TrapConditionOp_NtEq,
+  DEMON_TrapConditionOp_LessU,
+  DEMON_TrapConditionOp_LsEqU,
+  DEMON_TrapConditionOp_GrtrU,
+  DEMON_TrapConditionOp_GrEqU,
+  DEMON_TrapConditionOp_LessS,
+  DEMON_TrapConditionOp_LsEqS,
+  DEMON_TrapConditionOp_GrtrS,
+  DEMON_TrapConditionOp_GrEqS,
+  DEMON_TrapConditionOp_COUNT
+}
+DEMON_TrapConditionOp;
+
+typedef struct DEMON_TrapCondition DEMON_TrapCondition;
+struct DEMON_TrapCondition
+{
+  DEMON_TrapConditionOp op;
+  DEMON_TrapOperand l;
+  DEMON_TrapOperand r;
+  U64 hit_count;
+};
+
+// NOTE: A trap with a condition is only reported as a breakpoint when
+// its condition holds (or can't be evaluated); see demon_run.
 typedef struct DEMON_Trap DEMON_Trap;
 struct DEMON_Trap
 {
   DEMON_Handle process;
   U64 address;
   U64 id;
+  DEMON_TrapCondition *condition;
 };
 
 typedef struct DEMON_TrapChunkNode DEMON_TrapChunkNode;
@@ -167,6 +235,18 @@ struct DEMON_TrapChunkList
   U64 trap_count;
 };
 
+// NOTE: Watches are software data breakpoints: a write which touches
+// any byte of vaddr_range stops the writing thread *after* the write, with a
+// DEMON_EventKind_Watch event (address = written address, user_data = id).
+// Backends without a watch engine ignore them.
+typedef struct DEMON_Watch DEMON_Watch;
+struct DEMON_Watch
+{
+  DEMON_Handle process;
+  Rng1U64 vaddr_range;
+  U64 id;
+};
+
 typedef struct DEMON_RunCtrls DEMON_RunCtrls;
 struct DEMON_RunCtrls
 {
@@ -177,6 +257,8 @@ struct DEMON_RunCtrls
   DEMON_Handle *run_entities;
   U64 run_entity_count;
   DEMON_TrapChunkList traps;
+  DEMON_Watch *watches;
+  U64 watch_count;
 };
 
 ////////////////////////////////
@@ -265,6 +347,7 @@ internal B32 demon_release_memory(DEMON_Handle process, U64 vaddr, U64 size);
 
 //- rjf: target process memory reading/writing
 internal U64 demon_read_memory(DEMON_Handle process, void *dst, U64 src_address, U64 size);
+internal U64 demon_read_memory_ranges(DEMON_Handle process, DEMON_ReadRange *ranges, U64 range_count);
 internal B32 demon_write_memory(DEMON_Handle process, U64 dst_address, void *src, U64 size);
 internal U64 demon_read_memory_amap_aligned(DEMON_Handle process, void *dst, U64 src_address, U64 size);
 internal U64 demon_read_memory_amap(DEMON_Handle process, void *dst, U64 src_address, U64 size);
@@ -22,6 +22,14 @@ struct DEMON_OS_Trap
   U64 address;
 };
 
+typedef struct DEMON_OS_Watch DEMON_OS_Watch;
+struct DEMON_OS_Watch
+{
+  DEMON_Entity *process;
+  Rng1U64 vaddr_range;
+  U64 id;
+};
+
 typedef struct DEMON_OS_RunCtrls DEMON_OS_RunCtrls;
 struct DEMON_OS_RunCtrls
 {
@@ -33,6 +41,8 @@ struct DEMON_OS_RunCtrls
   U64 run_entity_count;
   DEMON_OS_Trap *traps;
   U64 trap_count;
+  DEMON_OS_Watch *watches;
+  U64 watch_count;
 };
 
 ////////////////////////////////
@@ -72,6 +82,7 @@ internal void demon_os_release_memory(DEMON_Entity *process, U64 vaddr, U64 size
 
 //- rjf: target process memory reading/writing
 internal U64 demon_os_read_memory(DEMON_Entity *process, void *dst, U64 src_address, U64 size);
+internal U64 demon_os_read_memory_ranges(DEMON_Entity *process, DEMON_ReadRange *ranges, U64 range_count);
 internal B32 demon_os_write_memory(DEMON_Entity *process, U64 dst_address, void *src, U64 size);
 #define demon_os_read_struct(p,dst,src)  demon_os_read_memory((p), (dst), (src), sizeof(*(dst)))
 #define demon_os_write_struct(p,dst,src) demon_os_write_memory((p), (dst), (src), sizeof(*(src)))
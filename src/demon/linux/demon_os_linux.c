@@ -17,6 +17,8 @@ global U64 demon_lnx_halt_user_data = 0;
 
 global B32 demon_lnx_new_process_pending = false;
 
+global B32 demon_lnx_process_vm_readv_unavailable = false;
+
 global Arena *demon_lnx_event_arena = 0;
 global DEMON_EventList demon_lnx_queued_events = {0};
 
@@ -246,7 +248,7 @@ demon_lnx_aux_from_pid(pid_t pid, Architecture arch){
 }
 
 internal DEMON_LNX_PhdrInfo
-demon_lnx_phdr_info_from_memory(int memory_fd, B32 is_32bit, U64 phvaddr, U64 phentsize, U64 phcount){
+demon_lnx_phdr_info_from_memory(pid_t pid, int memory_fd, B32 is_32bit, U64 phvaddr, U64 phentsize, U64 phcount){
   DEMON_LNX_PhdrInfo result = {0};
   result.range.min = max_U64;
   
@@ -254,10 +256,21 @@ demon_lnx_phdr_info_from_memory(int memory_fd, B32 is_32bit, U64 phvaddr, U64 ph
   U64 phdr_size_expected = (is_32bit?sizeof(SYMS_ElfPhdr32):sizeof(SYMS_ElfPhdr64));
   U64 phdr_stride = (phentsize?phentsize:phdr_size_expected);
   U64 phdr_read_size = ClampTop(phdr_stride, phdr_size_expected);
+  phcount = ClampTop(phcount, max_U16);
+  
+  // read the whole table with one vectored read
+  Temp scratch = scratch_begin(0, 0);
+  U8 *phdrs = push_array(scratch.arena, U8, phcount*phdr_size_expected);
+  DEMON_ReadRange *ranges = push_array(scratch.arena, DEMON_ReadRange, phcount);
+  for (U64 i = 0; i < phcount; i += 1){
+    ranges[i].dst = phdrs + i*phdr_size_expected;
+    ranges[i].src_address = phvaddr + i*phdr_stride;
+    ranges[i].size = phdr_read_size;
+  }
+  demon_lnx_read_memory_ranges(pid, memory_fd, ranges, phcount);
   
   // scan table
-  U64 va = phvaddr;
-  for (U64 i = 0; i < phcount; i += 1, va += phdr_stride){
+  for (U64 i = 0; i < phcount; i += 1){
     
     // get type and range
     SYMS_ElfPKind p_type = 0;
@@ -266,14 +279,14 @@ demon_lnx_phdr_info_from_memory(int memory_fd, B32 is_32bit, U64 phvaddr, U64 ph
     
     if (is_32bit){
       SYMS_ElfPhdr32 phdr32 = {0};
-      demon_lnx_read_memory(memory_fd, &phdr32, va, phdr_read_size);
+      MemoryCopy(&phdr32, phdrs + i*phdr_size_expected, sizeof(phdr32));
       p_type = phdr32.p_type;
       p_vaddr = phdr32.p_vaddr;
       p_memsz = phdr32.p_memsz;
     }
     else{
       SYMS_ElfPhdr64 phdr64 = {0};
-      demon_lnx_read_memory(memory_fd, &phdr64, va, phdr_read_size);
+      MemoryCopy(&phdr64, phdrs + i*phdr_size_expected, sizeof(phdr64));
       p_type = phdr64.p_type;
       p_vaddr = phdr64.p_vaddr;
       p_memsz = phdr64.p_memsz;
@@ -295,6 +308,7 @@ demon_lnx_phdr_info_from_memory(int memory_fd, B32 is_32bit, U64 phvaddr, U64 ph
     }
   }
   
+  scratch_end(scratch);
   return(result);
 }
 
@@ -303,12 +317,13 @@ demon_lnx_module_list_from_process(Arena *arena, DEMON_Entity *process){
   Architecture arch = (Architecture)process->arch;
   B32 is_32bit = (arch == Architecture_x86 || arch == Architecture_arm32);
   int memory_fd = (int)process->ext_u64;
+  pid_t pid = (pid_t)process->id;
   
   // aux from pid
-  DEMON_LNX_ProcessAux aux = demon_lnx_aux_from_pid((pid_t)process->id, arch);
+  DEMON_LNX_ProcessAux aux = demon_lnx_aux_from_pid(pid, arch);
   
   // extract info from program headers
-  DEMON_LNX_PhdrInfo phdr_info = demon_lnx_phdr_info_from_memory(memory_fd, is_32bit,
+  DEMON_LNX_PhdrInfo phdr_info = demon_lnx_phdr_info_from_memory(pid, memory_fd, is_32bit,
                                                                  aux.phdr, aux.phent, aux.phnum);
   
   // linkmap first from memory space & dyn address
@@ -361,25 +376,48 @@ demon_lnx_module_list_from_process(Arena *arena, DEMON_Entity *process){
     node->name = aux.execfn;
   }
   
-  // iterate link maps
+  // iterate link maps; each step reads the module's ELF header together
+  // with the next link map, in one vectored read
   if (first_linkmap_va != 0){
-    U64 linkmap_va = first_linkmap_va;
+    U64 linkmap_size = (is_32bit?sizeof(SYMS_ElfLinkMap32):sizeof(SYMS_ElfLinkMap64));
+    U64 ehdr_size = (is_32bit?sizeof(SYMS_ElfEhdr32):sizeof(SYMS_ElfEhdr64));
+    U8 linkmap_raw[sizeof(SYMS_ElfLinkMap64)] = {0};
+    demon_lnx_read_memory(memory_fd, linkmap_raw, first_linkmap_va, linkmap_size);
     
     for (;;){
       SYMS_ElfLinkMap64 linkmap = {0};
       if (is_32bit){
         // TOOD(nick): endian awarness
         SYMS_ElfLinkMap32 linkmap32 = {0};
-        demon_lnx_read_memory(memory_fd, &linkmap32, linkmap_va, sizeof(linkmap32));
+        MemoryCopy(&linkmap32, linkmap_raw, sizeof(linkmap32));
         linkmap.base = linkmap32.base;
         linkmap.name = linkmap32.name;
         linkmap.ld   = linkmap32.ld;
         linkmap.next = linkmap32.next;
       }
       else{
-        demon_lnx_read_memory(memory_fd, &linkmap, linkmap_va, sizeof(linkmap));
+        MemoryCopy(&linkmap, linkmap_raw, sizeof(linkmap));
       }
       
+      // read ELF header & next link map
+      U8 ehdr_raw[sizeof(SYMS_ElfEhdr64)] = {0};
+      U8 next_linkmap_raw[sizeof(SYMS_ElfLinkMap64)] = {0};
+      DEMON_ReadRange ranges[2] = {0};
+      U64 range_count = 0;
+      if (linkmap.base != 0){
+        ranges[range_count].dst = ehdr_raw;
+        ranges[range_count].src_address = linkmap.base;
+        ranges[range_count].size = ehdr_size;
+        range_count += 1;
+      }
+      if (linkmap.next != 0){
+        ranges[range_count].dst = next_linkmap_raw;
+        ranges[range_count].src_address = linkmap.next;
+        ranges[range_count].size = linkmap_size;
+        range_count += 1;
+      }
+      demon_lnx_read_memory_ranges(pid, memory_fd, ranges, range_count);
+      
       if (linkmap.base != 0){
         // find phdrs for this module
         SYMS_U64 phvaddr = 0;
@@ -388,21 +426,21 @@ demon_lnx_module_list_from_process(Arena *arena, DEMON_Entity *process){
         
         if (is_32bit){
           SYMS_ElfEhdr32 ehdr = {0};
-          demon_lnx_read_memory(memory_fd, &ehdr, linkmap.base, sizeof(ehdr));
+          MemoryCopy(&ehdr, ehdr_raw, sizeof(ehdr));
           phvaddr = ehdr.e_phoff + linkmap.base;
           phentsize = ehdr.e_phentsize;
           phcount = ehdr.e_phnum;
         }
         else{
           SYMS_ElfEhdr64 ehdr = {0};
-          demon_lnx_read_memory(memory_fd, &ehdr, linkmap.base, sizeof(ehdr));
+          MemoryCopy(&ehdr, ehdr_raw, sizeof(ehdr));
           phvaddr = ehdr.e_phoff + linkmap.base;
           phentsize = ehdr.e_phentsize;
           phcount = ehdr.e_phnum;
         }
         
         // extract info from phdrs
-        DEMON_LNX_PhdrInfo module_phdr_info = demon_lnx_phdr_info_from_memory(memory_fd, is_32bit,
+        DEMON_LNX_PhdrInfo module_phdr_info = demon_lnx_phdr_info_from_memory(pid, memory_fd, is_32bit,
                                                                               phvaddr, phentsize, phcount);
         
         // save module node
@@ -413,10 +451,10 @@ demon_lnx_module_list_from_process(Arena *arena, DEMON_Entity *process){
         node->name = linkmap.name;
       }
       
-      linkmap_va = linkmap.next;
-      if (linkmap_va == 0){
+      if (linkmap.next == 0){
         break;
       }
+      MemoryCopy(linkmap_raw, next_linkmap_raw, sizeof(linkmap_raw));
     }
   }
   
@@ -461,30 +499,72 @@ demon_lnx_write_memory(int memory_fd, U64 dst, void *src, U64 size){
   return(result);
 }
 
+internal U64
+demon_lnx_read_memory_ranges(pid_t pid, int memory_fd, DEMON_ReadRange *ranges, U64 range_count){
+  U64 bytes_read = 0;
+  struct iovec local_iov[DEMON_LNX_READ_RANGES_BATCH_MAX];
+  struct iovec remote_iov[DEMON_LNX_READ_RANGES_BATCH_MAX];
+  for (U64 first = 0; first < range_count;){
+    
+    // gather a batch of ranges
+    U64 iov_count = 0;
+    for (;first + iov_count < range_count && iov_count < DEMON_LNX_READ_RANGES_BATCH_MAX; iov_count += 1){
+      DEMON_ReadRange *range = &ranges[first + iov_count];
+      local_iov[iov_count].iov_base = range->dst;
+      local_iov[iov_count].iov_len = range->size;
+      remote_iov[iov_count].iov_base = (void*)range->src_address;
+      remote_iov[iov_count].iov_len = range->size;
+    }
+    
+    // read the batch in one syscall
+    ssize_t batch_read = -1;
+    if (!demon_lnx_process_vm_readv_unavailable){
+      batch_read = process_vm_readv(pid, local_iov, iov_count, remote_iov, iov_count, 0);
+      if (batch_read == -1 && (errno == ENOSYS || errno == EPERM)){
+        demon_lnx_process_vm_readv_unavailable = true;
+      }
+    }
+    
+    // account for fully read ranges; partial transfers stop at an iovec
+    // boundary, so the read ends at the first range which wasn't finished
+    U64 remaining = (batch_read > 0 ? (U64)batch_read : 0);
+    U64 done_count = 0;
+    for (;done_count < iov_count && ranges[first + done_count].size <= remaining; done_count += 1){
+      DEMON_ReadRange *range = &ranges[first + done_count];
+      range->bytes_read = range->size;
+      remaining -= range->size;
+      bytes_read += range->size;
+    }
+    
+    // read the range which stopped the batch with pread, which reports how
+    // far into it the readable memory goes, then resume after it
+    if (done_count < iov_count){
+      DEMON_ReadRange *range = &ranges[first + done_count];
+      range->bytes_read = demon_lnx_read_memory(memory_fd, range->dst, range->src_address, range->size);
+      bytes_read += range->bytes_read;
+      done_count += 1;
+    }
+    first += done_count;
+  }
+  return(bytes_read);
+}
+
 internal String8
 demon_lnx_read_memory_str(Arena *arena, int memory_fd, U64 address){
-  // TODO(allen): this could be done better with a demon_lnx_read_memory
-  // that returns a read amount instead of a success/fail.
-  
-  // scan piece by piece
+  // scan up to one page boundary at a time; a short read means the next
+  // page isn't readable, which ends the string
   Temp scratch = scratch_begin(&arena, 1);
   String8List list = {0};
   
-  U64 max_cap = 256;
-  U64 cap = max_cap;
   U64 read_p = address;
   for (;;){
-    U8 *block = push_array(scratch.arena, U8, cap);
-    for (;cap > 0;){
-      if (demon_lnx_read_memory(memory_fd, block, read_p, cap)){
-        break;
-      }
-      cap /= 2;
-    }
-    read_p += cap;
+    U64 cap = DEMON_LNX_PAGE_SIZE - (read_p&(DEMON_LNX_PAGE_SIZE - 1));
+    U8 *block = push_array_no_zero(scratch.arena, U8, cap);
+    U64 block_read = demon_lnx_read_memory(memory_fd, block, read_p, cap);
+    read_p += block_read;
     
     U64 block_opl = 0;
-    for (;block_opl < cap; block_opl += 1){
+    for (;block_opl < block_read; block_opl += 1){
       if (block[block_opl] == 0){
         break;
       }
@@ -494,7 +574,7 @@ demon_lnx_read_memory_str(Arena *arena, int memory_fd, U64 address){
       str8_list_push(scratch.arena, &list, str8(block, block_opl));
     }
     
-    if (block_opl < cap || cap == 0){
+    if (block_opl < cap){
       break;
     }
   }
@@ -790,6 +870,388 @@ demon_lnx_next_map(Arena *arena, int maps, DEMON_LNX_MapsEntry *entry_out){
   return(is_parsed);
 }
 
+//- page protection & syscall injection
+
+internal int
+demon_lnx_prot_from_memory_protect_flags(DEMON_MemoryProtectFlags flags){
+  int result = PROT_NONE;
+  if (flags & DEMON_MemoryProtectFlag_Read){
+    result |= PROT_READ;
+  }
+  if (flags & DEMON_MemoryProtectFlag_Write){
+    result |= PROT_WRITE;
+  }
+  if (flags & DEMON_MemoryProtectFlag_Execute){
+    result |= PROT_EXEC;
+  }
+  return(result);
+}
+
+internal B32
+demon_lnx_wait_for_step(DEMON_Entity *thread, int *status_out){
+  B32 result = false;
+  pid_t tid = (pid_t)thread->id;
+  int status = 0;
+  for (;;){
+    pid_t wait_id = waitpid(tid, &status, __WALL);
+    if (wait_id != tid || !WIFSTOPPED(status)){
+      break;
+    }
+    
+    // a dummy stop queued before the step gets reported first; eat it and step again
+    DEMON_LNX_ThreadExt *thread_ext = demon_lnx_thread_ext(thread);
+    if (WSTOPSIG(status) == SIGSTOP && thread_ext->expecting_dummy_sigstop){
+      thread_ext->expecting_dummy_sigstop = false;
+      ptrace(PTRACE_SINGLESTEP, tid, 0, 0);
+      continue;
+    }
+    
+    result = true;
+    break;
+  }
+  *status_out = status;
+  return(result);
+}
+
+internal DEMON_Entity*
+demon_lnx_stopped_thread_from_process(DEMON_Entity *process, pid_t wait_id){
+  DEMON_Entity *result = 0;
+  
+  // the thread that reported the current stop, or any thread that isn't
+  // waiting on a dummy stop, is sitting in a ptrace-stop already
+  for (DEMON_Entity *thread = process->first;
+       thread != 0;
+       thread = thread->next){
+    if (thread->kind == DEMON_EntityKind_Thread){
+      if ((pid_t)thread->id == wait_id){
+        result = thread;
+        break;
+      }
+      if (result == 0 && !demon_lnx_thread_ext(thread)->expecting_dummy_sigstop){
+        result = thread;
+      }
+    }
+  }
+  
+  // otherwise collect a dummy stop synchronously
+  // NOTE: if something other than the dummy stop is reported here it
+  // is dropped, the same as any other signal the demon suppresses.
+  if (result == 0){
+    for (DEMON_Entity *thread = process->first;
+         thread != 0;
+         thread = thread->next){
+      if (thread->kind == DEMON_EntityKind_Thread){
+        int status = 0;
+        if (waitpid((pid_t)thread->id, &status, __WALL) == (pid_t)thread->id && WIFSTOPPED(status)){
+          demon_lnx_thread_ext(thread)->expecting_dummy_sigstop = false;
+          result = thread;
+          break;
+        }
+      }
+    }
+  }
+  
+  return(result);
+}
+
+internal B32
+demon_lnx_inject_syscall_x64(DEMON_Entity *thread, U64 number, U64 *args, U64 arg_count, U64 *result_out){
+  B32 result = false;
+  
+  if (thread->arch == Architecture_x64){
+    DEMON_Entity *process = thread->parent;
+    int memory_fd = (int)process->ext_u64;
+    pid_t tid = (pid_t)thread->id;
+    
+    DEMON_LNX_UserRegsX64 saved_regs = {0};
+    struct iovec iov_saved = {0};
+    iov_saved.iov_base = &saved_regs;
+    iov_saved.iov_len = sizeof(saved_regs);
+    if (ptrace(PTRACE_GETREGSET, tid, (void*)NT_PRSTATUS, &iov_saved) != -1){
+      
+      // swap a syscall instruction in at the stopped ip
+      U8 syscall_code[2] = {0x0F, 0x05};
+      U8 saved_code[2] = {0};
+      if (demon_lnx_read_memory(memory_fd, saved_code, saved_regs.rip, sizeof(saved_code)) == sizeof(saved_code) &&
+          demon_lnx_write_memory(memory_fd, saved_regs.rip, syscall_code, sizeof(syscall_code))){
+        
+        // orig_rax = -1 keeps the kernel from restarting whatever syscall
+        // the thread was stopped inside of when we resume it for the step
+        U64 arg_regs[6] = {0};
+        MemoryCopy(arg_regs, args, Min(arg_count, ArrayCount(arg_regs))*sizeof(U64));
+        DEMON_LNX_UserRegsX64 regs = saved_regs;
+        regs.rax = number;
+        regs.orig_rax = max_U64;
+        regs.rdi = arg_regs[0];
+        regs.rsi = arg_regs[1];
+        regs.rdx = arg_regs[2];
+        regs.r10 = arg_regs[3];
+        regs.r8  = arg_regs[4];
+        regs.r9  = arg_regs[5];
+        struct iovec iov_regs = {0};
+        iov_regs.iov_base = &regs;
+        iov_regs.iov_len = sizeof(regs);
+        
+        // step the syscall
+        int status = 0;
+        if (ptrace(PTRACE_SETREGSET, tid, (void*)NT_PRSTATUS, &iov_regs) != -1 &&
+            ptrace(PTRACE_SINGLESTEP, tid, 0, 0) != -1 &&
+            demon_lnx_wait_for_step(thread, &status) &&
+            WSTOPSIG(status) == SIGTRAP &&
+            ptrace(PTRACE_GETREGSET, tid, (void*)NT_PRSTATUS, &iov_regs) != -1){
+          *result_out = regs.rax;
+          result = true;
+        }
+        
+        demon_lnx_write_memory(memory_fd, saved_regs.rip, saved_code, sizeof(saved_code));
+      }
+      
+      ptrace(PTRACE_SETREGSET, tid, (void*)NT_PRSTATUS, &iov_saved);
+    }
+  }
+  
+  return(result);
+}
+
+internal B32
+demon_lnx_mprotect(DEMON_Entity *thread, U64 vaddr, U64 size, int prot){
+  U64 args[3] = {vaddr, size, (U64)prot};
+  U64 ret = max_U64;
+  B32 result = (demon_lnx_inject_syscall_x64(thread, DEMON_LNX_SYSCALL_X64_MPROTECT, args, ArrayCount(args), &ret) &&
+                ret == 0);
+  return(result);
+}
+
+//- page-protection watchpoints
+
+internal int
+demon_lnx_qsort_compare_watch_page_runs(DEMON_LNX_WatchPageRun *a, DEMON_LNX_WatchPageRun *b){
+  int result = 0;
+  if (a->pid != b->pid){
+    result = (a->pid < b->pid) ? -1 : +1;
+  }
+  else if (a->range.min != b->range.min){
+    result = (a->range.min < b->range.min) ? -1 : +1;
+  }
+  return(result);
+}
+
+internal DEMON_LNX_WatchPageRun*
+demon_lnx_watch_page_runs_from_watches(Arena *arena, DEMON_OS_Watch *watches, U64 watch_count, U64 *run_count_out){
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  // page align, sort, merge
+  DEMON_LNX_WatchPageRun *pages = push_array(scratch.arena, DEMON_LNX_WatchPageRun, watch_count);
+  for (U64 i = 0; i < watch_count; i += 1){
+    pages[i].process = watches[i].process;
+    pages[i].pid = (pid_t)watches[i].process->id;
+    pages[i].range.min = AlignDownPow2(watches[i].vaddr_range.min, DEMON_LNX_PAGE_SIZE);
+    pages[i].range.max = AlignPow2(watches[i].vaddr_range.max, DEMON_LNX_PAGE_SIZE);
+  }
+  qsort(pages, watch_count, sizeof(pages[0]), (int (*)(const void *, const void *))demon_lnx_qsort_compare_watch_page_runs);
+  U64 merged_count = 0;
+  for (U64 i = 0; i < watch_count; i += 1){
+    DEMON_LNX_WatchPageRun *last = (merged_count > 0) ? &pages[merged_count - 1] : 0;
+    if (last != 0 && last->pid == pages[i].pid && pages[i].range.min <= last->range.max){
+      last->range.max = Max(last->range.max, pages[i].range.max);
+    }
+    else{
+      pages[merged_count] = pages[i];
+      merged_count += 1;
+    }
+  }
+  
+  // split along /proc/pid/maps entries, keeping only writable pieces
+  U64 run_cap = merged_count*2;
+  U64 run_count = 0;
+  DEMON_LNX_WatchPageRun *runs = push_array(arena, DEMON_LNX_WatchPageRun, run_cap);
+  for (U64 first = 0; first < merged_count;){
+    U64 opl = first + 1;
+    for (;opl < merged_count && pages[opl].pid == pages[first].pid; opl += 1);
+    
+    int maps = demon_lnx_open_maps(pages[first].pid);
+    if (maps >= 0){
+      for (;;){
+        Temp temp = temp_begin(scratch.arena);
+        DEMON_LNX_MapsEntry e;
+        if (!demon_lnx_next_map(temp.arena, maps, &e)){
+          temp_end(temp);
+          break;
+        }
+        if (e.perms & DEMON_LNX_PermFlags_Write){
+          Rng1U64 map_range = r1u64(e.address_lo, e.address_hi);
+          int prot = PROT_WRITE;
+          if (e.perms & DEMON_LNX_PermFlags_Read){
+            prot |= PROT_READ;
+          }
+          if (e.perms & DEMON_LNX_PermFlags_Exec){
+            prot |= PROT_EXEC;
+          }
+          for (U64 i = first; i < opl; i += 1){
+            Rng1U64 piece = intersect_1u64(pages[i].range, map_range);
+            if (piece.max > piece.min){
+              if (run_count == run_cap){
+                U64 new_cap = run_cap*2 + 16;
+                DEMON_LNX_WatchPageRun *new_runs = push_array(arena, DEMON_LNX_WatchPageRun, new_cap);
+                MemoryCopy(new_runs, runs, sizeof(runs[0])*run_count);
+                runs = new_runs;
+                run_cap = new_cap;
+              }
+              runs[run_count] = pages[i];
+              runs[run_count].range = piece;
+              runs[run_count].prot = prot;
+              run_count += 1;
+            }
+          }
+        }
+        temp_end(temp);
+      }
+      close(maps);
+    }
+    
+    first = opl;
+  }
+  
+  scratch_end(scratch);
+  *run_count_out = run_count;
+  return(runs);
+}
+
+internal void
+demon_lnx_watch_page_runs_protect(DEMON_LNX_WatchPageRun *runs, U64 run_count, B32 protect, pid_t wait_id){
+  DEMON_Entity *process = 0;
+  DEMON_Entity *thread = 0;
+  for (U64 i = 0; i < run_count; i += 1){
+    DEMON_LNX_WatchPageRun *run = &runs[i];
+    if (run->is_protected == protect){
+      continue;
+    }
+    
+    // the process may have exited (and its entity been recycled) during the run
+    if (run->process != process){
+      process = run->process;
+      thread = 0;
+      if (demon_ent_map_entity_from_id(DEMON_EntityKind_Process, run->pid) == process){
+        thread = demon_lnx_stopped_thread_from_process(process, wait_id);
+      }
+    }
+    
+    if (thread != 0){
+      int prot = protect ? (run->prot & ~PROT_WRITE) : run->prot;
+      if (demon_lnx_mprotect(thread, run->range.min, dim_1u64(run->range), prot)){
+        run->is_protected = protect;
+      }
+    }
+    else{
+      run->is_protected = false;
+    }
+  }
+}
+
+internal DEMON_LNX_WatchStep
+demon_lnx_watch_step_over(DEMON_Entity *thread, DEMON_LNX_WatchPageRun *runs, U64 run_count, DEMON_OS_Watch *watches, U64 watch_count){
+  DEMON_LNX_WatchStep result = {0};
+  DEMON_Entity *process = thread->parent;
+  int memory_fd = (int)process->ext_u64;
+  pid_t tid = (pid_t)thread->id;
+  
+  // open up every protected run the faulting instruction touches, then step it
+  U64 fault_address = 0;
+  U64 open_count = 0;
+  DEMON_LNX_WatchPageRun *open_runs[DEMON_LNX_WATCH_STEP_RUN_MAX];
+  U64 open_pages[DEMON_LNX_WATCH_STEP_RUN_MAX];
+  U8 page_before[DEMON_LNX_WATCH_STEP_RUN_MAX][DEMON_LNX_PAGE_SIZE];
+  int status = 0;
+  B32 stepped = false;
+  for (;;){
+    // find the protected run holding this fault
+    siginfo_t siginfo = {0};
+    DEMON_LNX_WatchPageRun *run = 0;
+    if (open_count < DEMON_LNX_WATCH_STEP_RUN_MAX &&
+        ptrace(PTRACE_GETSIGINFO, tid, 0, &siginfo) != -1 &&
+        siginfo.si_signo == SIGSEGV && siginfo.si_code == SEGV_ACCERR){
+      U64 address = (U64)siginfo.si_addr;
+      for (U64 i = 0; i < run_count; i += 1){
+        if (runs[i].process == process && runs[i].is_protected && contains_1u64(runs[i].range, address)){
+          run = &runs[i];
+          break;
+        }
+      }
+      if (open_count == 0){
+        fault_address = address;
+      }
+    }
+    if (run == 0){
+      break;
+    }
+    
+    // save the faulting page to catch writes the fault address doesn't show
+    U64 page = AlignDownPow2((U64)siginfo.si_addr, DEMON_LNX_PAGE_SIZE);
+    MemoryZeroArray(page_before[open_count]);
+    demon_lnx_read_memory(memory_fd, page_before[open_count], page, DEMON_LNX_PAGE_SIZE);
+    open_runs[open_count] = run;
+    open_pages[open_count] = page;
+    open_count += 1;
+    demon_lnx_mprotect(thread, run->range.min, dim_1u64(run->range), run->prot);
+    
+    // step; a fault on another protected run comes back around this loop
+    ptrace(PTRACE_SINGLESTEP, tid, 0, 0);
+    if (!demon_lnx_wait_for_step(thread, &status)){
+      break;
+    }
+    if (WSTOPSIG(status) == SIGTRAP){
+      stepped = true;
+      break;
+    }
+  }
+  
+  // protect again
+  for (U64 i = 0; i < open_count; i += 1){
+    DEMON_LNX_WatchPageRun *run = open_runs[i];
+    demon_lnx_mprotect(thread, run->range.min, dim_1u64(run->range), run->prot & ~PROT_WRITE);
+  }
+  
+  // did the write land in a watched range?
+  if (stepped){
+    result.handled = true;
+    for (U64 i = 0; i < watch_count && !result.hit; i += 1){
+      DEMON_OS_Watch *watch = &watches[i];
+      if (watch->process != process){
+        continue;
+      }
+      if (contains_1u64(watch->vaddr_range, fault_address)){
+        result.hit = true;
+        result.hit_address = fault_address;
+        result.hit_id = watch->id;
+        break;
+      }
+      for (U64 page_idx = 0; page_idx < open_count; page_idx += 1){
+        Rng1U64 page_range = r1u64(open_pages[page_idx], open_pages[page_idx] + DEMON_LNX_PAGE_SIZE);
+        Rng1U64 overlap = intersect_1u64(watch->vaddr_range, page_range);
+        if (overlap.max > overlap.min){
+          U8 page_after[DEMON_LNX_PAGE_SIZE] = {0};
+          U64 off_first = overlap.min - page_range.min;
+          U64 off_opl = overlap.max - page_range.min;
+          demon_lnx_read_memory(memory_fd, page_after + off_first, overlap.min, off_opl - off_first);
+          for (U64 off = off_first; off < off_opl; off += 1){
+            if (page_after[off] != page_before[page_idx][off]){
+              result.hit = true;
+              result.hit_address = page_range.min + off;
+              result.hit_id = watch->id;
+              break;
+            }
+          }
+        }
+        if (result.hit){
+          break;
+        }
+      }
+    }
+  }
+  
+  return(result);
+}
+
 ////////////////////////////////
 //~ rjf: @demon_os_hooks Main Layer Initialization
 
@@ -837,6 +1299,8 @@ demon_os_run(Arena *arena, DEMON_OS_RunCtrls *controls){
     // do setup
     B32 did_setup = false;
     U8 *trap_swap_bytes = 0;
+    DEMON_LNX_WatchPageRun *watch_runs = 0;
+    U64 watch_run_count = 0;
     
     if (result.first == 0){
       // TODO(allen): per-Architecture implementation of single steps
@@ -863,6 +1327,13 @@ demon_os_run(Arena *arena, DEMON_OS_RunCtrls *controls){
         }
       }
       
+      // write protect watched pages (before the traps go in, so the injected
+      // syscalls never land on a trap byte)
+      if (controls->watch_count != 0){
+        watch_runs = demon_lnx_watch_page_runs_from_watches(scratch.arena, controls->watches, controls->watch_count, &watch_run_count);
+        demon_lnx_watch_page_runs_protect(watch_runs, watch_run_count, true, 0);
+      }
+      
       // TODO(allen): per-Architecture implementation of traps
       trap_swap_bytes = push_array_no_zero(scratch.arena, U8, controls->trap_count);
       
@@ -884,6 +1355,7 @@ demon_os_run(Arena *arena, DEMON_OS_RunCtrls *controls){
     
     // do run
     B32 did_run = false;
+    pid_t stop_id = 0;
     if (did_setup){
       // continue non-frozen threads
       DEMON_LNX_EntityNode *resume_threads = 0;
@@ -957,6 +1429,20 @@ demon_os_run(Arena *arena, DEMON_OS_RunCtrls *controls){
       
       // handle devent
       DEMON_Entity *thread = demon_ent_map_entity_from_id(DEMON_EntityKind_Thread, wait_id);
+      
+      // step faults on watched pages past the write; writes that miss every
+      // watched range resume right here, without the full stop handling below
+      DEMON_LNX_WatchStep watch_step = {0};
+      if (thread != 0 && watch_run_count != 0 &&
+          WIFSTOPPED(status) && WSTOPSIG(status) == SIGSEGV){
+        watch_step = demon_lnx_watch_step_over(thread, watch_runs, watch_run_count,
+                                               controls->watches, controls->watch_count);
+        if (watch_step.handled && !watch_step.hit && thread != single_step_thread){
+          ptrace(PTRACE_CONT, wait_id, 0, 0);
+          goto wait_for_stop;
+        }
+      }
+      
       if (thread == 0){
         if (wait_id >= 0){
           // TODO(allen): this isn't a great situation! From what I can tell there's no
@@ -1162,6 +1648,21 @@ demon_os_run(Arena *arena, DEMON_OS_RunCtrls *controls){
               case SIGABRT:case SIGFPE:case SIGSEGV:
 #endif
               
+              // a watched page fault that was already stepped past
+              if (watch_step.handled){
+                DEMON_EventKind e_kind = DEMON_EventKind_SingleStep;
+                if (watch_step.hit){
+                  e_kind = DEMON_EventKind_Watch;
+                }
+                DEMON_Event *e = demon_push_event(arena, &stop_events, e_kind);
+                e->process = demon_ent_handle_from_ptr(process);
+                e->thread = demon_ent_handle_from_ptr(thread);
+                e->instruction_pointer = instruction_pointer;
+                e->address = watch_step.hit_address;
+                e->user_data = watch_step.hit_id;
+                break;
+              }
+              
               // event
               DEMON_Event *e = demon_push_event(arena, &stop_events, DEMON_EventKind_Exception);
               e->process = demon_ent_handle_from_ptr(process);
@@ -1332,6 +1833,7 @@ demon_os_run(Arena *arena, DEMON_OS_RunCtrls *controls){
       }
       
       did_run = true;
+      stop_id = wait_id;
     }
     
     // cleanup
@@ -1348,6 +1850,9 @@ demon_os_run(Arena *arena, DEMON_OS_RunCtrls *controls){
         }
       }
       
+      // restore watched page protections
+      demon_lnx_watch_page_runs_protect(watch_runs, watch_run_count, false, stop_id);
+      
       // TODO(allen): per-Architecture
       // unset single step bit
       //  the single step bit is automatically unset whenever we single step
@@ -1840,18 +2345,34 @@ demon_os_tls_root_vaddr_from_thread(DEMON_Entity *thread){
 internal U64
 demon_os_reserve_memory(DEMON_Entity *process, U64 size){
   U64 result = 0;
-  NotImplemented;
+  DEMON_Entity *thread = demon_lnx_stopped_thread_from_process(process, 0);
+  if (thread != 0){
+    U64 args[6] = {0, size, PROT_NONE, MAP_PRIVATE|MAP_ANONYMOUS, (U64)-1, 0};
+    U64 ret = 0;
+    if (demon_lnx_inject_syscall_x64(thread, DEMON_LNX_SYSCALL_X64_MMAP, args, ArrayCount(args), &ret) &&
+        ret < (U64)-4095){
+      result = ret;
+    }
+  }
   return(result);
 }
 
 internal void
 demon_os_set_memory_protect_flags(DEMON_Entity *process, U64 page_vaddr, U64 size, DEMON_MemoryProtectFlags flags){
-  NotImplemented;
+  DEMON_Entity *thread = demon_lnx_stopped_thread_from_process(process, 0);
+  if (thread != 0){
+    demon_lnx_mprotect(thread, page_vaddr, size, demon_lnx_prot_from_memory_protect_flags(flags));
+  }
 }
 
 internal void
 demon_os_release_memory(DEMON_Entity *process, U64 vaddr, U64 size){
-  NotImplemented;
+  DEMON_Entity *thread = demon_lnx_stopped_thread_from_process(process, 0);
+  if (thread != 0){
+    U64 args[2] = {vaddr, size};
+    U64 ret = 0;
+    demon_lnx_inject_syscall_x64(thread, DEMON_LNX_SYSCALL_X64_MUNMAP, args, ArrayCount(args), &ret);
+  }
 }
 
 //- rjf: target process memory reading/writing
@@ -1863,6 +2384,13 @@ demon_os_read_memory(DEMON_Entity *process, void *dst, U64 src_address, U64 size
   return(result);
 }
 
+internal U64
+demon_os_read_memory_ranges(DEMON_Entity *process, DEMON_ReadRange *ranges, U64 range_count){
+  int memory_fd = (int)process->ext_u64;
+  U64 result = demon_lnx_read_memory_ranges((pid_t)process->id, memory_fd, ranges, range_count);
+  return(result);
+}
+
 internal B32
 demon_os_write_memory(DEMON_Entity *process, U64 dst_address, void *src, U64 size){
   int memory_fd = (int)process->ext_u64;
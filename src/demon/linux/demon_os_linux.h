@@ -18,6 +18,7 @@
 #include <sys/ptrace.h>
 #include <sys/types.h>
 #include <sys/wait.h>
+#include <sys/uio.h>
 #include <unistd.h>
 #include <elf.h>
 #include <dirent.h>
@@ -26,6 +27,36 @@
 ////////////////////////////////
 //~ NOTE(allen): Linux Demon Types
 
+//- memory reads
+
+// ranges per process_vm_readv call; well under the kernel's IOV_MAX (1024)
+#define DEMON_LNX_READ_RANGES_BATCH_MAX 64
+#define DEMON_LNX_PAGE_SIZE KB(4)
+
+//- injected syscalls (x64 numbering)
+
+#define DEMON_LNX_SYSCALL_X64_MMAP     9
+#define DEMON_LNX_SYSCALL_X64_MPROTECT 10
+#define DEMON_LNX_SYSCALL_X64_MUNMAP   11
+
+//- page-protection watchpoints
+
+// watches write protect every page they touch for the duration of a run, and
+// step each faulting write past with its page(s) opened back up.
+//
+// limitations:
+//  * only user-mode stores fault. the kernel writing into a watched page on
+//    the target's behalf - read(2), recv(2), or any syscall with an output
+//    buffer there - is not reported as a hit; the syscall fails with EFAULT
+//    in the target instead, which the target will usually treat as an error.
+//    so avoid watching buffers the target passes to the kernel.
+//  * a write to a watched page through another mapping of the same memory
+//    (another process, or a second view of a shared mapping) isn't seen.
+
+// watched page runs one faulting instruction may open up at once
+//  (an access straddling two runs faults once per run)
+#define DEMON_LNX_WATCH_STEP_RUN_MAX 4
+
 //- entities
 
 // Demon Linux Entity Extensions
@@ -71,6 +102,23 @@ struct DEMON_LNX_EntityNode{
   DEMON_Entity *entity;
 };
 
+// a page aligned range of one process's writable memory that is write
+// protected for the duration of a run; prot is the original protection
+struct DEMON_LNX_WatchPageRun{
+  DEMON_Entity *process;
+  pid_t pid;
+  Rng1U64 range;
+  int prot;
+  B32 is_protected;
+};
+
+struct DEMON_LNX_WatchStep{
+  B32 handled;
+  B32 hit;
+  U64 hit_address;
+  U64 hit_id;
+};
+
 ////////////////////////////////
 //~ NOTE(allen): Linux Demon Register Layouts
 
@@ -200,11 +248,12 @@ internal int                   demon_lnx_open_memory_fd_for_pid(pid_t pid);
 
 internal Architecture          demon_lnx_arch_from_pid(pid_t pid);
 internal DEMON_LNX_ProcessAux  demon_lnx_aux_from_pid(pid_t pid, Architecture arch);
-internal DEMON_LNX_PhdrInfo    demon_lnx_phdr_info_from_memory(int memory_fd, B32 is_32bit,
+internal DEMON_LNX_PhdrInfo    demon_lnx_phdr_info_from_memory(pid_t pid, int memory_fd, B32 is_32bit,
                                                                U64 phvaddr, U64 phstride, U64 phcount);
 internal DEMON_LNX_ModuleNode* demon_lnx_module_list_from_process(Arena *arena, DEMON_Entity *process);
 
 internal U64     demon_lnx_read_memory(int memory_fd, void *dst, U64 src, U64 size);
+internal U64     demon_lnx_read_memory_ranges(pid_t pid, int memory_fd, DEMON_ReadRange *ranges, U64 range_count);
 internal B32     demon_lnx_write_memory(int memory_fd, U64 dst, void *src, U64 size);
 internal String8 demon_lnx_read_memory_str(Arena *arena, int memory_fd, U64 address);
 
@@ -219,4 +268,15 @@ internal String8 demon_lnx_read_string(Arena *arena, int fd);
 internal int demon_lnx_open_maps(pid_t pid);
 internal B32 demon_lnx_next_map(Arena *arena, int maps, DEMON_LNX_MapsEntry *entry_out);
 
+internal int           demon_lnx_prot_from_memory_protect_flags(DEMON_MemoryProtectFlags flags);
+internal B32           demon_lnx_wait_for_step(DEMON_Entity *thread, int *status_out);
+internal DEMON_Entity* demon_lnx_stopped_thread_from_process(DEMON_Entity *process, pid_t wait_id);
+internal B32           demon_lnx_inject_syscall_x64(DEMON_Entity *thread, U64 number, U64 *args, U64 arg_count, U64 *result_out);
+internal B32           demon_lnx_mprotect(DEMON_Entity *thread, U64 vaddr, U64 size, int prot);
+
+internal int                     demon_lnx_qsort_compare_watch_page_runs(DEMON_LNX_WatchPageRun *a, DEMON_LNX_WatchPageRun *b);
+internal DEMON_LNX_WatchPageRun* demon_lnx_watch_page_runs_from_watches(Arena *arena, DEMON_OS_Watch *watches, U64 watch_count, U64 *run_count_out);
+internal void                    demon_lnx_watch_page_runs_protect(DEMON_LNX_WatchPageRun *runs, U64 run_count, B32 protect, pid_t wait_id);
+internal DEMON_LNX_WatchStep     demon_lnx_watch_step_over(DEMON_Entity *thread, DEMON_LNX_WatchPageRun *runs, U64 run_count, DEMON_OS_Watch *watches, U64 watch_count);
+
 #endif //DEMON_OS_LINUX_H
@@ -0,0 +1,196 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+// exe //
+
+////////////////////////////////
+//~ page-protection watchpoint benchmark
+//
+// Relaunches itself as a target which maps a fixed region, stops on an int3,
+// then sweeps writes over every page of the region. The debugger side times
+// the sweep with N watched ranges spread over the region. The watched ranges
+// sit in the upper half of their pages and the sweep only writes the lower
+// half, so every fault is a false share the demon has to step past; a final
+// write into the first watched range checks the hit is still reported, and a
+// row with watches but no reported hit is marked failed.
+//
+// Only the linux demon has a watch engine; elsewhere rows with watches fail.
+
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "raddbg_format/raddbg_format.h"
+#include "regs/regs.h"
+#include "regs/raddbg/regs_raddbg.h"
+#include "demon/demon_inc.h"
+
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "regs/regs.c"
+#include "regs/raddbg/regs_raddbg.c"
+#include "demon/demon_inc.c"
+
+#define BENCH_REGION_BASE  0x200000000ull
+#define BENCH_PAGE_SIZE    KB(4)
+#define BENCH_PAGE_COUNT   1024
+#define BENCH_SWEEP_COUNT  64
+#define BENCH_WATCH_OFFSET (BENCH_PAGE_SIZE/2)
+#define BENCH_WATCH_SIZE   8
+
+//- target side
+
+internal int
+bench_target_main(void)
+{
+  U8 *region = (U8 *)mmap((void *)BENCH_REGION_BASE, BENCH_PAGE_SIZE*BENCH_PAGE_COUNT, PROT_READ|PROT_WRITE,
+                          MAP_PRIVATE|MAP_ANONYMOUS|MAP_FIXED, -1, 0);
+  if(region != (U8 *)BENCH_REGION_BASE)
+  {
+    return 1;
+  }
+  
+  // NOTE: the debugger sets its watches once it sees this trap
+  __asm__ volatile("int3");
+  
+  for(U64 sweep_idx = 0; sweep_idx < BENCH_SWEEP_COUNT; sweep_idx += 1)
+  {
+    U64 off = (sweep_idx*8)%BENCH_WATCH_OFFSET;
+    for(U64 page_idx = 0; page_idx < BENCH_PAGE_COUNT; page_idx += 1)
+    {
+      *(volatile U64 *)(region + page_idx*BENCH_PAGE_SIZE + off) = sweep_idx;
+    }
+  }
+  
+  // canary write into the first watched range
+  *(volatile U64 *)(region + BENCH_WATCH_OFFSET) = 1;
+  return 0;
+}
+
+//- debugger side
+
+typedef struct BenchResult BenchResult;
+struct BenchResult
+{
+  B32 good;
+  U64 sweep_us;
+  U64 watch_hit_count;
+};
+
+internal BenchResult
+bench_run(Arena *arena, U64 watch_count)
+{
+  BenchResult result = {0};
+  Temp scratch = temp_begin(arena);
+  
+  // launch self as target
+  OS_LaunchOptions options = {0};
+  str8_list_push(scratch.arena, &options.cmd_line, str8_lit("/proc/self/exe"));
+  str8_list_push(scratch.arena, &options.cmd_line, str8_lit("target"));
+  options.path = os_string_from_system_path(scratch.arena, OS_SystemPath_Current);
+  if(demon_launch_process(&options) == 0)
+  {
+    temp_end(scratch);
+    return result;
+  }
+  
+  // watches spread evenly over the region
+  DEMON_Watch *watches = push_array(scratch.arena, DEMON_Watch, watch_count);
+  
+  DEMON_Handle process = 0;
+  B32 watches_armed = 0;
+  U64 begin_us = 0;
+  for(B32 done = 0; !done;)
+  {
+    DEMON_RunCtrls ctrls = {0};
+    if(watches_armed)
+    {
+      ctrls.watches = watches;
+      ctrls.watch_count = watch_count;
+    }
+    Temp temp = temp_begin(scratch.arena);
+    DEMON_EventList events = demon_run(temp.arena, &ctrls);
+    for(DEMON_EventNode *n = events.first; n != 0; n = n->next)
+    {
+      DEMON_Event *event = &n->v;
+      switch(event->kind)
+      {
+        default:{}break;
+        case DEMON_EventKind_Error:
+        {
+          done = 1;
+        }break;
+        case DEMON_EventKind_CreateProcess:
+        {
+          process = event->process;
+        }break;
+        case DEMON_EventKind_Trap:
+        {
+          // NOTE: the exec stop is a trap too; wait for the one after the mapping
+          U8 probe = 0;
+          if(watches_armed || process == 0 || demon_read_memory(process, &probe, BENCH_REGION_BASE, 1) != 1)
+          {
+            break;
+          }
+          for(U64 idx = 0; idx < watch_count; idx += 1)
+          {
+            U64 page_idx = idx*BENCH_PAGE_COUNT/watch_count;
+            U64 addr = BENCH_REGION_BASE + page_idx*BENCH_PAGE_SIZE + BENCH_WATCH_OFFSET;
+            watches[idx].process = process;
+            watches[idx].vaddr_range = r1u64(addr, addr + BENCH_WATCH_SIZE);
+            watches[idx].id = idx;
+          }
+          watches_armed = 1;
+          begin_us = os_now_microseconds();
+        }break;
+        case DEMON_EventKind_Watch:
+        {
+          result.watch_hit_count += 1;
+        }break;
+        case DEMON_EventKind_ExitProcess:
+        {
+          result.sweep_us = os_now_microseconds() - begin_us;
+          result.good = watches_armed && event->code == 0 && (watch_count == 0 || result.watch_hit_count >= 1);
+          done = 1;
+        }break;
+      }
+    }
+    temp_end(temp);
+  }
+  
+  temp_end(scratch);
+  return result;
+}
+
+int
+main(int argument_count, char **arguments)
+{
+  if(argument_count > 1 && str8_match(str8_cstring(arguments[1]), str8_lit("target"), 0))
+  {
+    return bench_target_main();
+  }
+  
+  os_init(argument_count, arguments);
+  Arena *arena = arena_alloc();
+  demon_init();
+  demon_primary_thread_begin();
+  
+  U64 watch_counts[] = {0, 1, 4, 16, 64, 256};
+  F64 baseline_us = 0;
+  printf("%llu pages x %llu sweeps\n", (U64)BENCH_PAGE_COUNT, (U64)BENCH_SWEEP_COUNT);
+  printf("%8s %14s %10s %8s\n", "watches", "sweep ms", "slowdown", "hits");
+  for(U64 idx = 0; idx < ArrayCount(watch_counts); idx += 1)
+  {
+    BenchResult r = bench_run(arena, watch_counts[idx]);
+    if(!r.good)
+    {
+      printf("%8llu %14s\n", watch_counts[idx], "failed");
+      continue;
+    }
+    if(idx == 0)
+    {
+      baseline_us = (F64)Max(r.sweep_us, 1);
+    }
+    printf("%8llu %14.3f %9.1fx %8llu\n", watch_counts[idx], r.sweep_us/1000.0, r.sweep_us/baseline_us, r.watch_hit_count);
+  }
+  
+  return 0;
+}
@@ -1594,6 +1594,20 @@ demon_os_read_memory(DEMON_Entity *process, void *dst, U64 src_address, U64 size
   return(result);
 }
 
+internal U64
+demon_os_read_memory_ranges(DEMON_Entity *process, DEMON_ReadRange *ranges, U64 range_count){
+  // NOTE: ReadProcessMemory has no vectored form; each range is one call.
+  DEMON_W32_Ext *process_ext = demon_w32_ext(process);
+  HANDLE handle = process_ext->proc.handle;
+  U64 result = 0;
+  for (U64 i = 0; i < range_count; i += 1){
+    DEMON_ReadRange *range = &ranges[i];
+    range->bytes_read = demon_w32_read_memory(handle, range->dst, range->src_address, range->size);
+    result += range->bytes_read;
+  }
+  return(result);
+}
+
 internal B32
 demon_os_write_memory(DEMON_Entity *process, U64 dst_address, void *src, U64 size){
   DEMON_W32_Ext *process_ext = demon_w32_ext(process);
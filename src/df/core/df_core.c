@@ -2998,7 +2998,7 @@ df_dbgi_parse_from_binary_file(DBGI_Scope *scope, DF_Entity *binary)
 {
   Temp scratch = scratch_begin(0, 0);
   String8 exe_path = df_full_path_from_entity(scratch.arena, binary);
-  DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, exe_path, 0);
+  DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, exe_path, DBGI_ParseTier_Full, 0);
   scratch_end(scratch);
   return dbgi;
 }
@@ -3013,7 +3013,7 @@ df_symbol_name_from_binary_voff(Arena *arena, DF_Entity *binary, U64 voff)
     Temp scratch = scratch_begin(&arena, 1);
     DBGI_Scope *scope = dbgi_scope_open();
     String8 path = df_full_path_from_entity(scratch.arena, binary);
-    DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, path, 0);
+    DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, path, DBGI_ParseTier_Publics, 0);
     RADDBG_Parsed *rdbg = &dbgi->rdbg;
     if(rdbg->scope_vmap != 0)
     {
@@ -3072,7 +3072,7 @@ df_text_line_src2dasm_info_list_array_from_src_line_range(Arena *arena, DF_Entit
       // rjf: binary -> rdbg
       DF_Entity *binary = binary_n->entity;
       String8 binary_path = df_full_path_from_entity(scratch.arena, binary);
-      DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, 0);
+      DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, DBGI_ParseTier_Full, 0);
       RADDBG_Parsed *rdbg = &dbgi->rdbg;
       
       // rjf: file_path_normalized * rdbg -> src_id
@@ -3156,7 +3156,7 @@ df_text_line_dasm2src_info_from_binary_voff(DF_Entity *binary, U64 voff)
   Temp scratch = scratch_begin(0, 0);
   DBGI_Scope *scope = dbgi_scope_open();
   String8 path = df_full_path_from_entity(scratch.arena, binary);
-  DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, path, 0);
+  DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, path, DBGI_ParseTier_Full, 0);
   RADDBG_Parsed *rdbg = &dbgi->rdbg;
   DF_TextLineDasm2SrcInfo result = {0};
   result.file = result.binary = &df_g_nil_entity;
@@ -3221,7 +3221,7 @@ df_voff_from_binary_symbol_name(DF_Entity *binary, String8 symbol_name)
   U64 result = 0;
   {
     String8 binary_path = df_full_path_from_entity(scratch.arena, binary);
-    DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, 0);
+    DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, DBGI_ParseTier_Full, 0);
     RADDBG_Parsed *rdbg = &dbgi->rdbg;
     RADDBG_NameMapKind name_map_kinds[] =
     {
@@ -3304,7 +3304,7 @@ df_type_num_from_binary_name(DF_Entity *binary, String8 name)
   U64 result = 0;
   {
     String8 binary_path = df_full_path_from_entity(scratch.arena, binary);
-    DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, 0);
+    DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, DBGI_ParseTier_Full, 0);
     RADDBG_Parsed *rdbg = &dbgi->rdbg;
     RADDBG_NameMap *name_map = raddbg_name_map_from_kind(rdbg, RADDBG_NameMapKind_Types);
     RADDBG_ParsedNameMap parsed_name_map = {0};
@@ -3460,13 +3460,117 @@ df_architecture_from_entity(DF_Entity *entity)
   return entity->arch;
 }
 
+internal B32
+df_unwind_memview_fetch_page(void *u, U64 page_addr, void *out)
+{
+  DF_UnwindProcessInfo *process = (DF_UnwindProcessInfo *)u;
+  Temp scratch = scratch_begin(0, 0);
+  U64 read_size = 0;
+  String8 data = ctrl_query_cached_data_from_process_vaddr_range__read_size(scratch.arena, process->machine_id, process->handle, r1u64(page_addr, page_addr+UNW_MEMVIEW_PAGE_SIZE), &read_size);
+  B32 result = (read_size == UNW_MEMVIEW_PAGE_SIZE);
+  if(result)
+  {
+    MemoryCopy(out, data.str, UNW_MEMVIEW_PAGE_SIZE);
+  }
+  scratch_end(scratch);
+  return result;
+}
+
+internal DF_UnwindProcessInfo *
+df_push_unwind_process_info_from_process(Arena *arena, DF_Entity *process)
+{
+  DF_UnwindProcessInfo *info = push_array(arena, DF_UnwindProcessInfo, 1);
+  info->machine_id = process->ctrl_machine_id;
+  info->handle = process->ctrl_handle;
+  for(DF_Entity *child = process->first; !df_entity_is_nil(child); child = child->next)
+  {
+    info->module_count += (child->kind == DF_EntityKind_Module);
+  }
+  info->modules = push_array(arena, DF_UnwindModule, info->module_count);
+  U64 module_idx = 0;
+  for(DF_Entity *child = process->first; !df_entity_is_nil(child); child = child->next)
+  {
+    if(child->kind == DF_EntityKind_Module)
+    {
+      DF_UnwindModule *module = &info->modules[module_idx];
+      module->vaddr_range = child->vaddr_rng;
+      module->base_vaddr = df_base_vaddr_from_module(child);
+      module->binary_path = df_full_path_from_entity(arena, df_binary_file_from_module(child));
+      module_idx += 1;
+    }
+  }
+  return info;
+}
+
+internal DF_UnwindThreadInfo
+df_unwind_thread_info_from_thread(DF_Entity *thread, DF_UnwindProcessInfo *process_info)
+{
+  DF_UnwindThreadInfo info = {0};
+  info.arch = df_architecture_from_entity(thread);
+  info.machine_id = thread->ctrl_machine_id;
+  info.handle = thread->ctrl_handle;
+  info.stack_base = thread->stack_base;
+  info.process = process_info;
+  return info;
+}
+
+internal DF_UnwindModuleInfo *
+df_unwind_module_info_from_vaddr(DF_UnwindModuleCache *cache, DBGI_Scope *scope, DF_UnwindProcessInfo *process, U64 vaddr)
+{
+  DF_UnwindModule *module = 0;
+  for(U64 idx = 0; idx < process->module_count; idx += 1)
+  {
+    if(contains_1u64(process->modules[idx].vaddr_range, vaddr))
+    {
+      module = &process->modules[idx];
+      break;
+    }
+  }
+  DF_UnwindModuleInfo *info = 0;
+  for(DF_UnwindModuleInfo *n = cache->first; n != 0; n = n->next)
+  {
+    if(n->module == module)
+    {
+      info = n;
+      break;
+    }
+  }
+  if(info == 0)
+  {
+    info = push_array(cache->arena, DF_UnwindModuleInfo, 1);
+    info->module = module;
+    if(module != 0)
+    {
+      DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, module->binary_path, DBGI_ParseTier_Publics, 0);
+      info->binary_data = str8((U8 *)dbgi->exe_base, dbgi->exe_props.size);
+      info->pe = &dbgi->pe;
+    }
+    SLLStackPush(cache->first, info);
+  }
+  return info;
+}
+
 internal DF_Unwind
 df_push_unwind_from_thread(Arena *arena, DF_Entity *thread)
 {
-  ProfBeginFunction();
   Temp scratch = scratch_begin(&arena, 1);
   DBGI_Scope *scope = dbgi_scope_open();
-  Architecture arch = df_architecture_from_entity(thread);
+  DF_Entity *process = df_entity_ancestor_from_kind(thread, DF_EntityKind_Process);
+  DF_UnwindProcessInfo *process_info = df_push_unwind_process_info_from_process(scratch.arena, process);
+  DF_UnwindThreadInfo thread_info = df_unwind_thread_info_from_thread(thread, process_info);
+  DF_UnwindModuleCache module_cache = {scratch.arena};
+  DF_Unwind unwind = df_push_unwind_from_thread_info__module_cache(arena, scope, &module_cache, &thread_info);
+  dbgi_scope_close(scope);
+  scratch_end(scratch);
+  return unwind;
+}
+
+internal DF_Unwind
+df_push_unwind_from_thread_info__module_cache(Arena *arena, DBGI_Scope *scope, DF_UnwindModuleCache *module_cache, DF_UnwindThreadInfo *thread)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+  Architecture arch = thread->arch;
   U64 arch_reg_block_size = regs_block_size_from_architecture(arch);
   DF_Unwind unwind = {0};
   unwind.error = 1;
@@ -3475,13 +3579,13 @@ df_push_unwind_from_thread(Arena *arena, DF_Entity *thread)
     default:{}break;
     case Architecture_x64:
     {
-      DF_Entity *process = df_entity_ancestor_from_kind(thread, DF_EntityKind_Process);
+      DF_UnwindProcessInfo *process = thread->process;
       
       // rjf: grab initial register block
       void *regs_block = push_array(scratch.arena, U8, arch_reg_block_size);
       B32 regs_block_good = 0;
       {
-        void *regs_raw = ctrl_reg_block_from_thread(thread->ctrl_machine_id, thread->ctrl_handle);
+        void *regs_raw = ctrl_reg_block_from_thread(thread->machine_id, thread->handle);
         if(regs_raw != 0)
         {
           MemoryCopy(regs_block, regs_raw, arch_reg_block_size);
@@ -3489,7 +3593,8 @@ df_push_unwind_from_thread(Arena *arena, DF_Entity *thread)
         }
       }
       
-      // rjf: grab initial memory view
+      // grab initial memory view - stack pages are pulled in lazily, so
+      // the cost of unwinding scales with the frames walked, not stack size
       B32 stack_memview_good = 0;
       UNW_MemView stack_memview = {0};
       if(regs_block_good)
@@ -3498,19 +3603,10 @@ df_push_unwind_from_thread(Arena *arena, DF_Entity *thread)
         U64 stack_top_unrounded = regs_rsp_from_arch_block(arch, regs_block);
         U64 stack_base = AlignPow2(stack_base_unrounded, KB(4));
         U64 stack_top = AlignDownPow2(stack_top_unrounded, KB(4));
-        U64 stack_size = stack_base - stack_top;
-        if(stack_base >= stack_top)
+        if(stack_base > stack_top)
         {
-          String8 stack_memory = {0};
-          stack_memory.str = push_array_no_zero(scratch.arena, U8, stack_size);
-          stack_memory.size = ctrl_process_read(process->ctrl_machine_id, process->ctrl_handle, r1u64(stack_top, stack_top+stack_size), stack_memory.str);
-          if(stack_memory.size != 0)
-          {
-            stack_memview_good = 1;
-            stack_memview.data = stack_memory.str;
-            stack_memview.addr_first = stack_top;
-            stack_memview.addr_opl = stack_base;
-          }
+          stack_memview_good = 1;
+          stack_memview = unw_memview_from_fetch_page(scratch.arena, r1u64(stack_top, stack_base), df_unwind_memview_fetch_page, process);
         }
       }
       
@@ -3520,10 +3616,8 @@ df_push_unwind_from_thread(Arena *arena, DF_Entity *thread)
       {
         unwind.error = 0;
         
-        // rjf: regs -> rip*module*binary
+        // rjf: regs -> rip
         U64 rip = regs_rip_from_arch_block(arch, regs_block);
-        DF_Entity *module = df_module_from_process_vaddr(process, rip);
-        DF_Entity *binary = df_binary_file_from_module(module);
         
         // rjf: cancel on 0 rip
         if(rip == 0)
@@ -3531,10 +3625,9 @@ df_push_unwind_from_thread(Arena *arena, DF_Entity *thread)
           break;
         }
         
-        // rjf: binary -> all the binary info
-        String8 binary_full_path = df_full_path_from_entity(scratch.arena, binary);
-        DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_full_path, 0);
-        String8 binary_data = str8((U8 *)dbgi->exe_base, dbgi->exe_props.size);
+        // rjf: rip -> module -> all the binary info (resolved once per module)
+        DF_UnwindModuleInfo *module_info = df_unwind_module_info_from_vaddr(module_cache, scope, process, rip);
+        String8 binary_data = module_info->binary_data;
         
         // rjf: cancel on bad data
         if(binary_data.size == 0)
@@ -3552,7 +3645,7 @@ df_push_unwind_from_thread(Arena *arena, DF_Entity *thread)
         unwind.count += 1;
         
         // rjf: unwind one step
-        UNW_Result unwind_step = unw_pe_x64(binary_data, &dbgi->pe, df_base_vaddr_from_module(module), &memview, (UNW_X64_Regs *)regs_block);
+        UNW_Result unwind_step = unw_pe_x64(binary_data, module_info->pe, module_info->module->base_vaddr, &memview, (UNW_X64_Regs *)regs_block);
         
         // rjf: cancel on bad step
         if(unwind_step.dead != 0)
@@ -3571,12 +3664,42 @@ df_push_unwind_from_thread(Arena *arena, DF_Entity *thread)
       }
     }break;
   }
-  dbgi_scope_close(scope);
   scratch_end(scratch);
   ProfEnd();
   return unwind;
 }
 
+internal DF_Unwind
+df_push_unwind_copy(Arena *arena, Architecture arch, DF_Unwind *src)
+{
+  U64 arch_reg_block_size = regs_block_size_from_architecture(arch);
+  DF_Unwind dst = {0};
+  dst.error = src->error;
+  for(DF_UnwindFrame *src_frame = src->first; src_frame != 0; src_frame = src_frame->next)
+  {
+    DF_UnwindFrame *dst_frame = push_array(arena, DF_UnwindFrame, 1);
+    dst_frame->rip = src_frame->rip;
+    dst_frame->regs = push_array_no_zero(arena, U8, arch_reg_block_size);
+    MemoryCopy(dst_frame->regs, src_frame->regs, arch_reg_block_size);
+    SLLQueuePush(dst.first, dst.last, dst_frame);
+    dst.count += 1;
+  }
+  return dst;
+}
+
+internal TS_TASK_FUNCTION_DEF(df_unwind_gather_task__entry_point)
+{
+  DF_UnwindGatherTaskParams *params = (DF_UnwindGatherTaskParams *)p;
+  DBGI_Scope *scope = dbgi_scope_open();
+  DF_UnwindModuleCache module_cache = {arena};
+  for(U64 idx = 0; idx < params->thread_count; idx += 1)
+  {
+    params->unwinds_out[idx] = df_push_unwind_from_thread_info__module_cache(arena, scope, &module_cache, &params->threads[idx]);
+  }
+  dbgi_scope_close(scope);
+  return 0;
+}
+
 internal U64
 df_rip_from_thread(DF_Entity *thread)
 {
@@ -3611,7 +3734,7 @@ df_push_locals_map_from_binary_voff(Arena *arena, DBGI_Scope *scope, DF_Entity *
 {
   Temp scratch = scratch_begin(&arena, 1);
   String8 binary_path = df_full_path_from_entity(scratch.arena, binary);
-  DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, 0);
+  DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, DBGI_ParseTier_Full, 0);
   RADDBG_Parsed *rdbg = &dbgi->rdbg;
   EVAL_String2NumMap *result = eval_push_locals_map_from_raddbg_voff(arena, rdbg, voff);
   scratch_end(scratch);
@@ -3623,7 +3746,7 @@ df_push_member_map_from_binary_voff(Arena *arena, DBGI_Scope *scope, DF_Entity *
 {
   Temp scratch = scratch_begin(&arena, 1);
   String8 binary_path = df_full_path_from_entity(scratch.arena, binary);
-  DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, 0);
+  DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, DBGI_ParseTier_Full, 0);
   RADDBG_Parsed *rdbg = &dbgi->rdbg;
   EVAL_String2NumMap *result = eval_push_member_map_from_raddbg_voff(arena, rdbg, voff);
   scratch_end(scratch);
@@ -3879,15 +4002,26 @@ df_eval_memory_read(void *u, void *out, U64 addr, U64 size)
 {
   DF_Entity *process = (DF_Entity *)u;
   Assert(process->kind == DF_EntityKind_Process);
-  Temp scratch = scratch_begin(0, 0);
   B32 result = 0;
-  String8 data = ctrl_query_cached_data_from_process_vaddr_range(scratch.arena, process->ctrl_machine_id, process->ctrl_handle, r1u64(addr, addr+size));
-  if(data.size == size)
+  
+  //- serve from the active batch's snapshot, if it has the range
+  if(df_eval_batch_read(df_state->eval_batch, process, out, addr, size))
   {
     result = 1;
-    MemoryCopy(out, data.str, data.size);
   }
-  scratch_end(scratch);
+  
+  //- otherwise, read through ctrl
+  else
+  {
+    Temp scratch = scratch_begin(0, 0);
+    String8 data = ctrl_query_cached_data_from_process_vaddr_range(scratch.arena, process->ctrl_machine_id, process->ctrl_handle, r1u64(addr, addr+size));
+    if(data.size == size)
+    {
+      result = 1;
+      MemoryCopy(out, data.str, data.size);
+    }
+    scratch_end(scratch);
+  }
   return result;
 }
 
@@ -3899,7 +4033,7 @@ df_eval_parse_ctx_from_module_voff(DBGI_Scope *scope, DF_Entity *module, U64 vof
   //- rjf: extract info
   DF_Entity *binary = df_binary_file_from_module(module);
   String8 binary_path = df_full_path_from_entity(scratch.arena, binary);
-  DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, 0);
+  DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, DBGI_ParseTier_Full, 0);
   RADDBG_Parsed *rdbg = &dbgi->rdbg;
   Architecture arch = df_architecture_from_entity(module);
   EVAL_String2NumMap *reg_map = ctrl_string2reg_from_arch (arch);
@@ -3947,7 +4081,7 @@ df_eval_parse_ctx_from_src_loc(DBGI_Scope *scope, DF_Entity *file, TxtPt pt)
       // rjf: binary -> rdbg
       DF_Entity *binary = binary_n->entity;
       String8 binary_path = df_full_path_from_entity(scratch.arena, binary);
-      DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, 0);
+      DBGI_Parse *dbgi = dbgi_parse_from_exe_path(scope, binary_path, DBGI_ParseTier_Full, 0);
       RADDBG_Parsed *rdbg = &dbgi->rdbg;
       
       // rjf: file_path_normalized * rdbg -> src_id
@@ -4036,12 +4170,9 @@ df_eval_parse_ctx_from_src_loc(DBGI_Scope *scope, DF_Entity *file, TxtPt pt)
   return ctx;
 }
 
-internal DF_Eval
-df_eval_from_string(Arena *arena, DBGI_Scope *scope, DF_CtrlCtx *ctrl_ctx, EVAL_ParseCtx *parse_ctx, String8 string)
+internal EVAL_Machine
+df_eval_machine_from_ctrl_ctx(Arena *arena, DF_CtrlCtx *ctrl_ctx)
 {
-  ProfBeginFunction();
-  Temp scratch = scratch_begin(&arena, 1);
-  
   //- rjf: unpack arguments
   DF_Entity *thread = df_entity_from_handle(ctrl_ctx->thread);
   DF_Entity *process = thread->parent;
@@ -4050,7 +4181,7 @@ df_eval_from_string(Arena *arena, DBGI_Scope *scope, DF_CtrlCtx *ctrl_ctx, EVAL_
   Architecture arch = df_architecture_from_entity(thread);
   U64 reg_size = regs_block_size_from_architecture(arch);
   U64 thread_unwind_ip_vaddr = 0;
-  void *thread_unwind_regs_block = push_array(scratch.arena, U8, reg_size);
+  void *thread_unwind_regs_block = push_array(arena, U8, reg_size);
   {
     U64 idx = 0;
     for(DF_UnwindFrame *f = unwind.first; f != 0; f = f->next, idx += 1)
@@ -4064,6 +4195,30 @@ df_eval_from_string(Arena *arena, DBGI_Scope *scope, DF_CtrlCtx *ctrl_ctx, EVAL_
     }
   }
   
+  //- grab module
+  DF_Entity *module = df_module_from_process_vaddr(process, thread_unwind_ip_vaddr);
+  
+  //- build machine
+  U64 *module_base = push_array(arena, U64, 1);
+  U64 *tls_base = push_array(arena, U64, 1);
+  *module_base = df_base_vaddr_from_module(module);
+  *tls_base = df_tls_base_vaddr_from_thread(thread);
+  EVAL_Machine machine = {0};
+  machine.u = (void *)process;
+  machine.arch = arch;
+  machine.memory_read = df_eval_memory_read;
+  machine.reg_data = thread_unwind_regs_block;
+  machine.reg_size = reg_size;
+  machine.module_base = module_base;
+  machine.tls_base = tls_base;
+  return machine;
+}
+
+internal DF_EvalCompilation
+df_eval_compilation_from_string(Arena *arena, EVAL_ParseCtx *parse_ctx, String8 string)
+{
+  ProfBeginFunction();
+  
   //- rjf: lex & parse
   EVAL_TokenArray tokens = eval_token_array_from_text(arena, string);
   EVAL_ParseResult parse = eval_parse_expr_from_text_tokens(arena, parse_ctx, string, &tokens);
@@ -4092,31 +4247,46 @@ df_eval_from_string(Arena *arena, DBGI_Scope *scope, DF_CtrlCtx *ctrl_ctx, EVAL_
     bytecode = eval_bytecode_from_oplist(arena, &op_list);
   }
   
-  //- rjf: grab thread/module
-  DF_Entity *module = df_module_from_process_vaddr(process, thread_unwind_ip_vaddr);
+  //- fill result; the program isn't pre-decoded here, as most compilations
+  // are evaluated once
+  DF_EvalCompilation result = zero_struct;
+  result.errors = errors;
+  result.type_key = ir_tree_and_type.type_key;
+  result.mode = ir_tree_and_type.mode;
+  result.program.arch = parse_ctx->arch;
+  result.program.bytecode = bytecode;
+  ProfEnd();
+  return result;
+}
+
+internal DF_Eval
+df_eval_from_string(Arena *arena, DBGI_Scope *scope, DF_CtrlCtx *ctrl_ctx, EVAL_ParseCtx *parse_ctx, String8 string)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  //- compile, or reuse the active batch's compilation
+  DF_EvalCompilation *compilation = df_eval_batch_compilation_from_string(df_state->eval_batch, parse_ctx, string);
+  DF_EvalCompilation fresh_compilation = zero_struct;
+  if(compilation == 0)
+  {
+    fresh_compilation = df_eval_compilation_from_string(arena, parse_ctx, string);
+    compilation = &fresh_compilation;
+  }
   
   //- rjf: evaluate
   EVAL_Result eval = {0};
-  if(bytecode.size != 0)
+  if(compilation->program.bytecode.size != 0)
   {
-    U64 module_base = df_base_vaddr_from_module(module);
-    U64 tls_base = df_tls_base_vaddr_from_thread(thread);
-    EVAL_Machine machine = {0};
-    machine.u = (void *)thread->parent;
-    machine.arch = arch;
-    machine.memory_read = df_eval_memory_read;
-    machine.reg_data = thread_unwind_regs_block;
-    machine.reg_size = reg_size;
-    machine.module_base = &module_base;
-    machine.tls_base = &tls_base;
-    eval = eval_interpret(&machine, bytecode);
+    EVAL_Machine machine = df_eval_machine_from_ctrl_ctx(scratch.arena, ctrl_ctx);
+    eval = eval_interpret_program(&machine, &compilation->program);
   }
   
   //- rjf: fill result
   DF_Eval result = zero_struct;
   {
-    result.type_key = ir_tree_and_type.type_key;
-    result.mode = ir_tree_and_type.mode;
+    result.type_key = compilation->type_key;
+    result.mode = compilation->mode;
     switch(result.mode)
     {
       default:
@@ -4136,7 +4306,7 @@ df_eval_from_string(Arena *arena, DBGI_Scope *scope, DF_CtrlCtx *ctrl_ctx, EVAL_
         (void)reg_size;
       }break;
     }
-    result.errors = errors;
+    result.errors = compilation->errors;
   }
   
   scratch_end(scratch);
@@ -4168,7 +4338,12 @@ df_value_mode_eval_from_eval(TG_Graph *graph, RADDBG_Parsed *rdbg, DF_CtrlCtx *c
         Rng1U64 vaddr_range = r1u64(eval.offset, eval.offset + type_byte_size);
         if(dim_1u64(vaddr_range) == type_byte_size)
         {
-          String8 data = ctrl_query_cached_data_from_process_vaddr_range(scratch.arena, process->ctrl_machine_id, process->ctrl_handle, vaddr_range);
+          U8 batch_data[sizeof(U64)] = {0};
+          String8 data = str8(batch_data, type_byte_size);
+          if(!df_eval_batch_read(df_state->eval_batch, process, batch_data, vaddr_range.min, type_byte_size))
+          {
+            data = ctrl_query_cached_data_from_process_vaddr_range(scratch.arena, process->ctrl_machine_id, process->ctrl_handle, vaddr_range);
+          }
           MemoryZeroArray(eval.imm_u128);
           MemoryCopy(eval.imm_u128, data.str, Min(data.size, sizeof(U64)*2));
           eval.mode = EVAL_EvalMode_Value;
@@ -4231,6 +4406,272 @@ df_eval_from_eval_cfg_table(Arena *arena, DBGI_Scope *scope, DF_CtrlCtx *ctrl_ct
   return eval;
 }
 
+////////////////////////////////
+//~ Evaluation Batches
+
+internal int
+df_eval_batch_qsort_compare_ranges(Rng1U64 *a, Rng1U64 *b)
+{
+  int result = 0;
+  if(a->min < b->min)
+  {
+    result = -1;
+  }
+  else if(a->min > b->min)
+  {
+    result = +1;
+  }
+  return result;
+}
+
+internal DF_EvalBatchPage *
+df_eval_batch_page_from_vaddr(DF_EvalBatch *batch, U64 vaddr)
+{
+  DF_EvalBatchPage *result = 0;
+  U64 slot_idx = (vaddr/DF_EVAL_BATCH_PAGE_SIZE)%batch->page_slots_count;
+  for(DF_EvalBatchPage *page = batch->page_slots[slot_idx]; page != 0; page = page->hash_next)
+  {
+    if(page->vaddr == vaddr)
+    {
+      result = page;
+      break;
+    }
+  }
+  return result;
+}
+
+internal void
+df_eval_batch_push_miss(DF_EvalBatch *batch, Rng1U64 range)
+{
+  DF_EvalBatchMiss *miss = push_array(batch->arena, DF_EvalBatchMiss, 1);
+  miss->range = range;
+  SLLQueuePush(batch->first_miss, batch->last_miss, miss);
+  batch->miss_count += 1;
+}
+
+internal DF_EvalBatch *
+df_eval_batch_begin(Arena *arena, DF_CtrlCtx *ctrl_ctx, EVAL_ParseCtx *parse_ctx, String8List *exprs)
+{
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+  DF_Entity *thread = df_entity_from_handle(ctrl_ctx->thread);
+  DF_Entity *process = thread->parent;
+  
+  //- allocate batch
+  DF_EvalBatch *batch = push_array(arena, DF_EvalBatch, 1);
+  batch->arena = arena;
+  batch->parse_ctx = parse_ctx;
+  batch->process = process;
+  batch->expr_slots_count = 64;
+  batch->expr_slots = push_array(arena, DF_EvalBatchExpr *, batch->expr_slots_count);
+  batch->page_slots_count = 256;
+  batch->page_slots = push_array(arena, DF_EvalBatchPage *, batch->page_slots_count);
+  
+  //- compile & pre-decode all expressions
+  DF_EvalBatchExpr **exprs_array = push_array(scratch.arena, DF_EvalBatchExpr *, exprs->node_count);
+  U64 exprs_array_count = 0;
+  for(String8Node *n = exprs->first; n != 0; n = n->next)
+  {
+    if(df_eval_batch_compilation_from_string(batch, parse_ctx, n->string) != 0)
+    {
+      continue;
+    }
+    U64 hash = df_hash_from_string(n->string);
+    U64 slot_idx = hash%batch->expr_slots_count;
+    DF_EvalBatchExpr *expr = push_array(arena, DF_EvalBatchExpr, 1);
+    expr->hash = hash;
+    expr->string = push_str8_copy(arena, n->string);
+    expr->compilation = df_eval_compilation_from_string(arena, parse_ctx, expr->string);
+    if(expr->compilation.program.bytecode.size != 0)
+    {
+      expr->compilation.program = eval_program_from_bytecode(arena, parse_ctx->arch, expr->compilation.program.bytecode);
+    }
+    SLLStackPush_N(batch->expr_slots[slot_idx], expr, hash_next);
+    exprs_array[exprs_array_count] = expr;
+    exprs_array_count += 1;
+  }
+  
+  //- prefetch the memory which the expressions read, in rounds
+  if(process->kind == DF_EntityKind_Process)
+  {
+    EVAL_Machine machine = df_eval_machine_from_ctrl_ctx(scratch.arena, ctrl_ctx);
+    machine.memory_read = df_eval_batch_memory_read__record;
+    machine.u = batch;
+    for(U64 round_idx = 0; round_idx < DF_EVAL_BATCH_PREFETCH_ROUND_COUNT; round_idx += 1)
+    {
+      //- run all expressions which haven't completed against the snapshot
+      batch->first_miss = batch->last_miss = 0;
+      batch->miss_count = 0;
+      for(U64 idx = 0; idx < exprs_array_count; idx += 1)
+      {
+        DF_EvalBatchExpr *expr = exprs_array[idx];
+        if(expr->prefetch_done || expr->compilation.program.bytecode.size == 0)
+        {
+          continue;
+        }
+        U64 miss_count_before = batch->miss_count;
+        EVAL_Result eval = eval_interpret_program(&machine, &expr->compilation.program);
+        if(batch->miss_count != miss_count_before)
+        {
+          continue;
+        }
+        expr->prefetch_done = 1;
+        
+        // addresses => also prefetch the value they point at
+        if(expr->compilation.mode == EVAL_EvalMode_Addr && !eval.bad_eval)
+        {
+          U64 value_size = tg_byte_size_from_graph_raddbg_key(parse_ctx->type_graph, parse_ctx->rdbg, expr->compilation.type_key);
+          value_size = Min(value_size, DF_EVAL_BATCH_VALUE_PREFETCH_MAX_SIZE);
+          Rng1U64 value_range = r1u64(eval.value.u64, eval.value.u64 + value_size);
+          if(dim_1u64(value_range) == value_size && value_size != 0)
+          {
+            for(U64 vaddr = AlignDownPow2(value_range.min, DF_EVAL_BATCH_PAGE_SIZE); vaddr < value_range.max; vaddr += DF_EVAL_BATCH_PAGE_SIZE)
+            {
+              if(df_eval_batch_page_from_vaddr(batch, vaddr) == 0)
+              {
+                df_eval_batch_push_miss(batch, value_range);
+                break;
+              }
+            }
+          }
+        }
+      }
+      if(batch->miss_count == 0)
+      {
+        break;
+      }
+      
+      //- gather & sort page-aligned missed ranges
+      Rng1U64 *ranges = push_array_no_zero(scratch.arena, Rng1U64, batch->miss_count);
+      U64 ranges_count = 0;
+      for(DF_EvalBatchMiss *miss = batch->first_miss; miss != 0; miss = miss->next)
+      {
+        ranges[ranges_count] = r1u64(AlignDownPow2(miss->range.min, DF_EVAL_BATCH_PAGE_SIZE), AlignPow2(miss->range.max, DF_EVAL_BATCH_PAGE_SIZE));
+        ranges_count += 1;
+      }
+      qsort(ranges, ranges_count, sizeof(Rng1U64), (int (*)(const void *, const void *))df_eval_batch_qsort_compare_ranges);
+      
+      //- fetch each contiguous run with one read, then insert its pages
+      for(U64 run_first_idx = 0, run_opl_idx = 0; run_first_idx < ranges_count; run_first_idx = run_opl_idx)
+      {
+        Rng1U64 run = ranges[run_first_idx];
+        for(run_opl_idx = run_first_idx+1; run_opl_idx < ranges_count && ranges[run_opl_idx].min <= run.max; run_opl_idx += 1)
+        {
+          run.max = Max(run.max, ranges[run_opl_idx].max);
+        }
+        String8 data = ctrl_query_cached_data_from_process_vaddr_range(arena, process->ctrl_machine_id, process->ctrl_handle, run);
+        ctrl_stop_snapshot_mark_hot_range(process->ctrl_machine_id, process->ctrl_handle, run);
+        if(data.size != dim_1u64(run))
+        {
+          continue;
+        }
+        for(U64 vaddr = run.min; vaddr < run.max; vaddr += DF_EVAL_BATCH_PAGE_SIZE)
+        {
+          if(df_eval_batch_page_from_vaddr(batch, vaddr) == 0)
+          {
+            U64 slot_idx = (vaddr/DF_EVAL_BATCH_PAGE_SIZE)%batch->page_slots_count;
+            DF_EvalBatchPage *page = push_array(arena, DF_EvalBatchPage, 1);
+            page->vaddr = vaddr;
+            page->data = data.str + (vaddr - run.min);
+            SLLStackPush_N(batch->page_slots[slot_idx], page, hash_next);
+          }
+        }
+      }
+    }
+    batch->first_miss = batch->last_miss = 0;
+    batch->miss_count = 0;
+  }
+  
+  //- activate
+  batch->prev_active = df_state->eval_batch;
+  df_state->eval_batch = batch;
+  
+  scratch_end(scratch);
+  ProfEnd();
+  return batch;
+}
+
+internal void
+df_eval_batch_end(DF_EvalBatch *batch)
+{
+  if(df_state->eval_batch == batch)
+  {
+    df_state->eval_batch = batch->prev_active;
+  }
+}
+
+internal DF_EvalCompilation *
+df_eval_batch_compilation_from_string(DF_EvalBatch *batch, EVAL_ParseCtx *parse_ctx, String8 string)
+{
+  DF_EvalCompilation *result = 0;
+  if(batch != 0 && batch->parse_ctx == parse_ctx)
+  {
+    U64 hash = df_hash_from_string(string);
+    U64 slot_idx = hash%batch->expr_slots_count;
+    for(DF_EvalBatchExpr *expr = batch->expr_slots[slot_idx]; expr != 0; expr = expr->hash_next)
+    {
+      if(expr->hash == hash && str8_match(expr->string, string, 0))
+      {
+        result = &expr->compilation;
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+internal B32
+df_eval_batch_read(DF_EvalBatch *batch, DF_Entity *process, void *out, U64 addr, U64 size)
+{
+  B32 result = 0;
+  if(batch != 0 && batch->process == process && addr + size >= addr)
+  {
+    //- check that every page of the range is in the snapshot
+    result = 1;
+    U64 first_page_vaddr = AlignDownPow2(addr, DF_EVAL_BATCH_PAGE_SIZE);
+    for(U64 vaddr = first_page_vaddr; vaddr < addr + size; vaddr += DF_EVAL_BATCH_PAGE_SIZE)
+    {
+      if(df_eval_batch_page_from_vaddr(batch, vaddr) == 0)
+      {
+        result = 0;
+        break;
+      }
+    }
+    
+    //- copy out page-by-page
+    if(result)
+    {
+      U8 *out_u8 = (U8 *)out;
+      for(U64 off = 0; off < size;)
+      {
+        U64 vaddr = addr + off;
+        U64 page_off = vaddr & (DF_EVAL_BATCH_PAGE_SIZE-1);
+        U64 copy_size = Min(size - off, DF_EVAL_BATCH_PAGE_SIZE - page_off);
+        DF_EvalBatchPage *page = df_eval_batch_page_from_vaddr(batch, vaddr - page_off);
+        MemoryCopy(out_u8 + off, page->data + page_off, copy_size);
+        off += copy_size;
+      }
+    }
+  }
+  return result;
+}
+
+internal B32
+df_eval_batch_memory_read__record(void *u, void *out, U64 addr, U64 size)
+{
+  DF_EvalBatch *batch = (DF_EvalBatch *)u;
+  B32 result = df_eval_batch_read(batch, batch->process, out, addr, size);
+  
+  // NOTE: ranges which ctrl would refuse (e.g. non-canonical addresses) are
+  // not recorded, as no round of prefetching could satisfy them.
+  if(!result && size != 0 && size <= DF_EVAL_BATCH_VALUE_PREFETCH_MAX_SIZE &&
+     addr + size > addr && addr + size <= 0x000FFFFFFFFFFFFFull)
+  {
+    df_eval_batch_push_miss(batch, r1u64(addr, addr + size));
+  }
+  return result;
+}
+
 ////////////////////////////////
 //~ rjf: Evaluation Views
 
@@ -5911,6 +6352,12 @@ df_query_cached_rip_from_thread(DF_Entity *thread)
   {
     result = unwind.first->rip;
   }
+  else
+  {
+    // NOTE: unwinds land a frame or more after a stop; the top frame's rip
+    // is just the thread's, so don't wait for it
+    result = df_rip_from_thread(thread);
+  }
   return result;
 }
 
@@ -5928,6 +6375,10 @@ df_query_cached_rip_from_thread_unwind(DF_Entity *thread, U64 unwind_count)
       break;
     }
   }
+  if(unwind.first == 0 && unwind_count == 0)
+  {
+    result = df_rip_from_thread(thread);
+  }
   return result;
 }
 
@@ -6089,6 +6540,7 @@ df_core_init(String8 user_path, String8 profile_path, DF_StateDeltaHistory *hist
   
   // rjf: set up per-run caches
   df_state->unwind_cache.arena = arena_alloc();
+  df_state->unwind_cache.gather_arena = arena_alloc();
   df_state->locals_cache.arena = arena_alloc();
   df_state->member_cache.arena = arena_alloc();
   
@@ -6488,15 +6940,83 @@ df_core_begin_frame(Arena *arena, DF_CmdList *cmds, F32 dt)
       df_state->member_cache_invalidated = 1;
     }
     
-    //- rjf: refresh unwind cache
-    if(df_state->unwind_cache_invalidated && !df_ctrl_targets_running()) ProfScope("per-thread unwind gather")
+    //- gather pass done? -> commit results, stamped so that failed unwinds
+    // are only retried after memory or debug info changes. results from
+    // before an invalidation are dropped.
+    if(df_state->unwind_cache.gather_task_count != 0)
+    {
+      DF_RunUnwindCache *cache = &df_state->unwind_cache;
+      B32 gather_done = 1;
+      for(U64 task_idx = 0; task_idx < cache->gather_task_count; task_idx += 1)
+      {
+        gather_done = gather_done && ts_ticket_is_done(cache->gather_tickets[task_idx]);
+      }
+      if(gather_done) ProfScope("per-thread unwind commit")
+      {
+        for(U64 task_idx = 0; task_idx < cache->gather_task_count; task_idx += 1)
+        {
+          ts_join(cache->gather_tickets[task_idx]);
+        }
+        B32 good = 1;
+        if(!df_state->unwind_cache_invalidated)
+        {
+          for(U64 idx = 0; idx < cache->gather_thread_count; idx += 1)
+          {
+            DF_Handle thread_handle = cache->gather_threads[idx];
+            U64 hash = df_hash_from_string(str8_struct(&thread_handle));
+            U64 slot_idx = hash % cache->table_size;
+            DF_RunUnwindCacheSlot *slot = &cache->table[slot_idx];
+            for(DF_RunUnwindCacheNode *n = slot->first; n != 0; n = n->hash_next)
+            {
+              if(df_handle_match(n->thread, thread_handle))
+              {
+                n->unwind = df_push_unwind_copy(cache->arena, cache->gather_thread_infos[idx].arch, &cache->gather_unwinds[idx]);
+                n->attempt_count += 1;
+                n->attempt_memgen_idx = cache->gather_memgen_idx;
+                n->attempt_parse_gen = cache->gather_parse_gen;
+                break;
+              }
+            }
+            good = good && (cache->gather_unwinds[idx].error == 0);
+          }
+          df_state->unwind_cache_incomplete = !good;
+        }
+        for(U64 task_idx = 0; task_idx < cache->gather_task_count; task_idx += 1)
+        {
+          arena_clear(cache->gather_task_arenas[task_idx]);
+        }
+        arena_clear(cache->gather_arena);
+        cache->gather_task_count = 0;
+      }
+    }
+    
+    //- reset unwind cache (once no gather pass is using it)
+    if(df_state->unwind_cache_invalidated && !df_ctrl_targets_running() && df_state->unwind_cache.gather_task_count == 0)
     {
-      B32 good = 1;
-      DF_EntityList all_threads = df_query_cached_entity_list_with_kind(DF_EntityKind_Thread);
       DF_RunUnwindCache *cache = &df_state->unwind_cache;
       arena_clear(cache->arena);
       cache->table_size = 1024;
       cache->table = push_array(cache->arena, DF_RunUnwindCacheSlot, cache->table_size);
+      df_state->unwind_cache_invalidated = 0;
+      df_state->unwind_cache_incomplete = 1;
+    }
+    
+    //- refresh unwind cache - kick off unwinds of all threads which don't
+    // have a good unwind yet, split across the task system. threads which
+    // failed at the current memgen index & dbgi parse generation would only
+    // fail again, so they wait for one of those to move.
+    if(df_state->unwind_cache_incomplete && !df_state->unwind_cache_invalidated && !df_ctrl_targets_running() && df_state->unwind_cache.gather_task_count == 0) ProfScope("per-thread unwind gather kickoff")
+    {
+      Temp scratch = scratch_begin(0, 0);
+      DF_RunUnwindCache *cache = &df_state->unwind_cache;
+      U64 memgen_idx = ctrl_memgen_idx();
+      U64 parse_gen = dbgi_parse_gen();
+      
+      // gather threads needing an unwind
+      DF_EntityList all_threads = df_query_cached_entity_list_with_kind(DF_EntityKind_Thread);
+      DF_Entity **threads = push_array_no_zero(scratch.arena, DF_Entity *, all_threads.count);
+      U64 thread_count = 0;
+      B32 any_failed = 0;
       for(DF_EntityNode *n = all_threads.first; n != 0; n = n->next)
       {
         DF_Entity *thread = n->entity;
@@ -6504,17 +7024,87 @@ df_core_begin_frame(Arena *arena, DF_CmdList *cmds, F32 dt)
         U64 hash = df_hash_from_string(str8_struct(&thread_handle));
         U64 slot_idx = hash % cache->table_size;
         DF_RunUnwindCacheSlot *slot = &cache->table[slot_idx];
-        DF_RunUnwindCacheNode *cache_node = push_array(cache->arena, DF_RunUnwindCacheNode, 1);
-        cache_node->thread = thread_handle;
-        cache_node->unwind = df_push_unwind_from_thread(cache->arena, thread);
-        SLLQueuePush_NZ(0, slot->first, slot->last, cache_node, hash_next);
+        DF_RunUnwindCacheNode *cache_node = 0;
+        for(DF_RunUnwindCacheNode *node = slot->first; node != 0; node = node->hash_next)
+        {
+          if(df_handle_match(node->thread, thread_handle))
+          {
+            cache_node = node;
+            break;
+          }
+        }
+        if(cache_node == 0)
+        {
+          cache_node = push_array(cache->arena, DF_RunUnwindCacheNode, 1);
+          cache_node->thread = thread_handle;
+          cache_node->unwind.error = 1;
+          SLLQueuePush_NZ(0, slot->first, slot->last, cache_node, hash_next);
+        }
         if(cache_node->unwind.error != 0)
         {
-          good = 0;
+          any_failed = 1;
+          if(cache_node->attempt_count == 0 ||
+             cache_node->attempt_memgen_idx != memgen_idx ||
+             cache_node->attempt_parse_gen != parse_gen)
+          {
+            threads[thread_count] = thread;
+            thread_count += 1;
+          }
+        }
+      }
+      
+      // capture unwind inputs, shared per process
+      cache->gather_memgen_idx = memgen_idx;
+      cache->gather_parse_gen = parse_gen;
+      cache->gather_thread_count = thread_count;
+      cache->gather_threads = push_array_no_zero(cache->gather_arena, DF_Handle, thread_count);
+      cache->gather_thread_infos = push_array_no_zero(cache->gather_arena, DF_UnwindThreadInfo, thread_count);
+      cache->gather_unwinds = push_array(cache->gather_arena, DF_Unwind, thread_count);
+      {
+        DF_Entity *last_process = &df_g_nil_entity;
+        DF_UnwindProcessInfo *last_process_info = 0;
+        for(U64 idx = 0; idx < thread_count; idx += 1)
+        {
+          DF_Entity *process = df_entity_ancestor_from_kind(threads[idx], DF_EntityKind_Process);
+          if(process != last_process || last_process_info == 0)
+          {
+            last_process = process;
+            last_process_info = df_push_unwind_process_info_from_process(cache->gather_arena, process);
+          }
+          cache->gather_threads[idx] = df_handle_from_entity(threads[idx]);
+          cache->gather_thread_infos[idx] = df_unwind_thread_info_from_thread(threads[idx], last_process_info);
+        }
+      }
+      
+      // kick off unwind tasks - the results are picked up by a later frame
+      U64 task_count = Min(thread_count, Min(ts_thread_count()*4, DF_UNWIND_GATHER_TASK_COUNT_MAX));
+      U64 threads_per_task = task_count ? (thread_count + task_count - 1)/task_count : 0;
+      cache->gather_task_count = 0;
+      for(U64 task_idx = 0; task_idx < task_count; task_idx += 1)
+      {
+        U64 first_thread_idx = task_idx*threads_per_task;
+        U64 opl_thread_idx = Min(first_thread_idx + threads_per_task, thread_count);
+        if(first_thread_idx >= opl_thread_idx)
+        {
           break;
         }
+        if(cache->gather_task_arenas[task_idx] == 0)
+        {
+          cache->gather_task_arenas[task_idx] = arena_alloc();
+        }
+        DF_UnwindGatherTaskParams *params = push_array(cache->gather_arena, DF_UnwindGatherTaskParams, 1);
+        params->threads = cache->gather_thread_infos + first_thread_idx;
+        params->thread_count = opl_thread_idx - first_thread_idx;
+        params->unwinds_out = cache->gather_unwinds + first_thread_idx;
+        cache->gather_tickets[task_idx] = ts_kickoff(df_unwind_gather_task__entry_point, cache->gather_task_arenas[task_idx], params);
+        cache->gather_task_count += 1;
       }
-      df_state->unwind_cache_invalidated = !good;
+      if(cache->gather_task_count == 0)
+      {
+        df_state->unwind_cache_incomplete = any_failed;
+        arena_clear(cache->gather_arena);
+      }
+      scratch_end(scratch);
     }
     
     //- rjf: clear locals cache
@@ -6555,6 +7145,15 @@ df_core_begin_frame(Arena *arena, DF_CmdList *cmds, F32 dt)
           DF_Entity *task = df_entity_alloc(0, df_entity_root(), DF_EntityKind_ConversionTask);
           df_entity_equip_name(0, task, event->string);
         }break;
+        case DBGI_EventKind_ConversionProgress:
+        {
+          DF_Entity *task = df_entity_from_name_and_kind(event->string, DF_EntityKind_ConversionTask);
+          if(!df_entity_is_nil(task))
+          {
+            df_entity_equip_rng1u64(task, r1u64(event->units_processed, event->units_total));
+            df_entity_equip_u64(task, event->bytes_total != 0 ? (100*event->bytes_processed)/event->bytes_total : 0);
+          }
+        }break;
         case DBGI_EventKind_ConversionEnded:
         {
           DF_Entity *task = df_entity_from_name_and_kind(event->string, DF_EntityKind_ConversionTask);
@@ -638,6 +638,75 @@ struct DF_TextLineDasm2SrcInfoList
   U64 count;
 };
 
+////////////////////////////////
+//~ Evaluation Batch Types
+//
+// Evaluating a batch of expressions (e.g. every root of a watch view)
+// one-by-one issues one small process memory read per MemRead op, and one
+// per leaf value. A batch compiles all of its expressions up front, then
+// runs them in a few rounds against a local page snapshot: each round
+// records the reads which missed the snapshot (plus the value ranges of
+// expressions which produced addresses), then fetches all of those pages
+// with one ctrl read per contiguous run. Reads which depend on the results
+// of other reads are discovered in later rounds. While a batch is active,
+// df_eval_from_string reuses its compilations, and evaluation reads are
+// served from its snapshot. Fetched runs are also marked as hot for ctrl's
+// stop-time snapshot, so they're prefetched when the target next stops.
+
+#define DF_EVAL_BATCH_PAGE_SIZE KB(4)
+#define DF_EVAL_BATCH_PREFETCH_ROUND_COUNT 4
+#define DF_EVAL_BATCH_VALUE_PREFETCH_MAX_SIZE KB(16)
+
+typedef struct DF_EvalCompilation DF_EvalCompilation;
+struct DF_EvalCompilation
+{
+  EVAL_ErrorList errors;
+  TG_Key type_key;
+  EVAL_EvalMode mode;
+  EVAL_Program program;
+};
+
+typedef struct DF_EvalBatchExpr DF_EvalBatchExpr;
+struct DF_EvalBatchExpr
+{
+  DF_EvalBatchExpr *hash_next;
+  U64 hash;
+  String8 string;
+  DF_EvalCompilation compilation;
+  B32 prefetch_done;
+};
+
+typedef struct DF_EvalBatchPage DF_EvalBatchPage;
+struct DF_EvalBatchPage
+{
+  DF_EvalBatchPage *hash_next;
+  U64 vaddr;
+  U8 *data;
+};
+
+typedef struct DF_EvalBatchMiss DF_EvalBatchMiss;
+struct DF_EvalBatchMiss
+{
+  DF_EvalBatchMiss *next;
+  Rng1U64 range;
+};
+
+typedef struct DF_EvalBatch DF_EvalBatch;
+struct DF_EvalBatch
+{
+  DF_EvalBatch *prev_active;
+  Arena *arena;
+  EVAL_ParseCtx *parse_ctx;
+  DF_Entity *process;
+  U64 expr_slots_count;
+  DF_EvalBatchExpr **expr_slots;
+  U64 page_slots_count;
+  DF_EvalBatchPage **page_slots;
+  DF_EvalBatchMiss *first_miss;
+  DF_EvalBatchMiss *last_miss;
+  U64 miss_count;
+};
+
 ////////////////////////////////
 //~ rjf: Evaluation Visualization Types
 
@@ -954,6 +1023,64 @@ struct DF_EntityListCache
   DF_EntityList list;
 };
 
+//- per-thread unwind inputs - captured from entities on the frame thread, so
+// that unwinds can run on other threads while the entity tree changes
+
+typedef struct DF_UnwindModule DF_UnwindModule;
+struct DF_UnwindModule
+{
+  Rng1U64 vaddr_range;
+  U64 base_vaddr;
+  String8 binary_path;
+};
+
+typedef struct DF_UnwindProcessInfo DF_UnwindProcessInfo;
+struct DF_UnwindProcessInfo
+{
+  CTRL_MachineID machine_id;
+  CTRL_Handle handle;
+  DF_UnwindModule *modules;
+  U64 module_count;
+};
+
+typedef struct DF_UnwindThreadInfo DF_UnwindThreadInfo;
+struct DF_UnwindThreadInfo
+{
+  Architecture arch;
+  CTRL_MachineID machine_id;
+  CTRL_Handle handle;
+  U64 stack_base;
+  DF_UnwindProcessInfo *process;
+};
+
+//- per-unwind-pass module info (resolved once per module, not per frame)
+
+typedef struct DF_UnwindModuleInfo DF_UnwindModuleInfo;
+struct DF_UnwindModuleInfo
+{
+  DF_UnwindModuleInfo *next;
+  DF_UnwindModule *module;
+  String8 binary_data;
+  PE_BinInfo *pe;
+};
+
+typedef struct DF_UnwindModuleCache DF_UnwindModuleCache;
+struct DF_UnwindModuleCache
+{
+  Arena *arena;
+  DF_UnwindModuleInfo *first;
+};
+
+//- all-threads unwind gather task parameters
+
+typedef struct DF_UnwindGatherTaskParams DF_UnwindGatherTaskParams;
+struct DF_UnwindGatherTaskParams
+{
+  DF_UnwindThreadInfo *threads;
+  U64 thread_count;
+  DF_Unwind *unwinds_out;
+};
+
 //- rjf: per-run unwind cache
 
 typedef struct DF_RunUnwindCacheNode DF_RunUnwindCacheNode;
@@ -962,6 +1089,12 @@ struct DF_RunUnwindCacheNode
   DF_RunUnwindCacheNode *hash_next;
   DF_Handle thread;
   DF_Unwind unwind;
+  
+  // retry stamp - the memgen index & dbgi parse generation of the last
+  // attempt. a failed unwind is only retried once one of them has moved.
+  U64 attempt_count;
+  U64 attempt_memgen_idx;
+  U64 attempt_parse_gen;
 };
 
 typedef struct DF_RunUnwindCacheSlot DF_RunUnwindCacheSlot;
@@ -971,12 +1104,30 @@ struct DF_RunUnwindCacheSlot
   DF_RunUnwindCacheNode *last;
 };
 
+// NOTE: a gather pass runs on the task system without the frame thread
+// waiting on it; a later frame commits its results once every task is done.
+// tasks unwind into per-task arenas which are reused by every pass - results
+// are copied into the cache's arena when committed.
+#define DF_UNWIND_GATHER_TASK_COUNT_MAX 64
+
 typedef struct DF_RunUnwindCache DF_RunUnwindCache;
 struct DF_RunUnwindCache
 {
   Arena *arena;
   U64 table_size;
   DF_RunUnwindCacheSlot *table;
+  
+  // in-flight gather pass
+  Arena *gather_arena;
+  U64 gather_memgen_idx;
+  U64 gather_parse_gen;
+  U64 gather_thread_count;
+  DF_Handle *gather_threads;
+  DF_UnwindThreadInfo *gather_thread_infos;
+  DF_Unwind *gather_unwinds;
+  U64 gather_task_count;
+  TS_Ticket gather_tickets[DF_UNWIND_GATHER_TASK_COUNT_MAX];
+  Arena *gather_task_arenas[DF_UNWIND_GATHER_TASK_COUNT_MAX];
 };
 
 //- rjf: per-run locals cache
@@ -1129,12 +1280,16 @@ struct DF_State
   
   // rjf: per-run caches
   B32 unwind_cache_invalidated;
+  B32 unwind_cache_incomplete;
   DF_RunUnwindCache unwind_cache;
   B32 locals_cache_invalidated;
   DF_RunLocalsCache locals_cache;
   B32 member_cache_invalidated;
   DF_RunLocalsCache member_cache;
   
+  // active evaluation batch
+  DF_EvalBatch *eval_batch;
+  
   // rjf: eval view cache
   DF_EvalViewCache eval_view_cache;
   
@@ -1529,7 +1684,13 @@ internal DF_Entity *df_module_from_process_vaddr(DF_Entity *process, U64 vaddr);
 internal DF_Entity *df_module_from_thread(DF_Entity *thread);
 internal U64 df_tls_base_vaddr_from_thread(DF_Entity *thread);
 internal Architecture df_architecture_from_entity(DF_Entity *entity);
+internal B32 df_unwind_memview_fetch_page(void *u, U64 page_addr, void *out);
+internal DF_UnwindProcessInfo *df_push_unwind_process_info_from_process(Arena *arena, DF_Entity *process);
+internal DF_UnwindThreadInfo df_unwind_thread_info_from_thread(DF_Entity *thread, DF_UnwindProcessInfo *process_info);
+internal DF_UnwindModuleInfo *df_unwind_module_info_from_vaddr(DF_UnwindModuleCache *cache, DBGI_Scope *scope, DF_UnwindProcessInfo *process, U64 vaddr);
 internal DF_Unwind df_push_unwind_from_thread(Arena *arena, DF_Entity *thread);
+internal DF_Unwind df_push_unwind_from_thread_info__module_cache(Arena *arena, DBGI_Scope *scope, DF_UnwindModuleCache *module_cache, DF_UnwindThreadInfo *thread);
+internal DF_Unwind df_push_unwind_copy(Arena *arena, Architecture arch, DF_Unwind *src);
 internal U64 df_rip_from_thread(DF_Entity *thread);
 internal U64 df_rip_from_thread_unwind(DF_Entity *thread, U64 unwind_count);
 internal EVAL_String2NumMap *df_push_locals_map_from_binary_voff(Arena *arena, DBGI_Scope *scope, DF_Entity *binary, U64 voff);
@@ -1560,10 +1721,24 @@ internal CTRL_Event df_ctrl_last_stop_event(void);
 internal B32 df_eval_memory_read(void *u, void *out, U64 addr, U64 size);
 internal EVAL_ParseCtx df_eval_parse_ctx_from_module_voff(DBGI_Scope *scope, DF_Entity *module, U64 voff);
 internal EVAL_ParseCtx df_eval_parse_ctx_from_src_loc(DBGI_Scope *scope, DF_Entity *file, TxtPt pt);
+internal EVAL_Machine df_eval_machine_from_ctrl_ctx(Arena *arena, DF_CtrlCtx *ctrl_ctx);
+internal DF_EvalCompilation df_eval_compilation_from_string(Arena *arena, EVAL_ParseCtx *parse_ctx, String8 string);
 internal DF_Eval df_eval_from_string(Arena *arena, DBGI_Scope *scope, DF_CtrlCtx *ctrl_ctx, EVAL_ParseCtx *parse_ctx, String8 string);
 internal DF_Eval df_value_mode_eval_from_eval(TG_Graph *graph, RADDBG_Parsed *rdbg, DF_CtrlCtx *ctrl_ctx, DF_Eval eval);
 internal DF_Eval df_eval_from_eval_cfg_table(Arena *arena, DBGI_Scope *scope, DF_CtrlCtx *ctrl_ctx, EVAL_ParseCtx *parse_ctx, DF_Eval eval, DF_CfgTable *cfg);
 
+////////////////////////////////
+//~ Evaluation Batches
+
+internal int df_eval_batch_qsort_compare_ranges(Rng1U64 *a, Rng1U64 *b);
+internal DF_EvalBatchPage *df_eval_batch_page_from_vaddr(DF_EvalBatch *batch, U64 vaddr);
+internal void df_eval_batch_push_miss(DF_EvalBatch *batch, Rng1U64 range);
+internal DF_EvalBatch *df_eval_batch_begin(Arena *arena, DF_CtrlCtx *ctrl_ctx, EVAL_ParseCtx *parse_ctx, String8List *exprs);
+internal void df_eval_batch_end(DF_EvalBatch *batch);
+internal DF_EvalCompilation *df_eval_batch_compilation_from_string(DF_EvalBatch *batch, EVAL_ParseCtx *parse_ctx, String8 string);
+internal B32 df_eval_batch_read(DF_EvalBatch *batch, DF_Entity *process, void *out, U64 addr, U64 size);
+internal B32 df_eval_batch_memory_read__record(void *u, void *out, U64 addr, U64 size);
+
 ////////////////////////////////
 //~ rjf: Evaluation Views
 
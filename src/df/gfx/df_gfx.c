@@ -3240,6 +3240,37 @@ df_window_update_and_render(Arena *arena, OS_EventList *events, DF_Window *ws, D
             ui_spacer(ui_em(2.f, 1.f));
             ui_labelf("Average UI Hash Chain Length: %f", avg_ui_hash_chain_length);
           }
+          HS_Stats hs_stats_ = hs_stats();
+          ui_labelf("Hash Store:");
+          ui_set_next_pref_width(ui_children_sum(1));
+          ui_set_next_pref_height(ui_children_sum(1));
+          UI_Row
+          {
+            ui_spacer(ui_em(2.f, 1.f));
+            ui_labelf("Resident: %I64u MB / %I64u MB (%I64u blobs)", hs_stats_.resident_bytes/MB(1), hs_stats_.budget_bytes/MB(1), hs_stats_.resident_node_count);
+          }
+          ui_set_next_pref_width(ui_children_sum(1));
+          ui_set_next_pref_height(ui_children_sum(1));
+          UI_Row
+          {
+            ui_spacer(ui_em(2.f, 1.f));
+            ui_labelf("Hits: %I64u, Misses: %I64u", hs_stats_.hit_count, hs_stats_.miss_count);
+          }
+          ui_set_next_pref_width(ui_children_sum(1));
+          ui_set_next_pref_height(ui_children_sum(1));
+          UI_Row
+          {
+            ui_spacer(ui_em(2.f, 1.f));
+            ui_labelf("Evictions: %I64u (%I64u MB)", hs_stats_.eviction_count, hs_stats_.evicted_bytes/MB(1));
+          }
+          ui_labelf("Breakpoint Condition Cache:");
+          ui_set_next_pref_width(ui_children_sum(1));
+          ui_set_next_pref_height(ui_children_sum(1));
+          UI_Row
+          {
+            ui_spacer(ui_em(2.f, 1.f));
+            ui_labelf("Hits: %I64u, Misses: %I64u", ctrl_condition_cache_hit_count(), ctrl_condition_cache_miss_count());
+          }
         }
         
         //- rjf: draw entity file tree
@@ -4648,6 +4679,10 @@ df_window_update_and_render(Arena *arena, OS_EventList *events, DF_Window *ws, D
             String8 raddbg_path = task->name;
             String8 raddbg_name = str8_skip_last_slash(raddbg_path);
             String8 task_text = push_str8f(scratch.arena, "Creating %S...", raddbg_name);
+            if(task->rng1u64.max != 0)
+            {
+              task_text = push_str8f(scratch.arena, "Creating %S... %I64u%% (%I64u/%I64u units)", raddbg_name, task->u64, task->rng1u64.min, task->rng1u64.max);
+            }
             UI_Key key = ui_key_from_stringf(ui_key_zero(), "task_%p", task);
             UI_Box *box = ui_build_box_from_key(UI_BoxFlag_DrawHotEffects|UI_BoxFlag_DrawText|UI_BoxFlag_DrawBorder|UI_BoxFlag_DrawBackground|UI_BoxFlag_Clickable, key);
             UI_Signal sig = ui_signal_from_box(box);
@@ -11010,6 +11045,12 @@ df_gfx_begin_frame(Arena *arena, DF_CmdList *cmds)
     df_gfx_request_frame();
   }
   
+  //- unwinds being gathered? -> keep rendering, to pick up the results
+  if(df_state->unwind_cache.gather_task_count != 0)
+  {
+    df_gfx_request_frame();
+  }
+  
   //- rjf: process top-level graphical commands
   {
     B32 cfg_write_done[DF_CfgSrc_COUNT] = {0};
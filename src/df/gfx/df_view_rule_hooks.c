@@ -716,11 +716,21 @@ DF_GFX_VIEW_RULE_BLOCK_UI_FUNCTION_DEF(text)
     //- rjf: address range -> hash
     U128 hash = ctrl_stored_hash_from_process_vaddr_range(process->ctrl_machine_id, process->ctrl_handle, vaddr_range, 1);
     
-    //- rjf: hash -> data
-    String8 data = hs_data_from_hash(hs_scope, hash);
+    //- hash -> data; if the hash store evicted it, the range is being
+    // re-read - show nothing until it's back
+    B32 data_evicted = 0;
+    String8 data = hs_data_from_hash_evicted(hs_scope, hash, &data_evicted);
+    if(data_evicted)
+    {
+      df_gfx_request_frame();
+    }
     
     //- rjf: key * hash -> parsed text info
-    TXT_TextInfo info = txt_text_info_from_key_hash_lang(txt_scope, text_key, hash, top.lang);
+    TXT_TextInfo info = {0};
+    if(!data_evicted)
+    {
+      info = txt_text_info_from_key_hash_lang(txt_scope, text_key, hash, top.lang);
+    }
     
     //- rjf: info -> code slice info
     DF_CodeSliceParams code_slice_params = {0};
@@ -967,7 +977,12 @@ DF_GFX_VIEW_RULE_BLOCK_UI_FUNCTION_DEF(bitmap)
       {
         if(dim.y > (F32)topology_info.height)
         {
-          String8 data = hs_data_from_hash(hs_scope, hash);
+          B32 data_evicted = 0;
+          String8 data = hs_data_from_hash_evicted(hs_scope, hash, &data_evicted);
+          if(data_evicted)
+          {
+            df_gfx_request_frame();
+          }
           U64 bytes_per_pixel = r_tex2d_format_bytes_per_pixel_table[topology.fmt];
           U64 mouse_pixel_off = mouse_bitmap_px_off.y*topology_info.width + mouse_bitmap_px_off.x;
           U64 mouse_byte_off = mouse_pixel_off * bytes_per_pixel;
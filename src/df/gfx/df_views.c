@@ -659,6 +659,17 @@ internal DF_EvalVizBlockList
 df_eval_viz_block_list_from_watch_view_state(Arena *arena, DBGI_Scope *scope, DF_CtrlCtx *ctrl_ctx, EVAL_ParseCtx *parse_ctx, DF_EvalWatchViewState *ews)
 {
   ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  //- compile all roots & prefetch the memory they read up front
+  String8List root_expr_strings = {0};
+  for(DF_EvalRoot *root = ews->first_root; root != 0; root = root->next)
+  {
+    str8_list_push(scratch.arena, &root_expr_strings, df_string_from_eval_root(root));
+  }
+  DF_EvalBatch *batch = df_eval_batch_begin(arena, ctrl_ctx, parse_ctx, &root_expr_strings);
+  
+  //- build blocks for each root
   DF_EvalVizBlockList blocks = {0};
   for(DF_EvalRoot *root = ews->first_root; root != 0; root = root->next)
   {
@@ -669,6 +680,9 @@ df_eval_viz_block_list_from_watch_view_state(Arena *arena, DBGI_Scope *scope, DF
     DF_EvalVizBlockList root_blocks = df_eval_viz_block_list_from_eval_view_expr(arena, scope, ctrl_ctx, parse_ctx, root_view, root_expr_string);
     df_eval_viz_block_list_concat__in_place(&blocks, &root_blocks);
   }
+  
+  df_eval_batch_end(batch);
+  scratch_end(scratch);
   ProfEnd();
   return blocks;
 }
@@ -7512,11 +7526,54 @@ DF_VIEW_UI_FUNCTION_DEF(Memory)
         mv->last_viewed_memory_cache_run_idx = current_run_idx;
       }
       
+      // keep the visible range registered as a snapshot region, so each stop
+      // records versions of it; a run moves the diffed memgen pair forward
+      if(!df_ctrl_targets_running() && !df_entity_is_nil(process))
+      {
+        B32 region_changed = (mv->snapshot_region_machine_id != process->ctrl_machine_id ||
+                              !ctrl_handle_match(mv->snapshot_region_process, process->ctrl_handle) ||
+                              mv->snapshot_region_range.min != chunk_aligned_range_bytes.min ||
+                              mv->snapshot_region_range.max != chunk_aligned_range_bytes.max);
+        if(region_changed && mv->snapshot_region_range.max > mv->snapshot_region_range.min)
+        {
+          ctrl_mem_snapshot_region_remove(mv->snapshot_region_machine_id, mv->snapshot_region_process, mv->snapshot_region_range);
+          MemoryZeroStruct(&mv->snapshot_region_range);
+        }
+        if(ctrl_mem_snapshot_region_add(process->ctrl_machine_id, process->ctrl_handle, chunk_aligned_range_bytes))
+        {
+          mv->snapshot_region_machine_id = process->ctrl_machine_id;
+          mv->snapshot_region_process = process->ctrl_handle;
+          mv->snapshot_region_range = chunk_aligned_range_bytes;
+        }
+        if(run_happened)
+        {
+          mv->diff_memgen_idx_a = mv->diff_memgen_idx_b;
+          mv->diff_memgen_idx_b = ctrl_memgen_idx();
+        }
+      }
+      
       scratch_end(scratch);
     }
     visible_memory = mv->last_viewed_memory_cache_buffer + viz_range_bytes.min-chunk_aligned_range_bytes.min;
   }
   
+  //////////////////////////////
+  //- grab bytes changed by the last run
+  //
+  B8 *visible_memory_changed = push_array(scratch.arena, B8, visible_memory_size);
+  if(!df_entity_is_nil(process) && mv->diff_memgen_idx_a != 0 && mv->diff_memgen_idx_a != mv->diff_memgen_idx_b)
+  {
+    CTRL_MemDiff diff = ctrl_mem_diff_from_process_vaddr_range(scratch.arena, process->ctrl_machine_id, process->ctrl_handle, viz_range_bytes, mv->diff_memgen_idx_a, mv->diff_memgen_idx_b);
+    for(CTRL_MemDiffNode *n = diff.first; n != 0; n = n->next)
+    {
+      Rng1U64 range = intersect_1u64(n->vaddr_range, viz_range_bytes);
+      for(U64 vaddr = range.min; vaddr < range.max; vaddr += 1)
+      {
+        visible_memory_changed[vaddr - viz_range_bytes.min] = 1;
+      }
+    }
+  }
+  
   //////////////////////////////
   //- rjf: grab annotations for windowed range of memory
   //
@@ -7882,6 +7939,12 @@ DF_VIEW_UI_FUNCTION_DEF(Memory)
                 cell_bg_rgba.w *= 0.08f;
               }
             }
+            else if(visible_memory_changed[visible_byte_idx])
+            {
+              cell_flags |= UI_BoxFlag_DrawBackground;
+              cell_bg_rgba = df_rgba_from_theme_color(DF_ThemeColor_Highlight1);
+              cell_bg_rgba.w *= 0.2f;
+            }
             if(selection.min <= global_byte_idx && global_byte_idx <= selection.max)
             {
               cell_flags |= UI_BoxFlag_DrawBackground;
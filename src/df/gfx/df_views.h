@@ -388,6 +388,14 @@ struct DF_MemoryViewState
   Rng1U64 last_viewed_memory_cache_range;
   U64 last_viewed_memory_cache_run_idx;
   
+  // changed-by-last-run state: the visible range is kept registered as a
+  // ctrl snapshot region, & diffed between the memgens of the last two stops
+  CTRL_MachineID snapshot_region_machine_id;
+  CTRL_Handle snapshot_region_process;
+  Rng1U64 snapshot_region_range;
+  U64 diff_memgen_idx_a;
+  U64 diff_memgen_idx_b;
+  
   // rjf: control state
   U64 cursor;
   U64 mark;
@@ -4,6 +4,393 @@
 ////////////////////////////////
 //~ allen: Eval Machine Functions
 
+internal B32
+eval_value_op(RADDBG_EvalOp op, U64 imm, EVAL_Slot *svals, EVAL_Slot *nval_out){
+  // NOTE: ops which only compute a new value from popped values and
+  // the immediate; shared by the bytecode interpreter & program runner
+  B32 result = 1;
+  EVAL_Slot nval = {0};
+  switch (op){
+    case RADDBG_EvalOp_Abs:
+    {
+      if (imm == RADDBG_EvalTypeGroup_F32){
+        nval.f32 = svals[0].f32;
+        if (svals[0].f32 < 0){
+          nval.f32 = -svals[0].f32;
+        }
+      }
+      else if (imm == RADDBG_EvalTypeGroup_F64){
+        nval.f64 = svals[0].f64;
+        if (svals[0].f64 < 0){
+          nval.f64 = -svals[0].f64;
+        }
+      }
+      else{
+        nval.s64 = svals[0].s64;
+        if (svals[0].s64 < 0){
+          nval.s64 = -svals[0].s64;
+        }
+      }
+    }break;
+    
+    case RADDBG_EvalOp_Neg:
+    {
+      if (imm == RADDBG_EvalTypeGroup_F32){
+        nval.f32 = -svals[0].f32;
+      }
+      else if (imm == RADDBG_EvalTypeGroup_F64){
+        nval.f64 = -svals[0].f64;
+      }
+      else{
+        nval.u64 = (~svals[0].u64) + 1;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_Add:
+    {
+      if (imm == RADDBG_EvalTypeGroup_F32){
+        nval.f32 = svals[0].f32 + svals[1].f32;
+      }
+      else if (imm == RADDBG_EvalTypeGroup_F64){
+        nval.f64 = svals[0].f64 + svals[1].f64;
+      }
+      else{
+        nval.u64 = svals[0].u64 + svals[1].u64;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_Sub:
+    {
+      if (imm == RADDBG_EvalTypeGroup_F32){
+        nval.f32 = svals[0].f32 - svals[1].f32;
+      }
+      else if (imm == RADDBG_EvalTypeGroup_F64){
+        nval.f64 = svals[0].f64 - svals[1].f64;
+      }
+      else{
+        nval.u64 = svals[0].u64 - svals[1].u64;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_Mul:
+    {
+      if (imm == RADDBG_EvalTypeGroup_F32){
+        nval.f32 = svals[0].f32*svals[1].f32;
+      }
+      else if (imm == RADDBG_EvalTypeGroup_F64){
+        nval.f64 = svals[0].f64*svals[1].f64;
+      }
+      else{
+        nval.u64 = svals[0].u64*svals[1].u64;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_Div:
+    {
+      if (imm == RADDBG_EvalTypeGroup_F32){
+        if (svals[1].f32 != 0.f){
+          nval.f32 = svals[0].f32/svals[1].f32;
+        }
+      }
+      else if (imm == RADDBG_EvalTypeGroup_F64){
+        if (svals[1].f64 != 0.){
+          nval.f64 = svals[0].f64/svals[1].f64;
+        }
+      }
+      else if (imm == RADDBG_EvalTypeGroup_U ||
+               imm == RADDBG_EvalTypeGroup_S){
+        if (svals[1].u64 != 0){
+          nval.u64 = svals[0].u64/svals[1].u64;
+        }
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_Mod:
+    {
+      if (imm == RADDBG_EvalTypeGroup_U ||
+          imm == RADDBG_EvalTypeGroup_S){
+        if (svals[1].u64 != 0){
+          nval.u64 = svals[0].u64%svals[1].u64;
+        }
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_LShift:
+    {
+      if (imm == RADDBG_EvalTypeGroup_U ||
+          imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = svals[0].u64 << svals[1].u64;
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_RShift:
+    {
+      if (imm == RADDBG_EvalTypeGroup_U){
+        nval.u64 = svals[0].u64 >> svals[1].u64;
+      }
+      else if (imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = svals[0].s64 >> svals[1].u64;
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_BitAnd:
+    {
+      if (imm == RADDBG_EvalTypeGroup_U ||
+          imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = svals[0].u64&svals[1].u64;
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_BitOr:
+    {
+      if (imm == RADDBG_EvalTypeGroup_U ||
+          imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = svals[0].u64|svals[1].u64;
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_BitXor:
+    {
+      if (imm == RADDBG_EvalTypeGroup_U ||
+          imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = svals[0].u64^svals[1].u64;
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_BitNot:
+    {
+      if (imm == RADDBG_EvalTypeGroup_U ||
+          imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = ~svals[0].u64;
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_LogAnd:
+    {
+      if (imm == RADDBG_EvalTypeGroup_U ||
+          imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = (svals[0].u64 && svals[1].u64);
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_LogOr:
+    {
+      if (imm == RADDBG_EvalTypeGroup_U ||
+          imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = (svals[0].u64 || svals[1].u64);
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_LogNot:
+    {
+      if (imm == RADDBG_EvalTypeGroup_U ||
+          imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = (!svals[0].u64);
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_EqEq:
+    {
+      nval.u64 = (svals[0].u64 == svals[1].u64);
+    }break;
+    
+    case RADDBG_EvalOp_NtEq:
+    {
+      nval.u64 = (svals[0].u64 != svals[1].u64);
+    }break;
+    
+    case RADDBG_EvalOp_LsEq:
+    {
+      if (imm == RADDBG_EvalTypeGroup_F32){
+        nval.u64 = (svals[0].f32 <= svals[1].f32);
+      }
+      else if (imm == RADDBG_EvalTypeGroup_F64){
+        nval.u64 = (svals[0].f64 <= svals[1].f64);
+      }
+      else if (imm == RADDBG_EvalTypeGroup_U){
+        nval.u64 = (svals[0].u64 <= svals[1].u64);
+      }
+      else if (imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = (svals[0].s64 <= svals[1].s64);
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_GrEq:
+    {
+      if (imm == RADDBG_EvalTypeGroup_F32){
+        nval.u64 = (svals[0].f32 >= svals[1].f32);
+      }
+      else if (imm == RADDBG_EvalTypeGroup_F64){
+        nval.u64 = (svals[0].f64 >= svals[1].f64);
+      }
+      else if (imm == RADDBG_EvalTypeGroup_U){
+        nval.u64 = (svals[0].u64 >= svals[1].u64);
+      }
+      else if (imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = (svals[0].s64 >= svals[1].s64);
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_Less:
+    {
+      if (imm == RADDBG_EvalTypeGroup_F32){
+        nval.u64 = (svals[0].f32 < svals[1].f32);
+      }
+      else if (imm == RADDBG_EvalTypeGroup_F64){
+        nval.u64 = (svals[0].f64 < svals[1].f64);
+      }
+      else if (imm == RADDBG_EvalTypeGroup_U){
+        nval.u64 = (svals[0].u64 < svals[1].u64);
+      }
+      else if (imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = (svals[0].s64 < svals[1].s64);
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_Grtr:
+    {
+      if (imm == RADDBG_EvalTypeGroup_F32){
+        nval.u64 = (svals[0].f32 > svals[1].f32);
+      }
+      else if (imm == RADDBG_EvalTypeGroup_F64){
+        nval.u64 = (svals[0].f64 > svals[1].f64);
+      }
+      else if (imm == RADDBG_EvalTypeGroup_U){
+        nval.u64 = (svals[0].u64 > svals[1].u64);
+      }
+      else if (imm == RADDBG_EvalTypeGroup_S){
+        nval.u64 = (svals[0].s64 > svals[1].s64);
+      }
+      else{
+        result = 0;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_Trunc:
+    {
+      if (0 < imm){
+        U64 mask = 0;
+        if (imm < 64){
+          mask = max_U64 >> (64 - imm);
+        }
+        nval.u64 = svals[0].u64&mask;
+      }
+    }break;
+    
+    case RADDBG_EvalOp_TruncSigned:
+    {
+      if (0 < imm){
+        U64 mask = 0;
+        if (imm < 64){
+          mask = max_U64 >> (64 - imm);
+        }
+        U64 high = 0;
+        if (imm <= 64 && (svals[0].u64 & ((U64)1 << (imm - 1)))){
+          high = ~mask;
+        }
+        nval.u64 = high|(svals[0].u64&mask);
+      }
+    }break;
+    
+    case RADDBG_EvalOp_Convert:
+    {
+      U32 in = imm&0xFF;
+      U32 out = (imm >> 8)&0xFF;
+      if (in != out){
+        switch (in + out*RADDBG_EvalTypeGroup_COUNT){
+          case RADDBG_EvalTypeGroup_F32 + RADDBG_EvalTypeGroup_U*RADDBG_EvalTypeGroup_COUNT:
+          {
+            nval.u64 = (U64)svals[0].f32;
+          }break;
+          case RADDBG_EvalTypeGroup_F64 + RADDBG_EvalTypeGroup_U*RADDBG_EvalTypeGroup_COUNT:
+          {
+            nval.u64 = (U64)svals[0].f64;
+          }break;
+          
+          case RADDBG_EvalTypeGroup_F32 + RADDBG_EvalTypeGroup_S*RADDBG_EvalTypeGroup_COUNT:
+          {
+            nval.s64 = (S64)svals[0].f32;
+          }break;
+          case RADDBG_EvalTypeGroup_F64 + RADDBG_EvalTypeGroup_S*RADDBG_EvalTypeGroup_COUNT:
+          {
+            nval.s64 = (S64)svals[0].f64;
+          }break;
+          
+          case RADDBG_EvalTypeGroup_U + RADDBG_EvalTypeGroup_F32*RADDBG_EvalTypeGroup_COUNT:
+          {
+            nval.f32 = (F32)svals[0].u64;
+          }break;
+          case RADDBG_EvalTypeGroup_S + RADDBG_EvalTypeGroup_F32*RADDBG_EvalTypeGroup_COUNT:
+          {
+            nval.f32 = (F32)svals[0].s64;
+          }break;
+          case RADDBG_EvalTypeGroup_F64 + RADDBG_EvalTypeGroup_F32*RADDBG_EvalTypeGroup_COUNT:
+          {
+            nval.f32 = (F32)svals[0].f64;
+          }break;
+          
+          case RADDBG_EvalTypeGroup_U + RADDBG_EvalTypeGroup_F64*RADDBG_EvalTypeGroup_COUNT:
+          {
+            nval.f64 = (F64)svals[0].u64;
+          }break;
+          case RADDBG_EvalTypeGroup_S + RADDBG_EvalTypeGroup_F64*RADDBG_EvalTypeGroup_COUNT:
+          {
+            nval.f64 = (F64)svals[0].s64;
+          }break;
+          case RADDBG_EvalTypeGroup_F32 + RADDBG_EvalTypeGroup_F64*RADDBG_EvalTypeGroup_COUNT:
+          {
+            nval.f64 = (F64)svals[0].f32;
+          }break;
+        }
+      }
+    }break;
+  }
+  *nval_out = nval;
+  return(result);
+}
+
 internal EVAL_Result
 eval_interpret(EVAL_Machine *machine, String8 bytecode){
   EVAL_Result result = {0};
@@ -175,111 +562,18 @@ eval_interpret(EVAL_Machine *machine, String8 bytecode){
         nval.u64 = imm;
       }break;
       
-      case RADDBG_EvalOp_Abs:
-      {
-        if (imm == RADDBG_EvalTypeGroup_F32){
-          nval.f32 = svals[0].f32;
-          if (svals[0].f32 < 0){
-            nval.f32 = -svals[0].f32;
-          }
-        }
-        else if (imm == RADDBG_EvalTypeGroup_F64){
-          nval.f64 = svals[0].f64;
-          if (svals[0].f64 < 0){
-            nval.f64 = -svals[0].f64;
-          }
-        }
-        else{
-          nval.s64 = svals[0].s64;
-          if (svals[0].s64 < 0){
-            nval.s64 = -svals[0].s64;
-          }
-        }
-      }break;
-      
-      case RADDBG_EvalOp_Neg:
-      {
-        if (imm == RADDBG_EvalTypeGroup_F32){
-          nval.f32 = -svals[0].f32;
-        }
-        else if (imm == RADDBG_EvalTypeGroup_F64){
-          nval.f64 = -svals[0].f64;
-        }
-        else{
-          nval.u64 = (~svals[0].u64) + 1;
-        }
-      }break;
-      
-      case RADDBG_EvalOp_Add:
-      {
-        if (imm == RADDBG_EvalTypeGroup_F32){
-          nval.f32 = svals[0].f32 + svals[1].f32;
-        }
-        else if (imm == RADDBG_EvalTypeGroup_F64){
-          nval.f64 = svals[0].f64 + svals[1].f64;
-        }
-        else{
-          nval.u64 = svals[0].u64 + svals[1].u64;
-        }
-      }break;
-      
-      case RADDBG_EvalOp_Sub:
-      {
-        if (imm == RADDBG_EvalTypeGroup_F32){
-          nval.f32 = svals[0].f32 - svals[1].f32;
-        }
-        else if (imm == RADDBG_EvalTypeGroup_F64){
-          nval.f64 = svals[0].f64 - svals[1].f64;
-        }
-        else{
-          nval.u64 = svals[0].u64 - svals[1].u64;
-        }
-      }break;
-      
-      case RADDBG_EvalOp_Mul:
-      {
-        if (imm == RADDBG_EvalTypeGroup_F32){
-          nval.f32 = svals[0].f32*svals[1].f32;
-        }
-        else if (imm == RADDBG_EvalTypeGroup_F64){
-          nval.f64 = svals[0].f64*svals[1].f64;
-        }
-        else{
-          nval.u64 = svals[0].u64*svals[1].u64;
-        }
-      }break;
-      
-      case RADDBG_EvalOp_Div:
+      default:
       {
-        if (imm == RADDBG_EvalTypeGroup_F32){
-          if (svals[1].f32 != 0.f){
-            nval.f32 = svals[0].f32/svals[1].f32;
-          }
-        }
-        else if (imm == RADDBG_EvalTypeGroup_F64){
-          if (svals[1].f64 != 0.){
-            nval.f64 = svals[0].f64/svals[1].f64;
-          }
-        }
-        else if (imm == RADDBG_EvalTypeGroup_U ||
-                 imm == RADDBG_EvalTypeGroup_S){
-          if (svals[1].u64 != 0){
-            nval.u64 = svals[0].u64/svals[1].u64;
-          }
-        }
-        else{
+        if (!eval_value_op(op, imm, svals, &nval)){
           result.bad_eval = 1;
           goto done;
         }
       }break;
       
-      case RADDBG_EvalOp_Mod:
+      case RADDBG_EvalOp_Pick:
       {
-        if (imm == RADDBG_EvalTypeGroup_U ||
-            imm == RADDBG_EvalTypeGroup_S){
-          if (svals[1].u64 != 0){
-            nval.u64 = svals[0].u64%svals[1].u64;
-          }
+        if (stack_count > imm){
+          nval = stack[stack_count - imm - 1];
         }
         else{
           result.bad_eval = 1;
@@ -287,344 +581,567 @@ eval_interpret(EVAL_Machine *machine, String8 bytecode){
         }
       }break;
       
-      case RADDBG_EvalOp_LShift:
+      case RADDBG_EvalOp_Pop:
       {
-        if (imm == RADDBG_EvalTypeGroup_U ||
-            imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = svals[0].u64 << svals[1].u64;
-        }
-        else{
-          result.bad_eval = 1;
-          goto done;
-        }
+        // do nothing - the pop is handled by the control bits
       }break;
       
-      case RADDBG_EvalOp_RShift:
+      case RADDBG_EvalOp_Insert:
       {
-        if (imm == RADDBG_EvalTypeGroup_U){
-          nval.u64 = svals[0].u64 >> svals[1].u64;
-        }
-        else if (imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = svals[0].s64 >> svals[1].u64;
+        if (stack_count > imm){
+          if (imm > 0){
+            EVAL_Slot tval = stack[stack_count - 1];
+            EVAL_Slot *dst = stack + stack_count - 1 - imm;
+            EVAL_Slot *shift = dst + 1;
+            MemoryCopy(shift, dst, imm*sizeof(EVAL_Slot));
+            *dst = tval;
+          }
         }
         else{
           result.bad_eval = 1;
           goto done;
         }
       }break;
-      
-      case RADDBG_EvalOp_BitAnd:
-      {
-        if (imm == RADDBG_EvalTypeGroup_U ||
-            imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = svals[0].u64&svals[1].u64;
+    }
+    
+    // push
+    {
+      U64 push_count = RADDBG_PUSHN_FROM_CTRLBITS(ctrlbits);
+      if (push_count == 1){
+        if (stack_count < stack_cap){
+          stack[stack_count] = nval;
+          stack_count += 1;
         }
         else{
           result.bad_eval = 1;
           goto done;
         }
-      }break;
-      
-      case RADDBG_EvalOp_BitOr:
-      {
-        if (imm == RADDBG_EvalTypeGroup_U ||
-            imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = svals[0].u64|svals[1].u64;
-        }
-        else{
-          result.bad_eval = 1;
+      }
+    }
+    
+  }
+  done:;
+  
+  if (stack_count == 1){
+    result.value = stack[0];
+  }
+  else{
+    result.bad_eval = 1;
+  }
+  
+  scratch_end(scratch);
+  return(result);
+}
+////////////////////////////////
+//~ Eval Program Functions
+
+internal EVAL_Program
+eval_program_from_bytecode(Arena *arena, Architecture arch, String8 bytecode){
+  EVAL_Program program = {0};
+  program.arch = arch;
+  program.bytecode = bytecode;
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  // decode ops; an undecodable op becomes a failing op which ends decoding
+  U64 op_cap = bytecode.size + 1;
+  U8  *ops      = push_array_no_zero(scratch.arena, U8,  op_cap);
+  U64 *imms     = push_array_no_zero(scratch.arena, U64, op_cap);
+  U64 *next_off = push_array_no_zero(scratch.arena, U64, op_cap);
+  U32 *op_idx_from_off = push_array_no_zero(scratch.arena, U32, bytecode.size + 1);
+  MemorySet(op_idx_from_off, 0xFF, sizeof(U32)*(bytecode.size + 1));
+  U64 op_count = 0;
+  for (U64 off = 0; off < bytecode.size;){
+    U8 op = bytecode.str[off];
+    op_idx_from_off[off] = (U32)op_count;
+    if (op >= RADDBG_EvalOp_COUNT){
+      ops[op_count] = RADDBG_EvalOp_COUNT;
+      op_count += 1;
+      break;
+    }
+    U8 ctrlbits = raddbg_eval_opcode_ctrlbits[op];
+    U32 decode_size = RADDBG_DECODEN_FROM_CTRLBITS(ctrlbits);
+    if (off + 1 + decode_size > bytecode.size){
+      ops[op_count] = RADDBG_EvalOp_COUNT;
+      op_count += 1;
+      break;
+    }
+    U64 imm = 0;
+    MemoryCopy(&imm, bytecode.str + off + 1, decode_size);
+    ops[op_count] = op;
+    imms[op_count] = imm;
+    next_off[op_count] = off + 1 + decode_size;
+    op_count += 1;
+    off += 1 + decode_size;
+  }
+  U64 end_idx = op_count;
+  U32 *jump_idx  = push_array(scratch.arena, U32, op_count + 1);
+  B8  *is_target = push_array(scratch.arena, B8, op_count + 1);
+  S32 *depth_in  = push_array_no_zero(scratch.arena, S32, op_count + 1);
+  B8  *fails     = push_array(scratch.arena, B8, op_count + 1);
+  U64 max_depth = 0;
+  MemorySet(depth_in, 0xFF, sizeof(S32)*(op_count + 1));
+  depth_in[0] = 0;
+  
+  // resolve jump targets; jumps past the end go to the end, jumps into the
+  // middle of an op (or past an undecodable op) can't be pre-decoded
+  for (U64 idx = 0; idx < op_count; idx += 1){
+    if (ops[idx] == RADDBG_EvalOp_Cond || ops[idx] == RADDBG_EvalOp_Skip){
+      U64 target_off = next_off[idx] + imms[idx];
+      U64 target_idx = end_idx;
+      if (target_off >= next_off[idx] && target_off < bytecode.size){
+        target_idx = op_idx_from_off[target_off];
+        if (target_idx == max_U32){
           goto done;
         }
-      }break;
-      
-      case RADDBG_EvalOp_BitXor:
-      {
-        if (imm == RADDBG_EvalTypeGroup_U ||
-            imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = svals[0].u64^svals[1].u64;
+      }
+      jump_idx[idx] = (U32)target_idx;
+      is_target[target_idx] = 1;
+    }
+  }
+  
+  // compute stack depth on entry to each op; since jumps only go forward,
+  // one pass in order sees every predecessor of an op before the op itself
+  for (U64 idx = 0; idx < op_count; idx += 1){
+    S32 depth = depth_in[idx];
+    if (depth < 0){
+      continue;
+    }
+    U8 op = ops[idx];
+    B32 fail = 0;
+    S32 depth_out = depth;
+    if (op == RADDBG_EvalOp_COUNT){
+      fail = 1;
+    }
+    else{
+      U8 ctrlbits = raddbg_eval_opcode_ctrlbits[op];
+      S32 pop_count = RADDBG_POPN_FROM_CTRLBITS(ctrlbits);
+      S32 push_count = RADDBG_PUSHN_FROM_CTRLBITS(ctrlbits);
+      depth_out = depth - pop_count + push_count;
+      if (pop_count > depth || depth_out > EVAL_PROGRAM_STACK_CAP){
+        fail = 1;
+      }
+      else if ((op == RADDBG_EvalOp_Pick || op == RADDBG_EvalOp_Insert) && (U64)depth <= imms[idx]){
+        fail = 1;
+      }
+      else if (op == RADDBG_EvalOp_MemRead && imms[idx] > sizeof(EVAL_Slot)){
+        fail = 1;
+      }
+      else if (op == RADDBG_EvalOp_RegRead && ((imms[idx]&0x00FF00)>>8) > sizeof(EVAL_Slot)){
+        fail = 1;
+      }
+      else if (op == RADDBG_EvalOp_Stop && depth != 1){
+        fail = 1;
+      }
+    }
+    fails[idx] = (B8)fail;
+    if (!fail){
+      max_depth = Max(max_depth, (U64)depth_out);
+    }
+    if (!fail && op != RADDBG_EvalOp_Stop){
+      U64 succs[2] = {0};
+      U64 succ_count = 0;
+      if (op != RADDBG_EvalOp_Skip){
+        succs[succ_count] = idx + 1;
+        succ_count += 1;
+      }
+      if (op == RADDBG_EvalOp_Cond || op == RADDBG_EvalOp_Skip){
+        succs[succ_count] = jump_idx[idx];
+        succ_count += 1;
+      }
+      for (U64 succ_idx = 0; succ_idx < succ_count; succ_idx += 1){
+        S32 *succ_depth = &depth_in[succs[succ_idx]];
+        if (*succ_depth < 0){
+          *succ_depth = depth_out;
         }
-        else{
-          result.bad_eval = 1;
+        else if (*succ_depth != depth_out){
           goto done;
         }
-      }break;
+      }
+    }
+  }
+  
+  // emit instructions
+  {
+    EVAL_ProgramInst *insts = push_array(arena, EVAL_ProgramInst, op_count + 1);
+    U32 *inst_idx_from_op = push_array_no_zero(scratch.arena, U32, op_count + 1);
+    U64 inst_count = 0;
+    for (U64 idx = 0; idx < op_count;){
+      inst_idx_from_op[idx] = (U32)inst_count;
+      S32 depth = depth_in[idx];
+      U8 op = ops[idx];
+      U64 imm = imms[idx];
+      U64 consume_count = 1;
       
-      case RADDBG_EvalOp_BitNot:
-      {
-        if (imm == RADDBG_EvalTypeGroup_U ||
-            imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = ~svals[0].u64;
-        }
-        else{
-          result.bad_eval = 1;
-          goto done;
-        }
-      }break;
+      // unreachable -> nothing
+      if (depth < 0){
+        idx += 1;
+        continue;
+      }
+
+      // statically failing -> fail
+      EVAL_ProgramInst *inst = &insts[inst_count];
+      if (fails[idx]){
+        inst->op = EVAL_ProgramOp_Fail;
+        inst_count += 1;
+        idx += 1;
+        continue;
+      }
       
-      case RADDBG_EvalOp_LogAnd:
-      {
-        if (imm == RADDBG_EvalTypeGroup_U ||
-            imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = (svals[0].u64 && svals[1].u64);
+      // fusable sequences
+#define EVAL_OpIsConst(o) ((o) == RADDBG_EvalOp_ConstU8 || (o) == RADDBG_EvalOp_ConstU16 || \
+(o) == RADDBG_EvalOp_ConstU32 || (o) == RADDBG_EvalOp_ConstU64)
+#define EVAL_FusableAt(i, o) ((i) < op_count && !is_target[(i)] && !fails[(i)] && ops[(i)] == (o))
+      B32 fused = 0;
+      if (EVAL_OpIsConst(op) &&
+          EVAL_FusableAt(idx + 1, RADDBG_EvalOp_Add) &&
+          imms[idx + 1] != RADDBG_EvalTypeGroup_F32 && imms[idx + 1] != RADDBG_EvalTypeGroup_F64){
+        fused = 1;
+        inst->dst = (U16)(depth - 1);
+        inst->imm = imm;
+        if (EVAL_FusableAt(idx + 2, RADDBG_EvalOp_MemRead)){
+          inst->op = EVAL_ProgramOp_AddImmMemRead;
+          inst->size = (U8)imms[idx + 2];
+          consume_count = 3;
         }
         else{
-          result.bad_eval = 1;
-          goto done;
+          inst->op = EVAL_ProgramOp_AddImm;
+          consume_count = 2;
         }
-      }break;
+      }
+      else if (op == RADDBG_EvalOp_RegRead &&
+               idx + 1 < op_count && !is_target[idx + 1] && !fails[idx + 1] && EVAL_OpIsConst(ops[idx + 1]) &&
+               EVAL_FusableAt(idx + 2, RADDBG_EvalOp_Add) &&
+               imms[idx + 2] != RADDBG_EvalTypeGroup_F32 && imms[idx + 2] != RADDBG_EvalTypeGroup_F64){
+        fused = 1;
+        inst->op = EVAL_ProgramOp_RegReadAddImm;
+        inst->dst = (U16)depth;
+        inst->imm2 = imms[idx + 1];
+        consume_count = 3;
+      }
+#undef EVAL_FusableAt
+#undef EVAL_OpIsConst
+      
+      // single ops
+      B32 emit = 1;
+      if (!fused || op == RADDBG_EvalOp_RegRead){
+        U8 ctrlbits = raddbg_eval_opcode_ctrlbits[op];
+        U16 dst = (U16)(depth - RADDBG_POPN_FROM_CTRLBITS(ctrlbits));
+        B32 is_int = (imm != RADDBG_EvalTypeGroup_F32 && imm != RADDBG_EvalTypeGroup_F64);
+        B32 is_us = (imm == RADDBG_EvalTypeGroup_U || imm == RADDBG_EvalTypeGroup_S);
+        B32 is_u = (imm == RADDBG_EvalTypeGroup_U);
+        B32 is_s = (imm == RADDBG_EvalTypeGroup_S);
+        EVAL_ProgramOp pop = EVAL_ProgramOp_Generic;
+        U64 pimm = imm;
+        U64 pimm2 = inst->imm2;
+        U8 psize = 0;
+        switch (op){
+          default:{}break;
+          case RADDBG_EvalOp_Stop:{pop = EVAL_ProgramOp_Stop;}break;
+          case RADDBG_EvalOp_Noop:
+          case RADDBG_EvalOp_Pop:
+          case RADDBG_EvalOp_ObjectOff:
+          case RADDBG_EvalOp_CFA:{emit = 0;}break;
+          case RADDBG_EvalOp_Cond:{pop = EVAL_ProgramOp_CondJump; pimm = jump_idx[idx];}break;
+          case RADDBG_EvalOp_Skip:{pop = EVAL_ProgramOp_Jump; pimm = jump_idx[idx];}break;
+          case RADDBG_EvalOp_MemRead:{pop = EVAL_ProgramOp_MemRead; psize = (U8)imm;}break;
+          case RADDBG_EvalOp_RegRead:
+          {
+            U8 raddbg_reg_code = (imm&0x0000FF)>>0;
+            U8 byte_size       = (imm&0x00FF00)>>8;
+            U8 byte_off        = (imm&0xFF0000)>>16;
+            REGS_RegCode base_reg_code = regs_reg_code_from_arch_raddbg_code(arch, raddbg_reg_code);
+            REGS_Rng rng = regs_reg_code_rng_table_from_architecture(arch)[base_reg_code];
+            pop = (fused ? EVAL_ProgramOp_RegReadAddImm : EVAL_ProgramOp_RegRead);
+            pimm = (U64)rng.byte_off + byte_off;
+            psize = byte_size;
+          }break;
+          case RADDBG_EvalOp_RegReadDyn:{pop = EVAL_ProgramOp_RegReadDyn;}break;
+          case RADDBG_EvalOp_FrameOff:{pop = EVAL_ProgramOp_FrameOff;}break;
+          case RADDBG_EvalOp_ModuleOff:{pop = EVAL_ProgramOp_ModuleOff;}break;
+          case RADDBG_EvalOp_TLSOff:{pop = EVAL_ProgramOp_TLSOff;}break;
+          case RADDBG_EvalOp_ConstU8:
+          case RADDBG_EvalOp_ConstU16:
+          case RADDBG_EvalOp_ConstU32:
+          case RADDBG_EvalOp_ConstU64:{pop = EVAL_ProgramOp_Const;}break;
+          case RADDBG_EvalOp_Pick:{pop = EVAL_ProgramOp_Pick; inst->src = (U16)(depth - imm - 1);}break;
+          case RADDBG_EvalOp_Insert:
+          {
+            if (imm == 0){
+              emit = 0;
+            }
+            pop = EVAL_ProgramOp_Insert;
+            dst = (U16)(depth - 1 - imm);
+            inst->src = (U16)(depth - 1);
+          }break;
+          case RADDBG_EvalOp_Add:   {if (is_int){pop = EVAL_ProgramOp_Add;}}break;
+          case RADDBG_EvalOp_Sub:   {if (is_int){pop = EVAL_ProgramOp_Sub;}}break;
+          case RADDBG_EvalOp_Mul:   {if (is_int){pop = EVAL_ProgramOp_Mul;}}break;
+          case RADDBG_EvalOp_Neg:   {if (is_int){pop = EVAL_ProgramOp_Neg;}}break;
+          case RADDBG_EvalOp_BitAnd:{if (is_us){pop = EVAL_ProgramOp_BitAnd;}}break;
+          case RADDBG_EvalOp_BitOr: {if (is_us){pop = EVAL_ProgramOp_BitOr;}}break;
+          case RADDBG_EvalOp_BitXor:{if (is_us){pop = EVAL_ProgramOp_BitXor;}}break;
+          case RADDBG_EvalOp_BitNot:{if (is_us){pop = EVAL_ProgramOp_BitNot;}}break;
+          case RADDBG_EvalOp_LShift:{if (is_us){pop = EVAL_ProgramOp_LShift;}}break;
+          case RADDBG_EvalOp_RShift:{if (is_u){pop = EVAL_ProgramOp_RShiftU;}else if (is_s){pop = EVAL_ProgramOp_RShiftS;}}break;
+          case RADDBG_EvalOp_LogAnd:{if (is_us){pop = EVAL_ProgramOp_LogAnd;}}break;
+          case RADDBG_EvalOp_LogOr: {if (is_us){pop = EVAL_ProgramOp_LogOr;}}break;
+          case RADDBG_EvalOp_LogNot:{if (is_us){pop = EVAL_ProgramOp_LogNot;}}break;
+          case RADDBG_EvalOp_EqEq:  {pop = EVAL_ProgramOp_EqEq;}break;
+          case RADDBG_EvalOp_NtEq:  {pop = EVAL_ProgramOp_NtEq;}break;
+          case RADDBG_EvalOp_LsEq:  {if (is_u){pop = EVAL_ProgramOp_LsEqU;}else if (is_s){pop = EVAL_ProgramOp_LsEqS;}}break;
+          case RADDBG_EvalOp_GrEq:  {if (is_u){pop = EVAL_ProgramOp_GrEqU;}else if (is_s){pop = EVAL_ProgramOp_GrEqS;}}break;
+          case RADDBG_EvalOp_Less:  {if (is_u){pop = EVAL_ProgramOp_LessU;}else if (is_s){pop = EVAL_ProgramOp_LessS;}}break;
+          case RADDBG_EvalOp_Grtr:  {if (is_u){pop = EVAL_ProgramOp_GrtrU;}else if (is_s){pop = EVAL_ProgramOp_GrtrS;}}break;
+          case RADDBG_EvalOp_Trunc:
+          case RADDBG_EvalOp_TruncSigned:
+          {
+            // precompute masks; a zero-bit truncation always produces zero
+            U64 mask = 0;
+            if (0 < imm && imm < 64){
+              mask = max_U64 >> (64 - imm);
+            }
+            if (imm == 0){
+              pop = EVAL_ProgramOp_Const;
+              pimm = 0;
+            }
+            else if (op == RADDBG_EvalOp_Trunc){
+              pop = EVAL_ProgramOp_Trunc;
+              pimm = mask;
+            }
+            else{
+              pop = EVAL_ProgramOp_TruncSigned;
+              pimm = mask;
+              pimm2 = (imm <= 64) ? ((U64)1 << (imm - 1)) : 0;
+            }
+          }break;
+        }
+        inst->op = (U8)pop;
+        inst->raddbg_op = op;
+        inst->dst = dst;
+        inst->imm = pimm;
+        inst->imm2 = pimm2;
+        inst->size = psize;
+      }
       
-      case RADDBG_EvalOp_LogOr:
+      // advance
+      for (U64 consumed_idx = 1; consumed_idx < consume_count; consumed_idx += 1){
+        inst_idx_from_op[idx + consumed_idx] = (U32)inst_count;
+      }
+      if (emit){
+        inst_count += 1;
+      }
+      else{
+        MemoryZeroStruct(inst);
+      }
+      idx += consume_count;
+    }
+    
+    // end of bytecode
+    inst_idx_from_op[end_idx] = (U32)inst_count;
+    insts[inst_count].op = (depth_in[end_idx] == 1 ? EVAL_ProgramOp_Stop : EVAL_ProgramOp_Fail);
+    inst_count += 1;
+    
+    // jumps: op indices -> instruction indices
+    for (U64 idx = 0; idx < inst_count; idx += 1){
+      if (insts[idx].op == EVAL_ProgramOp_Jump || insts[idx].op == EVAL_ProgramOp_CondJump){
+        insts[idx].jump = inst_idx_from_op[insts[idx].imm];
+        insts[idx].imm = 0;
+      }
+    }
+    
+    program.insts = insts;
+    program.inst_count = inst_count;
+    program.max_stack_depth = max_depth;
+  }
+  
+  done:;
+  scratch_end(scratch);
+  return(program);
+}
+
+internal EVAL_Result
+eval_interpret_program(EVAL_Machine *machine, EVAL_Program *program){
+  EVAL_Result result = {0};
+  
+  // not pre-decoded (or pre-decoded for another architecture) -> interpret
+  if (program->insts == 0 || program->arch != machine->arch){
+    result = eval_interpret(machine, program->bytecode);
+    return(result);
+  }
+  
+  // run
+  // NOTE: like the bytecode interpreter's, integer op results clear the
+  // upper bits of their slot
+#define EVAL_ProgramResultU64(v) do{ U64 v_ = (v); s[0].u256[0] = v_; s[0].u256[1] = 0; s[0].u256[2] = 0; s[0].u256[3] = 0; }while(0)
+  EVAL_Slot stack[EVAL_PROGRAM_STACK_CAP];
+  EVAL_ProgramInst *insts = program->insts;
+  EVAL_ProgramInst *inst = insts;
+  for (;;){
+    EVAL_Slot *s = stack + inst->dst;
+    switch ((EVAL_ProgramOp)inst->op){
+      case EVAL_ProgramOp_Stop:
       {
-        if (imm == RADDBG_EvalTypeGroup_U ||
-            imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = (svals[0].u64 || svals[1].u64);
-        }
-        else{
-          result.bad_eval = 1;
-          goto done;
-        }
+        result.value = stack[0];
+        goto done;
       }break;
       
-      case RADDBG_EvalOp_LogNot:
+      default:
+      case EVAL_ProgramOp_Fail:
       {
-        if (imm == RADDBG_EvalTypeGroup_U ||
-            imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = (!svals[0].u64);
-        }
-        else{
-          result.bad_eval = 1;
-          goto done;
-        }
+        result.bad_eval = 1;
+        goto done;
       }break;
       
-      case RADDBG_EvalOp_EqEq:
+      case EVAL_ProgramOp_Jump:
       {
-        nval.u64 = (svals[0].u64 == svals[1].u64);
+        inst = insts + inst->jump;
+        continue;
       }break;
       
-      case RADDBG_EvalOp_NtEq:
+      case EVAL_ProgramOp_CondJump:
       {
-        nval.u64 = (svals[0].u64 != svals[1].u64);
+        if (s[0].u64){
+          inst = insts + inst->jump;
+          continue;
+        }
       }break;
       
-      case RADDBG_EvalOp_LsEq:
+      case EVAL_ProgramOp_MemRead:
       {
-        if (imm == RADDBG_EvalTypeGroup_F32){
-          nval.u64 = (svals[0].f32 <= svals[1].f32);
-        }
-        else if (imm == RADDBG_EvalTypeGroup_F64){
-          nval.u64 = (svals[0].f64 <= svals[1].f64);
-        }
-        else if (imm == RADDBG_EvalTypeGroup_U){
-          nval.u64 = (svals[0].u64 <= svals[1].u64);
-        }
-        else if (imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = (svals[0].s64 <= svals[1].s64);
-        }
-        else{
+        EVAL_Slot nval = {0};
+        if (machine->memory_read == 0 ||
+            !machine->memory_read(machine->u, &nval, s[0].u64, inst->size)){
           result.bad_eval = 1;
           goto done;
         }
+        s[0] = nval;
       }break;
       
-      case RADDBG_EvalOp_GrEq:
+      case EVAL_ProgramOp_RegRead:
+      case EVAL_ProgramOp_RegReadAddImm:
       {
-        if (imm == RADDBG_EvalTypeGroup_F32){
-          nval.u64 = (svals[0].f32 >= svals[1].f32);
-        }
-        else if (imm == RADDBG_EvalTypeGroup_F64){
-          nval.u64 = (svals[0].f64 >= svals[1].f64);
-        }
-        else if (imm == RADDBG_EvalTypeGroup_U){
-          nval.u64 = (svals[0].u64 >= svals[1].u64);
-        }
-        else if (imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = (svals[0].s64 >= svals[1].s64);
+        EVAL_Slot nval = {0};
+        if (inst->imm + inst->size <= machine->reg_size){
+          MemoryCopy(&nval, (U8*)machine->reg_data + inst->imm, inst->size);
         }
         else{
           result.bad_eval = 1;
           goto done;
         }
+        // NOTE: the unfused Add produces a plain u64 - reads wider than 8
+        // bytes must not keep their upper bytes
+        EVAL_ProgramResultU64(nval.u64 + inst->imm2);
       }break;
       
-      case RADDBG_EvalOp_Less:
+      case EVAL_ProgramOp_RegReadDyn:
       {
-        if (imm == RADDBG_EvalTypeGroup_F32){
-          nval.u64 = (svals[0].f32 < svals[1].f32);
-        }
-        else if (imm == RADDBG_EvalTypeGroup_F64){
-          nval.u64 = (svals[0].f64 < svals[1].f64);
-        }
-        else if (imm == RADDBG_EvalTypeGroup_U){
-          nval.u64 = (svals[0].u64 < svals[1].u64);
-        }
-        else if (imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = (svals[0].s64 < svals[1].s64);
+        EVAL_Slot nval = {0};
+        U64 off  = s[0].u64;
+        U64 size = bit_size_from_arch(machine->arch)/8;
+        if (off + size <= machine->reg_size){
+          MemoryCopy(&nval, (U8*)machine->reg_data + off, size);
         }
         else{
           result.bad_eval = 1;
           goto done;
         }
+        s[0] = nval;
       }break;
       
-      case RADDBG_EvalOp_Grtr:
+      case EVAL_ProgramOp_FrameOff:
+      case EVAL_ProgramOp_ModuleOff:
+      case EVAL_ProgramOp_TLSOff:
       {
-        if (imm == RADDBG_EvalTypeGroup_F32){
-          nval.u64 = (svals[0].f32 > svals[1].f32);
-        }
-        else if (imm == RADDBG_EvalTypeGroup_F64){
-          nval.u64 = (svals[0].f64 > svals[1].f64);
-        }
-        else if (imm == RADDBG_EvalTypeGroup_U){
-          nval.u64 = (svals[0].u64 > svals[1].u64);
-        }
-        else if (imm == RADDBG_EvalTypeGroup_S){
-          nval.u64 = (svals[0].s64 > svals[1].s64);
-        }
-        else{
+        U64 *base = (inst->op == EVAL_ProgramOp_FrameOff  ? machine->frame_base :
+                     inst->op == EVAL_ProgramOp_ModuleOff ? machine->module_base :
+                     machine->tls_base);
+        if (base == 0){
           result.bad_eval = 1;
           goto done;
         }
+        MemoryZeroStruct(&s[0]);
+        s[0].u64 = *base + inst->imm;
       }break;
       
-      case RADDBG_EvalOp_Trunc:
+      case EVAL_ProgramOp_Const:
       {
-        if (0 < imm){
-          U64 mask = 0;
-          if (imm < 64){
-            mask = max_U64 >> (64 - imm);
-          }
-          nval.u64 = svals[0].u64&mask;
-        }
+        MemoryZeroStruct(&s[0]);
+        s[0].u64 = inst->imm;
       }break;
       
-      case RADDBG_EvalOp_TruncSigned:
+      case EVAL_ProgramOp_Pick:
       {
-        if (0 < imm){
-          U64 mask = 0;
-          if (imm < 64){
-            mask = max_U64 >> (64 - imm);
-          }
-          U64 high = 0;
-          if (svals[0].u64 & (1 << (imm - 1))){
-            high = ~mask;
-          }
-          nval.u64 = high|(svals[0].u64&mask);
-        }
+        s[0] = stack[inst->src];
       }break;
       
-      case RADDBG_EvalOp_Convert:
+      case EVAL_ProgramOp_Insert:
       {
-        U32 in = imm&0xFF;
-        U32 out = (imm >> 8)&0xFF;
-        if (in != out){
-          switch (in + out*RADDBG_EvalTypeGroup_COUNT){
-            case RADDBG_EvalTypeGroup_F32 + RADDBG_EvalTypeGroup_U*RADDBG_EvalTypeGroup_COUNT:
-            {
-              nval.u64 = (U64)svals[0].f32;
-            }break;
-            case RADDBG_EvalTypeGroup_F64 + RADDBG_EvalTypeGroup_U*RADDBG_EvalTypeGroup_COUNT:
-            {
-              nval.u64 = (U64)svals[0].f64;
-            }break;
-            
-            case RADDBG_EvalTypeGroup_F32 + RADDBG_EvalTypeGroup_S*RADDBG_EvalTypeGroup_COUNT:
-            {
-              nval.s64 = (S64)svals[0].f32;
-            }break;
-            case RADDBG_EvalTypeGroup_F64 + RADDBG_EvalTypeGroup_S*RADDBG_EvalTypeGroup_COUNT:
-            {
-              nval.s64 = (S64)svals[0].f64;
-            }break;
-            
-            case RADDBG_EvalTypeGroup_U + RADDBG_EvalTypeGroup_F32*RADDBG_EvalTypeGroup_COUNT:
-            {
-              nval.f32 = (F32)svals[0].u64;
-            }break;
-            case RADDBG_EvalTypeGroup_S + RADDBG_EvalTypeGroup_F32*RADDBG_EvalTypeGroup_COUNT:
-            {
-              nval.f32 = (F32)svals[0].s64;
-            }break;
-            case RADDBG_EvalTypeGroup_F64 + RADDBG_EvalTypeGroup_F32*RADDBG_EvalTypeGroup_COUNT:
-            {
-              nval.f32 = (F32)svals[0].f64;
-            }break;
-            
-            case RADDBG_EvalTypeGroup_U + RADDBG_EvalTypeGroup_F64*RADDBG_EvalTypeGroup_COUNT:
-            {
-              nval.f64 = (F64)svals[0].u64;
-            }break;
-            case RADDBG_EvalTypeGroup_S + RADDBG_EvalTypeGroup_F64*RADDBG_EvalTypeGroup_COUNT:
-            {
-              nval.f64 = (F64)svals[0].s64;
-            }break;
-            case RADDBG_EvalTypeGroup_F32 + RADDBG_EvalTypeGroup_F64*RADDBG_EvalTypeGroup_COUNT:
-            {
-              nval.f64 = (F64)svals[0].f32;
-            }break;
-          }
-        }
+        EVAL_Slot tval = stack[inst->src];
+        MemoryCopy(s + 1, s, (inst->src - inst->dst)*sizeof(EVAL_Slot));
+        s[0] = tval;
       }break;
       
-      case RADDBG_EvalOp_Pick:
+      case EVAL_ProgramOp_Generic:
       {
-        if (stack_count > imm){
-          nval = stack[stack_count - imm - 1];
-        }
-        else{
+        EVAL_Slot nval = {0};
+        if (!eval_value_op(inst->raddbg_op, inst->imm, s, &nval)){
           result.bad_eval = 1;
           goto done;
         }
+        s[0] = nval;
       }break;
       
-      case RADDBG_EvalOp_Pop:
+      case EVAL_ProgramOp_Add:     {EVAL_ProgramResultU64(s[0].u64 + s[1].u64);}break;
+      case EVAL_ProgramOp_Sub:     {EVAL_ProgramResultU64(s[0].u64 - s[1].u64);}break;
+      case EVAL_ProgramOp_Mul:     {EVAL_ProgramResultU64(s[0].u64*s[1].u64);}break;
+      case EVAL_ProgramOp_Neg:     {EVAL_ProgramResultU64((~s[0].u64) + 1);}break;
+      case EVAL_ProgramOp_BitAnd:  {EVAL_ProgramResultU64(s[0].u64&s[1].u64);}break;
+      case EVAL_ProgramOp_BitOr:   {EVAL_ProgramResultU64(s[0].u64|s[1].u64);}break;
+      case EVAL_ProgramOp_BitXor:  {EVAL_ProgramResultU64(s[0].u64^s[1].u64);}break;
+      case EVAL_ProgramOp_BitNot:  {EVAL_ProgramResultU64(~s[0].u64);}break;
+      case EVAL_ProgramOp_LShift:  {EVAL_ProgramResultU64(s[0].u64 << s[1].u64);}break;
+      case EVAL_ProgramOp_RShiftU: {EVAL_ProgramResultU64(s[0].u64 >> s[1].u64);}break;
+      case EVAL_ProgramOp_RShiftS: {EVAL_ProgramResultU64(s[0].s64 >> s[1].u64);}break;
+      case EVAL_ProgramOp_LogAnd:  {EVAL_ProgramResultU64((s[0].u64 && s[1].u64));}break;
+      case EVAL_ProgramOp_LogOr:   {EVAL_ProgramResultU64((s[0].u64 || s[1].u64));}break;
+      case EVAL_ProgramOp_LogNot:  {EVAL_ProgramResultU64((!s[0].u64));}break;
+      case EVAL_ProgramOp_EqEq:    {EVAL_ProgramResultU64((s[0].u64 == s[1].u64));}break;
+      case EVAL_ProgramOp_NtEq:    {EVAL_ProgramResultU64((s[0].u64 != s[1].u64));}break;
+      case EVAL_ProgramOp_LsEqU:   {EVAL_ProgramResultU64((s[0].u64 <= s[1].u64));}break;
+      case EVAL_ProgramOp_LsEqS:   {EVAL_ProgramResultU64((s[0].s64 <= s[1].s64));}break;
+      case EVAL_ProgramOp_GrEqU:   {EVAL_ProgramResultU64((s[0].u64 >= s[1].u64));}break;
+      case EVAL_ProgramOp_GrEqS:   {EVAL_ProgramResultU64((s[0].s64 >= s[1].s64));}break;
+      case EVAL_ProgramOp_LessU:   {EVAL_ProgramResultU64((s[0].u64 <  s[1].u64));}break;
+      case EVAL_ProgramOp_LessS:   {EVAL_ProgramResultU64((s[0].s64 <  s[1].s64));}break;
+      case EVAL_ProgramOp_GrtrU:   {EVAL_ProgramResultU64((s[0].u64 >  s[1].u64));}break;
+      case EVAL_ProgramOp_GrtrS:   {EVAL_ProgramResultU64((s[0].s64 >  s[1].s64));}break;
+      case EVAL_ProgramOp_Trunc:   {EVAL_ProgramResultU64(s[0].u64&inst->imm);}break;
+      case EVAL_ProgramOp_TruncSigned:
       {
-        // do nothing - the pop is handled by the control bits
+        U64 high = (s[0].u64 & inst->imm2) ? ~inst->imm : 0;
+        EVAL_ProgramResultU64(high|(s[0].u64&inst->imm));
       }break;
       
-      case RADDBG_EvalOp_Insert:
+      case EVAL_ProgramOp_AddImm:
       {
-        if (stack_count > imm){
-          if (imm > 0){
-            EVAL_Slot tval = stack[stack_count - 1];
-            EVAL_Slot *dst = stack + stack_count - 1 - imm;
-            EVAL_Slot *shift = dst + 1;
-            MemoryCopy(shift, dst, imm*sizeof(EVAL_Slot));
-            *dst = tval;
-          }
-        }
-        else{
-          result.bad_eval = 1;
-          goto done;
-        }
+        EVAL_ProgramResultU64(s[0].u64 + inst->imm);
       }break;
-    }
-    
-    // push
-    {
-      U64 push_count = RADDBG_PUSHN_FROM_CTRLBITS(ctrlbits);
-      if (push_count == 1){
-        if (stack_count < stack_cap){
-          stack[stack_count] = nval;
-          stack_count += 1;
-        }
-        else{
+      
+      case EVAL_ProgramOp_AddImmMemRead:
+      {
+        EVAL_Slot nval = {0};
+        if (machine->memory_read == 0 ||
+            !machine->memory_read(machine->u, &nval, s[0].u64 + inst->imm, inst->size)){
           result.bad_eval = 1;
           goto done;
         }
-      }
+        s[0] = nval;
+      }break;
     }
-    
+    inst += 1;
   }
   done:;
+#undef EVAL_ProgramResultU64
   
-  if (stack_count == 1){
-    result.value = stack[0];
-  }
-  else{
-    result.bad_eval = 1;
-  }
-  
-  scratch_end(scratch);
   return(result);
-}
\ No newline at end of file
+}
@@ -37,9 +37,104 @@ struct EVAL_Result{
   B32 bad_eval;
 };
 
+////////////////////////////////
+//~ Eval Program Types
+//
+// An EVAL_Program is bytecode which has been validated & pre-decoded once,
+// so that it can be run many times (e.g. a breakpoint condition on every
+// hit) without per-op decoding, bounds checks, or stack count tracking.
+// Because bytecode jumps only go forward, the stack depth at every op is
+// known statically - each instruction addresses fixed stack slots, pops &
+// noops disappear, integer ops are specialized by type group, and a few
+// common op sequences are fused. Bytecode which can't be pre-decoded (e.g.
+// jumps into the middle of an op, or paths which disagree on stack depth)
+// keeps running through eval_interpret.
+
+#define EVAL_PROGRAM_STACK_CAP 128
+
+typedef enum EVAL_ProgramOp{
+  EVAL_ProgramOp_Stop,
+  EVAL_ProgramOp_Fail,
+  EVAL_ProgramOp_Jump,
+  EVAL_ProgramOp_CondJump,
+  EVAL_ProgramOp_MemRead,
+  EVAL_ProgramOp_RegRead,
+  EVAL_ProgramOp_RegReadDyn,
+  EVAL_ProgramOp_FrameOff,
+  EVAL_ProgramOp_ModuleOff,
+  EVAL_ProgramOp_TLSOff,
+  EVAL_ProgramOp_Const,
+  EVAL_ProgramOp_Pick,
+  EVAL_ProgramOp_Insert,
+  EVAL_ProgramOp_Generic,
+  
+  // integer-specialized ops
+  EVAL_ProgramOp_Add,
+  EVAL_ProgramOp_Sub,
+  EVAL_ProgramOp_Mul,
+  EVAL_ProgramOp_Neg,
+  EVAL_ProgramOp_BitAnd,
+  EVAL_ProgramOp_BitOr,
+  EVAL_ProgramOp_BitXor,
+  EVAL_ProgramOp_BitNot,
+  EVAL_ProgramOp_LShift,
+  EVAL_ProgramOp_RShiftU,
+  EVAL_ProgramOp_RShiftS,
+  EVAL_ProgramOp_LogAnd,
+  EVAL_ProgramOp_LogOr,
+  EVAL_ProgramOp_LogNot,
+  EVAL_ProgramOp_EqEq,
+  EVAL_ProgramOp_NtEq,
+  EVAL_ProgramOp_LsEqU,
+  EVAL_ProgramOp_LsEqS,
+  EVAL_ProgramOp_GrEqU,
+  EVAL_ProgramOp_GrEqS,
+  EVAL_ProgramOp_LessU,
+  EVAL_ProgramOp_LessS,
+  EVAL_ProgramOp_GrtrU,
+  EVAL_ProgramOp_GrtrS,
+  EVAL_ProgramOp_Trunc,
+  EVAL_ProgramOp_TruncSigned,
+  
+  // fused ops
+  EVAL_ProgramOp_AddImm,          // Const, Add
+  EVAL_ProgramOp_AddImmMemRead,   // Const, Add, MemRead
+  EVAL_ProgramOp_RegReadAddImm,   // RegRead, Const, Add
+  
+  EVAL_ProgramOp_COUNT
+} EVAL_ProgramOp;
+
+typedef struct EVAL_ProgramInst EVAL_ProgramInst;
+struct EVAL_ProgramInst{
+  U8  op;         // EVAL_ProgramOp
+  U8  raddbg_op;  // original opcode, for EVAL_ProgramOp_Generic
+  U8  size;       // read size
+  U16 dst;        // stack slot of the first operand & of the result
+  U16 src;        // Pick/Insert: stack slot to copy from
+  U32 jump;       // instruction index for jumps
+  U64 imm;
+  U64 imm2;
+};
+
+typedef struct EVAL_Program EVAL_Program;
+struct EVAL_Program{
+  Architecture arch;
+  String8 bytecode;
+  EVAL_ProgramInst *insts;
+  U64 inst_count;
+  U64 max_stack_depth;
+};
+
 ////////////////////////////////
 //~ allen: Eval Machine Functions
 
+internal B32 eval_value_op(RADDBG_EvalOp op, U64 imm, EVAL_Slot *svals, EVAL_Slot *nval_out);
 internal EVAL_Result eval_interpret(EVAL_Machine *machine, String8 bytecode);
 
+////////////////////////////////
+//~ Eval Program Functions
+
+internal EVAL_Program eval_program_from_bytecode(Arena *arena, Architecture arch, String8 bytecode);
+internal EVAL_Result eval_interpret_program(EVAL_Machine *machine, EVAL_Program *program);
+
 #endif //EVAL2_MACHINE_H
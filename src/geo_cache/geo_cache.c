@@ -154,6 +154,7 @@ geo_buffer_from_key_hash(GEO_Scope *scope, U128 key, U128 hash)
     GEO_Slot *slot = &geo_shared->slots[slot_idx];
     GEO_Stripe *stripe = &geo_shared->stripes[stripe_idx];
     B32 found = 0;
+    B32 node_needs_retry = 0;
     OS_MutexScopeR(stripe->rw_mutex)
     {
       for(GEO_Node *n = slot->first; n != 0; n = n->next)
@@ -162,6 +163,7 @@ geo_buffer_from_key_hash(GEO_Scope *scope, U128 key, U128 hash)
         {
           handle = n->buffer;
           found = !r_handle_match(r_handle_zero(), handle);
+          node_needs_retry = ins_atomic_u32_eval_cond_assign(&n->data_evicted, 0, 1);
           geo_scope_touch_node__stripe_r_guarded(scope, n);
           break;
         }
@@ -199,7 +201,7 @@ geo_buffer_from_key_hash(GEO_Scope *scope, U128 key, U128 hash)
         }
       }
     }
-    if(node_is_new)
+    if(node_is_new || node_needs_retry)
     {
       geo_u2x_enqueue_req(key, hash, max_U64);
     }
@@ -326,14 +328,15 @@ geo_xfer_thread__entry_point(void *p)
     
     //- rjf: hash -> data
     String8 data = {0};
+    B32 data_evicted = 0;
     if(got_task)
     {
-      data = hs_data_from_hash(scope, hash);
+      data = hs_data_from_hash_evicted(scope, hash, &data_evicted);
     }
     
     //- rjf: data -> buffer
     R_Handle buffer = {0};
-    if(got_task && data.size != 0)
+    if(got_task && !data_evicted && data.size != 0)
     {
       buffer = r_buffer_alloc(R_BufferKind_Static, data.size, data.str);
     }
@@ -345,16 +348,25 @@ geo_xfer_thread__entry_point(void *p)
       {
         if(u128_match(n->hash, hash))
         {
-          n->buffer = buffer;
+          // NOTE: evicted data is not this hash's content - leave the node
+          // unloaded, & retry on its next lookup, once it's been resubmitted
+          if(data_evicted)
+          {
+            ins_atomic_u32_eval_assign(&n->data_evicted, 1);
+          }
+          else
+          {
+            n->buffer = buffer;
+            ins_atomic_u64_inc_eval(&n->load_count);
+          }
           ins_atomic_u32_eval_assign(&n->is_working, 0);
-          ins_atomic_u64_inc_eval(&n->load_count);
           break;
         }
       }
     }
     
     //- rjf: commit this key/hash pair to fallback cache
-    if(got_task && !u128_match(key, u128_zero()) && !u128_match(hash, u128_zero()))
+    if(got_task && !data_evicted && !u128_match(key, u128_zero()) && !u128_match(hash, u128_zero()))
     {
       U64 fallback_slot_idx = key.u64[1]%geo_shared->fallback_slots_count;
       U64 fallback_stripe_idx = fallback_slot_idx%geo_shared->fallback_stripes_count;
@@ -410,7 +422,7 @@ geo_evictor_thread__entry_point(void *p)
           if(n->scope_ref_count == 0 &&
              n->last_time_touched_us+evict_threshold_us <= check_time_us &&
              n->last_user_clock_idx_touched+evict_threshold_user_clocks <= check_time_user_clocks &&
-             n->load_count != 0 &&
+             (n->load_count != 0 || n->data_evicted) &&
              n->is_working == 0)
           {
             slot_has_work = 1;
@@ -426,7 +438,7 @@ geo_evictor_thread__entry_point(void *p)
           if(n->scope_ref_count == 0 &&
              n->last_time_touched_us+evict_threshold_us <= check_time_us &&
              n->last_user_clock_idx_touched+evict_threshold_user_clocks <= check_time_user_clocks &&
-             n->load_count != 0 &&
+             (n->load_count != 0 || n->data_evicted) &&
              n->is_working == 0)
           {
             DLLRemove(slot->first, slot->last, n);
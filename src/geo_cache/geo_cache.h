@@ -30,6 +30,7 @@ struct GEO_Node
   U128 hash;
   R_Handle buffer;
   B32 is_working;
+  B32 data_evicted;
   U64 scope_ref_count;
   U64 last_time_touched_us;
   U64 last_user_clock_idx_touched;
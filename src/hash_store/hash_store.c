@@ -12,12 +12,88 @@
 
 internal U128
 hs_hash_from_data(String8 data)
+{
+  HS_HashKind kind = (hs_shared != 0 ? hs_shared->hash_kind : HS_DEFAULT_HASH_KIND);
+  U128 u128 = hs_hash_from_data_kind(kind, data);
+  return u128;
+}
+
+internal U128
+hs_hash_from_data_kind(HS_HashKind kind, String8 data)
+{
+  U128 u128 = {0};
+  switch(kind)
+  {
+    default:
+    case HS_HashKind_Blake2b:{u128 = hs_hash_from_data__blake2b(data);}break;
+    case HS_HashKind_AES:    {u128 = hs_hash_from_data__aes(data);}break;
+  }
+  return u128;
+}
+
+internal U128
+hs_hash_from_data__blake2b(String8 data)
 {
   U128 u128 = {0};
   blake2b((U8 *)&u128.u64[0], sizeof(u128), data.str, data.size, 0, 0);
   return u128;
 }
 
+internal U128
+hs_hash_from_data__aes(String8 data)
+{
+  // NOTE: four independent lanes each absorb one 16-byte chunk of every
+  // 64-byte block with a single AES decryption round, so the rounds of
+  // different lanes overlap in the pipeline. the length is folded into the
+  // initial state, which makes zero-padding the tail block unambiguous.
+  // finalization gives each lane another round, then folds the lanes
+  // together & runs a few more rounds for avalanche.
+  __m128i k0 = _mm_set_epi64x(0x243f6a8885a308d3ull, 0x13198a2e03707344ull);
+  __m128i k1 = _mm_set_epi64x(0xa4093822299f31d0ull, 0x082efa98ec4e6c89ull);
+  __m128i k2 = _mm_set_epi64x(0x452821e638d01377ull, 0xbe5466cf34e90c6cull);
+  __m128i k3 = _mm_set_epi64x(0xc0ac29b7c97c50ddull, 0x3f84d5b5b5470917ull);
+  __m128i len = _mm_set_epi64x((S64)data.size, (S64)~data.size);
+  __m128i s0 = _mm_xor_si128(k0, len);
+  __m128i s1 = _mm_xor_si128(k1, len);
+  __m128i s2 = _mm_xor_si128(k2, len);
+  __m128i s3 = _mm_xor_si128(k3, len);
+  
+  //- absorb whole blocks
+  U8 *ptr = data.str;
+  U64 remaining = data.size;
+  for(;remaining >= 64; ptr += 64, remaining -= 64)
+  {
+    s0 = _mm_aesdec_si128(s0, _mm_loadu_si128((__m128i *)(ptr +  0)));
+    s1 = _mm_aesdec_si128(s1, _mm_loadu_si128((__m128i *)(ptr + 16)));
+    s2 = _mm_aesdec_si128(s2, _mm_loadu_si128((__m128i *)(ptr + 32)));
+    s3 = _mm_aesdec_si128(s3, _mm_loadu_si128((__m128i *)(ptr + 48)));
+  }
+  
+  //- absorb zero-padded tail
+  if(remaining != 0)
+  {
+    U8 tail[64] = {0};
+    MemoryCopy(tail, ptr, remaining);
+    s0 = _mm_aesdec_si128(s0, _mm_loadu_si128((__m128i *)(tail +  0)));
+    s1 = _mm_aesdec_si128(s1, _mm_loadu_si128((__m128i *)(tail + 16)));
+    s2 = _mm_aesdec_si128(s2, _mm_loadu_si128((__m128i *)(tail + 32)));
+    s3 = _mm_aesdec_si128(s3, _mm_loadu_si128((__m128i *)(tail + 48)));
+  }
+  
+  //- finalize
+  s0 = _mm_aesenc_si128(s0, k1);
+  s1 = _mm_aesenc_si128(s1, k2);
+  s2 = _mm_aesenc_si128(s2, k3);
+  s3 = _mm_aesenc_si128(s3, k0);
+  __m128i h = _mm_aesdec_si128(_mm_aesdec_si128(s0, s1), _mm_aesdec_si128(s2, s3));
+  h = _mm_aesenc_si128(h, k0);
+  h = _mm_aesenc_si128(h, k1);
+  h = _mm_aesenc_si128(h, k2);
+  U128 u128 = {0};
+  _mm_storeu_si128((__m128i *)&u128.u64[0], h);
+  return u128;
+}
+
 ////////////////////////////////
 //~ rjf: Main Layer Initialization
 
@@ -50,9 +126,28 @@ hs_init(void)
     stripe->rw_mutex = os_rw_mutex_alloc();
     stripe->cv = os_condition_variable_alloc();
   }
+  hs_shared->tctx_list_mutex = os_mutex_alloc();
+  hs_shared->budget_bytes = HS_DEFAULT_BUDGET_BYTES;
+  hs_shared->hash_kind = HS_DEFAULT_HASH_KIND;
+  hs_shared->access_epoch = 1;
   hs_shared->evictor_thread = os_launch_thread(hs_evictor_thread__entry_point, 0, 0);
 }
 
+internal void
+hs_set_budget(U64 budget_bytes)
+{
+  ins_atomic_u64_eval_assign(&hs_shared->budget_bytes, budget_bytes);
+}
+
+internal void
+hs_set_hash_kind(HS_HashKind kind)
+{
+  if(0 <= kind && kind < HS_HashKind_COUNT)
+  {
+    ins_atomic_u32_eval_assign(&hs_shared->hash_kind, (U32)kind);
+  }
+}
+
 ////////////////////////////////
 //~ rjf: Thread Context Initialization
 
@@ -64,6 +159,10 @@ hs_tctx_ensure_inited(void)
     Arena *arena = arena_alloc();
     hs_tctx = push_array(arena, HS_TCTX, 1);
     hs_tctx->arena = arena;
+    OS_MutexScope(hs_shared->tctx_list_mutex)
+    {
+      SLLQueuePush(hs_shared->first_tctx, hs_shared->last_tctx, hs_tctx);
+    }
   }
 }
 
@@ -73,10 +172,6 @@ hs_tctx_ensure_inited(void)
 internal U128
 hs_submit_data(U128 key, Arena **data_arena, String8 data)
 {
-  U64 key_slot_idx = key.u64[1]%hs_shared->key_slots_count;
-  U64 key_stripe_idx = key_slot_idx%hs_shared->key_stripes_count;
-  HS_KeySlot *key_slot = &hs_shared->key_slots[key_slot_idx];
-  HS_Stripe *key_stripe = &hs_shared->key_stripes[key_stripe_idx];
   U128 hash = hs_hash_from_data(data);
   U64 slot_idx = hash.u64[1]%hs_shared->slots_count;
   U64 stripe_idx = slot_idx%hs_shared->stripes_count;
@@ -95,6 +190,7 @@ hs_submit_data(U128 key, Arena **data_arena, String8 data)
         break;
       }
     }
+    U64 epoch = ins_atomic_u64_eval(&hs_shared->access_epoch);
     if(existing_node == 0)
     {
       HS_Node *node = hs_shared->stripes_free_nodes[stripe_idx];
@@ -106,25 +202,59 @@ hs_submit_data(U128 key, Arena **data_arena, String8 data)
       {
         node = push_array(stripe->arena, HS_Node, 1);
       }
+      // NOTE: scope_ref_count is left as-is on recycled nodes - lock-free
+      // readers may still hold a transient reference they are about to drop
+      ins_atomic_u64_inc_eval(&slot->seq);
       node->hash = hash;
       node->arena = *data_arena;
       node->data = data;
-      node->scope_ref_count = 0;
       node->key_ref_count = 1;
+      node->last_access_epoch = epoch;
       DLLPushBack(slot->first, slot->last, node);
+      ins_atomic_u64_inc_eval(&slot->seq);
+      ins_atomic_u64_add_eval(&hs_shared->resident_bytes, data.size);
+      ins_atomic_u64_inc_eval(&hs_shared->resident_node_count);
+    }
+    else if(existing_node->arena == 0)
+    {
+      // NOTE: node was kept alive by keys, but its data was evicted for the
+      // budget - take the resubmitted copy
+      ins_atomic_u64_inc_eval(&slot->seq);
+      existing_node->arena = *data_arena;
+      existing_node->data = data;
+      existing_node->last_access_epoch = epoch;
+      ins_atomic_u64_inc_eval(&existing_node->key_ref_count);
+      ins_atomic_u64_inc_eval(&slot->seq);
+      ins_atomic_u64_add_eval(&hs_shared->resident_bytes, data.size);
+      ins_atomic_u64_inc_eval(&hs_shared->resident_node_count);
     }
     else
     {
-      existing_node->key_ref_count += 1;
+      ins_atomic_u64_inc_eval(&existing_node->key_ref_count);
       arena_release(*data_arena);
     }
     *data_arena = 0;
   }
   
+  //- rjf: commit this hash to key cache
+  hs_key_commit_hash__ref_held(key, hash);
+  
+  return hash;
+}
+
+internal void
+hs_key_commit_hash__ref_held(U128 key, U128 hash)
+{
+  U64 key_slot_idx = key.u64[1]%hs_shared->key_slots_count;
+  U64 key_stripe_idx = key_slot_idx%hs_shared->key_stripes_count;
+  HS_KeySlot *key_slot = &hs_shared->key_slots[key_slot_idx];
+  HS_Stripe *key_stripe = &hs_shared->key_stripes[key_stripe_idx];
+  
   //- rjf: commit this hash to key cache
   U128 key_old_hash = {0};
   OS_MutexScopeW(key_stripe->rw_mutex)
   {
+    ins_atomic_u64_inc_eval(&key_slot->seq);
     HS_KeyNode *key_node = 0;
     for(HS_KeyNode *n = key_slot->first; n != 0; n = n->next)
     {
@@ -145,6 +275,7 @@ hs_submit_data(U128 key, Arena **data_arena, String8 data)
       key_old_hash = key_node->hash;
       key_node->hash = hash;
     }
+    ins_atomic_u64_inc_eval(&key_slot->seq);
   }
   
   //- rjf: if this key was correllated with an old hash, dec key ref count of old hash
@@ -166,8 +297,39 @@ hs_submit_data(U128 key, Arena **data_arena, String8 data)
       }
     }
   }
+}
+
+internal B32
+hs_bind_key(U128 key, U128 hash)
+{
+  //- take a key ref on the hash's node, if it's still in the table
+  B32 found = u128_match(hash, u128_zero());
+  if(!found)
+  {
+    U64 slot_idx = hash.u64[1]%hs_shared->slots_count;
+    U64 stripe_idx = slot_idx%hs_shared->stripes_count;
+    HS_Slot *slot = &hs_shared->slots[slot_idx];
+    HS_Stripe *stripe = &hs_shared->stripes[stripe_idx];
+    OS_MutexScopeR(stripe->rw_mutex)
+    {
+      for(HS_Node *n = slot->first; n != 0; n = n->next)
+      {
+        if(u128_match(n->hash, hash))
+        {
+          ins_atomic_u64_inc_eval(&n->key_ref_count);
+          found = 1;
+          break;
+        }
+      }
+    }
+  }
   
-  return hash;
+  //- commit key -> hash; binding to the zero hash unbinds the key
+  if(found)
+  {
+    hs_key_commit_hash__ref_held(key, hash);
+  }
+  return found;
 }
 
 ////////////////////////////////
@@ -195,33 +357,20 @@ hs_scope_close(HS_Scope *scope)
 {
   for(HS_Touch *touch = scope->top_touch, *next = 0; touch != 0; touch = next)
   {
-    U128 hash = touch->hash;
     next = touch->next;
-    U64 slot_idx = hash.u64[1]%hs_shared->slots_count;
-    U64 stripe_idx = slot_idx%hs_shared->stripes_count;
-    HS_Slot *slot = &hs_shared->slots[slot_idx];
-    HS_Stripe *stripe = &hs_shared->stripes[stripe_idx];
-    OS_MutexScopeR(stripe->rw_mutex)
-    {
-      for(HS_Node *n = slot->first; n != 0; n = n->next)
-      {
-        if(u128_match(hash, n->hash))
-        {
-          ins_atomic_u64_dec_eval(&n->scope_ref_count);
-          break;
-        }
-      }
-    }
+    
+    // NOTE: the touch's reference keeps the node from being evicted, so it can
+    // be released directly, without finding the node again under a lock
+    ins_atomic_u64_dec_eval(&touch->node->scope_ref_count);
     SLLStackPush(hs_tctx->free_touch, touch);
   }
   SLLStackPush(hs_tctx->free_scope, scope);
 }
 
 internal void
-hs_scope_touch_node__stripe_r_guarded(HS_Scope *scope, HS_Node *node)
+hs_scope_touch_node__ref_held(HS_Scope *scope, HS_Node *node)
 {
   HS_Touch *touch = hs_tctx->free_touch;
-  ins_atomic_u64_inc_eval(&node->scope_ref_count);
   if(touch != 0)
   {
     SLLStackPop(hs_tctx->free_touch);
@@ -232,14 +381,163 @@ hs_scope_touch_node__stripe_r_guarded(HS_Scope *scope, HS_Node *node)
   }
   MemoryZeroStruct(touch);
   touch->hash = node->hash;
+  touch->node = node;
   SLLStackPush(scope->top_touch, touch);
 }
 
+internal void
+hs_node_mark_accessed(HS_Node *node)
+{
+  // NOTE: only written when changed, so that hot nodes don't bounce their
+  // cache line between reading threads on every lookup
+  U64 epoch = hs_shared->access_epoch;
+  if(node->last_access_epoch != epoch)
+  {
+    node->last_access_epoch = epoch;
+  }
+}
+
+internal U64
+hs_node_age(HS_Node *node, U64 epoch)
+{
+  U64 last_access_epoch = node->last_access_epoch;
+  U64 age = (epoch > last_access_epoch) ? (epoch - last_access_epoch) : 0;
+  age = Min(age, HS_EVICTOR_AGE_BUCKET_COUNT-1);
+  return age;
+}
+
+internal void
+hs_node_release_data__stripe_w_guarded(HS_Node *node)
+{
+  if(node->arena != 0)
+  {
+    ins_atomic_u64_add_eval(&hs_shared->resident_bytes, -(S64)node->data.size);
+    ins_atomic_u64_dec_eval(&hs_shared->resident_node_count);
+    arena_release(node->arena);
+  }
+  node->arena = 0;
+  MemoryZeroStruct(&node->data);
+}
+
 ////////////////////////////////
 //~ rjf: Cache Lookup
 
 internal U128
 hs_hash_from_key(U128 key)
+{
+  U128 result = {0};
+  U64 key_slot_idx = key.u64[1]%hs_shared->key_slots_count;
+  HS_KeySlot *key_slot = &hs_shared->key_slots[key_slot_idx];
+  B32 done = 0;
+  for(U64 attempt_idx = 0; !done && attempt_idx < HS_LOCKFREE_READ_ATTEMPTS; attempt_idx += 1)
+  {
+    U64 seq = ins_atomic_u64_eval(&key_slot->seq);
+    if(seq & 1)
+    {
+      continue;
+    }
+    U128 hash = {0};
+    for(HS_KeyNode *n = key_slot->first; n != 0; n = n->next)
+    {
+      if(u128_match(n->key, key))
+      {
+        hash = n->hash;
+        break;
+      }
+    }
+    if(ins_atomic_u64_eval(&key_slot->seq) == seq)
+    {
+      result = hash;
+      done = 1;
+    }
+  }
+  if(!done)
+  {
+    result = hs_hash_from_key__locked(key);
+  }
+  return result;
+}
+
+internal String8
+hs_data_from_hash(HS_Scope *scope, U128 hash)
+{
+  B32 evicted = 0;
+  String8 result = hs_data_from_hash_evicted(scope, hash, &evicted);
+  return result;
+}
+
+internal String8
+hs_data_from_hash_evicted(HS_Scope *scope, U128 hash, B32 *out_evicted)
+{
+  String8 result = {0};
+  B32 evicted = 0;
+  U64 slot_idx = hash.u64[1]%hs_shared->slots_count;
+  HS_Slot *slot = &hs_shared->slots[slot_idx];
+  B32 done = 0;
+  for(U64 attempt_idx = 0; !done && attempt_idx < HS_LOCKFREE_READ_ATTEMPTS; attempt_idx += 1)
+  {
+    U64 seq = ins_atomic_u64_eval(&slot->seq);
+    if(seq & 1)
+    {
+      continue;
+    }
+    
+    //- find node & take a reference before validating
+    HS_Node *node = 0;
+    String8 data = {0};
+    B32 is_resident = 0;
+    for(HS_Node *n = slot->first; n != 0; n = n->next)
+    {
+      if(u128_match(n->hash, hash))
+      {
+        node = n;
+        break;
+      }
+    }
+    if(node != 0)
+    {
+      ins_atomic_u64_inc_eval(&node->scope_ref_count);
+      data = node->data;
+      is_resident = (node->arena != 0);
+    }
+    
+    //- validate - on failure, drop the reference & retry
+    if(ins_atomic_u64_eval(&slot->seq) == seq)
+    {
+      if(node != 0)
+      {
+        result = data;
+        evicted = !is_resident;
+        hs_scope_touch_node__ref_held(scope, node);
+        hs_node_mark_accessed(node);
+      }
+      if(is_resident)
+      {
+        hs_tctx->hit_count += 1;
+      }
+      else
+      {
+        hs_tctx->miss_count += 1;
+      }
+      done = 1;
+    }
+    else if(node != 0)
+    {
+      ins_atomic_u64_dec_eval(&node->scope_ref_count);
+    }
+  }
+  if(!done)
+  {
+    result = hs_data_from_hash__locked(scope, hash, &evicted);
+  }
+  *out_evicted = evicted;
+  return result;
+}
+
+//- locked lookups (lock-free fallback path)
+
+internal U128
+hs_hash_from_key__locked(U128 key)
 {
   U128 result = {0};
   U64 key_slot_idx = key.u64[1]%hs_shared->key_slots_count;
@@ -261,9 +559,11 @@ hs_hash_from_key(U128 key)
 }
 
 internal String8
-hs_data_from_hash(HS_Scope *scope, U128 hash)
+hs_data_from_hash__locked(HS_Scope *scope, U128 hash, B32 *out_evicted)
 {
   String8 result = {0};
+  B32 is_resident = 0;
+  B32 evicted = 0;
   U64 slot_idx = hash.u64[1]%hs_shared->slots_count;
   U64 stripe_idx = slot_idx%hs_shared->stripes_count;
   HS_Slot *slot = &hs_shared->slots[slot_idx];
@@ -275,14 +575,50 @@ hs_data_from_hash(HS_Scope *scope, U128 hash)
       if(u128_match(n->hash, hash))
       {
         result = n->data;
-        hs_scope_touch_node__stripe_r_guarded(scope, n);
+        is_resident = (n->arena != 0);
+        evicted = !is_resident;
+        ins_atomic_u64_inc_eval(&n->scope_ref_count);
+        hs_scope_touch_node__ref_held(scope, n);
+        hs_node_mark_accessed(n);
         break;
       }
     }
   }
+  if(is_resident)
+  {
+    hs_tctx->hit_count += 1;
+  }
+  else
+  {
+    hs_tctx->miss_count += 1;
+  }
+  *out_evicted = evicted;
   return result;
 }
 
+////////////////////////////////
+//~ Stats
+
+internal HS_Stats
+hs_stats(void)
+{
+  HS_Stats stats = {0};
+  OS_MutexScope(hs_shared->tctx_list_mutex)
+  {
+    for(HS_TCTX *tctx = hs_shared->first_tctx; tctx != 0; tctx = tctx->next)
+    {
+      stats.hit_count += tctx->hit_count;
+      stats.miss_count += tctx->miss_count;
+    }
+  }
+  stats.eviction_count      = ins_atomic_u64_eval(&hs_shared->eviction_count);
+  stats.evicted_bytes       = ins_atomic_u64_eval(&hs_shared->evicted_bytes);
+  stats.resident_node_count = ins_atomic_u64_eval(&hs_shared->resident_node_count);
+  stats.resident_bytes      = ins_atomic_u64_eval(&hs_shared->resident_bytes);
+  stats.budget_bytes        = ins_atomic_u64_eval(&hs_shared->budget_bytes);
+  return stats;
+}
+
 ////////////////////////////////
 //~ rjf: Evictor Thread
 
@@ -291,6 +627,11 @@ hs_evictor_thread__entry_point(void *p)
 {
   for(;;)
   {
+    U64 epoch = ins_atomic_u64_inc_eval(&hs_shared->access_epoch);
+    U64 age_bucket_bytes[HS_EVICTOR_AGE_BUCKET_COUNT] = {0};
+    
+    //- release nodes which are no longer referenced; gather the sizes
+    // of evictable data by age
     for(U64 slot_idx = 0; slot_idx < hs_shared->slots_count; slot_idx += 1)
     {
       U64 stripe_idx = slot_idx%hs_shared->stripes_count;
@@ -306,12 +647,19 @@ hs_evictor_thread__entry_point(void *p)
           if(key_ref_count == 0 && scope_ref_count == 0)
           {
             slot_has_work = 1;
-            break;
+          }
+          else if(scope_ref_count == 0 && n->arena != 0)
+          {
+            U64 age = hs_node_age(n, epoch);
+            age_bucket_bytes[age] += n->data.size;
           }
         }
       }
       if(slot_has_work) OS_MutexScopeW(stripe->rw_mutex)
       {
+        // NOTE: begin the write before checking refcounts, so that lock-free
+        // readers either see the eviction or have their reference seen here
+        ins_atomic_u64_inc_eval(&slot->seq);
         for(HS_Node *n = slot->first, *next = 0; n != 0; n = next)
         {
           next = n->next;
@@ -321,11 +669,73 @@ hs_evictor_thread__entry_point(void *p)
           {
             DLLRemove(slot->first, slot->last, n);
             SLLStackPush(hs_shared->stripes_free_nodes[stripe_idx], n);
-            arena_release(n->arena);
+            hs_node_release_data__stripe_w_guarded(n);
+          }
+        }
+        ins_atomic_u64_inc_eval(&slot->seq);
+      }
+    }
+    
+    //- over budget -> pick the age above which data must go, then
+    // evict the data of unscoped nodes at least that old
+    U64 budget_bytes = ins_atomic_u64_eval(&hs_shared->budget_bytes);
+    U64 resident_bytes = ins_atomic_u64_eval(&hs_shared->resident_bytes);
+    B32 over_budget = (budget_bytes != 0 && resident_bytes > budget_bytes);
+    if(over_budget)
+    {
+      U64 excess_bytes = resident_bytes - budget_bytes;
+      U64 min_age = 0;
+      {
+        U64 bytes = 0;
+        for(U64 age = HS_EVICTOR_AGE_BUCKET_COUNT; age > 0; age -= 1)
+        {
+          bytes += age_bucket_bytes[age-1];
+          if(bytes >= excess_bytes)
+          {
+            min_age = age-1;
+            break;
+          }
+        }
+      }
+      U64 freed_bytes = 0;
+      for(U64 slot_idx = 0; slot_idx < hs_shared->slots_count && freed_bytes < excess_bytes; slot_idx += 1)
+      {
+        U64 stripe_idx = slot_idx%hs_shared->stripes_count;
+        HS_Slot *slot = &hs_shared->slots[slot_idx];
+        HS_Stripe *stripe = &hs_shared->stripes[stripe_idx];
+        B32 slot_has_work = 0;
+        OS_MutexScopeR(stripe->rw_mutex)
+        {
+          for(HS_Node *n = slot->first; n != 0; n = n->next)
+          {
+            if(n->arena != 0 && ins_atomic_u64_eval(&n->scope_ref_count) == 0 && hs_node_age(n, epoch) >= min_age)
+            {
+              slot_has_work = 1;
+              break;
+            }
+          }
+        }
+        if(slot_has_work) OS_MutexScopeW(stripe->rw_mutex)
+        {
+          ins_atomic_u64_inc_eval(&slot->seq);
+          for(HS_Node *n = slot->first; n != 0 && freed_bytes < excess_bytes; n = n->next)
+          {
+            if(n->arena != 0 && ins_atomic_u64_eval(&n->scope_ref_count) == 0 && hs_node_age(n, epoch) >= min_age)
+            {
+              freed_bytes += n->data.size;
+              ins_atomic_u64_inc_eval(&hs_shared->eviction_count);
+              ins_atomic_u64_add_eval(&hs_shared->evicted_bytes, n->data.size);
+              hs_node_release_data__stripe_w_guarded(n);
+            }
           }
+          ins_atomic_u64_inc_eval(&slot->seq);
         }
       }
     }
-    os_sleep_milliseconds(1000);
+    
+    //- still over budget (e.g. everything left is scoped) -> come back soon
+    resident_bytes = ins_atomic_u64_eval(&hs_shared->resident_bytes);
+    over_budget = (budget_bytes != 0 && resident_bytes > budget_bytes);
+    os_sleep_milliseconds(over_budget ? 100 : 1000);
   }
 }
@@ -4,6 +4,28 @@
 #ifndef HASH_STORE_H
 #define HASH_STORE_H
 
+////////////////////////////////
+//~ Hash Backends
+//
+// Content hashes are the store's identity for data - two blobs with the same
+// hash are the same blob - so the default backend is blake2b. The AES-round
+// backend runs several times faster on large blobs, but it is not collision
+// resistant: inputs can be crafted to collide, which would hand one blob's
+// consumers another's bytes. It is opt-in via hs_set_hash_kind, for callers
+// that only ever hash trusted data. The backend should be picked before data
+// is submitted: switching it later is safe, but identical data submitted
+// under different backends is no longer deduplicated.
+
+typedef enum HS_HashKind
+{
+  HS_HashKind_Blake2b,
+  HS_HashKind_AES,
+  HS_HashKind_COUNT
+}
+HS_HashKind;
+
+#define HS_DEFAULT_HASH_KIND HS_HashKind_Blake2b
+
 ////////////////////////////////
 //~ rjf: Cache Types
 
@@ -20,6 +42,7 @@ struct HS_KeySlot
 {
   HS_KeyNode *first;
   HS_KeyNode *last;
+  U64 seq;
 };
 
 typedef struct HS_Node HS_Node;
@@ -32,6 +55,7 @@ struct HS_Node
   String8 data;
   U64 scope_ref_count;
   U64 key_ref_count;
+  U64 last_access_epoch;
 };
 
 typedef struct HS_Slot HS_Slot;
@@ -39,6 +63,7 @@ struct HS_Slot
 {
   HS_Node *first;
   HS_Node *last;
+  U64 seq;
 };
 
 typedef struct HS_Stripe HS_Stripe;
@@ -49,6 +74,53 @@ struct HS_Stripe
   OS_Handle cv;
 };
 
+////////////////////////////////
+//~ Lock-Free Reads
+//
+// Lookups do not take stripe locks. Each slot carries a sequence number,
+// which writers (holding the stripe's write lock) bump to odd before
+// touching the slot's list & node contents, and back to even afterwards.
+// Readers walk the list between two reads of the sequence number, and
+// only trust what they saw if the number was even & unchanged. Nodes are
+// recycled through the stripe free lists rather than freed, so a stale
+// pointer always refers to readable memory. A reader takes its scope
+// reference *before* validating, so the evictor - which bumps the
+// sequence number before checking refcounts - either sees the reference
+// or invalidates the read. After a few failed attempts, readers fall back
+// to the stripe read lock.
+
+#define HS_LOCKFREE_READ_ATTEMPTS 16
+
+////////////////////////////////
+//~ Memory Budget
+//
+// The evictor keeps the total size of resident data under a byte budget.
+// Every evictor pass advances an access epoch; lookups stamp nodes with the
+// current epoch, so a node's age is the number of passes since it was last
+// read. When over budget, the evictor buckets unscoped nodes by age and
+// drops the data of the oldest ones until back under budget. Nodes which
+// are still referenced by keys stay in the table without data - lookups
+// miss on them, and resubmitting the same data makes them resident again.
+// An evicted node's empty data is not the content of its hash, so anything
+// derived from it must not be cached: hs_data_from_hash_evicted reports the
+// eviction, and callers should treat it as "not loaded yet" while the
+// producer resubmits.
+
+#define HS_DEFAULT_BUDGET_BYTES GB(1)
+#define HS_EVICTOR_AGE_BUCKET_COUNT 64
+
+typedef struct HS_Stats HS_Stats;
+struct HS_Stats
+{
+  U64 hit_count;
+  U64 miss_count;
+  U64 eviction_count;
+  U64 evicted_bytes;
+  U64 resident_node_count;
+  U64 resident_bytes;
+  U64 budget_bytes;
+};
+
 ////////////////////////////////
 //~ rjf: Scoped Access
 
@@ -57,6 +129,7 @@ struct HS_Touch
 {
   HS_Touch *next;
   U128 hash;
+  HS_Node *node;
 };
 
 typedef struct HS_Scope HS_Scope;
@@ -72,9 +145,12 @@ struct HS_Scope
 typedef struct HS_TCTX HS_TCTX;
 struct HS_TCTX
 {
+  HS_TCTX *next;
   Arena *arena;
   HS_Scope *free_scope;
   HS_Touch *free_touch;
+  U64 hit_count;
+  U64 miss_count;
 };
 
 ////////////////////////////////
@@ -98,6 +174,22 @@ struct HS_Shared
   HS_KeySlot *key_slots;
   HS_Stripe *key_stripes;
   
+  // thread contexts (for stats)
+  OS_Handle tctx_list_mutex;
+  HS_TCTX *first_tctx;
+  HS_TCTX *last_tctx;
+  
+  // content hash backend
+  HS_HashKind hash_kind;
+  
+  // memory budget & stats
+  U64 budget_bytes;
+  U64 resident_bytes;
+  U64 resident_node_count;
+  U64 access_epoch;
+  U64 eviction_count;
+  U64 evicted_bytes;
+  
   // rjf: evictor thread
   OS_Handle evictor_thread;
 };
@@ -112,11 +204,16 @@ global HS_Shared *hs_shared = 0;
 //~ rjf: Basic Helpers
 
 internal U128 hs_hash_from_data(String8 data);
+internal U128 hs_hash_from_data_kind(HS_HashKind kind, String8 data);
+internal U128 hs_hash_from_data__blake2b(String8 data);
+internal U128 hs_hash_from_data__aes(String8 data);
 
 ////////////////////////////////
 //~ rjf: Main Layer Initialization
 
 internal void hs_init(void);
+internal void hs_set_budget(U64 budget_bytes);
+internal void hs_set_hash_kind(HS_HashKind kind);
 
 ////////////////////////////////
 //~ rjf: Thread Context Initialization
@@ -127,19 +224,34 @@ internal void hs_tctx_ensure_inited(void);
 //~ rjf: Cache Submission/Derefs
 
 internal U128 hs_submit_data(U128 key, Arena **data_arena, String8 data);
+internal void hs_key_commit_hash__ref_held(U128 key, U128 hash);
+internal B32 hs_bind_key(U128 key, U128 hash);
 
 ////////////////////////////////
 //~ rjf: Scoped Access
 
 internal HS_Scope *hs_scope_open(void);
 internal void hs_scope_close(HS_Scope *scope);
-internal void hs_scope_touch_node__stripe_r_guarded(HS_Scope *scope, HS_Node *node);
+internal void hs_scope_touch_node__ref_held(HS_Scope *scope, HS_Node *node);
+internal void hs_node_mark_accessed(HS_Node *node);
+internal U64 hs_node_age(HS_Node *node, U64 epoch);
+internal void hs_node_release_data__stripe_w_guarded(HS_Node *node);
 
 ////////////////////////////////
 //~ rjf: Cache Lookups
 
 internal U128 hs_hash_from_key(U128 key);
 internal String8 hs_data_from_hash(HS_Scope *scope, U128 hash);
+internal String8 hs_data_from_hash_evicted(HS_Scope *scope, U128 hash, B32 *out_evicted);
+
+//- locked lookups (lock-free fallback path)
+internal U128 hs_hash_from_key__locked(U128 key);
+internal String8 hs_data_from_hash__locked(HS_Scope *scope, U128 hash, B32 *out_evicted);
+
+////////////////////////////////
+//~ Stats
+
+internal HS_Stats hs_stats(void);
 
 ////////////////////////////////
 //~ rjf: Evictor Thread
@@ -1149,6 +1149,20 @@ os_copy_file_path(String8 dst, String8 src)
   return 0;
 }
 
+internal B32
+os_move_file_path(String8 dst, String8 src)
+{
+  Temp scratch = scratch_begin(0, 0);
+  B32 result = false;
+  String8 dst_copy = push_str8_copy(scratch.arena, dst);
+  String8 src_copy = push_str8_copy(scratch.arena, src);
+  if (rename((char*)src_copy.str, (char*)dst_copy.str) != -1){
+    result = true;
+  }
+  scratch_end(scratch);
+  return(result);
+}
+
 internal String8
 os_full_path_from_path(Arena *arena, String8 path)
 {
@@ -167,6 +167,48 @@ os_string_from_file_range(Arena *arena, OS_Handle file, Rng1U64 range)
   return result;
 }
 
+internal OS_FileView
+os_file_view_open(String8 path)
+{
+  OS_FileView view = {0};
+  view.file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_Shared, path);
+  if(!os_handle_match(view.file, os_handle_zero()))
+  {
+    FileProperties props = os_properties_from_file(view.file);
+    if(props.size != 0)
+    {
+      view.map = os_file_map_open(OS_AccessFlag_Read, view.file);
+    }
+    if(!os_handle_match(view.map, os_handle_zero()))
+    {
+      void *base = os_file_map_view_open(view.map, OS_AccessFlag_Read, r1u64(0, props.size));
+      if(base != 0)
+      {
+        view.data = str8((U8 *)base, props.size);
+      }
+    }
+  }
+  return view;
+}
+
+internal void
+os_file_view_close(OS_FileView *view)
+{
+  if(view->data.str != 0)
+  {
+    os_file_map_view_close(view->map, view->data.str);
+  }
+  if(!os_handle_match(view->map, os_handle_zero()))
+  {
+    os_file_map_close(view->map);
+  }
+  if(!os_handle_match(view->file, os_handle_zero()))
+  {
+    os_file_close(view->file);
+  }
+  MemoryZeroStruct(view);
+}
+
 ////////////////////////////////
 //~ rjf: Synchronization Primitive Helpers (Helpers, Implemented Once)
 
@@ -123,6 +123,15 @@ struct OS_HandleArray
   U64 count;
 };
 
+// read-only mapping of a whole file
+typedef struct OS_FileView OS_FileView;
+struct OS_FileView
+{
+  OS_Handle file;
+  OS_Handle map;
+  String8 data;
+};
+
 ////////////////////////////////
 // Time
 
@@ -179,6 +188,8 @@ internal FileProperties os_properties_from_file_path(String8 path);
 internal OS_FileID      os_id_from_file_path(String8 path);
 internal S64            os_file_id_compare(OS_FileID a, OS_FileID b);
 internal String8        os_string_from_file_range(Arena *arena, OS_Handle file, Rng1U64 range);
+internal OS_FileView    os_file_view_open(String8 path);
+internal void           os_file_view_close(OS_FileView *view);
 
 ////////////////////////////////
 //~ rjf: Synchronization Primitive Helpers (Helpers, Implemented Once)
@@ -257,6 +268,7 @@ internal FileProperties os_properties_from_file(OS_Handle file);
 internal OS_FileID      os_id_from_file(OS_Handle file);
 internal B32            os_delete_file_at_path(String8 path);
 internal B32            os_copy_file_path(String8 dst, String8 src);
+internal B32            os_move_file_path(String8 dst, String8 src);
 internal String8        os_full_path_from_path(Arena *arena, String8 path);
 internal B32            os_file_path_exists(String8 path);
 
@@ -325,6 +325,9 @@ entry_point(int argc, char **argv)
   U64 jit_pid = 0;
   U64 jit_code = 0;
   U64 jit_addr = 0;
+  U64 hash_store_budget_mb = HS_DEFAULT_BUDGET_BYTES/MB(1);
+  String8 raddbg_cache_dir = str8_lit("");
+  B32 raddbg_cache_disabled = 0;
   {
     if(cmd_line_has_flag(&cmdln, str8_lit("ipc")))
     {
@@ -354,6 +357,10 @@ entry_point(int argc, char **argv)
     try_u64_from_str8_c_rules(jit_code_string, &jit_code);
     try_u64_from_str8_c_rules(jit_addr_string, &jit_addr);
     jit_attach = (jit_addr != 0);
+    String8 hash_store_budget_mb_string = cmd_line_string(&cmdln, str8_lit("hash_store_budget_mb"));
+    try_u64_from_str8_c_rules(hash_store_budget_mb_string, &hash_store_budget_mb);
+    raddbg_cache_dir = cmd_line_string(&cmdln, str8_lit("raddbg_cache"));
+    raddbg_cache_disabled = cmd_line_has_flag(&cmdln, str8_lit("no_raddbg_cache"));
   }
   
   //- rjf: auto-start capture
@@ -375,6 +382,10 @@ entry_point(int argc, char **argv)
     {
       profile_cfg_path = push_str8f(scratch.arena, "%S/default.raddbg_profile", user_data_folder);
     }
+    if(raddbg_cache_dir.size == 0 && !raddbg_cache_disabled)
+    {
+      raddbg_cache_dir = push_str8f(scratch.arena, "%S/cache", user_data_folder);
+    }
   }
   
   //- rjf: dispatch to top-level codepath based on execution mode
@@ -393,9 +404,12 @@ entry_point(int argc, char **argv)
       
       //- rjf: initialize stuff we depend on
       {
+        ts_init(Max(os_logical_core_count(), 2) - 1);
         hs_init();
+        hs_set_budget(hash_store_budget_mb*MB(1));
         txt_init();
         dbgi_init();
+        dbgi_set_cache_dir(raddbg_cache_dir);
         txti_init();
         demon_init();
         ctrl_init(wakeup_hook);
@@ -582,6 +596,9 @@ entry_point(int argc, char **argv)
       //- rjf: parse arguments
       PDBCONV_Params *params = pdb_convert_params_from_cmd_line(scratch.arena, &cmdln);
       
+      //- start worker threads
+      ts_init(params->thread_count - 1);
+      
       //- rjf: open output file
       String8 output_name = push_str8_copy(scratch.arena, params->output_name);
       OS_Handle out_file = os_file_open(OS_AccessFlag_Read|OS_AccessFlag_Write, output_name);
@@ -627,6 +644,12 @@ entry_point(int argc, char **argv)
                                     "This will step into all targets after the debugger initially starts.\n\n"
                                     "--auto_run\n"
                                     "This will run all targets after the debugger initially starts.\n\n"
+                                    "--hash_store_budget_mb:<megabytes>\n"
+                                    "Use to specify the approximate maximum amount of memory used for caching data read from targets, such as process memory. The least recently used data is evicted when over this budget. Defaults to 1024. 0 means no limit.\n\n"
+                                    "--raddbg_cache:<path>\n"
+                                    "Use to specify the directory in which converted debug info is cached. Debug info is keyed by its identity, so identical debug info found in different places is only converted once. Defaults to a folder next to the default user file.\n\n"
+                                    "--no_raddbg_cache\n"
+                                    "Disables the converted debug info cache. Converted debug info is then only stored next to the original debug info.\n\n"
                                     "--ipc <command>\n"
                                     "This will launch the debugger in the non-graphical IPC mode, which is used to communicate with another running instance of the debugger. The debugger instance will launch, send the specified command, then immediately terminate. This may be used by editors or other programs to control the debugger.\n\n"));
     }break;
@@ -4,6 +4,7 @@
 //- rjf: [h]
 #include "base/base_inc.h"
 #include "os/os_inc.h"
+#include "task_system/task_system.h"
 #include "mdesk/mdesk.h"
 #include "hash_store/hash_store.h"
 #include "text_cache/text_cache.h"
@@ -23,6 +24,9 @@
 #include "raddbg_convert/pdb/raddbg_from_pdb.h"
 #include "raddbg_convert/pdb/raddbg_codeview_stringize.h"
 #include "raddbg_convert/pdb/raddbg_pdb_stringize.h"
+#include "raddbg_convert/dwarf/raddbg_elf.h"
+#include "raddbg_convert/dwarf/raddbg_dwarf.h"
+#include "raddbg_convert/dwarf/raddbg_from_dwarf.h"
 #include "regs/regs.h"
 #include "regs/raddbg/regs_raddbg.h"
 #include "type_graph/type_graph.h"
@@ -47,6 +51,7 @@
 //- rjf: [c]
 #include "base/base_inc.c"
 #include "os/os_inc.c"
+#include "task_system/task_system.c"
 #include "mdesk/mdesk.c"
 #include "hash_store/hash_store.c"
 #include "text_cache/text_cache.c"
@@ -65,6 +70,9 @@
 #include "raddbg_convert/pdb/raddbg_codeview_stringize.c"
 #include "raddbg_convert/pdb/raddbg_pdb_stringize.c"
 #include "raddbg_convert/pdb/raddbg_from_pdb.c"
+#include "raddbg_convert/dwarf/raddbg_elf.c"
+#include "raddbg_convert/dwarf/raddbg_dwarf.c"
+#include "raddbg_convert/dwarf/raddbg_from_dwarf.c"
 #include "regs/regs.c"
 #include "regs/raddbg/regs_raddbg.c"
 #include "type_graph/type_graph.c"
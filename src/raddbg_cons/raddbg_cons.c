@@ -103,14 +103,17 @@ cons_bake_file(Arena *arena, CONS_Root *root, String8List *out){
   // units array
   // * pass for per-unit information including:
   // * top-level unit information
-  // * combining line info for whole unit
+  // * source files for line info (line combining itself runs in tasks)
+  U32 unit_count = root->unit_count;
+  RADDBG_Unit *units = push_array(arena, RADDBG_Unit, unit_count);
+  CONS_LineSequenceNode **unit_first_seqs = push_array(arena, CONS_LineSequenceNode*, unit_count);
+  U32 **unit_seq_file_ids = push_array(arena, U32*, unit_count);
   {
-    U32 count = root->unit_count;
-    RADDBG_Unit *units = push_array(arena, RADDBG_Unit, count);
     RADDBG_Unit *dunit = units;
+    U32 unit_idx = 0;
     for (CONS_Unit *sunit = root->unit_first;
          sunit != 0;
-         sunit = sunit->next_order, dunit += 1){
+         sunit = sunit->next_order, dunit += 1, unit_idx += 1){
       // strings & paths
       U32 unit_name = cons__string(bctx, sunit->unit_name);
       U32 cmp_name  = cons__string(bctx, sunit->compiler_name);
@@ -128,38 +131,132 @@ cons_bake_file(Arena *arena, CONS_Root *root, String8List *out){
       dunit->build_path_node          = build_path;
       dunit->language                 = sunit->language;
       
-      // line info (voff -> file*line*col)
-      CONS_LineSequenceNode *first_seq = sunit->line_seq_first;
-      CONS__UnitLinesCombined *lines = cons__unit_combine_lines(arena, bctx, first_seq);
-      
-      U32 line_count = lines->line_count;
-      if (line_count > 0){
-        dunit->line_info_voffs_data_idx =
-          cons__dsection(arena, &dss, lines->voffs, sizeof(U64)*(line_count + 1),
-                         RADDBG_DataSectionTag_LineInfoVoffs);
-        dunit->line_info_data_idx =
-          cons__dsection(arena, &dss, lines->lines, sizeof(RADDBG_Line)*line_count,
-                         RADDBG_DataSectionTag_LineInfoData);
-        if (lines->cols != 0){
-          dunit->line_info_col_data_idx =
-            cons__dsection(arena, &dss, lines->cols, sizeof(RADDBG_Column)*line_count,
-                           RADDBG_DataSectionTag_LineInfoColumns);
-        }
-        dunit->line_info_count = line_count;
+      // line info source files
+      unit_first_seqs[unit_idx] = sunit->line_seq_first;
+      unit_seq_file_ids[unit_idx] = cons__unit_line_file_ids(arena, bctx, sunit->line_seq_first);
+    }
+  }
+  
+  // source nodes with line info
+  // * snapshot of the source nodes that exist after the unit pass; nodes that
+  // * are introduced later (by types) never have line info attached
+  U32 src_count = bctx->tree->src_count;
+  CONS__SrcNode **src_nodes = push_array_no_zero(arena, CONS__SrcNode*, src_count);
+  {
+    CONS__SrcNode **src_node_ptr = src_nodes;
+    for (CONS__SrcNode *src_node = bctx->tree->src_first;
+         src_node != 0;
+         src_node = src_node->next, src_node_ptr += 1){
+      *src_node_ptr = src_node;
+    }
+  }
+  
+  // source file name mapping
+  {
+    CONS__NameMap* map = cons__name_map_for_kind(root, RADDBG_NameMapKind_NormalSourcePaths);
+    for (CONS__SrcNode *src_node = bctx->tree->src_first;
+         src_node != 0;
+         src_node = src_node->next){
+      if (src_node->idx != 0){
+        cons__name_map_add_pair(root, map, src_node->normal_full_path, src_node->idx);
       }
     }
+  }
+  
+  // kickoff tasks for everything that does not need the bake context
+  U64 task_thread_count = ts_thread_count();
+  
+  CONS__UnitLinesCombined **unit_lines = push_array(arena, CONS__UnitLinesCombined*, unit_count);
+  U64 units_per_task = CeilIntegerDiv(unit_count, task_thread_count*4);
+  units_per_task = Max(units_per_task, 1);
+  U64 unit_task_count = CeilIntegerDiv(unit_count, units_per_task);
+  TS_ArenaTask *unit_tasks = push_array(arena, TS_ArenaTask, unit_task_count);
+  ProfScope("kickoff unit line tasks"){
+    for (U64 i = 0; i < unit_task_count; i += 1){
+      CONS__UnitLinesIn *in = push_array(arena, CONS__UnitLinesIn, 1);
+      in->first_seqs = unit_first_seqs;
+      in->seq_file_ids = unit_seq_file_ids;
+      in->unit_idx_first = i*units_per_task;
+      in->unit_idx_opl = Min(unit_count, in->unit_idx_first + units_per_task);
+      in->lines_out = unit_lines;
+      unit_tasks[i] = ts_arena_task_kickoff(cons__unit_lines_task__entry_point, in);
+    }
+  }
+  
+  CONS__SrcLinesCombined **src_lines = push_array(arena, CONS__SrcLinesCombined*, src_count);
+  U64 srcs_per_task = CeilIntegerDiv(src_count, task_thread_count*4);
+  srcs_per_task = Max(srcs_per_task, 1);
+  U64 src_task_count = CeilIntegerDiv(src_count, srcs_per_task);
+  TS_ArenaTask *src_tasks = push_array(arena, TS_ArenaTask, src_task_count);
+  ProfScope("kickoff source line tasks"){
+    for (U64 i = 0; i < src_task_count; i += 1){
+      CONS__SrcLinesIn *in = push_array(arena, CONS__SrcLinesIn, 1);
+      in->src_nodes = src_nodes;
+      in->src_idx_first = i*srcs_per_task;
+      in->src_idx_opl = Min(src_count, in->src_idx_first + srcs_per_task);
+      in->lines_out = src_lines;
+      src_tasks[i] = ts_arena_task_kickoff(cons__src_lines_task__entry_point, in);
+    }
+  }
+  
+  TS_ArenaTask unit_vmap_task = ts_arena_task_kickoff(cons__unit_vmap_task__entry_point, root);
+  TS_ArenaTask global_vmap_task = ts_arena_task_kickoff(cons__global_vmap_task__entry_point, root);
+  TS_ArenaTask scope_data_task = ts_arena_task_kickoff(cons__scope_data_task__entry_point, root);
+  TS_ArenaTask scope_vmap_task = ts_arena_task_kickoff(cons__scope_vmap_task__entry_point, root);
+  
+  TS_ArenaTask name_map_layout_tasks[RADDBG_NameMapKind_COUNT] = {0};
+  for (U32 i = 0; i < RADDBG_NameMapKind_COUNT; i += 1){
+    CONS__NameMap *map = root->name_maps[i];
+    if (map != 0){
+      name_map_layout_tasks[i] = ts_arena_task_kickoff(cons__name_map_layout_task__entry_point, map);
+    }
+  }
+  
+  // type info & symbol info
+  // * interning for these runs on this thread while the tasks are in flight
+  CONS__TypeData *types = cons__type_data_combine(arena, root, bctx);
+  CONS__SymbolData *symbol_data = cons__symbol_data_combine(arena, root, bctx);
+  CONS__ScopeData *scope_data = (CONS__ScopeData*)ts_arena_task_join(arena, scope_data_task);
+  cons__scope_data_bake_local_names(root, bctx, scope_data);
+  
+  // unit line info (voff -> file*line*col)
+  ProfScope("join unit line tasks"){
+    for (U64 i = 0; i < unit_task_count; i += 1){
+      ts_arena_task_join(arena, unit_tasks[i]);
+    }
+  }
+  for (U32 i = 0; i < unit_count; i += 1){
+    RADDBG_Unit *dunit = &units[i];
+    CONS__UnitLinesCombined *lines = unit_lines[i];
     
-    cons__dsection(arena, &dss, units, sizeof(*units)*count, RADDBG_DataSectionTag_Units);
+    U32 line_count = lines->line_count;
+    if (line_count > 0){
+      dunit->line_info_voffs_data_idx =
+        cons__dsection(arena, &dss, lines->voffs, sizeof(U64)*(line_count + 1),
+                       RADDBG_DataSectionTag_LineInfoVoffs);
+      dunit->line_info_data_idx =
+        cons__dsection(arena, &dss, lines->lines, sizeof(RADDBG_Line)*line_count,
+                       RADDBG_DataSectionTag_LineInfoData);
+      if (lines->cols != 0){
+        dunit->line_info_col_data_idx =
+          cons__dsection(arena, &dss, lines->cols, sizeof(RADDBG_Column)*line_count,
+                         RADDBG_DataSectionTag_LineInfoColumns);
+      }
+      dunit->line_info_count = line_count;
+    }
   }
   
+  cons__dsection(arena, &dss, units, sizeof(*units)*unit_count, RADDBG_DataSectionTag_Units);
+  
   // source file line info baking
-  // * pass for "source_combine_line" for each source file -
-  // * can only be run after a pass that does "unit_combine_lines" for each unit.
-  for (CONS__SrcNode *src_node = bctx->tree->src_first;
-       src_node != 0;
-       src_node = src_node->next){
-    CONS__LineMapFragment *first_fragment = src_node->first_fragment;
-    CONS__SrcLinesCombined *lines = cons__source_combine_lines(arena, first_fragment);
+  ProfScope("join source line tasks"){
+    for (U64 i = 0; i < src_task_count; i += 1){
+      ts_arena_task_join(arena, src_tasks[i]);
+    }
+  }
+  for (U32 i = 0; i < src_count; i += 1){
+    CONS__SrcNode *src_node = src_nodes[i];
+    CONS__SrcLinesCombined *lines = src_lines[i];
     U32 line_count = lines->line_count;
     
     if (line_count > 0){
@@ -179,23 +276,9 @@ cons_bake_file(Arena *arena, CONS_Root *root, String8List *out){
     }
   }
   
-  // source file name mapping
-  {
-    CONS__NameMap* map = cons__name_map_for_kind(root, RADDBG_NameMapKind_NormalSourcePaths);
-    for (CONS__SrcNode *src_node = bctx->tree->src_first;
-         src_node != 0;
-         src_node = src_node->next){
-      if (src_node->idx != 0){
-        cons__name_map_add_pair(root, map, src_node->normal_full_path, src_node->idx);
-      }
-    }
-  }
-  
   // unit vmap baking
   {
-    CONS__VMap *vmap = cons__vmap_from_unit_ranges(arena,
-                                                   root->unit_vmap_range_first,
-                                                   root->unit_vmap_range_count);
+    CONS__VMap *vmap = (CONS__VMap*)ts_arena_task_join(arena, unit_vmap_task);
     
     U64 vmap_size = sizeof(*vmap->vmap)*(vmap->count + 1);
     cons__dsection(arena, &dss, vmap->vmap, vmap_size, RADDBG_DataSectionTag_UnitVmap);
@@ -203,8 +286,6 @@ cons_bake_file(Arena *arena, CONS_Root *root, String8List *out){
   
   // type info baking
   {
-    CONS__TypeData *types = cons__type_data_combine(arena, root, bctx);
-    
     U64 type_nodes_size = sizeof(*types->type_nodes)*types->type_node_count;
     cons__dsection(arena, &dss, types->type_nodes, type_nodes_size, RADDBG_DataSectionTag_TypeNodes);
     
@@ -220,14 +301,14 @@ cons_bake_file(Arena *arena, CONS_Root *root, String8List *out){
   
   // symbol info baking
   {
-    CONS__SymbolData *symbol_data = cons__symbol_data_combine(arena, root, bctx);
+    CONS__VMap *global_vmap = (CONS__VMap*)ts_arena_task_join(arena, global_vmap_task);
+    CONS__VMap *scope_vmap = (CONS__VMap*)ts_arena_task_join(arena, scope_vmap_task);
     
     U64 global_variables_size =
       sizeof(*symbol_data->global_variables)*symbol_data->global_variable_count;
     cons__dsection(arena, &dss, symbol_data->global_variables, global_variables_size,
                    RADDBG_DataSectionTag_GlobalVariables);
     
-    CONS__VMap *global_vmap = symbol_data->global_vmap;
     U64 global_vmap_size = sizeof(*global_vmap->vmap)*(global_vmap->count + 1);
     cons__dsection(arena, &dss, global_vmap->vmap, global_vmap_size,
                    RADDBG_DataSectionTag_GlobalVmap);
@@ -241,27 +322,26 @@ cons_bake_file(Arena *arena, CONS_Root *root, String8List *out){
     cons__dsection(arena, &dss, symbol_data->procedures, procedures_size,
                    RADDBG_DataSectionTag_Procedures);
     
-    U64 scopes_size = sizeof(*symbol_data->scopes)*symbol_data->scope_count;
-    cons__dsection(arena, &dss, symbol_data->scopes, scopes_size, RADDBG_DataSectionTag_Scopes);
+    U64 scopes_size = sizeof(*scope_data->scopes)*scope_data->scope_count;
+    cons__dsection(arena, &dss, scope_data->scopes, scopes_size, RADDBG_DataSectionTag_Scopes);
     
-    U64 scope_voffs_size = sizeof(*symbol_data->scope_voffs)*symbol_data->scope_voff_count;
-    cons__dsection(arena, &dss, symbol_data->scope_voffs, scope_voffs_size,
+    U64 scope_voffs_size = sizeof(*scope_data->scope_voffs)*scope_data->scope_voff_count;
+    cons__dsection(arena, &dss, scope_data->scope_voffs, scope_voffs_size,
                    RADDBG_DataSectionTag_ScopeVoffData);
     
-    CONS__VMap *scope_vmap = symbol_data->scope_vmap;
     U64 scope_vmap_size = sizeof(*scope_vmap->vmap)*(scope_vmap->count + 1);
     cons__dsection(arena, &dss, scope_vmap->vmap, scope_vmap_size, RADDBG_DataSectionTag_ScopeVmap);
     
-    U64 local_size = sizeof(*symbol_data->locals)*symbol_data->local_count;
-    cons__dsection(arena, &dss, symbol_data->locals, local_size, RADDBG_DataSectionTag_Locals);
+    U64 local_size = sizeof(*scope_data->locals)*scope_data->local_count;
+    cons__dsection(arena, &dss, scope_data->locals, local_size, RADDBG_DataSectionTag_Locals);
     
     U64 location_blocks_size =
-      sizeof(*symbol_data->location_blocks)*symbol_data->location_block_count;
-    cons__dsection(arena, &dss, symbol_data->location_blocks, location_blocks_size,
+      sizeof(*scope_data->location_blocks)*scope_data->location_block_count;
+    cons__dsection(arena, &dss, scope_data->location_blocks, location_blocks_size,
                    RADDBG_DataSectionTag_LocationBlocks);
     
-    U64 location_data_size = symbol_data->location_data_size;
-    cons__dsection(arena, &dss, symbol_data->location_data, location_data_size,
+    U64 location_data_size = scope_data->location_data_size;
+    cons__dsection(arena, &dss, scope_data->location_data, location_data_size,
                    RADDBG_DataSectionTag_LocationData);
   }
   
@@ -275,12 +355,19 @@ cons_bake_file(Arena *arena, CONS_Root *root, String8List *out){
     }
     
     RADDBG_NameMap *name_maps = push_array(arena, RADDBG_NameMap, name_map_count);
+    RADDBG_NameMapIndex *name_map_indexes = push_array(arena, RADDBG_NameMapIndex, name_map_count);
+    RADDBG_NameMapTrigramIndex *name_map_trigram_indexes =
+      push_array(arena, RADDBG_NameMapTrigramIndex, name_map_count);
+    U32 name_map_trigram_index_count = 0;
     
     RADDBG_NameMap *name_map_ptr = name_maps;
+    RADDBG_NameMapIndex *name_map_index_ptr = name_map_indexes;
     for (U32 i = 0; i < RADDBG_NameMapKind_COUNT; i += 1){
       CONS__NameMap *map = root->name_maps[i];
       if (map != 0){
-        CONS__NameMapBaked *baked = cons__name_map_bake(arena, root, bctx, map);
+        CONS__NameMapLayout *layout =
+          (CONS__NameMapLayout*)ts_arena_task_join(arena, name_map_layout_tasks[i]);
+        CONS__NameMapBaked *baked = cons__name_map_bake(arena, bctx, layout);
         
         name_map_ptr->kind = i;
         name_map_ptr->bucket_data_idx =
@@ -290,11 +377,39 @@ cons_bake_file(Arena *arena, CONS_Root *root, String8List *out){
           cons__dsection(arena, &dss, baked->nodes, sizeof(*baked->nodes)*baked->node_count,
                          RADDBG_DataSectionTag_NameMapNodes);
         name_map_ptr += 1;
+        
+        name_map_index_ptr->kind = i;
+        name_map_index_ptr->sorted_nodes_data_idx =
+          cons__dsection(arena, &dss, layout->sorted_nodes, sizeof(*layout->sorted_nodes)*layout->node_count,
+                         RADDBG_DataSectionTag_NameMapSortedNodes);
+        name_map_index_ptr->suffixes_data_idx =
+          cons__dsection(arena, &dss, layout->suffixes, sizeof(*layout->suffixes)*layout->suffix_count,
+                         RADDBG_DataSectionTag_NameMapSuffixes);
+        name_map_index_ptr += 1;
+        
+        if (layout->trigrams != 0){
+          RADDBG_NameMapTrigramIndex *trigram_index =
+            &name_map_trigram_indexes[name_map_trigram_index_count];
+          name_map_trigram_index_count += 1;
+          trigram_index->kind = i;
+          trigram_index->trigrams_data_idx =
+            cons__dsection(arena, &dss, layout->trigrams, sizeof(*layout->trigrams)*layout->trigram_count,
+                           RADDBG_DataSectionTag_NameMapTrigrams);
+          trigram_index->postings_data_idx =
+            cons__dsection(arena, &dss, layout->trigram_postings,
+                           sizeof(*layout->trigram_postings)*layout->trigram_posting_count,
+                           RADDBG_DataSectionTag_NameMapTrigramPostings);
+        }
       }
     }
     
     cons__dsection(arena, &dss, name_maps, sizeof(*name_maps)*name_map_count,
                    RADDBG_DataSectionTag_NameMaps);
+    cons__dsection(arena, &dss, name_map_indexes, sizeof(*name_map_indexes)*name_map_count,
+                   RADDBG_DataSectionTag_NameMapIndexes);
+    cons__dsection(arena, &dss, name_map_trigram_indexes,
+                   sizeof(*name_map_trigram_indexes)*name_map_trigram_index_count,
+                   RADDBG_DataSectionTag_NameMapTrigramIndexes);
   }
   
   ////////////////////////////////
@@ -367,12 +482,27 @@ cons_bake_file(Arena *arena, CONS_Root *root, String8List *out){
     
     U8 *buf = push_array(arena, U8, off_cursor);
     {
-      U8 *ptr = buf;
-      for (CONS__StringNode *node = bctx->strs.order_first;
-           node != 0;
-           node = node->order_next){
-        MemoryCopy(ptr, node->str.str, node->str.size);
-        ptr += node->str.size;
+      // shard the copy into runs of strings with disjoint output ranges
+      U64 str_count = bctx->strs.count;
+      U64 strs_per_task = CeilIntegerDiv(str_count, ts_thread_count()*4);
+      strs_per_task = Max(strs_per_task, 1);
+      U64 task_count = CeilIntegerDiv(str_count, strs_per_task);
+      TS_ArenaTask *tasks = push_array(arena, TS_ArenaTask, task_count);
+      
+      CONS__StringNode *node = bctx->strs.order_first;
+      for (U64 i = 0; i < task_count; i += 1){
+        CONS__StringDataIn *in = push_array(arena, CONS__StringDataIn, 1);
+        U64 first = i*strs_per_task;
+        in->first = node;
+        in->count = Min(str_count, first + strs_per_task) - first;
+        in->dst = buf + str_offs[first];
+        for (U64 j = 0; j < in->count; j += 1){
+          node = node->order_next;
+        }
+        tasks[i] = ts_arena_task_kickoff(cons__string_data_task__entry_point, in);
+      }
+      for (U64 i = 0; i < task_count; i += 1){
+        ts_arena_task_join(arena, tasks[i]);
       }
     }
     
@@ -386,17 +516,40 @@ cons_bake_file(Arena *arena, CONS_Root *root, String8List *out){
     U32 *idx_data = push_array_no_zero(arena, U32, bctx->idxs.idx_count);
     
     {
+      // shard the copy into runs of index runs with disjoint output ranges
+      U64 run_count = 0;
+      for (CONS__IdxRunNode *node = bctx->idxs.order_first;
+           node != 0;
+           node = node->order_next){
+        run_count += 1;
+      }
+      U64 runs_per_task = CeilIntegerDiv(run_count, ts_thread_count()*4);
+      runs_per_task = Max(runs_per_task, 1);
+      U64 task_count = CeilIntegerDiv(run_count, runs_per_task);
+      TS_ArenaTask *tasks = push_array(arena, TS_ArenaTask, task_count);
+      
       U32 *out_ptr = idx_data;
       U32 *opl = out_ptr + bctx->idxs.idx_count;
       CONS__IdxRunNode *node = bctx->idxs.order_first;
-      for (;node != 0 && out_ptr < opl;
-           node = node->order_next){
-        MemoryCopy(out_ptr, node->idx_run, sizeof(*node->idx_run)*node->count);
-        out_ptr += node->count;
+      for (U64 i = 0; i < task_count; i += 1){
+        CONS__IdxRunDataIn *in = push_array(arena, CONS__IdxRunDataIn, 1);
+        U64 first = i*runs_per_task;
+        in->first = node;
+        in->count = Min(run_count, first + runs_per_task) - first;
+        in->dst = out_ptr;
+        for (U64 j = 0; j < in->count; j += 1){
+          out_ptr += node->count;
+          node = node->order_next;
+        }
+        tasks[i] = ts_arena_task_kickoff(cons__idx_run_data_task__entry_point, in);
       }
       // both iterators should reach the end at the same time
       Assert(node == 0);
       Assert(out_ptr == opl);
+      
+      for (U64 i = 0; i < task_count; i += 1){
+        ts_arena_task_join(arena, tasks[i]);
+      }
     }
     
     cons__dsection(arena, &dss, idx_data, sizeof(*idx_data)*bctx->idxs.idx_count,
@@ -419,6 +572,8 @@ cons_bake_file(Arena *arena, CONS_Root *root, String8List *out){
     header->encoding_version = RADDBG_ENCODING_VERSION;
     header->data_section_off = data_section_off;
     header->data_section_count = dss.count;
+    header->dbg_age = root->top_level_info.dbg_age;
+    MemoryCopyArray(header->dbg_guid, root->top_level_info.dbg_guid);
   }
   {
     U64 test_dss_count = 0;
@@ -1642,6 +1797,90 @@ cons_bytecode_concat_in_place(CONS_EvalBytecode *left_dst, CONS_EvalBytecode *ri
   }
 }
 
+// progress reporting
+
+static void
+cons_progress_advance(CONS_Progress *progress, U64 bytes, U64 units){
+  if (progress->func != 0){
+    U64 bytes_processed = ins_atomic_u64_add_eval(&progress->bytes_processed, bytes);
+    U64 units_processed = ins_atomic_u64_add_eval(&progress->units_processed, units);
+    bytes_processed = ClampTop(bytes_processed, progress->bytes_total);
+    units_processed = ClampTop(units_processed, progress->units_total);
+    progress->func(progress->user,
+                   bytes_processed, progress->bytes_total,
+                   units_processed, progress->units_total);
+  }
+}
+
+static void
+cons_progress_finish(CONS_Progress *progress){
+  if (progress->func != 0){
+    progress->func(progress->user,
+                   progress->bytes_total, progress->bytes_total,
+                   progress->units_total, progress->units_total);
+  }
+}
+
+// publics-only roots
+
+static CONS_Root*
+cons_root_new_from_publics(U64 addr_size, CONS_Public *publics, U64 public_count){
+  // sort publics; a public never runs past the next one inside its range
+  qsort(publics, public_count, sizeof(*publics),
+        (int (*)(const void *, const void *))cons__qsort_compare_public);
+  for (U64 i = 0; i + 1 < public_count; i += 1){
+    CONS_Public *pub = publics + i;
+    for (U64 j = i + 1; j < public_count; j += 1){
+      CONS_Public *next = publics + j;
+      if (next->voff >= pub->voff_opl){
+        break;
+      }
+      if (next->voff > pub->voff){
+        pub->voff_opl = next->voff;
+        break;
+      }
+    }
+  }
+  
+  // setup root
+  CONS_RootParams root_params = {0};
+  root_params.addr_size = addr_size;
+  root_params.bucket_count_symbols = ClampBot(public_count, 128);
+  root_params.bucket_count_scopes = ClampBot(public_count, 128);
+  CONS_Root *root = cons_root_new(&root_params);
+  
+  // symbols
+  CONS_Type *type = cons_type_handled_nil(root);
+  U64 last_function_voff = max_U64;
+  for (U64 i = 0; i < public_count; i += 1){
+    CONS_Public *pub = publics + i;
+    U64 user_id = i + 1;
+    CONS_SymbolInfo info = zero_struct;
+    info.name = pub->name;
+    info.link_name = pub->name;
+    info.type = type;
+    info.is_extern = 1;
+    if (pub->is_function){
+      if (pub->voff == last_function_voff){
+        continue;
+      }
+      last_function_voff = pub->voff;
+      CONS_Scope *root_scope = cons_scope_handle_from_user_id(root, user_id);
+      cons_scope_add_voff_range(root, root_scope, pub->voff, pub->voff_opl);
+      info.kind = CONS_SymbolKind_Procedure;
+      info.root_scope = root_scope;
+    }
+    else{
+      info.kind = CONS_SymbolKind_GlobalVariable;
+      info.offset = pub->voff;
+    }
+    CONS_Symbol *symbol = cons_symbol_handle_from_user_id(root, user_id);
+    cons_symbol_set_info(root, symbol, &info);
+  }
+  
+  return(root);
+}
+
 
 
 ////////////////////////////////
@@ -1710,6 +1949,7 @@ cons__name_map_for_kind(CONS_Root *root, RADDBG_NameMapKind kind){
   if (kind < RADDBG_NameMapKind_COUNT){
     if (root->name_maps[kind] == 0){
       root->name_maps[kind] = push_array(root->arena, CONS__NameMap, 1);
+      root->name_maps[kind]->kind = kind;
     }
     result = root->name_maps[kind];
   }
@@ -2293,10 +2533,53 @@ cons__sort_key_array(Arena *arena, CONS__SortKey *keys, U64 count){
   return(result);
 }
 
+static int
+cons__qsort_compare_public(CONS_Public *a, CONS_Public *b){
+  int result = 0;
+  if (a->voff < b->voff){
+    result = -1;
+  }
+  else if (a->voff > b->voff){
+    result = +1;
+  }
+  return(result);
+}
+
 
 //- cons intermediate unit line info
+static U32*
+cons__unit_line_file_ids(Arena *arena, CONS__BakeCtx *bctx, CONS_LineSequenceNode *first_seq){
+  // resolve the source file of each sequence & attach the sequence to that
+  // file's line map; this is the only part of line combining that needs bctx
+  U64 seq_count = 0;
+  for (CONS_LineSequenceNode *node = first_seq;
+       node != 0;
+       node = node->next){
+    seq_count += 1;
+  }
+  
+  U32 *seq_file_ids = push_array_no_zero(arena, U32, seq_count);
+  {
+    U32 *id_ptr = seq_file_ids;
+    for (CONS_LineSequenceNode *node = first_seq;
+         node != 0;
+         node = node->next, id_ptr += 1){
+      CONS__PathNode *src_path =
+        cons__paths_node_from_path(bctx, node->line_seq.file_name);
+      CONS__SrcNode *src_file  = cons__paths_src_node_from_path_node(bctx, src_path);
+      *id_ptr = src_file->idx;
+      
+      CONS__LineMapFragment *fragment = push_array(arena, CONS__LineMapFragment, 1);
+      SLLQueuePush(src_file->first_fragment, src_file->last_fragment, fragment);
+      fragment->sequence = node;
+    }
+  }
+  
+  return(seq_file_ids);
+}
+
 static CONS__UnitLinesCombined*
-cons__unit_combine_lines(Arena *arena, CONS__BakeCtx *bctx, CONS_LineSequenceNode *first_seq){
+cons__unit_combine_lines(Arena *arena, CONS_LineSequenceNode *first_seq, U32 *seq_file_ids){
   ProfBegin("cons__unit_combine_lines");
   Temp scratch = scratch_begin(&arena, 1);
   
@@ -2319,14 +2602,12 @@ cons__unit_combine_lines(Arena *arena, CONS__BakeCtx *bctx, CONS_LineSequenceNod
   {
     CONS__SortKey *key_ptr = line_keys;
     CONS__LineRec *rec_ptr = line_recs;
+    U32 *id_ptr = seq_file_ids;
     
     for (CONS_LineSequenceNode *node = first_seq;
          node != 0;
-         node = node->next){
-      CONS__PathNode *src_path =
-        cons__paths_node_from_path(bctx, node->line_seq.file_name);
-      CONS__SrcNode *src_file  = cons__paths_src_node_from_path_node(bctx, src_path);
-      U32 file_id = src_file->idx;
+         node = node->next, id_ptr += 1){
+      U32 file_id = *id_ptr;
       
       U64 node_line_count = node->line_seq.line_count;
       for (U64 i = 0; i < node_line_count; i += 1){
@@ -2346,10 +2627,6 @@ cons__unit_combine_lines(Arena *arena, CONS__BakeCtx *bctx, CONS_LineSequenceNod
       key_ptr->key = node->line_seq.voffs[node_line_count];
       key_ptr->val = 0;
       key_ptr += 1;
-      
-      CONS__LineMapFragment *fragment = push_array(arena, CONS__LineMapFragment, 1);
-      SLLQueuePush(src_file->first_fragment, src_file->last_fragment, fragment);
-      fragment->sequence = node;
     }
   }
   
@@ -2902,7 +3179,6 @@ cons__idx_run_from_types(Arena *arena, CONS_Type **types, U32 count){
 static CONS__SymbolData*
 cons__symbol_data_combine(Arena *arena, CONS_Root *root, CONS__BakeCtx *bctx){
   ProfBegin("cons__symbol_data_combine");
-  Temp scratch = scratch_begin(&arena, 1);
   
   // count symbol kinds
   U32 globalvar_count = 1 + root->symbol_kind_counts[CONS_SymbolKind_GlobalVariable];
@@ -2994,6 +3270,27 @@ cons__symbol_data_combine(Arena *arena, CONS_Root *root, CONS__BakeCtx *bctx){
     Assert(procedure_ptr - procedures == procedure_count);
   }
   
+  // fill result
+  CONS__SymbolData *result = push_array(arena, CONS__SymbolData, 1);
+  result->global_variables = global_variables;
+  result->global_variable_count = globalvar_count;
+  result->thread_variables = thread_variables;
+  result->thread_variable_count = threadvar_count;
+  result->procedures = procedures;
+  result->procedure_count = procedure_count;
+  
+  ProfEnd();
+  
+  return(result);
+}
+
+static CONS__VMap*
+cons__vmap_from_global_symbols(Arena *arena, CONS_Root *root){
+  ProfBegin("cons__vmap_from_global_symbols");
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  U32 globalvar_count = 1 + root->symbol_kind_counts[CONS_SymbolKind_GlobalVariable];
+  
   // global vmap
   CONS__VMap *global_vmap = 0;
   {
@@ -3063,6 +3360,18 @@ cons__symbol_data_combine(Arena *arena, CONS_Root *root, CONS__BakeCtx *bctx){
     global_vmap = cons__vmap_from_markers(arena, markers, keys, marker_count);
   }
   
+  scratch_end(scratch);
+  ProfEnd();
+  
+  return(global_vmap);
+}
+
+//- cons serializer for scopes
+static CONS__ScopeData*
+cons__scope_data_combine(Arena *arena, CONS_Root *root){
+  ProfBegin("cons__scope_data_combine");
+  Temp scratch = scratch_begin(&arena, 1);
+  
   // allocate scope array
   
   // (assert there is a nil scope)
@@ -3118,7 +3427,6 @@ cons__symbol_data_combine(Arena *arena, CONS_Root *root, CONS__BakeCtx *bctx){
            slocal != 0;
            slocal = slocal->next, local_ptr += 1){
         local_ptr->kind = slocal->kind;
-        local_ptr->name_string_idx = cons__string(bctx, slocal->name);
         local_ptr->type_idx = slocal->type->idx;
         
         CONS_LocationSet *locset = slocal->locset;
@@ -3220,6 +3528,53 @@ cons__symbol_data_combine(Arena *arena, CONS_Root *root, CONS__BakeCtx *bctx){
   // flatten location data
   String8 location_data_str = str8_list_join(arena, &location_data, 0);
   
+  // fill result
+  CONS__ScopeData *result = push_array(arena, CONS__ScopeData, 1);
+  result->scopes = scopes;
+  result->scope_count = scope_count;
+  result->scope_voffs = scope_voffs;
+  result->scope_voff_count = scope_voff_count;
+  result->locals = locals;
+  result->local_count = local_count;
+  result->location_blocks = location_blocks;
+  result->location_block_count = location_block_count;
+  result->location_data = location_data_str.str;
+  result->location_data_size = location_data_str.size;
+  
+  scratch_end(scratch);
+  ProfEnd();
+  
+  return(result);
+}
+
+static void
+cons__scope_data_bake_local_names(CONS_Root *root, CONS__BakeCtx *bctx, CONS__ScopeData *scope_data){
+  ProfBegin("cons__scope_data_bake_local_names");
+  
+  // locals are laid out in scope order, so this walk visits them in the same
+  // order as cons__scope_data_combine
+  RADDBG_Local *local_ptr = scope_data->locals;
+  for (CONS_Scope *node = root->first_scope;
+       node != 0;
+       node = node->next_order){
+    for (CONS_Local *slocal = node->first_local;
+         slocal != 0;
+         slocal = slocal->next, local_ptr += 1){
+      local_ptr->name_string_idx = cons__string(bctx, slocal->name);
+    }
+  }
+  Assert(local_ptr - scope_data->locals == scope_data->local_count);
+  
+  ProfEnd();
+}
+
+static CONS__VMap*
+cons__vmap_from_scopes(Arena *arena, CONS_Root *root){
+  ProfBegin("cons__vmap_from_scopes");
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  U32 scope_voff_count = root->scope_voff_count;
+  
   // scope vmap
   CONS__VMap *scope_vmap = 0;
   {
@@ -3260,55 +3615,209 @@ cons__symbol_data_combine(Arena *arena, CONS_Root *root, CONS__BakeCtx *bctx){
     scope_vmap = cons__vmap_from_markers(arena, markers, keys, marker_count);
   }
   
-  // fill result
-  CONS__SymbolData *result = push_array(arena, CONS__SymbolData, 1);
-  result->global_variables = global_variables;
-  result->global_variable_count = globalvar_count;
-  result->global_vmap = global_vmap;
-  result->thread_variables = thread_variables;
-  result->thread_variable_count = threadvar_count;
-  result->procedures = procedures;
-  result->procedure_count = procedure_count;
-  result->scopes = scopes;
-  result->scope_count = scope_count;
-  result->scope_voffs = scope_voffs;
-  result->scope_voff_count = scope_voff_count;
-  result->scope_vmap = scope_vmap;
-  result->locals = locals;
-  result->local_count = local_count;
-  result->location_blocks = location_blocks;
-  result->location_block_count = location_block_count;
-  result->location_data = location_data_str.str;
-  result->location_data_size = location_data_str.size;
-  
   scratch_end(scratch);
   ProfEnd();
   
-  return(result);
+  return(scope_vmap);
 }
 
 //- cons serializer for name maps
 
-static CONS__NameMapBaked*
-cons__name_map_bake(Arena *arena, CONS_Root *root, CONS__BakeCtx *bctx, CONS__NameMap *map){
-  Temp scratch = scratch_begin(&arena, 1);
+static int
+cons__qsort_compare_name_map_sort_entry(CONS__NameMapSortEntry *a, CONS__NameMapSortEntry *b){
+  int result = raddbg_name_index_compare(a->string.str, a->string.size, b->string.str, b->string.size);
+  if (result == 0){
+    if (a->node_idx != b->node_idx){
+      result = (a->node_idx < b->node_idx)?-1:1;
+    }
+    else if (a->off != b->off){
+      result = (a->off < b->off)?-1:1;
+    }
+  }
+  return(result);
+}
+
+static CONS__NameMapLayout*
+cons__name_map_layout(Arena *arena, CONS__NameMap *map){
+  ProfBegin("cons__name_map_layout");
   
   U32 bucket_count = map->name_count;
-  U32 node_count = map->name_count;
   
   // setup the final bucket layouts
-  CONS__NameMapSemiBucket *sbuckets = push_array(scratch.arena, CONS__NameMapSemiBucket, bucket_count);
+  CONS__NameMapSemiBucket *sbuckets = push_array(arena, CONS__NameMapSemiBucket, bucket_count);
   for (CONS__NameMapNode *node = map->first;
        node != 0;
        node = node->order_next){
     U64 hash = raddbg_hash(node->string.str, node->string.size);
     U64 bi = hash%bucket_count;
-    CONS__NameMapSemiNode *snode = push_array(scratch.arena, CONS__NameMapSemiNode, 1);
+    CONS__NameMapSemiNode *snode = push_array(arena, CONS__NameMapSemiNode, 1);
     SLLQueuePush(sbuckets[bi].first, sbuckets[bi].last, snode);
     snode->node = node;
     sbuckets[bi].count += 1;
   }
   
+  // sort names & word-start suffixes for the prefix/substring index
+  U32 *sorted_nodes = push_array_no_zero(arena, U32, bucket_count);
+  RADDBG_NameMapSuffix *suffixes = 0;
+  U64 suffix_count = 0;
+  {
+    Temp scratch = scratch_begin(&arena, 1);
+    
+    // gather entries in node order
+    CONS__NameMapSortEntry *name_entries = push_array_no_zero(scratch.arena, CONS__NameMapSortEntry, bucket_count);
+    U32 node_idx = 0;
+    for (U32 i = 0; i < bucket_count; i += 1){
+      for (CONS__NameMapSemiNode *snode = sbuckets[i].first;
+           snode != 0;
+           snode = snode->next, node_idx += 1){
+        String8 string = snode->node->string;
+        name_entries[node_idx].string = string;
+        name_entries[node_idx].node_idx = node_idx;
+        name_entries[node_idx].off = 0;
+        for (U64 off = 0; off < string.size; off += 1){
+          if (raddbg_name_index_is_word_start(string.str, string.size, off)){
+            suffix_count += 1;
+          }
+        }
+      }
+    }
+    
+    CONS__NameMapSortEntry *suffix_entries = push_array_no_zero(scratch.arena, CONS__NameMapSortEntry, suffix_count);
+    {
+      CONS__NameMapSortEntry *suffix_ptr = suffix_entries;
+      for (U32 i = 0; i < node_idx; i += 1){
+        String8 string = name_entries[i].string;
+        for (U64 off = 0; off < string.size; off += 1){
+          if (raddbg_name_index_is_word_start(string.str, string.size, off)){
+            suffix_ptr->string = str8_skip(string, off);
+            suffix_ptr->node_idx = i;
+            suffix_ptr->off = (U32)off;
+            suffix_ptr += 1;
+          }
+        }
+      }
+    }
+    
+    // sort
+    qsort(name_entries, node_idx, sizeof(*name_entries),
+          (int (*)(const void *, const void *))cons__qsort_compare_name_map_sort_entry);
+    qsort(suffix_entries, suffix_count, sizeof(*suffix_entries),
+          (int (*)(const void *, const void *))cons__qsort_compare_name_map_sort_entry);
+    
+    // flatten
+    for (U32 i = 0; i < node_idx; i += 1){
+      sorted_nodes[i] = name_entries[i].node_idx;
+    }
+    suffixes = push_array_no_zero(arena, RADDBG_NameMapSuffix, suffix_count);
+    for (U64 i = 0; i < suffix_count; i += 1){
+      suffixes[i].node_idx = suffix_entries[i].node_idx;
+      suffixes[i].off = suffix_entries[i].off;
+    }
+    
+    scratch_end(scratch);
+  }
+  
+  // trigram index for fuzzy searching symbols & types
+  RADDBG_NameMapTrigram *trigrams = 0;
+  U32 trigram_count = 0;
+  U32 *trigram_postings = 0;
+  U64 trigram_posting_count = 0;
+  if (map->kind == RADDBG_NameMapKind_GlobalVariables ||
+      map->kind == RADDBG_NameMapKind_ThreadVariables ||
+      map->kind == RADDBG_NameMapKind_Procedures ||
+      map->kind == RADDBG_NameMapKind_Types){
+    Temp scratch = scratch_begin(&arena, 1);
+    
+    // one key per (trigram, node) occurrence
+    U64 key_count = 0;
+    for (CONS__NameMapNode *node = map->first; node != 0; node = node->order_next){
+      if (node->string.size >= 3){
+        key_count += node->string.size - 2;
+      }
+    }
+    CONS__SortKey *keys = push_array_no_zero(scratch.arena, CONS__SortKey, key_count);
+    {
+      CONS__SortKey *key_ptr = keys;
+      U32 node_idx = 0;
+      for (U32 i = 0; i < bucket_count; i += 1){
+        for (CONS__NameMapSemiNode *snode = sbuckets[i].first;
+             snode != 0;
+             snode = snode->next, node_idx += 1){
+          String8 string = snode->node->string;
+          for (U64 off = 0; off + 3 <= string.size; off += 1){
+            U64 trigram = raddbg_name_index_trigram(string.str + off);
+            key_ptr->key = (trigram << 32) | node_idx;
+            key_ptr->val = 0;
+            key_ptr += 1;
+          }
+        }
+      }
+    }
+    
+    // sort by trigram, then node
+    CONS__SortKey *sorted = cons__sort_key_array(scratch.arena, keys, key_count);
+    
+    // count unique trigrams & postings
+    U64 unique_trigram_count = 0;
+    for (U64 i = 0; i < key_count; i += 1){
+      if (i == 0 || sorted[i].key != sorted[i - 1].key){
+        trigram_posting_count += 1;
+        if (i == 0 || (sorted[i].key >> 32) != (sorted[i - 1].key >> 32)){
+          unique_trigram_count += 1;
+        }
+      }
+    }
+    
+    // fill trigrams & postings
+    trigram_count = (U32)unique_trigram_count;
+    trigrams = push_array(arena, RADDBG_NameMapTrigram, trigram_count);
+    trigram_postings = push_array_no_zero(arena, U32, trigram_posting_count);
+    {
+      RADDBG_NameMapTrigram *trigram_ptr = 0;
+      U32 *posting_ptr = trigram_postings;
+      for (U64 i = 0; i < key_count; i += 1){
+        if (i == 0 || sorted[i].key != sorted[i - 1].key){
+          U32 trigram = (U32)(sorted[i].key >> 32);
+          if (trigram_ptr == 0 || trigram != trigram_ptr->trigram){
+            trigram_ptr = (trigram_ptr == 0)?trigrams:(trigram_ptr + 1);
+            trigram_ptr->trigram = trigram;
+            trigram_ptr->posting_first = (U32)(posting_ptr - trigram_postings);
+          }
+          *posting_ptr = (U32)sorted[i].key;
+          posting_ptr += 1;
+          trigram_ptr->posting_count += 1;
+        }
+      }
+    }
+    
+    scratch_end(scratch);
+  }
+  
+  CONS__NameMapLayout *result = push_array(arena, CONS__NameMapLayout, 1);
+  result->sbuckets = sbuckets;
+  result->bucket_count = bucket_count;
+  result->sorted_nodes = sorted_nodes;
+  result->node_count = bucket_count;
+  result->suffixes = suffixes;
+  result->suffix_count = suffix_count;
+  result->trigrams = trigrams;
+  result->trigram_count = trigram_count;
+  result->trigram_postings = trigram_postings;
+  result->trigram_posting_count = trigram_posting_count;
+  
+  ProfEnd();
+  
+  return(result);
+}
+
+static CONS__NameMapBaked*
+cons__name_map_bake(Arena *arena, CONS__BakeCtx *bctx, CONS__NameMapLayout *layout){
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  U32 bucket_count = layout->bucket_count;
+  U32 node_count = layout->bucket_count;
+  CONS__NameMapSemiBucket *sbuckets = layout->sbuckets;
+  
   // allocate tables
   RADDBG_NameMapBucket *buckets = push_array(arena, RADDBG_NameMapBucket, bucket_count);
   RADDBG_NameMapNode *nodes = push_array_no_zero(arena, RADDBG_NameMapNode, node_count);
@@ -3373,3 +3882,83 @@ cons__name_map_bake(Arena *arena, CONS_Root *root, CONS__BakeCtx *bctx, CONS__Na
   result->node_count = node_count;
   return(result);
 }
+
+//- cons parallel bake tasks
+
+static TS_TASK_FUNCTION_DEF(cons__unit_lines_task__entry_point){
+  ProfBeginFunction();
+  CONS__UnitLinesIn *in = (CONS__UnitLinesIn*)p;
+  for (U64 i = in->unit_idx_first; i < in->unit_idx_opl; i += 1){
+    in->lines_out[i] = cons__unit_combine_lines(arena, in->first_seqs[i], in->seq_file_ids[i]);
+  }
+  ProfEnd();
+  return(0);
+}
+
+static TS_TASK_FUNCTION_DEF(cons__src_lines_task__entry_point){
+  ProfBeginFunction();
+  CONS__SrcLinesIn *in = (CONS__SrcLinesIn*)p;
+  for (U64 i = in->src_idx_first; i < in->src_idx_opl; i += 1){
+    in->lines_out[i] = cons__source_combine_lines(arena, in->src_nodes[i]->first_fragment);
+  }
+  ProfEnd();
+  return(0);
+}
+
+static TS_TASK_FUNCTION_DEF(cons__unit_vmap_task__entry_point){
+  CONS_Root *root = (CONS_Root*)p;
+  CONS__VMap *result = cons__vmap_from_unit_ranges(arena,
+                                                   root->unit_vmap_range_first,
+                                                   root->unit_vmap_range_count);
+  return(result);
+}
+
+static TS_TASK_FUNCTION_DEF(cons__global_vmap_task__entry_point){
+  CONS_Root *root = (CONS_Root*)p;
+  CONS__VMap *result = cons__vmap_from_global_symbols(arena, root);
+  return(result);
+}
+
+static TS_TASK_FUNCTION_DEF(cons__scope_vmap_task__entry_point){
+  CONS_Root *root = (CONS_Root*)p;
+  CONS__VMap *result = cons__vmap_from_scopes(arena, root);
+  return(result);
+}
+
+static TS_TASK_FUNCTION_DEF(cons__scope_data_task__entry_point){
+  CONS_Root *root = (CONS_Root*)p;
+  CONS__ScopeData *result = cons__scope_data_combine(arena, root);
+  return(result);
+}
+
+static TS_TASK_FUNCTION_DEF(cons__name_map_layout_task__entry_point){
+  CONS__NameMap *map = (CONS__NameMap*)p;
+  CONS__NameMapLayout *result = cons__name_map_layout(arena, map);
+  return(result);
+}
+
+static TS_TASK_FUNCTION_DEF(cons__string_data_task__entry_point){
+  ProfBeginFunction();
+  CONS__StringDataIn *in = (CONS__StringDataIn*)p;
+  U8 *ptr = in->dst;
+  CONS__StringNode *node = in->first;
+  for (U64 i = 0; i < in->count; i += 1, node = node->order_next){
+    MemoryCopy(ptr, node->str.str, node->str.size);
+    ptr += node->str.size;
+  }
+  ProfEnd();
+  return(0);
+}
+
+static TS_TASK_FUNCTION_DEF(cons__idx_run_data_task__entry_point){
+  ProfBeginFunction();
+  CONS__IdxRunDataIn *in = (CONS__IdxRunDataIn*)p;
+  U32 *ptr = in->dst;
+  CONS__IdxRunNode *node = in->first;
+  for (U64 i = 0; i < in->count; i += 1, node = node->order_next){
+    MemoryCopy(ptr, node->idx_run, sizeof(*node->idx_run)*node->count);
+    ptr += node->count;
+  }
+  ProfEnd();
+  return(0);
+}
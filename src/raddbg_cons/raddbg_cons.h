@@ -87,6 +87,9 @@ typedef struct CONS_TopLevelInfo{
   String8 exe_name;
   U64 exe_hash;
   U64 voff_max;
+  // (written to the header, not the top level info section)
+  U8 dbg_guid[16];
+  U32 dbg_age;
 } CONS_TopLevelInfo;
 
 static void cons_set_top_level_info(CONS_Root *root, CONS_TopLevelInfo *tli);
@@ -255,6 +258,45 @@ static void cons_bytecode_push_sconst(Arena *arena, CONS_EvalBytecode *bytecode,
 static void cons_bytecode_concat_in_place(CONS_EvalBytecode *left_dst,
                                           CONS_EvalBytecode *right_destroyed);
 
+
+//- progress reporting
+
+// NOTE: converters call the hook from whichever thread finished the work -
+// possibly several at once - so implementations must be thread safe. counts
+// are cumulative.
+#define CONS_PROGRESS_FUNCTION_DEF(name) void name(void *user, U64 bytes_processed, U64 bytes_total, U64 units_processed, U64 units_total)
+typedef CONS_PROGRESS_FUNCTION_DEF(CONS_ProgressFunctionType);
+
+typedef struct CONS_Progress{
+  CONS_ProgressFunctionType *func;
+  void *user;
+  U64 bytes_total;
+  U64 units_total;
+  U64 bytes_processed;
+  U64 units_processed;
+} CONS_Progress;
+
+static void cons_progress_advance(CONS_Progress *progress, U64 bytes, U64 units);
+static void cons_progress_finish(CONS_Progress *progress);
+
+
+//- publics-only roots
+
+// NOTE: for the cheap first tier a converter builds from a symbol table
+// alone. publics are sorted in place; each one is cut where the next public
+// inside its range begins. functions become procedures with a root scope so
+// they land in the procedure vmap - functions sharing a voff keep only their
+// first name - everything else becomes a global variable. top level info &
+// binary sections are left to the caller.
+typedef struct CONS_Public{
+  String8 name;
+  U64 voff;
+  U64 voff_opl;
+  B32 is_function;
+} CONS_Public;
+
+static CONS_Root* cons_root_new_from_publics(U64 addr_size, CONS_Public *publics, U64 public_count);
+
 ////////////////////////////////
 //- Concrete Types & Implementation Helpers
 
@@ -487,6 +529,7 @@ typedef struct CONS__NameMap{
   CONS__NameMapNode *first;
   CONS__NameMapNode *last;
   U64 name_count;
+  RADDBG_NameMapKind kind;
 } CONS__NameMap;
 
 static CONS__NameMap* cons__name_map_for_kind(CONS_Root *root, RADDBG_NameMapKind kind);
@@ -754,6 +797,8 @@ typedef struct CONS__OrderedRange{
 
 static CONS__SortKey* cons__sort_key_array(Arena *arena, CONS__SortKey *keys, U64 count);
 
+static int cons__qsort_compare_public(CONS_Public *a, CONS_Public *b);
+
 
 //- cons serializer for unit line info
 typedef struct CONS__LineRec{
@@ -770,8 +815,9 @@ typedef struct CONS__UnitLinesCombined{
   U32 line_count;
 } CONS__UnitLinesCombined;
 
-static CONS__UnitLinesCombined* cons__unit_combine_lines(Arena *arena, CONS__BakeCtx *bctx,
-                                                         CONS_LineSequenceNode *first);
+static U32* cons__unit_line_file_ids(Arena *arena, CONS__BakeCtx *bctx, CONS_LineSequenceNode *first);
+static CONS__UnitLinesCombined* cons__unit_combine_lines(Arena *arena, CONS_LineSequenceNode *first,
+                                                         U32 *seq_file_ids);
 
 //- cons serializer for source line info
 typedef struct CONS__SrcLinesCombined{
@@ -843,22 +889,25 @@ typedef struct CONS__SymbolData{
   RADDBG_GlobalVariable *global_variables;
   U32 global_variable_count;
   
-  CONS__VMap *global_vmap;
-  
   RADDBG_ThreadVariable *thread_variables;
   U32 thread_variable_count;
   
   RADDBG_Procedure *procedures;
   U32 procedure_count;
-  
+} CONS__SymbolData;
+
+static CONS__SymbolData* cons__symbol_data_combine(Arena *arena, CONS_Root *root, CONS__BakeCtx *bctx);
+
+static CONS__VMap* cons__vmap_from_global_symbols(Arena *arena, CONS_Root *root);
+
+//- cons serializer for scopes
+typedef struct CONS__ScopeData{
   RADDBG_Scope *scopes;
   U32 scope_count;
   
   U64 *scope_voffs;
   U32 scope_voff_count;
   
-  CONS__VMap *scope_vmap;
-  
   RADDBG_Local *locals;
   U32 local_count;
   
@@ -868,9 +917,13 @@ typedef struct CONS__SymbolData{
   void *location_data;
   U32 location_data_size;
   
-} CONS__SymbolData;
+} CONS__ScopeData;
 
-static CONS__SymbolData* cons__symbol_data_combine(Arena *arena, CONS_Root *root, CONS__BakeCtx *bctx);
+static CONS__ScopeData* cons__scope_data_combine(Arena *arena, CONS_Root *root);
+static void             cons__scope_data_bake_local_names(CONS_Root *root, CONS__BakeCtx *bctx,
+                                                          CONS__ScopeData *scope_data);
+
+static CONS__VMap* cons__vmap_from_scopes(Arena *arena, CONS_Root *root);
 
 //- cons serializer for name maps
 typedef struct CONS__NameMapSemiNode{
@@ -884,6 +937,29 @@ typedef struct CONS__NameMapSemiBucket{
   U64 count;
 } CONS__NameMapSemiBucket;
 
+typedef struct CONS__NameMapSortEntry{
+  String8 string;
+  U32 node_idx;
+  U32 off;
+} CONS__NameMapSortEntry;
+
+typedef struct CONS__NameMapLayout{
+  CONS__NameMapSemiBucket *sbuckets;
+  U32 bucket_count;
+  
+  // prefix & substring index (node indexes follow the bucket layout order)
+  U32 *sorted_nodes;
+  U32 node_count;
+  RADDBG_NameMapSuffix *suffixes;
+  U64 suffix_count;
+  
+  // trigram index (symbol & type maps only)
+  RADDBG_NameMapTrigram *trigrams;
+  U32 trigram_count;
+  U32 *trigram_postings;
+  U64 trigram_posting_count;
+} CONS__NameMapLayout;
+
 typedef struct CONS__NameMapBaked{
   RADDBG_NameMapBucket *buckets;
   RADDBG_NameMapNode *nodes;
@@ -891,6 +967,50 @@ typedef struct CONS__NameMapBaked{
   U32 node_count;
 } CONS__NameMapBaked;
 
-static CONS__NameMapBaked* cons__name_map_bake(Arena *arena, CONS_Root *root, CONS__BakeCtx *bctx, CONS__NameMap *map);
+static int                  cons__qsort_compare_name_map_sort_entry(CONS__NameMapSortEntry *a,
+                                                                    CONS__NameMapSortEntry *b);
+static CONS__NameMapLayout* cons__name_map_layout(Arena *arena, CONS__NameMap *map);
+static CONS__NameMapBaked*  cons__name_map_bake(Arena *arena, CONS__BakeCtx *bctx, CONS__NameMapLayout *layout);
+
+//- cons parallel bake tasks
+// only the work that does not touch the bake context runs in
+// tasks; string, index run, and path interning stay on the baking thread and
+// happen in a fixed order, so the baked file is identical for any thread count.
+typedef struct CONS__UnitLinesIn{
+  CONS_LineSequenceNode **first_seqs;
+  U32 **seq_file_ids;
+  U64 unit_idx_first;
+  U64 unit_idx_opl;
+  CONS__UnitLinesCombined **lines_out;
+} CONS__UnitLinesIn;
+
+typedef struct CONS__SrcLinesIn{
+  CONS__SrcNode **src_nodes;
+  U64 src_idx_first;
+  U64 src_idx_opl;
+  CONS__SrcLinesCombined **lines_out;
+} CONS__SrcLinesIn;
+
+typedef struct CONS__StringDataIn{
+  CONS__StringNode *first;
+  U64 count;
+  U8 *dst;
+} CONS__StringDataIn;
+
+typedef struct CONS__IdxRunDataIn{
+  CONS__IdxRunNode *first;
+  U64 count;
+  U32 *dst;
+} CONS__IdxRunDataIn;
+
+static TS_TASK_FUNCTION_DEF(cons__unit_lines_task__entry_point);
+static TS_TASK_FUNCTION_DEF(cons__src_lines_task__entry_point);
+static TS_TASK_FUNCTION_DEF(cons__unit_vmap_task__entry_point);
+static TS_TASK_FUNCTION_DEF(cons__global_vmap_task__entry_point);
+static TS_TASK_FUNCTION_DEF(cons__scope_vmap_task__entry_point);
+static TS_TASK_FUNCTION_DEF(cons__scope_data_task__entry_point);
+static TS_TASK_FUNCTION_DEF(cons__name_map_layout_task__entry_point);
+static TS_TASK_FUNCTION_DEF(cons__string_data_task__entry_point);
+static TS_TASK_FUNCTION_DEF(cons__idx_run_data_task__entry_point);
 
 #endif //RADDBG_CONS_H
@@ -25,20 +25,12 @@ dwarf_leb128_decode_U64(U8 *ptr, U8 *opl){
 
 static S64
 dwarf_leb128_decode_S64(U8 *ptr, U8 *opl){
-  U64 u = dwarf_leb128_decode_U32(ptr, opl);
+  U64 u = dwarf_leb128_decode_U64(ptr, opl);
   U64 s = (U64)(opl - ptr)*7;
-  B32 neg = ((u & (1llu << s)) != 0);
-  if (neg){
-    switch (opl - ptr){
-      case 9: u |= ~0x7FFFFFFFFFFFFFFFllu; break;
-      case 8: u |= ~0x00FFFFFFFFFFFFFFllu; break;
-      case 7: u |= ~  0x01FFFFFFFFFFFFllu; break;
-      case 6: u |= ~    0x03FFFFFFFFFFllu; break;
-      case 5: u |= ~      0x07FFFFFFFFllu; break;
-      case 4: u |= ~        0x0FFFFFFFllu; break;
-      case 3: u |= ~          0x1FFFFFllu; break;
-      case 2: u |= ~            0x3FFFllu; break;
-      case 1: u |= ~              0x7Fllu; break;
+  if (0 < s && s < 64){
+    B32 neg = ((u & (1llu << (s - 1))) != 0);
+    if (neg){
+      u |= (~0llu << s);
     }
   }
   S64 r = (S64)(u);
@@ -722,7 +714,9 @@ dwarf_line_from_data(Arena *arena, String8 data){
           file_name_entry_format = push_array(arena, DWARF_V5LinePathEntryFormat,
                                               file_name_entry_format_count);
           DWARF_V5LinePathEntryFormat *entry = file_name_entry_format;
-          for (;ptr < header_opl; entry += 1){
+          DWARF_V5LinePathEntryFormat *entry_opl =
+            file_name_entry_format + file_name_entry_format_count;
+          for (;entry < entry_opl && ptr < header_opl; entry += 1){
             DWARF_LEB128_DECODE_ADV(U64, entry->content_type, ptr, header_opl);
             DWARF_LEB128_DECODE_ADV(U64, entry->form, ptr, header_opl);
           }
@@ -734,7 +728,7 @@ dwarf_line_from_data(Arena *arena, String8 data){
         // file_names
         DWARF_V5Directory *file_names = push_array(arena, DWARF_V5Directory, file_names_count);
         dwarf__line_v5_directories(address_size, offset_size,
-                                   directory_entry_format, directory_entry_format_count,
+                                   file_name_entry_format, file_name_entry_format_count,
                                    file_names, file_names_count,
                                    &ptr, header_opl);
       }break;
@@ -782,9 +776,104 @@ dwarf_macro_from_data(Arena *arena, String8 data){
 }
 
 static DWARF_FrameParsed*
-dwarf_frame_from_data(Arena *arena, String8 data){
-  DWARF_FrameParsed *result = 0;
-  // TODO(allen): 
+dwarf_frame_from_data(Arena *arena, String8 data, U64 data_vaddr,
+                      U64 address_size, B32 is_eh_frame){
+  // supported version numbers: 1,3,4
+  
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  // row list
+  DWARF_CFARowList rows = {0};
+  
+  // whole section loop
+  U8 *ptr = data.str;
+  U8 *opl = data.str + data.size;
+  for (;ptr < opl;){
+    
+    // initial length (a zero length ends .eh_frame)
+    U8 *entry_opl = 0;
+    B32 is_64bit = 0;
+    dwarf__initial_length(data, &ptr, &entry_opl, &is_64bit);
+    if (entry_opl == ptr){
+      break;
+    }
+    
+    // CIE id or CIE pointer
+    U64 id_off = (ptr - data.str);
+    U64 id = 0;
+    if (is_64bit){
+      id = MemoryConsume(U64, ptr, entry_opl);
+    }
+    else{
+      id = MemoryConsume(U32, ptr, entry_opl);
+    }
+    
+    // in .debug_frame a FDE points at its CIE with a section offset;
+    // in .eh_frame it points backwards, relative to the pointer itself
+    B32 is_fde = 0;
+    U64 cie_off = 0;
+    if (is_eh_frame){
+      is_fde = (id != 0 && id <= id_off);
+      cie_off = id_off - id;
+    }
+    else{
+      is_fde = (id != (is_64bit?max_U64:max_U32));
+      cie_off = id;
+    }
+    
+    // FDE
+    DWARF_CIEParsed cie = {0};
+    if (is_fde && dwarf__cie_from_data(data, cie_off, address_size, is_eh_frame, &cie)){
+      B32 good = ((cie.addr_encoding & DWARF_EhPtrEnc_Indirect) == 0);
+      
+      // address range
+      U64 field_vaddr = data_vaddr + (ptr - data.str);
+      U64 vaddr_first = dwarf__eh_ptr_decode(cie.addr_encoding, cie.address_size, field_vaddr,
+                                             &ptr, entry_opl, &good);
+      U64 vaddr_size = dwarf__eh_ptr_decode(cie.addr_encoding & DWARF_EhPtrEnc_TypeMask,
+                                            cie.address_size, 0, &ptr, entry_opl, &good);
+      
+      // augmentation data
+      if (cie.has_augmentation_data){
+        U64 aug_size = 0;
+        DWARF_LEB128_DECODE_ADV(U64, aug_size, ptr, entry_opl);
+        ptr += ClampTop(aug_size, (U64)(entry_opl - ptr));
+      }
+      
+      // initial instructions then the FDE's own instructions
+      if (good && vaddr_size > 0){
+        DWARF_CFAState state = {0};
+        if (dwarf__cfa_program_run(0, &cie, data, data_vaddr, cie.insts_first, cie.insts_opl,
+                                   0, 0, &state, 0)){
+          dwarf__cfa_program_run(scratch.arena, &cie, data, data_vaddr, ptr, entry_opl,
+                                 vaddr_first, vaddr_first + vaddr_size, &state, &rows);
+        }
+      }
+    }
+    
+    // advance to next entry
+    ptr = entry_opl;
+  }
+  
+  // flatten & sort rows
+  DWARF_CFARow *row_array = push_array_no_zero(arena, DWARF_CFARow, rows.count);
+  {
+    DWARF_CFARow *row_ptr = row_array;
+    for (DWARF_CFARowNode *node = rows.first;
+         node != 0;
+         node = node->next, row_ptr += 1){
+      *row_ptr = node->row;
+    }
+  }
+  qsort(row_array, rows.count, sizeof(*row_array),
+        (int (*)(const void *, const void *))dwarf__qsort_compare_cfa_row);
+  
+  scratch_end(scratch);
+  
+  // fill result
+  DWARF_FrameParsed *result = push_array(arena, DWARF_FrameParsed, 1);
+  result->rows = row_array;
+  result->row_count = rows.count;
   return(result);
 }
 
@@ -927,7 +1016,7 @@ dwarf__line_v5_directories(U64 address_size, U64 offset_size,
   DWARF_V5Directory *directory_ptr = directories_out;
   for (U32 i = 0; i < dir_count; i += 1, directory_ptr += 1){
     DWARF_V5LinePathEntryFormat *fmt = format;
-    for (U32 j = 0; j < format_count; j += 1){
+    for (U32 j = 0; j < format_count; j += 1, fmt += 1){
       
       // form decode
       DWARF_FormDecodeRules rules =
@@ -990,6 +1079,392 @@ dwarf__line_v5_directories(U64 address_size, U64 offset_size,
   *ptr_io = ptr;
 }
 
+static U64
+dwarf__eh_ptr_decode(DWARF_EhPtrEnc enc, U64 address_size, U64 field_vaddr,
+                     U8 **ptr_io, U8 *opl, B32 *good_io){
+  U8 *ptr = *ptr_io;
+  
+  // value
+  U64 result = 0;
+  switch (enc & DWARF_EhPtrEnc_TypeMask){
+    default:
+    {
+      *good_io = 0;
+    }break;
+    
+    case DWARF_EhPtrEnc_Absptr:
+    {
+      if (address_size == 8){
+        result = MemoryConsume(U64, ptr, opl);
+      }
+      else if (address_size == 4){
+        result = MemoryConsume(U32, ptr, opl);
+      }
+      else{
+        *good_io = 0;
+      }
+    }break;
+    
+    case DWARF_EhPtrEnc_Uleb128:
+    {
+      DWARF_LEB128_DECODE_ADV(U64, result, ptr, opl);
+    }break;
+    case DWARF_EhPtrEnc_Udata2: result = MemoryConsume(U16, ptr, opl); break;
+    case DWARF_EhPtrEnc_Udata4: result = MemoryConsume(U32, ptr, opl); break;
+    case DWARF_EhPtrEnc_Udata8: result = MemoryConsume(U64, ptr, opl); break;
+    
+    case DWARF_EhPtrEnc_Sleb128:
+    {
+      S64 x = 0;
+      DWARF_LEB128_DECODE_ADV(S64, x, ptr, opl);
+      result = (U64)x;
+    }break;
+    case DWARF_EhPtrEnc_Sdata2: result = (U64)(S64)(S16)MemoryConsume(U16, ptr, opl); break;
+    case DWARF_EhPtrEnc_Sdata4: result = (U64)(S64)(S32)MemoryConsume(U32, ptr, opl); break;
+    case DWARF_EhPtrEnc_Sdata8: result = MemoryConsume(U64, ptr, opl); break;
+  }
+  
+  // base (only pc relative pointers show up in the fields read here)
+  switch (enc & DWARF_EhPtrEnc_ModMask){
+    case 0: break;
+    case DWARF_EhPtrEnc_Pcrel: result += field_vaddr; break;
+    default: *good_io = 0; break;
+  }
+  
+  *ptr_io = ptr;
+  return(result);
+}
+
+static B32
+dwarf__cie_from_data(String8 data, U64 cie_off, U64 address_size, B32 is_eh_frame,
+                     DWARF_CIEParsed *cie_out){
+  B32 result = 0;
+  
+  DWARF_CIEParsed cie = {0};
+  cie.address_size = address_size;
+  cie.addr_encoding = DWARF_EhPtrEnc_Absptr;
+  
+  if (cie_off < data.size){
+    U8 *ptr = data.str + cie_off;
+    
+    // initial length
+    U8 *cie_opl = 0;
+    B32 is_64bit = 0;
+    dwarf__initial_length(data, &ptr, &cie_opl, &is_64bit);
+    
+    // CIE id
+    U64 id = 0;
+    B32 is_cie = 0;
+    if (is_64bit){
+      id = MemoryConsume(U64, ptr, cie_opl);
+      is_cie = (id == (is_eh_frame?0:max_U64));
+    }
+    else{
+      id = MemoryConsume(U32, ptr, cie_opl);
+      is_cie = (id == (is_eh_frame?0:max_U32));
+    }
+    
+    if (is_cie && ptr < cie_opl){
+      // version
+      U8 version = MemoryConsume(U8, ptr, cie_opl);
+      
+      // augmentation
+      String8 augmentation = str8_cstring_capped((char*)ptr, (char*)cie_opl);
+      ptr += ClampTop(augmentation.size + 1, (U64)(cie_opl - ptr));
+      
+      // address size & segment selector size
+      if (version >= 4){
+        cie.address_size = MemoryConsume(U8, ptr, cie_opl);
+        MemoryConsume(U8, ptr, cie_opl);
+      }
+      
+      // alignment factors
+      DWARF_LEB128_DECODE_ADV(U64, cie.code_align, ptr, cie_opl);
+      DWARF_LEB128_DECODE_ADV(S64, cie.data_align, ptr, cie_opl);
+      
+      // return address register
+      if (version == 1){
+        MemoryConsume(U8, ptr, cie_opl);
+      }
+      else{
+        U64 ret_addr_reg = 0;
+        DWARF_LEB128_DECODE_ADV(U64, ret_addr_reg, ptr, cie_opl);
+      }
+      
+      // augmentation data; only the 'z' form says how to skip what we don't use
+      B32 good = 1;
+      if (augmentation.size > 0){
+        if (augmentation.str[0] != 'z'){
+          good = 0;
+        }
+        else{
+          cie.has_augmentation_data = 1;
+          U64 aug_size = 0;
+          DWARF_LEB128_DECODE_ADV(U64, aug_size, ptr, cie_opl);
+          U8 *aug_opl = ptr + ClampTop(aug_size, (U64)(cie_opl - ptr));
+          for (U64 i = 1; i < augmentation.size && good; i += 1){
+            switch (augmentation.str[i]){
+              default:
+              {
+                good = 0;
+              }break;
+              
+              case 'L':
+              {
+                MemoryConsume(U8, ptr, aug_opl);
+              }break;
+              
+              case 'P':
+              {
+                U8 enc = MemoryConsume(U8, ptr, aug_opl);
+                B32 ignore = 1;
+                dwarf__eh_ptr_decode(enc, cie.address_size, 0, &ptr, aug_opl, &ignore);
+              }break;
+              
+              case 'R':
+              {
+                cie.addr_encoding = MemoryConsume(U8, ptr, aug_opl);
+              }break;
+              
+              case 'S': case 'B': break;
+            }
+          }
+          ptr = aug_opl;
+        }
+      }
+      
+      // initial instructions
+      if (good){
+        cie.insts_first = ptr;
+        cie.insts_opl = cie_opl;
+        result = 1;
+      }
+    }
+  }
+  
+  *cie_out = cie;
+  return(result);
+}
+
+static B32
+dwarf__cfa_program_run(Arena *arena, DWARF_CIEParsed *cie,
+                       String8 data, U64 data_vaddr, U8 *ptr, U8 *opl,
+                       U64 vaddr_first, U64 vaddr_opl,
+                       DWARF_CFAState *state_io, DWARF_CFARowList *rows_out){
+  DWARF_CFAState state = *state_io;
+  
+  // remember/restore stack
+  DWARF_CFAState stack[16];
+  U64 stack_count = 0;
+  
+  B32 good = 1;
+  U64 loc = vaddr_first;
+  for (;good && ptr < opl;){
+    U8 insn = MemoryConsume(U8, ptr, opl);
+    U8 insn_hi = (insn & 0xC0);
+    U8 insn_lo = (insn & 0x3F);
+    
+    U64 next_loc = loc;
+    switch (insn_hi){
+      case DWARF_CallFrameInsn_advance_loc:
+      {
+        next_loc = loc + insn_lo*cie->code_align;
+      }break;
+      
+      // register rules aren't tracked
+      case DWARF_CallFrameInsn_offset:
+      {
+        U64 off = 0;
+        DWARF_LEB128_DECODE_ADV(U64, off, ptr, opl);
+      }break;
+      case DWARF_CallFrameInsn_restore: break;
+      
+      case 0:
+      switch (insn){
+        default:
+        {
+          good = 0;
+        }break;
+        
+        case DWARF_CallFrameInsn_nop: break;
+        
+        // location
+        case DWARF_CallFrameInsn_set_loc:
+        {
+          U64 field_vaddr = data_vaddr + (ptr - data.str);
+          next_loc = dwarf__eh_ptr_decode(cie->addr_encoding, cie->address_size, field_vaddr,
+                                          &ptr, opl, &good);
+        }break;
+        case DWARF_CallFrameInsn_advance_loc1:
+        {
+          next_loc = loc + MemoryConsume(U8, ptr, opl)*cie->code_align;
+        }break;
+        case DWARF_CallFrameInsn_advance_loc2:
+        {
+          next_loc = loc + MemoryConsume(U16, ptr, opl)*cie->code_align;
+        }break;
+        case DWARF_CallFrameInsn_advance_loc4:
+        {
+          next_loc = loc + MemoryConsume(U32, ptr, opl)*cie->code_align;
+        }break;
+        
+        // CFA rule
+        case DWARF_CallFrameInsn_def_cfa:
+        {
+          U64 reg = 0;
+          U64 off = 0;
+          DWARF_LEB128_DECODE_ADV(U64, reg, ptr, opl);
+          DWARF_LEB128_DECODE_ADV(U64, off, ptr, opl);
+          state.reg = reg;
+          state.off = (S64)off;
+          state.is_expr = 0;
+        }break;
+        case DWARF_CallFrameInsn_def_cfa_sf:
+        {
+          U64 reg = 0;
+          S64 off = 0;
+          DWARF_LEB128_DECODE_ADV(U64, reg, ptr, opl);
+          DWARF_LEB128_DECODE_ADV(S64, off, ptr, opl);
+          state.reg = reg;
+          state.off = off*cie->data_align;
+          state.is_expr = 0;
+        }break;
+        case DWARF_CallFrameInsn_def_cfa_register:
+        {
+          U64 reg = 0;
+          DWARF_LEB128_DECODE_ADV(U64, reg, ptr, opl);
+          state.reg = reg;
+        }break;
+        case DWARF_CallFrameInsn_def_cfa_offset:
+        {
+          U64 off = 0;
+          DWARF_LEB128_DECODE_ADV(U64, off, ptr, opl);
+          state.off = (S64)off;
+        }break;
+        case DWARF_CallFrameInsn_def_cfa_offset_sf:
+        {
+          S64 off = 0;
+          DWARF_LEB128_DECODE_ADV(S64, off, ptr, opl);
+          state.off = off*cie->data_align;
+        }break;
+        case DWARF_CallFrameInsn_def_cfa_expression:
+        {
+          U64 size = 0;
+          DWARF_LEB128_DECODE_ADV(U64, size, ptr, opl);
+          ptr += ClampTop(size, (U64)(opl - ptr));
+          state.is_expr = 1;
+        }break;
+        
+        // state stack
+        case DWARF_CallFrameInsn_remember_state:
+        {
+          if (stack_count < ArrayCount(stack)){
+            stack[stack_count] = state;
+            stack_count += 1;
+          }
+          else{
+            good = 0;
+          }
+        }break;
+        case DWARF_CallFrameInsn_restore_state:
+        {
+          if (stack_count > 0){
+            stack_count -= 1;
+            state = stack[stack_count];
+          }
+          else{
+            good = 0;
+          }
+        }break;
+        
+        // register rules aren't tracked; skip operands
+        case DWARF_CallFrameInsn_offset_extended:
+        case DWARF_CallFrameInsn_offset_extended_sf:
+        case DWARF_CallFrameInsn_register:
+        case DWARF_CallFrameInsn_val_offset:
+        case DWARF_CallFrameInsn_val_offset_sf:
+        case DWARF_CallFrameInsn_GNU_negative_offset_extended:
+        {
+          U64 x = 0;
+          DWARF_LEB128_DECODE_ADV(U64, x, ptr, opl);
+          DWARF_LEB128_DECODE_ADV(U64, x, ptr, opl);
+        }break;
+        case DWARF_CallFrameInsn_restore_extended:
+        case DWARF_CallFrameInsn_undefined:
+        case DWARF_CallFrameInsn_same_value:
+        case DWARF_CallFrameInsn_GNU_args_size:
+        {
+          U64 x = 0;
+          DWARF_LEB128_DECODE_ADV(U64, x, ptr, opl);
+        }break;
+        case DWARF_CallFrameInsn_expression:
+        case DWARF_CallFrameInsn_val_expression:
+        {
+          U64 reg = 0;
+          U64 size = 0;
+          DWARF_LEB128_DECODE_ADV(U64, reg, ptr, opl);
+          DWARF_LEB128_DECODE_ADV(U64, size, ptr, opl);
+          ptr += ClampTop(size, (U64)(opl - ptr));
+        }break;
+      }break;
+    }
+    
+    // emit the row that ends here
+    if (next_loc != loc){
+      if (next_loc < loc){
+        good = 0;
+      }
+      else{
+        dwarf__cfa_row_list_push(arena, rows_out, loc, ClampTop(next_loc, vaddr_opl), &state);
+        loc = next_loc;
+      }
+    }
+  }
+  
+  // the last row runs to the end of the range
+  if (good){
+    dwarf__cfa_row_list_push(arena, rows_out, loc, vaddr_opl, &state);
+  }
+  
+  *state_io = state;
+  return(good);
+}
+
+static void
+dwarf__cfa_row_list_push(Arena *arena, DWARF_CFARowList *list,
+                         U64 vaddr_first, U64 vaddr_opl, DWARF_CFAState *state){
+  if (list != 0 && vaddr_first < vaddr_opl){
+    DWARF_CFARowNode *last = list->last;
+    if (last != 0 && last->row.vaddr_opl == vaddr_first &&
+        last->row.reg == state->reg && last->row.off == state->off &&
+        last->row.is_expr == state->is_expr){
+      last->row.vaddr_opl = vaddr_opl;
+    }
+    else{
+      DWARF_CFARowNode *node = push_array(arena, DWARF_CFARowNode, 1);
+      SLLQueuePush(list->first, list->last, node);
+      list->count += 1;
+      node->row.vaddr_first = vaddr_first;
+      node->row.vaddr_opl = vaddr_opl;
+      node->row.reg = state->reg;
+      node->row.off = state->off;
+      node->row.is_expr = state->is_expr;
+    }
+  }
+}
+
+static int
+dwarf__qsort_compare_cfa_row(DWARF_CFARow *a, DWARF_CFARow *b){
+  int result = 0;
+  if (a->vaddr_first < b->vaddr_first){
+    result = -1;
+  }
+  else if (a->vaddr_first > b->vaddr_first){
+    result = +1;
+  }
+  return(result);
+}
+
 
 // debug sections
 
@@ -1024,14 +1499,124 @@ dwarf_abbrev_unit_from_offset(DWARF_AbbrevParsed *abbrev, U64 offset){
 static DWARF_AbbrevDecl*
 dwarf_abbrev_decl_from_code(DWARF_AbbrevUnit *unit, U32 abbrev_code){
   DWARF_AbbrevDecl *result = 0;
-  for (DWARF_AbbrevDecl *decl = unit->first;
-       decl != 0;
-       decl = decl->next){
-    if (decl->abbrev_code == abbrev_code){
-      result = decl;
+  if (abbrev_code < unit->decl_table_count){
+    result = unit->decl_table[abbrev_code];
+  }
+  else{
+    for (DWARF_AbbrevDecl *decl = unit->first;
+         decl != 0;
+         decl = decl->next){
+      if (decl->abbrev_code == abbrev_code){
+        result = decl;
+        break;
+      }
+    }
+  }
+  return(result);
+}
+
+static DWARF_AbbrevUnit*
+dwarf_abbrev_unit_from_data(Arena *arena, String8 data, U64 offset){
+  /* .debug_abbrev
+  ** Layout
+  **  List(Tag)
+  **  Tag       = { id:ULEB128, tag:ULEB128, has_children:B8, ListNullTerminated(Attribute) }
+  **  Attribute = { name:ULEB128, form:ULEB128, (val:SLEB128)? }
+  */
+  
+  DWARF_AbbrevUnit *result = push_array(arena, DWARF_AbbrevUnit, 1);
+  result->offset = offset;
+  
+  // abbrev decl loop
+  U32 max_code = 0;
+  U8 *ptr = data.str + ClampTop(offset, data.size);
+  U8 *opl = data.str + data.size;
+  for (;ptr < opl;){
+    B32 success = 1;
+    
+    // abbrev code; null abbrev code means end of unit
+    U8 *abbrev_code_ptr = ptr;
+    DWARF_LEB128_ADV(ptr, opl, success);
+    U32 abbrev_code = dwarf_leb128_decode_U32(abbrev_code_ptr, ptr);
+    if (!success || abbrev_code == 0){
       break;
     }
+    
+    // tag
+    U8 *tag_ptr = ptr;
+    DWARF_LEB128_ADV(ptr, opl, success);
+    U32 tag = dwarf_leb128_decode_U32(tag_ptr, ptr);
+    
+    // has_children
+    B8 has_children = MemoryConsume(U8, ptr, opl);
+    
+    // count attributes
+    U8 *attrib_start_ptr = ptr;
+    U32 attrib_count = 0;
+    B32 has_implicit_const = 0;
+    for (;success && ptr < opl;){
+      U64 name = 0;
+      U64 form = 0;
+      DWARF_LEB128_DECODE_ADV(U64, name, ptr, opl);
+      DWARF_LEB128_DECODE_ADV(U64, form, ptr, opl);
+      if (form == DWARF_AttributeForm_implicit_const){
+        DWARF_LEB128_ADV(ptr, opl, success);
+        has_implicit_const = 1;
+      }
+      if (name == 0 && form == 0){
+        break;
+      }
+      attrib_count += 1;
+    }
+    if (!success){
+      break;
+    }
+    
+    // build the abbreviation declaration
+    DWARF_AbbrevDecl *abbrev = push_array(arena, DWARF_AbbrevDecl, 1);
+    DWARF_AbbrevAttribSpec *attribs = push_array_no_zero(arena, DWARF_AbbrevAttribSpec, attrib_count);
+    S64 *implicit_const = 0;
+    if (has_implicit_const){
+      implicit_const = push_array(arena, S64, attrib_count);
+    }
+    
+    U8 *attrib_ptr = attrib_start_ptr;
+    for (U32 i = 0; i < attrib_count; i += 1){
+      U64 name = 0;
+      U64 form = 0;
+      DWARF_LEB128_DECODE_ADV(U64, name, attrib_ptr, opl);
+      DWARF_LEB128_DECODE_ADV(U64, form, attrib_ptr, opl);
+      attribs[i].name = (DWARF_AttributeName)name;
+      attribs[i].form = (DWARF_AttributeForm)form;
+      if (form == DWARF_AttributeForm_implicit_const){
+        S64 value = 0;
+        DWARF_LEB128_DECODE_ADV(S64, value, attrib_ptr, opl);
+        implicit_const[i] = value;
+      }
+    }
+    
+    SLLQueuePush(result->first, result->last, abbrev);
+    result->count += 1;
+    abbrev->abbrev_code = abbrev_code;
+    abbrev->tag = (DWARF_Tag)tag;
+    abbrev->has_children = has_children;
+    abbrev->attrib_count = attrib_count;
+    abbrev->attrib_specs = attribs;
+    abbrev->implicit_const = implicit_const;
+    max_code = Max(max_code, abbrev_code);
+  }
+  
+  // build the direct lookup table when the codes are reasonably dense
+  if (result->count > 0 && max_code <= result->count*4 + 64){
+    result->decl_table_count = (U64)max_code + 1;
+    result->decl_table = push_array(arena, DWARF_AbbrevDecl*, result->decl_table_count);
+    for (DWARF_AbbrevDecl *decl = result->first; decl != 0; decl = decl->next){
+      if (result->decl_table[decl->abbrev_code] == 0){
+        result->decl_table[decl->abbrev_code] = decl;
+      }
+    }
   }
+  
   return(result);
 }
 
@@ -1144,7 +1729,18 @@ dwarf_form_decode(DWARF_FormDecodeRules *rules, U8 **ptr_io, U8 *opl,
   U8 *dataptr = 0;
   
   B32 success = 1;
-  if (rules->size > 0){
+  if (rules->size > 8){
+    // data16 does not fit in val; expose it as a block
+    if (ptr + rules->size <= opl){
+      dataptr = ptr;
+      val = rules->size;
+      ptr += rules->size;
+    }
+    else{
+      success = 0;
+    }
+  }
+  else if (rules->size > 0){
     if (ptr + rules->size <= opl){
       MemoryCopy(&val, ptr, rules->size);
       ptr += rules->size;
@@ -1179,8 +1775,14 @@ dwarf_form_decode(DWARF_FormDecodeRules *rules, U8 **ptr_io, U8 *opl,
     val = 1;
   }
   if (rules->block){
-    dataptr = ptr;
-    ptr += val;
+    if (val <= (U64)(opl - ptr)){
+      dataptr = ptr;
+      ptr += val;
+    }
+    else{
+      success = 0;
+      ptr = opl;
+    }
   }
   else if (rules->null_terminated){
     dataptr = ptr;
@@ -1203,6 +1805,1161 @@ dwarf_form_decode(DWARF_FormDecodeRules *rules, U8 **ptr_io, U8 *opl,
 }
 
 
+// info entry functions
+
+typedef struct DWARF__InfoEntryChunk{
+  struct DWARF__InfoEntryChunk *next;
+  DWARF_InfoEntry *entries[256];
+  U64 count;
+} DWARF__InfoEntryChunk;
+
+static DWARF_InfoEntryTree*
+dwarf_info_entry_tree_from_unit(Arena *arena, String8 data,
+                                DWARF_InfoUnit *unit, DWARF_AbbrevUnit *abbrev){
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  // entry chunk list (entries arrive in offset order)
+  DWARF__InfoEntryChunk *chunk_first = 0;
+  DWARF__InfoEntryChunk *chunk_last = 0;
+  U64 entry_count = 0;
+  
+  DWARF_InfoEntry *root = 0;
+  DWARF_InfoEntry *parent = 0;
+  B32 decoding_error = 0;
+  
+  U8 *ptr = data.str + ClampTop(unit->base_off, data.size);
+  U8 *opl = data.str + ClampTop(unit->opl_off, data.size);
+  for (;ptr < opl;){
+    U64 info_offset = (U64)(ptr - data.str);
+    
+    // abbrev code
+    B32 success = 1;
+    U8 *code_ptr = ptr;
+    DWARF_LEB128_ADV(ptr, opl, success);
+    if (!success){
+      decoding_error = 1;
+      break;
+    }
+    U32 abbrev_code = dwarf_leb128_decode_U32(code_ptr, ptr);
+    
+    // null entry closes the current list of siblings
+    if (abbrev_code == 0){
+      if (parent == 0){
+        if (root != 0){
+          break;
+        }
+        continue;
+      }
+      parent = parent->parent;
+      if (parent == 0){
+        break;
+      }
+      continue;
+    }
+    
+    DWARF_AbbrevDecl *decl = dwarf_abbrev_decl_from_code(abbrev, abbrev_code);
+    if (decl == 0){
+      decoding_error = 1;
+      break;
+    }
+    
+    // decode attributes
+    U32 attrib_count = decl->attrib_count;
+    DWARF_InfoAttribVal *vals = push_array_no_zero(arena, DWARF_InfoAttribVal, attrib_count);
+    DWARF_AbbrevAttribSpec *spec = decl->attrib_specs;
+    for (U32 i = 0; i < attrib_count; i += 1, spec += 1){
+      DWARF_AttributeForm form = spec->form;
+      if (form == DWARF_AttributeForm_indirect){
+        U64 form_u64 = 0;
+        DWARF_LEB128_DECODE_ADV(U64, form_u64, ptr, opl);
+        form = (DWARF_AttributeForm)form_u64;
+      }
+      DWARF_FormDecodeRules rules =
+        dwarf_form_decode_rule(form, unit->address_size, unit->offset_size);
+      if (rules.x == 0){
+        success = 0;
+        break;
+      }
+      DWARF_FormDecoded decoded = dwarf_form_decode(&rules, &ptr, opl, decl, i);
+      if (decoded.error){
+        success = 0;
+        break;
+      }
+      vals[i].val = decoded.val;
+      vals[i].dataptr = decoded.dataptr;
+    }
+    if (!success){
+      decoding_error = 1;
+      break;
+    }
+    
+    // emit entry
+    DWARF_InfoEntry *entry = push_array(arena, DWARF_InfoEntry, 1);
+    entry->info_offset = info_offset;
+    entry->abbrev_decl = decl;
+    entry->attrib_vals = vals;
+    entry->parent = parent;
+    if (parent != 0){
+      if (parent->last_child == 0){
+        parent->first_child = entry;
+      }
+      else{
+        parent->last_child->next_sibling = entry;
+      }
+      parent->last_child = entry;
+      parent->child_count += 1;
+    }
+    else{
+      root = entry;
+    }
+    
+    if (chunk_last == 0 || chunk_last->count == ArrayCount(chunk_last->entries)){
+      DWARF__InfoEntryChunk *chunk = push_array_no_zero(scratch.arena, DWARF__InfoEntryChunk, 1);
+      chunk->next = 0;
+      chunk->count = 0;
+      SLLQueuePush(chunk_first, chunk_last, chunk);
+    }
+    chunk_last->entries[chunk_last->count] = entry;
+    chunk_last->count += 1;
+    entry_count += 1;
+    
+    // descend or finish
+    if (decl->has_children){
+      parent = entry;
+    }
+    else if (parent == 0){
+      break;
+    }
+  }
+  
+  // flatten entries
+  DWARF_InfoEntry **entries = push_array_no_zero(arena, DWARF_InfoEntry*, entry_count);
+  {
+    DWARF_InfoEntry **entry_ptr = entries;
+    for (DWARF__InfoEntryChunk *chunk = chunk_first; chunk != 0; chunk = chunk->next){
+      MemoryCopy(entry_ptr, chunk->entries, sizeof(*entry_ptr)*chunk->count);
+      entry_ptr += chunk->count;
+    }
+  }
+  
+  // fill result
+  DWARF_InfoEntryTree *result = push_array(arena, DWARF_InfoEntryTree, 1);
+  result->unit = unit;
+  result->root = root;
+  result->entries = entries;
+  result->entry_count = entry_count;
+  result->decoding_error = decoding_error;
+  
+  scratch_end(scratch);
+  return(result);
+}
+
+static DWARF_InfoEntry*
+dwarf_info_entry_from_offset(DWARF_InfoEntryTree *tree, U64 info_off){
+  DWARF_InfoEntry *result = 0;
+  if (tree != 0 && tree->entry_count > 0){
+    U64 first = 0;
+    U64 opl = tree->entry_count;
+    for (;first + 1 < opl;){
+      U64 mid = (first + opl)/2;
+      if (tree->entries[mid]->info_offset <= info_off){
+        first = mid;
+      }
+      else{
+        opl = mid;
+      }
+    }
+    if (tree->entries[first]->info_offset == info_off){
+      result = tree->entries[first];
+    }
+  }
+  return(result);
+}
+
+
+// attribute value functions
+
+static DWARF_UnitContext
+dwarf_unit_context_from_root(DWARF_Parsed *dwarf, DWARF_InfoUnit *unit, DWARF_InfoEntry *root){
+  DWARF_UnitContext result = {0};
+  result.dwarf = dwarf;
+  result.unit = unit;
+  if (root != 0){
+    // the bases must be read before anything that depends on them
+    result.str_offsets_base = dwarf_u64_from_attrib(&result, root, DWARF_AttributeName_str_offsets_base);
+    result.addr_base        = dwarf_u64_from_attrib(&result, root, DWARF_AttributeName_addr_base);
+    result.rnglists_base    = dwarf_u64_from_attrib(&result, root, DWARF_AttributeName_rnglists_base);
+    result.loclists_base    = dwarf_u64_from_attrib(&result, root, DWARF_AttributeName_loclists_base);
+    result.base_address     = dwarf_u64_from_attrib(&result, root, DWARF_AttributeName_low_pc);
+  }
+  return(result);
+}
+
+static U32
+dwarf_attrib_idx_from_name(DWARF_InfoEntry *entry, DWARF_AttributeName name){
+  U32 result = max_U32;
+  if (entry != 0){
+    DWARF_AbbrevDecl *decl = entry->abbrev_decl;
+    DWARF_AbbrevAttribSpec *spec = decl->attrib_specs;
+    for (U32 i = 0; i < decl->attrib_count; i += 1, spec += 1){
+      if (spec->name == name){
+        result = i;
+        break;
+      }
+    }
+  }
+  return(result);
+}
+
+static B32
+dwarf_entry_has_attrib(DWARF_InfoEntry *entry, DWARF_AttributeName name){
+  B32 result = (dwarf_attrib_idx_from_name(entry, name) != max_U32);
+  return(result);
+}
+
+static DWARF_AttributeForm
+dwarf_form_from_attrib(DWARF_InfoEntry *entry, DWARF_AttributeName name){
+  DWARF_AttributeForm result = DWARF_AttributeForm_null;
+  U32 idx = dwarf_attrib_idx_from_name(entry, name);
+  if (idx != max_U32){
+    result = entry->abbrev_decl->attrib_specs[idx].form;
+  }
+  return(result);
+}
+
+static U64
+dwarf_u64_from_attrib(DWARF_UnitContext *ctx, DWARF_InfoEntry *entry, DWARF_AttributeName name){
+  U64 result = 0;
+  U32 idx = dwarf_attrib_idx_from_name(entry, name);
+  if (idx != max_U32){
+    DWARF_AttributeForm form = entry->abbrev_decl->attrib_specs[idx].form;
+    DWARF_InfoAttribVal *val = &entry->attrib_vals[idx];
+    switch (form){
+      default:
+      {
+        if (val->dataptr == 0){
+          result = val->val;
+        }
+      }break;
+      
+      case DWARF_AttributeForm_addrx:
+      case DWARF_AttributeForm_addrx1:
+      case DWARF_AttributeForm_addrx2:
+      case DWARF_AttributeForm_addrx3:
+      case DWARF_AttributeForm_addrx4:
+      {
+        result = dwarf_address_from_idx(ctx, val->val);
+      }break;
+    }
+  }
+  return(result);
+}
+
+static S64
+dwarf_s64_from_attrib(DWARF_UnitContext *ctx, DWARF_InfoEntry *entry, DWARF_AttributeName name){
+  S64 result = 0;
+  U32 idx = dwarf_attrib_idx_from_name(entry, name);
+  if (idx != max_U32){
+    DWARF_AttributeForm form = entry->abbrev_decl->attrib_specs[idx].form;
+    U64 val = entry->attrib_vals[idx].val;
+    switch (form){
+      default:                          result = (S64)val; break;
+      case DWARF_AttributeForm_data1:   result = (S64)(S8)val; break;
+      case DWARF_AttributeForm_data2:   result = (S64)(S16)val; break;
+      case DWARF_AttributeForm_data4:   result = (S64)(S32)val; break;
+      case DWARF_AttributeForm_data16:  result = 0; break;
+    }
+  }
+  return(result);
+}
+
+static String8
+dwarf_string_from_attrib(DWARF_UnitContext *ctx, DWARF_InfoEntry *entry, DWARF_AttributeName name){
+  String8 result = {0};
+  U32 idx = dwarf_attrib_idx_from_name(entry, name);
+  if (idx != max_U32){
+    DWARF_AttributeForm form = entry->abbrev_decl->attrib_specs[idx].form;
+    DWARF_InfoAttribVal *val = &entry->attrib_vals[idx];
+    switch (form){
+      default:{}break;
+      
+      case DWARF_AttributeForm_string:
+      {
+        result = str8(val->dataptr, val->val);
+      }break;
+      
+      case DWARF_AttributeForm_strp:
+      {
+        result = dwarf_string_from_section_off(ctx->dwarf, DWARF_SectionCode_Str, val->val);
+      }break;
+      
+      case DWARF_AttributeForm_line_strp:
+      {
+        result = dwarf_string_from_section_off(ctx->dwarf, DWARF_SectionCode_LineStr, val->val);
+      }break;
+      
+      case DWARF_AttributeForm_strx:
+      case DWARF_AttributeForm_strx1:
+      case DWARF_AttributeForm_strx2:
+      case DWARF_AttributeForm_strx3:
+      case DWARF_AttributeForm_strx4:
+      {
+        result = dwarf_string_from_str_idx(ctx, val->val);
+      }break;
+    }
+  }
+  return(result);
+}
+
+static String8
+dwarf_block_from_attrib(DWARF_UnitContext *ctx, DWARF_InfoEntry *entry, DWARF_AttributeName name){
+  String8 result = {0};
+  U32 idx = dwarf_attrib_idx_from_name(entry, name);
+  if (idx != max_U32){
+    DWARF_AttributeForm form = entry->abbrev_decl->attrib_specs[idx].form;
+    DWARF_InfoAttribVal *val = &entry->attrib_vals[idx];
+    switch (form){
+      default:{}break;
+      case DWARF_AttributeForm_exprloc:
+      case DWARF_AttributeForm_block:
+      case DWARF_AttributeForm_block1:
+      case DWARF_AttributeForm_block2:
+      case DWARF_AttributeForm_block4:
+      {
+        result = str8(val->dataptr, val->val);
+      }break;
+    }
+  }
+  return(result);
+}
+
+static U64
+dwarf_ref_from_attrib(DWARF_UnitContext *ctx, DWARF_InfoEntry *entry, DWARF_AttributeName name){
+  U64 result = 0;
+  U32 idx = dwarf_attrib_idx_from_name(entry, name);
+  if (idx != max_U32){
+    DWARF_AttributeForm form = entry->abbrev_decl->attrib_specs[idx].form;
+    U64 val = entry->attrib_vals[idx].val;
+    switch (form){
+      default:{}break;
+      
+      // unit relative
+      case DWARF_AttributeForm_ref1:
+      case DWARF_AttributeForm_ref2:
+      case DWARF_AttributeForm_ref4:
+      case DWARF_AttributeForm_ref8:
+      case DWARF_AttributeForm_ref_udata:
+      {
+        result = ctx->unit->hdr_off + val;
+      }break;
+      
+      // section relative
+      case DWARF_AttributeForm_ref_addr:
+      {
+        result = val;
+      }break;
+    }
+  }
+  return(result);
+}
+
+static U64
+dwarf_address_from_idx(DWARF_UnitContext *ctx, U64 idx){
+  U64 result = 0;
+  String8 data = ctx->dwarf->debug_data[DWARF_SectionCode_Addr];
+  U64 address_size = ctx->unit->address_size;
+  U64 off = ctx->addr_base + idx*address_size;
+  if (address_size <= 8 && off + address_size <= data.size){
+    MemoryCopy(&result, data.str + off, address_size);
+  }
+  return(result);
+}
+
+static String8
+dwarf_string_from_str_idx(DWARF_UnitContext *ctx, U64 idx){
+  String8 result = {0};
+  String8 data = ctx->dwarf->debug_data[DWARF_SectionCode_StrOffsets];
+  U64 offset_size = ctx->unit->offset_size;
+  U64 off = ctx->str_offsets_base + idx*offset_size;
+  if (off + offset_size <= data.size){
+    U64 str_off = 0;
+    MemoryCopy(&str_off, data.str + off, offset_size);
+    result = dwarf_string_from_section_off(ctx->dwarf, DWARF_SectionCode_Str, str_off);
+  }
+  return(result);
+}
+
+static String8
+dwarf_string_from_section_off(DWARF_Parsed *dwarf, DWARF_SectionCode sec_code, U64 off){
+  String8 result = {0};
+  String8 data = dwarf->debug_data[sec_code];
+  if (off < data.size){
+    U8 *first = data.str + off;
+    U8 *opl = data.str + data.size;
+    U8 *ptr = first;
+    for (;ptr < opl && *ptr != 0;) ptr += 1;
+    result = str8_range(first, ptr);
+  }
+  return(result);
+}
+
+
+// range & location list functions
+
+static U64
+dwarf__list_offset_from_attrib(DWARF_UnitContext *ctx, DWARF_InfoEntry *entry,
+                               DWARF_AttributeName name, DWARF_SectionCode sec_code,
+                               U64 list_base){
+  // *listx forms index the offset table that follows the list section header
+  U64 result = 0;
+  U32 idx = dwarf_attrib_idx_from_name(entry, name);
+  if (idx != max_U32){
+    DWARF_AttributeForm form = entry->abbrev_decl->attrib_specs[idx].form;
+    U64 val = entry->attrib_vals[idx].val;
+    if (form == DWARF_AttributeForm_rnglistx || form == DWARF_AttributeForm_loclistx){
+      String8 data = ctx->dwarf->debug_data[sec_code];
+      U64 offset_size = ctx->unit->offset_size;
+      U64 off = list_base + val*offset_size;
+      U64 rel_off = 0;
+      if (off + offset_size <= data.size){
+        MemoryCopy(&rel_off, data.str + off, offset_size);
+      }
+      result = list_base + rel_off;
+    }
+    else{
+      result = val;
+    }
+  }
+  return(result);
+}
+
+static DWARF_RangeList
+dwarf_range_list_from_entry(Arena *arena, DWARF_UnitContext *ctx, DWARF_InfoEntry *entry){
+  DWARF_RangeList result = {0};
+  
+  U64 address_size = ctx->unit->address_size;
+  U64 max_address = (address_size >= 8)?max_U64:((1llu << (address_size*8)) - 1);
+  
+  // low_pc & high_pc
+  if (dwarf_entry_has_attrib(entry, DWARF_AttributeName_low_pc) &&
+      dwarf_entry_has_attrib(entry, DWARF_AttributeName_high_pc)){
+    U64 low_pc = dwarf_u64_from_attrib(ctx, entry, DWARF_AttributeName_low_pc);
+    U64 high_pc = dwarf_u64_from_attrib(ctx, entry, DWARF_AttributeName_high_pc);
+    DWARF_AttributeForm high_form = dwarf_form_from_attrib(entry, DWARF_AttributeName_high_pc);
+    DWARF_AttributeClassFlags high_class = dwarf_attribute_class_from_form(high_form);
+    if (!(high_class & DWARF_AttributeClassFlag_address)){
+      high_pc = low_pc + high_pc;
+    }
+    if (low_pc < high_pc){
+      DWARF_RangeNode *node = push_array(arena, DWARF_RangeNode, 1);
+      SLLQueuePush(result.first, result.last, node);
+      result.count += 1;
+      node->first = low_pc;
+      node->opl = high_pc;
+    }
+  }
+  
+  // ranges
+  else if (dwarf_entry_has_attrib(entry, DWARF_AttributeName_ranges)){
+    U64 base = ctx->base_address;
+    
+    // v4: .debug_ranges
+    if (ctx->unit->version < 5){
+      String8 data = ctx->dwarf->debug_data[DWARF_SectionCode_Ranges];
+      U64 off = dwarf_u64_from_attrib(ctx, entry, DWARF_AttributeName_ranges);
+      U8 *ptr = data.str + ClampTop(off, data.size);
+      U8 *opl = data.str + data.size;
+      for (;ptr + 2*address_size <= opl;){
+        U64 first = 0;
+        U64 last = 0;
+        MemoryCopy(&first, ptr, address_size);
+        MemoryCopy(&last, ptr + address_size, address_size);
+        ptr += 2*address_size;
+        if (first == 0 && last == 0){
+          break;
+        }
+        if (first == max_address){
+          base = last;
+          continue;
+        }
+        if (first < last){
+          DWARF_RangeNode *node = push_array(arena, DWARF_RangeNode, 1);
+          SLLQueuePush(result.first, result.last, node);
+          result.count += 1;
+          node->first = base + first;
+          node->opl = base + last;
+        }
+      }
+    }
+    
+    // v5: .debug_rnglists
+    else{
+      String8 data = ctx->dwarf->debug_data[DWARF_SectionCode_RngLists];
+      U64 off = dwarf__list_offset_from_attrib(ctx, entry, DWARF_AttributeName_ranges,
+                                               DWARF_SectionCode_RngLists, ctx->rnglists_base);
+      U8 *ptr = data.str + ClampTop(off, data.size);
+      U8 *opl = data.str + data.size;
+      for (B32 done = 0; !done && ptr < opl;){
+        U8 kind = MemoryConsume(U8, ptr, opl);
+        U64 first = 0;
+        U64 opl_addr = 0;
+        B32 emit = 0;
+        switch (kind){
+          default:
+          case DWARF_RangeListEntry_end_of_list:
+          {
+            done = 1;
+          }break;
+          case DWARF_RangeListEntry_base_addressx:
+          {
+            U64 idx = 0;
+            DWARF_LEB128_DECODE_ADV(U64, idx, ptr, opl);
+            base = dwarf_address_from_idx(ctx, idx);
+          }break;
+          case DWARF_RangeListEntry_startx_endx:
+          {
+            U64 idx0 = 0, idx1 = 0;
+            DWARF_LEB128_DECODE_ADV(U64, idx0, ptr, opl);
+            DWARF_LEB128_DECODE_ADV(U64, idx1, ptr, opl);
+            first = dwarf_address_from_idx(ctx, idx0);
+            opl_addr = dwarf_address_from_idx(ctx, idx1);
+            emit = 1;
+          }break;
+          case DWARF_RangeListEntry_startx_length:
+          {
+            U64 idx = 0, length = 0;
+            DWARF_LEB128_DECODE_ADV(U64, idx, ptr, opl);
+            DWARF_LEB128_DECODE_ADV(U64, length, ptr, opl);
+            first = dwarf_address_from_idx(ctx, idx);
+            opl_addr = first + length;
+            emit = 1;
+          }break;
+          case DWARF_RangeListEntry_offset_pair:
+          {
+            U64 off0 = 0, off1 = 0;
+            DWARF_LEB128_DECODE_ADV(U64, off0, ptr, opl);
+            DWARF_LEB128_DECODE_ADV(U64, off1, ptr, opl);
+            first = base + off0;
+            opl_addr = base + off1;
+            emit = 1;
+          }break;
+          case DWARF_RangeListEntry_base_address:
+          {
+            base = 0;
+            if (ptr + address_size <= opl){
+              MemoryCopy(&base, ptr, address_size);
+            }
+            ptr += address_size;
+          }break;
+          case DWARF_RangeListEntry_start_end:
+          {
+            if (ptr + 2*address_size <= opl){
+              MemoryCopy(&first, ptr, address_size);
+              MemoryCopy(&opl_addr, ptr + address_size, address_size);
+              emit = 1;
+            }
+            ptr += 2*address_size;
+          }break;
+          case DWARF_RangeListEntry_start_length:
+          {
+            U64 length = 0;
+            if (ptr + address_size <= opl){
+              MemoryCopy(&first, ptr, address_size);
+            }
+            ptr += address_size;
+            DWARF_LEB128_DECODE_ADV(U64, length, ptr, opl);
+            opl_addr = first + length;
+            emit = 1;
+          }break;
+        }
+        if (emit && first < opl_addr){
+          DWARF_RangeNode *node = push_array(arena, DWARF_RangeNode, 1);
+          SLLQueuePush(result.first, result.last, node);
+          result.count += 1;
+          node->first = first;
+          node->opl = opl_addr;
+        }
+      }
+    }
+  }
+  
+  return(result);
+}
+
+static DWARF_LocationList
+dwarf_location_list_from_attrib(Arena *arena, DWARF_UnitContext *ctx, DWARF_InfoEntry *entry,
+                                DWARF_AttributeName name){
+  DWARF_LocationList result = {0};
+  
+  U64 address_size = ctx->unit->address_size;
+  U64 max_address = (address_size >= 8)?max_U64:((1llu << (address_size*8)) - 1);
+  
+  DWARF_AttributeForm form = dwarf_form_from_attrib(entry, name);
+  switch (form){
+    default:{}break;
+    
+    // single location description, valid everywhere
+    case DWARF_AttributeForm_exprloc:
+    case DWARF_AttributeForm_block:
+    case DWARF_AttributeForm_block1:
+    case DWARF_AttributeForm_block2:
+    case DWARF_AttributeForm_block4:
+    {
+      DWARF_LocationNode *node = push_array(arena, DWARF_LocationNode, 1);
+      SLLQueuePush(result.first, result.last, node);
+      result.count += 1;
+      node->first = 0;
+      node->opl = max_U64;
+      node->expr = dwarf_block_from_attrib(ctx, entry, name);
+    }break;
+    
+    // location list
+    case DWARF_AttributeForm_data4:
+    case DWARF_AttributeForm_data8:
+    case DWARF_AttributeForm_sec_offset:
+    case DWARF_AttributeForm_loclistx:
+    {
+      U64 base = ctx->base_address;
+      
+      // v4: .debug_loc
+      if (ctx->unit->version < 5){
+        String8 data = ctx->dwarf->debug_data[DWARF_SectionCode_Loc];
+        U64 off = dwarf_u64_from_attrib(ctx, entry, name);
+        U8 *ptr = data.str + ClampTop(off, data.size);
+        U8 *opl = data.str + data.size;
+        for (;ptr + 2*address_size <= opl;){
+          U64 first = 0;
+          U64 last = 0;
+          MemoryCopy(&first, ptr, address_size);
+          MemoryCopy(&last, ptr + address_size, address_size);
+          ptr += 2*address_size;
+          if (first == 0 && last == 0){
+            break;
+          }
+          if (first == max_address){
+            base = last;
+            continue;
+          }
+          U16 expr_size = MemoryConsume(U16, ptr, opl);
+          String8 expr = str8(ptr, ClampTop(expr_size, (U64)(opl - ptr)));
+          ptr += expr.size;
+          if (first < last){
+            DWARF_LocationNode *node = push_array(arena, DWARF_LocationNode, 1);
+            SLLQueuePush(result.first, result.last, node);
+            result.count += 1;
+            node->first = base + first;
+            node->opl = base + last;
+            node->expr = expr;
+          }
+        }
+      }
+      
+      // v5: .debug_loclists
+      else{
+        String8 data = ctx->dwarf->debug_data[DWARF_SectionCode_LocLists];
+        U64 off = dwarf__list_offset_from_attrib(ctx, entry, name,
+                                                 DWARF_SectionCode_LocLists, ctx->loclists_base);
+        U8 *ptr = data.str + ClampTop(off, data.size);
+        U8 *opl = data.str + data.size;
+        for (B32 done = 0; !done && ptr < opl;){
+          U8 kind = MemoryConsume(U8, ptr, opl);
+          U64 first = 0;
+          U64 opl_addr = 0;
+          B32 has_expr = 0;
+          switch (kind){
+            default:
+            case DWARF_LocationListEntry_end_of_list:
+            {
+              done = 1;
+            }break;
+            case DWARF_LocationListEntry_base_addressx:
+            {
+              U64 idx = 0;
+              DWARF_LEB128_DECODE_ADV(U64, idx, ptr, opl);
+              base = dwarf_address_from_idx(ctx, idx);
+            }break;
+            case DWARF_LocationListEntry_startx_endx:
+            {
+              U64 idx0 = 0, idx1 = 0;
+              DWARF_LEB128_DECODE_ADV(U64, idx0, ptr, opl);
+              DWARF_LEB128_DECODE_ADV(U64, idx1, ptr, opl);
+              first = dwarf_address_from_idx(ctx, idx0);
+              opl_addr = dwarf_address_from_idx(ctx, idx1);
+              has_expr = 1;
+            }break;
+            case DWARF_LocationListEntry_startx_length:
+            {
+              U64 idx = 0, length = 0;
+              DWARF_LEB128_DECODE_ADV(U64, idx, ptr, opl);
+              DWARF_LEB128_DECODE_ADV(U64, length, ptr, opl);
+              first = dwarf_address_from_idx(ctx, idx);
+              opl_addr = first + length;
+              has_expr = 1;
+            }break;
+            case DWARF_LocationListEntry_offset_pair:
+            {
+              U64 off0 = 0, off1 = 0;
+              DWARF_LEB128_DECODE_ADV(U64, off0, ptr, opl);
+              DWARF_LEB128_DECODE_ADV(U64, off1, ptr, opl);
+              first = base + off0;
+              opl_addr = base + off1;
+              has_expr = 1;
+            }break;
+            case DWARF_LocationListEntry_default_location:
+            {
+              first = 0;
+              opl_addr = max_U64;
+              has_expr = 1;
+            }break;
+            case DWARF_LocationListEntry_base_address:
+            {
+              base = 0;
+              if (ptr + address_size <= opl){
+                MemoryCopy(&base, ptr, address_size);
+              }
+              ptr += address_size;
+            }break;
+            case DWARF_LocationListEntry_start_end:
+            {
+              if (ptr + 2*address_size <= opl){
+                MemoryCopy(&first, ptr, address_size);
+                MemoryCopy(&opl_addr, ptr + address_size, address_size);
+              }
+              ptr += 2*address_size;
+              has_expr = 1;
+            }break;
+            case DWARF_LocationListEntry_start_length:
+            {
+              U64 length = 0;
+              if (ptr + address_size <= opl){
+                MemoryCopy(&first, ptr, address_size);
+              }
+              ptr += address_size;
+              DWARF_LEB128_DECODE_ADV(U64, length, ptr, opl);
+              opl_addr = first + length;
+              has_expr = 1;
+            }break;
+          }
+          if (has_expr){
+            U64 expr_size = 0;
+            DWARF_LEB128_DECODE_ADV(U64, expr_size, ptr, opl);
+            ptr = PtrClampTop(ptr, opl);
+            String8 expr = str8(ptr, ClampTop(expr_size, (U64)(opl - ptr)));
+            ptr += expr.size;
+            if (first < opl_addr){
+              DWARF_LocationNode *node = push_array(arena, DWARF_LocationNode, 1);
+              SLLQueuePush(result.first, result.last, node);
+              result.count += 1;
+              node->first = first;
+              node->opl = opl_addr;
+              node->expr = expr;
+            }
+          }
+        }
+      }
+    }break;
+  }
+  
+  return(result);
+}
+
+
+// call frame functions
+
+static U64
+dwarf_cfa_row_idx_from_vaddr(DWARF_FrameParsed *frame, U64 vaddr){
+  // first row with vaddr_first > vaddr
+  U64 first = 0;
+  U64 opl = frame->row_count;
+  for (;first < opl;){
+    U64 mid = (first + opl)/2;
+    if (frame->rows[mid].vaddr_first <= vaddr){
+      first = mid + 1;
+    }
+    else{
+      opl = mid;
+    }
+  }
+  
+  // step back onto the row that holds vaddr
+  U64 result = first;
+  if (first > 0 && frame->rows[first - 1].vaddr_opl > vaddr){
+    result = first - 1;
+  }
+  return(result);
+}
+
+
+// line program functions
+
+typedef struct DWARF__LineRowChunk{
+  struct DWARF__LineRowChunk *next;
+  DWARF_LineRow rows[512];
+  U64 count;
+} DWARF__LineRowChunk;
+
+static String8
+dwarf__line_path_join(Arena *arena, String8 dir, String8 name){
+  String8 result = name;
+  B32 name_is_absolute = (name.size > 0 && (name.str[0] == '/' || name.str[0] == '\\' ||
+                                            (name.size > 1 && name.str[1] == ':')));
+  if (!name_is_absolute && dir.size > 0){
+    B32 dir_has_slash = (dir.str[dir.size - 1] == '/' || dir.str[dir.size - 1] == '\\');
+    result = push_str8f(arena, "%.*s%s%.*s",
+                        str8_varg(dir), dir_has_slash?"":"/", str8_varg(name));
+  }
+  return(result);
+}
+
+static String8
+dwarf__line_v5_path_from_entry(DWARF_UnitContext *ctx, DWARF_V5Directory *entry){
+  String8 result = entry->path_str;
+  if (result.size == 0){
+    switch (entry->path_sec_form){
+      default:{}break;
+      case DWARF_AttributeForm_strp:
+      {
+        result = dwarf_string_from_section_off(ctx->dwarf, DWARF_SectionCode_Str, entry->path_off);
+      }break;
+      case DWARF_AttributeForm_line_strp:
+      {
+        result = dwarf_string_from_section_off(ctx->dwarf, DWARF_SectionCode_LineStr, entry->path_off);
+      }break;
+      case DWARF_AttributeForm_strx:
+      case DWARF_AttributeForm_strx1:
+      case DWARF_AttributeForm_strx2:
+      case DWARF_AttributeForm_strx3:
+      case DWARF_AttributeForm_strx4:
+      {
+        result = dwarf_string_from_str_idx(ctx, entry->path_off);
+      }break;
+    }
+  }
+  return(result);
+}
+
+static DWARF_LineProgram*
+dwarf_line_program_from_offset(Arena *arena, DWARF_UnitContext *ctx, U64 line_off, String8 comp_dir){
+  // supported version numbers: 2, 3, 4, 5
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  DWARF_LineProgram *result = push_array(arena, DWARF_LineProgram, 1);
+  
+  String8 data = ctx->dwarf->debug_data[DWARF_SectionCode_Line];
+  if (line_off < data.size){
+    U8 *ptr = data.str + line_off;
+    
+    // initial length
+    U8 *unit_opl = 0;
+    B32 is_64bit = 0;
+    dwarf__initial_length(data, &ptr, &unit_opl, &is_64bit);
+    U64 offset_size = is_64bit?8:4;
+    
+    // version
+    U16 version = MemoryConsume(U16, ptr, unit_opl);
+    
+    // v5 address & segment sizes
+    U64 address_size = ctx->unit->address_size;
+    if (version >= 5){
+      address_size = MemoryConsume(U8, ptr, unit_opl);
+      MemoryConsume(U8, ptr, unit_opl);
+    }
+    
+    // header length
+    U64 header_length = 0;
+    if (is_64bit){
+      header_length = MemoryConsume(U64, ptr, unit_opl);
+    }
+    else{
+      header_length = MemoryConsume(U32, ptr, unit_opl);
+    }
+    U8 *program_first = PtrClampTop(ptr + header_length, unit_opl);
+    U8 *header_opl = program_first;
+    
+    // parameters
+    U8 minimum_instruction_length = MemoryConsume(U8, ptr, header_opl);
+    if (version >= 4){
+      MemoryConsume(U8, ptr, header_opl);
+    }
+    U8 default_is_stmt = MemoryConsume(U8, ptr, header_opl);
+    S8 line_base = MemoryConsume(S8, ptr, header_opl);
+    U8 line_range = MemoryConsume(U8, ptr, header_opl);
+    U8 opcode_base = MemoryConsume(U8, ptr, header_opl);
+    U8 *standard_opcode_lengths = ptr;
+    if (opcode_base > 1){
+      ptr = PtrClampTop(ptr + opcode_base - 1, header_opl);
+    }
+    (void)default_is_stmt;
+    
+    // directories & files
+    String8 *file_paths = 0;
+    U64 file_count = 0;
+    if (version < 5){
+      // directories; index zero is the compilation directory
+      String8List dirs = {0};
+      str8_list_push(scratch.arena, &dirs, comp_dir);
+      for (;ptr < header_opl && *ptr != 0;){
+        U8 *first = ptr;
+        for (;ptr < header_opl && *ptr != 0;) ptr += 1;
+        String8 dir = str8_range(first, ptr);
+        if (ptr < header_opl) ptr += 1;
+        if (dir.size > 0 && dir.str[0] != '/'){
+          dir = dwarf__line_path_join(scratch.arena, comp_dir, dir);
+        }
+        str8_list_push(scratch.arena, &dirs, dir);
+      }
+      if (ptr < header_opl) ptr += 1;
+      String8Array dir_array = str8_array_from_list(scratch.arena, &dirs);
+      
+      // files; file register values are 1-based
+      String8List files = {0};
+      str8_list_push(scratch.arena, &files, str8_lit(""));
+      for (;ptr < header_opl && *ptr != 0;){
+        U8 *first = ptr;
+        for (;ptr < header_opl && *ptr != 0;) ptr += 1;
+        String8 name = str8_range(first, ptr);
+        if (ptr < header_opl) ptr += 1;
+        U64 dir_idx = 0;
+        U64 ignore = 0;
+        DWARF_LEB128_DECODE_ADV(U64, dir_idx, ptr, header_opl);
+        DWARF_LEB128_DECODE_ADV(U64, ignore, ptr, header_opl);
+        DWARF_LEB128_DECODE_ADV(U64, ignore, ptr, header_opl);
+        String8 dir = (dir_idx < dir_array.count)?dir_array.strings[dir_idx]:str8_lit("");
+        str8_list_push(scratch.arena, &files, dwarf__line_path_join(arena, dir, name));
+      }
+      
+      file_count = files.node_count;
+      file_paths = push_array(arena, String8, file_count);
+      U64 i = 0;
+      for (String8Node *node = files.first; node != 0; node = node->next, i += 1){
+        file_paths[i] = node->string;
+      }
+    }
+    else{
+      // directories
+      U8 dir_format_count = MemoryConsume(U8, ptr, header_opl);
+      DWARF_V5LinePathEntryFormat *dir_format =
+        push_array(scratch.arena, DWARF_V5LinePathEntryFormat, dir_format_count);
+      for (U32 i = 0; i < dir_format_count; i += 1){
+        DWARF_LEB128_DECODE_ADV(U32, dir_format[i].content_type, ptr, header_opl);
+        DWARF_LEB128_DECODE_ADV(U32, dir_format[i].form, ptr, header_opl);
+      }
+      U64 dir_count = 0;
+      DWARF_LEB128_DECODE_ADV(U64, dir_count, ptr, header_opl);
+      dir_count = ClampTop(dir_count, (U64)(header_opl - ptr));
+      DWARF_V5Directory *dirs = push_array(scratch.arena, DWARF_V5Directory, dir_count);
+      dwarf__line_v5_directories(address_size, offset_size, dir_format, dir_format_count,
+                                 dirs, dir_count, &ptr, header_opl);
+      String8 *dir_paths = push_array(scratch.arena, String8, dir_count);
+      for (U64 i = 0; i < dir_count; i += 1){
+        String8 dir = dwarf__line_v5_path_from_entry(ctx, &dirs[i]);
+        if (i > 0 && dir.size > 0 && dir.str[0] != '/'){
+          dir = dwarf__line_path_join(scratch.arena, (dir_count > 0)?dir_paths[0]:comp_dir, dir);
+        }
+        dir_paths[i] = dir;
+      }
+      
+      // files; file register values are 0-based
+      U8 file_format_count = MemoryConsume(U8, ptr, header_opl);
+      DWARF_V5LinePathEntryFormat *file_format =
+        push_array(scratch.arena, DWARF_V5LinePathEntryFormat, file_format_count);
+      for (U32 i = 0; i < file_format_count; i += 1){
+        DWARF_LEB128_DECODE_ADV(U32, file_format[i].content_type, ptr, header_opl);
+        DWARF_LEB128_DECODE_ADV(U32, file_format[i].form, ptr, header_opl);
+      }
+      U64 files_count = 0;
+      DWARF_LEB128_DECODE_ADV(U64, files_count, ptr, header_opl);
+      files_count = ClampTop(files_count, (U64)(header_opl - ptr));
+      DWARF_V5Directory *files = push_array(scratch.arena, DWARF_V5Directory, files_count);
+      dwarf__line_v5_directories(address_size, offset_size, file_format, file_format_count,
+                                 files, files_count, &ptr, header_opl);
+      
+      file_count = files_count;
+      file_paths = push_array(arena, String8, file_count);
+      for (U64 i = 0; i < files_count; i += 1){
+        String8 name = dwarf__line_v5_path_from_entry(ctx, &files[i]);
+        U64 dir_idx = files[i].directory_index;
+        String8 dir = (dir_idx < dir_count)?dir_paths[dir_idx]:comp_dir;
+        file_paths[i] = dwarf__line_path_join(arena, dir, name);
+      }
+    }
+    
+    // line number program
+    //  (DWARF4.pdf + 6.2.5) (DWARF5.pdf + 6.2.5)
+    ptr = program_first;
+    U8 *opl = unit_opl;
+    
+    DWARF__LineRowChunk *chunk_first = 0;
+    DWARF__LineRowChunk *chunk_last = 0;
+    U64 row_count = 0;
+    
+    U64 address = 0;
+    U32 file_idx = 1;
+    U32 line = 1;
+    U32 column = 0;
+    B32 end_sequence = 0;
+    B32 decoding_error = 0;
+    
+    for (;ptr < opl && !decoding_error;){
+      B32 emit_row = 0;
+      U8 opcode = *ptr;
+      ptr += 1;
+      
+      // special opcodes
+      if (opcode >= opcode_base){
+        if (line_range == 0){
+          decoding_error = 1;
+          break;
+        }
+        U8 adjusted = opcode - opcode_base;
+        address += (adjusted/line_range)*minimum_instruction_length;
+        line += line_base + (adjusted%line_range);
+        emit_row = 1;
+      }
+      
+      // extended opcodes
+      else if (opcode == 0){
+        U64 length = 0;
+        DWARF_LEB128_DECODE_ADV(U64, length, ptr, opl);
+        U8 *ext_opl = PtrClampTop(ptr + length, opl);
+        if (length == 0 || ptr >= ext_opl){
+          ptr = ext_opl;
+          continue;
+        }
+        U8 ext_opcode = *ptr;
+        ptr += 1;
+        switch (ext_opcode){
+          default:{}break;
+          case DWARF_LineExtOp_end_sequence:
+          {
+            end_sequence = 1;
+            emit_row = 1;
+          }break;
+          case DWARF_LineExtOp_set_address:
+          {
+            address = 0;
+            U64 size = ClampTop((U64)(ext_opl - ptr), 8);
+            MemoryCopy(&address, ptr, size);
+          }break;
+        }
+        ptr = ext_opl;
+      }
+      
+      // standard opcodes
+      else{
+        switch (opcode){
+          default:
+          {
+            // skip unknown standard opcodes by their declared operand count
+            U8 arg_count = (opcode - 1 < (U8)(header_opl - standard_opcode_lengths))?
+              standard_opcode_lengths[opcode - 1]:0;
+            for (U8 i = 0; i < arg_count; i += 1){
+              B32 success = 1;
+              DWARF_LEB128_ADV(ptr, opl, success);
+            }
+          }break;
+          case DWARF_LineStdOp_copy:
+          {
+            emit_row = 1;
+          }break;
+          case DWARF_LineStdOp_advance_pc:
+          {
+            U64 adv = 0;
+            DWARF_LEB128_DECODE_ADV(U64, adv, ptr, opl);
+            address += adv*minimum_instruction_length;
+          }break;
+          case DWARF_LineStdOp_advance_line:
+          {
+            S64 adv = 0;
+            DWARF_LEB128_DECODE_ADV(S64, adv, ptr, opl);
+            line = (U32)((S64)line + adv);
+          }break;
+          case DWARF_LineStdOp_set_file:
+          {
+            U64 idx = 0;
+            DWARF_LEB128_DECODE_ADV(U64, idx, ptr, opl);
+            file_idx = (U32)idx;
+          }break;
+          case DWARF_LineStdOp_set_column:
+          {
+            U64 col = 0;
+            DWARF_LEB128_DECODE_ADV(U64, col, ptr, opl);
+            column = (U32)col;
+          }break;
+          case DWARF_LineStdOp_negate_stmt:
+          case DWARF_LineStdOp_set_basic_block:
+          case DWARF_LineStdOp_set_prologue_end:
+          case DWARF_LineStdOp_set_epilogue_begin:
+          {}break;
+          case DWARF_LineStdOp_const_add_pc:
+          {
+            if (line_range != 0){
+              address += ((255 - opcode_base)/line_range)*minimum_instruction_length;
+            }
+          }break;
+          case DWARF_LineStdOp_fixed_advance_pc:
+          {
+            address += MemoryConsume(U16, ptr, opl);
+          }break;
+          case DWARF_LineStdOp_set_isa:
+          {
+            U64 isa = 0;
+            DWARF_LEB128_DECODE_ADV(U64, isa, ptr, opl);
+          }break;
+        }
+      }
+      
+      // append row
+      if (emit_row){
+        if (chunk_last == 0 || chunk_last->count == ArrayCount(chunk_last->rows)){
+          DWARF__LineRowChunk *chunk = push_array_no_zero(scratch.arena, DWARF__LineRowChunk, 1);
+          chunk->next = 0;
+          chunk->count = 0;
+          SLLQueuePush(chunk_first, chunk_last, chunk);
+        }
+        DWARF_LineRow *row = &chunk_last->rows[chunk_last->count];
+        chunk_last->count += 1;
+        row_count += 1;
+        row->address = address;
+        row->file_idx = file_idx;
+        row->line = line;
+        row->column = column;
+      }
+      
+      // close sequence
+      if (end_sequence){
+        DWARF_LineSequence *seq = push_array(arena, DWARF_LineSequence, 1);
+        seq->rows = push_array_no_zero(arena, DWARF_LineRow, row_count);
+        seq->row_count = row_count;
+        DWARF_LineRow *row_ptr = seq->rows;
+        for (DWARF__LineRowChunk *chunk = chunk_first; chunk != 0; chunk = chunk->next){
+          MemoryCopy(row_ptr, chunk->rows, sizeof(*row_ptr)*chunk->count);
+          row_ptr += chunk->count;
+        }
+        SLLQueuePush(result->first, result->last, seq);
+        result->sequence_count += 1;
+        
+        // reset state machine
+        chunk_first = chunk_last = 0;
+        row_count = 0;
+        address = 0;
+        file_idx = 1;
+        line = 1;
+        column = 0;
+        end_sequence = 0;
+      }
+    }
+    
+    result->file_paths = file_paths;
+    result->file_count = file_count;
+    result->decoding_error = decoding_error;
+  }
+  
+  scratch_end(scratch);
+  return(result);
+}
+
+
 // string functions
 
 static String8
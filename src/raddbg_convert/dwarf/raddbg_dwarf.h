@@ -165,6 +165,7 @@ X(location,                0x02, exprloc,       loclist,   0,         0)\
 X(name,                    0x03, string,        0,         0,         0)\
 X(ordering,                0x09, constant,      0,         0,         0)\
 X(byte_size,               0x0b, constant,      exprloc,   reference, 0)\
+X(bit_offset,              0x0c, constant,      exprloc,   reference, 0)\
 X(bit_size,                0x0d, constant,      exprloc,   reference, 0)\
 X(stmt_list,               0x10, lineptr,       0,         0,         0)\
 X(low_pc,                  0x11, address,       0,         0,         0)\
@@ -422,6 +423,7 @@ X(deref_type,          0xa6, 2)\
 X(xderef_type,         0xa7, 2)\
 X(convert,             0xa8, 1)\
 X(reinterpret,         0xa9, 1)\
+X(GNU_push_tls_address,0xe0, 0)\
 X(lo_user,             0xe0, 0)\
 X(hi_user,             0xff, 0)
 
@@ -451,6 +453,24 @@ typedef enum DWARF_LocationListEntry{
 } DWARF_LocationListEntry;
 
 
+// range list entry:  X(name, code)
+#define DWARF_RangeListEntryXList(X)\
+X(end_of_list,      0x00)\
+X(base_addressx,    0x01)\
+X(startx_endx,      0x02)\
+X(startx_length,    0x03)\
+X(offset_pair,      0x04)\
+X(base_address,     0x05)\
+X(start_end,        0x06)\
+X(start_length,     0x07)
+
+typedef enum DWARF_RangeListEntry{
+#define X(N,C) DWARF_RangeListEntry_##N = C,
+  DWARF_RangeListEntryXList(X)
+#undef X
+} DWARF_RangeListEntry;
+
+
 // base type:  X(name, code)
 #define DWARF_BaseTypeXList(X)\
 X(address,         0x01)\
@@ -589,6 +609,9 @@ X(Fortran03,      0x0022, 1)\
 X(Fortran08,      0x0023, 1)\
 X(RenderScript,   0x0024, 0)\
 X(BLISS,          0x0025, 0)\
+X(C_plus_plus_17, 0x002a, 0)\
+X(C_plus_plus_20, 0x002b, 0)\
+X(C17,            0x002c, 0)\
 X(lo_user,        0x8000, 0)\
 X(hi_user,        0xffff, 0)
 
@@ -727,8 +750,16 @@ X(val_offset,        0x0, 1, 0x14, ULEB,  ULEB)\
 X(val_offset_sf,     0x0, 1, 0x15, ULEB,  SLEB)\
 X(val_expression,    0x0, 1, 0x16, ULEB,  BLOCK)\
 X(lo_user,           0x0, 1, 0x1c, NULL,  NULL)\
+X(GNU_args_size,     0x0, 1, 0x2e, ULEB,  NULL)\
+X(GNU_negative_offset_extended, 0x0, 1, 0x2f, ULEB, ULEB)\
 X(hi_user,           0x0, 1, 0x3f, NULL,  NULL)
 
+typedef enum DWARF_CallFrameInsn{
+#define X(N,h,m,l,o1,o2) DWARF_CallFrameInsn_##N = (((h) << 6)|(l)),
+  DWARF_CallFrameInsnXList(X)
+#undef X
+} DWARF_CallFrameInsn;
+
 // line number encoding codes
 //  (DWARF4.pdf + 7.21) (DWARF5.pdf + 7.22)
 
@@ -1002,6 +1033,10 @@ typedef struct DWARF_AbbrevUnit{
   DWARF_AbbrevDecl *first;
   DWARF_AbbrevDecl *last;
   U64 count;
+  
+  // direct code -> decl table; codes are almost always dense from 1
+  DWARF_AbbrevDecl **decl_table;
+  U64 decl_table_count;
 } DWARF_AbbrevUnit;
 
 #if 0
@@ -1019,6 +1054,31 @@ typedef struct DWARF_AbbrevParsed{
 } DWARF_AbbrevParsed;
 
 
+// info entry trees
+//  (one per unit, entries are stored in .debug_info order)
+
+typedef struct DWARF_InfoEntryTree{
+  DWARF_InfoUnit *unit;
+  DWARF_InfoEntry *root;
+  DWARF_InfoEntry **entries;
+  U64 entry_count;
+  B32 decoding_error;
+} DWARF_InfoEntryTree;
+
+// unit context: the per-unit bases needed to resolve indirect forms
+//  (DWARF5.pdf + 3.1.1)
+
+typedef struct DWARF_UnitContext{
+  DWARF_Parsed *dwarf;
+  DWARF_InfoUnit *unit;
+  U64 base_address;
+  U64 str_offsets_base;
+  U64 addr_base;
+  U64 rnglists_base;
+  U64 loclists_base;
+} DWARF_UnitContext;
+
+
 // name lookup tables (V4): .debug_pubnames .debug_pubtypes
 //  (DWARF4.pdf + 7.19)
 
@@ -1143,6 +1203,34 @@ typedef struct DWARF_LineParsed{
   U64 unit_count;
 } DWARF_LineParsed;
 
+// line number programs
+//  rows are emitted by the state machine; the last row of each sequence
+//  is the end_sequence row and only marks the end address
+
+typedef struct DWARF_LineRow{
+  U64 address;
+  U32 file_idx;
+  U32 line;
+  U32 column;
+} DWARF_LineRow;
+
+typedef struct DWARF_LineSequence{
+  struct DWARF_LineSequence *next;
+  DWARF_LineRow *rows;
+  U64 row_count;
+} DWARF_LineSequence;
+
+typedef struct DWARF_LineProgram{
+  // indexed by the state machine's file register
+  String8 *file_paths;
+  U64 file_count;
+  
+  DWARF_LineSequence *first;
+  DWARF_LineSequence *last;
+  U64 sequence_count;
+  B32 decoding_error;
+} DWARF_LineProgram;
+
 
 // macro information (V4): .debug_macinfo
 //  (DWARF4.pdf + 7.22)
@@ -1164,15 +1252,74 @@ typedef struct DWARF_MacroParsed{
 } DWARF_MacroParsed;
 
 
-// call frame information: .debug_frame
-//  (DWARF4.pdf + 7.23) (DWARF5.pdf + 7.24)
+// call frame information: .debug_frame & .eh_frame
+//  (DWARF4.pdf + 6.4) (DWARF5.pdf + 6.4) (LSB 5.0 + 10.6)
 
-// ** not implemented yet **
+// only the CFA rule is tracked; each row holds the rule over one address
+// range, sorted by address. a CFA given by an expression can't be written
+// as register + offset, so those rows are only marked.
+
+typedef struct DWARF_CFARow{
+  U64 vaddr_first;
+  U64 vaddr_opl;
+  U64 reg;
+  S64 off;
+  B32 is_expr;
+} DWARF_CFARow;
+
+typedef struct DWARF_CFARowNode{
+  struct DWARF_CFARowNode *next;
+  DWARF_CFARow row;
+} DWARF_CFARowNode;
+
+typedef struct DWARF_CFARowList{
+  DWARF_CFARowNode *first;
+  DWARF_CFARowNode *last;
+  U64 count;
+} DWARF_CFARowList;
 
 typedef struct DWARF_FrameParsed{
-  U32 dummy;
+  DWARF_CFARow *rows;
+  U64 row_count;
 } DWARF_FrameParsed;
 
+typedef struct DWARF_CIEParsed{
+  U64 address_size;
+  U64 code_align;
+  S64 data_align;
+  U8 addr_encoding;
+  B8 has_augmentation_data;
+  U8 *insts_first;
+  U8 *insts_opl;
+} DWARF_CIEParsed;
+
+typedef struct DWARF_CFAState{
+  U64 reg;
+  S64 off;
+  B32 is_expr;
+} DWARF_CFAState;
+
+// pointer encodings of .eh_frame (LSB 5.0 + 10.5.1)
+typedef U8 DWARF_EhPtrEnc;
+enum{
+  DWARF_EhPtrEnc_Absptr  = 0x00,
+  DWARF_EhPtrEnc_Uleb128 = 0x01,
+  DWARF_EhPtrEnc_Udata2  = 0x02,
+  DWARF_EhPtrEnc_Udata4  = 0x03,
+  DWARF_EhPtrEnc_Udata8  = 0x04,
+  DWARF_EhPtrEnc_Sleb128 = 0x09,
+  DWARF_EhPtrEnc_Sdata2  = 0x0A,
+  DWARF_EhPtrEnc_Sdata4  = 0x0B,
+  DWARF_EhPtrEnc_Sdata8  = 0x0C,
+  DWARF_EhPtrEnc_TypeMask = 0x0F,
+  
+  DWARF_EhPtrEnc_Pcrel   = 0x10,
+  DWARF_EhPtrEnc_ModMask = 0x70,
+  
+  DWARF_EhPtrEnc_Indirect = 0x80,
+  DWARF_EhPtrEnc_Omit     = 0xFF,
+};
+
 
 // range lists (V4): .debug_ranges
 //  (DWARF4.pdf + 7.24)
@@ -1237,6 +1384,35 @@ typedef struct DWARF_LocListsParsed{
 } DWARF_LocListsParsed;
 
 
+// decoded range & location lists
+//  (addresses are absolute, ranges are [first,opl))
+
+typedef struct DWARF_RangeNode{
+  struct DWARF_RangeNode *next;
+  U64 first;
+  U64 opl;
+} DWARF_RangeNode;
+
+typedef struct DWARF_RangeList{
+  DWARF_RangeNode *first;
+  DWARF_RangeNode *last;
+  U64 count;
+} DWARF_RangeList;
+
+typedef struct DWARF_LocationNode{
+  struct DWARF_LocationNode *next;
+  U64 first;
+  U64 opl;
+  String8 expr;
+} DWARF_LocationNode;
+
+typedef struct DWARF_LocationList{
+  DWARF_LocationNode *first;
+  DWARF_LocationNode *last;
+  U64 count;
+} DWARF_LocationList;
+
+
 ////////////////////////////////
 //~ Dwarf Decode Helpers
 
@@ -1254,7 +1430,7 @@ static U32 dwarf_leb128_decode_U32(U8 *ptr, U8 *opl);
 #define dwarf_leb128_decode(T,ptr,opl) dwarf_leb128_decode_##T(ptr,opl)
 
 #define DWARF_LEB128_DECODE_ADV(T,x,p,o) do{ \
-U8 *first__ = (p); B32 success__;          \
+U8 *first__ = (p); B32 success__ = 1;      \
 DWARF_LEB128_ADV(p,o,success__);           \
 if (success__)                             \
 (x) = dwarf_leb128_decode(T,first__, (p)); \
@@ -1274,7 +1450,8 @@ static DWARF_ArangesParsed*  dwarf_aranges_from_data(Arena *arena, String8 data)
 static DWARF_LineParsed*     dwarf_line_from_data(Arena *arena, String8 data);
 static DWARF_MacInfoParsed*  dwarf_mac_info_from_data(Arena *arena, String8 data);
 static DWARF_MacroParsed*    dwarf_macro_from_data(Arena *arena, String8 data);
-static DWARF_FrameParsed*    dwarf_frame_from_data(Arena *arena, String8 data);
+static DWARF_FrameParsed*    dwarf_frame_from_data(Arena *arena, String8 data, U64 data_vaddr,
+                                                   U64 address_size, B32 is_eh_frame);
 static DWARF_RangesParsed*   dwarf_ranges_from_data(Arena *arena, String8 data);
 static DWARF_StrOffsetsParsed* dwarf_str_offsets_from_data(Arena *arena, String8 data);
 static DWARF_AddrParsed*     dwarf_addr_from_data(Arena *arena, String8 data);
@@ -1294,6 +1471,23 @@ dwarf__line_v5_directories(U64 address_size, U64 offset_size,
                            DWARF_V5Directory *directories_out, U64 dir_count,
                            U8 **ptr_io, U8 *opl);
 
+// (LSB 5.0 + 10.5.1)
+static U64 dwarf__eh_ptr_decode(DWARF_EhPtrEnc enc, U64 address_size, U64 field_vaddr,
+                                U8 **ptr_io, U8 *opl, B32 *good_io);
+
+// (DWARF4.pdf + 6.4.1) (LSB 5.0 + 10.6.1.1)
+static B32  dwarf__cie_from_data(String8 data, U64 cie_off, U64 address_size, B32 is_eh_frame,
+                                 DWARF_CIEParsed *cie_out);
+
+// (DWARF4.pdf + 6.4.2)
+static B32  dwarf__cfa_program_run(Arena *arena, DWARF_CIEParsed *cie,
+                                   String8 data, U64 data_vaddr, U8 *ptr, U8 *opl,
+                                   U64 vaddr_first, U64 vaddr_opl,
+                                   DWARF_CFAState *state_io, DWARF_CFARowList *rows_out);
+static void dwarf__cfa_row_list_push(Arena *arena, DWARF_CFARowList *list,
+                                     U64 vaddr_first, U64 vaddr_opl, DWARF_CFAState *state);
+static int  dwarf__qsort_compare_cfa_row(DWARF_CFARow *a, DWARF_CFARow *b);
+
 // debug sections
 
 static String8 dwarf_name_from_debug_section(DWARF_Parsed *dwarf, DWARF_SectionCode sec_code);
@@ -1302,6 +1496,56 @@ static String8 dwarf_name_from_debug_section(DWARF_Parsed *dwarf, DWARF_SectionC
 
 static DWARF_AbbrevUnit* dwarf_abbrev_unit_from_offset(DWARF_AbbrevParsed *abbrev, U64 off);
 static DWARF_AbbrevDecl* dwarf_abbrev_decl_from_code(DWARF_AbbrevUnit *unit, U32 code);
+static DWARF_AbbrevUnit* dwarf_abbrev_unit_from_data(Arena *arena, String8 data, U64 offset);
+
+// info entry functions
+
+static DWARF_InfoEntryTree*
+dwarf_info_entry_tree_from_unit(Arena *arena, String8 data,
+                                DWARF_InfoUnit *unit, DWARF_AbbrevUnit *abbrev);
+static DWARF_InfoEntry* dwarf_info_entry_from_offset(DWARF_InfoEntryTree *tree, U64 info_off);
+
+// attribute value functions
+
+static DWARF_UnitContext dwarf_unit_context_from_root(DWARF_Parsed *dwarf, DWARF_InfoUnit *unit,
+                                                      DWARF_InfoEntry *root);
+
+static U32     dwarf_attrib_idx_from_name(DWARF_InfoEntry *entry, DWARF_AttributeName name);
+static B32     dwarf_entry_has_attrib(DWARF_InfoEntry *entry, DWARF_AttributeName name);
+static DWARF_AttributeForm dwarf_form_from_attrib(DWARF_InfoEntry *entry, DWARF_AttributeName name);
+
+static U64     dwarf_u64_from_attrib(DWARF_UnitContext *ctx, DWARF_InfoEntry *entry,
+                                     DWARF_AttributeName name);
+static S64     dwarf_s64_from_attrib(DWARF_UnitContext *ctx, DWARF_InfoEntry *entry,
+                                     DWARF_AttributeName name);
+static String8 dwarf_string_from_attrib(DWARF_UnitContext *ctx, DWARF_InfoEntry *entry,
+                                        DWARF_AttributeName name);
+static String8 dwarf_block_from_attrib(DWARF_UnitContext *ctx, DWARF_InfoEntry *entry,
+                                       DWARF_AttributeName name);
+static U64     dwarf_ref_from_attrib(DWARF_UnitContext *ctx, DWARF_InfoEntry *entry,
+                                     DWARF_AttributeName name);
+
+static U64     dwarf_address_from_idx(DWARF_UnitContext *ctx, U64 idx);
+static String8 dwarf_string_from_str_idx(DWARF_UnitContext *ctx, U64 idx);
+static String8 dwarf_string_from_section_off(DWARF_Parsed *dwarf, DWARF_SectionCode sec_code,
+                                             U64 off);
+
+// range & location list functions
+
+static DWARF_RangeList    dwarf_range_list_from_entry(Arena *arena, DWARF_UnitContext *ctx,
+                                                      DWARF_InfoEntry *entry);
+static DWARF_LocationList dwarf_location_list_from_attrib(Arena *arena, DWARF_UnitContext *ctx,
+                                                          DWARF_InfoEntry *entry,
+                                                          DWARF_AttributeName name);
+
+// call frame functions
+
+static U64 dwarf_cfa_row_idx_from_vaddr(DWARF_FrameParsed *frame, U64 vaddr);
+
+// line program functions
+
+static DWARF_LineProgram* dwarf_line_program_from_offset(Arena *arena, DWARF_UnitContext *ctx,
+                                                         U64 line_off, String8 comp_dir);
 
 // attribute decoding functions
 
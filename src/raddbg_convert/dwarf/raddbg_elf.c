@@ -457,7 +457,7 @@ elf_section_data_from_idx(ELF_Parsed *elf, U32 idx){
       ELF_Shdr64 *shdr = elf->sections + idx;
       U64 off_raw = shdr->sh_offset;
       U64 size = shdr->sh_size;
-      if (shdr->sh_flags & ELF_SectionType_NOBITS){
+      if (shdr->sh_type == ELF_SectionType_NOBITS){
         size = 0;
       }
       U64 opl_raw = off_raw + size;
@@ -508,6 +508,58 @@ elf_sym_array_from_data(Arena *arena, ELF_Class elf_class, String8 data){
   return(result);
 }
 
+static String8
+elf_gnu_build_id_from_elf(ELF_Parsed *elf){
+  String8 result = {0};
+  if (elf != 0){
+    for (U64 i = 0; i < elf->section_count && result.size == 0; i += 1){
+      if (elf->sections[i].sh_type != ELF_SectionType_NOTE){
+        continue;
+      }
+      
+      // each note: header, name (4-byte aligned), desc (4-byte aligned)
+      String8 data = elf_section_data_from_idx(elf, i);
+      U64 off = 0;
+      for (;off + sizeof(ELF_Nhdr) <= data.size;){
+        ELF_Nhdr *nhdr = (ELF_Nhdr*)(data.str + off);
+        U64 name_off = off + sizeof(ELF_Nhdr);
+        U64 desc_off = name_off + AlignPow2((U64)nhdr->n_namesz, 4);
+        U64 desc_opl = desc_off + nhdr->n_descsz;
+        if (desc_opl > data.size){
+          break;
+        }
+        String8 name = str8(data.str + name_off, nhdr->n_namesz);
+        if (nhdr->n_type == ELF_NoteType_GNU_BUILD_ID &&
+            str8_match(name, str8_lit("GNU\0"), 0)){
+          result = str8(data.str + desc_off, nhdr->n_descsz);
+          break;
+        }
+        off = desc_off + AlignPow2((U64)nhdr->n_descsz, 4);
+      }
+    }
+  }
+  return(result);
+}
+
+static ELF_GnuDebugLink
+elf_gnu_debuglink_from_elf(ELF_Parsed *elf){
+  ELF_GnuDebugLink result = {0};
+  if (elf != 0){
+    U32 idx = elf_section_idx_from_name(elf, str8_lit(".gnu_debuglink"));
+    if (idx != 0){
+      // file name, null terminated & padded to 4 bytes, then the crc
+      String8 data = elf_section_data_from_idx(elf, idx);
+      String8 name = str8_cstring_capped((char*)data.str, (char*)(data.str + data.size));
+      U64 crc_off = AlignPow2(name.size + 1, 4);
+      if (name.size > 0 && crc_off + sizeof(U32) <= data.size){
+        result.name = name;
+        result.crc = *(U32*)(data.str + crc_off);
+      }
+    }
+  }
+  return(result);
+}
+
 // string functions
 
 static String8
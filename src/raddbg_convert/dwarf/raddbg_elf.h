@@ -444,6 +444,20 @@ typedef enum ELF_SegmentFlags{
   ELF_SegmentFlag_MASKPROC = 0xF0000000,
 } ELF_SegmentFlags;
 
+// notes
+
+typedef struct ELF_Nhdr{
+  U32 n_namesz;
+  U32 n_descsz;
+  U32 n_type;
+} ELF_Nhdr;
+
+typedef enum ELF_NoteType{
+  ELF_NoteType_GNU_ABI_TAG  = 1,
+  ELF_NoteType_GNU_HWCAP    = 2,
+  ELF_NoteType_GNU_BUILD_ID = 3,
+} ELF_NoteType;
+
 ////////////////////////////////
 //~ ELF Parser Types
 
@@ -490,6 +504,15 @@ typedef struct ELF_SymArray{
   U64 count;
 } ELF_SymArray;
 
+// separate debug info
+
+// NOTE: .gnu_debuglink names a file holding this image's debug info, along
+// with a CRC32 of that file's contents.
+typedef struct ELF_GnuDebugLink{
+  String8 name;
+  U32 crc;
+} ELF_GnuDebugLink;
+
 ////////////////////////////////
 //~ ELF Parser Functions
 
@@ -507,6 +530,9 @@ static String8 elf_section_data_from_idx(ELF_Parsed *elf, U32 idx);
 
 static ELF_SymArray elf_sym_array_from_data(Arena *arena, ELF_Class elf_class, String8 data);
 
+static String8          elf_gnu_build_id_from_elf(ELF_Parsed *elf);
+static ELF_GnuDebugLink elf_gnu_debuglink_from_elf(ELF_Parsed *elf);
+
 // string functions
 
 static String8 elf_string_from_section_type(ELF_SectionType section_type);
@@ -1,28 +1,6 @@
 // Copyright (c) 2024 Epic Games Tools
 // Licensed under the MIT license (https://opensource.org/license/mit/)
 
-#include "base/base_inc.h"
-#include "os/os_inc.h"
-#include "raddbg_format/raddbg_format.h"
-#include "raddbg_cons/raddbg_cons.h"
-
-#include "raddbg_elf.h"
-#include "raddbg_dwarf.h"
-
-#include "raddbg_dwarf_stringize.h"
-
-#include "raddbg_from_dwarf.h"
-
-#include "base/base_inc.c"
-#include "os/os_inc.c"
-#include "raddbg_format/raddbg_format.c"
-#include "raddbg_cons/raddbg_cons.c"
-
-#include "raddbg_elf.c"
-#include "raddbg_dwarf.c"
-
-#include "raddbg_dwarf_stringize.c"
-
 // TODO(allen): 
 // [ ] need sample data for .debug_names
 
@@ -44,7 +22,13 @@ dwarf_convert_params_from_cmd_line(Arena *arena, CmdLine *cmdline){
     }
     
     if (input_name.size > 0){
-      String8 input_data = os_data_from_file_path(arena, input_name);
+      // map the input read-only; fall back to reading it into the arena
+      OS_FileView input_view = os_file_view_open(input_name);
+      String8 input_data = input_view.data;
+      if (input_data.size == 0){
+        os_file_view_close(&input_view);
+        input_data = os_data_from_file_path(arena, input_name);
+      }
       
       if (input_data.size == 0){
         str8_list_pushf(arena, &result->errors,
@@ -54,6 +38,7 @@ dwarf_convert_params_from_cmd_line(Arena *arena, CmdLine *cmdline){
       if (input_data.size != 0){
         result->input_elf_name = input_name;
         result->input_elf_data = input_data;
+        result->input_elf_view = input_view;
       }
     }
   }
@@ -63,6 +48,22 @@ dwarf_convert_params_from_cmd_line(Arena *arena, CmdLine *cmdline){
     result->output_name = cmd_line_string(cmdline, str8_lit("out"));
   }
   
+  // get thread count
+  {
+    result->thread_count = os_logical_core_count();
+    String8 thread_count_string = cmd_line_string(cmdline, str8_lit("threads"));
+    if (thread_count_string.size > 0){
+      U64 thread_count = 0;
+      if (try_u64_from_str8_c_rules(thread_count_string, &thread_count) && thread_count > 0){
+        result->thread_count = thread_count;
+      }
+      else{
+        str8_list_pushf(arena, &result->errors,
+                        "invalid thread count '%.*s'", str8_varg(thread_count_string));
+      }
+    }
+  }
+  
   // error options
   if (cmd_line_has_flag(cmdline, str8_lit("hide_errors"))){
     String8List vals = cmd_line_strings(cmdline, str8_lit("hide_errors"));
@@ -169,737 +170,1950 @@ dwarf_convert_params_from_cmd_line(Arena *arena, CmdLine *cmdline){
 }
 
 ////////////////////////////////
-//~ Entry Point
+//~ Conversion Functions
 
-static void
-dump_symtab(Arena *arena, String8List *out, ELF_SymArray *symbols, String8 strtab,
-            U32 indent){
-  static char spaces[] = "                                ";
-  
-  U8 *str_first = strtab.str;
-  U8 *str_opl   = strtab.str + strtab.size;
-  
-  ELF_Sym64 *symbol = symbols->symbols;
-  U64 count = symbols->count;
-  for (U64 i = 0; i < count; i += 1, symbol += 1){
-    U8 *name_first = str_first + symbol->st_name;
-    U8 *name_opl = name_first;
-    for (;name_opl < str_opl && *name_opl != 0;) name_opl += 1;
-    String8 name = str8_range(name_first, name_opl);
-    
-    ELF_SymbolBinding binding = ELF_SymBindingFromInfo(symbol->st_info);
-    String8 binding_string = elf_string_from_symbol_binding(binding);
-    
-    ELF_SymbolType type = ELF_SymTypeFromInfo(symbol->st_info);
-    String8 type_string = elf_string_from_symbol_type(type);
-    
-    ELF_SymbolVisibility vis = ELF_SymVisibilityFromOther(symbol->st_other);
-    String8 vis_string = elf_string_from_symbol_visibility(vis);
-    
-    str8_list_pushf(arena, out,
-                    "%.*ssymbol[%5llu] %6.*s %7.*s %9.*s 0x%08llx size=%-5llu sec=%-5u "
-                    "%.*s\n",
-                    indent, spaces, i,
-                    str8_varg(binding_string), str8_varg(type_string),
-                    str8_varg(vis_string),
-                    symbol->st_value, symbol->st_size,
-                    symbol->st_shndx, str8_varg(name));
-  }
-}
+//- tasks
 
-#if 0
-static void
-dump_entry_tree(Arena *arena, String8List *out,
-                DWARF_Parsed *dwarf, DWARF_InfoUnit *unit,
-                DWARF_InfoEntry *entry, U32 indent){
-  static char spaces[] = "                                ";
-  
-  DWARF_AbbrevDecl *abbrev_decl = entry->abbrev_decl;
-  
-  // tag
-  DWARF_Tag tag = abbrev_decl->tag;
-  String8 tag_string = dwarf_string_from_tag(tag);
-  str8_list_pushf(arena, out, "%.*sentry(@%llx) TAG %.*s\n",
-                  indent, spaces, entry->info_offset, str8_varg(tag_string));
-  
-  // attributes
-  U32                     attrib_count = abbrev_decl->attrib_count;
-  DWARF_AbbrevAttribSpec *attrib_spec  = abbrev_decl->attrib_specs;
-  DWARF_InfoAttribVal    *attrib_val   = entry->attrib_vals;
-  for (U32 i = 0; i < attrib_count; i += 1, attrib_spec += 1, attrib_val += 1){
-    // attribute name
-    DWARF_AttributeName name = attrib_spec->name;
-    String8 name_string = dwarf_string_from_attribute_name(name);
-    str8_list_pushf(arena, out, "%.*sATTR %.*s ", indent + 4, spaces, str8_varg(name_string));
-    
-    // attribute value
-    switch (attrib_spec->form){
-      default:
-      {
-        String8 form_string = dwarf_string_from_attribute_form(attrib_spec->form);
-        str8_list_pushf(arena, out, "<form: %.*s> {%llu, 0x%p}\n",
-                        str8_varg(form_string), attrib_val->val, attrib_val->dataptr);
-      }break;
+static TS_TASK_FUNCTION_DEF(dwarfconv_unit_parse_task__entry_point){
+  ProfBeginFunction();
+  DWARFCONV_UnitParseIn *in = (DWARFCONV_UnitParseIn*)p;
+  DWARF_Parsed *dwarf = in->dwarf;
+  String8 info_data = dwarf->debug_data[DWARF_SectionCode_Info];
+  String8 abbrev_data = dwarf->debug_data[DWARF_SectionCode_Abbrev];
+  U64 vbase = in->vbase;
+  U64 bytes_processed = 0;
+  
+  for (U64 unit_idx = in->unit_idx_first; unit_idx < in->unit_idx_opl; unit_idx += 1){
+    DWARF_InfoUnit *unit = in->units[unit_idx];
+    DWARFCONV_UnitParsed *out = &in->units_out[unit_idx];
+    out->unit = unit;
+    bytes_processed += unit->opl_off - unit->hdr_off;
+    
+    // entries
+    out->abbrev = dwarf_abbrev_unit_from_data(arena, abbrev_data, unit->abbrev_off);
+    out->tree = dwarf_info_entry_tree_from_unit(arena, info_data, unit, out->abbrev);
+    
+    DWARF_InfoEntry *root = out->tree->root;
+    out->ctx = dwarf_unit_context_from_root(dwarf, unit, root);
+    if (root == 0){
+      continue;
+    }
+    
+    // root attributes
+    DWARF_UnitContext *ctx = &out->ctx;
+    out->name = dwarf_string_from_attrib(ctx, root, DWARF_AttributeName_name);
+    out->comp_dir = dwarf_string_from_attrib(ctx, root, DWARF_AttributeName_comp_dir);
+    out->producer = dwarf_string_from_attrib(ctx, root, DWARF_AttributeName_producer);
+    out->language =
+      dwarfconv_language_from_dwarf_language(dwarf_u64_from_attrib(ctx, root, DWARF_AttributeName_language));
+    out->ranges = dwarf_range_list_from_entry(arena, ctx, root);
+    
+    // line info
+    if (dwarf_entry_has_attrib(root, DWARF_AttributeName_stmt_list)){
+      U64 line_off = dwarf_u64_from_attrib(ctx, root, DWARF_AttributeName_stmt_list);
+      DWARF_LineProgram *program = dwarf_line_program_from_offset(arena, ctx, line_off, out->comp_dir);
       
-      case DWARF_AttributeForm_strp:
-      {
-        String8 str = {0};
+      // split each sequence into runs of rows that share a file
+      for (DWARF_LineSequence *seq = program->first; seq != 0; seq = seq->next){
+        DWARF_LineRow *rows = seq->rows;
+        U64 row_count = seq->row_count;
         
-        String8 data = dwarf->debug_data[DWARF_SectionCode_Str];
-        U64 off = attrib_val->val;
-        if (off < data.size){
-          U8 *start = data.str + off;
-          U8 *opl = data.str + data.size;
-          U8 *ptr = start;
-          for (;ptr < opl && *ptr != 0;) ptr += 1;
-          str = str8_range(start, ptr);
+        // code the linker discarded keeps its sequences, relocated to zero
+        // (or to a tombstone); PIE images have a zero vbase, so only keep
+        // sequences that start inside an executable section
+        if (row_count < 2){
+          continue;
         }
-        
-        str8_list_pushf(arena, out, "'%.*s'\n", str8_varg(str));
-      }break;
-      
-      case DWARF_AttributeForm_sec_offset:
-      {
-        DWARF_AttributeClassFlags attr_classes1 = dwarf_attribute_class_from_name(name);
-        DWARF_AttributeClassFlags attr_classes2 = DWARF_AttributeClassFlag_sec_offset_classes;
-        DWARF_AttributeClassFlags attr_classes = attr_classes1&attr_classes2;
-        
-        DWARF_SectionCode sec_code = DWARF_SectionCode_Null;
-        if (unit->dwarf_version == 5){
-          switch (attr_classes){
-            case DWARF_AttributeClassFlag_addrptr: sec_code = DWARF_SectionCode_Addr; break;
-            case DWARF_AttributeClassFlag_lineptr: sec_code = DWARF_SectionCode_Line; break;
-            case DWARF_AttributeClassFlag_loclist: sec_code = DWARF_SectionCode_LocLists; break;
-            case DWARF_AttributeClassFlag_loclistsptr: sec_code = DWARF_SectionCode_LocLists; break;
-            case DWARF_AttributeClassFlag_macptr:  sec_code = DWARF_SectionCode_Macro; break;
-            case DWARF_AttributeClassFlag_rnglist: sec_code = DWARF_SectionCode_RngLists; break;
-            case DWARF_AttributeClassFlag_rnglistsptr: sec_code = DWARF_SectionCode_RngLists; break;
-            case DWARF_AttributeClassFlag_stroffsetsptr: sec_code = DWARF_SectionCode_StrOffsets; break;
-          }
-        }
-        else if (unit->dwarf_version == 4){
-          switch (attr_classes){
-            case DWARF_AttributeClassFlag_lineptr: sec_code = DWARF_SectionCode_Line; break;
-            case DWARF_AttributeClassFlag_loclist: sec_code = DWARF_SectionCode_Loc; break;
-            case DWARF_AttributeClassFlag_macptr:  sec_code = DWARF_SectionCode_MacInfo; break;
-            case DWARF_AttributeClassFlag_rnglist: sec_code = DWARF_SectionCode_Ranges; break;
-          }
+        if (!dwarfconv_vaddr_is_in_code(in->code_ranges, in->code_range_count, rows[0].address)){
+          continue;
         }
         
-        String8 sec_name = dwarf_name_from_debug_section(dwarf, sec_code);
-        str8_list_pushf(arena, out, "sec(%.*s) + %llu\n", str8_varg(sec_name), attrib_val->val);
-      }break;
-      
-      case DWARF_AttributeForm_ref1:
-      case DWARF_AttributeForm_ref2:
-      case DWARF_AttributeForm_ref4:
-      case DWARF_AttributeForm_ref8:
-      case DWARF_AttributeForm_ref_udata:
-      {
-        str8_list_pushf(arena, out, "entry(@%llx)\n", attrib_val->val);
-      }break;
-      
-      case DWARF_AttributeForm_addr:
-      {
-        str8_list_pushf(arena, out, "0x%llx\n", attrib_val->val);
-      }break;
-      
-      case DWARF_AttributeForm_exprloc:
-      {
-        str8_list_pushf(arena, out, "expression\n");
-        // TODO(allen): dwarf expression dumping
-      }break;
-      
-      case DWARF_AttributeForm_strx1:
-      case DWARF_AttributeForm_strx2:
-      case DWARF_AttributeForm_strx3:
-      case DWARF_AttributeForm_strx4:
-      {
-        String8 str = {0};
-        
-        U32 idx = attrib_val->val;
-        U64 str_offsets_off = unit->str_offsets_base + idx*unit->offset_size;
-        
-        String8 str_offsets = dwarf->debug_data[DWARF_SectionCode_StrOffsets];
-        if (str_offsets_off + unit->offset_size < str_offsets.size){
-          U64 off = 0;
-          MemoryCopy(&off, str_offsets.str + str_offsets_off, unit->offset_size);
+        for (U64 first = 0; first + 1 < row_count;){
+          U32 file_idx = rows[first].file_idx;
+          U64 opl = first + 1;
+          for (;opl + 1 < row_count && rows[opl].file_idx == file_idx;) opl += 1;
           
-          String8 data = dwarf->debug_data[DWARF_SectionCode_Str];
-          if (off < data.size){
-            U8 *start = data.str + off;
-            U8 *opl = data.str + data.size;
-            U8 *ptr = start;
-            for (;ptr < opl && *ptr != 0;) ptr += 1;
-            str = str8_range(start, ptr);
+          U64 line_count = opl - first;
+          U64 *voffs = push_array_no_zero(arena, U64, line_count + 1);
+          U32 *line_nums = push_array_no_zero(arena, U32, line_count);
+          for (U64 i = 0; i < line_count; i += 1){
+            voffs[i] = rows[first + i].address - vbase;
+            line_nums[i] = rows[first + i].line;
           }
+          voffs[line_count] = rows[opl].address - vbase;
+          
+          DWARFCONV_LineSequenceNode *node = push_array(arena, DWARFCONV_LineSequenceNode, 1);
+          SLLQueuePush(out->line_seq_first, out->line_seq_last, node);
+          out->line_seq_count += 1;
+          if (file_idx < program->file_count){
+            node->line_seq.file_name = program->file_paths[file_idx];
+          }
+          node->line_seq.voffs = voffs;
+          node->line_seq.line_nums = line_nums;
+          node->line_seq.line_count = line_count;
+          
+          first = opl;
         }
-        
-        str8_list_pushf(arena, out, "'%.*s'\n", str8_varg(str));
-      }break;
-      
-      case DWARF_AttributeForm_addrx:
-      case DWARF_AttributeForm_addrx1:
-      case DWARF_AttributeForm_addrx2:
-      case DWARF_AttributeForm_addrx3:
-      case DWARF_AttributeForm_addrx4:
-      {
-        U64 address = 0;
-        
-        U32 idx = attrib_val->val;
-        U64 address_off = unit->addr_base + idx*unit->address_size;
-        
-        String8 data = dwarf->debug_data[DWARF_SectionCode_Addr];
-        if (address_off + unit->address_size < data.size){
-          MemoryCopy(&address, data.str + address_off, unit->address_size);
-        }
-        
-        str8_list_pushf(arena, out, "0x%x\n", address);
-      }break;
-      
-      case DWARF_AttributeForm_rnglistx:
-      {
-        U64 rnglist_off = unit->rnglists_base + attrib_val->val;
-        int x = 0;
-      }break;
-      
-      case DWARF_AttributeForm_data1:
-      case DWARF_AttributeForm_data2:
-      case DWARF_AttributeForm_data4:
-      case DWARF_AttributeForm_data8:
-      case DWARF_AttributeForm_data16:
-      case DWARF_AttributeForm_udata:
-      case DWARF_AttributeForm_implicit_const:
-      case DWARF_AttributeForm_flag:
-      case DWARF_AttributeForm_flag_present:
-      {
-        str8_list_pushf(arena, out, "%llu\n", attrib_val->val);
-      }break;
-      
-      case DWARF_AttributeForm_sdata:
-      {
-        str8_list_pushf(arena, out, "%lld\n", (S64)attrib_val->val);
-      }break;
-      
-      case DWARF_AttributeForm_string:
-      {
-        str8_list_pushf(arena, out, "'%.*s'\n", (int)attrib_val->val, attrib_val->dataptr);
-      }break;
+      }
     }
   }
   
-  // dump children
-  for (DWARF_InfoEntry *child = entry->first_child;
-       child != 0;
-       child = child->next_sibling){
-    dump_entry_tree(arena, out, dwarf, unit, child, indent + 1);
-  }
+  cons_progress_advance(in->progress, bytes_processed, in->unit_idx_opl - in->unit_idx_first);
+  
+  ProfEnd();
+  return(0);
 }
-#endif
 
-int
-main(int argc, char **argv){
-  local_persist TCTX main_thread_tctx = {0};
-  tctx_init_and_equip(&main_thread_tctx);
-  
-#if PROFILE_TELEMETRY
-  U64 tm_data_size = GB(1);
-  U8 *tm_data = os_reserve(tm_data_size);
-  os_commit(tm_data, tm_data_size);
-  tmLoadLibrary(TM_RELEASE);
-  tmSetMaxThreadCount(1024);
-  tmInitialize(tm_data_size, tm_data);
-#endif
-  
-  ThreadName("[main]");
-  
-  Arena *arena = arena_alloc();
-  String8List args = os_string_list_from_argcv(arena, argc, argv);
-  CmdLine cmdline = cmd_line_from_string_list(arena, args);
-  
-  ProfBeginCapture("raddbg_from_dwarf");
-  
-  // parse arguments
-  DWARFCONV_Params *params = dwarf_convert_params_from_cmd_line(arena, &cmdline);
-  
-  // show input errors
-  if (params->errors.node_count > 0 &&
-      !params->hide_errors.input){
-    for (String8Node *node = params->errors.first;
-         node != 0;
-         node = node->next){
-      fprintf(stdout, "error(input): %.*s\n", str8_varg(node->string));
-    }
-  }
-  
-  // will we try to parse an input file?
-  B32 try_parse_input = (params->errors.node_count == 0);
-  
-  // track parse success
-  B32 successful_parse = 1;
-  
-#define PARSE_CHECK_ERROR(p,fmt,...) do{ if ((p) == 0){ \
-successful_parse = 0; \
-fprintf(stdout, "error(parsing): " fmt "\n", __VA_ARGS__); \
-} }while(0)
-  
-  // parse elf
-  ELF_Parsed *elf = 0;
-  if (try_parse_input) ProfScope("parse elf"){
-    elf = elf_parsed_from_data(arena, params->input_elf_data);
-    PARSE_CHECK_ERROR(elf, "ELF");
-  }
-  
-  // parse strtab
-  String8 strtab = {0};
-  if (elf != 0) ProfScope("parse strtab"){
-    strtab = elf_section_data_from_idx(elf, elf->strtab_idx);
+//- enum conversion helpers
+
+static RADDBG_Arch
+dwarfconv_arch_from_elf_arch(Architecture arch){
+  RADDBG_Arch result = RADDBG_Arch_NULL;
+  switch (arch){
+    default:{}break;
+    case Architecture_x86: result = RADDBG_Arch_X86; break;
+    case Architecture_x64: result = RADDBG_Arch_X64; break;
   }
-  
-  // parse symtab
-  ELF_SymArray symtab = {0};
-  if (elf != 0) ProfScope("parse symtab"){
-    String8 data = elf_section_data_from_idx(elf, elf->symtab_idx);
-    symtab = elf_sym_array_from_data(arena, elf->elf_class, data);
+  return(result);
+}
+
+static RADDBG_Language
+dwarfconv_language_from_dwarf_language(U64 lang){
+  RADDBG_Language result = RADDBG_Language_NULL;
+  switch (lang){
+    default:{}break;
+    
+    case DWARF_Language_C89:
+    case DWARF_Language_C:
+    case DWARF_Language_C99:
+    case DWARF_Language_C11:
+    case DWARF_Language_C17:
+    {
+      result = RADDBG_Language_C;
+    }break;
+    
+    case DWARF_Language_C_plus_plus:
+    case DWARF_Language_C_plus_plus_03:
+    case DWARF_Language_C_plus_plus_11:
+    case DWARF_Language_C_plus_plus_14:
+    case DWARF_Language_C_plus_plus_17:
+    case DWARF_Language_C_plus_plus_20:
+    {
+      result = RADDBG_Language_CPlusPlus;
+    }break;
   }
+  return(result);
+}
+
+static RADDBG_RegisterCode
+dwarfconv_reg_code_from_dwarf_reg(RADDBG_Arch arch, U64 reg){
+  // (System V AMD64 ABI + 3.6.2) (System V i386 ABI + 2-14)
+  local_persist RADDBG_RegisterCode x64_regs[] = {
+    RADDBG_RegisterCode_X64_rax, RADDBG_RegisterCode_X64_rdx,
+    RADDBG_RegisterCode_X64_rcx, RADDBG_RegisterCode_X64_rbx,
+    RADDBG_RegisterCode_X64_rsi, RADDBG_RegisterCode_X64_rdi,
+    RADDBG_RegisterCode_X64_rbp, RADDBG_RegisterCode_X64_rsp,
+    RADDBG_RegisterCode_X64_r8,  RADDBG_RegisterCode_X64_r9,
+    RADDBG_RegisterCode_X64_r10, RADDBG_RegisterCode_X64_r11,
+    RADDBG_RegisterCode_X64_r12, RADDBG_RegisterCode_X64_r13,
+    RADDBG_RegisterCode_X64_r14, RADDBG_RegisterCode_X64_r15,
+    RADDBG_RegisterCode_X64_rip,
+  };
+  local_persist RADDBG_RegisterCode x86_regs[] = {
+    RADDBG_RegisterCode_X86_eax, RADDBG_RegisterCode_X86_ecx,
+    RADDBG_RegisterCode_X86_edx, RADDBG_RegisterCode_X86_ebx,
+    RADDBG_RegisterCode_X86_esp, RADDBG_RegisterCode_X86_ebp,
+    RADDBG_RegisterCode_X86_esi, RADDBG_RegisterCode_X86_edi,
+    RADDBG_RegisterCode_X86_eip,
+  };
   
-  // parse dynsym
-  ELF_SymArray dynsym = {0};
-  if (elf != 0) ProfScope("parse dynsym"){
-    String8 data = elf_section_data_from_idx(elf, elf->dynsym_idx);
-    dynsym = elf_sym_array_from_data(arena, elf->elf_class, data);
+  RADDBG_RegisterCode result = 0;
+  switch (arch){
+    default:{}break;
+    case RADDBG_Arch_X64:
+    {
+      if (reg < ArrayCount(x64_regs)){
+        result = x64_regs[reg];
+      }
+    }break;
+    case RADDBG_Arch_X86:
+    {
+      if (reg < ArrayCount(x86_regs)){
+        result = x86_regs[reg];
+      }
+    }break;
   }
-  
-  // parse dwarf
-  DWARF_Parsed *dwarf = 0;
-  if (elf != 0) ProfScope("parse dwarf"){
-    dwarf = dwarf_parsed_from_elf(arena, elf);
-    PARSE_CHECK_ERROR(dwarf, "DWARF");
+  return(result);
+}
+
+static RADDBG_TypeKind
+dwarfconv_type_kind_from_base_type(U64 encoding, U64 byte_size, String8 name){
+  RADDBG_TypeKind result = RADDBG_TypeKind_NULL;
+  switch (encoding){
+    default:{}break;
+    
+    case DWARF_BaseType_boolean:
+    {
+      result = RADDBG_TypeKind_Bool;
+    }break;
+    
+    case DWARF_BaseType_address:
+    case DWARF_BaseType_unsigned:
+    {
+      switch (byte_size){
+        case 1:  result = RADDBG_TypeKind_U8; break;
+        case 2:  result = RADDBG_TypeKind_U16; break;
+        case 4:  result = RADDBG_TypeKind_U32; break;
+        case 8:  result = RADDBG_TypeKind_U64; break;
+        case 16: result = RADDBG_TypeKind_U128; break;
+      }
+    }break;
+    
+    case DWARF_BaseType_signed:
+    {
+      switch (byte_size){
+        case 1:  result = RADDBG_TypeKind_S8; break;
+        case 2:  result = RADDBG_TypeKind_S16; break;
+        case 4:  result = RADDBG_TypeKind_S32; break;
+        case 8:  result = RADDBG_TypeKind_S64; break;
+        case 16: result = RADDBG_TypeKind_S128; break;
+      }
+    }break;
+    
+    case DWARF_BaseType_signed_char:
+    {
+      result = RADDBG_TypeKind_Char8;
+    }break;
+    
+    case DWARF_BaseType_unsigned_char:
+    {
+      result = RADDBG_TypeKind_UChar8;
+    }break;
+    
+    case DWARF_BaseType_UTF:
+    {
+      switch (byte_size){
+        case 1: result = RADDBG_TypeKind_UChar8; break;
+        case 2: result = RADDBG_TypeKind_UChar16; break;
+        case 4: result = RADDBG_TypeKind_UChar32; break;
+      }
+    }break;
+    
+    case DWARF_BaseType_float:
+    {
+      switch (byte_size){
+        case 2:  result = RADDBG_TypeKind_F16; break;
+        case 4:  result = RADDBG_TypeKind_F32; break;
+        case 8:  result = RADDBG_TypeKind_F64; break;
+        case 10: result = RADDBG_TypeKind_F80; break;
+        case 12: result = RADDBG_TypeKind_F80; break;
+        case 16:
+        {
+          // x87 long double is padded to 16 bytes
+          if (str8_match(name, str8_lit("long double"), 0)){
+            result = RADDBG_TypeKind_F80;
+          }
+          else{
+            result = RADDBG_TypeKind_F128;
+          }
+        }break;
+      }
+    }break;
+    
+    case DWARF_BaseType_complex_float:
+    {
+      switch (byte_size){
+        case 8:  result = RADDBG_TypeKind_ComplexF32; break;
+        case 16: result = RADDBG_TypeKind_ComplexF64; break;
+        case 20: result = RADDBG_TypeKind_ComplexF80; break;
+        case 32: result = RADDBG_TypeKind_ComplexF128; break;
+      }
+    }break;
   }
-  
-  // parse info
-  DWARF_InfoParsed *info = 0;
-  if (dwarf != 0){
-    String8 data = dwarf->debug_data[DWARF_SectionCode_Info];
-    if (data.size > 0) ProfScope("parse .debug_info"){
-      info = dwarf_info_from_data(arena, data);
-      PARSE_CHECK_ERROR(info, "DEBUG INFO");
+  return(result);
+}
+
+//- address helpers
+
+static B32
+dwarfconv_vaddr_is_in_code(Rng1U64 *code_ranges, U64 code_range_count, U64 vaddr){
+  B32 result = 0;
+  if (vaddr != 0){
+    for (U64 i = 0; i < code_range_count; i += 1){
+      if (contains_1u64(code_ranges[i], vaddr)){
+        result = 1;
+        break;
+      }
     }
   }
+  return(result);
+}
+
+//- entry helpers
+
+static DWARFCONV_EntryRef
+dwarfconv_entry_from_offset(DWARFCONV_Ctx *ctx, U64 info_off){
+  DWARFCONV_EntryRef result = {0};
   
-  // parse pubnames
-  DWARF_PubNamesParsed *pubnames = 0;
-  if (dwarf != 0){
-    String8 data = dwarf->debug_data[DWARF_SectionCode_PubNames];
-    if (data.size) ProfScope("parse .debug_pubnames"){
-      pubnames = dwarf_pubnames_from_data(arena, data);
-      PARSE_CHECK_ERROR(pubnames, "DEBUG PUBNAMES");
+  // units are in .debug_info order; find the last one that starts at or before info_off
+  if (ctx->unit_count > 0){
+    U64 first = 0;
+    U64 opl = ctx->unit_count;
+    for (;first + 1 < opl;){
+      U64 mid = (first + opl)/2;
+      if (ctx->units[mid].unit->hdr_off <= info_off){
+        first = mid;
+      }
+      else{
+        opl = mid;
+      }
+    }
+    DWARFCONV_UnitParsed *unit = &ctx->units[first];
+    if (unit->unit->hdr_off <= info_off && info_off < unit->unit->opl_off){
+      DWARF_InfoEntry *entry = dwarf_info_entry_from_offset(unit->tree, info_off);
+      if (entry != 0){
+        result.unit = unit;
+        result.entry = entry;
+      }
     }
   }
   
-  // parse pubtypes
-  DWARF_PubNamesParsed *pubtypes = 0;
-  if (dwarf != 0){
-    String8 data = dwarf->debug_data[DWARF_SectionCode_PubTypes];
-    if (data.size) ProfScope("parse .debug_pubtypes"){
-      pubtypes = dwarf_pubnames_from_data(arena, data);
-      PARSE_CHECK_ERROR(pubtypes, "DEBUG PUBTYPES");
+  return(result);
+}
+
+static DWARFCONV_EntryRef
+dwarfconv_attrib_owner(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref, DWARF_AttributeName name){
+  // definitions and concrete instances inherit attributes from the entries they
+  //  point at through DW_AT_specification & DW_AT_abstract_origin
+  DWARFCONV_EntryRef result = ref;
+  for (U32 hop = 0; hop < 8 && result.entry != 0; hop += 1){
+    if (dwarf_entry_has_attrib(result.entry, name)){
+      break;
+    }
+    U64 next_off = dwarf_ref_from_attrib(&result.unit->ctx, result.entry,
+                                         DWARF_AttributeName_specification);
+    if (next_off == 0){
+      next_off = dwarf_ref_from_attrib(&result.unit->ctx, result.entry,
+                                       DWARF_AttributeName_abstract_origin);
     }
+    if (next_off == 0){
+      break;
+    }
+    DWARFCONV_EntryRef next = dwarfconv_entry_from_offset(ctx, next_off);
+    if (next.entry == 0){
+      break;
+    }
+    result = next;
   }
-  
-  // parse names
-  DWARF_NamesParsed *names = 0;
-  if (dwarf != 0){
-    String8 data = dwarf->debug_data[DWARF_SectionCode_Names];
-    if (data.size) ProfScope("parse .debug_names"){
-      names = dwarf_names_from_data(arena, data);
-      PARSE_CHECK_ERROR(names, "DEBUG NAMES");
+  return(result);
+}
+
+static String8
+dwarfconv_qualified_name(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref, String8 name){
+  String8 result = name;
+  if (name.size > 0 && ref.entry != 0){
+    Temp scratch = scratch_begin(&ctx->arena, 1);
+    String8List parts = {0};
+    str8_list_push(scratch.arena, &parts, name);
+    for (DWARF_InfoEntry *parent = ref.entry->parent; parent != 0; parent = parent->parent){
+      DWARF_Tag tag = parent->abbrev_decl->tag;
+      if (tag == DWARF_Tag_namespace ||
+          tag == DWARF_Tag_structure_type ||
+          tag == DWARF_Tag_class_type ||
+          tag == DWARF_Tag_union_type){
+        String8 parent_name = dwarf_string_from_attrib(&ref.unit->ctx, parent, DWARF_AttributeName_name);
+        if (parent_name.size == 0){
+          parent_name = (tag == DWARF_Tag_namespace)?str8_lit("(anonymous namespace)"):str8_lit("<unnamed>");
+        }
+        str8_list_push_front(scratch.arena, &parts, parent_name);
+      }
+    }
+    if (parts.node_count > 1){
+      StringJoin join = {0};
+      join.sep = str8_lit("::");
+      result = str8_list_join(ctx->arena, &parts, &join);
     }
+    scratch_end(scratch);
   }
+  return(result);
+}
+
+
+//- types
+
+static CONS_Type*
+dwarfconv_type_from_offset(DWARFCONV_Ctx *ctx, U64 info_off){
+  CONS_Root *root = ctx->root;
   
-  // parse aranges
-  DWARF_ArangesParsed *aranges = 0;
-  if (dwarf != 0){
-    String8 data = dwarf->debug_data[DWARF_SectionCode_Aranges];
-    if (data.size) ProfScope("parse .debug_aranges"){
-      aranges = dwarf_aranges_from_data(arena, data);
-      PARSE_CHECK_ERROR(aranges, "DEBUG ARANGES");
+  // lookup or build
+  CONS_Type *result = cons_type_from_id(root, info_off);
+  if (result == 0){
+    CONS_Reservation *res = cons_type_reserve_id(root, info_off);
+    DWARFCONV_EntryRef ref = dwarfconv_entry_from_offset(ctx, info_off);
+    if (ref.entry != 0){
+      result = dwarfconv_type_from_entry(ctx, ref, res);
     }
+    else{
+      result = cons_type_handled_nil(root);
+    }
+    cons_type_fill_id(root, res, result);
   }
   
-  // parse addr
-  DWARF_AddrParsed *addr = 0;
-  if (dwarf != 0){
-    String8 data = dwarf->debug_data[DWARF_SectionCode_Addr];
-    if (data.size) ProfScope("parse .debug_addr"){
-      addr = dwarf_addr_from_data(arena, data);
-      PARSE_CHECK_ERROR(addr, "DEBUG ADDR");
+  // fill records that were created while answering this request
+  if (!ctx->filling){
+    ctx->filling = 1;
+    for (;ctx->fill_first != 0;){
+      DWARFCONV_TypeFillNode *node = ctx->fill_first;
+      SLLQueuePop(ctx->fill_first, ctx->fill_last);
+      dwarfconv_type_fill_members(ctx, node);
     }
+    ctx->filling = 0;
   }
   
-#if 0
-  // parse abbrev
-  DWARF_AbbrevParsed *abbrev = 0;
-  if (dwarf != 0){
-    String8 data = dwarf->debug_data[DWARF_SectionCode_Abbrev];
-    if (data.size > 0) ProfScope("parse .debug_abbrev"){
-      DWARF_AbbrevParams abbrev_params = {0};
-      abbrev_params.unit_idx_min = params->unit_idx_min;
-      abbrev_params.unit_idx_max = params->unit_idx_max;
-      abbrev = dwarf_abbrev_from_data(arena, data, &abbrev_params);
-      PARSE_CHECK_ERROR(abbrev, "DEBUG ABBREV");
+  return(result);
+}
+
+static CONS_Type*
+dwarfconv_type_from_attrib(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref, DWARF_AttributeName name){
+  CONS_Type *result = ctx->void_type;
+  DWARFCONV_EntryRef owner = dwarfconv_attrib_owner(ctx, ref, name);
+  if (owner.entry != 0){
+    U64 info_off = dwarf_ref_from_attrib(&owner.unit->ctx, owner.entry, name);
+    if (info_off != 0){
+      result = dwarfconv_type_from_offset(ctx, info_off);
     }
   }
+  return(result);
+}
+
+static CONS_Type*
+dwarfconv_type_from_entry(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref, CONS_Reservation *res){
+  CONS_Root *root = ctx->root;
+  DWARF_UnitContext *uctx = &ref.unit->ctx;
+  DWARF_InfoEntry *entry = ref.entry;
   
-  // parse info
-  DWARF_InfoParsed *info = 0;
-  if (abbrev != 0){
-    String8 data = dwarf->debug_data[DWARF_SectionCode_Info];
-    if (data.size > 0) ProfScope("parse .debug_info"){
-      DWARF_InfoParams info_params = {0};
-      info_params.unit_idx_min = params->unit_idx_min;
-      info_params.unit_idx_max = params->unit_idx_max;
-      info = dwarf_info_from_data(arena, data, &info_params, abbrev);
-      PARSE_CHECK_ERROR(info, "DEBUG INFO");
-    }
-  }
-#endif
-  
-  // dump
-  if (params->dump) ProfScope("dump"){
-    String8List dump = {0};
-    
-    // ELF
-    if (params->dump_header){
-      if (elf != 0){
-        str8_list_push(arena, &dump,
-                       str8_lit("################################"
-                                "################################\n"
-                                "ELF:\n"));
-        
-        // TODO: better stringizers for fields here
-        str8_list_pushf(arena, &dump, " elf_class=%u\n", elf->elf_class);
-        str8_list_pushf(arena, &dump, " arch=%u\n", elf->arch);
-        str8_list_pushf(arena, &dump, " section_count=%llu\n", elf->section_count);
-        str8_list_pushf(arena, &dump, " segment_count=%llu\n", elf->segment_count);
-        str8_list_pushf(arena, &dump, " vbase=0x%llx\n", elf->vbase);
-        str8_list_pushf(arena, &dump, " entry_vaddr=0x%llx\n", elf->vbase);
-        
-        str8_list_push(arena, &dump, str8_lit("\n"));
-      }
-    }
+  CONS_Type *result = cons_type_handled_nil(root);
+  
+  String8 name = dwarf_string_from_attrib(uctx, entry, DWARF_AttributeName_name);
+  U64 byte_size = dwarf_u64_from_attrib(uctx, entry, DWARF_AttributeName_byte_size);
+  B32 is_declaration = (dwarf_u64_from_attrib(uctx, entry, DWARF_AttributeName_declaration) != 0);
+  
+  switch (entry->abbrev_decl->tag){
+    default:{}break;
     
-    // SECTIONS
-    if (params->dump_sections){
-      if (elf != 0){
-        ELF_SectionArray section_array = elf_section_array_from_elf(elf);
-        String8Array section_name_array = elf_section_name_array_from_elf(elf);
-        
-        str8_list_push(arena, &dump,
-                       str8_lit("################################"
-                                "################################\n"
-                                "SECTIONS:\n"));
-        
-        ELF_Shdr64 *sec = section_array.sections;
-        String8 *sec_name = section_name_array.strings;
-        U64 count = section_array.count;
-        for (U64 i = 0 ; i < count; i += 1, sec += 1, sec_name += 1){
-          String8 type_string = elf_string_from_section_type(sec->sh_type);
-          
-          // TODO: better stringizers for fields here
-          str8_list_pushf(arena, &dump, " section[%llu]:\n", i);
-          str8_list_pushf(arena, &dump, "  name='%.*s'\n", str8_varg(*sec_name));
-          str8_list_pushf(arena, &dump, "  type=%.*s\n", str8_varg(type_string));
-          str8_list_pushf(arena, &dump, "  flags=0x%llx\n", sec->sh_flags);
-          str8_list_pushf(arena, &dump, "  addr=0x%llx\n", sec->sh_addr);
-          str8_list_pushf(arena, &dump, "  offset=0x%llx\n", sec->sh_offset);
-          str8_list_pushf(arena, &dump, "  size=%llu\n", sec->sh_size);
-          str8_list_pushf(arena, &dump, "  link=%u\n", sec->sh_link);
-          str8_list_pushf(arena, &dump, "  info=%u\n", sec->sh_info);
-          str8_list_pushf(arena, &dump, "  addralign=0x%llx\n", sec->sh_addralign);
-          str8_list_pushf(arena, &dump, "  entsize=%llu\n", sec->sh_entsize);
-          str8_list_push(arena, &dump, str8_lit("\n"));
-        }
-      }
-    }
-    
-    // SYMTAB
-    if (symtab.count > 0 && params->dump_symtab){
-      str8_list_push(arena, &dump,
-                     str8_lit("################################"
-                              "################################\n"
-                              "SYMTAB:\n"));
-      str8_list_pushf(arena, &dump, " section: %llu\n", elf->symtab_idx);
-      dump_symtab(arena, &dump, &symtab, strtab, 1);
-      str8_list_push(arena, &dump, str8_lit("\n"));
-    }
-    
-    // DYNSYM
-    if (dynsym.count > 0 && params->dump_dynsym){
-      str8_list_push(arena, &dump,
-                     str8_lit("################################"
-                              "################################\n"
-                              "DYNSYM:\n"));
-      str8_list_pushf(arena, &dump, " section: %llu\n", elf->dynsym_idx);
-      dump_symtab(arena, &dump, &dynsym, strtab, 1);
-      str8_list_push(arena, &dump, str8_lit("\n"));
-    }
-    
-    // SEGMENTS
-    if (params->dump_segments){
-      if (elf != 0){
-        ELF_SegmentArray segment_array = elf_segment_array_from_elf(elf);
-        
-        str8_list_push(arena, &dump,
-                       str8_lit("################################"
-                                "################################\n"
-                                "SEGMENTS:\n"));
-        
-        ELF_Phdr64 *segments = segment_array.segments;
-        U64 count = segment_array.count;
-        for (U64 i = 0 ; i < count; i += 1){
-          ELF_Phdr64 *seg = segments + i;
-          
-          // TODO: better stringizers for fields here
-          str8_list_pushf(arena, &dump, " segment[%llu]:\n", i);
-          str8_list_pushf(arena, &dump, "  p_type=%u\n", seg->p_type);
-          str8_list_pushf(arena, &dump, "  p_flags=0x%x\n", seg->p_flags);
-          str8_list_pushf(arena, &dump, "  p_offset=0x%llx\n", seg->p_offset);
-          str8_list_pushf(arena, &dump, "  p_vaddr=0x%llx\n", seg->p_vaddr);
-          str8_list_pushf(arena, &dump, "  p_paddr=0x%llx\n", seg->p_paddr);
-          str8_list_pushf(arena, &dump, "  p_filesz=%llu\n", seg->p_filesz);
-          str8_list_pushf(arena, &dump, "  p_memsz=%llu\n", seg->p_memsz);
-          str8_list_pushf(arena, &dump, "  p_align=%llu\n", seg->p_align);
-          str8_list_push(arena, &dump, str8_lit("\n"));
-        }
-      }
-    }
-    
-    // DEBUG SECTIONS
-    if (params->dump_debug_sections){
-      if (dwarf != 0){
-        str8_list_push(arena, &dump,
-                       str8_lit("################################"
-                                "################################\n"
-                                "DEBUG SECTIONS:\n"));
-        
-        U32 *debug_section_idx = dwarf->debug_section_idx;
-        String8 *debug_data = dwarf->debug_data;
-        for (U32 i = 1; i < DWARF_SectionCode_COUNT; i += 1, debug_data += 1){
-          U32 idx = debug_section_idx[i];
-          String8 name = dwarf_string_from_section_code(i);
-          str8_list_pushf(arena, &dump, " %-10.*s section_idx=%u\n", str8_varg(name), idx);
-        }
-        str8_list_push(arena, &dump, str8_lit("\n"));
+    case DWARF_Tag_base_type:
+    {
+      U64 encoding = dwarf_u64_from_attrib(uctx, entry, DWARF_AttributeName_encoding);
+      RADDBG_TypeKind kind = dwarfconv_type_kind_from_base_type(encoding, byte_size, name);
+      if (kind != RADDBG_TypeKind_NULL){
+        result = cons_type_basic(root, kind, name);
       }
-    }
+    }break;
     
-    // DEBUG INFO
-    if (params->dump_debug_info){
-      if (info != 0){
-        str8_list_push(arena, &dump,
-                       str8_lit("################################"
-                                "################################\n"
-                                "DEBUG INFO:\n"));
-        
-        U32 i = 0;
-        for (DWARF_InfoUnit *unit = info->unit_first;
-             unit != 0;
-             unit = unit->next, i += 1){
-          str8_list_pushf(arena, &dump, " unit[%u]:\n", i);
-          dwarf_stringize_info(arena, &dump, unit, 2);
-          str8_list_push(arena, &dump, str8_lit("\n"));
-        }
-        
-      }
-    }
+    case DWARF_Tag_unspecified_type:
+    {
+      result = cons_type_basic(root, RADDBG_TypeKind_Void, name);
+    }break;
     
-    // DEBUG PUBNAMES
-    if (params->dump_debug_pubnames){
-      if (pubnames != 0){
-        str8_list_push(arena, &dump,
-                       str8_lit("################################"
-                                "################################\n"
-                                "DEBUG PUBNAMES:\n"));
-        
-        U32 i = 0;
-        for (DWARF_PubNamesUnit *unit = pubnames->unit_first;
-             unit != 0;
-             unit = unit->next, i += 1){
-          str8_list_pushf(arena, &dump, " unit[%u]:\n", i);
-          dwarf_stringize_pubnames(arena, &dump, unit, 2);
-          str8_list_push(arena, &dump, str8_lit("\n"));
-        }
-        
+    case DWARF_Tag_pointer_type:
+    case DWARF_Tag_reference_type:
+    case DWARF_Tag_rvalue_reference_type:
+    {
+      RADDBG_TypeKind kind = RADDBG_TypeKind_Ptr;
+      switch (entry->abbrev_decl->tag){
+        default:{}break;
+        case DWARF_Tag_reference_type:        kind = RADDBG_TypeKind_LRef; break;
+        case DWARF_Tag_rvalue_reference_type: kind = RADDBG_TypeKind_RRef; break;
       }
-    }
+      CONS_Type *direct = dwarfconv_type_from_attrib(ctx, ref, DWARF_AttributeName_type);
+      result = cons_type_pointer(root, direct, kind);
+    }break;
     
-    // DEBUG PUBTYPES
-    if (params->dump_debug_pubtypes){
-      if (pubtypes != 0){
-        str8_list_push(arena, &dump,
-                       str8_lit("################################"
-                                "################################\n"
-                                "DEBUG PUBTYPES:\n"));
-        
-        U32 i = 0;
-        for (DWARF_PubNamesUnit *unit = pubtypes->unit_first;
-             unit != 0;
-             unit = unit->next, i += 1){
-          str8_list_pushf(arena, &dump, " unit[%u]:\n", i);
-          dwarf_stringize_pubnames(arena, &dump, unit, 2);
-          str8_list_push(arena, &dump, str8_lit("\n"));
-        }
-        
-      }
-    }
+    case DWARF_Tag_const_type:
+    case DWARF_Tag_volatile_type:
+    {
+      RADDBG_TypeModifierFlags flags = ((entry->abbrev_decl->tag == DWARF_Tag_const_type)?
+                                        RADDBG_TypeModifierFlag_Const:
+                                        RADDBG_TypeModifierFlag_Volatile);
+      CONS_Type *direct = dwarfconv_type_from_attrib(ctx, ref, DWARF_AttributeName_type);
+      result = cons_type_modifier(root, direct, flags);
+    }break;
     
-    // DEBUG NAMES
-    if (params->dump_debug_names){
-      if (names != 0){
-        str8_list_push(arena, &dump,
-                       str8_lit("################################"
-                                "################################\n"
-                                "DEBUG NAMES:\n"));
-        
-        U32 i = 0;
-        for (DWARF_NamesUnit *unit = names->unit_first;
-             unit != 0;
-             unit = unit->next, i += 1){
-          str8_list_pushf(arena, &dump, " unit[%u]:\n", i);
-          dwarf_stringize_names(arena, &dump, unit, 2);
-          str8_list_push(arena, &dump, str8_lit("\n"));
-        }
+    // qualifiers with no raddbg equivalent
+    case DWARF_Tag_restrict_type:
+    case DWARF_Tag_atomic_type:
+    case DWARF_Tag_immutable_type:
+    case DWARF_Tag_packed_type:
+    case DWARF_Tag_shared_type:
+    {
+      result = dwarfconv_type_from_attrib(ctx, ref, DWARF_AttributeName_type);
+    }break;
+    
+    case DWARF_Tag_typedef:
+    {
+      CONS_Type *direct = dwarfconv_type_from_attrib(ctx, ref, DWARF_AttributeName_type);
+      result = cons_type_alias(root, direct, dwarfconv_qualified_name(ctx, ref, name));
+    }break;
+    
+    case DWARF_Tag_structure_type:
+    case DWARF_Tag_class_type:
+    case DWARF_Tag_union_type:
+    {
+      RADDBG_TypeKind kind = RADDBG_TypeKind_Struct;
+      RADDBG_TypeKind incomplete_kind = RADDBG_TypeKind_IncompleteStruct;
+      switch (entry->abbrev_decl->tag){
+        default:{}break;
+        case DWARF_Tag_class_type:
+        {
+          kind = RADDBG_TypeKind_Class;
+          incomplete_kind = RADDBG_TypeKind_IncompleteClass;
+        }break;
+        case DWARF_Tag_union_type:
+        {
+          kind = RADDBG_TypeKind_Union;
+          incomplete_kind = RADDBG_TypeKind_IncompleteUnion;
+        }break;
+      }
+      
+      String8 qualified_name = dwarfconv_qualified_name(ctx, ref, name);
+      if (is_declaration){
+        result = cons_type_incomplete(root, incomplete_kind, qualified_name);
+      }
+      else{
+        result = cons_type_udt(root, kind, qualified_name, byte_size);
         
+        // publish before members so self references resolve to this record
+        cons_type_fill_id(root, res, result);
+        DWARFCONV_TypeFillNode *node = push_array(ctx->arena, DWARFCONV_TypeFillNode, 1);
+        SLLQueuePush(ctx->fill_first, ctx->fill_last, node);
+        node->ref = ref;
+        node->type = result;
       }
-    }
+    }break;
     
-    // DEBUG ARANGES
-    if (params->dump_debug_aranges){
-      if (aranges != 0){
-        str8_list_push(arena, &dump,
-                       str8_lit("################################"
-                                "################################\n"
-                                "DEBUG ARANGES:\n"));
-        
-        U32 i = 0;
-        for (DWARF_ArangesUnit *unit = aranges->unit_first;
-             unit != 0;
-             unit = unit->next, i += 1){
-          str8_list_pushf(arena, &dump, " unit[%u]:\n", i);
-          dwarf_stringize_aranges(arena, &dump, unit, 2);
-          str8_list_push(arena, &dump, str8_lit("\n"));
+    case DWARF_Tag_enumeration_type:
+    {
+      String8 qualified_name = dwarfconv_qualified_name(ctx, ref, name);
+      if (is_declaration){
+        result = cons_type_incomplete(root, RADDBG_TypeKind_IncompleteEnum, qualified_name);
+      }
+      else{
+        // underlying type; pre-DWARF3 producers only give the size
+        CONS_Type *direct = 0;
+        if (dwarf_entry_has_attrib(entry, DWARF_AttributeName_type)){
+          direct = dwarfconv_type_from_attrib(ctx, ref, DWARF_AttributeName_type);
+        }
+        else{
+          RADDBG_TypeKind kind = dwarfconv_type_kind_from_base_type(DWARF_BaseType_unsigned,
+                                                                    byte_size, str8_lit(""));
+          if (kind == RADDBG_TypeKind_NULL){
+            kind = RADDBG_TypeKind_U32;
+          }
+          direct = cons_type_basic(root, kind, str8_lit(""));
         }
         
+        result = cons_type_enum(root, direct, qualified_name);
+        for (DWARF_InfoEntry *child = entry->first_child; child != 0; child = child->next_sibling){
+          if (child->abbrev_decl->tag == DWARF_Tag_enumerator){
+            String8 val_name = dwarf_string_from_attrib(uctx, child, DWARF_AttributeName_name);
+            U64 val = (U64)dwarf_s64_from_attrib(uctx, child, DWARF_AttributeName_const_value);
+            cons_type_add_enum_val(root, result, val_name, val);
+          }
+        }
       }
-    }
+    }break;
     
-    // DEBUG ADDR
-    if (params->dump_debug_addr){
-      if (addr != 0){
-        str8_list_push(arena, &dump,
-                       str8_lit("################################"
-                                "################################\n"
-                                "DEBUG ADDR:\n"));
-        
-        U32 i = 0;
-        for (DWARF_AddrUnit *unit = addr->unit_first;
-             unit != 0;
-             unit = unit->next, i += 1){
-          str8_list_pushf(arena, &dump, " unit[%u]:\n", i);
-          dwarf_stringize_addr(arena, &dump, unit, 2);
-          str8_list_push(arena, &dump, str8_lit("\n"));
+    case DWARF_Tag_array_type:
+    {
+      Temp scratch = scratch_begin(&ctx->arena, 1);
+      
+      // gather dimensions
+      U64 dim_count = 0;
+      for (DWARF_InfoEntry *child = entry->first_child; child != 0; child = child->next_sibling){
+        if (child->abbrev_decl->tag == DWARF_Tag_subrange_type){
+          dim_count += 1;
         }
-        
       }
-    }
-    
-#if 0
-    // DEBUG ABBREV
-    if (params->dump_debug_abbrev){
-      if (abbrev != 0){
-        str8_list_push(arena, &dump,
-                       str8_lit("################################"
-                                "################################\n"
-                                "DEBUG ABBREV:\n"));
-        
-        U32 i = 0;
-        for (DWARF_AbbrevUnit *unit = abbrev->unit_first;
-             unit != 0;
-             unit = unit->next, i += 1){
-          U32 j = 0;
-          for (DWARF_AbbrevDecl *abbrev_decl = unit->first;
-               abbrev_decl != 0;
-               abbrev_decl = abbrev_decl->next, j += 1){
-            String8 tag_string = dwarf_string_from_tag(abbrev_decl->tag);
-            
-            str8_list_pushf(arena, &dump, " unit[%u],abbrev[%u]:\n", i, j);
-            str8_list_pushf(arena, &dump, "  code=%llu\n", abbrev_decl->abbrev_code);
-            str8_list_pushf(arena, &dump, "  tag=%.*s\n", str8_varg(tag_string));
-            str8_list_pushf(arena, &dump, "  has_children=%u\n", abbrev_decl->has_children);
-            str8_list_pushf(arena, &dump, "  attrib_count=%u\n", abbrev_decl->attrib_count);
-            str8_list_pushf(arena, &dump, "  attribs:\n", abbrev_decl->attrib_count);
-            
-            U32 attrib_count = abbrev_decl->attrib_count;
-            DWARF_AbbrevAttribSpec *attrib_spec = abbrev_decl->attrib_specs;
-            for (U32 k = 0; k < attrib_count; k += 1, attrib_spec += 1){
-              String8 name_string = dwarf_string_from_attribute_name(attrib_spec->name);
-              String8 form_string = dwarf_string_from_attribute_form(attrib_spec->form);
-              
-              str8_list_pushf(arena, &dump, "   [%-14.*s %-10.*s]\n", 
-                              str8_varg(name_string), str8_varg(form_string));
+      U64 *dims = push_array(scratch.arena, U64, dim_count);
+      {
+        U64 dim_idx = 0;
+        for (DWARF_InfoEntry *child = entry->first_child; child != 0; child = child->next_sibling){
+          if (child->abbrev_decl->tag == DWARF_Tag_subrange_type){
+            U64 count = 0;
+            DWARF_AttributeClassFlags count_class =
+              dwarf_attribute_class_from_form(dwarf_form_from_attrib(child, DWARF_AttributeName_count));
+            DWARF_AttributeClassFlags upper_class =
+              dwarf_attribute_class_from_form(dwarf_form_from_attrib(child, DWARF_AttributeName_upper_bound));
+            if (count_class & DWARF_AttributeClassFlag_constant){
+              count = dwarf_u64_from_attrib(uctx, child, DWARF_AttributeName_count);
+            }
+            else if (upper_class & DWARF_AttributeClassFlag_constant){
+              S64 lower = dwarf_s64_from_attrib(uctx, child, DWARF_AttributeName_lower_bound);
+              S64 upper = dwarf_s64_from_attrib(uctx, child, DWARF_AttributeName_upper_bound);
+              if (upper >= lower){
+                count = (U64)(upper - lower + 1);
+              }
             }
-            
-            str8_list_push(arena, &dump, str8_lit("\n"));
+            dims[dim_idx] = count;
+            dim_idx += 1;
           }
         }
-        
       }
-    }
-#endif
-    
-#if 0
-    // DEBUG INFO
-    if (params->dump_debug_info){
-      if (info != 0){
-        str8_list_push(arena, &dump,
-                       str8_lit("################################"
-                                "################################\n"
-                                "DEBUG INFO:\n"));
-        
-        U32 i = 0;
-        for (DWARF_InfoUnit *unit = info->unit_first;
-             unit != 0;
-             unit = unit->next, i += 1){
-          str8_list_pushf(arena, &dump, " unit[%u]:\n", i);
-          str8_list_pushf(arena, &dump, "  [header]\n");
-          str8_list_pushf(arena, &dump, "  version=%u\n", unit->dwarf_version);
-          str8_list_pushf(arena, &dump, "  offset_size=%u\n", unit->offset_size);
-          str8_list_pushf(arena, &dump, "  address_size=%u\n", unit->address_size);
-          str8_list_pushf(arena, &dump, "  [extracted attributes]\n");
-          str8_list_pushf(arena, &dump, "  langauge=%u\n", (U32)unit->language);
-          str8_list_pushf(arena, &dump, "  line_info_offset=%llu\n", unit->line_info_offset);
-          str8_list_pushf(arena, &dump, "  vbase=0x%llx\n", unit->vbase);
-          str8_list_pushf(arena, &dump, "  str_offsets_base=%llu\n", unit->str_offsets_base);
-          str8_list_pushf(arena, &dump, "  addr_base=%llu\n", unit->addr_base);
-          str8_list_pushf(arena, &dump, "  rnglists_base=%llu\n", unit->rnglists_base);
-          str8_list_pushf(arena, &dump, "  loclists_base=%llu\n", unit->loclists_base);
-          dump_entry_tree(arena, &dump, dwarf, unit, unit->entry_root, 2);
-          str8_list_push(arena, &dump, str8_lit("\n"));
-        }
-        
+      
+      // build from the innermost dimension out
+      CONS_Type *element = dwarfconv_type_from_attrib(ctx, ref, DWARF_AttributeName_type);
+      result = element;
+      for (U64 i = dim_count; i > 0; i -= 1){
+        result = cons_type_array(root, result, dims[i - 1]);
       }
-    }
-#endif
+      if (dim_count == 0){
+        result = cons_type_array(root, element, 0);
+      }
+      
+      scratch_end(scratch);
+    }break;
     
-    // print dump
-    for (String8Node *node = dump.first;
-         node != 0;
-         node = node->next){
-      fwrite(node->string.str, 1, node->string.size, stdout);
-    }
+    case DWARF_Tag_subroutine_type:
+    {
+      result = dwarfconv_proc_type_from_entry(ctx, ref, 0);
+    }break;
   }
   
-  ProfEndCapture();
-  return(0);
+  return(result);
+}
+
+static CONS_Type*
+dwarfconv_proc_type_from_entry(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref, CONS_Type **this_type_out){
+  CONS_Root *root = ctx->root;
+  
+  // out-of-line definitions may omit the parameter list; take it from
+  //  the entry they point back at
+  DWARFCONV_EntryRef params_ref = ref;
+  for (U32 hop = 0; hop < 8 && params_ref.entry->first_child == 0; hop += 1){
+    U64 next_off = dwarf_ref_from_attrib(&params_ref.unit->ctx, params_ref.entry,
+                                         DWARF_AttributeName_specification);
+    if (next_off == 0){
+      next_off = dwarf_ref_from_attrib(&params_ref.unit->ctx, params_ref.entry,
+                                       DWARF_AttributeName_abstract_origin);
+    }
+    DWARFCONV_EntryRef next = dwarfconv_entry_from_offset(ctx, next_off);
+    if (next.entry == 0){
+      break;
+    }
+    params_ref = next;
+  }
+  
+  CONS_Type *ret_type = dwarfconv_type_from_attrib(ctx, ref, DWARF_AttributeName_type);
+  CONS_Type *this_type = 0;
+  CONS_TypeList params = {0};
+  for (DWARF_InfoEntry *child = params_ref.entry->first_child; child != 0; child = child->next_sibling){
+    DWARFCONV_EntryRef child_ref = {params_ref.unit, child};
+    switch (child->abbrev_decl->tag){
+      default:{}break;
+      case DWARF_Tag_formal_parameter:
+      {
+        CONS_Type *param_type = dwarfconv_type_from_attrib(ctx, child_ref, DWARF_AttributeName_type);
+        DWARFCONV_EntryRef artificial = dwarfconv_attrib_owner(ctx, child_ref, DWARF_AttributeName_artificial);
+        B32 is_artificial = (dwarf_u64_from_attrib(&artificial.unit->ctx, artificial.entry,
+                                                   DWARF_AttributeName_artificial) != 0);
+        if (this_type_out != 0 && is_artificial && this_type == 0 && params.count == 0){
+          this_type = param_type;
+        }
+        else{
+          cons_type_list_push(ctx->arena, &params, param_type);
+        }
+      }break;
+      case DWARF_Tag_unspecified_parameters:
+      {
+        cons_type_list_push(ctx->arena, &params, cons_type_variadic(root));
+      }break;
+    }
+  }
+  
+  CONS_Type *result = 0;
+  if (this_type != 0){
+    result = cons_type_method(root, this_type, ret_type, &params);
+  }
+  else{
+    result = cons_type_proc(root, ret_type, &params);
+  }
+  if (this_type_out != 0){
+    *this_type_out = this_type;
+  }
+  return(result);
+}
+
+static U64
+dwarfconv_member_offset_from_entry(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref){
+  // member locations are constants, or 'DW_OP_plus_uconst n' from older producers
+  U64 result = 0;
+  DWARF_UnitContext *uctx = &ref.unit->ctx;
+  DWARF_AttributeForm form = dwarf_form_from_attrib(ref.entry, DWARF_AttributeName_data_member_location);
+  DWARF_AttributeClassFlags form_class = dwarf_attribute_class_from_form(form);
+  if (form_class & DWARF_AttributeClassFlag_constant){
+    result = dwarf_u64_from_attrib(uctx, ref.entry, DWARF_AttributeName_data_member_location);
+  }
+  else{
+    String8 expr = dwarf_block_from_attrib(uctx, ref.entry, DWARF_AttributeName_data_member_location);
+    U8 *ptr = expr.str;
+    U8 *opl = expr.str + expr.size;
+    if (ptr < opl && *ptr == DWARF_Op_plus_uconst){
+      ptr += 1;
+      DWARF_LEB128_DECODE_ADV(U64, result, ptr, opl);
+    }
+  }
+  return(result);
+}
+
+static void
+dwarfconv_type_fill_members(DWARFCONV_Ctx *ctx, DWARFCONV_TypeFillNode *node){
+  CONS_Root *root = ctx->root;
+  DWARFCONV_EntryRef ref = node->ref;
+  DWARF_UnitContext *uctx = &ref.unit->ctx;
+  CONS_Type *type = node->type;
+  
+  for (DWARF_InfoEntry *child = ref.entry->first_child; child != 0; child = child->next_sibling){
+    DWARFCONV_EntryRef child_ref = {ref.unit, child};
+    String8 name = dwarf_string_from_attrib(uctx, child, DWARF_AttributeName_name);
+    
+    switch (child->abbrev_decl->tag){
+      default:{}break;
+      
+      case DWARF_Tag_member:
+      {
+        CONS_Type *mem_type = dwarfconv_type_from_attrib(ctx, child_ref, DWARF_AttributeName_type);
+        B32 is_static = (dwarf_u64_from_attrib(uctx, child, DWARF_AttributeName_declaration) != 0 ||
+                         dwarf_u64_from_attrib(uctx, child, DWARF_AttributeName_external) != 0);
+        if (is_static){
+          cons_type_add_member_static_data(root, type, name, mem_type);
+        }
+        else{
+          U64 off = dwarfconv_member_offset_from_entry(ctx, child_ref);
+          
+          // bitfields
+          if (dwarf_entry_has_attrib(child, DWARF_AttributeName_bit_size)){
+            U64 bit_size = dwarf_u64_from_attrib(uctx, child, DWARF_AttributeName_bit_size);
+            U64 storage_size = ClampBot(mem_type->byte_size, 1);
+            U64 bit_off = 0;
+            if (dwarf_entry_has_attrib(child, DWARF_AttributeName_data_bit_offset)){
+              U64 total_bit_off = dwarf_u64_from_attrib(uctx, child, DWARF_AttributeName_data_bit_offset);
+              off = (total_bit_off/(storage_size*8))*storage_size;
+              bit_off = total_bit_off - off*8;
+            }
+            else if (dwarf_entry_has_attrib(child, DWARF_AttributeName_bit_offset)){
+              // DWARF2/3 count from the most significant bit of the storage unit
+              if (dwarf_entry_has_attrib(child, DWARF_AttributeName_byte_size)){
+                storage_size = dwarf_u64_from_attrib(uctx, child, DWARF_AttributeName_byte_size);
+              }
+              U64 msb_off = dwarf_u64_from_attrib(uctx, child, DWARF_AttributeName_bit_offset);
+              bit_off = storage_size*8 - msb_off - bit_size;
+            }
+            mem_type = cons_type_bitfield(root, mem_type, (U32)bit_off, (U32)bit_size);
+          }
+          
+          cons_type_add_member_data_field(root, type, name, mem_type, (U32)off);
+        }
+      }break;
+      
+      // DWARF5 static data members
+      case DWARF_Tag_variable:
+      {
+        CONS_Type *mem_type = dwarfconv_type_from_attrib(ctx, child_ref, DWARF_AttributeName_type);
+        cons_type_add_member_static_data(root, type, name, mem_type);
+      }break;
+      
+      case DWARF_Tag_inheritance:
+      {
+        CONS_Type *base_type = dwarfconv_type_from_attrib(ctx, child_ref, DWARF_AttributeName_type);
+        if (dwarf_u64_from_attrib(uctx, child, DWARF_AttributeName_virtuality) != 0){
+          cons_type_add_member_virtual_base(root, type, base_type, 0, 0);
+        }
+        else{
+          U64 off = dwarfconv_member_offset_from_entry(ctx, child_ref);
+          cons_type_add_member_base(root, type, base_type, (U32)off);
+        }
+      }break;
+      
+      case DWARF_Tag_subprogram:
+      {
+        CONS_Type *this_type = 0;
+        CONS_Type *method_type = dwarfconv_proc_type_from_entry(ctx, child_ref, &this_type);
+        if (this_type == 0){
+          cons_type_add_member_static_method(root, type, name, method_type);
+        }
+        else if (dwarf_u64_from_attrib(uctx, child, DWARF_AttributeName_virtuality) != 0){
+          cons_type_add_member_virtual_method(root, type, name, method_type);
+        }
+        else{
+          cons_type_add_member_method(root, type, name, method_type);
+        }
+      }break;
+      
+      case DWARF_Tag_structure_type:
+      case DWARF_Tag_class_type:
+      case DWARF_Tag_union_type:
+      case DWARF_Tag_enumeration_type:
+      case DWARF_Tag_typedef:
+      {
+        CONS_Type *nested_type = dwarfconv_type_from_offset(ctx, child->info_offset);
+        cons_type_add_member_nested_type(root, type, nested_type);
+      }break;
+    }
+  }
+}
+
+//- locations
+
+static DWARFCONV_FrameBase
+dwarfconv_frame_base_from_expr(DWARFCONV_Ctx *ctx, String8 expr){
+  DWARFCONV_FrameBase result = {0};
+  U8 *ptr = expr.str;
+  U8 *opl = expr.str + expr.size;
+  if (ptr < opl){
+    U8 op = *ptr;
+    ptr += 1;
+    if (DWARF_Op_reg0 <= op && op <= DWARF_Op_reg31){
+      result.reg_code = dwarfconv_reg_code_from_dwarf_reg(ctx->arch, op - DWARF_Op_reg0);
+    }
+    else if (DWARF_Op_breg0 <= op && op <= DWARF_Op_breg31){
+      S64 off = 0;
+      DWARF_LEB128_DECODE_ADV(S64, off, ptr, opl);
+      result.reg_code = dwarfconv_reg_code_from_dwarf_reg(ctx->arch, op - DWARF_Op_breg0);
+      result.off = off;
+    }
+    else if (op == DWARF_Op_call_frame_cfa){
+      result.is_cfa = 1;
+    }
+    result.valid = ((result.is_cfa || result.reg_code != 0) && ptr == opl);
+  }
+  return(result);
+}
+
+static DWARFCONV_FrameBase
+dwarfconv_cfa_from_row(DWARFCONV_Ctx *ctx, DWARF_CFARow *row){
+  DWARFCONV_FrameBase result = {0};
+  if (!row->is_expr){
+    result.reg_code = dwarfconv_reg_code_from_dwarf_reg(ctx->arch, row->reg);
+    result.off = row->off;
+    result.valid = (result.reg_code != 0);
+  }
+  return(result);
+}
+
+static CONS_Location*
+dwarfconv_location_from_addr_reg_off(DWARFCONV_Ctx *ctx, RADDBG_RegisterCode reg_code, S64 offset){
+  CONS_Location *result = 0;
+  if (0 <= offset && offset <= max_U16){
+    result = cons_location_addr_reg_plus_u16(ctx->root, reg_code, (U16)offset);
+  }
+  else{
+    CONS_EvalBytecode bytecode = {0};
+    U32 regread_param = RADDBG_EncodeRegReadParam(reg_code, ctx->addr_size, 0);
+    cons_bytecode_push_op(ctx->arena, &bytecode, RADDBG_EvalOp_RegRead, regread_param);
+    cons_bytecode_push_sconst(ctx->arena, &bytecode, offset);
+    cons_bytecode_push_op(ctx->arena, &bytecode, RADDBG_EvalOp_Add, RADDBG_EvalTypeGroup_U);
+    result = cons_location_addr_bytecode_stream(ctx->root, &bytecode);
+  }
+  return(result);
+}
+
+static CONS_Location*
+dwarfconv_location_from_expr(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref, String8 expr,
+                             DWARFCONV_FrameBase *frame_base,
+                             DWARFCONV_FrameBase *cfa, B32 *uses_cfa_out){
+  CONS_Location *result = 0;
+  DWARF_UnitContext *uctx = &ref.unit->ctx;
+  U64 addr_size = uctx->unit->address_size;
+  U8 *ptr = expr.str;
+  U8 *opl = expr.str + expr.size;
+  
+  // resolve the frame base against the CFA of the range being converted
+  DWARFCONV_FrameBase fb = {0};
+  if (frame_base != 0){
+    fb = *frame_base;
+  }
+  if (fb.valid && fb.is_cfa){
+    DWARFCONV_FrameBase cfa_fb = {0};
+    if (cfa != 0 && cfa->valid){
+      cfa_fb = *cfa;
+      cfa_fb.off += fb.off;
+    }
+    fb = cfa_fb;
+  }
+  
+  // single op forms that have direct location encodings
+  if (ptr < opl){
+    U8 op = *ptr;
+    U8 *after = ptr + 1;
+    if (DWARF_Op_reg0 <= op && op <= DWARF_Op_reg31 && after == opl){
+      RADDBG_RegisterCode reg_code = dwarfconv_reg_code_from_dwarf_reg(ctx->arch, op - DWARF_Op_reg0);
+      if (reg_code != 0){
+        result = cons_location_val_reg(ctx->root, reg_code);
+      }
+      goto done;
+    }
+    if (op == DWARF_Op_regx){
+      U64 reg = 0;
+      DWARF_LEB128_DECODE_ADV(U64, reg, after, opl);
+      if (after == opl){
+        RADDBG_RegisterCode reg_code = dwarfconv_reg_code_from_dwarf_reg(ctx->arch, reg);
+        if (reg_code != 0){
+          result = cons_location_val_reg(ctx->root, reg_code);
+        }
+        goto done;
+      }
+    }
+    if (DWARF_Op_breg0 <= op && op <= DWARF_Op_breg31){
+      S64 off = 0;
+      DWARF_LEB128_DECODE_ADV(S64, off, after, opl);
+      if (after == opl){
+        RADDBG_RegisterCode reg_code = dwarfconv_reg_code_from_dwarf_reg(ctx->arch, op - DWARF_Op_breg0);
+        if (reg_code != 0){
+          result = dwarfconv_location_from_addr_reg_off(ctx, reg_code, off);
+        }
+        goto done;
+      }
+    }
+    if (op == DWARF_Op_fbreg){
+      S64 off = 0;
+      DWARF_LEB128_DECODE_ADV(S64, off, after, opl);
+      if (after == opl){
+        if (frame_base != 0 && frame_base->is_cfa){
+          *uses_cfa_out = 1;
+        }
+        if (fb.valid){
+          result = dwarfconv_location_from_addr_reg_off(ctx, fb.reg_code, fb.off + off);
+        }
+        goto done;
+      }
+    }
+  }
+  
+  // general expressions
+  {
+    Arena *arena = ctx->arena;
+    CONS_EvalBytecode bytecode = {0};
+    B32 is_value = 0;
+    B32 good = 1;
+    for (;good && ptr < opl;){
+      U8 op = *ptr;
+      ptr += 1;
+      
+      if (DWARF_Op_lit0 <= op && op <= DWARF_Op_lit31){
+        cons_bytecode_push_uconst(arena, &bytecode, op - DWARF_Op_lit0);
+        continue;
+      }
+      if (DWARF_Op_breg0 <= op && op <= DWARF_Op_breg31){
+        S64 off = 0;
+        DWARF_LEB128_DECODE_ADV(S64, off, ptr, opl);
+        RADDBG_RegisterCode reg_code = dwarfconv_reg_code_from_dwarf_reg(ctx->arch, op - DWARF_Op_breg0);
+        if (reg_code == 0){
+          good = 0;
+        }
+        else{
+          U32 regread_param = RADDBG_EncodeRegReadParam(reg_code, ctx->addr_size, 0);
+          cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_RegRead, regread_param);
+          cons_bytecode_push_sconst(arena, &bytecode, off);
+          cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Add, RADDBG_EvalTypeGroup_U);
+        }
+        continue;
+      }
+      
+      switch (op){
+        default:
+        {
+          // DW_OP_reg*, DW_OP_piece, typed stack ops, etc.
+          good = 0;
+        }break;
+        
+        case DWARF_Op_nop:{}break;
+        
+        case DWARF_Op_addr:
+        {
+          U64 addr = 0;
+          if (ptr + addr_size <= opl){
+            MemoryCopy(&addr, ptr, addr_size);
+          }
+          ptr += addr_size;
+          if (addr < ctx->vbase){
+            good = 0;
+          }
+          else{
+            cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_ModuleOff, addr - ctx->vbase);
+          }
+        }break;
+        
+        case DWARF_Op_addrx:
+        case DWARF_Op_constx:
+        {
+          U64 idx = 0;
+          DWARF_LEB128_DECODE_ADV(U64, idx, ptr, opl);
+          U64 addr = dwarf_address_from_idx(uctx, idx);
+          if (op == DWARF_Op_constx){
+            cons_bytecode_push_uconst(arena, &bytecode, addr);
+          }
+          else if (addr < ctx->vbase){
+            good = 0;
+          }
+          else{
+            cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_ModuleOff, addr - ctx->vbase);
+          }
+        }break;
+        
+        case DWARF_Op_const1u:
+        case DWARF_Op_const2u:
+        case DWARF_Op_const4u:
+        case DWARF_Op_const8u:
+        case DWARF_Op_const1s:
+        case DWARF_Op_const2s:
+        case DWARF_Op_const4s:
+        case DWARF_Op_const8s:
+        {
+          U64 size = 0;
+          B32 is_signed = 0;
+          switch (op){
+            case DWARF_Op_const1u: size = 1; break;
+            case DWARF_Op_const2u: size = 2; break;
+            case DWARF_Op_const4u: size = 4; break;
+            case DWARF_Op_const8u: size = 8; break;
+            case DWARF_Op_const1s: size = 1; is_signed = 1; break;
+            case DWARF_Op_const2s: size = 2; is_signed = 1; break;
+            case DWARF_Op_const4s: size = 4; is_signed = 1; break;
+            case DWARF_Op_const8s: size = 8; is_signed = 1; break;
+          }
+          U64 x = 0;
+          if (ptr + size <= opl){
+            MemoryCopy(&x, ptr, size);
+          }
+          ptr += size;
+          if (is_signed && size < 8 && (x & (1ull << (size*8 - 1))) != 0){
+            x |= ~((1ull << (size*8)) - 1);
+          }
+          cons_bytecode_push_uconst(arena, &bytecode, x);
+        }break;
+        
+        case DWARF_Op_constu:
+        {
+          U64 x = 0;
+          DWARF_LEB128_DECODE_ADV(U64, x, ptr, opl);
+          cons_bytecode_push_uconst(arena, &bytecode, x);
+        }break;
+        
+        case DWARF_Op_consts:
+        {
+          S64 x = 0;
+          DWARF_LEB128_DECODE_ADV(S64, x, ptr, opl);
+          cons_bytecode_push_sconst(arena, &bytecode, x);
+        }break;
+        
+        case DWARF_Op_fbreg:
+        {
+          S64 off = 0;
+          DWARF_LEB128_DECODE_ADV(S64, off, ptr, opl);
+          if (frame_base != 0 && frame_base->is_cfa){
+            *uses_cfa_out = 1;
+          }
+          if (!fb.valid){
+            good = 0;
+          }
+          else{
+            U32 regread_param = RADDBG_EncodeRegReadParam(fb.reg_code, ctx->addr_size, 0);
+            cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_RegRead, regread_param);
+            cons_bytecode_push_sconst(arena, &bytecode, fb.off + off);
+            cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Add, RADDBG_EvalTypeGroup_U);
+          }
+        }break;
+        
+        case DWARF_Op_bregx:
+        {
+          U64 reg = 0;
+          S64 off = 0;
+          DWARF_LEB128_DECODE_ADV(U64, reg, ptr, opl);
+          DWARF_LEB128_DECODE_ADV(S64, off, ptr, opl);
+          RADDBG_RegisterCode reg_code = dwarfconv_reg_code_from_dwarf_reg(ctx->arch, reg);
+          if (reg_code == 0){
+            good = 0;
+          }
+          else{
+            U32 regread_param = RADDBG_EncodeRegReadParam(reg_code, ctx->addr_size, 0);
+            cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_RegRead, regread_param);
+            cons_bytecode_push_sconst(arena, &bytecode, off);
+            cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Add, RADDBG_EvalTypeGroup_U);
+          }
+        }break;
+        
+        case DWARF_Op_call_frame_cfa:
+        {
+          *uses_cfa_out = 1;
+          if (cfa == 0 || !cfa->valid){
+            good = 0;
+          }
+          else{
+            U32 regread_param = RADDBG_EncodeRegReadParam(cfa->reg_code, ctx->addr_size, 0);
+            cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_RegRead, regread_param);
+            cons_bytecode_push_sconst(arena, &bytecode, cfa->off);
+            cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Add, RADDBG_EvalTypeGroup_U);
+          }
+        }break;
+        
+        case DWARF_Op_form_tls_address:
+        case DWARF_Op_GNU_push_tls_address:
+        {
+          cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_TLSOff, 0);
+          cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Add, RADDBG_EvalTypeGroup_U);
+        }break;
+        
+        case DWARF_Op_deref:
+        {
+          cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_MemRead, addr_size);
+        }break;
+        
+        case DWARF_Op_deref_size:
+        {
+          U8 size = (ptr < opl)?*ptr:0;
+          ptr += 1;
+          cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_MemRead, size);
+        }break;
+        
+        // stack manipulation
+        case DWARF_Op_dup:  cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Pick, 0); break;
+        case DWARF_Op_over: cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Pick, 1); break;
+        case DWARF_Op_drop: cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Pop, 0); break;
+        case DWARF_Op_swap: cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Insert, 1); break;
+        case DWARF_Op_rot:  cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Insert, 2); break;
+        case DWARF_Op_pick:
+        {
+          U8 idx = (ptr < opl)?*ptr:0;
+          ptr += 1;
+          cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Pick, idx);
+        }break;
+        
+        // arithmetic
+        case DWARF_Op_plus_uconst:
+        {
+          U64 x = 0;
+          DWARF_LEB128_DECODE_ADV(U64, x, ptr, opl);
+          cons_bytecode_push_uconst(arena, &bytecode, x);
+          cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Add, RADDBG_EvalTypeGroup_U);
+        }break;
+        
+        case DWARF_Op_abs:   cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Abs,    RADDBG_EvalTypeGroup_S); break;
+        case DWARF_Op_neg:   cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Neg,    RADDBG_EvalTypeGroup_S); break;
+        case DWARF_Op_not:   cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_BitNot, RADDBG_EvalTypeGroup_U); break;
+        case DWARF_Op_and:   cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_BitAnd, RADDBG_EvalTypeGroup_U); break;
+        case DWARF_Op_or:    cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_BitOr,  RADDBG_EvalTypeGroup_U); break;
+        case DWARF_Op_xor:   cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_BitXor, RADDBG_EvalTypeGroup_U); break;
+        case DWARF_Op_plus:  cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Add,    RADDBG_EvalTypeGroup_U); break;
+        case DWARF_Op_minus: cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Sub,    RADDBG_EvalTypeGroup_U); break;
+        case DWARF_Op_mul:   cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Mul,    RADDBG_EvalTypeGroup_U); break;
+        case DWARF_Op_div:   cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Div,    RADDBG_EvalTypeGroup_S); break;
+        case DWARF_Op_mod:   cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Mod,    RADDBG_EvalTypeGroup_U); break;
+        case DWARF_Op_shl:   cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_LShift, RADDBG_EvalTypeGroup_U); break;
+        case DWARF_Op_shr:   cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_RShift, RADDBG_EvalTypeGroup_U); break;
+        case DWARF_Op_shra:  cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_RShift, RADDBG_EvalTypeGroup_S); break;
+        
+        // comparisons
+        case DWARF_Op_eq: cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_EqEq, RADDBG_EvalTypeGroup_S); break;
+        case DWARF_Op_ne: cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_NtEq, RADDBG_EvalTypeGroup_S); break;
+        case DWARF_Op_lt: cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Less, RADDBG_EvalTypeGroup_S); break;
+        case DWARF_Op_gt: cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_Grtr, RADDBG_EvalTypeGroup_S); break;
+        case DWARF_Op_le: cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_LsEq, RADDBG_EvalTypeGroup_S); break;
+        case DWARF_Op_ge: cons_bytecode_push_op(arena, &bytecode, RADDBG_EvalOp_GrEq, RADDBG_EvalTypeGroup_S); break;
+        
+        case DWARF_Op_stack_value:
+        {
+          is_value = 1;
+          if (ptr != opl){
+            good = 0;
+          }
+        }break;
+      }
+    }
+    
+    if (good && bytecode.op_count > 0){
+      if (is_value){
+        result = cons_location_val_bytecode_stream(ctx->root, &bytecode);
+      }
+      else{
+        result = cons_location_addr_bytecode_stream(ctx->root, &bytecode);
+      }
+    }
+  }
+  
+  done:;
+  return(result);
+}
+
+static void
+dwarfconv_location_set_add_expr(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref,
+                                CONS_LocationSet *locset, String8 expr,
+                                DWARFCONV_FrameBase *frame_base,
+                                U64 vaddr_first, U64 vaddr_opl){
+  CONS_Root *root = ctx->root;
+  if (vaddr_first < vaddr_opl &&
+      dwarfconv_vaddr_is_in_code(ctx->code_ranges, ctx->code_range_count, vaddr_first)){
+    B32 uses_cfa = 0;
+    CONS_Location *location = dwarfconv_location_from_expr(ctx, ref, expr, frame_base, 0, &uses_cfa);
+    if (location != 0){
+      cons_location_set_add_case(root, locset, vaddr_first - ctx->vbase,
+                                 vaddr_opl - ctx->vbase, location);
+    }
+    
+    // the CFA moves with the pc; one case per CFI row over the range
+    else if (uses_cfa && ctx->frame != 0){
+      DWARF_FrameParsed *frame = ctx->frame;
+      for (U64 row_idx = dwarf_cfa_row_idx_from_vaddr(frame, vaddr_first);
+           row_idx < frame->row_count && frame->rows[row_idx].vaddr_first < vaddr_opl;
+           row_idx += 1){
+        DWARF_CFARow *row = &frame->rows[row_idx];
+        DWARFCONV_FrameBase cfa = dwarfconv_cfa_from_row(ctx, row);
+        if (cfa.valid){
+          location = dwarfconv_location_from_expr(ctx, ref, expr, frame_base, &cfa, &uses_cfa);
+          if (location != 0){
+            U64 first = Max(row->vaddr_first, vaddr_first);
+            U64 opl = Min(row->vaddr_opl, vaddr_opl);
+            cons_location_set_add_case(root, locset, first - ctx->vbase, opl - ctx->vbase, location);
+          }
+        }
+      }
+    }
+  }
+}
+
+static B32
+dwarfconv_global_from_expr(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref, String8 expr,
+                           CONS_SymbolKind *kind_out, U64 *off_out){
+  // globals:  DW_OP_addr/DW_OP_addrx
+  // tls:      DW_OP_const*u/DW_OP_constu, DW_OP_form_tls_address/DW_OP_GNU_push_tls_address
+  B32 result = 0;
+  DWARF_UnitContext *uctx = &ref.unit->ctx;
+  U64 addr_size = uctx->unit->address_size;
+  U8 *ptr = expr.str;
+  U8 *opl = expr.str + expr.size;
+  if (ptr < opl){
+    U8 op = *ptr;
+    ptr += 1;
+    
+    U64 x = 0;
+    B32 is_addr = 0;
+    B32 is_const = 1;
+    switch (op){
+      default:{ is_const = 0; }break;
+      case DWARF_Op_addr:
+      {
+        if (ptr + addr_size <= opl){
+          MemoryCopy(&x, ptr, addr_size);
+        }
+        ptr += addr_size;
+        is_addr = 1;
+      }break;
+      case DWARF_Op_addrx:
+      {
+        U64 idx = 0;
+        DWARF_LEB128_DECODE_ADV(U64, idx, ptr, opl);
+        x = dwarf_address_from_idx(uctx, idx);
+        is_addr = 1;
+      }break;
+      case DWARF_Op_const1u: if (ptr + 1 <= opl){ MemoryCopy(&x, ptr, 1); } ptr += 1; break;
+      case DWARF_Op_const2u: if (ptr + 2 <= opl){ MemoryCopy(&x, ptr, 2); } ptr += 2; break;
+      case DWARF_Op_const4u: if (ptr + 4 <= opl){ MemoryCopy(&x, ptr, 4); } ptr += 4; break;
+      case DWARF_Op_const8u: if (ptr + 8 <= opl){ MemoryCopy(&x, ptr, 8); } ptr += 8; break;
+      case DWARF_Op_constu:
+      {
+        DWARF_LEB128_DECODE_ADV(U64, x, ptr, opl);
+      }break;
+    }
+    
+    if (is_addr && ptr == opl && x >= ctx->vbase){
+      *kind_out = CONS_SymbolKind_GlobalVariable;
+      *off_out = x - ctx->vbase;
+      result = 1;
+    }
+    else if (is_const && ptr + 1 == opl &&
+             (*ptr == DWARF_Op_form_tls_address || *ptr == DWARF_Op_GNU_push_tls_address)){
+      *kind_out = CONS_SymbolKind_ThreadVariable;
+      *off_out = x;
+      result = 1;
+    }
+  }
+  return(result);
+}
+
+//- symbols
+
+static CONS_Type*
+dwarfconv_container_type_from_entry(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref){
+  CONS_Type *result = 0;
+  DWARF_InfoEntry *parent = ref.entry->parent;
+  if (parent != 0){
+    switch (parent->abbrev_decl->tag){
+      default:{}break;
+      case DWARF_Tag_structure_type:
+      case DWARF_Tag_class_type:
+      case DWARF_Tag_union_type:
+      {
+        result = dwarfconv_type_from_offset(ctx, parent->info_offset);
+      }break;
+    }
+  }
+  return(result);
+}
+
+static void
+dwarfconv_gather_entry(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref, DWARFCONV_GatherState *state){
+  CONS_Root *root = ctx->root;
+  DWARF_UnitContext *uctx = &ref.unit->ctx;
+  DWARF_InfoEntry *entry = ref.entry;
+  Temp scratch = scratch_begin(&ctx->arena, 1);
+  
+  switch (entry->abbrev_decl->tag){
+    default:{}break;
+    
+    case DWARF_Tag_namespace:
+    {
+      dwarfconv_gather_children(ctx, ref, state);
+    }break;
+    
+    case DWARF_Tag_subprogram:
+    {
+      // only definitions that made it into the image
+      DWARF_RangeList ranges = dwarf_range_list_from_entry(scratch.arena, uctx, entry);
+      U64 voff_first = max_U64;
+      U64 voff_count = 0;
+      for (DWARF_RangeNode *node = ranges.first; node != 0; node = node->next){
+        if (node->first < node->opl &&
+            dwarfconv_vaddr_is_in_code(ctx->code_ranges, ctx->code_range_count, node->first)){
+          voff_first = Min(voff_first, node->first - ctx->vbase);
+          voff_count += 1;
+        }
+      }
+      if (voff_count == 0){
+        break;
+      }
+      
+      // attributes from the declaration
+      DWARFCONV_EntryRef name_owner = dwarfconv_attrib_owner(ctx, ref, DWARF_AttributeName_name);
+      DWARFCONV_EntryRef link_owner = dwarfconv_attrib_owner(ctx, ref, DWARF_AttributeName_linkage_name);
+      DWARFCONV_EntryRef extern_owner = dwarfconv_attrib_owner(ctx, ref, DWARF_AttributeName_external);
+      String8 name = dwarf_string_from_attrib(&name_owner.unit->ctx, name_owner.entry,
+                                              DWARF_AttributeName_name);
+      String8 link_name = dwarf_string_from_attrib(&link_owner.unit->ctx, link_owner.entry,
+                                                   DWARF_AttributeName_linkage_name);
+      B32 is_extern = (dwarf_u64_from_attrib(&extern_owner.unit->ctx, extern_owner.entry,
+                                             DWARF_AttributeName_external) != 0);
+      CONS_Type *this_type = 0;
+      CONS_Type *type = dwarfconv_proc_type_from_entry(ctx, ref, &this_type);
+      CONS_Type *container_type = dwarfconv_container_type_from_entry(ctx, name_owner);
+      
+      // root scope
+      CONS_Scope *scope = cons_scope_handle_from_user_id(root, entry->info_offset);
+      for (DWARF_RangeNode *node = ranges.first; node != 0; node = node->next){
+        if (node->first < node->opl &&
+            dwarfconv_vaddr_is_in_code(ctx->code_ranges, ctx->code_range_count, node->first)){
+          cons_scope_add_voff_range(root, scope, node->first - ctx->vbase, node->opl - ctx->vbase);
+        }
+      }
+      
+      // symbol
+      CONS_Symbol *symbol = cons_symbol_handle_from_user_id(root, entry->info_offset);
+      CONS_SymbolInfo info = zero_struct;
+      info.kind = CONS_SymbolKind_Procedure;
+      info.name = dwarfconv_qualified_name(ctx, name_owner, name);
+      info.link_name = link_name;
+      info.type = type;
+      info.is_extern = is_extern;
+      info.offset = voff_first;
+      info.container_type = container_type;
+      info.root_scope = scope;
+      cons_symbol_set_info(root, symbol, &info);
+      
+      // frame base
+      DWARFCONV_FrameBase frame_base = {0};
+      {
+        String8 expr = dwarf_block_from_attrib(uctx, entry, DWARF_AttributeName_frame_base);
+        frame_base = dwarfconv_frame_base_from_expr(ctx, expr);
+      }
+      
+      // locals & inner scopes
+      DWARFCONV_GatherState child_state = zero_struct;
+      child_state.proc = symbol;
+      child_state.scope = scope;
+      child_state.scope_ranges = &ranges;
+      child_state.frame_base = frame_base;
+      dwarfconv_gather_children(ctx, ref, &child_state);
+    }break;
+    
+    case DWARF_Tag_lexical_block:
+    case DWARF_Tag_inlined_subroutine:
+    {
+      if (state->scope == 0){
+        break;
+      }
+      DWARF_RangeList ranges = dwarf_range_list_from_entry(scratch.arena, uctx, entry);
+      if (ranges.count == 0){
+        dwarfconv_gather_children(ctx, ref, state);
+        break;
+      }
+      
+      CONS_Scope *scope = cons_scope_handle_from_user_id(root, entry->info_offset);
+      cons_scope_set_parent(root, scope, state->scope);
+      for (DWARF_RangeNode *node = ranges.first; node != 0; node = node->next){
+        if (node->first < node->opl &&
+            dwarfconv_vaddr_is_in_code(ctx->code_ranges, ctx->code_range_count, node->first)){
+          cons_scope_add_voff_range(root, scope, node->first - ctx->vbase, node->opl - ctx->vbase);
+        }
+      }
+      
+      DWARFCONV_GatherState child_state = *state;
+      child_state.scope = scope;
+      child_state.scope_ranges = &ranges;
+      dwarfconv_gather_children(ctx, ref, &child_state);
+    }break;
+    
+    case DWARF_Tag_variable:
+    case DWARF_Tag_formal_parameter:
+    {
+      DWARFCONV_EntryRef name_owner = dwarfconv_attrib_owner(ctx, ref, DWARF_AttributeName_name);
+      String8 name = dwarf_string_from_attrib(&name_owner.unit->ctx, name_owner.entry,
+                                              DWARF_AttributeName_name);
+      DWARF_AttributeClassFlags loc_class =
+        dwarf_attribute_class_from_form(dwarf_form_from_attrib(entry, DWARF_AttributeName_location));
+      
+      // globals, thread locals & function statics
+      {
+        CONS_SymbolKind kind = CONS_SymbolKind_NULL;
+        U64 off = 0;
+        B32 is_global = 0;
+        if (loc_class & (DWARF_AttributeClassFlag_exprloc|DWARF_AttributeClassFlag_block)){
+          String8 expr = dwarf_block_from_attrib(uctx, entry, DWARF_AttributeName_location);
+          is_global = dwarfconv_global_from_expr(ctx, ref, expr, &kind, &off);
+        }
+        if (is_global){
+          DWARFCONV_EntryRef extern_owner = dwarfconv_attrib_owner(ctx, ref, DWARF_AttributeName_external);
+          DWARFCONV_EntryRef link_owner = dwarfconv_attrib_owner(ctx, ref, DWARF_AttributeName_linkage_name);
+          CONS_Symbol *symbol = cons_symbol_handle_from_user_id(root, entry->info_offset);
+          CONS_SymbolInfo info = zero_struct;
+          info.kind = kind;
+          info.name = dwarfconv_qualified_name(ctx, name_owner, name);
+          info.link_name = dwarf_string_from_attrib(&link_owner.unit->ctx, link_owner.entry,
+                                                    DWARF_AttributeName_linkage_name);
+          info.type = dwarfconv_type_from_attrib(ctx, ref, DWARF_AttributeName_type);
+          info.is_extern = (dwarf_u64_from_attrib(&extern_owner.unit->ctx, extern_owner.entry,
+                                                  DWARF_AttributeName_external) != 0);
+          info.offset = off;
+          if (state->proc != 0){
+            info.container_symbol = state->proc;
+          }
+          else{
+            info.container_type = dwarfconv_container_type_from_entry(ctx, name_owner);
+          }
+          cons_symbol_set_info(root, symbol, &info);
+          break;
+        }
+      }
+      
+      // locals
+      if (state->scope == 0){
+        break;
+      }
+      
+      CONS_Local *local = cons_local_handle_from_user_id(root, entry->info_offset);
+      CONS_LocalInfo info = zero_struct;
+      info.kind = ((entry->abbrev_decl->tag == DWARF_Tag_formal_parameter)?
+                   RADDBG_LocalKind_Parameter:
+                   RADDBG_LocalKind_Variable);
+      info.scope = state->scope;
+      info.name = name;
+      info.type = dwarfconv_type_from_attrib(ctx, ref, DWARF_AttributeName_type);
+      cons_local_set_basic_info(root, local, &info);
+      
+      if (loc_class != 0){
+        CONS_LocationSet *locset = cons_location_set_from_local(root, local);
+        DWARF_LocationList locs = dwarf_location_list_from_attrib(scratch.arena, uctx, entry,
+                                                                  DWARF_AttributeName_location);
+        for (DWARF_LocationNode *node = locs.first; node != 0; node = node->next){
+          // a single expression covers the whole scope
+          if (node->first == 0 && node->opl == max_U64){
+            if (state->scope_ranges != 0){
+              for (DWARF_RangeNode *range = state->scope_ranges->first; range != 0; range = range->next){
+                dwarfconv_location_set_add_expr(ctx, ref, locset, node->expr, &state->frame_base,
+                                                range->first, range->opl);
+              }
+            }
+          }
+          else{
+            dwarfconv_location_set_add_expr(ctx, ref, locset, node->expr, &state->frame_base,
+                                            node->first, node->opl);
+          }
+        }
+      }
+    }break;
+    
+    case DWARF_Tag_base_type:
+    case DWARF_Tag_structure_type:
+    case DWARF_Tag_class_type:
+    case DWARF_Tag_union_type:
+    case DWARF_Tag_enumeration_type:
+    case DWARF_Tag_typedef:
+    {
+      // emit named types even when no symbol refers to them
+      if (state->proc == 0 && dwarf_entry_has_attrib(entry, DWARF_AttributeName_name)){
+        dwarfconv_type_from_offset(ctx, entry->info_offset);
+      }
+    }break;
+  }
+  
+  scratch_end(scratch);
+}
+
+static void
+dwarfconv_gather_children(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref, DWARFCONV_GatherState *state){
+  for (DWARF_InfoEntry *child = ref.entry->first_child; child != 0; child = child->next_sibling){
+    DWARFCONV_EntryRef child_ref = {ref.unit, child};
+    dwarfconv_gather_entry(ctx, child_ref, state);
+  }
+}
+
+//- image info
+
+static void
+dwarfconv_guid_age_from_build_id(String8 build_id, U8 *guid_out, U32 *age_out){
+  // the first 16 bytes land in the guid, the next 4 in the age; this covers
+  // the common 20 byte (sha1) build ids exactly
+  MemoryZero(guid_out, 16);
+  *age_out = 0;
+  U64 guid_size = Min(build_id.size, 16);
+  MemoryCopy(guid_out, build_id.str, guid_size);
+  if (build_id.size > 16){
+    MemoryCopy(age_out, build_id.str + 16, Min(build_id.size - 16, sizeof(*age_out)));
+  }
+}
+
+static ELF_Parsed*
+dwarfconv_image_from_params(Arena *arena, DWARFCONV_Params *params, ELF_Parsed *elf){
+  ELF_Parsed *result = elf;
+  if (params->input_exe_data.size > 0){
+    ELF_Parsed *exe = elf_parsed_from_data(arena, params->input_exe_data);
+    if (exe != 0){
+      result = exe;
+    }
+  }
+  return(result);
+}
+
+static void
+dwarfconv_set_image_info(CONS_Root *root, DWARFCONV_Params *params,
+                         ELF_Parsed *image, RADDBG_Arch arch){
+  U64 vbase = image->vbase;
+  
+  // top level info
+  {
+    U64 voff_max = 0;
+    for (U64 i = 0; i < image->section_count; i += 1){
+      ELF_Shdr64 *section = &image->sections[i];
+      if ((section->sh_flags & ELF_SectionAttributeFlag_ALLOC) && section->sh_addr >= vbase){
+        voff_max = Max(voff_max, section->sh_addr + section->sh_size - vbase);
+      }
+    }
+    
+    CONS_TopLevelInfo tli = {0};
+    tli.architecture = arch;
+    tli.exe_name = params->input_elf_name;
+    if (params->input_exe_name.size > 0){
+      tli.exe_name = params->input_exe_name;
+    }
+    tli.voff_max = voff_max;
+    dwarfconv_guid_age_from_build_id(elf_gnu_build_id_from_elf(image), tli.dbg_guid, &tli.dbg_age);
+    cons_set_top_level_info(root, &tli);
+  }
+  
+  // binary sections
+  for (U64 i = 0; i < image->section_count; i += 1){
+    ELF_Shdr64 *section = &image->sections[i];
+    if ((section->sh_flags & ELF_SectionAttributeFlag_ALLOC) && section->sh_addr >= vbase){
+      RADDBG_BinarySectionFlags flags = RADDBG_BinarySectionFlag_Read;
+      if (section->sh_flags & ELF_SectionAttributeFlag_WRITE){
+        flags |= RADDBG_BinarySectionFlag_Write;
+      }
+      if (section->sh_flags & ELF_SectionAttributeFlag_EXECINSTR){
+        flags |= RADDBG_BinarySectionFlag_Execute;
+      }
+      U64 foff_opl = section->sh_offset;
+      if (section->sh_type != ELF_SectionType_NOBITS){
+        foff_opl += section->sh_size;
+      }
+      cons_add_binary_section(root, image->section_names[i], flags,
+                              section->sh_addr - vbase, section->sh_addr + section->sh_size - vbase,
+                              section->sh_offset, foff_opl);
+    }
+  }
+}
+
+//- conversion
+
+static CONS_Root*
+dwarfconv_convert(Arena *arena, DWARFCONV_Params *params, ELF_Parsed *elf,
+                  DWARF_Parsed *dwarf, DWARF_InfoParsed *info){
+  ProfBeginFunction();
+  
+  // sections & build id come from the loaded image, which is not the
+  // debug info's file when that was split off
+  ELF_Parsed *image = dwarfconv_image_from_params(arena, params, elf);
+  
+  RADDBG_Arch arch = dwarfconv_arch_from_elf_arch(image->arch);
+  U64 addr_size = raddbg_addr_size_from_arch(arch);
+  U64 vbase = image->vbase;
+  
+  // flatten units
+  U64 unit_count = info->unit_count;
+  DWARF_InfoUnit **units = push_array_no_zero(arena, DWARF_InfoUnit*, unit_count);
+  {
+    U64 unit_idx = 0;
+    for (DWARF_InfoUnit *unit = info->unit_first; unit != 0; unit = unit->next, unit_idx += 1){
+      units[unit_idx] = unit;
+    }
+  }
+  
+  // progress
+  CONS_Progress *progress = push_array(arena, CONS_Progress, 1);
+  progress->func = params->progress_func;
+  progress->user = params->progress_user;
+  progress->bytes_total = dwarf->debug_data[DWARF_SectionCode_Info].size;
+  progress->units_total = unit_count;
+  
+  // executable section ranges, for dropping debug info of discarded code
+  U64 code_range_count = 0;
+  Rng1U64 *code_ranges = push_array(arena, Rng1U64, image->section_count);
+  for (U64 i = 0; i < image->section_count; i += 1){
+    ELF_Shdr64 *section = &image->sections[i];
+    if ((section->sh_flags & ELF_SectionAttributeFlag_ALLOC) &&
+        (section->sh_flags & ELF_SectionAttributeFlag_EXECINSTR)){
+      code_ranges[code_range_count] = r1u64(section->sh_addr, section->sh_addr + section->sh_size);
+      code_range_count += 1;
+    }
+  }
+  
+  // parse units
+  DWARFCONV_UnitParsed *units_parsed = push_array(arena, DWARFCONV_UnitParsed, unit_count);
+  ProfScope("parse units"){
+    U64 units_per_task = CeilIntegerDiv(unit_count, ts_thread_count()*4);
+    units_per_task = ClampBot(units_per_task, 1);
+    U64 task_count = CeilIntegerDiv(unit_count, units_per_task);
+    
+    DWARFCONV_UnitParseIn *tasks_in = push_array(arena, DWARFCONV_UnitParseIn, task_count);
+    TS_ArenaTask *tasks = push_array(arena, TS_ArenaTask, task_count);
+    for (U64 task_idx = 0; task_idx < task_count; task_idx += 1){
+      DWARFCONV_UnitParseIn *in = &tasks_in[task_idx];
+      in->dwarf = dwarf;
+      in->units = units;
+      in->unit_idx_first = task_idx*units_per_task;
+      in->unit_idx_opl = Min(in->unit_idx_first + units_per_task, unit_count);
+      in->vbase = vbase;
+      in->code_ranges = code_ranges;
+      in->code_range_count = code_range_count;
+      in->units_out = units_parsed;
+      in->progress = progress;
+      tasks[task_idx] = ts_arena_task_kickoff(dwarfconv_unit_parse_task__entry_point, in);
+    }
+    for (U64 task_idx = 0; task_idx < task_count; task_idx += 1){
+      ts_arena_task_join(arena, tasks[task_idx]);
+    }
+  }
+  
+  // predict symbol counts
+  U64 entry_count = 0;
+  for (U64 unit_idx = 0; unit_idx < unit_count; unit_idx += 1){
+    entry_count += units_parsed[unit_idx].tree->entry_count;
+  }
+  U64 symbol_count_prediction = ClampBot(entry_count/8, 128);
+  
+  // setup root
+  CONS_RootParams root_params = {0};
+  root_params.addr_size = addr_size;
+  root_params.bucket_count_units = unit_count;
+  root_params.bucket_count_symbols = symbol_count_prediction;
+  root_params.bucket_count_scopes = symbol_count_prediction;
+  root_params.bucket_count_locals = symbol_count_prediction;
+  root_params.bucket_count_types = symbol_count_prediction;
+  CONS_Root *root = cons_root_new(&root_params);
+  
+  // top level info & binary sections
+  dwarfconv_set_image_info(root, params, image, arch);
+  
+  // conversion context
+  DWARFCONV_Ctx ctx = {0};
+  ctx.arena = arena;
+  ctx.root = root;
+  ctx.arch = arch;
+  ctx.addr_size = addr_size;
+  ctx.vbase = vbase;
+  ctx.units = units_parsed;
+  ctx.unit_count = unit_count;
+  ctx.code_ranges = code_ranges;
+  ctx.code_range_count = code_range_count;
+  ctx.void_type = cons_type_basic(root, RADDBG_TypeKind_Void, str8_lit("void"));
+  
+  // call frame info, for frame bases & locations given against the CFA;
+  //  .debug_frame if the debug info has it, otherwise the image's .eh_frame
+  ProfScope("call frame info"){
+    String8 frame_data = dwarf->debug_data[DWARF_SectionCode_Frame];
+    if (frame_data.size > 0){
+      ctx.frame = dwarf_frame_from_data(arena, frame_data, 0, addr_size, 0);
+    }
+    else{
+      U32 eh_frame_idx = elf_section_idx_from_name(image, str8_lit(".eh_frame"));
+      if (eh_frame_idx != 0){
+        String8 eh_frame_data = elf_section_data_from_idx(image, eh_frame_idx);
+        U64 eh_frame_vaddr = image->sections[eh_frame_idx].sh_addr;
+        ctx.frame = dwarf_frame_from_data(arena, eh_frame_data, eh_frame_vaddr, addr_size, 1);
+      }
+    }
+  }
+  
+  // units
+  ProfScope("units"){
+    for (U64 unit_idx = 0; unit_idx < unit_count; unit_idx += 1){
+      DWARFCONV_UnitParsed *unit = &units_parsed[unit_idx];
+      DWARF_InfoEntry *unit_root = unit->tree->root;
+      if (unit_root == 0 ||
+          (unit_root->abbrev_decl->tag != DWARF_Tag_compile_unit &&
+           unit_root->abbrev_decl->tag != DWARF_Tag_partial_unit)){
+        continue;
+      }
+      
+      CONS_Unit *unit_handle = cons_unit_handle_from_user_id(root, unit_idx);
+      
+      // info
+      {
+        String8 source_file = unit->name;
+        if (unit->comp_dir.size > 0 && source_file.size > 0 &&
+            source_file.str[0] != '/' && source_file.str[0] != '\\'){
+          source_file = push_str8f(arena, "%.*s/%.*s",
+                                   str8_varg(unit->comp_dir), str8_varg(unit->name));
+        }
+        
+        CONS_UnitInfo unit_info = {0};
+        unit_info.unit_name = str8_skip_last_slash(unit->name);
+        unit_info.compiler_name = unit->producer;
+        unit_info.source_file = source_file;
+        unit_info.build_path = unit->comp_dir;
+        unit_info.language = unit->language;
+        cons_unit_set_info(root, unit_handle, &unit_info);
+      }
+      
+      // line info
+      for (DWARFCONV_LineSequenceNode *node = unit->line_seq_first; node != 0; node = node->next){
+        cons_unit_add_line_sequence(root, unit_handle, &node->line_seq);
+      }
+      
+      // vmap
+      {
+        B32 has_ranges = 0;
+        for (DWARF_RangeNode *node = unit->ranges.first; node != 0; node = node->next){
+          if (node->first < node->opl &&
+              dwarfconv_vaddr_is_in_code(code_ranges, code_range_count, node->first)){
+            cons_unit_vmap_add_range(root, unit_handle, node->first - vbase, node->opl - vbase);
+            has_ranges = 1;
+          }
+        }
+        if (!has_ranges){
+          for (DWARFCONV_LineSequenceNode *node = unit->line_seq_first; node != 0; node = node->next){
+            CONS_LineSequence *seq = &node->line_seq;
+            cons_unit_vmap_add_range(root, unit_handle, seq->voffs[0], seq->voffs[seq->line_count]);
+          }
+        }
+      }
+    }
+  }
+  
+  // symbols & types
+  ProfScope("symbols & types"){
+    for (U64 unit_idx = 0; unit_idx < unit_count; unit_idx += 1){
+      DWARFCONV_UnitParsed *unit = &units_parsed[unit_idx];
+      DWARF_InfoEntry *unit_root = unit->tree->root;
+      if (unit_root != 0){
+        DWARFCONV_EntryRef ref = {unit, unit_root};
+        DWARFCONV_GatherState state = {0};
+        dwarfconv_gather_children(&ctx, ref, &state);
+      }
+    }
+  }
+  
+  cons_progress_finish(progress);
+  
+  ProfEnd();
+  return(root);
+}
+
+////////////////////////////////
+//~ Conversion Path
+
+static DWARFCONV_Out*
+dwarfconv_convert_elf(Arena *arena, DWARFCONV_Params *params){
+  DWARFCONV_Out *out = push_array(arena, DWARFCONV_Out, 1);
+  out->good_parse = 1;
+  
+  // will we try to parse an input file?
+  B32 try_parse_input = (params->errors.node_count == 0);
+  
+  // parse elf
+  ELF_Parsed *elf = 0;
+  if (try_parse_input) ProfScope("parse elf"){
+    elf = elf_parsed_from_data(arena, params->input_elf_data);
+    if (elf == 0){
+      out->good_parse = 0;
+      str8_list_pushf(arena, &out->errors, "ELF");
+    }
+  }
+  
+  // parse dwarf
+  DWARF_Parsed *dwarf = 0;
+  if (elf != 0) ProfScope("parse dwarf"){
+    dwarf = dwarf_parsed_from_elf(arena, elf);
+    if (dwarf == 0){
+      out->good_parse = 0;
+      str8_list_pushf(arena, &out->errors, "DWARF");
+    }
+  }
+  
+  // parse info
+  DWARF_InfoParsed *info = 0;
+  if (dwarf != 0){
+    String8 data = dwarf->debug_data[DWARF_SectionCode_Info];
+    if (data.size > 0) ProfScope("parse .debug_info"){
+      info = dwarf_info_from_data(arena, data);
+      if (info == 0){
+        out->good_parse = 0;
+        str8_list_pushf(arena, &out->errors, "DEBUG INFO");
+      }
+    }
+  }
+  
+  // parsing error
+  if (try_parse_input && !out->good_parse){
+    str8_list_pushf(arena, &out->errors, "error(parsing): '%S' as an ELF\n", params->input_elf_name);
+  }
+  
+  // convert; with no .debug_info at all, the symbol table is all there is
+  if (out->good_parse){
+    if (info != 0) ProfScope("convert"){
+      out->root = dwarfconv_convert(arena, params, elf, dwarf, info);
+    }
+    else{
+      out = dwarfconv_convert_publics(arena, params);
+    }
+  }
+  
+  return(out);
+}
+
+////////////////////////////////
+//~ Publics-Only Conversion Path
+
+static DWARFCONV_Out*
+dwarfconv_convert_publics(Arena *arena, DWARFCONV_Params *params){
+  DWARFCONV_Out *out = push_array(arena, DWARFCONV_Out, 1);
+  out->good_parse = 1;
+  
+  // will we try to parse an input file?
+  B32 try_parse_input = (params->errors.node_count == 0);
+  
+  // parse elf & loaded image
+  ELF_Parsed *elf = 0;
+  ELF_Parsed *image = 0;
+  if (try_parse_input) ProfScope("parse elf"){
+    elf = elf_parsed_from_data(arena, params->input_elf_data);
+    if (elf == 0){
+      out->good_parse = 0;
+      str8_list_pushf(arena, &out->errors, "ELF");
+    }
+    else{
+      image = dwarfconv_image_from_params(arena, params, elf);
+    }
+  }
+  
+  // parsing error
+  if (try_parse_input && !out->good_parse){
+    str8_list_pushf(arena, &out->errors, "error(parsing): '%S' as an ELF\n", params->input_elf_name);
+  }
+  
+  if (out->good_parse) ProfScope("convert publics"){
+    U64 vbase = image->vbase;
+    
+    // pick a symbol table; a stripped image only has its dynamic symbols left
+    ELF_Parsed *sym_elf = 0;
+    U64 sym_section_idx = 0;
+    {
+      ELF_Parsed *candidates[] = {elf, image};
+      for (U64 i = 0; i < ArrayCount(candidates) && sym_elf == 0; i += 1){
+        if (candidates[i]->symtab_idx != 0){
+          sym_elf = candidates[i];
+          sym_section_idx = candidates[i]->symtab_idx;
+        }
+      }
+      for (U64 i = 0; i < ArrayCount(candidates) && sym_elf == 0; i += 1){
+        if (candidates[i]->dynsym_idx != 0){
+          sym_elf = candidates[i];
+          sym_section_idx = candidates[i]->dynsym_idx;
+        }
+      }
+    }
+    
+    // gather publics
+    CONS_Public *publics = 0;
+    U64 public_count = 0;
+    if (sym_elf != 0){
+      ELF_Shdr64 *sym_section = &sym_elf->sections[sym_section_idx];
+      String8 sym_data = elf_section_data_from_idx(sym_elf, sym_section_idx);
+      String8 strtab = elf_section_data_from_idx(sym_elf, sym_section->sh_link);
+      ELF_SymArray symbols = elf_sym_array_from_data(arena, sym_elf->elf_class, sym_data);
+      
+      publics = push_array_no_zero(arena, CONS_Public, symbols.count);
+      ELF_Sym64 *symbol = symbols.symbols;
+      for (U64 i = 0; i < symbols.count; i += 1, symbol += 1){
+        ELF_SymbolType type = ELF_SymTypeFromInfo(symbol->st_info);
+        if (type != ELF_SymbolType_FUNC && type != ELF_SymbolType_OBJECT){
+          continue;
+        }
+        if (symbol->st_shndx == ELF_ReservedSectionIndex_UNDEF ||
+            symbol->st_shndx >= sym_elf->section_count ||
+            symbol->st_value < vbase ||
+            symbol->st_name >= strtab.size){
+          continue;
+        }
+        String8 name = str8_cstring_capped(strtab.str + symbol->st_name, strtab.str + strtab.size);
+        if (name.size == 0){
+          continue;
+        }
+        
+        // fill public; sizeless symbols run to the end of their section for
+        // now, & are cut at the next public once everything is sorted
+        ELF_Shdr64 *section = &sym_elf->sections[symbol->st_shndx];
+        CONS_Public *pub = publics + public_count;
+        public_count += 1;
+        pub->name = name;
+        pub->voff = symbol->st_value - vbase;
+        pub->voff_opl = section->sh_addr + section->sh_size - vbase;
+        if (symbol->st_size != 0){
+          pub->voff_opl = pub->voff + symbol->st_size;
+        }
+        pub->voff_opl = Max(pub->voff_opl, pub->voff + 1);
+        pub->is_function = (type == ELF_SymbolType_FUNC);
+      }
+    }
+    
+    // architecture
+    RADDBG_Arch architecture = dwarfconv_arch_from_elf_arch(image->arch);
+    U64 addr_size = raddbg_addr_size_from_arch(architecture);
+    
+    // setup root & symbols
+    CONS_Root *root = cons_root_new_from_publics(addr_size, publics, public_count);
+    out->root = root;
+    
+    // top level info & binary sections
+    dwarfconv_set_image_info(root, params, image, architecture);
+    
+  }
+  
+  return(out);
 }
@@ -10,9 +10,20 @@
 typedef struct DWARFCONV_Params{
   String8 input_elf_name;
   String8 input_elf_data;
+  OS_FileView input_elf_view;
+  
+  // optional; when the debug info lives in a separate file, the loaded
+  // image's sections & build id come from here instead
+  String8 input_exe_name;
+  String8 input_exe_data;
   
   String8 output_name;
   
+  U64 thread_count;
+  
+  CONS_ProgressFunctionType *progress_func;
+  void *progress_user;
+  
   U64 unit_idx_min;
   U64 unit_idx_max;
   
@@ -45,6 +56,195 @@ typedef struct DWARFCONV_Params{
 
 static DWARFCONV_Params *dwarf_convert_params_from_cmd_line(Arena *arena, CmdLine *cmdline);
 
+////////////////////////////////
+//~ Conversion Types
+
+// unit parse tasks
+
+typedef struct DWARFCONV_LineSequenceNode{
+  struct DWARFCONV_LineSequenceNode *next;
+  CONS_LineSequence line_seq;
+} DWARFCONV_LineSequenceNode;
+
+typedef struct DWARFCONV_UnitParsed{
+  DWARF_InfoUnit *unit;
+  DWARF_AbbrevUnit *abbrev;
+  DWARF_InfoEntryTree *tree;
+  DWARF_UnitContext ctx;
+  
+  // root attributes
+  String8 name;
+  String8 comp_dir;
+  String8 producer;
+  RADDBG_Language language;
+  DWARF_RangeList ranges;
+  
+  // line info (already in voff space)
+  DWARFCONV_LineSequenceNode *line_seq_first;
+  DWARFCONV_LineSequenceNode *line_seq_last;
+  U64 line_seq_count;
+} DWARFCONV_UnitParsed;
+
+typedef struct DWARFCONV_UnitParseIn{
+  DWARF_Parsed *dwarf;
+  DWARF_InfoUnit **units;
+  U64 unit_idx_first;
+  U64 unit_idx_opl;
+  U64 vbase;
+  // vaddr ranges of the image's executable sections
+  Rng1U64 *code_ranges;
+  U64 code_range_count;
+  DWARFCONV_UnitParsed *units_out;
+  CONS_Progress *progress;
+} DWARFCONV_UnitParseIn;
+
+// conversion context
+
+typedef struct DWARFCONV_EntryRef{
+  DWARFCONV_UnitParsed *unit;
+  DWARF_InfoEntry *entry;
+} DWARFCONV_EntryRef;
+
+// a frame base is a register + offset, or (is_cfa) an offset from the
+//  canonical frame address, which moves with the pc & comes from the CFI
+typedef struct DWARFCONV_FrameBase{
+  B32 valid;
+  B32 is_cfa;
+  RADDBG_RegisterCode reg_code;
+  S64 off;
+} DWARFCONV_FrameBase;
+
+typedef struct DWARFCONV_TypeFillNode{
+  struct DWARFCONV_TypeFillNode *next;
+  DWARFCONV_EntryRef ref;
+  CONS_Type *type;
+} DWARFCONV_TypeFillNode;
+
+typedef struct DWARFCONV_GatherState{
+  CONS_Symbol *proc;
+  CONS_Scope *scope;
+  DWARF_RangeList *scope_ranges;
+  DWARFCONV_FrameBase frame_base;
+} DWARFCONV_GatherState;
+
+typedef struct DWARFCONV_Ctx{
+  Arena *arena;
+  CONS_Root *root;
+  RADDBG_Arch arch;
+  U64 addr_size;
+  U64 vbase;
+  
+  DWARFCONV_UnitParsed *units;
+  U64 unit_count;
+  
+  // executable sections of the image; debug info for code the linker
+  //  discarded still shows up, relocated to zero or to a tombstone
+  Rng1U64 *code_ranges;
+  U64 code_range_count;
+  
+  DWARF_FrameParsed *frame;
+  
+  CONS_Type *void_type;
+  
+  // records get their members after the current type request finishes,
+  //  so that cycles through aliases resolve to the finished types
+  DWARFCONV_TypeFillNode *fill_first;
+  DWARFCONV_TypeFillNode *fill_last;
+  B32 filling;
+} DWARFCONV_Ctx;
+
+////////////////////////////////
+//~ Conversion Functions
+
+// tasks
+static TS_TASK_FUNCTION_DEF(dwarfconv_unit_parse_task__entry_point);
+
+// enum conversion helpers
+static RADDBG_Arch         dwarfconv_arch_from_elf_arch(Architecture arch);
+static RADDBG_Language     dwarfconv_language_from_dwarf_language(U64 lang);
+static RADDBG_RegisterCode dwarfconv_reg_code_from_dwarf_reg(RADDBG_Arch arch, U64 reg);
+static RADDBG_TypeKind     dwarfconv_type_kind_from_base_type(U64 encoding, U64 byte_size,
+                                                              String8 name);
+
+// address helpers
+static B32 dwarfconv_vaddr_is_in_code(Rng1U64 *code_ranges, U64 code_range_count, U64 vaddr);
+
+// entry helpers
+static DWARFCONV_EntryRef dwarfconv_entry_from_offset(DWARFCONV_Ctx *ctx, U64 info_off);
+static DWARFCONV_EntryRef dwarfconv_attrib_owner(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref,
+                                                 DWARF_AttributeName name);
+static String8 dwarfconv_qualified_name(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref, String8 name);
+
+// types
+static CONS_Type* dwarfconv_type_from_offset(DWARFCONV_Ctx *ctx, U64 info_off);
+static CONS_Type* dwarfconv_type_from_attrib(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref,
+                                             DWARF_AttributeName name);
+static CONS_Type* dwarfconv_type_from_entry(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref,
+                                            CONS_Reservation *res);
+static CONS_Type* dwarfconv_proc_type_from_entry(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref,
+                                                 CONS_Type **this_type_out);
+static U64        dwarfconv_member_offset_from_entry(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref);
+static void       dwarfconv_type_fill_members(DWARFCONV_Ctx *ctx, DWARFCONV_TypeFillNode *node);
+
+// locations
+static DWARFCONV_FrameBase dwarfconv_frame_base_from_expr(DWARFCONV_Ctx *ctx, String8 expr);
+static DWARFCONV_FrameBase dwarfconv_cfa_from_row(DWARFCONV_Ctx *ctx, DWARF_CFARow *row);
+static CONS_Location* dwarfconv_location_from_addr_reg_off(DWARFCONV_Ctx *ctx,
+                                                           RADDBG_RegisterCode reg_code,
+                                                           S64 offset);
+static CONS_Location* dwarfconv_location_from_expr(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref,
+                                                   String8 expr, DWARFCONV_FrameBase *frame_base,
+                                                   DWARFCONV_FrameBase *cfa, B32 *uses_cfa_out);
+static void dwarfconv_location_set_add_expr(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref,
+                                            CONS_LocationSet *locset, String8 expr,
+                                            DWARFCONV_FrameBase *frame_base,
+                                            U64 vaddr_first, U64 vaddr_opl);
+static B32 dwarfconv_global_from_expr(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref, String8 expr,
+                                      CONS_SymbolKind *kind_out, U64 *off_out);
+
+// symbols
+static CONS_Type* dwarfconv_container_type_from_entry(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref);
+static void dwarfconv_gather_entry(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref,
+                                   DWARFCONV_GatherState *state);
+static void dwarfconv_gather_children(DWARFCONV_Ctx *ctx, DWARFCONV_EntryRef ref,
+                                      DWARFCONV_GatherState *state);
+
+// image info
+static void dwarfconv_guid_age_from_build_id(String8 build_id, U8 *guid_out, U32 *age_out);
+static ELF_Parsed* dwarfconv_image_from_params(Arena *arena, DWARFCONV_Params *params,
+                                               ELF_Parsed *elf);
+static void dwarfconv_set_image_info(CONS_Root *root, DWARFCONV_Params *params,
+                                     ELF_Parsed *image, RADDBG_Arch arch);
+
+// conversion
+static CONS_Root* dwarfconv_convert(Arena *arena, DWARFCONV_Params *params, ELF_Parsed *elf,
+                                    DWARF_Parsed *dwarf, DWARF_InfoParsed *info);
+
+////////////////////////////////
+//~ Conversion Output Type
+
+typedef struct DWARFCONV_Out{
+  B32 good_parse;
+  CONS_Root *root;
+  String8List errors;
+} DWARFCONV_Out;
+
+////////////////////////////////
+//~ Conversion Path
+
+// NOTE: parse the input ELF & its DWARF, then convert; for callers that
+// only need the resulting root, not the intermediate parses.
+static DWARFCONV_Out* dwarfconv_convert_elf(Arena *arena, DWARFCONV_Params *params);
+
+////////////////////////////////
+//~ Publics-Only Conversion Path
+
+// NOTE: a cheap first tier - only the section headers & the ELF symbol table
+// (.symtab, or .dynsym for stripped images) are read; no DWARF at all. every
+// function symbol becomes a procedure covering its st_size bytes - or, when
+// that is missing, up to the next symbol - so symbolization & the procedure
+// vmap work, but there are no types, locals, units, or line info.
 
+static DWARFCONV_Out* dwarfconv_convert_publics(Arena *arena, DWARFCONV_Params *params);
 
 #endif //RADDBG_FROM_DWARF_H
@@ -17,7 +17,13 @@ pdb_convert_params_from_cmd_line(Arena *arena, CmdLine *cmdline){
     }
     
     if (input_name.size > 0){
-      String8 input_data = os_data_from_file_path(arena, input_name);
+      // map the input read-only; fall back to reading it into the arena
+      OS_FileView input_view = os_file_view_open(input_name);
+      String8 input_data = input_view.data;
+      if (input_data.size == 0){
+        os_file_view_close(&input_view);
+        input_data = os_data_from_file_path(arena, input_name);
+      }
       
       if (input_data.size == 0){
         str8_list_pushf(arena, &result->errors,
@@ -27,6 +33,7 @@ pdb_convert_params_from_cmd_line(Arena *arena, CmdLine *cmdline){
       if (input_data.size != 0){
         result->input_pdb_name = input_name;
         result->input_pdb_data = input_data;
+        result->input_pdb_view = input_view;
       }
     }
   }
@@ -35,7 +42,13 @@ pdb_convert_params_from_cmd_line(Arena *arena, CmdLine *cmdline){
   {
     String8 input_name = cmd_line_string(cmdline, str8_lit("exe"));
     if (input_name.size > 0){
-      String8 input_data = os_data_from_file_path(arena, input_name);
+      // map the input read-only; fall back to reading it into the arena
+      OS_FileView input_view = os_file_view_open(input_name);
+      String8 input_data = input_view.data;
+      if (input_data.size == 0){
+        os_file_view_close(&input_view);
+        input_data = os_data_from_file_path(arena, input_name);
+      }
       
       if (input_data.size == 0){
         str8_list_pushf(arena, &result->errors,
@@ -45,6 +58,7 @@ pdb_convert_params_from_cmd_line(Arena *arena, CmdLine *cmdline){
       if (input_data.size != 0){
         result->input_exe_name = input_name;
         result->input_exe_data = input_data;
+        result->input_exe_view = input_view;
       }
     }
   }
@@ -54,6 +68,36 @@ pdb_convert_params_from_cmd_line(Arena *arena, CmdLine *cmdline){
     result->output_name = cmd_line_string(cmdline, str8_lit("out"));
   }
   
+  // get thread count
+  {
+    result->thread_count = os_logical_core_count();
+    String8 thread_count_string = cmd_line_string(cmdline, str8_lit("threads"));
+    if (thread_count_string.size > 0){
+      U64 thread_count = 0;
+      if (try_u64_from_str8_c_rules(thread_count_string, &thread_count) && thread_count > 0){
+        result->thread_count = thread_count;
+      }
+      else{
+        str8_list_pushf(arena, &result->errors,
+                        "invalid thread count '%.*s'", str8_varg(thread_count_string));
+      }
+    }
+  }
+  
+  // get unit cache directory
+  {
+    String8 cache_dir = cmd_line_string(cmdline, str8_lit("cache"));
+    if (cache_dir.size > 0){
+      if (os_make_directory(cache_dir)){
+        result->cache_dir = cache_dir;
+      }
+      else{
+        str8_list_pushf(arena, &result->errors,
+                        "could not create cache directory '%.*s'", str8_varg(cache_dir));
+      }
+    }
+  }
+  
   // error options
   if (cmd_line_has_flag(cmdline, str8_lit("hide_errors"))){
     String8List vals = cmd_line_strings(cmdline, str8_lit("hide_errors"));
@@ -158,10 +202,15 @@ pdbconv_types_and_symbols(PDBCONV_TypesSymbolsParams *params, CONS_Root *out_roo
     pdbconv_gather_link_names(pdb_ctx, params->sym);
     pdbconv_symbol_cons(pdb_ctx, params->sym, 0);
   }
+  
+  // the units' symbols were decoded into fragments alongside their parses;
+  // replay them in unit order so the root sees the same sequence of calls
   U64 unit_count = params->unit_count;
   for (U64 i = 0; i < unit_count; i += 1){
-    CV_SymParsed *unit_sym = params->sym_for_unit[i];
-    pdbconv_symbol_cons(pdb_ctx, unit_sym, 1 + i);
+    PDBCONV_SymFragment *unit_frag = params->sym_frag_for_unit[i];
+    if (unit_frag != 0){
+      pdbconv_symbol_cons_from_fragment(pdb_ctx, unit_frag, 1 + i);
+    }
   }
   
   scratch_end(scratch);
@@ -183,9 +232,15 @@ pdbconv_u32_from_numeric(PDBCONV_Ctx *ctx, CV_NumericParsed *num){
 
 static COFF_SectionHeader*
 pdbconv_sec_header_from_sec_num(PDBCONV_Ctx *ctx, U32 sec_num){
+  COFF_SectionHeader *result = pdbconv_sec_header_from_sections(ctx->sections, ctx->section_count, sec_num);
+  return(result);
+}
+
+static COFF_SectionHeader*
+pdbconv_sec_header_from_sections(COFF_SectionHeader *sections, U64 section_count, U32 sec_num){
   COFF_SectionHeader *result = 0;
-  if (0 < sec_num && sec_num <= ctx->section_count){
-    result = ctx->sections + sec_num - 1;
+  if (0 < sec_num && sec_num <= section_count){
+    result = sections + sec_num - 1;
   }
   return(result);
 }
@@ -1740,85 +1795,31 @@ static void
 pdbconv_symbol_cons(PDBCONV_Ctx *ctx, CV_SymParsed *sym, U32 sym_unique_id){
   ProfBeginFunction();
   Temp scratch = scratch_begin(0, 0);
+  PDBCONV_SymFragment *frag =
+    pdbconv_sym_fragment_from_sym(scratch.arena, sym, ctx->sections, ctx->section_count);
+  pdbconv_symbol_cons_from_fragment(ctx, frag, sym_unique_id);
+  scratch_end(scratch);
+  ProfEnd();
+}
+
+static void
+pdbconv_symbol_cons_from_fragment(PDBCONV_Ctx *ctx, PDBCONV_SymFragment *frag, U32 sym_unique_id){
+  ProfBeginFunction();
   
   // extract important values from parameters
-  String8 data = sym->data;
   U64 user_id_base = (((U64)sym_unique_id) << 32);
   
-  // PASS 1: map out data associations
-  ProfScope("map out data associations")
-  {
-    // state variables
-    CONS_Symbol *current_proc = 0;
-    
-    // loop
-    CV_RecRange *rec_range = sym->sym_ranges.ranges;
-    CV_RecRange *opl = rec_range + sym->sym_ranges.count;
-    for (;rec_range < opl; rec_range += 1){
-      // symbol data range
-      U64 opl_off_raw = rec_range->off + rec_range->hdr.size;
-      U64 opl_off = ClampTop(opl_off_raw, data.size);
-      
-      U64 off_raw = rec_range->off + 2;
-      U64 off = ClampTop(off_raw, opl_off);
-      
-      U8 *first = data.str + off;
-      U64 cap = (opl_off - off);
-      
-      CV_SymKind kind = rec_range->hdr.kind; 
-      switch (kind){
-        default: break;
-        
-        case CV_SymKind_FRAMEPROC:
-        {
-          if (sizeof(CV_SymFrameproc) > cap){
-            // TODO(allen): error
-          }
-          else{
-            CV_SymFrameproc *frameproc = (CV_SymFrameproc*)first;
-            if (current_proc == 0){
-              // TODO(allen): error
-            }
-            else{
-              PDBCONV_FrameProcData data = {0};
-              data.frame_size = frameproc->frame_size;
-              data.flags = frameproc->flags;
-              pdbconv_symbol_frame_proc_write(ctx, current_proc, &data);
-            }
-          }
-        }break;
-        
-        case CV_SymKind_LPROC32:
-        case CV_SymKind_GPROC32:
-        {
-          U64 user_id = user_id_base + off;
-          current_proc = cons_symbol_handle_from_user_id(ctx->root, user_id);
-        }break;
-      }
-    }
-  }
+  // state variables
+  CONS_LocationSet *defrange_target = 0;
+  CONS_Location *defrange_location = 0;
   
-  // PASS 2: main symbol construction pass
-  ProfScope("main symbol construction pass")
-  {
-    // state variables
-    CONS_LocationSet *defrange_target = 0;
-    B32 defrange_target_is_param = 0;
-    
-    // loop
-    CV_RecRange *rec_range = sym->sym_ranges.ranges;
-    CV_RecRange *opl = rec_range + sym->sym_ranges.count;
-    for (;rec_range < opl; rec_range += 1){
-      // symbol data range
-      U64 opl_off_raw = rec_range->off + rec_range->hdr.size;
-      U64 opl_off = ClampTop(opl_off_raw, data.size);
-      
-      U64 off_raw = rec_range->off + 2;
-      U64 off = ClampTop(off_raw, opl_off);
-      
-      U8 *first = data.str + off;
-      U64 cap = (opl_off - off);
-      
+  // loop
+  for (PDBCONV_SymOpChunk *chunk = frag->first_chunk;
+       chunk != 0;
+       chunk = chunk->next){
+    PDBCONV_SymOp *op = chunk->ops;
+    PDBCONV_SymOp *opl = op + chunk->count;
+    for (;op < opl; op += 1){
       // current state
       CONS_Scope *current_scope = pdbconv_symbol_current_scope(ctx);
       CONS_Symbol *current_procedure = 0;
@@ -1826,127 +1827,50 @@ pdbconv_symbol_cons(PDBCONV_Ctx *ctx, CV_SymParsed *sym, U32 sym_unique_id){
         current_procedure = current_scope->symbol;
       }
       
-      CV_SymKind kind = rec_range->hdr.kind; 
-      switch (kind){
+      U64 user_id = user_id_base + op->off;
+      
+      switch (op->kind){
         default:break;
         
-        case CV_SymKind_END:
-        {
-          // pop scope stack
-          pdbconv_symbol_pop_scope(ctx);
-          defrange_target = 0;
-          defrange_target_is_param = 0;
-        }break;
-        
-        case CV_SymKind_FRAMEPROC:
+        case PDBCONV_SymOpKind_ProcHandle:
         {
-          if (sizeof(CV_SymFrameproc) > cap){
-            // TODO(allen): error
-          }
-          else{
-            // do nothing (handled in 'association map' pass)
-          }
+          cons_symbol_handle_from_user_id(ctx->root, user_id);
         }break;
         
-        case CV_SymKind_BLOCK32:
+        case PDBCONV_SymOpKind_End:
         {
-          if (sizeof(CV_SymBlock32) > cap){
-            // TODO(allen): error
-          }
-          else{
-            CV_SymBlock32 *block32 = (CV_SymBlock32*)first;
-            
-            // scope
-            U64 user_id = user_id_base + off;
-            CONS_Scope *block_scope = cons_scope_handle_from_user_id(ctx->root, user_id);
-            cons_scope_set_parent(ctx->root, block_scope, current_scope);
-            pdbconv_symbol_push_scope(ctx, block_scope, current_procedure);
-            
-            // set voff range
-            COFF_SectionHeader *section = pdbconv_sec_header_from_sec_num(ctx, block32->sec);
-            if (section != 0){
-              U64 voff_first = section->voff + block32->off;
-              U64 voff_last = voff_first + block32->len;
-              cons_scope_add_voff_range(ctx->root, block_scope, voff_first, voff_last);
-            }
-          }
+          // pop scope stack
+          pdbconv_symbol_pop_scope(ctx);
+          defrange_target = 0;
         }break;
         
-        case CV_SymKind_LDATA32:
-        case CV_SymKind_GDATA32:
+        case PDBCONV_SymOpKind_Block:
         {
-          if (sizeof(CV_SymData32) > cap){
-            // TODO(allen): error
-          }
-          else{
-            CV_SymData32 *data32 = (CV_SymData32*)first;
-            
-            // name
-            String8 name = str8_cstring_capped((char*)(data32 + 1), first + cap);
-            
-            // determine voff
-            COFF_SectionHeader *section = pdbconv_sec_header_from_sec_num(ctx, data32->sec);
-            U64 voff = ((section != 0)?section->voff:0) + data32->off;
-            
-            // deduplicate global variable symbols with the same name & offset
-            // * PDB likes to have duplicates of these spread across
-            // * different symbol streams so we deduplicate across the
-            // * entire translation context.
-            if (!pdbconv_known_global_lookup(&ctx->known_globals, name, voff)){
-              pdbconv_known_global_insert(ctx->temp_arena, &ctx->known_globals, name, voff);
-              
-              // type of variable
-              CONS_Type *type = pdbconv_type_resolve_itype(ctx, data32->itype);
-              
-              // container type
-              CONS_Type *container_type = 0;
-              U64 container_name_opl = pdbconv_end_of_cplusplus_container_name(name);
-              if (container_name_opl > 2){
-                String8 container_name = str8(name.str, container_name_opl - 2);
-                container_type = pdbconv_type_from_name(ctx, container_name);
-              }
-              
-              // container symbol
-              CONS_Symbol *container_symbol = 0;
-              if (container_type == 0){
-                container_symbol = current_procedure;
-              }
-              
-              // determine link kind
-              B32 is_extern = (kind == CV_SymKind_GDATA32);
-              
-              // cons this symbol
-              U64 user_id = user_id_base + off;
-              CONS_Symbol *symbol = cons_symbol_handle_from_user_id(ctx->root, user_id);
-              
-              CONS_SymbolInfo info = zero_struct;
-              info.kind = CONS_SymbolKind_GlobalVariable;
-              info.name = name;
-              info.type = type;
-              info.is_extern = is_extern;
-              info.offset = voff;
-              info.container_type = container_type;
-              info.container_symbol = container_symbol;
-              
-              cons_symbol_set_info(ctx->root, symbol, &info);
-            }
+          // scope
+          CONS_Scope *block_scope = cons_scope_handle_from_user_id(ctx->root, user_id);
+          cons_scope_set_parent(ctx->root, block_scope, current_scope);
+          pdbconv_symbol_push_scope(ctx, block_scope, current_procedure);
+          
+          // set voff range
+          if (op->flags & PDBCONV_SymOpFlag_HasRange){
+            cons_scope_add_voff_range(ctx->root, block_scope, op->voff_first, op->voff_opl);
           }
         }break;
         
-        case CV_SymKind_LPROC32:
-        case CV_SymKind_GPROC32:
+        case PDBCONV_SymOpKind_Data:
         {
-          if (sizeof(CV_SymProc32) > cap){
-            // TODO(allen): error
-          }
-          else{
-            CV_SymProc32 *proc32 = (CV_SymProc32*)first;
-            
-            // name
-            String8 name = str8_cstring_capped((char*)(proc32 + 1), first + cap);
+          String8 name = op->name;
+          U64 voff = op->val;
+          
+          // deduplicate global variable symbols with the same name & offset
+          // * PDB likes to have duplicates of these spread across
+          // * different symbol streams so we deduplicate across the
+          // * entire translation context.
+          if (!pdbconv_known_global_lookup(&ctx->known_globals, name, voff)){
+            pdbconv_known_global_insert(ctx->temp_arena, &ctx->known_globals, name, voff);
             
-            // type of procedure
-            CONS_Type *type = pdbconv_type_resolve_itype(ctx, proc32->itype);
+            // type of variable
+            CONS_Type *type = pdbconv_type_resolve_itype(ctx, op->itype);
             
             // container type
             CONS_Type *container_type = 0;
@@ -1962,201 +1886,613 @@ pdbconv_symbol_cons(PDBCONV_Ctx *ctx, CV_SymParsed *sym, U32 sym_unique_id){
               container_symbol = current_procedure;
             }
             
-            // get this symbol handle
-            U64 user_id = user_id_base + off;
-            CONS_Symbol *proc_symbol = cons_symbol_handle_from_user_id(ctx->root, user_id);
-            
-            // scope
-            
-            // NOTE: even if there could be a containing scope at this point (which should be
-            //       illegal in C/C++ but not necessarily in another language) we would not pass
-            //       it here because these scopes refer to the ranges of code that make up a
-            //       procedure *not* the namespaces, so a procedure's root scope always has
-            //       no parent.
-            CONS_Scope *root_scope = cons_scope_handle_from_user_id(ctx->root, user_id);
-            pdbconv_symbol_push_scope(ctx, root_scope, proc_symbol);
-            
-            // set voff range
-            U64 voff = 0;
-            COFF_SectionHeader *section = pdbconv_sec_header_from_sec_num(ctx, proc32->sec);
-            if (section != 0){
-              U64 voff_first = section->voff + proc32->off;
-              U64 voff_last = voff_first + proc32->len;
-              cons_scope_add_voff_range(ctx->root, root_scope, voff_first, voff_last);
-              
-              voff = voff_first;
-            }
-            
-            // link name
-            String8 link_name = {0};
-            if (voff != 0){
-              link_name = pdbconv_link_name_find(&ctx->link_names, voff);
-            }
-            
-            // determine link kind
-            B32 is_extern = (kind == CV_SymKind_GPROC32);
+            // cons this symbol
+            CONS_Symbol *symbol = cons_symbol_handle_from_user_id(ctx->root, user_id);
             
-            // set symbol info
             CONS_SymbolInfo info = zero_struct;
-            info.kind = CONS_SymbolKind_Procedure;
+            info.kind = CONS_SymbolKind_GlobalVariable;
             info.name = name;
-            info.link_name = link_name;
             info.type = type;
-            info.is_extern = is_extern;
+            info.is_extern = !!(op->flags & PDBCONV_SymOpFlag_IsExtern);
+            info.offset = voff;
             info.container_type = container_type;
             info.container_symbol = container_symbol;
-            info.root_scope = root_scope;
             
-            cons_symbol_set_info(ctx->root, proc_symbol, &info);
+            cons_symbol_set_info(ctx->root, symbol, &info);
           }
         }break;
         
-        case CV_SymKind_REGREL32:
+        case PDBCONV_SymOpKind_Proc:
         {
-          if (sizeof(CV_SymRegrel32) > cap){
-            // TODO(allen): error
+          String8 name = op->name;
+          
+          // type of procedure
+          CONS_Type *type = pdbconv_type_resolve_itype(ctx, op->itype);
+          
+          // container type
+          CONS_Type *container_type = 0;
+          U64 container_name_opl = pdbconv_end_of_cplusplus_container_name(name);
+          if (container_name_opl > 2){
+            String8 container_name = str8(name.str, container_name_opl - 2);
+            container_type = pdbconv_type_from_name(ctx, container_name);
           }
-          else{
-            // TODO(allen): hide this when it's redundant with better information
-            // from a CV_SymKind_LOCAL record.
-            
-            CV_SymRegrel32 *regrel32 = (CV_SymRegrel32*)first;
-            
-            // name
-            String8 name = str8_cstring_capped((char*)(regrel32 + 1), first + cap);
-            
-            // type of variable
-            CONS_Type *type = pdbconv_type_resolve_itype(ctx, regrel32->itype);
+          
+          // container symbol
+          CONS_Symbol *container_symbol = 0;
+          if (container_type == 0){
+            container_symbol = current_procedure;
+          }
+          
+          // get this symbol handle
+          CONS_Symbol *proc_symbol = cons_symbol_handle_from_user_id(ctx->root, user_id);
+          
+          // scope
+          
+          // NOTE: even if there could be a containing scope at this point (which should be
+          //       illegal in C/C++ but not necessarily in another language) we would not pass
+          //       it here because these scopes refer to the ranges of code that make up a
+          //       procedure *not* the namespaces, so a procedure's root scope always has
+          //       no parent.
+          CONS_Scope *root_scope = cons_scope_handle_from_user_id(ctx->root, user_id);
+          pdbconv_symbol_push_scope(ctx, root_scope, proc_symbol);
+          
+          // set voff range
+          U64 voff = 0;
+          if (op->flags & PDBCONV_SymOpFlag_HasRange){
+            cons_scope_add_voff_range(ctx->root, root_scope, op->voff_first, op->voff_opl);
+            voff = op->voff_first;
+          }
+          
+          // link name
+          String8 link_name = {0};
+          if (voff != 0){
+            link_name = pdbconv_link_name_find(&ctx->link_names, voff);
+          }
+          
+          // set symbol info
+          CONS_SymbolInfo info = zero_struct;
+          info.kind = CONS_SymbolKind_Procedure;
+          info.name = name;
+          info.link_name = link_name;
+          info.type = type;
+          info.is_extern = !!(op->flags & PDBCONV_SymOpFlag_IsExtern);
+          info.container_type = container_type;
+          info.container_symbol = container_symbol;
+          info.root_scope = root_scope;
+          
+          cons_symbol_set_info(ctx->root, proc_symbol, &info);
+        }break;
+        
+        case PDBCONV_SymOpKind_RegRel:
+        {
+          // TODO(allen): hide this when it's redundant with better information
+          // from a CV_SymKind_LOCAL record.
+          
+          // type of variable
+          CONS_Type *type = pdbconv_type_resolve_itype(ctx, op->itype);
+          
+          // extract regrel's info
+          CV_Reg cv_reg = (CV_Reg)op->reg;
+          U64 var_off = op->val;
+          
+          // need arch for analyzing register stuff
+          RADDBG_Arch arch = ctx->arch;
+          
+          // determine if this is a parameter
+          RADDBG_LocalKind local_kind = RADDBG_LocalKind_Variable;
+          {
+            B32 is_stack_reg = 0;
+            switch (arch){
+              case RADDBG_Arch_X86: is_stack_reg = (cv_reg == CV_Regx86_ESP); break;
+              case RADDBG_Arch_X64: is_stack_reg = (cv_reg == CV_Regx64_RSP); break;
+            }
+            if (is_stack_reg && var_off > op->frame_size){
+              local_kind = RADDBG_LocalKind_Parameter;
+            }
+          }
+          
+          // emit local
+          CONS_Local *local_var = cons_local_handle_from_user_id(ctx->root, user_id);
+          
+          CONS_LocalInfo info = {0};
+          info.kind = local_kind;
+          info.scope = current_scope;
+          info.name = op->name;
+          info.type = type;
+          
+          cons_local_set_basic_info(ctx->root, local_var, &info);
+          
+          // add location to local
+          {
+            // will there be an extra indirection to the value
+            B32 extra_indirection_to_value = 0;
+            switch (arch){
+              case RADDBG_Arch_X86:
+              {
+                if (local_kind == RADDBG_LocalKind_Parameter &&
+                    (type->byte_size > 4 || !IsPow2OrZero(type->byte_size))){
+                  extra_indirection_to_value = 1;
+                }
+              }break;
+              
+              case RADDBG_Arch_X64:
+              {
+                if (local_kind == RADDBG_LocalKind_Parameter &&
+                    (type->byte_size > 8 || !IsPow2OrZero(type->byte_size))){
+                  extra_indirection_to_value = 1;
+                }
+              }break;
+            }
             
-            // extract regrel's info
-            CV_Reg cv_reg = regrel32->reg;
-            U32 var_off = regrel32->reg_off;
+            // get raddbg register code
+            RADDBG_RegisterCode register_code = raddbg_reg_code_from_cv_reg_code(arch, cv_reg);
+            // TODO(allen): real byte_size & byte_pos from cv_reg goes here
+            U32 byte_size = 8;
+            U32 byte_pos = 0;
             
-            // need arch for analyzing register stuff
-            RADDBG_Arch arch = ctx->arch;
-            U64 addr_size = ctx->addr_size;
+            // set location case
+            CONS_Location *loc =
+              pdbconv_location_from_addr_reg_off(ctx, register_code, byte_size, byte_pos,
+                                                 var_off, extra_indirection_to_value);
             
-            // determine if this is a parameter
+            CONS_LocationSet *locset = cons_location_set_from_local(ctx->root, local_var);
+            cons_location_set_add_case(ctx->root, locset, 0, max_U64, loc);
+          }
+        }break;
+        
+        case PDBCONV_SymOpKind_Thread:
+        {
+          String8 name = op->name;
+          
+          // type of variable
+          CONS_Type *type = pdbconv_type_resolve_itype(ctx, op->itype);
+          
+          // container type
+          CONS_Type *container_type = 0;
+          U64 container_name_opl = pdbconv_end_of_cplusplus_container_name(name);
+          if (container_name_opl > 2){
+            String8 container_name = str8(name.str, container_name_opl - 2);
+            container_type = pdbconv_type_from_name(ctx, container_name);
+          }
+          
+          // container symbol
+          CONS_Symbol *container_symbol = 0;
+          if (container_type == 0){
+            container_symbol = current_procedure;
+          }
+          
+          // setup symbol
+          CONS_Symbol *symbol = cons_symbol_handle_from_user_id(ctx->root, user_id);
+          
+          CONS_SymbolInfo info = zero_struct;
+          info.kind = CONS_SymbolKind_ThreadVariable;
+          info.name = name;
+          info.type = type;
+          info.is_extern = !!(op->flags & PDBCONV_SymOpFlag_IsExtern);
+          info.offset = op->val;
+          info.container_type = container_type;
+          info.container_symbol = container_symbol;
+          
+          cons_symbol_set_info(ctx->root, symbol, &info);
+        }break;
+        
+        case PDBCONV_SymOpKind_Local:
+        {
+          // type of variable
+          CONS_Type *type = pdbconv_type_resolve_itype(ctx, op->itype);
+          
+          // emit a global modification
+          if (op->flags & PDBCONV_SymOpFlag_IsGlobalMod){
+            // TODO(allen): add global modification symbols
+            defrange_target = 0;
+          }
+          
+          // emit a local variable
+          else{
+            // local kind
             RADDBG_LocalKind local_kind = RADDBG_LocalKind_Variable;
-            {
-              B32 is_stack_reg = 0;
-              switch (arch){
-                case RADDBG_Arch_X86: is_stack_reg = (cv_reg == CV_Regx86_ESP); break;
-                case RADDBG_Arch_X64: is_stack_reg = (cv_reg == CV_Regx64_RSP); break;
-              }
-              if (is_stack_reg){
-                U32 frame_size = 0xFFFFFFFF;
-                if (current_procedure != 0){
-                  PDBCONV_FrameProcData *frameproc =
-                    pdbconv_symbol_frame_proc_read(ctx, current_procedure);
-                  frame_size = frameproc->frame_size;
-                }
-                if (var_off > frame_size){
-                  local_kind = RADDBG_LocalKind_Parameter;
-                }
-              }
+            if (op->flags & PDBCONV_SymOpFlag_IsParam){
+              local_kind = RADDBG_LocalKind_Parameter;
             }
             
             // emit local
-            U64 user_id = user_id_base + off;
             CONS_Local *local_var = cons_local_handle_from_user_id(ctx->root, user_id);
             
             CONS_LocalInfo info = {0};
             info.kind = local_kind;
             info.scope = current_scope;
-            info.name = name;
+            info.name = op->name;
             info.type = type;
             
             cons_local_set_basic_info(ctx->root, local_var, &info);
             
-            // add location to local
-            {
-              // will there be an extra indirection to the value
-              B32 extra_indirection_to_value = 0;
-              switch (arch){
-                case RADDBG_Arch_X86:
-                {
-                  if (local_kind == RADDBG_LocalKind_Parameter &&
-                      (type->byte_size > 4 || !IsPow2OrZero(type->byte_size))){
-                    extra_indirection_to_value = 1;
-                  }
-                }break;
-                
-                case RADDBG_Arch_X64:
-                {
-                  if (local_kind == RADDBG_LocalKind_Parameter &&
-                      (type->byte_size > 8 || !IsPow2OrZero(type->byte_size))){
-                    extra_indirection_to_value = 1;
-                  }
-                }break;
-              }
-              
-              // get raddbg register code
-              RADDBG_RegisterCode register_code = raddbg_reg_code_from_cv_reg_code(arch, cv_reg);
-              // TODO(allen): real byte_size & byte_pos from cv_reg goes here
-              U32 byte_size = 8;
-              U32 byte_pos = 0;
-              
-              // set location case
-              CONS_Location *loc =
-                pdbconv_location_from_addr_reg_off(ctx, register_code, byte_size, byte_pos,
-                                                   var_off, extra_indirection_to_value);
-              
-              CONS_LocationSet *locset = cons_location_set_from_local(ctx->root, local_var);
-              cons_location_set_add_case(ctx->root, locset, 0, max_U64, loc);
-            }
+            defrange_target = cons_location_set_from_local(ctx->root, local_var);
           }
         }break;
         
-        case CV_SymKind_LTHREAD32:
-        case CV_SymKind_GTHREAD32:
+        case PDBCONV_SymOpKind_FileStatic:
         {
-          if (sizeof(CV_SymThread32) > cap){
-            // TODO(allen): error
-          }
-          else{
-            CV_SymThread32 *thread32 = (CV_SymThread32*)first;
+          // type of variable
+          CONS_Type *type = pdbconv_type_resolve_itype(ctx, op->itype);
+          
+          // TODO(allen): emit a global modifier symbol
+          
+          // defrange records from this point attach to this location information
+          defrange_target = 0;
+        }break;
+        
+        case PDBCONV_SymOpKind_LocationRegOff:
+        {
+          // TODO(allen): offset & size from cv_reg code
+          RADDBG_RegisterCode register_code =
+            raddbg_reg_code_from_cv_reg_code(ctx->arch, (CV_Reg)op->reg);
+          U32 byte_size = ctx->addr_size;
+          U32 byte_pos = 0;
+          B32 extra_indirection = 0;
+          defrange_location =
+            pdbconv_location_from_addr_reg_off(ctx, register_code, byte_size, byte_pos,
+                                               op->val, extra_indirection);
+        }break;
+        
+        case PDBCONV_SymOpKind_LocationFramePtrOff:
+        {
+          // select frame pointer register
+          RADDBG_RegisterCode fp_register_code =
+            pdbconv_reg_code_from_arch_encoded_fp_reg(ctx->arch, (CV_EncodedFramePtrReg)op->reg);
+          U32 byte_size = ctx->addr_size;
+          U32 byte_pos = 0;
+          B32 extra_indirection = 0;
+          defrange_location =
+            pdbconv_location_from_addr_reg_off(ctx, fp_register_code, byte_size, byte_pos,
+                                               op->val, extra_indirection);
+        }break;
+        
+        case PDBCONV_SymOpKind_LocationValReg:
+        {
+          // TODO(allen): offset & size from cv_reg code
+          RADDBG_RegisterCode register_code =
+            raddbg_reg_code_from_cv_reg_code(ctx->arch, (CV_Reg)op->reg);
+          defrange_location = cons_location_val_reg(ctx->root, register_code);
+        }break;
+        
+        case PDBCONV_SymOpKind_LocationCase:
+        {
+          if (defrange_target == 0 || defrange_location == 0){
+            // TODO(allen): error
+          }
+          else{
+            cons_location_set_add_case(ctx->root, defrange_target,
+                                       op->voff_first, op->voff_opl, defrange_location);
+          }
+        }break;
+      }
+    }
+  }
+  
+  // if scope stack isn't empty emit an error
+  {
+    CONS_Scope* scope = pdbconv_symbol_current_scope(ctx);
+    if (scope != 0){
+      // TODO(allen): emit error
+    }
+  }
+  
+  // clear the scope stack
+  pdbconv_symbol_clear_scope_stack(ctx);
+  
+  ProfEnd();
+}
+
+static void
+pdbconv_gather_link_names(PDBCONV_Ctx *ctx, CV_SymParsed *sym){
+  ProfBeginFunction();
+  // extract important values from parameters
+  String8 data = sym->data;
+  
+  // loop
+  CV_RecRange *rec_range = sym->sym_ranges.ranges;
+  CV_RecRange *opl = rec_range + sym->sym_ranges.count;
+  for (;rec_range < opl; rec_range += 1){
+    // symbol data range
+    U64 opl_off_raw = rec_range->off + rec_range->hdr.size;
+    U64 opl_off = ClampTop(opl_off_raw, data.size);
+    
+    U64 off_raw = rec_range->off + 2;
+    U64 off = ClampTop(off_raw, opl_off);
+    
+    U8 *first = data.str + off;
+    U64 cap = (opl_off - off);
+    
+    CV_SymKind kind = rec_range->hdr.kind; 
+    switch (kind){
+      default: break;
+      
+      case CV_SymKind_PUB32:
+      {
+        if (sizeof(CV_SymPub32) > cap){
+          // TODO(allen): error
+        }
+        else{
+          CV_SymPub32 *pub32 = (CV_SymPub32*)first;
+          
+          // name
+          String8 name = str8_cstring_capped((char*)(pub32 + 1), first + cap);
+          
+          // calculate voff
+          U64 voff = 0;
+          COFF_SectionHeader *section = pdbconv_sec_header_from_sec_num(ctx, pub32->sec);
+          if (section != 0){
+            voff = section->voff + pub32->off;
+          }
+          
+          // save link name
+          pdbconv_link_name_save(ctx->temp_arena, &ctx->link_names, voff, name);
+        }
+      }break;
+    }
+  }
+  ProfEnd();
+}
+
+// symbol fragments
+
+static PDBCONV_SymFragment*
+pdbconv_sym_fragment_from_sym(Arena *arena, CV_SymParsed *sym,
+                              COFF_SectionHeader *sections, U64 section_count){
+  ProfBeginFunction();
+  Temp scratch = scratch_begin(&arena, 1);
+  
+  PDBCONV_SymFragment *frag = push_array(arena, PDBCONV_SymFragment, 1);
+  
+  // extract important values from parameters
+  String8 data = sym->data;
+  
+  // PASS 1: map out data associations
+  PDBCONV_FrameProcEntry *frame_procs =
+    push_array_no_zero(scratch.arena, PDBCONV_FrameProcEntry, sym->sym_ranges.count);
+  U64 frame_proc_count = 0;
+  ProfScope("map out data associations")
+  {
+    // state variables
+    B32 has_current_proc = 0;
+    U64 current_proc_off = 0;
+    
+    // loop
+    CV_RecRange *rec_range = sym->sym_ranges.ranges;
+    CV_RecRange *opl = rec_range + sym->sym_ranges.count;
+    for (;rec_range < opl; rec_range += 1){
+      // symbol data range
+      U64 opl_off_raw = rec_range->off + rec_range->hdr.size;
+      U64 opl_off = ClampTop(opl_off_raw, data.size);
+      
+      U64 off_raw = rec_range->off + 2;
+      U64 off = ClampTop(off_raw, opl_off);
+      
+      U8 *first = data.str + off;
+      U64 cap = (opl_off - off);
+      
+      CV_SymKind kind = rec_range->hdr.kind; 
+      switch (kind){
+        default: break;
+        
+        case CV_SymKind_FRAMEPROC:
+        {
+          if (sizeof(CV_SymFrameproc) > cap){
+            // TODO(allen): error
+          }
+          else{
+            CV_SymFrameproc *frameproc = (CV_SymFrameproc*)first;
+            if (!has_current_proc){
+              // TODO(allen): error
+            }
+            else if (frame_proc_count > 0 &&
+                     frame_procs[frame_proc_count - 1].proc_off == current_proc_off){
+              // TODO(allen): error
+            }
+            else{
+              PDBCONV_FrameProcEntry *entry = &frame_procs[frame_proc_count];
+              frame_proc_count += 1;
+              entry->proc_off = current_proc_off;
+              entry->data.frame_size = frameproc->frame_size;
+              entry->data.flags = frameproc->flags;
+            }
+          }
+        }break;
+        
+        case CV_SymKind_LPROC32:
+        case CV_SymKind_GPROC32:
+        {
+          has_current_proc = 1;
+          current_proc_off = off;
+          pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_ProcHandle, off);
+        }break;
+      }
+    }
+  }
+  
+  // PASS 2: main symbol decoding pass
+  ProfScope("main symbol decoding pass")
+  {
+    // scope stack
+    // (mirrors the one the replay keeps, but only tracks each scope's procedure)
+    struct ScopeNode{
+      struct ScopeNode *next;
+      PDBCONV_FrameProcData *frame_proc;
+    };
+    struct ScopeNode *scope_stack = 0;
+    struct ScopeNode *scope_free = 0;
+    
+    // state variables
+    B32 has_defrange_target = 0;
+    B32 defrange_target_is_param = 0;
+    
+    // loop
+    CV_RecRange *rec_range = sym->sym_ranges.ranges;
+    CV_RecRange *opl = rec_range + sym->sym_ranges.count;
+    for (;rec_range < opl; rec_range += 1){
+      // symbol data range
+      U64 opl_off_raw = rec_range->off + rec_range->hdr.size;
+      U64 opl_off = ClampTop(opl_off_raw, data.size);
+      
+      U64 off_raw = rec_range->off + 2;
+      U64 off = ClampTop(off_raw, opl_off);
+      
+      U8 *first = data.str + off;
+      U64 cap = (opl_off - off);
+      
+      // current state
+      PDBCONV_FrameProcData *current_frame_proc = 0;
+      if (scope_stack != 0){
+        current_frame_proc = scope_stack->frame_proc;
+      }
+      
+      CV_SymKind kind = rec_range->hdr.kind; 
+      switch (kind){
+        default:break;
+        
+        case CV_SymKind_END:
+        {
+          // pop scope stack
+          struct ScopeNode *node = scope_stack;
+          if (node != 0){
+            SLLStackPop(scope_stack);
+            SLLStackPush(scope_free, node);
+          }
+          has_defrange_target = 0;
+          defrange_target_is_param = 0;
+          pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_End, off);
+        }break;
+        
+        case CV_SymKind_BLOCK32:
+        {
+          if (sizeof(CV_SymBlock32) > cap){
+            // TODO(allen): error
+          }
+          else{
+            CV_SymBlock32 *block32 = (CV_SymBlock32*)first;
+            PDBCONV_SymOp *op = pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_Block, off);
             
-            // name
-            String8 name = str8_cstring_capped((char*)(thread32 + 1), first + cap);
+            // voff range
+            COFF_SectionHeader *section =
+              pdbconv_sec_header_from_sections(sections, section_count, block32->sec);
+            if (section != 0){
+              op->flags |= PDBCONV_SymOpFlag_HasRange;
+              op->voff_first = section->voff + block32->off;
+              op->voff_opl = op->voff_first + block32->len;
+            }
             
-            // determine tls off
-            U32 tls_off = thread32->tls_off;
+            // push scope stack
+            struct ScopeNode *node = scope_free;
+            if (node == 0){
+              node = push_array(scratch.arena, struct ScopeNode, 1);
+            }
+            else{
+              SLLStackPop(scope_free);
+            }
+            SLLStackPush(scope_stack, node);
+            node->frame_proc = current_frame_proc;
+          }
+        }break;
+        
+        case CV_SymKind_LDATA32:
+        case CV_SymKind_GDATA32:
+        {
+          if (sizeof(CV_SymData32) > cap){
+            // TODO(allen): error
+          }
+          else{
+            CV_SymData32 *data32 = (CV_SymData32*)first;
+            PDBCONV_SymOp *op = pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_Data, off);
+            op->name = str8_cstring_capped((char*)(data32 + 1), first + cap);
+            op->itype = data32->itype;
             
-            // type of variable
-            CONS_Type *type = pdbconv_type_resolve_itype(ctx, thread32->itype);
+            // determine voff
+            COFF_SectionHeader *section =
+              pdbconv_sec_header_from_sections(sections, section_count, data32->sec);
+            op->val = ((section != 0)?section->voff:0) + data32->off;
             
-            // container type
-            CONS_Type *container_type = 0;
-            U64 container_name_opl = pdbconv_end_of_cplusplus_container_name(name);
-            if (container_name_opl > 2){
-              String8 container_name = str8(name.str, container_name_opl - 2);
-              container_type = pdbconv_type_from_name(ctx, container_name);
+            // determine link kind
+            if (kind == CV_SymKind_GDATA32){
+              op->flags |= PDBCONV_SymOpFlag_IsExtern;
             }
+          }
+        }break;
+        
+        case CV_SymKind_LPROC32:
+        case CV_SymKind_GPROC32:
+        {
+          if (sizeof(CV_SymProc32) > cap){
+            // TODO(allen): error
+          }
+          else{
+            CV_SymProc32 *proc32 = (CV_SymProc32*)first;
+            PDBCONV_SymOp *op = pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_Proc, off);
+            op->name = str8_cstring_capped((char*)(proc32 + 1), first + cap);
+            op->itype = proc32->itype;
             
-            // container symbol
-            CONS_Symbol *container_symbol = 0;
-            if (container_type == 0){
-              container_symbol = current_procedure;
+            // voff range
+            COFF_SectionHeader *section =
+              pdbconv_sec_header_from_sections(sections, section_count, proc32->sec);
+            if (section != 0){
+              op->flags |= PDBCONV_SymOpFlag_HasRange;
+              op->voff_first = section->voff + proc32->off;
+              op->voff_opl = op->voff_first + proc32->len;
             }
             
             // determine link kind
-            B32 is_extern = (kind == CV_SymKind_GTHREAD32);
-            
-            // setup symbol
-            U64 user_id = user_id_base + off;
-            CONS_Symbol *symbol = cons_symbol_handle_from_user_id(ctx->root, user_id);
+            if (kind == CV_SymKind_GPROC32){
+              op->flags |= PDBCONV_SymOpFlag_IsExtern;
+            }
             
-            CONS_SymbolInfo info = zero_struct;
-            info.kind = CONS_SymbolKind_ThreadVariable;
-            info.name = name;
-            info.type = type;
-            info.is_extern = is_extern;
-            info.offset = tls_off;
-            info.container_type = container_type;
-            info.container_symbol = container_symbol;
+            // push scope stack
+            struct ScopeNode *node = scope_free;
+            if (node == 0){
+              node = push_array(scratch.arena, struct ScopeNode, 1);
+            }
+            else{
+              SLLStackPop(scope_free);
+            }
+            SLLStackPush(scope_stack, node);
+            node->frame_proc = pdbconv_frame_proc_from_off(frame_procs, frame_proc_count, off);
+          }
+        }break;
+        
+        case CV_SymKind_REGREL32:
+        {
+          if (sizeof(CV_SymRegrel32) > cap){
+            // TODO(allen): error
+          }
+          else{
+            CV_SymRegrel32 *regrel32 = (CV_SymRegrel32*)first;
+            PDBCONV_SymOp *op = pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_RegRel, off);
+            op->name = str8_cstring_capped((char*)(regrel32 + 1), first + cap);
+            op->itype = regrel32->itype;
+            op->reg = regrel32->reg;
+            op->val = regrel32->reg_off;
+            op->frame_size = 0xFFFFFFFF;
+            if (current_frame_proc != 0){
+              op->frame_size = current_frame_proc->frame_size;
+            }
+          }
+        }break;
+        
+        case CV_SymKind_LTHREAD32:
+        case CV_SymKind_GTHREAD32:
+        {
+          if (sizeof(CV_SymThread32) > cap){
+            // TODO(allen): error
+          }
+          else{
+            CV_SymThread32 *thread32 = (CV_SymThread32*)first;
+            PDBCONV_SymOp *op = pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_Thread, off);
+            op->name = str8_cstring_capped((char*)(thread32 + 1), first + cap);
+            op->itype = thread32->itype;
+            op->val = thread32->tls_off;
             
-            cons_symbol_set_info(ctx->root, symbol, &info);
+            // determine link kind
+            if (kind == CV_SymKind_GTHREAD32){
+              op->flags |= PDBCONV_SymOpFlag_IsExtern;
+            }
           }
         }break;
         
@@ -2167,49 +2503,23 @@ pdbconv_symbol_cons(PDBCONV_Ctx *ctx, CV_SymParsed *sym, U32 sym_unique_id){
           }
           else{
             CV_SymLocal *slocal = (CV_SymLocal*)first;
-            
-            // name
-            String8 name = str8_cstring_capped((char*)(slocal + 1), first + cap);
-            
-            // type of variable
-            CONS_Type *type = pdbconv_type_resolve_itype(ctx, slocal->itype);
+            PDBCONV_SymOp *op = pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_Local, off);
+            op->name = str8_cstring_capped((char*)(slocal + 1), first + cap);
+            op->itype = slocal->itype;
             
             // determine how to handle
-            B32 begin_a_global_modification = 0;
             if ((slocal->flags & CV_LocalFlag_Global) ||
                 (slocal->flags & CV_LocalFlag_Static)){
-              begin_a_global_modification = 1;
-            }
-            
-            // emit a global modification
-            if (begin_a_global_modification){
-              // TODO(allen): add global modification symbols
-              defrange_target = 0;
+              op->flags |= PDBCONV_SymOpFlag_IsGlobalMod;
+              has_defrange_target = 0;
               defrange_target_is_param = 0;
             }
-            
-            // emit a local variable
             else{
-              // local kind
-              RADDBG_LocalKind local_kind = RADDBG_LocalKind_Variable;
               if (slocal->flags & CV_LocalFlag_Param){
-                local_kind = RADDBG_LocalKind_Parameter;
+                op->flags |= PDBCONV_SymOpFlag_IsParam;
               }
-              
-              // emit local
-              U64 user_id = user_id_base + off;
-              CONS_Local *local_var = cons_local_handle_from_user_id(ctx->root, user_id);
-              
-              CONS_LocalInfo info = {0};
-              info.kind = local_kind;
-              info.scope = current_scope;
-              info.name = name;
-              info.type = type;
-              
-              cons_local_set_basic_info(ctx->root, local_var, &info);
-              
-              defrange_target = cons_location_set_from_local(ctx->root, local_var);
-              defrange_target_is_param = (local_kind == RADDBG_LocalKind_Parameter);
+              has_defrange_target = 1;
+              defrange_target_is_param = !!(slocal->flags & CV_LocalFlag_Param);
             }
           }
         }break;
@@ -2219,70 +2529,50 @@ pdbconv_symbol_cons(PDBCONV_Ctx *ctx, CV_SymParsed *sym, U32 sym_unique_id){
           if (sizeof(CV_SymDefrangeRegister) > cap){
             // TODO(allen): error
           }
+          else if (!has_defrange_target){
+            // TODO(allen): error
+          }
           else{
-            if (defrange_target == 0){
-              // TODO(allen): error
-            }
-            else{
-              CV_SymDefrangeRegister *defrange_register = (CV_SymDefrangeRegister*)first;
-              
-              // TODO(allen): offset & size from cv_reg code
-              RADDBG_Arch arch = ctx->arch;
-              CV_Reg cv_reg = defrange_register->reg;
-              RADDBG_RegisterCode register_code = raddbg_reg_code_from_cv_reg_code(arch, cv_reg);
-              
-              // setup location
-              CONS_Location *location = cons_location_val_reg(ctx->root, register_code);
-              
-              // extract range info
-              CV_LvarAddrRange *range = &defrange_register->range;
-              CV_LvarAddrGap *gaps = (CV_LvarAddrGap*)(defrange_register + 1);
-              U64 gap_count = ((first + cap) - (U8*)gaps)/sizeof(*gaps);
-              
-              // emit locations
-              pdbconv_location_over_lvar_addr_range(ctx, defrange_target, location,
-                                                    range, gaps, gap_count);
-            }
+            CV_SymDefrangeRegister *defrange_register = (CV_SymDefrangeRegister*)first;
+            PDBCONV_SymOp *op =
+              pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_LocationValReg, off);
+            op->reg = defrange_register->reg;
+            
+            // extract range info
+            CV_LvarAddrRange *range = &defrange_register->range;
+            CV_LvarAddrGap *gaps = (CV_LvarAddrGap*)(defrange_register + 1);
+            U64 gap_count = ((first + cap) - (U8*)gaps)/sizeof(*gaps);
+            
+            // emit location cases
+            pdbconv_sym_fragment_push_lvar_cases(arena, frag, sections, section_count,
+                                                 range, gaps, gap_count);
           }
         }break;
         
         case CV_SymKind_DEFRANGE_FRAMEPOINTER_REL:
-        {
-          if (sizeof(CV_SymDefrangeFramepointerRel) > cap){
-            // TODO(allen): error
-          }
-          else{
-            if (defrange_target == 0){
-              // TODO(allen): error
-            }
-            else{
-              CV_SymDefrangeFramepointerRel *defrange_fprel = (CV_SymDefrangeFramepointerRel*)first;
-              
-              // select frame pointer register
-              CV_EncodedFramePtrReg encoded_fp_reg =
-                pdbconv_cv_encoded_fp_reg_from_proc(ctx, current_procedure, defrange_target_is_param);
-              RADDBG_RegisterCode fp_register_code =
-                pdbconv_reg_code_from_arch_encoded_fp_reg(ctx->arch, encoded_fp_reg);
-              
-              // setup location
-              B32 extra_indirection = 0;
-              U32 byte_size = ctx->addr_size;
-              U32 byte_pos = 0;
-              U64 var_off = defrange_fprel->off;
-              CONS_Location *location =
-                pdbconv_location_from_addr_reg_off(ctx, fp_register_code, byte_size, byte_pos,
-                                                   var_off, extra_indirection);
-              
-              
-              // extract range info
-              CV_LvarAddrRange *range = &defrange_fprel->range;
-              CV_LvarAddrGap *gaps = (CV_LvarAddrGap*)(defrange_fprel + 1);
-              U64 gap_count = ((first + cap) - (U8*)gaps)/sizeof(*gaps);
-              
-              // emit locations
-              pdbconv_location_over_lvar_addr_range(ctx, defrange_target, location,
-                                                    range, gaps, gap_count);
-            }
+        {
+          if (sizeof(CV_SymDefrangeFramepointerRel) > cap){
+            // TODO(allen): error
+          }
+          else if (!has_defrange_target){
+            // TODO(allen): error
+          }
+          else{
+            CV_SymDefrangeFramepointerRel *defrange_fprel = (CV_SymDefrangeFramepointerRel*)first;
+            PDBCONV_SymOp *op =
+              pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_LocationFramePtrOff, off);
+            op->reg = pdbconv_cv_encoded_fp_reg_from_frame_proc(current_frame_proc,
+                                                                defrange_target_is_param);
+            op->val = defrange_fprel->off;
+            
+            // extract range info
+            CV_LvarAddrRange *range = &defrange_fprel->range;
+            CV_LvarAddrGap *gaps = (CV_LvarAddrGap*)(defrange_fprel + 1);
+            U64 gap_count = ((first + cap) - (U8*)gaps)/sizeof(*gaps);
+            
+            // emit location cases
+            pdbconv_sym_fragment_push_lvar_cases(arena, frag, sections, section_count,
+                                                 range, gaps, gap_count);
           }
         }break;
         
@@ -2291,33 +2581,26 @@ pdbconv_symbol_cons(PDBCONV_Ctx *ctx, CV_SymParsed *sym, U32 sym_unique_id){
           if (sizeof(CV_SymDefrangeSubfieldRegister) > cap){
             // TODO(allen): error
           }
+          else if (!has_defrange_target){
+            // TODO(allen): error
+          }
           else{
-            if (defrange_target == 0){
-              // TODO(allen): error
-            }
-            else{
-              CV_SymDefrangeSubfieldRegister *defrange_subfield_register = (CV_SymDefrangeSubfieldRegister*)first;
+            CV_SymDefrangeSubfieldRegister *defrange_subfield_register = (CV_SymDefrangeSubfieldRegister*)first;
+            
+            // TODO(allen): full "subfield" location system
+            if (defrange_subfield_register->field_offset == 0){
+              PDBCONV_SymOp *op =
+                pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_LocationValReg, off);
+              op->reg = defrange_subfield_register->reg;
               
-              // TODO(allen): full "subfield" location system
-              if (defrange_subfield_register->field_offset == 0){
-                
-                // TODO(allen): offset & size from cv_reg code
-                RADDBG_Arch arch = ctx->arch;
-                CV_Reg cv_reg = defrange_subfield_register->reg;
-                RADDBG_RegisterCode register_code = raddbg_reg_code_from_cv_reg_code(arch, cv_reg);
-                
-                // setup location
-                CONS_Location *location = cons_location_val_reg(ctx->root, register_code);
-                
-                // extract range info
-                CV_LvarAddrRange *range = &defrange_subfield_register->range;
-                CV_LvarAddrGap *gaps = (CV_LvarAddrGap*)(defrange_subfield_register + 1);
-                U64 gap_count = ((first + cap) - (U8*)gaps)/sizeof(*gaps);
-                
-                // emit locations
-                pdbconv_location_over_lvar_addr_range(ctx, defrange_target, location,
-                                                      range, gaps, gap_count);
-              }
+              // extract range info
+              CV_LvarAddrRange *range = &defrange_subfield_register->range;
+              CV_LvarAddrGap *gaps = (CV_LvarAddrGap*)(defrange_subfield_register + 1);
+              U64 gap_count = ((first + cap) - (U8*)gaps)/sizeof(*gaps);
+              
+              // emit location cases
+              pdbconv_sym_fragment_push_lvar_cases(arena, frag, sections, section_count,
+                                                   range, gaps, gap_count);
             }
           }
         }break;
@@ -2327,33 +2610,23 @@ pdbconv_symbol_cons(PDBCONV_Ctx *ctx, CV_SymParsed *sym, U32 sym_unique_id){
           if (sizeof(CV_SymDefrangeFramepointerRelFullScope) > cap){
             // TODO(allen): error
           }
+          else if (!has_defrange_target){
+            // TODO(allen): error
+          }
           else{
-            if (defrange_target == 0){
-              // TODO(allen): error
-            }
-            else{
-              CV_SymDefrangeFramepointerRelFullScope *defrange_fprel_full_scope =
-              (CV_SymDefrangeFramepointerRelFullScope*)first;
-              
-              // select frame pointer register
-              CV_EncodedFramePtrReg encoded_fp_reg =
-                pdbconv_cv_encoded_fp_reg_from_proc(ctx, current_procedure, defrange_target_is_param);
-              RADDBG_RegisterCode fp_register_code =
-                pdbconv_reg_code_from_arch_encoded_fp_reg(ctx->arch, encoded_fp_reg);
-              
-              // setup location
-              B32 extra_indirection = 0;
-              U32 byte_size = ctx->addr_size;
-              U32 byte_pos = 0;
-              U64 var_off = defrange_fprel_full_scope->off;
-              CONS_Location *location =
-                pdbconv_location_from_addr_reg_off(ctx, fp_register_code, byte_size, byte_pos,
-                                                   var_off, extra_indirection);
-              
-              
-              // emit location
-              cons_location_set_add_case(ctx->root, defrange_target, 0, max_U64, location);
-            }
+            CV_SymDefrangeFramepointerRelFullScope *defrange_fprel_full_scope =
+            (CV_SymDefrangeFramepointerRelFullScope*)first;
+            PDBCONV_SymOp *op =
+              pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_LocationFramePtrOff, off);
+            op->reg = pdbconv_cv_encoded_fp_reg_from_frame_proc(current_frame_proc,
+                                                                defrange_target_is_param);
+            op->val = defrange_fprel_full_scope->off;
+            
+            // emit location case
+            PDBCONV_SymOp *case_op =
+              pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_LocationCase, off);
+            case_op->voff_first = 0;
+            case_op->voff_opl = max_U64;
           }
         }break;
         
@@ -2362,39 +2635,24 @@ pdbconv_symbol_cons(PDBCONV_Ctx *ctx, CV_SymParsed *sym, U32 sym_unique_id){
           if (sizeof(CV_SymDefrangeRegisterRel) > cap){
             // TODO(allen): error
           }
+          else if (!has_defrange_target){
+            // TODO(rjf): error
+          }
           else{
             CV_SymDefrangeRegisterRel *defrange_register_rel = (CV_SymDefrangeRegisterRel*)first;
-            if(defrange_target == 0)
-            {
-              // TODO(rjf): error
-            }
-            else
-            {
-              // TODO(allen): offset & size from cv_reg code
-              RADDBG_Arch arch = ctx->arch;
-              CV_Reg cv_reg = defrange_register_rel->reg;
-              RADDBG_RegisterCode register_code = raddbg_reg_code_from_cv_reg_code(arch, cv_reg);
-              U32 byte_size = ctx->addr_size;
-              U32 byte_pos = 0;
-              
-              B32 extra_indirection_to_value = 0;
-              U64 var_off = defrange_register_rel->reg_off;
-              
-              // setup location
-              CONS_Location *location =
-                pdbconv_location_from_addr_reg_off(ctx, register_code, byte_size, byte_pos,
-                                                   var_off, extra_indirection_to_value);
-              
-              // extract range info
-              CV_LvarAddrRange *range = &defrange_register_rel->range;
-              CV_LvarAddrGap *gaps = (CV_LvarAddrGap*)(defrange_register_rel + 1);
-              U64 gap_count = ((first + cap) - (U8*)gaps)/sizeof(*gaps);
-              
-              
-              // emit locations
-              pdbconv_location_over_lvar_addr_range(ctx, defrange_target, location,
-                                                    range, gaps, gap_count);
-            }
+            PDBCONV_SymOp *op =
+              pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_LocationRegOff, off);
+            op->reg = defrange_register_rel->reg;
+            op->val = defrange_register_rel->reg_off;
+            
+            // extract range info
+            CV_LvarAddrRange *range = &defrange_register_rel->range;
+            CV_LvarAddrGap *gaps = (CV_LvarAddrGap*)(defrange_register_rel + 1);
+            U64 gap_count = ((first + cap) - (U8*)gaps)/sizeof(*gaps);
+            
+            // emit location cases
+            pdbconv_sym_fragment_push_lvar_cases(arena, frag, sections, section_count,
+                                                 range, gaps, gap_count);
           }
         }break;
         
@@ -2405,140 +2663,99 @@ pdbconv_symbol_cons(PDBCONV_Ctx *ctx, CV_SymParsed *sym, U32 sym_unique_id){
           }
           else{
             CV_SymFileStatic *file_static = (CV_SymFileStatic*)first;
-            
-            // name
-            String8 name = str8_cstring_capped((char*)(file_static + 1), first + cap);
-            
-            // type of variable
-            CONS_Type *type = pdbconv_type_resolve_itype(ctx, file_static->itype);
-            
-            // TODO(allen): emit a global modifier symbol
+            PDBCONV_SymOp *op = pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_FileStatic, off);
+            op->name = str8_cstring_capped((char*)(file_static + 1), first + cap);
+            op->itype = file_static->itype;
             
             // defrange records from this point attach to this location information
-            defrange_target = 0;
+            has_defrange_target = 0;
             defrange_target_is_param = 0;
           }
         }break;
       }
     }
-    
-    // if scope stack isn't empty emit an error
-    {
-      CONS_Scope* scope = pdbconv_symbol_current_scope(ctx);
-      if (scope != 0){
-        // TODO(allen): emit error
-      }
-    }
-    
-    // clear the scope stack
-    pdbconv_symbol_clear_scope_stack(ctx);
   }
   
   scratch_end(scratch);
   ProfEnd();
+  return(frag);
 }
 
-static void
-pdbconv_gather_link_names(PDBCONV_Ctx *ctx, CV_SymParsed *sym){
-  ProfBeginFunction();
-  // extract important values from parameters
-  String8 data = sym->data;
-  
-  // loop
-  CV_RecRange *rec_range = sym->sym_ranges.ranges;
-  CV_RecRange *opl = rec_range + sym->sym_ranges.count;
-  for (;rec_range < opl; rec_range += 1){
-    // symbol data range
-    U64 opl_off_raw = rec_range->off + rec_range->hdr.size;
-    U64 opl_off = ClampTop(opl_off_raw, data.size);
-    
-    U64 off_raw = rec_range->off + 2;
-    U64 off = ClampTop(off_raw, opl_off);
-    
-    U8 *first = data.str + off;
-    U64 cap = (opl_off - off);
-    
-    CV_SymKind kind = rec_range->hdr.kind; 
-    switch (kind){
-      default: break;
-      
-      case CV_SymKind_PUB32:
-      {
-        if (sizeof(CV_SymPub32) > cap){
-          // TODO(allen): error
-        }
-        else{
-          CV_SymPub32 *pub32 = (CV_SymPub32*)first;
-          
-          // name
-          String8 name = str8_cstring_capped((char*)(pub32 + 1), first + cap);
-          
-          // calculate voff
-          U64 voff = 0;
-          COFF_SectionHeader *section = pdbconv_sec_header_from_sec_num(ctx, pub32->sec);
-          if (section != 0){
-            voff = section->voff + pub32->off;
-          }
-          
-          // save link name
-          pdbconv_link_name_save(ctx->temp_arena, &ctx->link_names, voff, name);
-        }
-      }break;
-    }
+static PDBCONV_SymOp*
+pdbconv_sym_fragment_push(Arena *arena, PDBCONV_SymFragment *frag, PDBCONV_SymOpKind kind, U64 off){
+  PDBCONV_SymOpChunk *chunk = frag->last_chunk;
+  if (chunk == 0 || chunk->count >= ArrayCount(chunk->ops)){
+    chunk = push_array_no_zero(arena, PDBCONV_SymOpChunk, 1);
+    chunk->next = 0;
+    chunk->count = 0;
+    SLLQueuePush(frag->first_chunk, frag->last_chunk, chunk);
   }
-  ProfEnd();
+  PDBCONV_SymOp *result = &chunk->ops[chunk->count];
+  chunk->count += 1;
+  frag->op_count += 1;
+  MemoryZeroStruct(result);
+  result->kind = kind;
+  result->off = off;
+  return(result);
 }
 
-// "frameproc" map
-
 static void
-pdbconv_symbol_frame_proc_write(PDBCONV_Ctx *ctx,CONS_Symbol *key,PDBCONV_FrameProcData *data){
-  U64 key_int = IntFromPtr(key);
-  PDBCONV_FrameProcMap *map = &ctx->frame_proc_map;
-  U32 bucket_idx = key_int%ArrayCount(map->buckets);
-  
-  // find match
-  PDBCONV_FrameProcNode *match = 0;
-  for (PDBCONV_FrameProcNode *node = map->buckets[bucket_idx];
-       node != 0;
-       node = node->next){
-    if (node->key == key){
-      match = node;
-      break;
+pdbconv_sym_fragment_push_lvar_cases(Arena *arena, PDBCONV_SymFragment *frag,
+                                     COFF_SectionHeader *sections, U64 section_count,
+                                     CV_LvarAddrRange *range,
+                                     CV_LvarAddrGap *gaps, U64 gap_count){
+  // extract range info
+  U64 voff_first = 0;
+  U64 voff_opl = 0;
+  {
+    COFF_SectionHeader *section = pdbconv_sec_header_from_sections(sections, section_count, range->sec);
+    if (section != 0){
+      voff_first = section->voff + range->off;
+      voff_opl = voff_first + range->len;
     }
   }
   
-  // if there is already a match emit error
-  if (match != 0){
-    // TODO(allen): error
+  // emit ranges
+  CV_LvarAddrGap *gap_ptr = gaps;
+  U64 voff_cursor = voff_first;
+  for (U64 i = 0; i < gap_count; i += 1, gap_ptr += 1){
+    U64 voff_gap_first = voff_first + gap_ptr->off;
+    U64 voff_gap_opl   = voff_gap_first + gap_ptr->len;
+    if (voff_cursor < voff_gap_first){
+      PDBCONV_SymOp *op = pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_LocationCase, 0);
+      op->voff_first = voff_cursor;
+      op->voff_opl = voff_gap_first;
+    }
+    voff_cursor = voff_gap_opl;
   }
   
-  // insert new association if no match
-  if (match == 0){
-    match = push_array(ctx->temp_arena, PDBCONV_FrameProcNode, 1);
-    SLLStackPush(map->buckets[bucket_idx], match);
-    match->key = key;
-    MemoryCopyStruct(&match->data, data);
+  if (voff_cursor < voff_opl){
+    PDBCONV_SymOp *op = pdbconv_sym_fragment_push(arena, frag, PDBCONV_SymOpKind_LocationCase, 0);
+    op->voff_first = voff_cursor;
+    op->voff_opl = voff_opl;
   }
 }
 
+// "frameproc" table
+
 static PDBCONV_FrameProcData*
-pdbconv_symbol_frame_proc_read(PDBCONV_Ctx *ctx, CONS_Symbol *key){
-  U64 key_int = IntFromPtr(key);
-  PDBCONV_FrameProcMap *map = &ctx->frame_proc_map;
-  U32 bucket_idx = key_int%ArrayCount(map->buckets);
-  
-  // find match
+pdbconv_frame_proc_from_off(PDBCONV_FrameProcEntry *entries, U64 count, U64 proc_off){
+  // NOTE: entries are pushed in record order, so they're sorted by proc_off
   PDBCONV_FrameProcData *result = 0;
-  for (PDBCONV_FrameProcNode *node = map->buckets[bucket_idx];
-       node != 0;
-       node = node->next){
-    if (node->key == key){
-      result = &node->data;
-      break;
+  U64 first = 0;
+  U64 opl = count;
+  for (;first < opl;){
+    U64 mid = (first + opl)/2;
+    if (entries[mid].proc_off < proc_off){
+      first = mid + 1;
+    }
+    else{
+      opl = mid;
     }
   }
-  
+  if (first < count && entries[first].proc_off == proc_off){
+    result = &entries[first].data;
+  }
   return(result);
 }
 
@@ -2695,10 +2912,9 @@ pdbconv_location_from_addr_reg_off(PDBCONV_Ctx *ctx,
 }
 
 static CV_EncodedFramePtrReg
-pdbconv_cv_encoded_fp_reg_from_proc(PDBCONV_Ctx *ctx, CONS_Symbol *proc, B32 param_base){
+pdbconv_cv_encoded_fp_reg_from_frame_proc(PDBCONV_FrameProcData *frame_proc, B32 param_base){
   CV_EncodedFramePtrReg result = 0;
-  if (proc != 0){
-    PDBCONV_FrameProcData *frame_proc = pdbconv_symbol_frame_proc_read(ctx, proc);
+  if (frame_proc != 0){
     CV_FrameprocFlags flags = frame_proc->flags;
     if (param_base){
       result = CV_FrameprocFlags_ExtractParamBasePointer(flags);
@@ -2709,7 +2925,6 @@ pdbconv_cv_encoded_fp_reg_from_proc(PDBCONV_Ctx *ctx, CONS_Symbol *proc, B32 par
   }
   return(result);
 }
-
 static RADDBG_RegisterCode
 pdbconv_reg_code_from_arch_encoded_fp_reg(RADDBG_Arch arch, CV_EncodedFramePtrReg encoded_reg){
   RADDBG_RegisterCode result = 0;
@@ -2756,69 +2971,409 @@ pdbconv_reg_code_from_arch_encoded_fp_reg(RADDBG_Arch arch, CV_EncodedFramePtrRe
   return(result);
 }
 
+// link names
+
 static void
-pdbconv_location_over_lvar_addr_range(PDBCONV_Ctx *ctx,
-                                      CONS_LocationSet *locset,
-                                      CONS_Location *location,
-                                      CV_LvarAddrRange *range,
-                                      CV_LvarAddrGap *gaps, U64 gap_count){
-  // extract range info
-  U64 voff_first = 0;
-  U64 voff_opl = 0;
-  {
-    COFF_SectionHeader *section = pdbconv_sec_header_from_sec_num(ctx, range->sec);
-    if (section != 0){
-      voff_first = section->voff + range->off;
-      voff_opl = voff_first + range->len;
+pdbconv_link_name_save(Arena *arena, PDBCONV_LinkNameMap *map, U64 voff, String8 name){
+  U64 hash = (voff >> 3) ^ ((7 & voff) << 6);
+  U64 bucket_idx = hash%ArrayCount(map->buckets);
+  
+  PDBCONV_LinkNameNode *node = push_array(arena, PDBCONV_LinkNameNode, 1);
+  SLLStackPush(map->buckets[bucket_idx], node);
+  node->voff = voff;
+  node->name = push_str8_copy(arena, name);
+}
+
+static String8
+pdbconv_link_name_find(PDBCONV_LinkNameMap *map, U64 voff){
+  U64 hash = (voff >> 3) ^ ((7 & voff) << 6);
+  U64 bucket_idx = hash%ArrayCount(map->buckets);
+  
+  String8 result = {0};
+  for (PDBCONV_LinkNameNode *node = map->buckets[bucket_idx];
+       node != 0;
+       node = node->next){
+    if (node->voff == voff){
+      result = node->name;
+      break;
     }
   }
   
-  // emit ranges
-  CV_LvarAddrGap *gap_ptr = gaps;
-  U64 voff_cursor = voff_first;
-  for (U64 i = 0; i < gap_count; i += 1, gap_ptr += 1){
-    U64 voff_gap_first = voff_first + gap_ptr->off;
-    U64 voff_gap_opl   = voff_gap_first + gap_ptr->len;
-    if (voff_cursor < voff_gap_first){
-      cons_location_set_add_case(ctx->root, locset, voff_cursor, voff_gap_first, location);
+  return(result);
+}
+
+////////////////////////////////
+//~ Per-Unit Conversion Cache
+
+static U64
+pdbconv_unit_cache_context_hash(PDB_Strtbl *strtbl, PDB_CoffSectionArray *sections){
+  U64 parts[3] = {0};
+  parts[0] = PDBCONV_UNIT_CACHE_VERSION;
+  if (strtbl != 0){
+    parts[1] = raddbg_hash(strtbl->data.str, strtbl->data.size);
+  }
+  if (sections != 0){
+    parts[2] = raddbg_hash((U8*)sections->sections, sections->count*sizeof(COFF_SectionHeader));
+  }
+  U64 result = raddbg_hash((U8*)parts, sizeof(parts));
+  return(result);
+}
+
+static U64
+pdbconv_unit_cache_key(U64 context_hash, String8 sym_data, String8 c13_data){
+  U64 parts[5] = {0};
+  parts[0] = context_hash;
+  parts[1] = raddbg_hash(sym_data.str, sym_data.size);
+  parts[2] = sym_data.size;
+  parts[3] = raddbg_hash(c13_data.str, c13_data.size);
+  parts[4] = c13_data.size;
+  U64 result = raddbg_hash((U8*)parts, sizeof(parts));
+  return(result);
+}
+
+static String8
+pdbconv_unit_cache_path(Arena *arena, String8 cache_dir, U64 key){
+  String8 result = push_str8f(arena, "%S/%016llx.rdcu", cache_dir, key);
+  return(result);
+}
+
+static B32
+pdbconv_unit_cache_read(Arena *arena, String8 cache_dir, U64 key,
+                        CV_C13Parsed **c13_out, PDBCONV_SymFragment **frag_out){
+  Temp scratch = scratch_begin(&arena, 1);
+  B32 result = 0;
+  
+  String8 path = pdbconv_unit_cache_path(scratch.arena, cache_dir, key);
+  String8 data = os_data_from_file_path(scratch.arena, path);
+  
+  // check header
+  PDBCONV_UnitCacheHeader *hdr = 0;
+  if (data.size >= sizeof(PDBCONV_UnitCacheHeader)){
+    hdr = (PDBCONV_UnitCacheHeader*)data.str;
+    if (hdr->magic != PDBCONV_UNIT_CACHE_MAGIC ||
+        hdr->version != PDBCONV_UNIT_CACHE_VERSION ||
+        hdr->key != key){
+      hdr = 0;
     }
-    voff_cursor = voff_gap_opl;
   }
   
-  if (voff_cursor < voff_opl){
-    cons_location_set_add_case(ctx->root, locset, voff_cursor, voff_opl, location);
+  if (hdr != 0){
+    Temp restore_point = temp_begin(arena);
+    B32 good = 1;
+    U64 off = sizeof(*hdr);
+    
+    // rebuild the lines sub sections
+    CV_C13Parsed *c13 = push_array(arena, CV_C13Parsed, 1);
+    for (U32 i = 0; i < hdr->seq_count; i += 1){
+      // sequence header
+      if (off + sizeof(PDBCONV_UnitCacheSeqHeader) > data.size){
+        good = 0;
+        break;
+      }
+      PDBCONV_UnitCacheSeqHeader *seq_hdr = (PDBCONV_UnitCacheSeqHeader*)(data.str + off);
+      off += sizeof(*seq_hdr);
+      
+      // array sizes
+      U64 line_count = seq_hdr->line_count;
+      U64 name_size = AlignPow2((U64)seq_hdr->file_name_size, 8);
+      U64 voffs_size = (line_count + 1)*sizeof(U64);
+      U64 line_nums_size = AlignPow2(line_count*sizeof(U32), 8);
+      if (off + name_size + voffs_size + line_nums_size > data.size){
+        good = 0;
+        break;
+      }
+      
+      // copy out of the file buffer
+      CV_C13LinesParsed *lines = push_array(arena, CV_C13LinesParsed, 1);
+      lines->file_name = push_str8_copy(arena, str8(data.str + off, seq_hdr->file_name_size));
+      off += name_size;
+      lines->voffs = push_array_no_zero(arena, U64, line_count + 1);
+      MemoryCopy(lines->voffs, data.str + off, voffs_size);
+      off += voffs_size;
+      lines->line_nums = push_array_no_zero(arena, U32, line_count);
+      MemoryCopy(lines->line_nums, data.str + off, line_count*sizeof(U32));
+      off += line_nums_size;
+      lines->line_count = (U32)line_count;
+      
+      CV_C13SubSectionNode *node = push_array(arena, CV_C13SubSectionNode, 1);
+      node->kind = CV_C13_SubSectionKind_Lines;
+      node->lines = lines;
+      SLLQueuePush(c13->first_sub_section, c13->last_sub_section, node);
+      c13->sub_section_count += 1;
+    }
+    
+    // rebuild the symbol fragment
+    PDBCONV_SymFragment *frag = push_array(arena, PDBCONV_SymFragment, 1);
+    if (good){
+      U64 op_count = hdr->op_count;
+      U64 name_data_size = hdr->name_data_size;
+      if (op_count > (data.size - off)/sizeof(PDBCONV_SymOp) ||
+          name_data_size > data.size - off - op_count*sizeof(PDBCONV_SymOp)){
+        good = 0;
+      }
+      else{
+        PDBCONV_SymOp *ops = (PDBCONV_SymOp*)(data.str + off);
+        String8 name_data = push_str8_copy(arena, str8(data.str + off + op_count*sizeof(PDBCONV_SymOp),
+                                                       name_data_size));
+        U64 name_off = 0;
+        for (U64 i = 0; i < op_count; i += 1){
+          U64 name_size = ops[i].name.size;
+          if (name_size > name_data.size - name_off){
+            good = 0;
+            break;
+          }
+          PDBCONV_SymOp *op = pdbconv_sym_fragment_push(arena, frag, ops[i].kind, ops[i].off);
+          MemoryCopyStruct(op, &ops[i]);
+          op->name = str8(name_data.str + name_off, name_size);
+          name_off += name_size;
+        }
+      }
+    }
+    
+    if (good){
+      *c13_out = c13;
+      *frag_out = frag;
+      result = 1;
+    }
+    else{
+      temp_end(restore_point);
+    }
+  }
+  
+  scratch_end(scratch);
+  return(result);
+}
+
+static void
+pdbconv_unit_cache_write(String8 cache_dir, U64 key, U64 unit_idx,
+                         CV_C13Parsed *c13, PDBCONV_SymFragment *frag){
+  Temp scratch = scratch_begin(0, 0);
+  static U8 zeros[8] = {0};
+  
+  String8List list = {0};
+  PDBCONV_UnitCacheHeader *hdr = push_array(scratch.arena, PDBCONV_UnitCacheHeader, 1);
+  hdr->magic = PDBCONV_UNIT_CACHE_MAGIC;
+  hdr->key = key;
+  hdr->version = PDBCONV_UNIT_CACHE_VERSION;
+  str8_list_push(scratch.arena, &list, str8_struct(hdr));
+  
+  // line sequences
+  for (CV_C13SubSectionNode *node = c13->first_sub_section;
+       node != 0;
+       node = node->next){
+    if (node->kind == CV_C13_SubSectionKind_Lines && node->lines != 0){
+      CV_C13LinesParsed *lines = node->lines;
+      U64 line_nums_size = lines->line_count*sizeof(U32);
+      
+      PDBCONV_UnitCacheSeqHeader *seq_hdr = push_array(scratch.arena, PDBCONV_UnitCacheSeqHeader, 1);
+      seq_hdr->file_name_size = (U32)lines->file_name.size;
+      seq_hdr->line_count = lines->line_count;
+      str8_list_push(scratch.arena, &list, str8_struct(seq_hdr));
+      str8_list_push(scratch.arena, &list, lines->file_name);
+      str8_list_push(scratch.arena, &list, str8(zeros, AlignPadPow2(lines->file_name.size, 8)));
+      str8_list_push(scratch.arena, &list, str8((U8*)lines->voffs, (lines->line_count + 1)*sizeof(U64)));
+      str8_list_push(scratch.arena, &list, str8((U8*)lines->line_nums, line_nums_size));
+      str8_list_push(scratch.arena, &list, str8(zeros, AlignPadPow2(line_nums_size, 8)));
+      hdr->seq_count += 1;
+    }
+  }
+  
+  // symbol ops, then their names
+  String8List names = {0};
+  PDBCONV_SymOp *ops = push_array(scratch.arena, PDBCONV_SymOp, frag->op_count);
+  U64 op_idx = 0;
+  for (PDBCONV_SymOpChunk *chunk = frag->first_chunk;
+       chunk != 0;
+       chunk = chunk->next){
+    for (U64 i = 0; i < chunk->count; i += 1, op_idx += 1){
+      MemoryCopyStruct(&ops[op_idx], &chunk->ops[i]);
+      ops[op_idx].name.str = 0;
+      if (chunk->ops[i].name.size > 0){
+        str8_list_push(scratch.arena, &names, chunk->ops[i].name);
+      }
+    }
+  }
+  hdr->op_count = op_idx;
+  hdr->name_data_size = names.total_size;
+  str8_list_push(scratch.arena, &list, str8((U8*)ops, op_idx*sizeof(PDBCONV_SymOp)));
+  str8_list_concat_in_place(&list, &names);
+  str8_list_push(scratch.arena, &list, str8(zeros, AlignPadPow2(hdr->name_data_size, 8)));
+  
+  // write to a unique temp file, then rename it into place
+  String8 path = pdbconv_unit_cache_path(scratch.arena, cache_dir, key);
+  String8 tmp_path = push_str8f(scratch.arena, "%S.%i.%llu.tmp", path, os_get_pid(), unit_idx);
+  B32 good = os_write_data_list_to_file_path(tmp_path, list);
+  if (good){
+    good = os_move_file_path(path, tmp_path);
+  }
+  if (!good){
+    os_delete_file_at_path(tmp_path);
+  }
+  
+  scratch_end(scratch);
+}
+
+////////////////////////////////
+//~ Parallel Parse Tasks
+
+//- tasks
+
+static TS_TASK_FUNCTION_DEF(pdbconv_info_parse_task__entry_point){
+  ProfBeginFunction();
+  MSF_Parsed *msf = (MSF_Parsed*)p;
+  PDBCONV_InfoParseOut *out = push_array(arena, PDBCONV_InfoParseOut, 1);
+  
+  // parse pdb info
+  {
+    Temp scratch = scratch_begin(&arena, 1);
+    String8 info_data = msf_data_from_stream(msf, PDB_FixedStream_PdbInfo);
+    PDB_Info *info = pdb_info_from_data(scratch.arena, info_data);
+    out->named_streams = pdb_named_stream_table_from_info(arena, info);
+    MemoryCopyStruct(&out->auth_guid, &info->auth_guid);
+    scratch_end(scratch);
+  }
+  
+  // parse strtbl
+  if (out->named_streams != 0){
+    MSF_StreamNumber strtbl_sn = out->named_streams->sn[PDB_NamedStream_STRTABLE];
+    String8 strtbl_data = msf_data_from_stream(msf, strtbl_sn);
+    out->strtbl = pdb_strtbl_from_data(arena, strtbl_data);
   }
+  
+  ProfEnd();
+  return(out);
 }
 
-// link names
+static TS_TASK_FUNCTION_DEF(pdbconv_dbi_parse_task__entry_point){
+  ProfBeginFunction();
+  PDBCONV_StreamParseIn *in = (PDBCONV_StreamParseIn*)p;
+  String8 dbi_data = msf_data_from_stream(in->msf, in->sn);
+  PDB_DbiParsed *dbi = pdb_dbi_from_data(arena, dbi_data);
+  ProfEnd();
+  return(dbi);
+}
 
-static void
-pdbconv_link_name_save(Arena *arena, PDBCONV_LinkNameMap *map, U64 voff, String8 name){
-  U64 hash = (voff >> 3) ^ ((7 & voff) << 6);
-  U64 bucket_idx = hash%ArrayCount(map->buckets);
-  
-  PDBCONV_LinkNameNode *node = push_array(arena, PDBCONV_LinkNameNode, 1);
-  SLLStackPush(map->buckets[bucket_idx], node);
-  node->voff = voff;
-  node->name = push_str8_copy(arena, name);
+static TS_TASK_FUNCTION_DEF(pdbconv_tpi_parse_task__entry_point){
+  ProfBeginFunction();
+  PDBCONV_StreamParseIn *in = (PDBCONV_StreamParseIn*)p;
+  String8 tpi_data = msf_data_from_stream(in->msf, in->sn);
+  PDB_TpiParsed *tpi = pdb_tpi_from_data(arena, tpi_data);
+  ProfEnd();
+  return(tpi);
 }
 
-static String8
-pdbconv_link_name_find(PDBCONV_LinkNameMap *map, U64 voff){
-  U64 hash = (voff >> 3) ^ ((7 & voff) << 6);
-  U64 bucket_idx = hash%ArrayCount(map->buckets);
-  
-  String8 result = {0};
-  for (PDBCONV_LinkNameNode *node = map->buckets[bucket_idx];
-       node != 0;
-       node = node->next){
-    if (node->voff == voff){
-      result = node->name;
-      break;
+static TS_TASK_FUNCTION_DEF(pdbconv_coff_sections_parse_task__entry_point){
+  ProfBeginFunction();
+  PDBCONV_StreamParseIn *in = (PDBCONV_StreamParseIn*)p;
+  String8 section_data = msf_data_from_stream(in->msf, in->sn);
+  PDB_CoffSectionArray *coff_sections = pdb_coff_section_array_from_data(arena, section_data);
+  ProfEnd();
+  return(coff_sections);
+}
+
+static TS_TASK_FUNCTION_DEF(pdbconv_gsi_parse_task__entry_point){
+  ProfBeginFunction();
+  PDBCONV_StreamParseIn *in = (PDBCONV_StreamParseIn*)p;
+  String8 data = msf_data_from_stream(in->msf, in->sn);
+  String8 gsi_data = str8_range(data.str + in->skip_size, data.str + data.size);
+  PDB_GsiParsed *gsi = pdb_gsi_from_data(arena, gsi_data);
+  ProfEnd();
+  return(gsi);
+}
+
+static TS_TASK_FUNCTION_DEF(pdbconv_tpi_hash_parse_task__entry_point){
+  ProfBeginFunction();
+  PDBCONV_TpiHashParseIn *in = (PDBCONV_TpiHashParseIn*)p;
+  String8 hash_data = msf_data_from_stream(in->msf, in->tpi->hash_sn);
+  String8 aux_data = msf_data_from_stream(in->msf, in->tpi->hash_sn_aux);
+  PDB_TpiHashParsed *tpi_hash = pdb_tpi_hash_from_data(arena, in->tpi, hash_data, aux_data);
+  ProfEnd();
+  return(tpi_hash);
+}
+
+static TS_TASK_FUNCTION_DEF(pdbconv_tpi_leaf_parse_task__entry_point){
+  ProfBeginFunction();
+  PDB_TpiParsed *tpi = (PDB_TpiParsed*)p;
+  String8 leaf_data = pdb_leaf_data_from_tpi(tpi);
+  CV_LeafParsed *leaf = cv_leaf_from_data(arena, leaf_data, tpi->itype_first);
+  ProfEnd();
+  return(leaf);
+}
+
+static TS_TASK_FUNCTION_DEF(pdbconv_sym_parse_task__entry_point){
+  ProfBeginFunction();
+  PDBCONV_StreamParseIn *in = (PDBCONV_StreamParseIn*)p;
+  String8 sym_data = msf_data_from_stream(in->msf, in->sn);
+  CV_SymParsed *sym = cv_sym_from_data(arena, sym_data, 4);
+  ProfEnd();
+  return(sym);
+}
+
+static TS_TASK_FUNCTION_DEF(pdbconv_comp_units_parse_task__entry_point){
+  ProfBeginFunction();
+  PDB_DbiParsed *dbi = (PDB_DbiParsed*)p;
+  String8 mod_info_data = pdb_data_from_dbi_range(dbi, PDB_DbiRange_ModuleInfo);
+  PDB_CompUnitArray *comp_units = pdb_comp_unit_array_from_data(arena, mod_info_data);
+  ProfEnd();
+  return(comp_units);
+}
+
+static TS_TASK_FUNCTION_DEF(pdbconv_contributions_parse_task__entry_point){
+  ProfBeginFunction();
+  PDBCONV_ContributionsParseIn *in = (PDBCONV_ContributionsParseIn*)p;
+  String8 section_contribution_data = pdb_data_from_dbi_range(in->dbi, PDB_DbiRange_SecCon);
+  PDB_CompUnitContributionArray *contributions =
+    pdb_comp_unit_contribution_array_from_data(arena, section_contribution_data, in->coff_sections);
+  ProfEnd();
+  return(contributions);
+}
+
+static TS_TASK_FUNCTION_DEF(pdbconv_unit_parse_task__entry_point){
+  ProfBeginFunction();
+  PDBCONV_UnitParseIn *in = (PDBCONV_UnitParseIn*)p;
+  U64 bytes_processed = 0;
+  for (U64 i = in->unit_idx_first; i < in->unit_idx_opl; i += 1){
+    PDB_CompUnit *unit = in->units[i];
+    String8 sym_data = pdb_data_from_unit_range(in->msf, unit, PDB_DbiCompUnitRange_Symbols);
+    String8 c13_data = pdb_data_from_unit_range(in->msf, unit, PDB_DbiCompUnitRange_C13);
+    bytes_processed += sym_data.size + c13_data.size;
+    CV_SymParsed *sym = cv_sym_from_data(arena, sym_data, 4);
+    in->sym_for_unit_out[i] = sym;
+    
+    // reuse this unit's converted output if its bytes haven't changed
+    B32 use_cache = (in->cache_dir.size > 0 && sym != 0 && in->coff_sections != 0);
+    U64 cache_key = 0;
+    CV_C13Parsed *c13 = 0;
+    PDBCONV_SymFragment *frag = 0;
+    if (use_cache){
+      cache_key = pdbconv_unit_cache_key(in->cache_context_hash, sym_data, c13_data);
+      if (!pdbconv_unit_cache_read(arena, in->cache_dir, cache_key, &c13, &frag)){
+        c13 = 0;
+        frag = 0;
+      }
+    }
+    
+    // otherwise convert it: parse the line info & decode the unit's symbols
+    // now, so only the replay into the root is serial
+    if (c13 == 0){
+      c13 = cv_c13_from_data(arena, c13_data, in->strtbl, in->coff_sections);
+      if (sym != 0 && in->coff_sections != 0){
+        frag = pdbconv_sym_fragment_from_sym(arena, sym,
+                                             in->coff_sections->sections,
+                                             in->coff_sections->count);
+      }
+      if (use_cache && c13 != 0 && frag != 0){
+        pdbconv_unit_cache_write(in->cache_dir, cache_key, i, c13, frag);
+      }
     }
+    in->sym_frag_for_unit_out[i] = frag;
+    in->c13_for_unit_out[i] = c13;
   }
   
-  return(result);
+  // report the whole batch at once, to keep the hook's call count bounded
+  cons_progress_advance(in->progress, bytes_processed, in->unit_idx_opl - in->unit_idx_first);
+  ProfEnd();
+  return(0);
 }
 
 ////////////////////////////////
@@ -2833,6 +3388,13 @@ pdbconv_convert(Arena *arena, PDBCONV_Params *params)
   // will we try to parse an input file?
   B32 try_parse_input = (params->errors.node_count == 0);
   
+  // progress: bytes are of the input pdb, units are compilation units. the
+  // unit total isn't known until the dbi is parsed, so until then it's zero.
+  CONS_Progress *progress = push_array(arena, CONS_Progress, 1);
+  progress->func = params->progress_func;
+  progress->user = params->progress_user;
+  progress->bytes_total = params->input_pdb_data.size;
+  
 #define PARSE_CHECK_ERROR(p,fmt,...) do{ if ((p) == 0){\
 out->good_parse = 0;\
 str8_list_pushf(arena, &out->errors, fmt, __VA_ARGS__);\
@@ -2845,190 +3407,241 @@ str8_list_pushf(arena, &out->errors, fmt, __VA_ARGS__);\
     PARSE_CHECK_ERROR(msf, "MSF");
   }
   
-  // parse pdb info
+  //- kick off top-level stream parses
+  PDBCONV_StreamParseIn *dbi_in = 0;
+  PDBCONV_StreamParseIn *tpi_in = 0;
+  PDBCONV_StreamParseIn *ipi_in = 0;
+  TS_ArenaTask info_task = {0};
+  TS_ArenaTask dbi_task = {0};
+  TS_ArenaTask tpi_task = {0};
+  TS_ArenaTask ipi_task = {0};
+  if (msf != 0) ProfScope("kick off pdb info, dbi, tpi, ipi parses"){
+    dbi_in = push_array(arena, PDBCONV_StreamParseIn, 1);
+    dbi_in->msf = msf;
+    dbi_in->sn = PDB_FixedStream_Dbi;
+    tpi_in = push_array(arena, PDBCONV_StreamParseIn, 1);
+    tpi_in->msf = msf;
+    tpi_in->sn = PDB_FixedStream_Tpi;
+    ipi_in = push_array(arena, PDBCONV_StreamParseIn, 1);
+    ipi_in->msf = msf;
+    ipi_in->sn = PDB_FixedStream_Ipi;
+    info_task = ts_arena_task_kickoff(pdbconv_info_parse_task__entry_point, msf);
+    dbi_task = ts_arena_task_kickoff(pdbconv_dbi_parse_task__entry_point, dbi_in);
+    tpi_task = ts_arena_task_kickoff(pdbconv_tpi_parse_task__entry_point, tpi_in);
+    ipi_task = ts_arena_task_kickoff(pdbconv_tpi_parse_task__entry_point, ipi_in);
+  }
+  
+  //- join top-level stream parses
+  PDBCONV_InfoParseOut *info_out = 0;
+  PDB_DbiParsed *dbi = 0;
+  PDB_TpiParsed *tpi = 0;
+  PDB_TpiParsed *ipi = 0;
+  ProfScope("join pdb info, dbi, tpi, ipi parses"){
+    info_out = (PDBCONV_InfoParseOut*)ts_arena_task_join(arena, info_task);
+    dbi = (PDB_DbiParsed*)ts_arena_task_join(arena, dbi_task);
+    tpi = (PDB_TpiParsed*)ts_arena_task_join(arena, tpi_task);
+    ipi = (PDB_TpiParsed*)ts_arena_task_join(arena, ipi_task);
+  }
+  
+  // pdb info
   PDB_NamedStreamTable *named_streams = 0;
   COFF_Guid auth_guid = {0};
-  if (msf != 0) ProfScope("parse pdb info"){
-    Temp scratch = scratch_begin(&arena, 1);
-    
-    String8 info_data = msf_data_from_stream(msf, PDB_FixedStream_PdbInfo);
-    PDB_Info *info = pdb_info_from_data(scratch.arena, info_data);
-    named_streams = pdb_named_stream_table_from_info(arena, info);
-    MemoryCopyStruct(&auth_guid, &info->auth_guid);
-    
-    scratch_end(scratch);
-    
+  if (msf != 0){
+    named_streams = info_out->named_streams;
+    MemoryCopyStruct(&auth_guid, &info_out->auth_guid);
     PARSE_CHECK_ERROR(named_streams, "named streams from pdb info");
   }
   
-  // parse strtbl
+  // strtbl
   PDB_Strtbl *strtbl = 0;
-  if (named_streams != 0) ProfScope("parse strtbl"){
-    MSF_StreamNumber strtbl_sn = named_streams->sn[PDB_NamedStream_STRTABLE];
-    String8 strtbl_data = msf_data_from_stream(msf, strtbl_sn);
-    strtbl = pdb_strtbl_from_data(arena, strtbl_data);
-    
+  if (named_streams != 0){
+    strtbl = info_out->strtbl;
     PARSE_CHECK_ERROR(strtbl, "string table");
   }
   
-  // parse dbi
-  PDB_DbiParsed *dbi = 0;
-  if (msf != 0) ProfScope("parse dbi"){
-    String8 dbi_data = msf_data_from_stream(msf, PDB_FixedStream_Dbi);
-    dbi = pdb_dbi_from_data(arena, dbi_data);
-    
+  // dbi
+  if (msf != 0){
     PARSE_CHECK_ERROR(dbi, "DBI");
   }
   
-  // parse tpi
-  PDB_TpiParsed *tpi = 0;
-  if (msf != 0) ProfScope("parse tpi"){
-    String8 tpi_data = msf_data_from_stream(msf, PDB_FixedStream_Tpi);
-    tpi = pdb_tpi_from_data(arena, tpi_data);
-    
+  // tpi
+  if (msf != 0){
     PARSE_CHECK_ERROR(tpi, "TPI");
   }
   
-  // parse ipi
-  PDB_TpiParsed *ipi = 0;
-  if (msf != 0) ProfScope("parse ipi"){
-    String8 ipi_data = msf_data_from_stream(msf, PDB_FixedStream_Ipi);
-    ipi = pdb_tpi_from_data(arena, ipi_data);
-    
+  // ipi
+  if (msf != 0){
     PARSE_CHECK_ERROR(ipi, "IPI");
   }
   
-  // parse coff sections
+  //- kick off dependent stream parses
+  TS_ArenaTask coff_sections_task = {0};
+  TS_ArenaTask gsi_task = {0};
+  TS_ArenaTask psi_task = {0};
+  TS_ArenaTask sym_task = {0};
+  TS_ArenaTask comp_units_task = {0};
+  if (dbi != 0) ProfScope("kick off coff sections, gsi, psi, sym, compilation unit parses"){
+    PDBCONV_StreamParseIn *coff_sections_in = push_array(arena, PDBCONV_StreamParseIn, 1);
+    coff_sections_in->msf = msf;
+    coff_sections_in->sn = dbi->dbg_streams[PDB_DbiStream_SECTION_HEADER];
+    PDBCONV_StreamParseIn *gsi_in = push_array(arena, PDBCONV_StreamParseIn, 1);
+    gsi_in->msf = msf;
+    gsi_in->sn = dbi->gsi_sn;
+    PDBCONV_StreamParseIn *psi_in = push_array(arena, PDBCONV_StreamParseIn, 1);
+    psi_in->msf = msf;
+    psi_in->sn = dbi->psi_sn;
+    psi_in->skip_size = sizeof(PDB_PsiHeader);
+    PDBCONV_StreamParseIn *sym_in = push_array(arena, PDBCONV_StreamParseIn, 1);
+    sym_in->msf = msf;
+    sym_in->sn = dbi->sym_sn;
+    coff_sections_task = ts_arena_task_kickoff(pdbconv_coff_sections_parse_task__entry_point, coff_sections_in);
+    gsi_task = ts_arena_task_kickoff(pdbconv_gsi_parse_task__entry_point, gsi_in);
+    psi_task = ts_arena_task_kickoff(pdbconv_gsi_parse_task__entry_point, psi_in);
+    sym_task = ts_arena_task_kickoff(pdbconv_sym_parse_task__entry_point, sym_in);
+    comp_units_task = ts_arena_task_kickoff(pdbconv_comp_units_parse_task__entry_point, dbi);
+  }
+  TS_ArenaTask tpi_hash_task = {0};
+  TS_ArenaTask tpi_leaf_task = {0};
+  if (tpi != 0) ProfScope("kick off tpi hash & leaf parses"){
+    PDBCONV_TpiHashParseIn *tpi_hash_in = push_array(arena, PDBCONV_TpiHashParseIn, 1);
+    tpi_hash_in->msf = msf;
+    tpi_hash_in->tpi = tpi;
+    tpi_hash_task = ts_arena_task_kickoff(pdbconv_tpi_hash_parse_task__entry_point, tpi_hash_in);
+    tpi_leaf_task = ts_arena_task_kickoff(pdbconv_tpi_leaf_parse_task__entry_point, tpi);
+  }
+  TS_ArenaTask ipi_hash_task = {0};
+  TS_ArenaTask ipi_leaf_task = {0};
+  if (ipi != 0) ProfScope("kick off ipi hash & leaf parses"){
+    PDBCONV_TpiHashParseIn *ipi_hash_in = push_array(arena, PDBCONV_TpiHashParseIn, 1);
+    ipi_hash_in->msf = msf;
+    ipi_hash_in->tpi = ipi;
+    ipi_hash_task = ts_arena_task_kickoff(pdbconv_tpi_hash_parse_task__entry_point, ipi_hash_in);
+    ipi_leaf_task = ts_arena_task_kickoff(pdbconv_tpi_leaf_parse_task__entry_point, ipi);
+  }
+  
+  //- join coff sections & compilation units - needed to kick off per-unit work
   PDB_CoffSectionArray *coff_sections = 0;
   U64 coff_section_count = 0;
-  if (dbi != 0) ProfScope("parse coff sections"){
-    MSF_StreamNumber section_stream = dbi->dbg_streams[PDB_DbiStream_SECTION_HEADER];
-    String8 section_data = msf_data_from_stream(msf, section_stream);
-    coff_sections = pdb_coff_section_array_from_data(arena, section_data);
+  PDB_CompUnitArray *comp_units = 0;
+  U64 comp_unit_count = 0;
+  ProfScope("join coff sections & compilation unit parses"){
+    coff_sections = (PDB_CoffSectionArray*)ts_arena_task_join(arena, coff_sections_task);
+    comp_units = (PDB_CompUnitArray*)ts_arena_task_join(arena, comp_units_task);
+  }
+  if (dbi != 0){
     coff_section_count = coff_sections->count;
-    
-    PARSE_CHECK_ERROR(coff_sections, "coff sections");
+    comp_unit_count = comp_units->count;
+    progress->units_total = comp_unit_count;
+  }
+  if (msf != 0){
+    U64 top_level_bytes = 0;
+    MSF_StreamNumber top_level_sns[] = {PDB_FixedStream_PdbInfo, PDB_FixedStream_Dbi, PDB_FixedStream_Tpi, PDB_FixedStream_Ipi};
+    for (U64 i = 0; i < ArrayCount(top_level_sns); i += 1){
+      top_level_bytes += msf_data_from_stream(msf, top_level_sns[i]).size;
+    }
+    cons_progress_advance(progress, top_level_bytes, 0);
   }
   
-  // parse gsi
-  PDB_GsiParsed *gsi = 0;
-  if (dbi != 0) ProfScope("parse gsi"){
-    String8 gsi_data = msf_data_from_stream(msf, dbi->gsi_sn);
-    gsi = pdb_gsi_from_data(arena, gsi_data);
-    
-    PARSE_CHECK_ERROR(gsi, "GSI");
+  //- kick off dbi's section contributions
+  TS_ArenaTask contributions_task = {0};
+  if (dbi != 0 && coff_sections != 0){
+    PDBCONV_ContributionsParseIn *contributions_in = push_array(arena, PDBCONV_ContributionsParseIn, 1);
+    contributions_in->dbi = dbi;
+    contributions_in->coff_sections = coff_sections;
+    contributions_task = ts_arena_task_kickoff(pdbconv_contributions_parse_task__entry_point, contributions_in);
   }
   
-  // parse psi
-  PDB_GsiParsed *psi_gsi_part = 0;
-  if (dbi != 0) ProfScope("parse psi"){
-    String8 psi_data = msf_data_from_stream(msf, dbi->psi_sn);
-    String8 psi_data_gsi_part = str8_range(psi_data.str + sizeof(PDB_PsiHeader),
-                                           psi_data.str + psi_data.size);
-    psi_gsi_part = pdb_gsi_from_data(arena, psi_data_gsi_part);
+  //- kick off syms & c13 for each compilation unit, in batches
+  CV_SymParsed **sym_for_unit = push_array(arena, CV_SymParsed*, comp_unit_count);
+  CV_C13Parsed **c13_for_unit = push_array(arena, CV_C13Parsed*, comp_unit_count);
+  PDBCONV_SymFragment **sym_frag_for_unit = push_array(arena, PDBCONV_SymFragment*, comp_unit_count);
+  U64 unit_task_count = 0;
+  TS_ArenaTask *unit_tasks = 0;
+  if (comp_units != 0) ProfScope("kick off compilation unit symbol & c13 parses"){
+    // the dump wants the raw sub sections, which the cache doesn't keep
+    String8 cache_dir = params->cache_dir;
+    if (params->dump_c13){
+      cache_dir = str8_lit("");
+    }
+    U64 cache_context_hash = 0;
+    if (cache_dir.size > 0){
+      cache_context_hash = pdbconv_unit_cache_context_hash(strtbl, coff_sections);
+    }
     
-    PARSE_CHECK_ERROR(psi_gsi_part, "PSI");
+    U64 units_per_task = CeilIntegerDiv(comp_unit_count, ts_thread_count()*4);
+    units_per_task = ClampBot(units_per_task, 1);
+    unit_task_count = CeilIntegerDiv(comp_unit_count, units_per_task);
+    unit_tasks = push_array(arena, TS_ArenaTask, unit_task_count);
+    for (U64 task_idx = 0; task_idx < unit_task_count; task_idx += 1){
+      PDBCONV_UnitParseIn *unit_in = push_array(arena, PDBCONV_UnitParseIn, 1);
+      unit_in->msf = msf;
+      unit_in->strtbl = strtbl;
+      unit_in->coff_sections = coff_sections;
+      unit_in->units = comp_units->units;
+      unit_in->unit_idx_first = task_idx*units_per_task;
+      unit_in->unit_idx_opl = ClampTop(unit_in->unit_idx_first + units_per_task, comp_unit_count);
+      unit_in->cache_dir = cache_dir;
+      unit_in->cache_context_hash = cache_context_hash;
+      unit_in->sym_for_unit_out = sym_for_unit;
+      unit_in->c13_for_unit_out = c13_for_unit;
+      unit_in->sym_frag_for_unit_out = sym_frag_for_unit;
+      unit_in->progress = progress;
+      unit_tasks[task_idx] = ts_arena_task_kickoff(pdbconv_unit_parse_task__entry_point, unit_in);
+    }
   }
   
-  // parse tpi hash
+  //- join everything else
+  PDB_GsiParsed *gsi = 0;
+  PDB_GsiParsed *psi_gsi_part = 0;
   PDB_TpiHashParsed *tpi_hash = 0;
-  if (tpi != 0) ProfScope("parse tpi hash"){
-    String8 hash_data = msf_data_from_stream(msf, tpi->hash_sn);
-    String8 aux_data = msf_data_from_stream(msf, tpi->hash_sn_aux);
-    tpi_hash = pdb_tpi_hash_from_data(arena, tpi, hash_data, aux_data);
-    
-    PARSE_CHECK_ERROR(tpi_hash, "TPI hash table");
+  CV_LeafParsed *tpi_leaf = 0;
+  PDB_TpiHashParsed *ipi_hash = 0;
+  CV_LeafParsed *ipi_leaf = 0;
+  CV_SymParsed *sym = 0;
+  PDB_CompUnitContributionArray *comp_unit_contributions = 0;
+  U64 comp_unit_contribution_count = 0;
+  ProfScope("join remaining parses"){
+    gsi = (PDB_GsiParsed*)ts_arena_task_join(arena, gsi_task);
+    psi_gsi_part = (PDB_GsiParsed*)ts_arena_task_join(arena, psi_task);
+    tpi_hash = (PDB_TpiHashParsed*)ts_arena_task_join(arena, tpi_hash_task);
+    tpi_leaf = (CV_LeafParsed*)ts_arena_task_join(arena, tpi_leaf_task);
+    ipi_hash = (PDB_TpiHashParsed*)ts_arena_task_join(arena, ipi_hash_task);
+    ipi_leaf = (CV_LeafParsed*)ts_arena_task_join(arena, ipi_leaf_task);
+    sym = (CV_SymParsed*)ts_arena_task_join(arena, sym_task);
+    comp_unit_contributions = (PDB_CompUnitContributionArray*)ts_arena_task_join(arena, contributions_task);
+    for (U64 task_idx = 0; task_idx < unit_task_count; task_idx += 1){
+      ts_arena_task_join(arena, unit_tasks[task_idx]);
+    }
   }
   
-  // parse tpi leaves
-  CV_LeafParsed *tpi_leaf = 0;
-  if (tpi != 0) ProfScope("parse tpi leaves"){
-    String8 leaf_data = pdb_leaf_data_from_tpi(tpi);
-    tpi_leaf = cv_leaf_from_data(arena, leaf_data, tpi->itype_first);
-    
+  //- check parse results, in dependency order
+  if (dbi != 0){
+    PARSE_CHECK_ERROR(coff_sections, "coff sections");
+    PARSE_CHECK_ERROR(gsi, "GSI");
+    PARSE_CHECK_ERROR(psi_gsi_part, "PSI");
+  }
+  if (tpi != 0){
+    PARSE_CHECK_ERROR(tpi_hash, "TPI hash table");
     PARSE_CHECK_ERROR(tpi_hash, "TPI leaf data");
   }
-  
-  // parse ipi hash
-  PDB_TpiHashParsed *ipi_hash = 0;
-  if (ipi != 0) ProfScope("parse ipi hash"){
-    String8 hash_data = msf_data_from_stream(msf, ipi->hash_sn);
-    String8 aux_data = msf_data_from_stream(msf, ipi->hash_sn_aux);
-    ipi_hash = pdb_tpi_hash_from_data(arena, ipi, hash_data, aux_data);
-    
+  if (ipi != 0){
     PARSE_CHECK_ERROR(tpi_hash, "IPI hash table");
-  }
-  
-  // parse ipi leaves
-  CV_LeafParsed *ipi_leaf = 0;
-  if (ipi != 0) ProfScope("parse ipi leaves"){
-    String8 leaf_data = pdb_leaf_data_from_tpi(ipi);
-    ipi_leaf = cv_leaf_from_data(arena, leaf_data, ipi->itype_first);
-    
     PARSE_CHECK_ERROR(tpi_hash, "IPI leaf data");
   }
-  
-  // parse sym
-  CV_SymParsed *sym = 0;
-  if (dbi != 0) ProfScope("parse sym"){
-    String8 sym_data = msf_data_from_stream(msf, dbi->sym_sn);
-    sym = cv_sym_from_data(arena, sym_data, 4);
-    
+  if (dbi != 0){
     PARSE_CHECK_ERROR(tpi_hash, "public SYM data");
-  }
-  
-  // parse compilation units
-  PDB_CompUnitArray *comp_units = 0;
-  U64 comp_unit_count = 0;
-  if (dbi != 0) ProfScope("parse compilation units"){
-    String8 mod_info_data = pdb_data_from_dbi_range(dbi, PDB_DbiRange_ModuleInfo);
-    comp_units = pdb_comp_unit_array_from_data(arena, mod_info_data);
-    comp_unit_count = comp_units->count;
-    
     PARSE_CHECK_ERROR(comp_units, "module info");
   }
-  
-  // parse dbi's section contributions
-  PDB_CompUnitContributionArray *comp_unit_contributions = 0;
-  U64 comp_unit_contribution_count = 0;
-  if (dbi != 0 && coff_sections != 0) ProfScope("parse dbi section contributions"){
-    String8 section_contribution_data = pdb_data_from_dbi_range(dbi, PDB_DbiRange_SecCon);
-    comp_unit_contributions =
-      pdb_comp_unit_contribution_array_from_data(arena, section_contribution_data, coff_sections);
+  if (dbi != 0 && coff_sections != 0){
     comp_unit_contribution_count = comp_unit_contributions->count;
-    
     PARSE_CHECK_ERROR(comp_unit_contributions, "module contributions");
   }
-  
-  // parse syms for each compilation unit
-  CV_SymParsed **sym_for_unit = push_array(arena, CV_SymParsed*, comp_unit_count);
-  if (comp_units != 0) ProfScope("parse symbols"){
-    PDB_CompUnit **unit_ptr = comp_units->units;
-    for (U64 i = 0; i < comp_unit_count; i += 1, unit_ptr += 1){
-      CV_SymParsed *unit_sym = 0;
-      {
-        String8 sym_data = pdb_data_from_unit_range(msf, *unit_ptr, PDB_DbiCompUnitRange_Symbols);
-        unit_sym = cv_sym_from_data(arena, sym_data, 4);
-      }
-      PARSE_CHECK_ERROR(unit_sym, "module (i=%llu) SYM data", i);
-      
-      sym_for_unit[i] = unit_sym;
+  if (comp_units != 0){
+    for (U64 i = 0; i < comp_unit_count; i += 1){
+      PARSE_CHECK_ERROR(sym_for_unit[i], "module (i=%llu) SYM data", i);
     }
-  }
-  
-  // parse c13 for each compilation unit
-  CV_C13Parsed **c13_for_unit = push_array(arena, CV_C13Parsed*, comp_unit_count);
-  if (comp_units != 0) ProfScope("parse c13s"){
-    PDB_CompUnit **unit_ptr = comp_units->units;
-    for (U64 i = 0; i < comp_unit_count; i += 1, unit_ptr += 1){
-      CV_C13Parsed *unit_c13 = 0;
-      {
-        String8 c13_data = pdb_data_from_unit_range(msf, *unit_ptr, PDB_DbiCompUnitRange_C13);
-        unit_c13 = cv_c13_from_data(arena, c13_data, strtbl, coff_sections);
-      }
-      PARSE_CHECK_ERROR(unit_c13, "module (i=%llu) C13 line info", i);
-      
-      c13_for_unit[i] = unit_c13;
+    for (U64 i = 0; i < comp_unit_count; i += 1){
+      PARSE_CHECK_ERROR(c13_for_unit[i], "module (i=%llu) C13 line info", i);
     }
   }
   
@@ -3297,6 +3910,8 @@ str8_list_pushf(arena, &out->errors, fmt, __VA_ARGS__);\
       tli.exe_name = params->input_exe_name;
       tli.exe_hash = exe_hash;
       tli.voff_max = voff_max;
+      MemoryCopy(tli.dbg_guid, &auth_guid, sizeof(tli.dbg_guid));
+      tli.dbg_age = dbi->age;
       
       cons_set_top_level_info(root, &tli);
     }
@@ -3409,7 +4024,7 @@ str8_list_pushf(arena, &out->errors, fmt, __VA_ARGS__);\
       PDBCONV_TypesSymbolsParams pdb_params = {0};
       pdb_params.architecture = architecture;
       pdb_params.sym = sym;
-      pdb_params.sym_for_unit = sym_for_unit;
+      pdb_params.sym_frag_for_unit = sym_frag_for_unit;
       pdb_params.unit_count = comp_unit_count;
       pdb_params.tpi_hash = tpi_hash;
       pdb_params.tpi_leaf = tpi_leaf;
@@ -3429,5 +4044,164 @@ str8_list_pushf(arena, &out->errors, fmt, __VA_ARGS__);\
     }
   }
   
+  cons_progress_finish(progress);
+  
+  return out;
+}
+
+////////////////////////////////
+//~ Publics-Only Conversion Path
+
+static RADDBG_Arch
+pdbconv_arch_from_coff_machine(COFF_Arch machine){
+  RADDBG_Arch result = 0;
+  switch (machine){
+    case COFF_Arch_X86: result = RADDBG_Arch_X86; break;
+    case COFF_Arch_X64: result = RADDBG_Arch_X64; break;
+  }
+  return(result);
+}
+
+static PDBCONV_Out *
+pdbconv_convert_publics(Arena *arena, PDBCONV_Params *params){
+  PDBCONV_Out *out = push_array(arena, PDBCONV_Out, 1);
+  out->good_parse = 1;
+  
+  // will we try to parse an input file?
+  B32 try_parse_input = (params->errors.node_count == 0);
+  
+  // parse msf file
+  MSF_Parsed *msf = 0;
+  if (try_parse_input) ProfScope("parse msf"){
+    msf = msf_parsed_from_data(arena, params->input_pdb_data);
+    if (msf == 0){
+      out->good_parse = 0;
+      str8_list_pushf(arena, &out->errors, "MSF");
+    }
+  }
+  
+  // dbi
+  PDB_DbiParsed *dbi = 0;
+  if (msf != 0) ProfScope("parse dbi"){
+    dbi = pdb_dbi_from_data(arena, msf_data_from_stream(msf, PDB_FixedStream_Dbi));
+    if (dbi == 0){
+      out->good_parse = 0;
+      str8_list_pushf(arena, &out->errors, "DBI");
+    }
+  }
+  
+  // coff sections & public symbols
+  PDB_CoffSectionArray *coff_sections = 0;
+  CV_SymParsed *sym = 0;
+  if (dbi != 0) ProfScope("parse coff sections & public symbols"){
+    String8 section_data = msf_data_from_stream(msf, dbi->dbg_streams[PDB_DbiStream_SECTION_HEADER]);
+    coff_sections = pdb_coff_section_array_from_data(arena, section_data);
+    sym = cv_sym_from_data(arena, msf_data_from_stream(msf, dbi->sym_sn), 4);
+    if (coff_sections == 0){
+      out->good_parse = 0;
+      str8_list_pushf(arena, &out->errors, "coff sections");
+    }
+    if (sym == 0){
+      out->good_parse = 0;
+      str8_list_pushf(arena, &out->errors, "public SYM data");
+    }
+  }
+  
+  // parsing error
+  if (try_parse_input && !out->good_parse &&
+      !params->hide_errors.parsing){
+    str8_list_pushf(arena, &out->errors, "error(parsing): '%S' as a PDB\n", params->input_pdb_name);
+  }
+  
+  if (out->good_parse) ProfScope("convert publics"){
+    COFF_SectionHeader *sections = coff_sections->sections;
+    U64 section_count = coff_sections->count;
+    
+    // gather publics
+    U64 public_cap = sym->sym_ranges.count;
+    CONS_Public *publics = push_array_no_zero(arena, CONS_Public, public_cap);
+    U64 public_count = 0;
+    {
+      String8 data = sym->data;
+      CV_RecRange *rec_range = sym->sym_ranges.ranges;
+      CV_RecRange *opl = rec_range + sym->sym_ranges.count;
+      for (;rec_range < opl; rec_range += 1){
+        if (rec_range->hdr.kind != CV_SymKind_PUB32){
+          continue;
+        }
+        
+        // symbol data range
+        U64 opl_off_raw = rec_range->off + rec_range->hdr.size;
+        U64 opl_off = ClampTop(opl_off_raw, data.size);
+        U64 off_raw = rec_range->off + 2;
+        U64 off = ClampTop(off_raw, opl_off);
+        U8 *first = data.str + off;
+        U64 cap = (opl_off - off);
+        if (sizeof(CV_SymPub32) > cap){
+          continue;
+        }
+        CV_SymPub32 *pub32 = (CV_SymPub32*)first;
+        if (!(0 < pub32->sec && pub32->sec <= section_count)){
+          continue;
+        }
+        
+        // fill public; it runs to the end of its section until the root
+        // builder cuts it at the next public
+        COFF_SectionHeader *section = sections + pub32->sec - 1;
+        CONS_Public *pub = publics + public_count;
+        public_count += 1;
+        pub->name = str8_cstring_capped((char*)(pub32 + 1), first + cap);
+        pub->voff = section->voff + pub32->off;
+        pub->voff_opl = section->voff + section->vsize;
+        pub->is_function = !!(pub32->flags & (CV_PubFlag_Code|CV_PubFlag_Function));
+      }
+    }
+    
+    // architecture
+    RADDBG_Arch architecture = pdbconv_arch_from_coff_machine(dbi->arch);
+    U64 addr_size = raddbg_addr_size_from_arch(architecture);
+    
+    // setup root & symbols
+    CONS_Root *root = cons_root_new_from_publics(addr_size, publics, public_count);
+    out->root = root;
+    
+    // top level info
+    {
+      U64 voff_max = 0;
+      for (U64 i = 0; i < section_count; i += 1){
+        voff_max = Max(voff_max, sections[i].voff + sections[i].vsize);
+      }
+      CONS_TopLevelInfo tli = {0};
+      tli.architecture = architecture;
+      tli.exe_name = params->input_exe_name;
+      // NOTE: exe_hash stays zero; hashing the whole exe would cost more
+      // than the rest of this publics-only pass
+      tli.voff_max = voff_max;
+      cons_set_top_level_info(root, &tli);
+    }
+    
+    // setup binary sections
+    for (U64 i = 0; i < section_count; i += 1){
+      COFF_SectionHeader *coff_ptr = sections + i;
+      char *name_first = (char*)coff_ptr->name;
+      char *name_opl   = name_first + sizeof(coff_ptr->name);
+      String8 name = str8_cstring_capped(name_first, name_opl);
+      RADDBG_BinarySectionFlags flags =
+        raddbg_binary_section_flags_from_coff_section_flags(coff_ptr->flags);
+      cons_add_binary_section(root, name, flags,
+                              coff_ptr->voff, coff_ptr->voff + coff_ptr->vsize,
+                              coff_ptr->foff, coff_ptr->foff + coff_ptr->fsize);
+    }
+    
+    // conversion errors
+    if (!params->hide_errors.converting){
+      for (CONS_Error *error = cons_get_first_error(root);
+           error != 0;
+           error = error->next){
+        str8_list_push(arena, &out->errors, error->msg);
+      }
+    }
+  }
+  
   return out;
 }
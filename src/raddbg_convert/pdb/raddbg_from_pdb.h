@@ -10,12 +10,21 @@
 typedef struct PDBCONV_Params{
   String8 input_pdb_name;
   String8 input_pdb_data;
+  OS_FileView input_pdb_view;
   
   String8 input_exe_name;
   String8 input_exe_data;
+  OS_FileView input_exe_view;
   
   String8 output_name;
   
+  U64 thread_count;
+  
+  String8 cache_dir;
+  
+  CONS_ProgressFunctionType *progress_func;
+  void *progress_user;
+  
   struct{
     B8 input;
     B8 output;
@@ -67,15 +76,71 @@ typedef struct PDBCONV_FrameProcData{
   CV_FrameprocFlags flags;
 } PDBCONV_FrameProcData;
 
-typedef struct PDBCONV_FrameProcNode{
-  struct PDBCONV_FrameProcNode *next;
-  CONS_Symbol *key;
+typedef struct PDBCONV_FrameProcEntry{
+  U64 proc_off;
   PDBCONV_FrameProcData data;
-} PDBCONV_FrameProcNode;
+} PDBCONV_FrameProcEntry;
+
+// NOTE: a symbol stream converts in two halves. the first decodes the
+// stream's records into a flat list of "symbol ops", which depend only on the
+// stream's own bytes & the section table, so every unit's ops can be built on
+// a worker. the second replays the ops against the shared root, one stream at
+// a time in stream order, making the same cons calls in the same order as a
+// direct conversion would - so the baked output doesn't depend on threading.
+
+typedef U32 PDBCONV_SymOpKind;
+typedef enum{
+  PDBCONV_SymOpKind_Null,
+  PDBCONV_SymOpKind_ProcHandle,
+  PDBCONV_SymOpKind_End,
+  PDBCONV_SymOpKind_Block,
+  PDBCONV_SymOpKind_Data,
+  PDBCONV_SymOpKind_Proc,
+  PDBCONV_SymOpKind_RegRel,
+  PDBCONV_SymOpKind_Thread,
+  PDBCONV_SymOpKind_Local,
+  PDBCONV_SymOpKind_FileStatic,
+  PDBCONV_SymOpKind_LocationRegOff,
+  PDBCONV_SymOpKind_LocationFramePtrOff,
+  PDBCONV_SymOpKind_LocationValReg,
+  PDBCONV_SymOpKind_LocationCase,
+  PDBCONV_SymOpKind_COUNT
+} PDBCONV_SymOpKindEnum;
+
+typedef U32 PDBCONV_SymOpFlags;
+typedef enum{
+  PDBCONV_SymOpFlag_HasRange      = (1 << 0),
+  PDBCONV_SymOpFlag_IsExtern      = (1 << 1),
+  PDBCONV_SymOpFlag_IsParam       = (1 << 2),
+  PDBCONV_SymOpFlag_IsGlobalMod   = (1 << 3),
+} PDBCONV_SymOpFlagsEnum;
+
+typedef struct PDBCONV_SymOp{
+  PDBCONV_SymOpKind kind;
+  PDBCONV_SymOpFlags flags;
+  CV_TypeId itype;
+  U32 reg;        // CV_Reg; CV_EncodedFramePtrReg for LocationFramePtrOff
+  U32 frame_size; // RegRel: the enclosing procedure's frame size
+  U64 off;        // record offset - the user id within the stream
+  U64 val;        // data voff, tls offset, or register offset
+  U64 voff_first;
+  U64 voff_opl;
+  String8 name;
+} PDBCONV_SymOp;
 
-typedef struct PDBCONV_FrameProcMap{
-  PDBCONV_FrameProcNode *buckets[1<<24];
-} PDBCONV_FrameProcMap;
+#define PDBCONV_SYM_OP_CHUNK_CAP 256
+
+typedef struct PDBCONV_SymOpChunk{
+  struct PDBCONV_SymOpChunk *next;
+  U64 count;
+  PDBCONV_SymOp ops[PDBCONV_SYM_OP_CHUNK_CAP];
+} PDBCONV_SymOpChunk;
+
+typedef struct PDBCONV_SymFragment{
+  PDBCONV_SymOpChunk *first_chunk;
+  PDBCONV_SymOpChunk *last_chunk;
+  U64 op_count;
+} PDBCONV_SymFragment;
 
 typedef struct PDBCONV_ScopeNode{
   struct PDBCONV_ScopeNode *next;
@@ -97,7 +162,7 @@ typedef struct PDBCONV_KnownGlobalSet{
 typedef struct PDBCONV_TypesSymbolsParams{
   RADDBG_Arch architecture;
   CV_SymParsed *sym;
-  CV_SymParsed **sym_for_unit;
+  PDBCONV_SymFragment **sym_frag_for_unit;
   U64 unit_count;
   PDB_TpiHashParsed *tpi_hash;
   CV_LeafParsed *tpi_leaf;
@@ -133,7 +198,6 @@ typedef struct PDBCONV_Ctx{
   PDBCONV_TypeRev *member_revisit_last;
   PDBCONV_TypeRev *enum_revisit_first;
   PDBCONV_TypeRev *enum_revisit_last;
-  PDBCONV_FrameProcMap frame_proc_map;
   PDBCONV_ScopeNode *scope_stack;
   PDBCONV_ScopeNode *scope_node_free;
   PDBCONV_KnownGlobalSet known_globals;
@@ -146,6 +210,8 @@ static void pdbconv_types_and_symbols(PDBCONV_TypesSymbolsParams *params, CONS_R
 //- decoding helpers
 static U32 pdbconv_u32_from_numeric(PDBCONV_Ctx *ctx, CV_NumericParsed *num);
 static COFF_SectionHeader* pdbconv_sec_header_from_sec_num(PDBCONV_Ctx *ctx, U32 sec_num);
+static COFF_SectionHeader* pdbconv_sec_header_from_sections(COFF_SectionHeader *sections,
+                                                            U64 section_count, U32 sec_num);
 
 //- type info
 
@@ -187,12 +253,27 @@ static CV_TypeId pdbconv_type_fwd_map_get(PDBCONV_FwdMap *map, CV_TypeId key);
 
 // symbol info construction
 static void pdbconv_symbol_cons(PDBCONV_Ctx *ctx, CV_SymParsed *sym, U32 sym_unique_id);
+static void pdbconv_symbol_cons_from_fragment(PDBCONV_Ctx *ctx, PDBCONV_SymFragment *frag,
+                                              U32 sym_unique_id);
 static void pdbconv_gather_link_names(PDBCONV_Ctx *ctx, CV_SymParsed *sym);
 
-// "frameproc" map
-static void                   pdbconv_symbol_frame_proc_write(PDBCONV_Ctx *ctx,CONS_Symbol *key,
-                                                              PDBCONV_FrameProcData *data);
-static PDBCONV_FrameProcData* pdbconv_symbol_frame_proc_read(PDBCONV_Ctx *ctx, CONS_Symbol *key);
+// symbol fragments
+static PDBCONV_SymFragment* pdbconv_sym_fragment_from_sym(Arena *arena, CV_SymParsed *sym,
+                                                          COFF_SectionHeader *sections,
+                                                          U64 section_count);
+static PDBCONV_SymOp*       pdbconv_sym_fragment_push(Arena *arena, PDBCONV_SymFragment *frag,
+                                                      PDBCONV_SymOpKind kind, U64 off);
+static void                 pdbconv_sym_fragment_push_lvar_cases(Arena *arena,
+                                                                 PDBCONV_SymFragment *frag,
+                                                                 COFF_SectionHeader *sections,
+                                                                 U64 section_count,
+                                                                 CV_LvarAddrRange *range,
+                                                                 CV_LvarAddrGap *gaps,
+                                                                 U64 gap_count);
+
+// "frameproc" table
+static PDBCONV_FrameProcData* pdbconv_frame_proc_from_off(PDBCONV_FrameProcEntry *entries,
+                                                          U64 count, U64 proc_off);
 
 // scope stack
 static void pdbconv_symbol_push_scope(PDBCONV_Ctx *ctx, CONS_Scope *scope, CONS_Symbol *symbol);
@@ -224,24 +305,111 @@ static CONS_Location* pdbconv_location_from_addr_reg_off(PDBCONV_Ctx *ctx,
                                                          U64 offset,
                                                          B32 extra_indirection);
 
-static CV_EncodedFramePtrReg pdbconv_cv_encoded_fp_reg_from_proc(PDBCONV_Ctx *ctx,
-                                                                 CONS_Symbol *proc,
-                                                                 B32 param_base);
+static CV_EncodedFramePtrReg pdbconv_cv_encoded_fp_reg_from_frame_proc(PDBCONV_FrameProcData *frame_proc,
+                                                                       B32 param_base);
 
 static RADDBG_RegisterCode pdbconv_reg_code_from_arch_encoded_fp_reg(RADDBG_Arch arch,
                                                                      CV_EncodedFramePtrReg encoded_reg);
 
-static void pdbconv_location_over_lvar_addr_range(PDBCONV_Ctx *ctx,
-                                                  CONS_LocationSet *locset,
-                                                  CONS_Location *location,
-                                                  CV_LvarAddrRange *range,
-                                                  CV_LvarAddrGap *gaps, U64 gap_count);
-
 // link names
 static void    pdbconv_link_name_save(Arena *arena, PDBCONV_LinkNameMap *map,
                                       U64 voff, String8 name);
 static String8 pdbconv_link_name_find(PDBCONV_LinkNameMap *map, U64 voff);
 
+////////////////////////////////
+//~ Per-Unit Conversion Cache
+
+// NOTE: one file per compilation unit in the cache directory, named by the
+// unit's key. the file holds the unit's converted output - its line sequences
+// and its symbol fragment - so a hit skips both the C13 parse & the symbol
+// decode. the key hashes the unit's SYM & C13 bytes together with everything
+// else that output depends on (section headers & string table), so a changed
+// unit simply misses and is reconverted. files are written to a temp path &
+// renamed into place, so readers only ever see whole files.
+
+#define PDBCONV_UNIT_CACHE_MAGIC   0x6E75636762646172ull // "radbgcun"
+#define PDBCONV_UNIT_CACHE_VERSION 2
+
+typedef struct PDBCONV_UnitCacheHeader{
+  U64 magic;
+  U64 key;
+  U32 version;
+  U32 seq_count;
+  U64 op_count;
+  U64 name_data_size;
+} PDBCONV_UnitCacheHeader;
+
+typedef struct PDBCONV_UnitCacheSeqHeader{
+  U32 file_name_size;
+  U32 line_count;
+} PDBCONV_UnitCacheSeqHeader;
+
+// (each sequence is laid out as: header, file name padded to 8 bytes,
+//  voffs[line_count + 1], line_nums[line_count] padded to 8 bytes;
+//  the sequences are followed by ops[op_count] with their name pointers
+//  zeroed, then every op's name bytes back to back, padded to 8 bytes)
+
+static U64     pdbconv_unit_cache_context_hash(PDB_Strtbl *strtbl, PDB_CoffSectionArray *sections);
+static U64     pdbconv_unit_cache_key(U64 context_hash, String8 sym_data, String8 c13_data);
+static String8 pdbconv_unit_cache_path(Arena *arena, String8 cache_dir, U64 key);
+static B32     pdbconv_unit_cache_read(Arena *arena, String8 cache_dir, U64 key,
+                                       CV_C13Parsed **c13_out, PDBCONV_SymFragment **frag_out);
+static void    pdbconv_unit_cache_write(String8 cache_dir, U64 key, U64 unit_idx,
+                                        CV_C13Parsed *c13, PDBCONV_SymFragment *frag);
+
+////////////////////////////////
+//~ Parallel Parse Tasks
+
+typedef struct PDBCONV_InfoParseOut{
+  PDB_NamedStreamTable *named_streams;
+  COFF_Guid auth_guid;
+  PDB_Strtbl *strtbl;
+} PDBCONV_InfoParseOut;
+
+typedef struct PDBCONV_StreamParseIn{
+  MSF_Parsed *msf;
+  MSF_StreamNumber sn;
+  U64 skip_size;
+} PDBCONV_StreamParseIn;
+
+typedef struct PDBCONV_TpiHashParseIn{
+  MSF_Parsed *msf;
+  PDB_TpiParsed *tpi;
+} PDBCONV_TpiHashParseIn;
+
+typedef struct PDBCONV_ContributionsParseIn{
+  PDB_DbiParsed *dbi;
+  PDB_CoffSectionArray *coff_sections;
+} PDBCONV_ContributionsParseIn;
+
+typedef struct PDBCONV_UnitParseIn{
+  MSF_Parsed *msf;
+  PDB_Strtbl *strtbl;
+  PDB_CoffSectionArray *coff_sections;
+  PDB_CompUnit **units;
+  U64 unit_idx_first;
+  U64 unit_idx_opl;
+  String8 cache_dir;
+  U64 cache_context_hash;
+  CV_SymParsed **sym_for_unit_out;
+  CV_C13Parsed **c13_for_unit_out;
+  PDBCONV_SymFragment **sym_frag_for_unit_out;
+  CONS_Progress *progress;
+} PDBCONV_UnitParseIn;
+
+// tasks
+static TS_TASK_FUNCTION_DEF(pdbconv_info_parse_task__entry_point);
+static TS_TASK_FUNCTION_DEF(pdbconv_dbi_parse_task__entry_point);
+static TS_TASK_FUNCTION_DEF(pdbconv_tpi_parse_task__entry_point);
+static TS_TASK_FUNCTION_DEF(pdbconv_coff_sections_parse_task__entry_point);
+static TS_TASK_FUNCTION_DEF(pdbconv_gsi_parse_task__entry_point);
+static TS_TASK_FUNCTION_DEF(pdbconv_tpi_hash_parse_task__entry_point);
+static TS_TASK_FUNCTION_DEF(pdbconv_tpi_leaf_parse_task__entry_point);
+static TS_TASK_FUNCTION_DEF(pdbconv_sym_parse_task__entry_point);
+static TS_TASK_FUNCTION_DEF(pdbconv_comp_units_parse_task__entry_point);
+static TS_TASK_FUNCTION_DEF(pdbconv_contributions_parse_task__entry_point);
+static TS_TASK_FUNCTION_DEF(pdbconv_unit_parse_task__entry_point);
+
 ////////////////////////////////
 //~ Conversion Output Type
 
@@ -259,4 +427,16 @@ struct PDBCONV_Out
 
 static PDBCONV_Out *pdbconv_convert(Arena *arena, PDBCONV_Params *params);
 
+////////////////////////////////
+//~ Publics-Only Conversion Path
+
+// NOTE: a cheap first tier - only the DBI, section headers, and the public
+// symbol stream are parsed. every function public becomes a procedure whose
+// range runs to the next public, so symbolization & the procedure vmap work,
+// but there are no types, locals, units, or line info.
+
+static RADDBG_Arch pdbconv_arch_from_coff_machine(COFF_Arch machine);
+
+static PDBCONV_Out *pdbconv_convert_publics(Arena *arena, PDBCONV_Params *params);
+
 #endif //RADDBG_FROM_PDB_H
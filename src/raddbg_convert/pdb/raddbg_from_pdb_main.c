@@ -3,6 +3,7 @@
 
 #include "base/base_inc.h"
 #include "os/os_inc.h"
+#include "task_system/task_system.h"
 #include "coff/coff.h"
 #include "raddbg_format/raddbg_format.h"
 #include "raddbg_cons/raddbg_cons.h"
@@ -22,6 +23,7 @@
 #include "base/base_inc.c"
 #include "coff/coff.c"
 #include "os/os_inc.c"
+#include "task_system/task_system.c"
 #include "raddbg_format/raddbg_format.c"
 #include "raddbg_cons/raddbg_cons.c"
 
@@ -60,6 +62,10 @@ main(int argc, char **argv){
   //- rjf: parse arguments
   PDBCONV_Params *params = pdb_convert_params_from_cmd_line(arena, &cmdline);
   
+  //- start worker threads - the main thread participates in joins, so it
+  // counts as one of the requested threads
+  ts_init(params->thread_count - 1);
+  
   //- rjf: show input errors
   if (params->errors.node_count > 0 &&
       !params->hide_errors.input){
@@ -111,6 +117,10 @@ main(int argc, char **argv){
     fclose(out_file);
   }
   
+  //- close input views
+  os_file_view_close(&params->input_pdb_view);
+  os_file_view_close(&params->input_exe_view);
+  
   ProfEndCapture();
   return(0);
 }
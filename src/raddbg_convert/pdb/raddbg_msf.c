@@ -173,6 +173,8 @@ msf_parsed_from_data(Arena *arena, String8 msf_data){
     U32 stream_count = 0;
     B32 got_streams = 0;
     String8 *streams = 0;
+    U32 **stream_blocks = 0;
+    U32 *stream_states = 0;
     
     if (got_directory){
       got_streams = 1;
@@ -193,6 +195,8 @@ msf_parsed_from_data(Arena *arena, String8 msf_data){
       // set output buffer and count
       stream_count = stream_count__inner;
       streams = push_array(arena, String8, stream_count);
+      stream_blocks = push_array(arena, U32*, stream_count);
+      stream_states = push_array(arena, U32, stream_count);
       
       // iterate sizes and indices in lock step
       U32 entry_cursor = all_stream_entries_off;
@@ -211,14 +215,11 @@ msf_parsed_from_data(Arena *arena, String8 msf_data){
         U32 stream_block_count = ClampTop(stream_block_count_raw, stream_block_count_max);
         U32 stream_size = ClampTop(stream_size_raw, stream_block_count*block_size);
         
-        // copy stream data
-        U8 *stream_buf = push_array(arena, U8, stream_size);
-        stream_ptr->str = stream_buf;
-        stream_ptr->size = stream_size;
-        
+        // read block indices
+        U32 *blocks = push_array_no_zero(arena, U32, stream_block_count);
+        B32 is_contiguous = 1;
         U32 sub_index_cursor = index_cursor;
-        U8 *stream_out_ptr = stream_buf;
-        for (U32 i = 0; i < stream_block_count; i += 1, sub_index_cursor += index_size){
+        for (U32 j = 0; j < stream_block_count; j += 1, sub_index_cursor += index_size){
           
           // read index
           U32 stream_block_index = 0;
@@ -233,22 +234,27 @@ msf_parsed_from_data(Arena *arena, String8 msf_data){
             goto parse_streams_done;
           }
           
-          U64 stream_block_off = (U64)(stream_block_index)*block_size;
-          U8 *stream_block_base = (msf_data.str + stream_block_off);
-          
-          // clamp copy size by end of stream
-          U32 copy_size = 0;
-          {
-            U32 stream_pos = (U32)(stream_out_ptr - stream_buf);
-            U32 remaining_size = stream_size - stream_pos;
-            copy_size = ClampTop(block_size, remaining_size);
+          blocks[j] = stream_block_index;
+          if (j > 0 && stream_block_index != blocks[j - 1] + 1){
+            is_contiguous = 0;
           }
-          
-          // copy block data
-          MemoryCopy(stream_out_ptr, stream_block_base, copy_size);
-          stream_out_ptr += copy_size;
         }
         
+        // contiguous streams are views into the file; others get a buffer
+        //  that is not touched until the stream is first requested
+        U64 first_off = (stream_block_count > 0)?(U64)(blocks[0])*block_size:0;
+        if (is_contiguous && first_off + stream_size <= msf_data.size){
+          stream_ptr->str = msf_data.str + first_off;
+          stream_ptr->size = stream_size;
+          stream_states[i] = MSF_StreamState_Ready;
+        }
+        else{
+          stream_ptr->str = push_array_no_zero(arena, U8, stream_size);
+          stream_ptr->size = stream_size;
+          stream_states[i] = MSF_StreamState_Pending;
+        }
+        stream_blocks[i] = blocks;
+        
         // advance cursors
         entry_cursor += size_of_stream_entry;
         index_cursor = sub_index_cursor;
@@ -260,7 +266,10 @@ msf_parsed_from_data(Arena *arena, String8 msf_data){
     
     if (got_streams){
       result = push_array(arena, MSF_Parsed, 1);
+      result->data = msf_data;
       result->streams = streams;
+      result->stream_blocks = stream_blocks;
+      result->stream_states = stream_states;
       result->stream_count = stream_count;
       result->block_size = block_size;
       result->block_count = whole_file_block_count;
@@ -278,7 +287,196 @@ static String8
 msf_data_from_stream(MSF_Parsed *msf, MSF_StreamNumber sn){
   String8 result = {0};
   if (sn < msf->stream_count){
+    // the first caller reassembles the stream; concurrent callers wait for it
+    U32 *state = &msf->stream_states[sn];
+    if (ins_atomic_u32_eval(state) != MSF_StreamState_Ready){
+      U32 prev_state = ins_atomic_u32_eval_cond_assign(state, MSF_StreamState_Assembling,
+                                                       MSF_StreamState_Pending);
+      if (prev_state == MSF_StreamState_Pending){
+        msf__stream_assemble(msf, sn);
+        ins_atomic_u32_eval_assign(state, MSF_StreamState_Ready);
+      }
+      else{
+        // streams can be huge; after a short spin, sleep between checks
+        // rather than burn a core for the whole assembly
+        for (U64 spin_count = 0; ins_atomic_u32_eval(state) != MSF_StreamState_Ready; spin_count += 1){
+          if (spin_count < 256){
+            ins_pause();
+          }
+          else{
+            os_sleep_milliseconds(1);
+          }
+        }
+      }
+    }
     result = msf->streams[sn];
   }
   return(result);
 }
+
+static void
+msf__stream_assemble(MSF_Parsed *msf, MSF_StreamNumber sn){
+  ProfBeginFunction();
+  
+  String8 stream = msf->streams[sn];
+  U32 *blocks = msf->stream_blocks[sn];
+  U64 block_size = msf->block_size;
+  U64 block_count = CeilIntegerDiv(stream.size, block_size);
+  
+  U8 *out_ptr = stream.str;
+  U8 *out_opl = stream.str + stream.size;
+  for (U64 i = 0; i < block_count; i += 1){
+    U64 block_off = (U64)(blocks[i])*block_size;
+    
+    // clamp copy size by end of stream & end of file
+    U64 copy_size = ClampTop(block_size, (U64)(out_opl - out_ptr));
+    U64 avail_size = (block_off < msf->data.size)?(msf->data.size - block_off):0;
+    U64 read_size = ClampTop(copy_size, avail_size);
+    
+    MemoryCopy(out_ptr, msf->data.str + block_off, read_size);
+    MemoryZero(out_ptr + read_size, copy_size - read_size);
+    out_ptr += copy_size;
+  }
+  
+  ProfEnd();
+}
+
+////////////////////////////////
+//~ MSF Peek Functions
+
+static String8
+msf_stream_first_block_from_data(String8 msf_data, MSF_StreamNumber sn){
+  String8 result = {0};
+  
+  //- determine msf type & read header
+  MSF_DirectoryPeek peek = {0};
+  peek.data = msf_data;
+  if (msf_data.size >= MSF_MIN_SIZE){
+    if (str8_match(msf_data, str8_lit(msf_msf20_magic),
+                   StringMatchFlag_RightSideSloppy)){
+      MSF_Header20 *header = (MSF_Header20*)(msf_data.str + MSF_MSF20_MAGIC_SIZE);
+      peek.index_size = 2;
+      peek.block_size = header->block_size;
+      peek.block_count = header->block_count;
+      peek.directory_size = header->directory_size;
+      peek.map_skip_size = MSF_MSF20_MAGIC_SIZE + OffsetOf(MSF_Header20, directory_map);
+    }
+    else if (str8_match(msf_data, str8_lit(msf_msf70_magic),
+                        StringMatchFlag_RightSideSloppy)){
+      MSF_Header70 *header = (MSF_Header70*)(msf_data.str + MSF_MSF70_MAGIC_SIZE);
+      peek.index_size = 4;
+      peek.block_size = header->block_size;
+      peek.block_count = header->block_count;
+      peek.directory_size = header->directory_size;
+      peek.super_map_off = MSF_MSF70_MAGIC_SIZE + OffsetOf(MSF_Header70, directory_super_map);
+    }
+  }
+  if (peek.index_size == 0 || peek.block_size <= peek.map_skip_size ||
+      peek.block_size%4 != 0){
+    peek.bad = 1;
+  }
+  
+  //- find the stream's size & its first entry in the index list
+  U32 stream_size = 0;
+  U64 index_off = 0;
+  if (!peek.bad){
+    U32 stream_count = msf__directory_peek(&peek, 0, 4);
+    U32 size_of_stream_entry = (peek.index_size == 2)?8:4;
+    if (sn < stream_count){
+      index_off = 4 + (U64)stream_count*size_of_stream_entry;
+      for (U32 i = 0; i <= sn && !peek.bad; i += 1){
+        U32 size = msf__directory_peek(&peek, 4 + (U64)i*size_of_stream_entry, 4);
+        if (size == 0xffffffff){
+          size = 0;
+        }
+        if (i < sn){
+          index_off += CeilIntegerDiv(size, peek.block_size)*peek.index_size;
+        }
+        else{
+          stream_size = size;
+        }
+      }
+    }
+  }
+  
+  //- read the first block
+  if (!peek.bad && stream_size > 0){
+    U32 block_index = msf__directory_peek(&peek, index_off, peek.index_size);
+    U64 block_off = (U64)block_index*peek.block_size;
+    if (!peek.bad && block_index < peek.block_count && block_off < msf_data.size){
+      U64 size = Min(peek.block_size, stream_size);
+      size = ClampTop(size, msf_data.size - block_off);
+      result = str8(msf_data.str + block_off, size);
+    }
+  }
+  
+  return(result);
+}
+
+static U32
+msf__directory_peek(MSF_DirectoryPeek *peek, U64 directory_off, U32 size){
+  U32 result = 0;
+  
+  // NOTE: reads are of 2 or 4 byte entries at aligned offsets, and block
+  //  sizes are multiples of 4, so a read never straddles two blocks.
+  if (directory_off + size > peek->directory_size){
+    peek->bad = 1;
+  }
+  
+  // directory block -> its slot in the directory map
+  U64 map_block_index = 0;
+  U64 map_slot = 0;
+  if (!peek->bad){
+    U64 directory_block = directory_off/peek->block_size;
+    U64 slots_per_map_block = (peek->block_size - peek->map_skip_size)/peek->index_size;
+    U64 super_map_slot = directory_block/slots_per_map_block;
+    map_slot = directory_block%slots_per_map_block;
+    if (peek->index_size == 4){
+      U64 super_off = peek->super_map_off + super_map_slot*4;
+      if (super_off + 4 <= peek->data.size){
+        map_block_index = *(U32*)(peek->data.str + super_off);
+      }
+      else{
+        peek->bad = 1;
+      }
+    }
+    else if (super_map_slot != 0){
+      peek->bad = 1;
+    }
+  }
+  
+  // directory map -> directory block
+  U64 directory_block_index = 0;
+  if (!peek->bad){
+    U64 map_off = map_block_index*peek->block_size + peek->map_skip_size + map_slot*peek->index_size;
+    if (map_block_index < peek->block_count && map_off + peek->index_size <= peek->data.size){
+      if (peek->index_size == 4){
+        directory_block_index = *(U32*)(peek->data.str + map_off);
+      }
+      else{
+        directory_block_index = *(U16*)(peek->data.str + map_off);
+      }
+    }
+    else{
+      peek->bad = 1;
+    }
+  }
+  
+  // directory block -> value
+  if (!peek->bad){
+    U64 off = directory_block_index*peek->block_size + directory_off%peek->block_size;
+    if (directory_block_index < peek->block_count && off + size <= peek->data.size){
+      if (size == 4){
+        result = *(U32*)(peek->data.str + off);
+      }
+      else{
+        result = *(U16*)(peek->data.str + off);
+      }
+    }
+    else{
+      peek->bad = 1;
+    }
+  }
+  
+  return(result);
+}
@@ -43,8 +43,20 @@ typedef struct MSF_Header70{
 ////////////////////////////////
 //~ MSF Parser Helper Types
 
+typedef enum MSF_StreamState{
+  MSF_StreamState_Pending,
+  MSF_StreamState_Assembling,
+  MSF_StreamState_Ready,
+} MSF_StreamState;
+
 typedef struct MSF_Parsed{
+  // streams whose blocks are contiguous in the file are views into this
+  //  data; the rest are reassembled on first access
+  String8 data;
+  
   String8 *streams;
+  U32 **stream_blocks;
+  U32 *stream_states; // (MSF_StreamState) - atomic
   U64 stream_count;
   
   U64 block_size;
@@ -57,4 +69,27 @@ typedef struct MSF_Parsed{
 static MSF_Parsed* msf_parsed_from_data(Arena *arena, String8 msf_data);
 static String8     msf_data_from_stream(MSF_Parsed *msf, MSF_StreamNumber sn);
 
+static void        msf__stream_assemble(MSF_Parsed *msf, MSF_StreamNumber sn);
+
+////////////////////////////////
+//~ MSF Peek Functions
+
+// NOTE: these read straight out of the file data, walking only as much of
+//  the stream directory as they need. for cheap looks at small headers
+//  (e.g. a PDB's identity) without parsing a whole, possibly huge, file.
+
+typedef struct MSF_DirectoryPeek{
+  String8 data;
+  U32 index_size;
+  U64 block_size;
+  U64 block_count;
+  U64 directory_size;
+  U64 map_skip_size;
+  U64 super_map_off;
+  B32 bad;
+} MSF_DirectoryPeek;
+
+static String8     msf_stream_first_block_from_data(String8 msf_data, MSF_StreamNumber sn);
+static U32         msf__directory_peek(MSF_DirectoryPeek *peek, U64 directory_off, U32 size);
+
 #endif //RADDBG_MSF_H
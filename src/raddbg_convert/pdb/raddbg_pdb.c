@@ -226,6 +226,7 @@ pdb_dbi_from_data(Arena *arena, String8 data){
     result = push_array(arena, PDB_DbiParsed, 1);
     result->data = data;
     result->arch = header->machine;
+    result->age = header->age;
     result->gsi_sn = header->gsi_sn;
     result->psi_sn = header->psi_sn;
     result->sym_sn = header->sym_sn;
@@ -308,6 +308,7 @@ typedef struct PDB_Strtbl{
 typedef struct PDB_DbiParsed{
   String8 data;
   COFF_Arch arch;
+  U32 age;
   MSF_StreamNumber gsi_sn;
   MSF_StreamNumber psi_sn;
   MSF_StreamNumber sym_sn;
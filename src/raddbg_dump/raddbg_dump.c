@@ -412,6 +412,11 @@ main(int argc, char **argv){
           }
         }
         
+        if (name_map.sorted_nodes != 0){
+          str8_list_pushf(arena, &dump, "  index: sorted_nodes=%llu suffixes=%llu\n",
+                          name_map.sorted_node_count, name_map.suffix_count);
+        }
+        
         str8_list_push(arena, &dump, str8_lit("\n"));
       }
       str8_list_push(arena, &dump, str8_lit("\n"));
@@ -40,6 +40,68 @@ raddbg_addr_size_from_arch(RADDBG_Arch arch){
   return(result);
 }
 
+//- name index helpers
+
+RADDBG_PROC RADDBG_S32
+raddbg_name_index_compare(RADDBG_U8 *a, RADDBG_U64 alen, RADDBG_U8 *b, RADDBG_U64 blen){
+  RADDBG_S32 result = 0;
+  RADDBG_S32 raw_result = 0;
+  RADDBG_U64 len = (alen < blen)?alen:blen;
+  for (RADDBG_U64 i = 0; i < len; i += 1){
+    RADDBG_U8 ac = a[i];
+    RADDBG_U8 bc = b[i];
+    if (raw_result == 0 && ac != bc){
+      raw_result = (ac < bc)?-1:1;
+    }
+    if ('A' <= ac && ac <= 'Z'){ ac += 'a' - 'A'; }
+    if ('A' <= bc && bc <= 'Z'){ bc += 'a' - 'A'; }
+    if (ac != bc){
+      result = (ac < bc)?-1:1;
+      break;
+    }
+  }
+  if (result == 0 && alen != blen){
+    result = (alen < blen)?-1:1;
+  }
+  if (result == 0){
+    result = raw_result;
+  }
+  return(result);
+}
+
+RADDBG_PROC RADDBG_S32
+raddbg_name_index_is_word_start(RADDBG_U8 *str, RADDBG_U64 len, RADDBG_U64 off){
+  RADDBG_S32 result = 0;
+  if (off == 0){
+    result = (len > 0);
+  }
+  else if (off < len){
+    RADDBG_U8 prev = str[off - 1];
+    RADDBG_U8 cur = str[off];
+    RADDBG_S32 prev_lower = ('a' <= prev && prev <= 'z');
+    RADDBG_S32 prev_alnum = (prev_lower || ('A' <= prev && prev <= 'Z') ||
+                             ('0' <= prev && prev <= '9'));
+    RADDBG_S32 cur_upper = ('A' <= cur && cur <= 'Z');
+    RADDBG_S32 cur_alnum = (cur_upper || ('a' <= cur && cur <= 'z') ||
+                            ('0' <= cur && cur <= '9'));
+    
+    // "foo::Bar", "foo_bar", "fooBar"
+    result = ((!prev_alnum && cur_alnum) || (prev_lower && cur_upper));
+  }
+  return(result);
+}
+
+RADDBG_PROC RADDBG_U32
+raddbg_name_index_trigram(RADDBG_U8 *str){
+  RADDBG_U32 result = 0;
+  for (RADDBG_U32 i = 0; i < 3; i += 1){
+    RADDBG_U8 c = str[i];
+    if ('A' <= c && c <= 'Z'){ c += 'a' - 'A'; }
+    result = (result << 8) | c;
+  }
+  return(result);
+}
+
 //- eval helpers
 
 RADDBG_PROC RADDBG_EvalConversionKind
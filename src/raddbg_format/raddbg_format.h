@@ -217,7 +217,7 @@ typedef enum RADDBG_RegisterCode_X64_Enum{
 
 // "raddbg\0\0"
 #define RADDBG_MAGIC_CONSTANT   0x0000676264646172
-#define RADDBG_ENCODING_VERSION 1
+#define RADDBG_ENCODING_VERSION 2
 
 #define RADDBG_LanguageXList(X) \
 X(NULL,      0) \
@@ -239,6 +239,12 @@ typedef struct RADDBG_Header{
   // data sections
   RADDBG_U32 data_section_off;
   RADDBG_U32 data_section_count;
+  
+  // identity of the debug info this was converted from (PDB GUID & age);
+  // lets a consumer check freshness without comparing file times. all zero
+  // when the source has no identity.
+  RADDBG_U32 dbg_age;
+  RADDBG_U8 dbg_guid[16];
 } RADDBG_Header;
 
 
@@ -272,6 +278,8 @@ X(Locals,              0x0015)\
 X(LocationBlocks,      0x0016)\
 X(LocationData,        0x0017)\
 X(NameMaps,            0x0018)\
+X(NameMapIndexes,      0x0019)\
+X(NameMapTrigramIndexes, 0x001A)\
 Y(PRIMARY_COUNT)\
 X(SKIP,                RADDBG_DataSectionTag_SECONDARY|0x0000)\
 X(LineInfoVoffs,       RADDBG_DataSectionTag_SECONDARY|0x0001)\
@@ -281,7 +289,11 @@ X(LineMapNumbers,      RADDBG_DataSectionTag_SECONDARY|0x0004)\
 X(LineMapRanges,       RADDBG_DataSectionTag_SECONDARY|0x0005)\
 X(LineMapVoffs,        RADDBG_DataSectionTag_SECONDARY|0x0006)\
 X(NameMapBuckets,      RADDBG_DataSectionTag_SECONDARY|0x0007)\
-X(NameMapNodes,        RADDBG_DataSectionTag_SECONDARY|0x0008)
+X(NameMapNodes,        RADDBG_DataSectionTag_SECONDARY|0x0008)\
+X(NameMapSortedNodes,  RADDBG_DataSectionTag_SECONDARY|0x0009)\
+X(NameMapSuffixes,     RADDBG_DataSectionTag_SECONDARY|0x000A)\
+X(NameMapTrigrams,     RADDBG_DataSectionTag_SECONDARY|0x000B)\
+X(NameMapTrigramPostings, RADDBG_DataSectionTag_SECONDARY|0x000C)
 
 typedef RADDBG_U32 RADDBG_DataSectionTag;
 typedef enum RADDBG_DataSectionTagEnum{
@@ -751,6 +763,49 @@ typedef struct RADDBG_NameMapNode{
   RADDBG_U32 match_idx_or_idx_run_first;
 } RADDBG_NameMapNode;
 
+// NOTE: name map indexes are optional companions to name maps, for answering
+// prefix & substring queries without touching every node. names are ordered
+// by raddbg_name_index_compare (ASCII case folded, ties broken by raw bytes).
+//
+// * sorted nodes: every node index of the map, in name order; the nodes
+//   whose names start with a given prefix form one contiguous run
+// * suffixes: one entry per word start in every name (see
+//   raddbg_name_index_is_word_start), in order of the name's tail from that
+//   word start; the word-aligned substrings matching a needle form one
+//   contiguous run
+
+typedef struct RADDBG_NameMapIndex{
+  RADDBG_NameMapKind kind;
+  RADDBG_U32 sorted_nodes_data_idx;
+  RADDBG_U32 suffixes_data_idx;
+} RADDBG_NameMapIndex;
+
+typedef struct RADDBG_NameMapSuffix{
+  RADDBG_U32 node_idx;
+  RADDBG_U32 off;
+} RADDBG_NameMapSuffix;
+
+// NOTE: trigram indexes are optional companions to the symbol & type name
+// maps, for fuzzy search. a trigram is three consecutive bytes of a name,
+// ASCII case folded, packed by raddbg_name_index_trigram.
+//
+// * trigrams: every trigram occurring in the map's names, sorted by value
+// * postings: for each trigram, the node indexes of the names containing it,
+//   sorted & unique; trigrams[i] owns the run
+//   [posting_first, posting_first + posting_count)
+
+typedef struct RADDBG_NameMapTrigramIndex{
+  RADDBG_NameMapKind kind;
+  RADDBG_U32 trigrams_data_idx;
+  RADDBG_U32 postings_data_idx;
+} RADDBG_NameMapTrigramIndex;
+
+typedef struct RADDBG_NameMapTrigram{
+  RADDBG_U32 trigram;
+  RADDBG_U32 posting_first;
+  RADDBG_U32 posting_count;
+} RADDBG_NameMapTrigram;
+
 
 ////////////////////////////////
 // Eval Bytecode
@@ -910,6 +965,16 @@ RADDBG_PROC RADDBG_U64 raddbg_hash(RADDBG_U8 *ptr, RADDBG_U64 size);
 RADDBG_PROC RADDBG_U32 raddbg_size_from_basic_type_kind(RADDBG_TypeKind kind);
 RADDBG_PROC RADDBG_U32 raddbg_addr_size_from_arch(RADDBG_Arch arch);
 
+//- name index helpers
+RADDBG_PROC RADDBG_S32
+raddbg_name_index_compare(RADDBG_U8 *a, RADDBG_U64 alen, RADDBG_U8 *b, RADDBG_U64 blen);
+
+RADDBG_PROC RADDBG_S32
+raddbg_name_index_is_word_start(RADDBG_U8 *str, RADDBG_U64 len, RADDBG_U64 off);
+
+RADDBG_PROC RADDBG_U32
+raddbg_name_index_trigram(RADDBG_U8 *str);
+
 //- eval helpers
 RADDBG_PROC RADDBG_EvalConversionKind
 raddbg_eval_conversion_rule(RADDBG_EvalTypeGroup in, RADDBG_EvalTypeGroup out);
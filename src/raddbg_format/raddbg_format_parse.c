@@ -20,7 +20,7 @@ raddbg_parse(RADDBG_U8 *data, RADDBG_U64 size, RADDBG_Parsed *out){
       hdr = 0;
       result = RADDBG_ParseStatus_HeaderDoesNotMatch;
     }
-    if (hdr != 0 && hdr->encoding_version != 1){
+    if (hdr != 0 && hdr->encoding_version != RADDBG_ENCODING_VERSION){
       hdr = 0;
       result = RADDBG_ParseStatus_UnsupportedVersionNumber;
     }
@@ -194,6 +194,35 @@ raddbg_parse(RADDBG_U8 *data, RADDBG_U64 size, RADDBG_Parsed *out){
       }
     }
     
+    {
+      raddbg_parse__extract_primary(out, out->name_map_indexes, &out->name_map_index_count,
+                                    RADDBG_DataSectionTag_NameMapIndexes);
+      
+      RADDBG_NameMapIndex *index_ptr = out->name_map_indexes;
+      RADDBG_NameMapIndex *index_opl = out->name_map_indexes + out->name_map_index_count;
+      for (; index_ptr < index_opl; index_ptr += 1){
+        if (index_ptr->kind < RADDBG_NameMapKind_COUNT &&
+            out->name_map_indexes_by_kind[index_ptr->kind] == 0){
+          out->name_map_indexes_by_kind[index_ptr->kind] = index_ptr;
+        }
+      }
+    }
+    
+    {
+      raddbg_parse__extract_primary(out, out->name_map_trigram_indexes,
+                                    &out->name_map_trigram_index_count,
+                                    RADDBG_DataSectionTag_NameMapTrigramIndexes);
+      
+      RADDBG_NameMapTrigramIndex *index_ptr = out->name_map_trigram_indexes;
+      RADDBG_NameMapTrigramIndex *index_opl = index_ptr + out->name_map_trigram_index_count;
+      for (; index_ptr < index_opl; index_ptr += 1){
+        if (index_ptr->kind < RADDBG_NameMapKind_COUNT &&
+            out->name_map_trigram_indexes_by_kind[index_ptr->kind] == 0){
+          out->name_map_trigram_indexes_by_kind[index_ptr->kind] = index_ptr;
+        }
+      }
+    }
+    
   }
   
   return(result);
@@ -423,6 +452,14 @@ RADDBG_PROC void
 raddbg_name_map_parse(RADDBG_Parsed *p, RADDBG_NameMap *mapptr, RADDBG_ParsedNameMap *out){
   out->buckets = 0;
   out->bucket_count = 0;
+  out->sorted_nodes = 0;
+  out->sorted_node_count = 0;
+  out->suffixes = 0;
+  out->suffix_count = 0;
+  out->trigrams = 0;
+  out->trigram_count = 0;
+  out->trigram_postings = 0;
+  out->trigram_posting_count = 0;
   if (mapptr != 0){
     out->buckets = (RADDBG_NameMapBucket*)
       raddbg_data_from_dsec(p, mapptr->bucket_data_idx, sizeof(RADDBG_NameMapBucket),
@@ -430,6 +467,33 @@ raddbg_name_map_parse(RADDBG_Parsed *p, RADDBG_NameMap *mapptr, RADDBG_ParsedNam
     out->nodes = (RADDBG_NameMapNode*)
       raddbg_data_from_dsec(p, mapptr->node_data_idx, sizeof(RADDBG_NameMapNode),
                             RADDBG_DataSectionTag_NameMapNodes, &out->node_count);
+    
+    RADDBG_NameMapIndex *index = 0;
+    if (mapptr->kind < RADDBG_NameMapKind_COUNT){
+      index = p->name_map_indexes_by_kind[mapptr->kind];
+    }
+    if (index != 0){
+      out->sorted_nodes = (RADDBG_U32*)
+        raddbg_data_from_dsec(p, index->sorted_nodes_data_idx, sizeof(RADDBG_U32),
+                              RADDBG_DataSectionTag_NameMapSortedNodes, &out->sorted_node_count);
+      out->suffixes = (RADDBG_NameMapSuffix*)
+        raddbg_data_from_dsec(p, index->suffixes_data_idx, sizeof(RADDBG_NameMapSuffix),
+                              RADDBG_DataSectionTag_NameMapSuffixes, &out->suffix_count);
+    }
+    
+    RADDBG_NameMapTrigramIndex *trigram_index = 0;
+    if (mapptr->kind < RADDBG_NameMapKind_COUNT){
+      trigram_index = p->name_map_trigram_indexes_by_kind[mapptr->kind];
+    }
+    if (trigram_index != 0){
+      out->trigrams = (RADDBG_NameMapTrigram*)
+        raddbg_data_from_dsec(p, trigram_index->trigrams_data_idx, sizeof(RADDBG_NameMapTrigram),
+                              RADDBG_DataSectionTag_NameMapTrigrams, &out->trigram_count);
+      out->trigram_postings = (RADDBG_U32*)
+        raddbg_data_from_dsec(p, trigram_index->postings_data_idx, sizeof(RADDBG_U32),
+                              RADDBG_DataSectionTag_NameMapTrigramPostings,
+                              &out->trigram_posting_count);
+    }
   }
 }
 
@@ -490,6 +554,216 @@ raddbg_matches_from_map_node(RADDBG_Parsed *p, RADDBG_NameMapNode *node,
   return(result);
 }
 
+RADDBG_PROC RADDBG_U32*
+raddbg_name_map_prefix_lookup(RADDBG_Parsed *p, RADDBG_ParsedNameMap *map,
+                              RADDBG_U8 *str, RADDBG_U64 len, RADDBG_U64 *n_out){
+  RADDBG_U32 *sorted = map->sorted_nodes;
+  RADDBG_U64 count = map->sorted_node_count;
+  
+  // find first name that is not before the prefix
+  RADDBG_U64 first = 0;
+  {
+    RADDBG_U64 opl = count;
+    for (;first < opl;){
+      RADDBG_U64 mid = (first + opl)/2;
+      RADDBG_U64 nlen = 0;
+      RADDBG_U8 *nstr = raddbg_name_map__string_from_node_idx(p, map, sorted[mid], &nlen);
+      if (raddbg_name_map__prefix_compare(nstr, nlen, str, len) < 0){
+        first = mid + 1;
+      }
+      else{
+        opl = mid;
+      }
+    }
+  }
+  
+  // find first name that is after the prefix
+  RADDBG_U64 opl = count;
+  {
+    RADDBG_U64 lo = first;
+    for (;lo < opl;){
+      RADDBG_U64 mid = (lo + opl)/2;
+      RADDBG_U64 nlen = 0;
+      RADDBG_U8 *nstr = raddbg_name_map__string_from_node_idx(p, map, sorted[mid], &nlen);
+      if (raddbg_name_map__prefix_compare(nstr, nlen, str, len) <= 0){
+        lo = mid + 1;
+      }
+      else{
+        opl = mid;
+      }
+    }
+  }
+  
+  RADDBG_U32 *result = 0;
+  *n_out = opl - first;
+  if (first < opl){
+    result = sorted + first;
+  }
+  return(result);
+}
+
+RADDBG_PROC RADDBG_NameMapSuffix*
+raddbg_name_map_substring_lookup(RADDBG_Parsed *p, RADDBG_ParsedNameMap *map,
+                                 RADDBG_U8 *str, RADDBG_U64 len, RADDBG_U64 *n_out){
+  RADDBG_NameMapSuffix *suffixes = map->suffixes;
+  RADDBG_U64 count = map->suffix_count;
+  
+  // find first suffix that is not before the needle
+  RADDBG_U64 first = 0;
+  {
+    RADDBG_U64 opl = count;
+    for (;first < opl;){
+      RADDBG_U64 mid = (first + opl)/2;
+      RADDBG_U64 nlen = 0;
+      RADDBG_U8 *nstr = raddbg_name_map__string_from_node_idx(p, map, suffixes[mid].node_idx, &nlen);
+      RADDBG_U64 off = raddbg_parse__min(suffixes[mid].off, nlen);
+      if (raddbg_name_map__prefix_compare(nstr + off, nlen - off, str, len) < 0){
+        first = mid + 1;
+      }
+      else{
+        opl = mid;
+      }
+    }
+  }
+  
+  // find first suffix that is after the needle
+  RADDBG_U64 opl = count;
+  {
+    RADDBG_U64 lo = first;
+    for (;lo < opl;){
+      RADDBG_U64 mid = (lo + opl)/2;
+      RADDBG_U64 nlen = 0;
+      RADDBG_U8 *nstr = raddbg_name_map__string_from_node_idx(p, map, suffixes[mid].node_idx, &nlen);
+      RADDBG_U64 off = raddbg_parse__min(suffixes[mid].off, nlen);
+      if (raddbg_name_map__prefix_compare(nstr + off, nlen - off, str, len) <= 0){
+        lo = mid + 1;
+      }
+      else{
+        opl = mid;
+      }
+    }
+  }
+  
+  RADDBG_NameMapSuffix *result = 0;
+  *n_out = opl - first;
+  if (first < opl){
+    result = suffixes + first;
+  }
+  return(result);
+}
+
+RADDBG_PROC RADDBG_U64
+raddbg_name_map_fuzzy_lookup(RADDBG_Parsed *p, RADDBG_ParsedNameMap *map,
+                             RADDBG_U8 *query, RADDBG_U64 query_len,
+                             RADDBG_NameMapFuzzyMatch *out, RADDBG_U64 out_cap){
+  RADDBG_U64 out_count = 0;
+  
+  // gather the query's unique trigrams, with their posting lists
+  RADDBG_U32 *lists[RADDBG_NAME_MAP_FUZZY_MAX_TRIGRAMS];
+  RADDBG_U64 list_counts[RADDBG_NAME_MAP_FUZZY_MAX_TRIGRAMS];
+  RADDBG_U32 trigrams[RADDBG_NAME_MAP_FUZZY_MAX_TRIGRAMS];
+  RADDBG_U32 trigram_count = 0;
+  {
+    RADDBG_U64 word_first = 0;
+    for (RADDBG_U64 i = 0; i <= query_len; i += 1){
+      if (i == query_len || query[i] == ' '){
+        for (RADDBG_U64 j = word_first; j + 3 <= i; j += 1){
+          if (trigram_count == RADDBG_NAME_MAP_FUZZY_MAX_TRIGRAMS){
+            break;
+          }
+          RADDBG_U32 trigram = raddbg_name_index_trigram(query + j);
+          RADDBG_S32 is_dup = 0;
+          for (RADDBG_U32 k = 0; k < trigram_count; k += 1){
+            if (trigrams[k] == trigram){
+              is_dup = 1;
+              break;
+            }
+          }
+          if (!is_dup){
+            RADDBG_U32 *list = 0;
+            RADDBG_U64 list_count = 0;
+            RADDBG_NameMapTrigram *entry = raddbg_name_map__trigram_lookup(map, trigram);
+            if (entry != 0){
+              RADDBG_U64 first = raddbg_parse__min(entry->posting_first, map->trigram_posting_count);
+              RADDBG_U64 opl = raddbg_parse__min(first + entry->posting_count, map->trigram_posting_count);
+              list = map->trigram_postings + first;
+              list_count = opl - first;
+            }
+            trigrams[trigram_count] = trigram;
+            lists[trigram_count] = list;
+            list_counts[trigram_count] = list_count;
+            trigram_count += 1;
+          }
+        }
+        word_first = i + 1;
+      }
+    }
+  }
+  
+  // rarest trigrams first
+  for (RADDBG_U32 i = 1; i < trigram_count; i += 1){
+    for (RADDBG_U32 j = i; j > 0 && list_counts[j - 1] > list_counts[j]; j -= 1){
+      RADDBG_U32 *list = lists[j]; lists[j] = lists[j - 1]; lists[j - 1] = list;
+      RADDBG_U64 count = list_counts[j]; list_counts[j] = list_counts[j - 1]; list_counts[j - 1] = count;
+    }
+  }
+  
+  // NOTE: a name matching at least min_score of the trigrams must appear in
+  // at least one of any (trigram_count - min_score + 1) lists, so only the
+  // rarest lists are walked to find candidates.
+  if (trigram_count > 0 && out_cap > 0){
+    RADDBG_U32 min_score = trigram_count - trigram_count/4;
+    RADDBG_U32 seed_list_count = trigram_count - min_score + 1;
+    for (RADDBG_U32 seed_idx = 0; seed_idx < seed_list_count; seed_idx += 1){
+      RADDBG_U32 *seed_list = lists[seed_idx];
+      RADDBG_U64 seed_count = list_counts[seed_idx];
+      for (RADDBG_U64 i = 0; i < seed_count; i += 1){
+        RADDBG_U32 node_idx = seed_list[i];
+        
+        // skip candidates already visited from an earlier seed list
+        RADDBG_S32 visited = 0;
+        for (RADDBG_U32 k = 0; k < seed_idx; k += 1){
+          if (raddbg_name_map__posting_contains(lists[k], list_counts[k], node_idx)){
+            visited = 1;
+            break;
+          }
+        }
+        if (visited){
+          continue;
+        }
+        
+        // score
+        RADDBG_U32 score = 1;
+        for (RADDBG_U32 k = seed_idx + 1; k < trigram_count; k += 1){
+          score += raddbg_name_map__posting_contains(lists[k], list_counts[k], node_idx);
+        }
+        if (score < min_score){
+          continue;
+        }
+        
+        // insert into ranked output
+        RADDBG_NameMapFuzzyMatch match = {node_idx, score};
+        RADDBG_U64 pos = out_count;
+        if (out_count < out_cap){
+          out_count += 1;
+        }
+        else if (raddbg_name_map__fuzzy_match_is_better(p, map, &match, &out[out_count - 1])){
+          pos = out_count - 1;
+        }
+        else{
+          continue;
+        }
+        for (;pos > 0 && raddbg_name_map__fuzzy_match_is_better(p, map, &match, &out[pos - 1]); pos -= 1){
+          out[pos] = out[pos - 1];
+        }
+        out[pos] = match;
+      }
+    }
+  }
+  
+  return(out_count);
+}
+
 //- common helpers
 
 RADDBG_PROC RADDBG_U64
@@ -535,3 +809,102 @@ raddbg_data_from_dsec(RADDBG_Parsed *parsed, RADDBG_U32 idx, RADDBG_U32 item_siz
   *count_out = count_result;
   return(result);
 }
+
+RADDBG_PROC RADDBG_U8*
+raddbg_name_map__string_from_node_idx(RADDBG_Parsed *p, RADDBG_ParsedNameMap *map,
+                                      RADDBG_U32 node_idx, RADDBG_U64 *len_out){
+  RADDBG_U8 *result = 0;
+  *len_out = 0;
+  if (node_idx < map->node_count){
+    result = raddbg_string_from_idx(p, map->nodes[node_idx].string_idx, len_out);
+  }
+  return(result);
+}
+
+RADDBG_PROC RADDBG_S32
+raddbg_name_map__prefix_compare(RADDBG_U8 *name, RADDBG_U64 name_len,
+                                RADDBG_U8 *prefix, RADDBG_U64 prefix_len){
+  // NOTE: zero when prefix is a (case folded) prefix of name, otherwise the
+  // order of name relative to all names with that prefix
+  RADDBG_S32 result = 0;
+  RADDBG_U64 len = raddbg_parse__min(name_len, prefix_len);
+  for (RADDBG_U64 i = 0; i < len; i += 1){
+    RADDBG_U8 a = name[i];
+    RADDBG_U8 b = prefix[i];
+    if ('A' <= a && a <= 'Z'){ a += 'a' - 'A'; }
+    if ('A' <= b && b <= 'Z'){ b += 'a' - 'A'; }
+    if (a != b){
+      result = (a < b)?-1:1;
+      break;
+    }
+  }
+  if (result == 0 && name_len < prefix_len){
+    result = -1;
+  }
+  return(result);
+}
+
+RADDBG_PROC RADDBG_NameMapTrigram*
+raddbg_name_map__trigram_lookup(RADDBG_ParsedNameMap *map, RADDBG_U32 trigram){
+  RADDBG_NameMapTrigram *result = 0;
+  RADDBG_U64 first = 0;
+  RADDBG_U64 opl = map->trigram_count;
+  for (;first < opl;){
+    RADDBG_U64 mid = (first + opl)/2;
+    RADDBG_U32 mid_trigram = map->trigrams[mid].trigram;
+    if (mid_trigram < trigram){
+      first = mid + 1;
+    }
+    else if (mid_trigram > trigram){
+      opl = mid;
+    }
+    else{
+      result = map->trigrams + mid;
+      break;
+    }
+  }
+  return(result);
+}
+
+RADDBG_PROC RADDBG_S32
+raddbg_name_map__posting_contains(RADDBG_U32 *postings, RADDBG_U64 count, RADDBG_U32 node_idx){
+  RADDBG_S32 result = 0;
+  RADDBG_U64 first = 0;
+  RADDBG_U64 opl = count;
+  for (;first < opl;){
+    RADDBG_U64 mid = (first + opl)/2;
+    if (postings[mid] < node_idx){
+      first = mid + 1;
+    }
+    else if (postings[mid] > node_idx){
+      opl = mid;
+    }
+    else{
+      result = 1;
+      break;
+    }
+  }
+  return(result);
+}
+
+RADDBG_PROC RADDBG_S32
+raddbg_name_map__fuzzy_match_is_better(RADDBG_Parsed *p, RADDBG_ParsedNameMap *map,
+                                       RADDBG_NameMapFuzzyMatch *a, RADDBG_NameMapFuzzyMatch *b){
+  RADDBG_S32 result = 0;
+  if (a->score != b->score){
+    result = (a->score > b->score);
+  }
+  else{
+    RADDBG_U64 a_len = 0;
+    RADDBG_U64 b_len = 0;
+    raddbg_name_map__string_from_node_idx(p, map, a->node_idx, &a_len);
+    raddbg_name_map__string_from_node_idx(p, map, b->node_idx, &b_len);
+    if (a_len != b_len){
+      result = (a_len < b_len);
+    }
+    else{
+      result = (a->node_idx < b->node_idx);
+    }
+  }
+  return(result);
+}
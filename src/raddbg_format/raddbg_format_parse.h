@@ -69,10 +69,16 @@ typedef struct RADDBG_Parsed{
   RADDBG_U64             location_data_size;
   RADDBG_NameMap*        name_maps;
   RADDBG_U64             name_map_count;
+  RADDBG_NameMapIndex*   name_map_indexes;
+  RADDBG_U64             name_map_index_count;
+  RADDBG_NameMapTrigramIndex* name_map_trigram_indexes;
+  RADDBG_U64                  name_map_trigram_index_count;
   
   // other helpers
   
   RADDBG_NameMap* name_maps_by_kind[RADDBG_NameMapKind_COUNT];
+  RADDBG_NameMapIndex* name_map_indexes_by_kind[RADDBG_NameMapKind_COUNT];
+  RADDBG_NameMapTrigramIndex* name_map_trigram_indexes_by_kind[RADDBG_NameMapKind_COUNT];
   
 } RADDBG_Parsed;
 
@@ -122,8 +128,28 @@ typedef struct RADDBG_ParsedNameMap{
   RADDBG_NameMapNode *nodes;
   RADDBG_U64 bucket_count;
   RADDBG_U64 node_count;
+  
+  // (empty when the map has no index)
+  RADDBG_U32 *sorted_nodes;
+  RADDBG_NameMapSuffix *suffixes;
+  RADDBG_U64 sorted_node_count;
+  RADDBG_U64 suffix_count;
+  
+  // (empty when the map has no trigram index)
+  RADDBG_NameMapTrigram *trigrams;
+  RADDBG_U32 *trigram_postings;
+  RADDBG_U64 trigram_count;
+  RADDBG_U64 trigram_posting_count;
 } RADDBG_ParsedNameMap;
 
+typedef struct RADDBG_NameMapFuzzyMatch{
+  RADDBG_U32 node_idx;
+  // number of the query's trigrams found in this node's name
+  RADDBG_U32 score;
+} RADDBG_NameMapFuzzyMatch;
+
+#define RADDBG_NAME_MAP_FUZZY_MAX_TRIGRAMS 64
+
 
 ////////////////////////////////
 //~ RADDBG Parse API
@@ -173,6 +199,32 @@ raddbg_name_map_lookup(RADDBG_Parsed *p, RADDBG_ParsedNameMap *map,
 RADDBG_PROC RADDBG_U32*
 raddbg_matches_from_map_node(RADDBG_Parsed *p, RADDBG_NameMapNode *node, RADDBG_U32 *n_out);
 
+// NOTE: these need the map's index; both match ASCII case-insensitively.
+// prefix lookup returns the run of node indexes (into map->nodes) for names
+// starting with str. substring lookup returns the run of suffix entries for
+// names containing str at a word start - a name with several such places
+// shows up once per place.
+RADDBG_PROC RADDBG_U32*
+raddbg_name_map_prefix_lookup(RADDBG_Parsed *p, RADDBG_ParsedNameMap *map,
+                              RADDBG_U8 *str, RADDBG_U64 len, RADDBG_U64 *n_out);
+
+RADDBG_PROC RADDBG_NameMapSuffix*
+raddbg_name_map_substring_lookup(RADDBG_Parsed *p, RADDBG_ParsedNameMap *map,
+                                 RADDBG_U8 *str, RADDBG_U64 len, RADDBG_U64 *n_out);
+
+// NOTE: needs the map's trigram index. the query is split into words at
+// spaces, and each word of three or more bytes contributes its trigrams (up
+// to RADDBG_NAME_MAP_FUZZY_MAX_TRIGRAMS in all). a name is a candidate when
+// it contains at least three quarters of those trigrams. the best candidates
+// are written to out, ordered by score, then by shorter name, then by node
+// index; their ids come from raddbg_matches_from_map_node. the work done
+// only depends on the posting lists of the query's rarest trigrams, not on
+// the total number of names.
+RADDBG_PROC RADDBG_U64
+raddbg_name_map_fuzzy_lookup(RADDBG_Parsed *p, RADDBG_ParsedNameMap *map,
+                             RADDBG_U8 *query, RADDBG_U64 query_len,
+                             RADDBG_NameMapFuzzyMatch *out, RADDBG_U64 out_cap);
+
 
 //- common helpers
 RADDBG_PROC RADDBG_U64
@@ -193,4 +245,22 @@ raddbg_data_from_dsec(RADDBG_Parsed *p, RADDBG_U32 idx, RADDBG_U32 item_size,
 
 #define raddbg_parse__min(a,b) (((a)<(b))?(a):(b))
 
+RADDBG_PROC RADDBG_U8*
+raddbg_name_map__string_from_node_idx(RADDBG_Parsed *p, RADDBG_ParsedNameMap *map,
+                                      RADDBG_U32 node_idx, RADDBG_U64 *len_out);
+
+RADDBG_PROC RADDBG_S32
+raddbg_name_map__prefix_compare(RADDBG_U8 *name, RADDBG_U64 name_len,
+                                RADDBG_U8 *prefix, RADDBG_U64 prefix_len);
+
+RADDBG_PROC RADDBG_NameMapTrigram*
+raddbg_name_map__trigram_lookup(RADDBG_ParsedNameMap *map, RADDBG_U32 trigram);
+
+RADDBG_PROC RADDBG_S32
+raddbg_name_map__posting_contains(RADDBG_U32 *postings, RADDBG_U64 count, RADDBG_U32 node_idx);
+
+RADDBG_PROC RADDBG_S32
+raddbg_name_map__fuzzy_match_is_better(RADDBG_Parsed *p, RADDBG_ParsedNameMap *map,
+                                       RADDBG_NameMapFuzzyMatch *a, RADDBG_NameMapFuzzyMatch *b);
+
 #endif //RADDBG_PARSE_H
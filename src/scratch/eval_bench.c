@@ -0,0 +1,247 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ eval machine microbenchmark
+//
+// Builds a per-"frame" workload of watch-expression-like & location-like
+// bytecode, then runs each frame through both eval_interpret (decode every
+// op, every time) and eval_interpret_program (pre-decoded once), checking
+// that both produce the same results.
+
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "raddbg_format/raddbg_format.h"
+#include "regs/regs.h"
+#include "regs/raddbg/regs_raddbg.h"
+#include "eval/eval_machine.h"
+
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "regs/regs.c"
+#include "regs/raddbg/regs_raddbg.c"
+#include "eval/eval_machine.c"
+
+#define BENCH_EXPRS_PER_FRAME 4096
+#define BENCH_FRAME_COUNT     256
+#define BENCH_MEMORY_BASE     0x10000
+#define BENCH_MEMORY_SIZE     KB(64)
+
+global U8 bench_memory[BENCH_MEMORY_SIZE];
+
+internal B32
+bench_memory_read(void *u, void *out, U64 addr, U64 size)
+{
+  B32 result = 0;
+  if(BENCH_MEMORY_BASE <= addr && addr + size <= BENCH_MEMORY_BASE + BENCH_MEMORY_SIZE)
+  {
+    MemoryCopy(out, bench_memory + (addr - BENCH_MEMORY_BASE), size);
+    result = 1;
+  }
+  return result;
+}
+
+//- bytecode building
+
+typedef struct BenchBytecode BenchBytecode;
+struct BenchBytecode
+{
+  U8 *str;
+  U64 size;
+  U64 cap;
+};
+
+internal void
+bench_op(BenchBytecode *bc, RADDBG_EvalOp op, U64 imm)
+{
+  U8 ctrlbits = raddbg_eval_opcode_ctrlbits[op];
+  U32 decode_size = RADDBG_DECODEN_FROM_CTRLBITS(ctrlbits);
+  if(bc->size + 1 + decode_size <= bc->cap)
+  {
+    bc->str[bc->size] = op;
+    MemoryCopy(bc->str + bc->size + 1, &imm, decode_size);
+    bc->size += 1 + decode_size;
+  }
+}
+
+internal void
+bench_local(BenchBytecode *bc, U64 off, U64 size)
+{
+  bench_op(bc, RADDBG_EvalOp_RegRead, RADDBG_EncodeRegReadParam(RADDBG_RegisterCode_X64_rsp, 8, 0));
+  bench_op(bc, RADDBG_EvalOp_ConstU16, off);
+  bench_op(bc, RADDBG_EvalOp_Add, RADDBG_EvalTypeGroup_U);
+  if(size != 0)
+  {
+    bench_op(bc, RADDBG_EvalOp_MemRead, size);
+  }
+}
+
+internal String8
+bench_bytecode_from_template(Arena *arena, U64 kind, U64 rng)
+{
+  BenchBytecode bc = {push_array(arena, U8, 256), 0, 256};
+  U64 off_a = (rng >>  0)%1024*8;
+  U64 off_b = (rng >> 16)%1024*8;
+  switch(kind)
+  {
+    default:
+    //- location of a local
+    case 0:
+    {
+      bench_local(&bc, off_a, 0);
+    }break;
+    
+    //- value of a local
+    case 1:
+    {
+      bench_local(&bc, off_a, 4);
+    }break;
+    
+    //- global member chain: g.ptr->member
+    case 2:
+    {
+      bench_op(&bc, RADDBG_EvalOp_ModuleOff, off_a);
+      bench_op(&bc, RADDBG_EvalOp_ConstU8, 8);
+      bench_op(&bc, RADDBG_EvalOp_Add, RADDBG_EvalTypeGroup_U);
+      bench_op(&bc, RADDBG_EvalOp_MemRead, 2);
+      bench_op(&bc, RADDBG_EvalOp_ConstU32, BENCH_MEMORY_BASE);
+      bench_op(&bc, RADDBG_EvalOp_Add, RADDBG_EvalTypeGroup_U);
+      bench_op(&bc, RADDBG_EvalOp_ConstU8, 16);
+      bench_op(&bc, RADDBG_EvalOp_Add, RADDBG_EvalTypeGroup_U);
+      bench_op(&bc, RADDBG_EvalOp_MemRead, 4);
+    }break;
+    
+    //- condition: a > 10 && b != 0
+    case 3:
+    {
+      bench_local(&bc, off_a, 4);
+      bench_op(&bc, RADDBG_EvalOp_TruncSigned, 32);
+      bench_op(&bc, RADDBG_EvalOp_ConstU8, 10);
+      bench_op(&bc, RADDBG_EvalOp_Grtr, RADDBG_EvalTypeGroup_S);
+      bench_local(&bc, off_b, 8);
+      bench_op(&bc, RADDBG_EvalOp_ConstU8, 0);
+      bench_op(&bc, RADDBG_EvalOp_NtEq, RADDBG_EvalTypeGroup_U);
+      bench_op(&bc, RADDBG_EvalOp_LogAnd, RADDBG_EvalTypeGroup_U);
+    }break;
+    
+    //- arithmetic: (a*3 + b - 7) & 0xffff
+    case 4:
+    {
+      bench_local(&bc, off_a, 4);
+      bench_op(&bc, RADDBG_EvalOp_ConstU8, 3);
+      bench_op(&bc, RADDBG_EvalOp_Mul, RADDBG_EvalTypeGroup_U);
+      bench_local(&bc, off_b, 4);
+      bench_op(&bc, RADDBG_EvalOp_Add, RADDBG_EvalTypeGroup_U);
+      bench_op(&bc, RADDBG_EvalOp_ConstU8, 7);
+      bench_op(&bc, RADDBG_EvalOp_Sub, RADDBG_EvalTypeGroup_U);
+      bench_op(&bc, RADDBG_EvalOp_Trunc, 16);
+    }break;
+    
+    //- ternary: a < b ? a : b
+    case 5:
+    {
+      bench_local(&bc, off_a, 8);
+      bench_local(&bc, off_b, 8);
+      bench_op(&bc, RADDBG_EvalOp_Less, RADDBG_EvalTypeGroup_U);
+      bench_op(&bc, RADDBG_EvalOp_Cond, 12 + 2);
+      bench_local(&bc, off_b, 8);
+      bench_op(&bc, RADDBG_EvalOp_Skip, 12);
+      bench_local(&bc, off_a, 8);
+    }break;
+  }
+  String8 result = str8(bc.str, bc.size);
+  return result;
+}
+
+int
+main(int argc, char **argv)
+{
+  local_persist TCTX main_thread_tctx = {0};
+  tctx_init_and_equip(&main_thread_tctx);
+  Arena *arena = arena_alloc();
+  
+  //- set up fake target
+  U64 module_base = BENCH_MEMORY_BASE;
+  U64 frame_base = BENCH_MEMORY_BASE;
+  U64 tls_base = BENCH_MEMORY_BASE;
+  U64 reg_size = regs_block_size_from_architecture(Architecture_x64);
+  void *reg_data = push_array(arena, U8, reg_size);
+  regs_arch_block_write_rsp(Architecture_x64, reg_data, BENCH_MEMORY_BASE + KB(8));
+  for(U64 idx = 0; idx < BENCH_MEMORY_SIZE; idx += 1)
+  {
+    bench_memory[idx] = (U8)(idx*131 + (idx >> 8));
+  }
+  EVAL_Machine machine = {0};
+  machine.arch = Architecture_x64;
+  machine.memory_read = bench_memory_read;
+  machine.reg_data = reg_data;
+  machine.reg_size = reg_size;
+  machine.module_base = &module_base;
+  machine.frame_base = &frame_base;
+  machine.tls_base = &tls_base;
+  
+  //- build workload
+  String8 *bytecodes = push_array(arena, String8, BENCH_EXPRS_PER_FRAME);
+  EVAL_Program *programs = push_array(arena, EVAL_Program, BENCH_EXPRS_PER_FRAME);
+  U64 rng = 0x2545F4914F6CDD1Dull;
+  U64 predecode_begin_us = os_now_microseconds();
+  for(U64 idx = 0; idx < BENCH_EXPRS_PER_FRAME; idx += 1)
+  {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    bytecodes[idx] = bench_bytecode_from_template(arena, idx%6, rng);
+    programs[idx] = eval_program_from_bytecode(arena, Architecture_x64, bytecodes[idx]);
+  }
+  U64 predecode_end_us = os_now_microseconds();
+  
+  //- check results match
+  U64 mismatch_count = 0;
+  U64 fallback_count = 0;
+  for(U64 idx = 0; idx < BENCH_EXPRS_PER_FRAME; idx += 1)
+  {
+    EVAL_Result a = eval_interpret(&machine, bytecodes[idx]);
+    EVAL_Result b = eval_interpret_program(&machine, &programs[idx]);
+    if(a.bad_eval != b.bad_eval || (!a.bad_eval && !MemoryMatchStruct(&a.value, &b.value)))
+    {
+      mismatch_count += 1;
+    }
+    fallback_count += (programs[idx].insts == 0);
+  }
+  
+  //- run
+  U64 checksum[2] = {0};
+  U64 frame_us[2] = {0};
+  for(U64 path = 0; path < 2; path += 1)
+  {
+    U64 begin_us = os_now_microseconds();
+    for(U64 frame_idx = 0; frame_idx < BENCH_FRAME_COUNT; frame_idx += 1)
+    {
+      for(U64 idx = 0; idx < BENCH_EXPRS_PER_FRAME; idx += 1)
+      {
+        EVAL_Result result = (path == 0 ? eval_interpret(&machine, bytecodes[idx]) : eval_interpret_program(&machine, &programs[idx]));
+        checksum[path] += (result.bad_eval ? 1 : result.value.u64);
+      }
+    }
+    U64 end_us = os_now_microseconds();
+    frame_us[path] = end_us - begin_us;
+  }
+  
+  //- report
+  printf("%llu expressions/frame, %llu frames\n", (U64)BENCH_EXPRS_PER_FRAME, (U64)BENCH_FRAME_COUNT);
+  printf("pre-decode: %.3f ms total (%llu fallbacks, %llu mismatches)\n", (predecode_end_us - predecode_begin_us)/1000.0, fallback_count, mismatch_count);
+  printf("%-12s %14s %14s\n", "path", "us/frame", "ns/expr");
+  char *names[2] = {"interpret", "program"};
+  for(U64 path = 0; path < 2; path += 1)
+  {
+    F64 us_per_frame = (F64)frame_us[path] / BENCH_FRAME_COUNT;
+    F64 ns_per_expr = us_per_frame*1000.0 / BENCH_EXPRS_PER_FRAME;
+    printf("%-12s %14.2f %14.2f\n", names[path], us_per_frame, ns_per_expr);
+  }
+  if(checksum[0] != checksum[1])
+  {
+    printf("checksum mismatch!\n");
+  }
+  
+  return 0;
+}
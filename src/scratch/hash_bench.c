@@ -0,0 +1,85 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ hash_store content hash throughput benchmark
+//
+// Hashes inputs from 1KB to 1GB with every hs_hash_from_data backend, and
+// reports throughput for each. Small inputs are hashed repeatedly (at
+// consecutive offsets into the buffer) so every row covers a similar number
+// of bytes.
+
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "hash_store/hash_store.h"
+
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "hash_store/hash_store.c"
+
+#define BENCH_BUFFER_SIZE     GB(1)
+#define BENCH_BYTES_PER_ROW   GB(2)
+
+int
+main(int argc, char **argv)
+{
+  local_persist TCTX main_thread_tctx = {0};
+  tctx_init_and_equip(&main_thread_tctx);
+  Arena *arena = arena_alloc();
+  
+  //- fill buffer
+  U8 *buffer = (U8 *)os_reserve(BENCH_BUFFER_SIZE);
+  if(buffer == 0 || !os_commit(buffer, BENCH_BUFFER_SIZE))
+  {
+    printf("could not allocate %llu byte buffer\n", (U64)BENCH_BUFFER_SIZE);
+    return 1;
+  }
+  U64 rng = 0x2545F4914F6CDD1Dull;
+  for(U64 idx = 0; idx < BENCH_BUFFER_SIZE/8; idx += 1)
+  {
+    rng ^= rng << 13;
+    rng ^= rng >> 7;
+    rng ^= rng << 17;
+    ((U64 *)buffer)[idx] = rng;
+  }
+  
+  //- run
+  U64 sizes[] = {KB(1), KB(16), KB(256), MB(4), MB(64), GB(1)};
+  char *names[HS_HashKind_COUNT] = {"blake2b", "aes"};
+  printf("%-10s", "size");
+  for(U64 kind = 0; kind < HS_HashKind_COUNT; kind += 1)
+  {
+    printf(" %12s", names[kind]);
+  }
+  printf(" %10s\n", "speedup");
+  for(U64 size_idx = 0; size_idx < ArrayCount(sizes); size_idx += 1)
+  {
+    U64 size = sizes[size_idx];
+    U64 iteration_count = Max(BENCH_BYTES_PER_ROW/size, 1);
+    U64 max_off = BENCH_BUFFER_SIZE - size;
+    F64 gb_per_second[HS_HashKind_COUNT] = {0};
+    U64 checksum = 0;
+    for(U64 kind = 0; kind < HS_HashKind_COUNT; kind += 1)
+    {
+      U64 begin_us = os_now_microseconds();
+      for(U64 iteration_idx = 0; iteration_idx < iteration_count; iteration_idx += 1)
+      {
+        U64 off = (max_off != 0 ? (iteration_idx*64)%max_off : 0);
+        U128 hash = hs_hash_from_data_kind((HS_HashKind)kind, str8(buffer + off, size));
+        checksum += hash.u64[0] ^ hash.u64[1];
+      }
+      U64 end_us = os_now_microseconds();
+      F64 seconds = (F64)Max(end_us - begin_us, 1) / 1000000.0;
+      gb_per_second[kind] = (F64)(iteration_count*size) / seconds / (F64)GB(1);
+    }
+    String8 size_string = str8_from_memory_size(arena, size);
+    printf("%-10.*s", str8_varg(size_string));
+    for(U64 kind = 0; kind < HS_HashKind_COUNT; kind += 1)
+    {
+      printf(" %9.2f GB/s", gb_per_second[kind]);
+    }
+    printf(" %9.1fx   (%llx)\n", gb_per_second[HS_HashKind_AES]/gb_per_second[HS_HashKind_Blake2b], checksum);
+  }
+  
+  return 0;
+}
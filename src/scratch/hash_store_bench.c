@@ -0,0 +1,160 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ hash_store read-path microbenchmark
+//
+// Fills the hash store with a fixed set of blobs, then measures
+// hs_hash_from_key + hs_data_from_hash throughput from 1..N threads, for
+// both the lock-free read path and the stripe-locked fallback path.
+
+#include "base/base_inc.h"
+#include "os/os_inc.h"
+#include "hash_store/hash_store.h"
+
+#include "base/base_inc.c"
+#include "os/os_inc.c"
+#include "hash_store/hash_store.c"
+
+#define BENCH_KEY_COUNT          4096
+#define BENCH_BLOB_SIZE          256
+#define BENCH_LOOKUPS_PER_THREAD 2000000
+#define BENCH_LOOKUPS_PER_SCOPE  64
+
+typedef struct BenchThreadParams BenchThreadParams;
+struct BenchThreadParams
+{
+  B32 locked;
+  U64 seed;
+  U64 checksum;
+};
+
+global U64 bench_start_gen = 0;
+global U64 bench_done_count = 0;
+global U64 bench_thread_count = 0;
+global BenchThreadParams *bench_thread_params = 0;
+
+internal U128
+bench_key_from_idx(U64 idx)
+{
+  U128 key = {idx, idx*0x9E3779B97F4A7C15ull + 1};
+  return key;
+}
+
+internal U64
+bench_run_lookups(BenchThreadParams *params)
+{
+  U64 checksum = 0;
+  U64 rng = params->seed;
+  for(U64 lookup_idx = 0; lookup_idx < BENCH_LOOKUPS_PER_THREAD; lookup_idx += BENCH_LOOKUPS_PER_SCOPE)
+  {
+    HS_Scope *scope = hs_scope_open();
+    for(U64 idx = 0; idx < BENCH_LOOKUPS_PER_SCOPE; idx += 1)
+    {
+      rng ^= rng << 13;
+      rng ^= rng >> 7;
+      rng ^= rng << 17;
+      U128 key = bench_key_from_idx(rng%BENCH_KEY_COUNT);
+      String8 data = {0};
+      if(params->locked)
+      {
+        U128 hash = hs_hash_from_key__locked(key);
+        B32 evicted = 0;
+        data = hs_data_from_hash__locked(scope, hash, &evicted);
+      }
+      else
+      {
+        U128 hash = hs_hash_from_key(key);
+        data = hs_data_from_hash(scope, hash);
+      }
+      checksum += data.size;
+    }
+    hs_scope_close(scope);
+  }
+  return checksum;
+}
+
+internal void
+bench_thread__entry_point(void *p)
+{
+  U64 thread_idx = (U64)p;
+  U64 last_gen = 0;
+  for(;;)
+  {
+    U64 gen = ins_atomic_u64_eval(&bench_start_gen);
+    if(gen == last_gen)
+    {
+      os_sleep_milliseconds(1);
+      continue;
+    }
+    last_gen = gen;
+    if(thread_idx < ins_atomic_u64_eval(&bench_thread_count))
+    {
+      BenchThreadParams *params = &bench_thread_params[thread_idx];
+      params->checksum = bench_run_lookups(params);
+      ins_atomic_u64_inc_eval(&bench_done_count);
+    }
+  }
+}
+
+int
+main(int argc, char **argv)
+{
+  local_persist TCTX main_thread_tctx = {0};
+  tctx_init_and_equip(&main_thread_tctx);
+  Arena *arena = arena_alloc();
+  hs_init();
+  
+  //- fill store
+  for(U64 idx = 0; idx < BENCH_KEY_COUNT; idx += 1)
+  {
+    Arena *data_arena = arena_alloc();
+    U8 *data = push_array_no_zero(data_arena, U8, BENCH_BLOB_SIZE);
+    for(U64 byte_idx = 0; byte_idx < BENCH_BLOB_SIZE; byte_idx += 1)
+    {
+      data[byte_idx] = (U8)(idx*31 + byte_idx);
+    }
+    hs_submit_data(bench_key_from_idx(idx), &data_arena, str8(data, BENCH_BLOB_SIZE));
+  }
+  
+  //- launch workers
+  U64 max_thread_count = os_logical_core_count();
+  bench_thread_params = push_array(arena, BenchThreadParams, max_thread_count);
+  for(U64 idx = 0; idx < max_thread_count; idx += 1)
+  {
+    os_launch_thread(bench_thread__entry_point, (void *)idx, 0);
+  }
+  
+  //- run
+  printf("%-8s %-10s %16s\n", "threads", "path", "lookups/sec");
+  for(U64 thread_count = 1, next_thread_count = 0; thread_count <= max_thread_count; thread_count = next_thread_count)
+  {
+    for(U64 locked = 0; locked <= 1; locked += 1)
+    {
+      for(U64 idx = 0; idx < thread_count; idx += 1)
+      {
+        bench_thread_params[idx].locked = (B32)locked;
+        bench_thread_params[idx].seed = 0x2545F4914F6CDD1Dull ^ (idx+1)*0x9E3779B97F4A7C15ull;
+      }
+      ins_atomic_u64_eval_assign(&bench_done_count, 0);
+      ins_atomic_u64_eval_assign(&bench_thread_count, thread_count);
+      U64 begin_us = os_now_microseconds();
+      ins_atomic_u64_inc_eval(&bench_start_gen);
+      for(;ins_atomic_u64_eval(&bench_done_count) < thread_count;)
+      {
+        os_sleep_milliseconds(1);
+      }
+      U64 end_us = os_now_microseconds();
+      F64 seconds = (F64)(end_us - begin_us) / 1000000.0;
+      F64 lookups_per_second = (F64)(thread_count*BENCH_LOOKUPS_PER_THREAD) / seconds;
+      printf("%-8llu %-10s %16.0f\n", thread_count, locked ? "locked" : "lock-free", lookups_per_second);
+    }
+    next_thread_count = thread_count*2;
+    if(thread_count < max_thread_count && next_thread_count > max_thread_count)
+    {
+      next_thread_count = max_thread_count;
+    }
+  }
+  
+  return 0;
+}
@@ -0,0 +1,212 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+////////////////////////////////
+//~ Main Layer Initialization
+
+internal void
+ts_init(U64 worker_thread_count)
+{
+  Arena *arena = arena_alloc();
+  ts_shared = push_array(arena, TS_Shared, 1);
+  ts_shared->arena = arena;
+  ts_shared->mutex = os_mutex_alloc();
+  ts_shared->cv = os_condition_variable_alloc();
+  ts_shared->worker_thread_count = worker_thread_count;
+  ts_shared->worker_threads = push_array(arena, OS_Handle, ts_shared->worker_thread_count);
+  for(U64 idx = 0; idx < ts_shared->worker_thread_count; idx += 1)
+  {
+    ts_shared->worker_threads[idx] = os_launch_thread(ts_worker_thread__entry_point, (void *)(idx+1), 0);
+  }
+}
+
+internal U64
+ts_thread_count(void)
+{
+  // NOTE: joining threads also execute queued tasks, so they count as well
+  U64 result = 1;
+  if(ts_shared != 0)
+  {
+    result = ts_shared->worker_thread_count + 1;
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ Task Kickoff/Join
+
+internal TS_Ticket
+ts_kickoff(TS_TaskFunctionType *entry_point, Arena *arena, void *p)
+{
+  TS_Ticket ticket = {0};
+  OS_MutexScope(ts_shared->mutex)
+  {
+    TS_Task *task = ts_shared->free_task;
+    if(task != 0)
+    {
+      SLLStackPop(ts_shared->free_task);
+    }
+    else
+    {
+      task = push_array(ts_shared->arena, TS_Task, 1);
+    }
+    U64 gen = task->gen + 1;
+    MemoryZeroStruct(task);
+    task->gen = gen;
+    task->entry_point = entry_point;
+    task->arena = arena;
+    task->p = p;
+    SLLQueuePush(ts_shared->first_queued_task, ts_shared->last_queued_task, task);
+    ticket.u64[0] = (U64)task;
+    ticket.u64[1] = gen;
+  }
+  os_condition_variable_broadcast(ts_shared->cv);
+  return ticket;
+}
+
+internal B32
+ts_ticket_is_done(TS_Ticket ticket)
+{
+  // NOTE: never blocks or runs queued work - for callers which must not wait
+  // (e.g. a frame), & join only once this says the join will be immediate
+  B32 result = 1;
+  TS_Task *task = (TS_Task *)ticket.u64[0];
+  if(task != 0)
+  {
+    OS_MutexScope(ts_shared->mutex)
+    {
+      result = (task->gen != ticket.u64[1] || task->done);
+    }
+  }
+  return result;
+}
+
+internal void *
+ts_join(TS_Ticket ticket)
+{
+  void *result = 0;
+  TS_Task *task = (TS_Task *)ticket.u64[0];
+  if(task != 0)
+  {
+    os_mutex_take(ts_shared->mutex);
+    for(;;)
+    {
+      //- task is not live anymore (already joined) -> nothing to wait on
+      if(task->gen != ticket.u64[1])
+      {
+        break;
+      }
+      
+      //- task is done -> grab result & recycle
+      if(task->done)
+      {
+        result = task->result;
+        task->gen += 1;
+        SLLStackPush(ts_shared->free_task, task);
+        break;
+      }
+      
+      //- task not done -> help out with queued work instead of sleeping, so
+      // that joins from within tasks (or with zero worker threads) never stall
+      TS_Task *other_task = ts_dequeue_task__mutex_guarded();
+      if(other_task != 0)
+      {
+        os_mutex_drop(ts_shared->mutex);
+        ts_execute_task(other_task, 0);
+        os_mutex_take(ts_shared->mutex);
+      }
+      else
+      {
+        os_condition_variable_wait(ts_shared->cv, ts_shared->mutex, max_U64);
+      }
+    }
+    os_mutex_drop(ts_shared->mutex);
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ Arena-Owning Task Kickoff/Join
+
+internal TS_ArenaTask
+ts_arena_task_kickoff(TS_TaskFunctionType *entry_point, void *p)
+{
+  TS_ArenaTask task = {0};
+  task.arena = arena_alloc();
+  if(ts_shared != 0)
+  {
+    task.ticket = ts_kickoff(entry_point, task.arena, p);
+  }
+  else
+  {
+    task.result = entry_point(task.arena, 0, p);
+  }
+  return task;
+}
+
+internal void *
+ts_arena_task_join(Arena *arena, TS_ArenaTask task)
+{
+  void *result = task.result;
+  if(task.arena != 0)
+  {
+    if(ts_shared != 0)
+    {
+      result = ts_join(task.ticket);
+    }
+    arena_absorb(arena, task.arena);
+  }
+  return result;
+}
+
+////////////////////////////////
+//~ Task Execution
+
+internal TS_Task *
+ts_dequeue_task__mutex_guarded(void)
+{
+  TS_Task *task = ts_shared->first_queued_task;
+  if(task != 0)
+  {
+    SLLQueuePop(ts_shared->first_queued_task, ts_shared->last_queued_task);
+    task->next = 0;
+  }
+  return task;
+}
+
+internal void
+ts_execute_task(TS_Task *task, U64 worker_idx)
+{
+  ProfBeginFunction();
+  void *result = task->entry_point(task->arena, worker_idx, task->p);
+  OS_MutexScope(ts_shared->mutex)
+  {
+    task->result = result;
+    task->done = 1;
+  }
+  os_condition_variable_broadcast(ts_shared->cv);
+  ProfEnd();
+}
+
+internal void
+ts_worker_thread__entry_point(void *p)
+{
+  TCTX tctx_ = {0};
+  tctx_init_and_equip(&tctx_);
+  U64 worker_idx = (U64)p;
+  ProfThreadName("[ts] worker #%I64u", worker_idx);
+  for(;;)
+  {
+    TS_Task *task = 0;
+    OS_MutexScope(ts_shared->mutex) for(;;)
+    {
+      task = ts_dequeue_task__mutex_guarded();
+      if(task != 0)
+      {
+        break;
+      }
+      os_condition_variable_wait(ts_shared->cv, ts_shared->mutex, max_U64);
+    }
+    ts_execute_task(task, worker_idx);
+  }
+}
@@ -0,0 +1,102 @@
+// Copyright (c) 2024 Epic Games Tools
+// Licensed under the MIT license (https://opensource.org/license/mit/)
+
+#ifndef TASK_SYSTEM_H
+#define TASK_SYSTEM_H
+
+////////////////////////////////
+//~ Task Function Types
+
+#define TS_TASK_FUNCTION_DEF(name) void *name(Arena *arena, U64 worker_idx, void *p)
+typedef TS_TASK_FUNCTION_DEF(TS_TaskFunctionType);
+
+////////////////////////////////
+//~ Ticket Type
+
+typedef struct TS_Ticket TS_Ticket;
+struct TS_Ticket
+{
+  U64 u64[2];
+};
+
+////////////////////////////////
+//~ Task Types
+
+typedef struct TS_Task TS_Task;
+struct TS_Task
+{
+  TS_Task *next;
+  U64 gen;
+  TS_TaskFunctionType *entry_point;
+  Arena *arena;
+  void *p;
+  void *result;
+  B32 done;
+};
+
+////////////////////////////////
+//~ Arena-Owning Task Types
+
+// NOTE: a task which allocates into its own arena; joining absorbs that arena
+// into the joiner's, so results outlive the task without copying. without a
+// task system (ts_init never called) the task just runs in place.
+typedef struct TS_ArenaTask TS_ArenaTask;
+struct TS_ArenaTask
+{
+  Arena *arena;
+  TS_Ticket ticket;
+  void *result;
+};
+
+////////////////////////////////
+//~ Shared State
+
+typedef struct TS_Shared TS_Shared;
+struct TS_Shared
+{
+  Arena *arena;
+  
+  // task queue; guarded by `mutex`, `cv` is broadcast on push & completion
+  OS_Handle mutex;
+  OS_Handle cv;
+  TS_Task *first_queued_task;
+  TS_Task *last_queued_task;
+  TS_Task *free_task;
+  
+  // worker threads
+  U64 worker_thread_count;
+  OS_Handle *worker_threads;
+};
+
+////////////////////////////////
+//~ Globals
+
+global TS_Shared *ts_shared = 0;
+
+////////////////////////////////
+//~ Main Layer Initialization
+
+internal void ts_init(U64 worker_thread_count);
+internal U64 ts_thread_count(void);
+
+////////////////////////////////
+//~ Task Kickoff/Join
+
+internal TS_Ticket ts_kickoff(TS_TaskFunctionType *entry_point, Arena *arena, void *p);
+internal B32 ts_ticket_is_done(TS_Ticket ticket);
+internal void *ts_join(TS_Ticket ticket);
+
+////////////////////////////////
+//~ Arena-Owning Task Kickoff/Join
+
+internal TS_ArenaTask ts_arena_task_kickoff(TS_TaskFunctionType *entry_point, void *p);
+internal void *ts_arena_task_join(Arena *arena, TS_ArenaTask task);
+
+////////////////////////////////
+//~ Task Execution
+
+internal TS_Task *ts_dequeue_task__mutex_guarded(void);
+internal void ts_execute_task(TS_Task *task, U64 worker_idx);
+internal void ts_worker_thread__entry_point(void *p);
+
+#endif // TASK_SYSTEM_H
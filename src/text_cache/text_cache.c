@@ -531,6 +531,7 @@ txt_text_info_from_key_hash_lang(TXT_Scope *scope, U128 key, U128 hash, TXT_Lang
     TXT_Slot *slot = &txt_shared->slots[slot_idx];
     TXT_Stripe *stripe = &txt_shared->stripes[stripe_idx];
     B32 found = 0;
+    B32 node_needs_retry = 0;
     OS_MutexScopeR(stripe->rw_mutex)
     {
       for(TXT_Node *n = slot->first; n != 0; n = n->next)
@@ -539,6 +540,7 @@ txt_text_info_from_key_hash_lang(TXT_Scope *scope, U128 key, U128 hash, TXT_Lang
         {
           MemoryCopyStruct(&info, &n->info);
           found = 1;
+          node_needs_retry = ins_atomic_u32_eval_cond_assign(&n->data_evicted, 0, 1);
           txt_scope_touch_node__stripe_r_guarded(scope, n);
           break;
         }
@@ -577,7 +579,7 @@ txt_text_info_from_key_hash_lang(TXT_Scope *scope, U128 key, U128 hash, TXT_Lang
         }
       }
     }
-    if(node_is_new)
+    if(node_is_new || node_needs_retry)
     {
       txt_u2p_enqueue_req(key, hash, lang, max_U64);
     }
@@ -708,15 +710,16 @@ txt_parse_thread__entry_point(void *p)
     
     //- rjf: hash -> data
     String8 data = {0};
+    B32 data_evicted = 0;
     if(got_task)
     {
-      data = hs_data_from_hash(scope, hash);
+      data = hs_data_from_hash_evicted(scope, hash, &data_evicted);
     }
     
     //- rjf: data -> text info
     Arena *info_arena = 0;
     TXT_TextInfo info = {0};
-    if(got_task && data.size != 0)
+    if(got_task && !data_evicted && data.size != 0)
     {
       info_arena = arena_alloc();
       
@@ -813,17 +816,26 @@ txt_parse_thread__entry_point(void *p)
       {
         if(u128_match(n->hash, hash))
         {
-          n->arena = info_arena;
-          MemoryCopyStruct(&n->info, &info);
+          // NOTE: evicted data is not this hash's content - leave the node
+          // unloaded, & retry on its next lookup, once it's been resubmitted
+          if(data_evicted)
+          {
+            ins_atomic_u32_eval_assign(&n->data_evicted, 1);
+          }
+          else
+          {
+            n->arena = info_arena;
+            MemoryCopyStruct(&n->info, &info);
+            ins_atomic_u64_inc_eval(&n->load_count);
+          }
           ins_atomic_u32_eval_assign(&n->is_working, 0);
-          ins_atomic_u64_inc_eval(&n->load_count);
           break;
         }
       }
     }
     
     //- rjf: commit this key/hash pair to fallback cache
-    if(got_task && !u128_match(key, u128_zero()) && !u128_match(hash, u128_zero()))
+    if(got_task && !data_evicted && !u128_match(key, u128_zero()) && !u128_match(hash, u128_zero()))
     {
       U64 fallback_slot_idx = key.u64[1]%txt_shared->fallback_slots_count;
       U64 fallback_stripe_idx = fallback_slot_idx%txt_shared->fallback_stripes_count;
@@ -879,7 +891,7 @@ txt_evictor_thread__entry_point(void *p)
           if(n->scope_ref_count == 0 &&
              n->last_time_touched_us+evict_threshold_us <= check_time_us &&
              n->last_user_clock_idx_touched+evict_threshold_user_clocks <= check_time_user_clocks &&
-             n->load_count != 0 &&
+             (n->load_count != 0 || n->data_evicted) &&
              n->is_working == 0)
           {
             slot_has_work = 1;
@@ -895,7 +907,7 @@ txt_evictor_thread__entry_point(void *p)
           if(n->scope_ref_count == 0 &&
              n->last_time_touched_us+evict_threshold_us <= check_time_us &&
              n->last_user_clock_idx_touched+evict_threshold_user_clocks <= check_time_user_clocks &&
-             n->load_count != 0 &&
+             (n->load_count != 0 || n->data_evicted) &&
              n->is_working == 0)
           {
             DLLRemove(slot->first, slot->last, n);
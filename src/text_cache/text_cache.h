@@ -135,6 +135,7 @@ struct TXT_Node
   Arena *arena;
   TXT_TextInfo info;
   B32 is_working;
+  B32 data_evicted;
   U64 scope_ref_count;
   U64 last_time_touched_us;
   U64 last_user_clock_idx_touched;
@@ -169,6 +169,7 @@ tex_texture_from_key_hash_topology(TEX_Scope *scope, U128 key, U128 hash, TEX_To
     TEX_Stripe *stripe = &tex_shared->stripes[stripe_idx];
     B32 found = 0;
     B32 stale = 0;
+    B32 node_needs_retry = 0;
     OS_MutexScopeR(stripe->rw_mutex)
     {
       for(TEX_Node *n = slot->first; n != 0; n = n->next)
@@ -177,6 +178,7 @@ tex_texture_from_key_hash_topology(TEX_Scope *scope, U128 key, U128 hash, TEX_To
         {
           handle = n->texture;
           found = !r_handle_match(r_handle_zero(), handle);
+          node_needs_retry = ins_atomic_u32_eval_cond_assign(&n->data_evicted, 0, 1);
           tex_scope_touch_node__stripe_r_guarded(scope, n);
           break;
         }
@@ -215,7 +217,7 @@ tex_texture_from_key_hash_topology(TEX_Scope *scope, U128 key, U128 hash, TEX_To
         }
       }
     }
-    if(node_is_new)
+    if(node_is_new || node_needs_retry)
     {
       tex_u2x_enqueue_req(key, hash, topology, max_U64);
     }
@@ -345,14 +347,15 @@ tex_xfer_thread__entry_point(void *p)
     
     //- rjf: hash -> data
     String8 data = {0};
+    B32 data_evicted = 0;
     if(got_task)
     {
-      data = hs_data_from_hash(scope, hash);
+      data = hs_data_from_hash_evicted(scope, hash, &data_evicted);
     }
     
     //- rjf: data * topology -> texture
     R_Handle texture = {0};
-    if(got_task && top.dim.x != 0 && top.dim.y != 0 && data.size >= (U64)top.dim.x*(U64)top.dim.y*r_tex2d_format_bytes_per_pixel_table[top.fmt])
+    if(got_task && !data_evicted && top.dim.x != 0 && top.dim.y != 0 && data.size >= (U64)top.dim.x*(U64)top.dim.y*r_tex2d_format_bytes_per_pixel_table[top.fmt])
     {
       texture = r_tex2d_alloc(R_Tex2DKind_Static, v2s32(top.dim.x, top.dim.y), top.fmt, data.str);
     }
@@ -364,16 +367,25 @@ tex_xfer_thread__entry_point(void *p)
       {
         if(u128_match(n->hash, hash) && MemoryMatchStruct(&top, &n->topology))
         {
-          n->texture = texture;
+          // NOTE: evicted data is not this hash's content - leave the node
+          // unloaded, & retry on its next lookup, once it's been resubmitted
+          if(data_evicted)
+          {
+            ins_atomic_u32_eval_assign(&n->data_evicted, 1);
+          }
+          else
+          {
+            n->texture = texture;
+            ins_atomic_u64_inc_eval(&n->load_count);
+          }
           ins_atomic_u32_eval_assign(&n->is_working, 0);
-          ins_atomic_u64_inc_eval(&n->load_count);
           break;
         }
       }
     }
     
     //- rjf: commit this key/hash pair to fallback cache
-    if(got_task && !u128_match(key, u128_zero()) && !u128_match(hash, u128_zero()))
+    if(got_task && !data_evicted && !u128_match(key, u128_zero()) && !u128_match(hash, u128_zero()))
     {
       U64 fallback_slot_idx = key.u64[1]%tex_shared->fallback_slots_count;
       U64 fallback_stripe_idx = fallback_slot_idx%tex_shared->fallback_stripes_count;
@@ -429,7 +441,7 @@ tex_evictor_thread__entry_point(void *p)
           if(n->scope_ref_count == 0 &&
              n->last_time_touched_us+evict_threshold_us <= check_time_us &&
              n->last_user_clock_idx_touched+evict_threshold_user_clocks <= check_time_user_clocks &&
-             n->load_count != 0 &&
+             (n->load_count != 0 || n->data_evicted) &&
              n->is_working == 0)
           {
             slot_has_work = 1;
@@ -445,7 +457,7 @@ tex_evictor_thread__entry_point(void *p)
           if(n->scope_ref_count == 0 &&
              n->last_time_touched_us+evict_threshold_us <= check_time_us &&
              n->last_user_clock_idx_touched+evict_threshold_user_clocks <= check_time_user_clocks &&
-             n->load_count != 0 &&
+             (n->load_count != 0 || n->data_evicted) &&
              n->is_working == 0)
           {
             DLLRemove(slot->first, slot->last, n);
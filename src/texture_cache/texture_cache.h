@@ -41,6 +41,7 @@ struct TEX_Node
   TEX_Topology topology;
   R_Handle texture;
   B32 is_working;
+  B32 data_evicted;
   U64 scope_ref_count;
   U64 last_time_touched_us;
   U64 last_user_clock_idx_touched;
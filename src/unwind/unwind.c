@@ -15,14 +15,51 @@ unw_memview_from_data(String8 data, U64 base_vaddr){
   return(result);
 }
 
+internal UNW_MemView
+unw_memview_from_fetch_page(Arena *arena, Rng1U64 vaddr_range,
+                            UNW_MemViewFetchPageFunction *fetch_page, void *u){
+  UNW_MemView result = {0};
+  result.addr_first = vaddr_range.min;
+  result.addr_opl = vaddr_range.max;
+  result.fetch_page = fetch_page;
+  result.fetch_page_u = u;
+  result.page_data = push_array_no_zero(arena, U8, UNW_MEMVIEW_PAGE_SIZE*UNW_MEMVIEW_PAGE_SLOT_COUNT);
+  return(result);
+}
+
 //- mem view user face for unwind users
 
 internal B32
 unw_memview_read(UNW_MemView *memview, U64 addr, U64 size, void *out){
   B32 result = 0;
-  if (memview->addr_first <= addr && addr + size <= memview->addr_opl){
-    MemoryCopy(out, (U8*)memview->data + addr - memview->addr_first, size);
-    result = 1;
+  if (memview->addr_first <= addr && addr <= addr + size && addr + size <= memview->addr_opl){
+    if (memview->fetch_page == 0){
+      MemoryCopy(out, (U8*)memview->data + addr - memview->addr_first, size);
+      result = 1;
+    }
+    else{
+      // copy page-by-page, faulting in pages which are not resident
+      result = 1;
+      U64 opl = addr + size;
+      for (U64 cursor = addr; cursor < opl;){
+        U64 page_addr = AlignDownPow2(cursor, UNW_MEMVIEW_PAGE_SIZE);
+        U64 slot_idx = (page_addr/UNW_MEMVIEW_PAGE_SIZE)%UNW_MEMVIEW_PAGE_SLOT_COUNT;
+        U8 *page = memview->page_data + slot_idx*UNW_MEMVIEW_PAGE_SIZE;
+        if (memview->page_states[slot_idx] == UNW_MemViewPageState_Empty ||
+            memview->page_addrs[slot_idx] != page_addr){
+          B32 fetched = memview->fetch_page(memview->fetch_page_u, page_addr, page);
+          memview->page_addrs[slot_idx] = page_addr;
+          memview->page_states[slot_idx] = (fetched ? UNW_MemViewPageState_Good : UNW_MemViewPageState_Bad);
+        }
+        if (memview->page_states[slot_idx] != UNW_MemViewPageState_Good){
+          result = 0;
+          break;
+        }
+        U64 copy_opl = Min(opl, page_addr + UNW_MEMVIEW_PAGE_SIZE);
+        MemoryCopy((U8*)out + (cursor - addr), page + (cursor - page_addr), copy_opl - cursor);
+        cursor = copy_opl;
+      }
+    }
   }
   return(result);
 }
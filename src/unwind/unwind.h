@@ -9,15 +9,37 @@
 
 // * applies to (any X,Y: unwind(X, Y))
 
+#define UNW_MEMVIEW_PAGE_SIZE       KB(4)
+#define UNW_MEMVIEW_PAGE_SLOT_COUNT 16
+
+// fills 'out' with the UNW_MEMVIEW_PAGE_SIZE bytes at 'page_addr'; returns
+// zero if the page cannot be read
+typedef B32 UNW_MemViewFetchPageFunction(void *u, U64 page_addr, void *out);
+
+typedef U8 UNW_MemViewPageState;
+enum{
+  UNW_MemViewPageState_Empty,
+  UNW_MemViewPageState_Good,
+  UNW_MemViewPageState_Bad,
+};
+
 typedef struct UNW_MemView{
   // Upgrade Path:
   //  1. A list of ranges like this one
   //  2. Binary-searchable list of ranges
   //  3. In-line growth strategy for missing pages (hardwired to source of new data)
-  //  4. Abstracted source of new data
+  //  4. Abstracted source of new data (fetch_page)
   void *data;
   U64 addr_first;
   U64 addr_opl;
+  
+  // lazy paged mode: data is 0; pages inside [addr_first,addr_opl) are pulled
+  // in through fetch_page on first touch, into a small direct-mapped cache
+  UNW_MemViewFetchPageFunction *fetch_page;
+  void *fetch_page_u;
+  U8 *page_data;
+  U64 page_addrs[UNW_MEMVIEW_PAGE_SLOT_COUNT];
+  UNW_MemViewPageState page_states[UNW_MEMVIEW_PAGE_SLOT_COUNT];
 } UNW_MemView;
 
 typedef struct UNW_Result{
@@ -284,6 +306,8 @@ enum{
 
 //- mem view construction
 internal UNW_MemView unw_memview_from_data(String8 data, U64 base_vaddr);
+internal UNW_MemView unw_memview_from_fetch_page(Arena *arena, Rng1U64 vaddr_range,
+                                                 UNW_MemViewFetchPageFunction *fetch_page, void *u);
 
 //- mem view user face for unwind users
 internal B32 unw_memview_read(UNW_MemView *memview, U64 addr, U64 size, void *out);